@@ -0,0 +1,338 @@
+/*
+ *  Calcula en una sola pasada la foto promedio y la foto mediana
+ *  de un conjunto de fotos, separadas por sexo
+ *
+ *  Copyright (C) 2010-2026  Daniel J. Calandria Hernández &
+ *                           Antonio Cañas Vargas
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Uso: foto_promedio_mediana <lista> <prefijo_mediana> <prefijo_promedio>
+ *
+ * Cada linea de <lista> es "<sexo> <fichero>", con <sexo> = unknown|female|male.
+ * Se generan <prefijo>_<sexo>.jpg para cada sexo con fotos
+ * y <prefijo>_all.jpg con todas las fotos.
+ *
+ * Memoria: un unico bloque contiguo de histogramas uint16 por sexo,
+ * organizado por planos (hist[valor * TamBanda + muestra]),
+ * de forma que el calculo de la mediana recorre memoria contigua
+ * y el compilador puede vectorizarlo.
+ * Cada foto se acumula en cuanto se decodifica, sin guardar fotos decodificadas.
+ * Si los histogramas de todas las muestras superan MAX_BYTES_HIST,
+ * las muestras se reparten en bandas y las fotos se leen una vez por banda.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <omp.h>
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/highgui/highgui.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+using namespace std;
+
+#define NUM_SEXOS	3	// unknown, female, male
+#define NUM_NIVELES	256
+#define MAX_BYTES_HIST	(64UL * 1024UL * 1024UL)	// Memoria maxima para histogramas
+
+static const char *NombreSexo[NUM_SEXOS] =
+{
+	"unknown",
+	"female",
+	"male",
+};
+
+struct Foto
+{
+	int Sexo;
+	bool EnHist;	// Entre las UINT16_MAX primeras de su sexo
+	string Fichero;
+};
+
+struct Acumulador
+{
+	uint32_t NumFotos;		// Fotos sumadas al promedio
+	uint32_t NumFotosHist;		// Fotos sumadas al histograma (<= UINT16_MAX)
+	vector<uint32_t> Suma;		// Suma por muestra
+	vector<uint16_t> Hist;		// NUM_NIVELES planos de TamBanda contadores
+};
+
+static bool LeerLista (const char *NombreLista, vector<Foto> &Fotos);
+static bool LeerFoto (const string &Fichero, const cv::Size &Tam, cv::Mat &Img);
+static void Acumular (Acumulador &Acu, const uint8_t *Img, bool EnSuma, bool EnHist,
+		      size_t Ini, size_t Fin, size_t NumMuestras, size_t TamBanda);
+static void Promedio (const uint32_t *Suma, uint32_t NumFotos, uint8_t *Salida, size_t NumMuestras);
+static void Mediana (const vector<const uint16_t *> &Hists, uint32_t NumFotos,
+		     uint8_t *Salida, size_t NumMuestras, size_t TamBanda);
+static bool Guardar (const char *Prefijo, const char *Sexo, const cv::Mat &Img);
+
+int main (int argc, char **argv)
+{
+	vector<Foto> Fotos;
+	Acumulador Acu[NUM_SEXOS];
+	cv::Mat Primera;
+	cv::Size Tam;
+	size_t NumMuestras;
+	size_t NumSexosConFotos = 0;
+	size_t NumBandas;
+	size_t TamBanda;
+	int Sexo;
+
+	//Opciones: <lista> <prefijo_mediana> <prefijo_promedio>
+	if (argc < 4)
+	{
+		cerr << "foto_promedio_mediana <lista> <prefijo_mediana> <prefijo_promedio>" << endl;
+		return 2;
+	}
+
+	if (!LeerLista (argv[1], Fotos) || Fotos.empty ())
+		return 1;
+
+	//El tamano de la primera foto legible es el de todas las demas
+	for (size_t i = 0; i < Fotos.size () && Primera.empty (); i++)
+		Primera = cv::imread (Fotos[i].Fichero, cv::IMREAD_COLOR);
+	if (Primera.empty ())
+		return 1;
+	Tam = Primera.size ();
+	NumMuestras = (size_t) Tam.width * Tam.height * 3;
+	Primera.release ();
+
+	//Reservar solo para los sexos presentes en la lista
+	for (size_t i = 0; i < Fotos.size (); i++)
+	{
+		Acumulador &A = Acu[Fotos[i].Sexo];
+		if (A.Suma.empty ())
+		{
+			A.Suma.assign (NumMuestras, 0);
+			NumSexosConFotos++;
+		}
+	}
+
+	//Repartir las muestras en bandas cuyos histogramas quepan en MAX_BYTES_HIST
+	NumBandas = (NumSexosConFotos * NUM_NIVELES * NumMuestras * sizeof (uint16_t) +
+		     MAX_BYTES_HIST - 1) / MAX_BYTES_HIST;
+	TamBanda = (NumMuestras + NumBandas - 1) / NumBandas;
+	for (Sexo = 0; Sexo < NUM_SEXOS; Sexo++)
+	{
+		if (!Acu[Sexo].Suma.empty ())
+			Acu[Sexo].Hist.resize (NUM_NIVELES * TamBanda);
+		Acu[Sexo].NumFotos = Acu[Sexo].NumFotosHist = 0;
+	}
+
+	cv::Mat Medianas[NUM_SEXOS + 1];
+	for (Sexo = 0; Sexo <= NUM_SEXOS; Sexo++)
+		Medianas[Sexo].create (Tam, CV_8UC3);
+
+	for (size_t Ini = 0; Ini < NumMuestras; Ini += TamBanda)
+	{
+		size_t Fin = min (Ini + TamBanda, NumMuestras);
+		bool PrimeraBanda = (Ini == 0);
+
+		for (Sexo = 0; Sexo < NUM_SEXOS; Sexo++)
+			fill (Acu[Sexo].Hist.begin (), Acu[Sexo].Hist.end (), 0);
+
+		//Decodificar en paralelo y acumular cada foto en cuanto se lee,
+		//de modo que cada hilo solo mantiene una foto decodificada
+		#pragma omp parallel
+		{
+			cv::Mat Img;
+
+			#pragma omp for schedule(dynamic)
+			for (size_t i = 0; i < Fotos.size (); i++)
+				if (LeerFoto (Fotos[i].Fichero, Tam, Img))
+				{
+					#pragma omp critical
+					{
+						Acumulador &A = Acu[Fotos[i].Sexo];
+
+						//Contar las fotos solo una vez
+						if (PrimeraBanda)
+						{
+							A.NumFotos++;
+							if (Fotos[i].EnHist)
+								A.NumFotosHist++;
+						}
+						Acumular (A,Img.ptr<uint8_t> (),PrimeraBanda,Fotos[i].EnHist,
+							  Ini,Fin,NumMuestras,TamBanda);
+					}
+				}
+		}
+
+		//Medianas de esta banda, por sexo y de todas las fotos
+		vector<const uint16_t *> HistsTodos;
+		uint32_t NumFotosHistTodos = 0;
+
+		for (Sexo = 0; Sexo < NUM_SEXOS; Sexo++)
+			if (Acu[Sexo].NumFotos)
+			{
+				Mediana (vector<const uint16_t *> (1, Acu[Sexo].Hist.data ()),
+					 Acu[Sexo].NumFotosHist,Medianas[Sexo].ptr<uint8_t> () + Ini,
+					 Fin - Ini,TamBanda);
+				HistsTodos.push_back (Acu[Sexo].Hist.data ());
+				NumFotosHistTodos += Acu[Sexo].NumFotosHist;
+			}
+		if (!HistsTodos.empty ())
+			Mediana (HistsTodos,NumFotosHistTodos,Medianas[NUM_SEXOS].ptr<uint8_t> () + Ini,
+				 Fin - Ini,TamBanda);
+	}
+
+	//Escribir resultados
+	cv::Mat Salida (Tam, CV_8UC3);
+	vector<uint32_t> SumaTodos (NumMuestras, 0);
+	uint32_t NumFotosTodos = 0;
+	int Error = 0;
+
+	for (Sexo = 0; Sexo < NUM_SEXOS; Sexo++)
+		if (Acu[Sexo].NumFotos)
+		{
+			if (!Guardar (argv[2], NombreSexo[Sexo], Medianas[Sexo]))
+				Error = 1;
+
+			Promedio (Acu[Sexo].Suma.data (),Acu[Sexo].NumFotos,
+				  Salida.ptr<uint8_t> (),NumMuestras);
+			if (!Guardar (argv[3], NombreSexo[Sexo], Salida))
+				Error = 1;
+
+			//Los totales se obtienen sumando los de cada sexo
+			for (size_t i = 0; i < NumMuestras; i++)
+				SumaTodos[i] += Acu[Sexo].Suma[i];
+			NumFotosTodos += Acu[Sexo].NumFotos;
+		}
+
+	if (NumFotosTodos)
+	{
+		if (!Guardar (argv[2], "all", Medianas[NUM_SEXOS]))
+			Error = 1;
+
+		Promedio (SumaTodos.data (), NumFotosTodos, Salida.ptr<uint8_t> (), NumMuestras);
+		if (!Guardar (argv[3], "all", Salida))
+			Error = 1;
+	}
+
+	return Error;
+}
+
+//Leer la lista de fotos "<sexo> <fichero>"
+static bool LeerLista (const char *NombreLista, vector<Foto> &Fotos)
+{
+	ifstream fs (NombreLista);
+	string StrSexo;
+	Foto F;
+	int Sexo;
+	uint32_t NumFotosSexo[NUM_SEXOS] = {0, 0, 0};
+
+	if (fs.fail ())
+		return false;
+
+	while (fs >> StrSexo >> F.Fichero)
+	{
+		F.Sexo = -1;
+		for (Sexo = 0; Sexo < NUM_SEXOS; Sexo++)
+			if (StrSexo == NombreSexo[Sexo])
+				F.Sexo = Sexo;
+		if (F.Sexo < 0)
+			return false;
+
+		//El histograma se limita a las UINT16_MAX primeras fotos de cada sexo,
+		//las mismas en todas las bandas
+		F.EnHist = (NumFotosSexo[F.Sexo]++ < UINT16_MAX);
+		Fotos.push_back (F);
+	}
+
+	return true;
+}
+
+//Decodificar una foto y ajustarla al tamano comun
+static bool LeerFoto (const string &Fichero, const cv::Size &Tam, cv::Mat &Img)
+{
+	Img = cv::imread (Fichero, cv::IMREAD_COLOR);
+	if (Img.empty ())
+		return false;
+	if (Img.size () != Tam)
+		cv::resize (Img, Img, Tam);
+	if (!Img.isContinuous ())
+		Img = Img.clone ();
+	return true;
+}
+
+//Sumar una foto al promedio y sus muestras [Ini,Fin) al histograma de la banda
+static void Acumular (Acumulador &Acu, const uint8_t *Img, bool EnSuma, bool EnHist,
+		      size_t Ini, size_t Fin, size_t NumMuestras, size_t TamBanda)
+{
+	uint32_t *Suma = Acu.Suma.data ();
+	uint16_t *Hist = Acu.Hist.data ();
+	size_t i;
+
+	//Bucle sin dependencias, vectorizable
+	if (EnSuma)
+		for (i = 0; i < NumMuestras; i++)
+			Suma[i] += Img[i];
+
+	//Histograma limitado a UINT16_MAX fotos
+	if (EnHist)
+		for (i = Ini; i < Fin; i++)
+			Hist[(size_t) Img[i] * TamBanda + (i - Ini)]++;
+}
+
+//Promedio redondeado de cada muestra
+static void Promedio (const uint32_t *Suma, uint32_t NumFotos, uint8_t *Salida, size_t NumMuestras)
+{
+	for (size_t i = 0; i < NumMuestras; i++)
+		Salida[i] = (uint8_t) ((Suma[i] + NumFotos / 2) / NumFotos);
+}
+
+//Mediana de cada muestra a partir de uno o varios histogramas
+//La mediana es el numero de niveles cuya frecuencia acumulada no supera la mitad,
+//lo que evita saltos y permite vectorizar recorriendo cada plano
+static void Mediana (const vector<const uint16_t *> &Hists, uint32_t NumFotos,
+		     uint8_t *Salida, size_t NumMuestras, size_t TamBanda)
+{
+	vector<uint32_t> Acumulada (NumMuestras, 0);
+	vector<uint16_t> Nivel (NumMuestras, 0);
+	uint32_t Mitad = NumFotos / 2;
+	uint32_t *A = Acumulada.data ();
+	uint16_t *N = Nivel.data ();
+	size_t i;
+
+	for (size_t p = 0; p < NUM_NIVELES; p++)
+	{
+		for (size_t h = 0; h < Hists.size (); h++)
+		{
+			const uint16_t *Plano = Hists[h] + p * TamBanda;
+			for (i = 0; i < NumMuestras; i++)
+				A[i] += Plano[i];
+		}
+		for (i = 0; i < NumMuestras; i++)
+			N[i] += (A[i] <= Mitad);
+	}
+
+	for (i = 0; i < NumMuestras; i++)
+		Salida[i] = (uint8_t) (N[i] < NUM_NIVELES ? N[i] : NUM_NIVELES - 1);
+}
+
+static bool Guardar (const char *Prefijo, const char *Sexo, const cv::Mat &Img)
+{
+	string Fichero = string (Prefijo) + "_" + Sexo + ".jpg";
+
+	return cv::imwrite (Fichero, Img);
+}
@@ -489,12 +489,41 @@ function writeClockConnected () {
 	setTimeout('writeClockConnected()',1000);	// refresh after 1 second
 }
 
+/*****************************************************************************/
+/************** Compute delay until next automatic refresh *******************/
+/*****************************************************************************/
+
+// When the server is loaded, it recommends a longer delay in a HTTP header.
+// After each failed refresh, delay is doubled, up to a maximum.
+// A random jitter prevents many clients from refreshing at the same time.
+const maxRefreshDelay = 15 * 60 * 1000;	// 15 minutes, sessions are closed after one hour without refresh
+var numRefreshFailures = {};
+
+function getRefreshDelay (refresh,objXMLHttp,delay) {
+	var recommendedDelay = parseInt(objXMLHttp.getResponseHeader('X-Refresh-Delay'));
+
+	if (objXMLHttp.status == 200) {
+		numRefreshFailures[refresh] = 0;
+		if (recommendedDelay > delay)
+			delay = recommendedDelay;
+	}
+	else {
+		numRefreshFailures[refresh] = (numRefreshFailures[refresh] || 0) + 1;
+		delay *= Math.pow(2,Math.min(numRefreshFailures[refresh],10));
+		if (delay > maxRefreshDelay)
+			delay = maxRefreshDelay;
+	}
+
+	return Math.round(delay * (0.9 + 0.2 * Math.random()));	// +-10%
+}
+
 /*****************************************************************************/
 /************* Automatic refresh of connected users using AJAX ***************/
 /*****************************************************************************/
 
 // This function must be called from time to time
 var objXMLHttpReqCon = false;
+var delayCon = 60000;
 function refreshConnected () {
 	objXMLHttpReqCon = AJAXCreateObject();
 	if (objXMLHttpReqCon) {
@@ -512,7 +541,7 @@ function refreshConnected () {
 
 // Receive and show connected users data
 function readConnUsrsData () {
-	if (objXMLHttpReqCon.readyState == 4)	// Check if data have been received
+	if (objXMLHttpReqCon.readyState == 4) {	// Check if data have been received
 		if (objXMLHttpReqCon.status == 200) {
 			var endOfDelay   = objXMLHttpReqCon.responseText.indexOf('|',0);		// Get separator position
 			var endOfNotif   = objXMLHttpReqCon.responseText.indexOf('|',endOfDelay  + 1);	// Get separator position
@@ -551,9 +580,14 @@ function readConnUsrsData () {
 				}
 			}
 
-			if (delay >= 60000)	// If refresh slower than 1 time each 60 seconds, do refresh; else abort
-				setTimeout('refreshConnected()',delay);
+			if (delay >= 60000) {	// If refresh slower than 1 time each 60 seconds, do refresh; else abort
+				delayCon = delay;
+				setTimeout('refreshConnected()',getRefreshDelay('con',objXMLHttpReqCon,delay));
+			}
 		}
+		else	// Server is not responding properly ==> try again later
+			setTimeout('refreshConnected()',getRefreshDelay('con',objXMLHttpReqCon,delayCon));
+	}
 }
 
 /*****************************************************************************/
@@ -773,16 +807,18 @@ function refreshMatchStd () {
 }
 
 function readMatchStdData () {
-	if (objXMLHttpReqMchStd.readyState == 4)	// Check if data have been received
+	if (objXMLHttpReqMchStd.readyState == 4) {	// Check if data have been received
 		if (objXMLHttpReqMchStd.status == 200) {
 			var htmlMatch = objXMLHttpReqMchStd.responseText;	// Get HTML code
 
 			var div = document.getElementById('match');	// Access to refreshable DIV
 			if (div)
 				div.innerHTML = htmlMatch;				// Update DIV content
-			// Global delay variable is set initially in swad-core
-			setTimeout('refreshMatchStd()',delayMatch);
 		}
+
+		// Global delay variable is set initially in swad-core
+		setTimeout('refreshMatchStd()',getRefreshDelay('mch',objXMLHttpReqMchStd,delayMatch));
+	}
 }
 
 /*****************************************************************************/
@@ -807,7 +843,7 @@ function refreshMatchTch () {
 }
 
 function readMatchTchData () {
-	if (objXMLHttpReqMchTch.readyState == 4)	// Check if data have been received
+	if (objXMLHttpReqMchTch.readyState == 4) {	// Check if data have been received
 		if (objXMLHttpReqMchTch.status == 200) {
 			var endOfId = objXMLHttpReqMchTch.responseText.indexOf('|',0           );	// Get separator position
 			var endOfEv = objXMLHttpReqMchTch.responseText.indexOf('|',endOfId  + 1);	// Get separator position
@@ -828,10 +864,11 @@ function readMatchTchData () {
 					MathJax.typeset();
 				}
 			}
-			
-			// Global delay variable is set initially in swad-core
-			setTimeout('refreshMatchTch()',delayMatch);
 		}
+
+		// Global delay variable is set initially in swad-core
+		setTimeout('refreshMatchTch()',getRefreshDelay('mch',objXMLHttpReqMchTch,delayMatch));
+	}
 }
 
 /*****************************************************************************/
@@ -882,8 +919,9 @@ function refreshLastClicks () {
 	}
 }
 
+var delayLastClicks = 1000;
 function readLastClicksData () {
-	if (objXMLHttpReqLog.readyState == 4)	// Check if data have been received
+	if (objXMLHttpReqLog.readyState == 4) {	// Check if data have been received
 		if (objXMLHttpReqLog.status == 200) {
 			var endOfDelay = objXMLHttpReqLog.responseText.indexOf('|',0);	// Get separator position
 
@@ -893,9 +931,14 @@ function readLastClicksData () {
 			var divLastClicks = document.getElementById('lastclicks');			// Access to last click DIV
 			if (divLastClicks)
 				divLastClicks.innerHTML = htmlLastClicks;				// Update global connected DIV
-			if (delay > 200)	// If refresh slower than 1 time each 0.2 seconds, do refresh; else abort
-				setTimeout('refreshLastClicks()',delay);
+			if (delay > 200) {	// If refresh slower than 1 time each 0.2 seconds, do refresh; else abort
+				delayLastClicks = delay;
+				setTimeout('refreshLastClicks()',getRefreshDelay('clk',objXMLHttpReqLog,delay));
+			}
 		}
+		else	// Server is not responding properly ==> try again later
+			setTimeout('refreshLastClicks()',getRefreshDelay('clk',objXMLHttpReqLog,delayLastClicks));
+	}
 }
 
 /*****************************************************************************/
@@ -922,7 +965,7 @@ function refreshNewTimeline () {
 }
 
 function readNewTimelineData () {
-	if (objXMLHttpReqNewTml.readyState == 4)	// Check if data have been received
+	if (objXMLHttpReqNewTml.readyState == 4) {	// Check if data have been received
 		if (objXMLHttpReqNewTml.status == 200) {
 
 			// Access to UL for just now timeline
@@ -956,11 +999,13 @@ function readNewTimelineData () {
 					viewNewContainer.style.display = '';
 				}
 			}
-			
+
 			// Global delay variable is set initially in swad-core
 			delayNewTml += 1000;	// Increase one second on each call
-			setTimeout('refreshNewTimeline()',delayNewTml);
 		}
+
+		setTimeout('refreshNewTimeline()',getRefreshDelay('tml',objXMLHttpReqNewTml,delayNewTml));
+	}
 }
 
 /*****************************************************************************/
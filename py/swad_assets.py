@@ -0,0 +1,272 @@
+#!/usr/bin/python3
+#
+# swad_assets.py: build bundles of style sheets and scripts for SWAD
+#
+##########################################################################
+#
+#   SWAD (Shared Workspace At a Distance),
+#   is a web platform developed at the University of Granada (Spain),
+#   and used to support university teaching.
+#   Copyright (C) 1999-2026 Antonio Canas-Vargas
+#   University of Granada (SPAIN) (acanas@ugr.es)
+#
+#   This program is free software: you can redistribute it and/or modify
+#   it under the terms of the GNU Affero General Public License as
+#   published by the Free Software Foundation, either version 3 of the
+#   License, or (at your option) any later version.
+#
+#   This program is distributed in the hope that it will be useful,
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#   GNU Affero General Public License for more details.
+#
+#   You should have received a copy of the GNU Affero General Public License
+#   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+##########################################################################
+#
+# Usage: swad_assets.py [output_directory]	(default: assets)
+#
+# Style sheets and scripts loaded in every page are joined, minified
+# and written to files whose name contains a hash of their content,
+# so they never change and can be cached forever by browsers:
+#	swad-<hash>.css, swad-<hash>.css.gz, swad-<hash>.css.br
+#	swad-<hash>.js,  swad-<hash>.js.gz,  swad-<hash>.js.br
+# The file swad_assets.manifest holds the names of the bundles.
+# Copy all files to the public directory of SWAD, the manifest the last.
+# If the manifest does not exist, SWAD uses the original files.
+#
+# Example of Apache configuration to serve precompressed files:
+#	<FilesMatch "^swad-[0-9a-f]+\.(css|js)$">
+#		Header set Cache-Control "public, max-age=31536000, immutable"
+#	</FilesMatch>
+#	RewriteCond %{HTTP:Accept-Encoding} br
+#	RewriteCond %{REQUEST_FILENAME}.br -f
+#	RewriteRule ^(.*/swad-[0-9a-f]+\.(css|js))$ $1.br [L]
+#	RewriteCond %{HTTP:Accept-Encoding} gzip
+#	RewriteCond %{REQUEST_FILENAME}.gz -f
+#	RewriteRule ^(.*/swad-[0-9a-f]+\.(css|js))$ $1.gz [L]
+#	(and Content-Encoding/Content-Type for .br and .gz files)
+
+import gzip
+import hashlib
+import os
+import re
+import shutil
+import subprocess
+import sys
+
+CORE = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+# Style sheet and script of SWAD currently used, as defined in the changelog
+def changelog_file(name):
+	with open(os.path.join(CORE,"swad_changelog.h"),encoding="latin-1") as f:
+		m = re.search(r'^#define\s+' + name + r'\s+"([^"]+)"',f.read(),re.M)
+	if not m:
+		sys.exit("Error: " + name + " not found in swad_changelog.h")
+	return m.group(1)
+
+# Style sheets, in the same order as in the head of pages.
+# Relative URLs are rewritten to be relative to the public directory.
+CSS_FILES = [
+	(os.path.join(CORE,"css",changelog_file("Chl_CSS_FILE")),""),
+	(os.path.join(CORE,"fontawesome","css","fontawesome.min.css"),"fontawesome/css/"),
+	(os.path.join(CORE,"fontawesome","css","solid.min.css"),"fontawesome/css/"),
+]
+
+# Scripts, in order of execution
+JS_FILES = [
+	os.path.join(CORE,"js","mathjax-config.js"),
+	os.path.join(CORE,"js",changelog_file("Chl_JS_FILE")),
+]
+
+MANIFEST = "swad_assets.manifest"	# Same as Cfg_FILE_ASSETS_MANIFEST
+HASH_LENGTH = 16
+
+##########################################################################
+# Rewrite relative URLs in a style sheet
+##########################################################################
+
+def rebase_urls(css,base):
+	if not base:
+		return css
+	def rebase(m):
+		url = m.group(2)
+		if re.match(r"^([a-z]+:|/|#)",url):
+			return m.group(0)
+		return "url(" + m.group(1) + os.path.normpath(base + url.split("?")[0].split("#")[0]) + url[len(url.split("?")[0].split("#")[0]):] + m.group(1) + ")"
+	return re.sub(r"url\(\s*(['\"]?)([^'\")]+)\1\s*\)",rebase,css)
+
+##########################################################################
+# Minify a style sheet: remove comments and unneeded whitespace
+##########################################################################
+
+def minify_css(css):
+	out = []
+	i = 0
+	n = len(css)
+	while i < n:
+		c = css[i]
+		if c in "\"'":				# String
+			j = i + 1
+			while j < n and css[j] != c:
+				j += 2 if css[j] == "\\" else 1
+			out.append(css[i:j + 1])
+			i = j + 1
+		elif css.startswith("/*",i):		# Comment
+			j = css.find("*/",i + 2)
+			i = n if j < 0 else j + 2
+		elif c.isspace():			# Whitespace
+			while i < n and css[i].isspace():
+				i += 1
+			if out and out[-1][-1:] not in "{};:,>" and i < n and css[i] not in "{};,>)":	# Keep space in "a :hover"
+				out.append(" ")
+		else:
+			out.append(c)
+			i += 1
+	return "".join(out).replace(";}","}") + "\n"
+
+##########################################################################
+# Minify a script: remove comments and indentation.
+# Line breaks are kept, so automatic semicolon insertion is not affected.
+##########################################################################
+
+REGEX_PRECEDERS = "(,=:[!&|?{};+-*%<>~^"
+REGEX_KEYWORDS = ("return","typeof","case","do","else","in","instanceof","new","void","delete","throw")
+
+def minify_js(js):
+	out = []
+	line = []
+	last = ""	# Last significant token in code
+	i = 0
+	n = len(js)
+
+	def flush():
+		text = "".join(line).strip()
+		if text:
+			out.append(text)
+		del line[:]
+
+	while i < n:
+		c = js[i]
+		if c in "\"'`":				# String or template
+			j = i + 1
+			while j < n and js[j] != c:
+				j += 2 if js[j] == "\\" else 1
+			line.append(js[i:j + 1])
+			last = c
+			i = j + 1
+		elif js.startswith("//",i):		# Line comment
+			j = js.find("\n",i)
+			i = n if j < 0 else j
+		elif js.startswith("/*",i):		# Block comment
+			j = js.find("*/",i + 2)
+			comment = js[i:n if j < 0 else j + 2]
+			i = n if j < 0 else j + 2
+			if "\n" in comment:
+				flush()
+			else:
+				line.append(" ")
+		elif c == "/" and (last == "" or last[-1] in REGEX_PRECEDERS or last in REGEX_KEYWORDS):	# Regular expression
+			j = i + 1
+			in_class = False
+			while j < n and js[j] != "\n" and (in_class or js[j] != "/"):
+				if js[j] == "\\":
+					j += 1
+				elif js[j] == "[":
+					in_class = True
+				elif js[j] == "]":
+					in_class = False
+				j += 1
+			j += 1
+			while j < n and js[j].isalpha():	# Flags
+				j += 1
+			line.append(js[i:j])
+			last = "/"
+			i = j
+		elif c == "\n":
+			flush()
+			i += 1
+		elif c in " \t\r":
+			while i < n and js[i] in " \t\r":
+				i += 1
+			line.append(" ")
+		elif c.isalnum() or c in "_$":
+			j = i
+			while j < n and (js[j].isalnum() or js[j] in "_$"):
+				j += 1
+			line.append(js[i:j])
+			last = js[i:j]
+			i = j
+		else:
+			line.append(c)
+			last = c
+			i += 1
+	flush()
+
+	# Remove spaces inside lines next to punctuation
+	lines = []
+	for text in out:
+		lines.append(re.sub(r" ?([{}();,=]) ?",r"\1",text) if not re.search(r"[\"'`/]",text) else text)
+	return "\n".join(lines) + "\n"
+
+##########################################################################
+# Write a bundle and its compressed versions
+##########################################################################
+
+def write_bundle(outdir,ext,data):
+	name = "swad-" + hashlib.sha256(data).hexdigest()[:HASH_LENGTH] + "." + ext
+	path = os.path.join(outdir,name)
+
+	with open(path,"wb") as f:
+		f.write(data)
+
+	# gzip, with fixed time so the same content gives the same file
+	with open(path + ".gz","wb") as raw:
+		with gzip.GzipFile(filename="",mode="wb",compresslevel=9,fileobj=raw,mtime=0) as f:
+			f.write(data)
+
+	# brotli, from python module or command, if available
+	try:
+		import brotli
+		with open(path + ".br","wb") as f:
+			f.write(brotli.compress(data,quality=11))
+	except ImportError:
+		if shutil.which("brotli"):
+			subprocess.check_call(["brotli","-f","-q","11","-o",path + ".br",path])
+		else:
+			print("Warning: brotli not available, " + name + ".br not created",file=sys.stderr)
+
+	return name
+
+##########################################################################
+# Main
+##########################################################################
+
+outdir = sys.argv[1] if len(sys.argv) > 1 else "assets"
+os.makedirs(outdir,exist_ok=True)
+
+# Files are read in latin-1, which maps each byte to a character,
+# so bytes are written unchanged whatever the encoding of each file
+css = ""
+for filename,base in CSS_FILES:
+	with open(filename,encoding="latin-1") as f:
+		css += minify_css(rebase_urls(f.read(),base))
+
+js = ""
+for filename in JS_FILES:
+	with open(filename,encoding="latin-1") as f:
+		js += minify_js(f.read()) + ";\n"
+
+css_name = write_bundle(outdir,"css",css.encode("latin-1"))
+js_name  = write_bundle(outdir,"js" ,js.encode("latin-1"))
+
+# Manifest is written last, atomically
+tmp = os.path.join(outdir,MANIFEST + ".tmp")
+with open(tmp,"w") as f:
+	f.write("css " + css_name + "\n")
+	f.write("js "  + js_name  + "\n")
+os.replace(tmp,os.path.join(outdir,MANIFEST))
+
+print(css_name)
+print(js_name)
@@ -0,0 +1,264 @@
+#!/usr/bin/python3
+#
+# swad_bench.py: load test replaying CGI requests against the SWAD binary
+#
+##########################################################################
+#
+#   SWAD (Shared Workspace At a Distance),
+#   is a web platform developed at the University of Granada (Spain),
+#   and used to support university teaching.
+#   Copyright (C) 1999-2026 Antonio Canas-Vargas
+#   University of Granada (SPAIN) (acanas@ugr.es)
+#
+#   This program is free software: you can redistribute it and/or modify
+#   it under the terms of the GNU Affero General Public License as
+#   published by the Free Software Foundation, either version 3 of the
+#   License, or (at your option) any later version.
+#
+#   This program is distributed in the hope that it will be useful,
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#   GNU Affero General Public License for more details.
+#
+#   You should have received a copy of the GNU Affero General Public License
+#   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+##########################################################################
+#
+# Usage: make bench_cgi
+#    or: swad_bench.py [--cgi ./swad_bench] [--mix all|public|student|teacher]
+#			[--requests N] [--no-seed]
+#			[--courses N] [--users N] [--files N] [--log N]
+#
+# Steps:
+# 1. Database swad_bench is created from sql/swad.sql and filled
+#    with a synthetic university generated by swad_bench_seed.py.
+#    The binary swad_bench (make swad_bench) uses this database
+#    instead of swad, so the database of the platform is never touched.
+# 2. Each action of the mix is requested --requests times,
+#    running the CGI directly with REQUEST_METHOD, QUERY_STRING
+#    and standard input, as a web server would do.
+#    Requests of different actions are interleaved.
+# 3. For each action, these are reported:
+#    p50 and p99 of the time to serve the request,
+#    mean number of database queries and maximum resident memory.
+#
+# Must be run in a host where SWAD is installed (private directories
+# writable by the current user), with a MySQL/MariaDB server used
+# only for this test, since queries are counted with the global
+# status variable Questions. The database user is swad, as in the CGI,
+# and its password is taken from environment variable SWAD_BENCH_PASSWORD:
+#	GRANT ALL PRIVILEGES ON swad_bench.* TO 'swad'@'localhost';
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import time
+
+import swad_bench_seed
+
+CORE = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+DATABASE = "swad_bench"		# Same as Cfg_DATABASE_DBNAME in swad_bench
+DATABASE_USER = "swad"		# Same as Cfg_DATABASE_USER
+
+# Representative actions: (action, session, parameters)
+# Session is None for users not logged, or the session of a student or a teacher
+MIXES = {
+	"public": [
+		("ActSeeCty",None,"cty=%u" % swad_bench_seed.CTY_COD),
+		("ActSeeIns",None,"cty=%u" % swad_bench_seed.CTY_COD),
+		("ActSeeCtr",None,"ins=%u" % swad_bench_seed.INS_COD),
+		("ActSeeDeg",None,"ctr=1"),
+		("ActSeeCrs",None,"deg=1"),
+		("ActSeeCrsInf",None,"crs=1"),
+		("ActSeeCal",None,"crs=1"),
+	],
+	"student": [
+		("ActSeeCrsInf",swad_bench_seed.BENCH_SES_STD,""),
+		("ActSeeAdmDocCrsGrp",swad_bench_seed.BENCH_SES_STD,""),
+		("ActLstTch",swad_bench_seed.BENCH_SES_STD,""),
+		("ActSeeCrsTT",swad_bench_seed.BENCH_SES_STD,""),
+		("ActSeeMyTT",swad_bench_seed.BENCH_SES_STD,""),
+		("ActSeeNtf",swad_bench_seed.BENCH_SES_STD,""),
+		("ActSeeLstMyAtt",swad_bench_seed.BENCH_SES_STD,""),
+	],
+	"teacher": [
+		("ActLstStd",swad_bench_seed.BENCH_SES_TCH,""),
+		("ActSeeAllAtt",swad_bench_seed.BENCH_SES_TCH,""),
+		("ActSeeAdmDocCrsGrp",swad_bench_seed.BENCH_SES_TCH,""),
+		("ActReqStaCrs",swad_bench_seed.BENCH_SES_TCH,""),
+		("ActSeeAccCrs",swad_bench_seed.BENCH_SES_TCH,""),
+		("ActSeeUseGbl",swad_bench_seed.BENCH_SES_TCH,""),
+	],
+}
+MIXES["all"] = MIXES["public"] + MIXES["student"] + MIXES["teacher"]
+
+USERS = {
+	None: "unknown",
+	swad_bench_seed.BENCH_SES_STD: "student",
+	swad_bench_seed.BENCH_SES_TCH: "teacher",
+}
+
+##########################################################################
+# Get codes of actions from the list of actions in the C code
+
+def get_action_codes():
+	with open(os.path.join(CORE,"swad_action_list.c"),encoding="latin-1") as f:
+		return {name: int(cod)
+			for name,cod in re.findall(r"^\s*\[(Act\w+)\s*\]\s*=\s*\{\s*(-?\d+)",
+						   f.read(),re.MULTILINE)}
+
+##########################################################################
+# Run SQL in the database of the test
+
+def mysql(password,sql=None,database=DATABASE,input=None):
+	cmd = ["mysql","-u",DATABASE_USER,"-N","-B"]
+	if database:
+		cmd.append(database)
+	if sql is not None:
+		cmd += ["-e",sql]
+	env = dict(os.environ,MYSQL_PWD=password)
+	return subprocess.run(cmd,input=input,env=env,check=True,
+			      stdout=subprocess.PIPE).stdout.decode("latin-1")
+
+def get_num_questions(password):
+	return int(mysql(password,"SHOW GLOBAL STATUS LIKE 'Questions'").split()[1])
+
+##########################################################################
+# Create the database of the test and fill it with synthetic data
+
+def seed_database(password,args):
+	print("Creating database %s..." % DATABASE,file=sys.stderr)
+	mysql(password,"DROP DATABASE IF EXISTS %s;"
+		       " CREATE DATABASE %s DEFAULT CHARACTER SET=latin1 DEFAULT COLLATE latin1_spanish_ci" %
+		       (DATABASE,DATABASE),
+	      database="")
+	with open(os.path.join(CORE,"sql","swad.sql"),"rb") as f:
+		# Skip creation and selection of database swad
+		schema = re.sub(rb"^(CREATE DATABASE|USE) [^\n]*\n",b"",f.read(),flags=re.MULTILINE)
+	mysql(password,input=schema)
+
+	print("Seeding %u courses, %u users, %u files and %u clicks..." %
+	      (args.courses,args.users,args.files,args.log),file=sys.stderr)
+	seed = subprocess.run([sys.executable,
+			       os.path.join(CORE,"py","swad_bench_seed.py"),
+			       "--courses",str(args.courses),"--users",str(args.users),
+			       "--files",str(args.files),"--log",str(args.log)],
+			      check=True,stdout=subprocess.PIPE).stdout
+	mysql(password,input=seed)
+
+##########################################################################
+# Run the CGI for one request and measure it.
+# Return time in seconds and maximum resident memory in kilobytes
+
+def run_request(cgi,workdir,act_cod,session,pars,num_request):
+	query = "act=%d" % act_cod
+	if pars:
+		query += "&" + pars
+	env = {
+		"PATH": os.environ.get("PATH",""),
+		"SERVER_NAME": "localhost",
+		"HTTP_USER_AGENT": "swad_bench",
+		"HTTP_ACCEPT_ENCODING": "gzip",
+		# Different IPs, so firewall does not ban the test
+		"REMOTE_ADDR": "10.1.%u.%u" % (num_request // 250 % 250,num_request % 250 + 1),
+	}
+	if session:	# Forms of logged users are sent by POST
+		body = ("%s&ses=%s" % (query,session)).encode()
+		env.update({"REQUEST_METHOD": "POST",
+			    "QUERY_STRING": "",
+			    "CONTENT_TYPE": "application/x-www-form-urlencoded",
+			    "CONTENT_LENGTH": str(len(body))})
+	else:
+		body = b""
+		env.update({"REQUEST_METHOD": "GET",
+			    "QUERY_STRING": query})
+
+	start = time.perf_counter()
+	proc = subprocess.Popen([cgi],cwd=workdir,env=env,
+				stdin=subprocess.PIPE,stdout=subprocess.DEVNULL,
+				stderr=subprocess.DEVNULL)
+	proc.stdin.write(body)
+	proc.stdin.close()
+	_,status,rusage = os.wait4(proc.pid,0)
+	elapsed = time.perf_counter() - start
+	proc.returncode = os.waitstatus_to_exitcode(status)	# Already waited
+
+	return elapsed,rusage.ru_maxrss
+
+##########################################################################
+# Percentile by nearest rank
+
+def percentile(values,p):
+	values = sorted(values)
+	return values[max(0,(len(values) * p + 99) // 100 - 1)]
+
+##########################################################################
+
+def main():
+	parser = argparse.ArgumentParser(description="Load test of SWAD CGI")
+	parser.add_argument("--cgi",default=os.path.join(CORE,"swad_bench"))
+	parser.add_argument("--mix",choices=sorted(MIXES),default="all")
+	parser.add_argument("--requests",type=int,default=50,help="requests per action")
+	parser.add_argument("--no-seed",action="store_true",help="reuse database of last test")
+	parser.add_argument("--courses",type=int,default=200)
+	parser.add_argument("--users",type=int,default=10000)
+	parser.add_argument("--files",type=int,default=20000)
+	parser.add_argument("--log",type=int,default=1000000)
+	args = parser.parse_args()
+
+	password = os.environ.get("SWAD_BENCH_PASSWORD")
+	if password is None:
+		sys.exit("Set SWAD_BENCH_PASSWORD to the password of database user %s" % DATABASE_USER)
+	cgi = os.path.abspath(args.cgi)
+	action_codes = get_action_codes()
+	mix = MIXES[args.mix]
+	for act,_,_ in mix:
+		if act not in action_codes:
+			sys.exit("Action %s not found in swad_action_list.c" % act)
+
+	if not args.no_seed:
+		seed_database(password,args)
+
+	# Queries made by the test itself to read the counter
+	before = get_num_questions(password)
+	overhead = get_num_questions(password) - before
+
+	with tempfile.TemporaryDirectory() as workdir:
+		# The CGI reads the password of the database from swad.cfg
+		with open(os.path.join(workdir,"swad.cfg"),"w") as f:
+			f.write("DATABASE_PASSWORD\t%s\n" % password)
+
+		results = {i: ([],[],[]) for i in range(len(mix))}
+		num_request = 0
+		for n in range(args.requests):
+			# Keep sessions open
+			mysql(password,"UPDATE ses_sessions SET LastTime=NOW(),LastRefresh=NOW()")
+			for i,(act,session,pars) in enumerate(mix):
+				before = get_num_questions(password)
+				elapsed,rss = run_request(cgi,workdir,action_codes[act],
+							  session,pars,num_request)
+				queries = get_num_questions(password) - before - overhead
+				times,nqueries,rsss = results[i]
+				times.append(elapsed)
+				nqueries.append(queries)
+				rsss.append(rss)
+				num_request += 1
+			print("\r%u/%u" % (n + 1,args.requests),end="",file=sys.stderr)
+		print(file=sys.stderr)
+
+	print("%-20s %5s %-8s %9s %9s %8s %9s" %
+	      ("Action","Code","User","p50 (ms)","p99 (ms)","Queries","RSS (kB)"))
+	for i,(act,session,pars) in enumerate(mix):
+		times,nqueries,rsss = results[i]
+		print("%-20s %5d %-8s %9.1f %9.1f %8.1f %9d" %
+		      (act,action_codes[act],USERS[session],
+		       percentile(times,50) * 1000.0,percentile(times,99) * 1000.0,
+		       sum(nqueries) / len(nqueries),max(rsss)))
+
+if __name__ == "__main__":
+	main()
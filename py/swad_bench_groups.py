@@ -0,0 +1,232 @@
+#!/usr/bin/python3
+#
+# swad_bench_groups.py: contention test of students changing their groups
+#
+##########################################################################
+#
+#   SWAD (Shared Workspace At a Distance),
+#   is a web platform developed at the University of Granada (Spain),
+#   and used to support university teaching.
+#   Copyright (C) 1999-2026 Antonio Canas-Vargas
+#   University of Granada (SPAIN) (acanas@ugr.es)
+#
+#   This program is free software: you can redistribute it and/or modify
+#   it under the terms of the GNU Affero General Public License as
+#   published by the Free Software Foundation, either version 3 of the
+#   License, or (at your option) any later version.
+#
+#   This program is distributed in the hope that it will be useful,
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#   GNU Affero General Public License for more details.
+#
+#   You should have received a copy of the GNU Affero General Public License
+#   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+##########################################################################
+#
+# Usage: make bench_groups
+#    or: swad_bench_groups.py [--cgi ./swad_bench] [--no-seed]
+#			       [--grp-courses M] [--students N] [--groups G]
+#			       [--seats S] [--concurrency C] [--rounds R]
+#
+# Steps:
+# 1. Database swad_bench is created and seeded as in swad_bench.py,
+#    unless --no-seed is given.
+# 2. In each of the first M courses, a type of group of single enrolment
+#    is created with G open groups of S seats each.
+#    By default there are seats for only half of the students,
+#    so many students compete for the last seats.
+#    N students of those courses get a session in their course.
+# 3. In each of R rounds, every student asks to change to a random group
+#    of their course (action ActChgGrp), with C requests running at once.
+# 4. These are reported: p50 and p99 of the time to serve a request
+#    and requests per second. Then the groups are checked:
+#    the test fails if any group has more students than seats
+#    or any student is in more than one group of the type.
+#
+# Same requirements as swad_bench.py: password of the database user
+# in environment variable SWAD_BENCH_PASSWORD.
+
+import argparse
+import concurrent.futures
+import os
+import random
+import sys
+import tempfile
+import time
+
+import swad_bench
+import swad_bench_seed
+
+CORE = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+SESSION_PREFIX = "BenchGrp"	# Sessions of this test: prefix + 35 digits = 43 chars
+
+##########################################################################
+# Create types of group and groups in the first courses,
+# and open sessions of students of those courses.
+# Return list of (session,GrpTypCod,[GrpCod,...]) for each student
+
+def create_groups_and_sessions(password,args):
+	# Remove groups and sessions of a previous run
+	swad_bench.mysql(password,
+			 "DELETE FROM grp_users;"
+			 " DELETE FROM grp_groups;"
+			 " DELETE FROM grp_types;"
+			 " DELETE FROM ses_sessions WHERE SessionId LIKE '%s%%'" % SESSION_PREFIX)
+
+	# One type of group per course, with the same code as the course
+	grp_cods = {}
+	types = []
+	groups = []
+	for crs in range(1,args.grp_courses + 1):
+		types.append("(%u,%u,'Bench','N','N','N',NOW())" % (crs,crs))
+		grp_cods[crs] = []
+		for g in range(args.groups):
+			grp_cod = (crs - 1) * args.groups + g + 1
+			grp_cods[crs].append(grp_cod)
+			groups.append("(%u,%u,'Group %u',%u,'Y')" % (grp_cod,crs,g + 1,args.seats))
+	swad_bench.mysql(password,
+			 "INSERT INTO grp_types"
+			 " (GrpTypCod,CrsCod,GrpTypName,Mandatory,Multiple,MustBeOpened,OpenTime)"
+			 " VALUES %s;"
+			 " INSERT INTO grp_groups (GrpCod,GrpTypCod,GrpName,MaxStudents,Open)"
+			 " VALUES %s" % (",".join(types),",".join(groups)))
+
+	# Each student competes in only one course
+	students = {}
+	for line in swad_bench.mysql(password,
+				     "SELECT UsrCod,MIN(CrsCod) FROM crs_users"
+				     " WHERE CrsCod<=%u AND Role=%u"
+				     " GROUP BY UsrCod ORDER BY UsrCod" %
+				     (args.grp_courses,swad_bench_seed.ROL_STD)).splitlines():
+		usr,crs = map(int,line.split())
+		students[usr] = crs
+		if len(students) == args.students:
+			break
+	if len(students) < args.students:
+		sys.exit("Only %u students in the first %u courses, seed more users" %
+			 (len(students),args.grp_courses))
+
+	sessions = []
+	rows = []
+	for usr,crs in students.items():
+		ses = "%s%035u" % (SESSION_PREFIX,usr)
+		deg = (crs - 1) // swad_bench_seed.COURSES_PER_DEGREE + 1
+		ctr = (deg - 1) // swad_bench_seed.DEGREES_PER_CENTER + 1
+		rows.append("('%s',%u,'%s',%u,%u,%u,%u,%u,%u,NOW(),NOW())" %
+			    (ses,usr,swad_bench_seed.BENCH_PASSWORD,swad_bench_seed.ROL_STD,
+			     swad_bench_seed.CTY_COD,swad_bench_seed.INS_COD,ctr,deg,crs))
+		sessions.append((ses,crs,grp_cods[crs]))
+	swad_bench.mysql(password,
+			 "INSERT INTO ses_sessions"
+			 " (SessionId,UsrCod,Password,Role,CtyCod,InsCod,CtrCod,DegCod,CrsCod,"
+			 "LastTime,LastRefresh) VALUES %s" % ",".join(rows))
+
+	return sessions
+
+##########################################################################
+# Check that no group is overfull
+# and no student is in two groups of the same type.
+# Return list of errors
+
+def check_groups(password):
+	errors = []
+	for line in swad_bench.mysql(password,
+				     "SELECT grp_groups.GrpCod,grp_groups.MaxStudents,COUNT(*)"
+				     " FROM grp_groups,grp_users"
+				     " WHERE grp_groups.GrpCod=grp_users.GrpCod"
+				     " GROUP BY grp_groups.GrpCod,grp_groups.MaxStudents"
+				     " HAVING COUNT(*)>grp_groups.MaxStudents").splitlines():
+		errors.append("Group %s has %s students and %s seats" %
+			      tuple(line.split()[i] for i in (0,2,1)))
+	for line in swad_bench.mysql(password,
+				     "SELECT grp_users.UsrCod,grp_groups.GrpTypCod,COUNT(*)"
+				     " FROM grp_users,grp_groups"
+				     " WHERE grp_users.GrpCod=grp_groups.GrpCod"
+				     " GROUP BY grp_users.UsrCod,grp_groups.GrpTypCod"
+				     " HAVING COUNT(*)>1").splitlines():
+		errors.append("User %s is in %s groups of type %s" %
+			      tuple(line.split()[i] for i in (0,2,1)))
+	return errors
+
+##########################################################################
+
+def main():
+	parser = argparse.ArgumentParser(description="Contention test of group changes")
+	parser.add_argument("--cgi",default=os.path.join(CORE,"swad_bench"))
+	parser.add_argument("--no-seed",action="store_true",help="reuse database of last test")
+	parser.add_argument("--grp-courses",type=int,default=4,help="courses with groups (M)")
+	parser.add_argument("--students",type=int,default=400,help="students changing groups (N)")
+	parser.add_argument("--groups",type=int,default=4,help="groups per course")
+	parser.add_argument("--seats",type=int,default=0,
+			    help="seats per group (default: for half of the students)")
+	parser.add_argument("--concurrency",type=int,default=16,help="requests at once")
+	parser.add_argument("--rounds",type=int,default=3)
+	parser.add_argument("--seed",type=int,default=1)
+	# Size of synthetic university, as in swad_bench.py
+	parser.add_argument("--courses",type=int,default=200)
+	parser.add_argument("--users",type=int,default=10000)
+	parser.add_argument("--files",type=int,default=1000)
+	parser.add_argument("--log",type=int,default=10000)
+	args = parser.parse_args()
+	if args.grp_courses > args.courses:
+		sys.exit("--grp-courses can not be greater than --courses")
+	if not args.seats:
+		args.seats = max(1,args.students // (2 * args.grp_courses * args.groups))
+
+	password = os.environ.get("SWAD_BENCH_PASSWORD")
+	if password is None:
+		sys.exit("Set SWAD_BENCH_PASSWORD to the password of database user %s" %
+			 swad_bench.DATABASE_USER)
+	cgi = os.path.abspath(args.cgi)
+	act_cod = swad_bench.get_action_codes()["ActChgGrp"]
+	rnd = random.Random(args.seed)
+
+	if not args.no_seed:
+		swad_bench.seed_database(password,args)
+	sessions = create_groups_and_sessions(password,args)
+
+	times = []
+	with tempfile.TemporaryDirectory() as workdir:
+		# The CGI reads the password of the database from swad.cfg
+		with open(os.path.join(workdir,"swad.cfg"),"w") as f:
+			f.write("DATABASE_PASSWORD\t%s\n" % password)
+
+		num_request = 0
+		start = time.perf_counter()
+		with concurrent.futures.ThreadPoolExecutor(max_workers=args.concurrency) as pool:
+			for r in range(args.rounds):
+				# Keep sessions open
+				swad_bench.mysql(password,
+						 "UPDATE ses_sessions SET LastTime=NOW(),LastRefresh=NOW()")
+				futures = []
+				for ses,crs,grp_cods in rnd.sample(sessions,len(sessions)):
+					pars = "GrpCod%u=%u" % (crs,rnd.choice(grp_cods))	# GrpTypCod = CrsCod
+					futures.append(pool.submit(swad_bench.run_request,cgi,workdir,
+								   act_cod,ses,pars,num_request))
+					num_request += 1
+				times += [future.result()[0] for future in futures]
+				print("\r%u/%u" % (r + 1,args.rounds),end="",file=sys.stderr)
+		elapsed = time.perf_counter() - start
+		print(file=sys.stderr)
+
+	enroled = int(swad_bench.mysql(password,"SELECT COUNT(*) FROM grp_users"))
+	print("%u students in %u courses, %u groups of %u seats, %u requests at once" %
+	      (len(sessions),args.grp_courses,args.grp_courses * args.groups,args.seats,
+	       args.concurrency))
+	print("%9s %9s %10s %9s" % ("p50 (ms)","p99 (ms)","Requests/s","Enroled"))
+	print("%9.1f %9.1f %10.1f %9u" %
+	      (swad_bench.percentile(times,50) * 1000.0,
+	       swad_bench.percentile(times,99) * 1000.0,
+	       len(times) / elapsed,enroled))
+
+	errors = check_groups(password)
+	for error in errors:
+		print(error,file=sys.stderr)
+	if errors:
+		sys.exit(1)
+
+if __name__ == "__main__":
+	main()
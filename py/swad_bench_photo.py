@@ -0,0 +1,122 @@
+#!/usr/bin/python3
+#
+# swad_bench_photo.py: benchmark of the program that computes average and median photos
+#
+##########################################################################
+#
+#   SWAD (Shared Workspace At a Distance),
+#   is a web platform developed at the University of Granada (Spain),
+#   and used to support university teaching.
+#   Copyright (C) 1999-2026 Antonio Canas-Vargas
+#   University of Granada (SPAIN) (acanas@ugr.es)
+#
+#   This program is free software: you can redistribute it and/or modify
+#   it under the terms of the GNU Affero General Public License as
+#   published by the Free Software Foundation, either version 3 of the
+#   License, or (at your option) any later version.
+#
+#   This program is distributed in the hope that it will be useful,
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#   GNU Affero General Public License for more details.
+#
+#   You should have received a copy of the GNU Affero General Public License
+#   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+##########################################################################
+#
+# Usage: make bench_photo
+#    or: swad_bench_photo.py [--program foto_promedio/foto_promedio_mediana]
+#			      [--photos N,N,...] [--width W] [--height H]
+#			      [--runs N] [--seed N]
+#
+# For each number of photos, a synthetic degree is generated in a temporary
+# directory: photos of the size of students' photos (Pho_PHOTO_REAL_WIDTH x
+# Pho_PHOTO_REAL_HEIGHT) with random sexes, and the list of photos
+# "<sex> <file>" that Pho_CalcPhotoDegree gives to the program.
+# The program is run --runs times and these are reported:
+# time of the best run, photos per second and maximum resident memory.
+#
+# Photos are written as binary PPM, which needs no library to be written
+# and is read by OpenCV. Real photos are JPEG, so decoding takes
+# a larger part of the time in production.
+
+import argparse
+import os
+import random
+import subprocess
+import sys
+import tempfile
+import time
+
+CORE = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+SEXES = ("unknown","female","male")	# Same as Usr_StringsSexDB
+NUM_TEMPLATES = 16			# Different random images used to build photos
+
+##########################################################################
+# Write photos and list of photos of a synthetic degree.
+# Each photo is a rotation of one of a few random images,
+# so photos are different without generating every byte
+
+def write_degree(workdir,num_photos,width,height,rnd):
+	header = b"P6\n%u %u\n255\n" % (width,height)
+	size = width * height * 3
+	templates = [bytes(rnd.getrandbits(8) for _ in range(size))
+		     for _ in range(NUM_TEMPLATES)]
+	list_path = os.path.join(workdir,"photos.txt")
+	with open(list_path,"w") as lst:
+		for n in range(num_photos):
+			template = templates[n % NUM_TEMPLATES]
+			shift = rnd.randrange(size)
+			path = os.path.join(workdir,"%u.ppm" % n)
+			with open(path,"wb") as f:
+				f.write(header + template[shift:] + template[:shift])
+			lst.write("%s %s\n" % (rnd.choice(SEXES),path))
+	return list_path
+
+##########################################################################
+# Run the program once.
+# Return time in seconds and maximum resident memory in kilobytes
+
+def run_program(program,workdir,list_path):
+	start = time.perf_counter()
+	proc = subprocess.Popen([program,list_path,
+				 os.path.join(workdir,"mdn"),os.path.join(workdir,"avg")],
+				cwd=workdir,stdout=subprocess.DEVNULL)
+	_,status,rusage = os.wait4(proc.pid,0)
+	elapsed = time.perf_counter() - start
+	if os.waitstatus_to_exitcode(status):
+		sys.exit("%s failed with exit code %d" % (program,os.waitstatus_to_exitcode(status)))
+
+	return elapsed,rusage.ru_maxrss
+
+##########################################################################
+
+def main():
+	parser = argparse.ArgumentParser(description="Benchmark of average and median photos")
+	parser.add_argument("--program",default=os.path.join(CORE,"foto_promedio",
+							       "foto_promedio_mediana"))
+	parser.add_argument("--photos",default="100,500,2000",help="numbers of photos, separated by commas")
+	parser.add_argument("--width",type=int,default=186)	# Pho_PHOTO_REAL_WIDTH
+	parser.add_argument("--height",type=int,default=248)	# Pho_PHOTO_REAL_HEIGHT
+	parser.add_argument("--runs",type=int,default=3)
+	parser.add_argument("--seed",type=int,default=1)
+	args = parser.parse_args()
+
+	program = os.path.abspath(args.program)
+	if not os.access(program,os.X_OK):
+		sys.exit("%s not found, build it with make -C foto_promedio" % program)
+	rnd = random.Random(args.seed)
+
+	print("%8s %10s %10s %10s" % ("Photos","Time (s)","Photos/s","RSS (MB)"))
+	for num_photos in [int(n) for n in args.photos.split(",")]:
+		with tempfile.TemporaryDirectory() as workdir:
+			list_path = write_degree(workdir,num_photos,args.width,args.height,rnd)
+			runs = [run_program(program,workdir,list_path) for _ in range(args.runs)]
+		best = min(elapsed for elapsed,_ in runs)
+		print("%8u %10.2f %10.1f %10.1f" %
+		      (num_photos,best,num_photos / best,max(rss for _,rss in runs) / 1024.0))
+
+if __name__ == "__main__":
+	main()
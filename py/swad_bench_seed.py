@@ -0,0 +1,224 @@
+#!/usr/bin/python3
+#
+# swad_bench_seed.py: generate SQL to fill a database with a synthetic university
+#
+##########################################################################
+#
+#   SWAD (Shared Workspace At a Distance),
+#   is a web platform developed at the University of Granada (Spain),
+#   and used to support university teaching.
+#   Copyright (C) 1999-2026 Antonio Canas-Vargas
+#   University of Granada (SPAIN) (acanas@ugr.es)
+#
+#   This program is free software: you can redistribute it and/or modify
+#   it under the terms of the GNU Affero General Public License as
+#   published by the Free Software Foundation, either version 3 of the
+#   License, or (at your option) any later version.
+#
+#   This program is distributed in the hope that it will be useful,
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#   GNU Affero General Public License for more details.
+#
+#   You should have received a copy of the GNU Affero General Public License
+#   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+##########################################################################
+#
+# Usage: swad_bench_seed.py [--courses N] [--users N] [--files N] [--log N]
+#			    [--seed N] > seed.sql
+#
+# SQL is written to standard output, to be loaded in an empty database
+# created with sql/swad.sql. The same seed always gives the same data.
+#
+# One country with one institution, and centers, degrees and courses
+# depending on the number of courses. 2% of users are teachers;
+# each teacher teaches 2 courses and each student is enroled in 6.
+# Files are distributed among documents zones of courses.
+# Clicks are spread over the last year; clicks of the last days
+# are also stored in the recent log.
+#
+# Two sessions are opened, one of a student and one of a teacher,
+# both in the first course, so actions of logged users can be requested:
+#	ses=BENCH_SES_STD (student) and ses=BENCH_SES_TCH (teacher)
+
+import argparse
+import datetime
+import random
+import sys
+
+# Values used also by swad_bench.py
+CTY_COD = 724
+INS_COD = 1
+BENCH_PASSWORD = "B" * 86		# Encrypted password of all users
+BENCH_SES_STD = "BenchSessionStudent" + "S" * 24	# 43 chars
+BENCH_SES_TCH = "BenchSessionTeacher" + "T" * 24	# 43 chars
+
+# Values of enumerations in the C code
+ROL_STD = 3		# Rol_STD
+ROL_TCH = 5		# Rol_TCH
+BRW_ADMI_DOC_CRS = 3	# Brw_ADMI_DOC_CRS
+BRW_IS_FILE = 1		# Brw_IS_FILE
+DAYS_IN_RECENT_LOG = 15	# Cfg_DAYS_IN_RECENT_LOG
+
+# Same order as in Lan_STR_LANG_ID
+LANGUAGES = ["ca","de","en","es","fr","gn","it","pl","pt","tr"]
+
+COURSES_PER_DEGREE = 40
+DEGREES_PER_CENTER = 5
+COURSES_PER_STUDENT = 6
+COURSES_PER_TEACHER = 2
+ROWS_PER_INSERT = 1000
+
+# Actions found in log: frequent ones in real servers
+LOG_ACTIONS = [0,2,25,84,95,345,408,678,679,847,861,990,1009,1011,1622]
+
+##########################################################################
+# Write INSERT statements of many rows each
+
+def insert(table,columns,rows):
+	for i in range(0,len(rows),ROWS_PER_INSERT):
+		print("INSERT INTO %s (%s) VALUES" % (table,",".join(columns)))
+		print(",\n".join("(" + ",".join(sql_value(v) for v in row) + ")"
+				 for row in rows[i:i + ROWS_PER_INSERT]) + ";")
+
+class Raw(str):		# SQL expression, not quoted
+	pass
+
+def sql_value(v):
+	if isinstance(v,Raw):
+		return v
+	if isinstance(v,str):
+		return "'" + v.replace("\\","\\\\").replace("'","\\'") + "'"
+	return str(v)
+
+##########################################################################
+# Generate hierarchy: country, institution, centers, degrees and courses
+
+def gen_hierarchy(num_courses):
+	num_degrees = (num_courses + COURSES_PER_DEGREE - 1) // COURSES_PER_DEGREE
+	num_centers = (num_degrees + DEGREES_PER_CENTER - 1) // DEGREES_PER_CENTER
+
+	insert("cty_countrs",
+	       ["CtyCod","Alpha2","MapAttribution"] +
+	       ["Name_" + l for l in LANGUAGES] + ["WWW_" + l for l in LANGUAGES],
+	       [[CTY_COD,"ES",""] + ["Country"] * len(LANGUAGES) + [""] * len(LANGUAGES)])
+	insert("ins_instits",
+	       ["InsCod","CtyCod","Status","RequesterUsrCod","ShortName","FullName","WWW"],
+	       [[INS_COD,CTY_COD,0,-1,"Bench","Bench University",""]])
+	insert("ctr_centers",
+	       ["CtrCod","InsCod","PlcCod","Status","RequesterUsrCod",
+		"ShortName","FullName","WWW","PhotoAttribution"],
+	       [[c,INS_COD,-1,0,-1,"Center %u" % c,"Synthetic center %u" % c,"",""]
+		for c in range(1,num_centers + 1)])
+	insert("deg_types",["DegTypCod","DegTypName"],[[1,"Degree"]])
+	insert("deg_degrees",
+	       ["DegCod","CtrCod","DegTypCod","Status","RequesterUsrCod",
+		"ShortName","FullName","WWW"],
+	       [[d,(d - 1) // DEGREES_PER_CENTER + 1,1,0,-1,
+		 "Degree %u" % d,"Synthetic degree %u" % d,""]
+		for d in range(1,num_degrees + 1)])
+	insert("crs_courses",
+	       ["CrsCod","DegCod","Year","InsCrsCod","Status","RequesterUsrCod",
+		"ShortName","FullName"],
+	       [[c,(c - 1) // COURSES_PER_DEGREE + 1,(c - 1) % 4 + 1,"%07u" % c,0,-1,
+		 "Course %u" % c,"Synthetic course %u" % c]
+		for c in range(1,num_courses + 1)])
+
+##########################################################################
+# Generate users and their enrolments. Return list of teachers' codes
+
+def gen_users(num_users,num_courses):
+	num_teachers = max(1,num_users // 50)
+
+	insert("usr_data",
+	       ["UsrCod","EncryptedUsrCod","Password","Surname1","Surname2",
+		"FirstName","Sex","Comments"],
+	       [[u,"BenchUsr%035u" % u,BENCH_PASSWORD,"Surname%u" % u,"",
+		 "Name%u" % u,random.choice(("female","male")),""]
+		for u in range(1,num_users + 1)])
+
+	rows = []
+	for u in range(1,num_users + 1):
+		if u <= num_teachers:
+			role = ROL_TCH
+			n = COURSES_PER_TEACHER
+		else:
+			role = ROL_STD
+			n = COURSES_PER_STUDENT
+		courses = {1} if u in (1,num_teachers + 1) else set()	# Users in sessions
+		while len(courses) < min(n,num_courses):
+			courses.add(random.randint(1,num_courses))
+		rows += [[c,u,role,"Y"] for c in sorted(courses)]
+	insert("crs_users",["CrsCod","UsrCod","Role","Accepted"],rows)
+
+	return list(range(1,num_teachers + 1))
+
+##########################################################################
+# Generate files in documents zones of courses
+
+def gen_files(num_files,num_courses,teachers):
+	insert("brw_files",
+	       ["FileBrowser","Cod","ZoneUsrCod","PublisherUsrCod","FileType",
+		"Path","Hidden","Public","License"],
+	       [[BRW_ADMI_DOC_CRS,random.randint(1,num_courses),-1,
+		 random.choice(teachers),BRW_IS_FILE,
+		 "unit%u/file%u.pdf" % (f % 10 + 1,f),"N","N",0]
+		for f in range(1,num_files + 1)])
+
+##########################################################################
+# Generate clicks in log and recent log
+
+def gen_log(num_clicks,num_users,num_courses):
+	now = datetime.datetime.now().replace(microsecond=0)
+	columns = ["LogCod","ActCod","CtyCod","InsCod","CtrCod","DegCod","CrsCod",
+		   "UsrCod","Role","ClickTime","TimeToGenerate","TimeToSend","IP"]
+	rows = []
+	for l in range(1,num_clicks + 1):
+		crs = random.randint(1,num_courses)
+		deg = (crs - 1) // COURSES_PER_DEGREE + 1
+		ctr = (deg - 1) // DEGREES_PER_CENTER + 1
+		# Older clicks have lower codes, as in a real log
+		ago = (num_clicks - l) * 365 * 24 * 3600 // num_clicks
+		rows.append([l,random.choice(LOG_ACTIONS),CTY_COD,INS_COD,ctr,deg,crs,
+			     random.randint(1,num_users),ROL_STD,
+			     (now - datetime.timedelta(seconds=ago)).strftime("%Y-%m-%d %H:%M:%S"),
+			     random.randint(1000,200000),random.randint(100,20000),
+			     "10.0.%u.%u" % (l // 256 % 256,l % 256)])
+	insert("log",columns,rows)
+	recent = (now - datetime.timedelta(days=DAYS_IN_RECENT_LOG)).strftime("%Y-%m-%d %H:%M:%S")
+	insert("log_recent",columns,[row for row in rows if row[9] >= recent])
+
+##########################################################################
+# Open sessions of a student and a teacher in the first course
+
+def gen_sessions(teachers):
+	insert("ses_sessions",
+	       ["SessionId","UsrCod","Password","Role",
+		"CtyCod","InsCod","CtrCod","DegCod","CrsCod","LastTime","LastRefresh"],
+	       [[ses,usr,BENCH_PASSWORD,role,CTY_COD,INS_COD,1,1,1,Raw("NOW()"),Raw("NOW()")]
+		for ses,usr,role in ((BENCH_SES_STD,len(teachers) + 1,ROL_STD),
+				     (BENCH_SES_TCH,teachers[0],ROL_TCH))])
+
+##########################################################################
+
+def main():
+	parser = argparse.ArgumentParser(description="Generate SQL with a synthetic university")
+	parser.add_argument("--courses",type=int,default=200)
+	parser.add_argument("--users",type=int,default=10000)
+	parser.add_argument("--files",type=int,default=20000)
+	parser.add_argument("--log",type=int,default=1000000)
+	parser.add_argument("--seed",type=int,default=1)
+	args = parser.parse_args()
+	if args.courses < 1 or args.users < 2 or args.log < 1:
+		sys.exit("At least 1 course, 2 users and 1 click are needed")
+
+	random.seed(args.seed)
+	gen_hierarchy(args.courses)
+	teachers = gen_users(args.users,args.courses)
+	gen_files(args.files,args.courses,teachers)
+	gen_log(args.log,args.users,args.courses)
+	gen_sessions(teachers)
+
+if __name__ == "__main__":
+	main()
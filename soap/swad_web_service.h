@@ -81,6 +81,15 @@ struct swad__getCoursesOutput
    struct swad__coursesArray coursesArray;
   };
 
+/* getCoursesIfModified */
+struct swad__getCoursesIfModifiedOutput
+  {
+   int modified;	// 0 ==> not modified since the version given, no courses returned
+   int version;		// current version of the list of courses
+   int numCourses;
+   struct swad__coursesArray coursesArray;
+  };
+
 /* getCourseInfo */
 struct swad__getCourseInfoOutput
   {
@@ -170,6 +179,15 @@ struct swad__getNotificationsOutput
    struct swad__notificationsArray notificationsArray;
   };
 
+/* getNotificationsIfModified */
+struct swad__getNotificationsIfModifiedOutput
+  {
+   int modified;	// 0 ==> not modified since the version given, no notifications returned
+   int version;		// current version of the notifications since beginTime
+   int numNotifications;
+   struct swad__notificationsArray notificationsArray;
+  };
+
 /* markNotificationsAsRead */
 struct swad__markNotificationsAsReadOutput
   {
@@ -340,6 +358,15 @@ struct swad__getUsersOutput
    struct swad__usersArray usersArray;
   };
 
+/* getUsersIfModified */
+struct swad__getUsersIfModifiedOutput
+  {
+   int modified;	// 0 ==> not modified since the version given, no users returned
+   int version;		// current version of the users of the course
+   int numUsers;
+   struct swad__usersArray usersArray;
+  };
+
 /* getAttendanceEvents */
 struct swad__attendanceEvent
   {
@@ -415,6 +442,14 @@ struct swad__getDirectoryTreeOutput
    char *tree;		// full tree in xml format
   };
 
+/* getDirectoryTreeIfModified */
+struct swad__getDirectoryTreeIfModifiedOutput
+  {
+   int modified;	// 0 ==> not modified since the version given, no tree returned
+   int version;		// current version of the tree
+   char *tree;		// full tree in xml format
+  };
+
 /* getFile */
 struct swad__getFileOutput
   {
@@ -502,6 +537,8 @@ int swad__getNewPassword (char *userID,char *appKey,
 /* Courses */
 int swad__getCourses (char *wsKey,
                       struct swad__getCoursesOutput *getCoursesOut);
+int swad__getCoursesIfModified (char *wsKey,int version,
+                                struct swad__getCoursesIfModifiedOutput *getCoursesIfModifiedOut);
 int swad__getCourseInfo (char *wsKey,int courseCode,char *infoType,
                          struct swad__getCourseInfoOutput *getCourseInfoOut);
 
@@ -516,6 +553,8 @@ int swad__sendMyGroups (char *wsKey,int courseCode,char *myGroups,
 /* File browsers */
 int swad__getDirectoryTree (char *wsKey,int courseCode,int groupCode,int treeCode,
                             struct swad__getDirectoryTreeOutput *getDirectoryTreeOut);
+int swad__getDirectoryTreeIfModified (char *wsKey,int courseCode,int groupCode,int treeCode,int version,
+                                      struct swad__getDirectoryTreeIfModifiedOutput *getDirectoryTreeIfModifiedOut);
 int swad__getFile (char *wsKey,int fileCode,
                    struct swad__getFileOutput *getFileOut);
 int swad__getMarks (char *wsKey,int fileCode,
@@ -542,6 +581,8 @@ int swad__answerMatchQuestion (char *wsKey,int courseCode,int gameCode,int match
 /* List of users */
 int swad__getUsers (char *wsKey,int courseCode,char *groups,int userRole,
                     struct swad__getUsersOutput *getUsersOut);
+int swad__getUsersIfModified (char *wsKey,int courseCode,char *groups,int userRole,int version,
+                              struct swad__getUsersIfModifiedOutput *getUsersIfModifiedOut);
 int swad__findUsers (char *wsKey,int courseCode,char *filter,int userRole,
                      struct swad__getUsersOutput *getUsersOut);
 
@@ -560,6 +601,8 @@ int swad__sendAttendanceUsers (char *wsKey,int attendanceEventCode,char *users,i
 /* Notifications */
 int swad__getNotifications (char *wsKey,long beginTime,
                             struct swad__getNotificationsOutput *getNotificationsOut);
+int swad__getNotificationsIfModified (char *wsKey,long beginTime,int version,
+                                      struct swad__getNotificationsIfModifiedOutput *getNotificationsIfModifiedOut);
 int swad__markNotificationsAsRead (char *wsKey,char *notifications,
                                    struct swad__markNotificationsAsReadOutput *markNotificationAsReadOut);
 
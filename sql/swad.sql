@@ -212,6 +212,23 @@ CREATE TABLE IF NOT EXISTS brw_files (
 	INDEX(PublisherUsrCod)
 	) ENGINE=MyISAM;
 --
+-- Table brw_folders: stores the number of subfolders, files and bytes directly inside each folder of the file zones
+--
+CREATE TABLE IF NOT EXISTS brw_folders (
+	FileBrowser TINYINT NOT NULL,
+	Cod INT NOT NULL DEFAULT -1,
+	ZoneUsrCod INT NOT NULL DEFAULT -1,
+	Path TEXT COLLATE latin1_bin NOT NULL,
+	PathHash BINARY(16) NOT NULL,
+	NumFolders INT NOT NULL DEFAULT 0,
+	NumFiles INT NOT NULL DEFAULT 0,
+	Size BIGINT NOT NULL DEFAULT 0,
+	VerifyTime DATETIME NOT NULL,
+	UNIQUE INDEX(FileBrowser,Cod,ZoneUsrCod,PathHash),
+	INDEX(ZoneUsrCod),
+	INDEX(VerifyTime)
+	) ENGINE=MyISAM;
+--
 -- Table brw_last: stores the last click of every user in each file browser zone
 --
 CREATE TABLE IF NOT EXISTS brw_last (
@@ -621,6 +638,7 @@ CREATE TABLE IF NOT EXISTS exa_prints (
 	NumQsts INT NOT NULL DEFAULT 0,
 	NumQstsNotBlank INT NOT NULL DEFAULT 0,
 	Score DOUBLE PRECISION NOT NULL DEFAULT 0,
+	Seed BIGINT UNSIGNED NOT NULL DEFAULT 0,
 	UNIQUE INDEX(PrnCod),
 	UNIQUE INDEX(SesCod,UsrCod)
 	) ENGINE=MyISAM;
@@ -776,6 +794,7 @@ CREATE TABLE IF NOT EXISTS for_read (
 	ThrCod INT NOT NULL,
 	UsrCod INT NOT NULL,
 	ReadTime DATETIME NOT NULL,
+	NumReadPsts INT NOT NULL DEFAULT 0,
 	UNIQUE INDEX(ThrCod,UsrCod)
 	) ENGINE=MyISAM;
 --
@@ -787,6 +806,9 @@ CREATE TABLE IF NOT EXISTS for_threads (
 	HieCod INT NOT NULL DEFAULT -1,
 	FirstPstCod INT NOT NULL,
 	LastPstCod INT NOT NULL,
+	NumPsts INT NOT NULL DEFAULT 0,
+	NumWriters INT NOT NULL DEFAULT 0,
+	NumReaders INT NOT NULL DEFAULT 0,
 	UNIQUE INDEX(ThrCod),
 	INDEX(ForumType),
 	INDEX(HieCod),
@@ -1474,6 +1496,25 @@ CREATE TABLE IF NOT EXISTS rub_scores (
 	UNIQUE INDEX(Type,Cod,UsrCod,CriCod)
 	) ENGINE=MyISAM;
 --
+-- Table sch_indexes: stores the state of building of each trigram index used to search
+--
+CREATE TABLE IF NOT EXISTS sch_indexes (
+	Idx TINYINT NOT NULL,
+	LastCod INT NOT NULL DEFAULT -1,
+	Ready ENUM('N','Y') NOT NULL DEFAULT 'N',
+	UNIQUE INDEX(Idx)
+	) ENGINE=MyISAM;
+--
+-- Table sch_trigrams: stores the trigrams of names of users, institutions, centers, degrees, courses and files, used to search
+--
+CREATE TABLE IF NOT EXISTS sch_trigrams (
+	Idx TINYINT NOT NULL,
+	Trigram CHAR(3) COLLATE latin1_bin NOT NULL,
+	Cod INT NOT NULL,
+	UNIQUE INDEX(Idx,Trigram,Cod),
+	INDEX(Idx,Cod)
+	) ENGINE=MyISAM;
+--
 -- Table ses_params: stores some hidden parameters passed from a page to another using database instead of forms
 --
 CREATE TABLE IF NOT EXISTS ses_params (
@@ -94,9 +94,12 @@ cp -f /home/acanas/swad/swad/swad /var/www/cgi-bin/
 #include <dirent.h>		// For scandir, etc.
 #include <linux/limits.h>	// For PATH_MAX
 #include <stddef.h>		// For NULL
+#include <stdio.h>		// For open_memstream
+#include <stdlib.h>		// For free, qsort
 #include <string.h>
 #include <stdsoap2.h>
 #include <sys/stat.h>		// For lstat
+#include <zlib.h>		// For crc32
 
 #include "soap/soapH.h"		// gSOAP header
 #include "soap/swad.nsmap"	// Namespaces map used
@@ -199,6 +202,10 @@ static const char *API_Functions[1 + API_NUM_FUNCTIONS] =
    [API_sendMyLocation		] = "sendMyLocation",		// 33
    [API_getLastLocation		] = "getLastLocation",		// 34
    [API_getAvailableRoles	] = "getAvailableRoles",	// 35
+   [API_getCoursesIfModified	] = "getCoursesIfModified",	// 36
+   [API_getUsersIfModified	] = "getUsersIfModified",	// 37
+   [API_getNotificationsIfModified] = "getNotificationsIfModified",	// 38
+   [API_getDirectoryTreeIfModified] = "getDirectoryTreeIfModified",	// 39
   };
 
 /* Web service roles (they do not match internal swad-core roles) */
@@ -241,6 +248,9 @@ static int API_GetPlgCodFromAppKey (struct soap *soap,
 static int API_CheckIdSession (struct soap *soap,
 			       const char *IdSes);
 static int API_CheckAPIKey (char APIKey[API_BYTES_KEY + 1]);
+static int API_GetVersionFromStamp (unsigned long Stamp);
+static unsigned long API_AddUsrsRequestToStamp (unsigned long Stamp,int userRole);
+static int API_CompareGrpCods (const void *p1,const void *p2);
 
 static int API_CheckCourseAndGroupCodes (struct soap *soap,
 					 long HieCod,long GrpCod);
@@ -256,16 +266,28 @@ static int API_CheckParsNewAccount (char *NewNickWithArr,		// Input
                                     char *NewPlainPassword,		// Input
                                     char NewEncryptedPassword[Pwd_BYTES_ENCRYPTED_PASSWORD + 1]);	// Output
 
+static int API_GetCourses (struct soap *soap,
+                           char *wsKey,int version,
+                           int *modified,int *currentVersion,
+                           struct swad__getCoursesOutput *getCoursesOut);
+
 static int API_WriteSyllabusIntoHTMLBuffer (struct soap *soap,
 					    Inf_Type_t InfoType,
 					    char **HTMLBuffer);
 static int API_WritePlainTextIntoHTMLBuffer (struct soap *soap,
 					     Inf_Type_t InfoType,
                                              char **HTMLBuffer);
+static int API_WriteRichTextIntoHTMLBuffer (struct soap *soap,
+					    Inf_Type_t InfoType,
+					    char **HTMLBuffer);
 static int API_WritePageIntoHTMLBuffer (struct soap *soap,
 				        Inf_Type_t InfoType,
                                         char **HTMLBuffer);
 
+static int API_GetUsers (struct soap *soap,
+                         char *wsKey,int courseCode,char *groups,int userRole,int version,
+                         int *modified,int *currentVersion,
+                         struct swad__getUsersOutput *getUsersOut);
 static void API_CopyListUsers (struct soap *soap,
                                Rol_Role_t Role,
 			       struct swad__getUsersOutput *getUsersOut);
@@ -277,6 +299,10 @@ static void API_GetListGrpsInAttendanceEventFromDB (struct soap *soap,
 						    long AttCod,char **ListGroups);
 static void API_GetLstGrpsSel (const char *Groups);
 
+static int API_GetNotifications (struct soap *soap,
+                                 char *wsKey,long beginTime,int version,
+                                 int *modified,int *currentVersion,
+                                 struct swad__getNotificationsOutput *getNotificationsOut);
 static int API_GetMyLanguage (struct soap *soap);
 
 static int API_SendMessageToUsr (long OriginalMsgCod,
@@ -299,6 +325,10 @@ static int API_GetTstQuestionTags (struct soap *soap,
 static void API_GetListGrpsInMatchFromDB (struct soap *soap,
 					  long MchCod,char **ListGroups);
 
+static int API_GetDirectoryTree (struct soap *soap,
+                                 char *wsKey,int courseCode,int groupCode,int treeCode,int version,
+                                 int *modified,int *currentVersion,
+                                 struct swad__getDirectoryTreeOutput *getDirectoryTreeOut);
 static void API_ListDir (FILE *XML,unsigned Level,const char *Path,const char *PathInTree);
 static HidVis_HiddenOrVisible_t API_WriteRowFileBrowser (FILE *XML,unsigned Level,
 							 Brw_FileType_t FileType,
@@ -484,6 +514,54 @@ static int API_CheckAPIKey (char APIKey[API_BYTES_KEY + 1])
    return SOAP_OK;
   }
 
+/*****************************************************************************/
+/************** Get version to be sent to client from a stamp ****************/
+/*****************************************************************************/
+// Version 0 is never returned, so clients without a copy
+// can use it to request full data
+
+static int API_GetVersionFromStamp (unsigned long Stamp)
+  {
+   int Version = (int) (Stamp & 0x7FFFFFFFUL);
+
+   return Version ? Version :
+		    1;
+  }
+
+/*****************************************************************************/
+/********* Add role and groups requested to version stamp of users ***********/
+/*****************************************************************************/
+// The same users in a course give different versions for different
+// roles or groups requested, so a version got for some users
+// is never taken as valid for others.
+// Groups are sorted, so their order in the request does not matter
+
+static unsigned long API_AddUsrsRequestToStamp (unsigned long Stamp,int userRole)
+  {
+   Stamp = crc32 (Stamp,(const Bytef *) &userRole,sizeof (userRole));
+
+   if (Gbl.Crs.Grps.LstGrpsSel.NumGrps)
+     {
+      qsort (Gbl.Crs.Grps.LstGrpsSel.GrpCods,(size_t) Gbl.Crs.Grps.LstGrpsSel.NumGrps,
+	     sizeof (*Gbl.Crs.Grps.LstGrpsSel.GrpCods),API_CompareGrpCods);
+      Stamp = crc32 (Stamp,(const Bytef *) Gbl.Crs.Grps.LstGrpsSel.GrpCods,
+		     (uInt) (Gbl.Crs.Grps.LstGrpsSel.NumGrps *
+			     sizeof (*Gbl.Crs.Grps.LstGrpsSel.GrpCods)));
+     }
+
+   return Stamp;
+  }
+
+static int API_CompareGrpCods (const void *p1,const void *p2)
+  {
+   long GrpCod1 = *((const long *) p1);
+   long GrpCod2 = *((const long *) p2);
+
+   return GrpCod1 < GrpCod2 ? -1 :
+	  GrpCod1 > GrpCod2 ?  1 :
+			       0;
+  }
+
 /*****************************************************************************/
 /** Check if a course code and a group code are valid and exist in database **/
 /*****************************************************************************/
@@ -1164,6 +1242,54 @@ int swad__getNewPassword (struct soap *soap,
 int swad__getCourses (struct soap *soap,
                       char *wsKey,					// input
                       struct swad__getCoursesOutput *getCoursesOut)	// output
+  {
+   int modified;
+   int currentVersion;
+
+   /***** Initializations *****/
+   API_Set_gSOAP_RuntimeEnv (soap);
+   Gbl.WebService.Function = API_getCourses;
+
+   /***** Get courses *****/
+   return API_GetCourses (soap,wsKey,0,&modified,&currentVersion,getCoursesOut);
+  }
+
+/*****************************************************************************/
+/*********** Return courses of a user if modified since a version ************/
+/*****************************************************************************/
+
+int swad__getCoursesIfModified (struct soap *soap,
+                                char *wsKey,int version,						// input
+                                struct swad__getCoursesIfModifiedOutput *getCoursesIfModifiedOut)	// output
+  {
+   struct swad__getCoursesOutput getCoursesOut;
+   int ReturnCode;
+
+   /***** Initializations *****/
+   API_Set_gSOAP_RuntimeEnv (soap);
+   Gbl.WebService.Function = API_getCoursesIfModified;
+
+   /***** Get courses if modified *****/
+   if ((ReturnCode = API_GetCourses (soap,wsKey,version,
+				     &getCoursesIfModifiedOut->modified,
+				     &getCoursesIfModifiedOut->version,
+				     &getCoursesOut)) != SOAP_OK)
+      return ReturnCode;
+   getCoursesIfModifiedOut->numCourses   = getCoursesOut.numCourses;
+   getCoursesIfModifiedOut->coursesArray = getCoursesOut.coursesArray;
+
+   return SOAP_OK;
+  }
+
+/*****************************************************************************/
+/*************** Get courses of a user if modified since a version ***********/
+/*****************************************************************************/
+// If version is 0, courses are always returned
+
+static int API_GetCourses (struct soap *soap,
+                           char *wsKey,int version,
+                           int *modified,int *currentVersion,
+                           struct swad__getCoursesOutput *getCoursesOut)
   {
    int ReturnCode;
    MYSQL_RES *mysql_res;
@@ -1172,10 +1298,6 @@ int swad__getCourses (struct soap *soap,
    unsigned NumCrss;
    Rol_Role_t Role;
 
-   /***** Initializations *****/
-   API_Set_gSOAP_RuntimeEnv (soap);
-   Gbl.WebService.Function = API_getCourses;
-
    /***** Check web service key *****/
    if ((ReturnCode = API_CheckAPIKey (wsKey)) != SOAP_OK)
       return ReturnCode;
@@ -1193,6 +1315,18 @@ int swad__getCourses (struct soap *soap,
    Gbl.Usrs.Me.Logged = true;
    Gbl.Usrs.Me.Role.Logged = Gbl.Usrs.Me.UsrDat.Roles.InCurrentCrs;
 
+   /***** Check if my courses have been modified since client version *****/
+   *currentVersion = API_GetVersionFromStamp (API_DB_GetVersionOfUsrCourses (Gbl.Usrs.Me.UsrDat.UsrCod));
+   if (version == *currentVersion)
+     {
+      *modified = 0;
+      getCoursesOut->numCourses          =
+      getCoursesOut->coursesArray.__size = 0;
+      getCoursesOut->coursesArray.__ptr  = NULL;
+      return SOAP_OK;
+     }
+   *modified = 1;
+
    /***** Query my courses from database *****/
    NumCrss = Enr_DB_GetMyCoursesNames (&mysql_res);
 
@@ -1352,9 +1486,11 @@ int swad__getCourseInfo (struct soap *soap,
 	   }
 	 break;
       case Inf_PLAIN_TEXT:	// Plain text
-      case Inf_RICH_TEXT:	// Rich text (not yet available)
 	 Result = API_WritePlainTextIntoHTMLBuffer (soap,Info.Type,&(getCourseInfo->infoTxt));
          break;
+      case Inf_RICH_TEXT:	// Rich text, rendered from Markdown
+	 Result = API_WriteRichTextIntoHTMLBuffer (soap,Info.Type,&(getCourseInfo->infoTxt));
+         break;
       case Inf_PAGE:		// Web page hosted in SWAD server
 	 Result = API_WritePageIntoHTMLBuffer (soap,Info.Type,&(getCourseInfo->infoTxt));
          break;
@@ -1382,8 +1518,7 @@ static int API_WriteSyllabusIntoHTMLBuffer (struct soap *soap,
 					    Inf_Type_t InfoType,
 					    char **HTMLBuffer)
   {
-   char FileNameHTMLTmp[PATH_MAX + 1];
-   FILE *FileHTMLTmp;
+   FILE *FileBuffer;
    size_t Length;
 
    /***** Initialize buffer *****/
@@ -1393,53 +1528,20 @@ static int API_WriteSyllabusIntoHTMLBuffer (struct soap *soap,
    Tre_GetListNodes (InfoType);
    if (Tre_GetNumNodes ())
      {
-      /***** Create a unique name for the file *****/
-      snprintf (FileNameHTMLTmp,sizeof (FileNameHTMLTmp),"%s/%s_tree.html",
-	        Cfg_PATH_OUT_PRIVATE,Cry_GetUniqueNameEncrypted ());
-
-      /***** Create a new temporary file for writing and reading *****/
-      if ((FileHTMLTmp = fopen (FileNameHTMLTmp,"w+b")) == NULL)
+      /***** Open a buffer in memory for writing *****/
+      if ((FileBuffer = open_memstream (HTMLBuffer,&Length)) == NULL)
 	{
-	 Tre_FreeListNodes ();
-         return soap_receiver_fault (soap,
-                                     "Syllabus can not be copied into buffer",
-                                     "Can not create temporary file");
-	}
-
-      /***** Write syllabus in HTML into a temporary file *****/
-      Tre_WriteTreeIntoHTMLTmpFile (InfoType,FileHTMLTmp);
-
-      /***** Write syllabus from list of items in memory to text buffer *****/
-      /* Compute length of file */
-      Length = (size_t) ftell (FileHTMLTmp);
-
-      /* Allocate memory for buffer */
-      if ((*HTMLBuffer = malloc (Length + 1)) == NULL)
-	{
-	 fclose (FileHTMLTmp);
-	 unlink (FileNameHTMLTmp);
 	 Tre_FreeListNodes ();
          return soap_receiver_fault (soap,
                                      "Syllabus can not be copied into buffer",
                                      "Not enough memory for buffer");
 	}
 
-      /* Copy file content into buffer */
-      fseek (FileHTMLTmp,0L,SEEK_SET);
-      if (fread (*HTMLBuffer,sizeof (char),Length,FileHTMLTmp) != Length)
-	{
-	 fclose (FileHTMLTmp);
-	 unlink (FileNameHTMLTmp);
-	 Tre_FreeListNodes ();
-         return soap_receiver_fault (soap,
-                                     "Syllabus can not be copied into buffer",
-                                     "Error reading file into buffer");
-	}
-      (*HTMLBuffer)[Length] = '\0';
+      /***** Write syllabus in HTML into buffer *****/
+      Tre_WriteTreeIntoHTMLTmpFile (InfoType,FileBuffer);
 
-      /***** Close and remove temporary file *****/
-      fclose (FileHTMLTmp);
-      unlink (FileNameHTMLTmp);
+      /***** Close buffer (it remains allocated and ended with '\0') *****/
+      fclose (FileBuffer);
      }
 
    /***** Free list of tree nodes *****/
@@ -1533,6 +1635,64 @@ static int API_WritePlainTextIntoHTMLBuffer (struct soap *soap,
    return SOAP_OK;
   }
 
+/*****************************************************************************/
+/********************* Write rich text into HTML buffer **********************/
+/*****************************************************************************/
+
+static int API_WriteRichTextIntoHTMLBuffer (struct soap *soap,
+					    Inf_Type_t InfoType,
+					    char **HTMLBuffer)
+  {
+   extern const char *Txt_INFO_TITLE[Inf_NUM_TYPES];
+   char TxtHTML[Cns_MAX_BYTES_LONG_TEXT + 1];
+   char TxtMD[Cns_MAX_BYTES_LONG_TEXT + 1];
+   FILE *FileHTML;	// HTML rendered from Markdown
+   FILE *FileBuffer;
+   size_t Length;
+
+   /***** Initialize buffer *****/
+   *HTMLBuffer = NULL;
+
+   /***** Get info text from database *****/
+   Inf_GetInfoTxtFromDB (Gbl.Hierarchy.Node[Hie_CRS].HieCod,InfoType,
+                         TxtHTML,TxtMD);
+
+   if (TxtMD[0])
+     {
+      /***** Open HTML rendered from Markdown,
+             the same used when showing the page *****/
+      if ((FileHTML = Inf_OpenRichTxtAsHTML (Gbl.Hierarchy.Node[Hie_CRS].HieCod,
+					     InfoType,TxtMD)) == NULL)
+         return soap_receiver_fault (soap,
+                                     "Rich text can not be copied into buffer",
+                                     "Can not convert from Markdown to HTML");
+
+      /***** Open a buffer in memory for writing *****/
+      if ((FileBuffer = open_memstream (HTMLBuffer,&Length)) == NULL)
+	{
+	 fclose (FileHTML);
+         return soap_receiver_fault (soap,
+                                     "Rich text can not be copied into buffer",
+                                     "Not enough memory for buffer");
+	}
+
+      /***** Write page into buffer *****/
+      Lay_BeginHTMLFile (FileBuffer,Txt_INFO_TITLE[InfoType]);
+      fprintf (FileBuffer,"<body>\n"
+                          "<div class=\"LM DAT_%s\">\n",The_GetSuffix ());
+      Fil_FastCopyOfOpenFiles (FileHTML,FileBuffer);
+      fprintf (FileBuffer,"</div>\n"
+			  "</body>\n"
+			  "</html>\n");
+
+      /***** Close buffer (it remains allocated and ended with '\0') *****/
+      fclose (FileBuffer);
+      fclose (FileHTML);
+     }
+
+   return SOAP_OK;
+  }
+
 /*****************************************************************************/
 /************* Check if exists and write page into HTML buffer ***************/
 /*****************************************************************************/
@@ -1613,12 +1773,59 @@ int swad__getUsers (struct soap *soap,
                     char *wsKey,int courseCode,char *groups,int userRole,	// input
                     struct swad__getUsersOutput *getUsersOut)			// output
   {
-   int ReturnCode;
-   Rol_Role_t Role;
+   int modified;
+   int currentVersion;
 
    /***** Initializations *****/
    API_Set_gSOAP_RuntimeEnv (soap);
    Gbl.WebService.Function = API_getUsers;
+
+   /***** Get users *****/
+   return API_GetUsers (soap,wsKey,courseCode,groups,userRole,0,
+			&modified,&currentVersion,getUsersOut);
+  }
+
+/*****************************************************************************/
+/**** Get users in a course (and groups) if modified since a version *********/
+/*****************************************************************************/
+
+int swad__getUsersIfModified (struct soap *soap,
+                              char *wsKey,int courseCode,char *groups,int userRole,int version,	// input
+                              struct swad__getUsersIfModifiedOutput *getUsersIfModifiedOut)	// output
+  {
+   struct swad__getUsersOutput getUsersOut;
+   int ReturnCode;
+
+   /***** Initializations *****/
+   API_Set_gSOAP_RuntimeEnv (soap);
+   Gbl.WebService.Function = API_getUsersIfModified;
+
+   /***** Get users if modified *****/
+   if ((ReturnCode = API_GetUsers (soap,wsKey,courseCode,groups,userRole,version,
+				   &getUsersIfModifiedOut->modified,
+				   &getUsersIfModifiedOut->version,
+				   &getUsersOut)) != SOAP_OK)
+      return ReturnCode;
+   getUsersIfModifiedOut->numUsers   = getUsersOut.numUsers;
+   getUsersIfModifiedOut->usersArray = getUsersOut.usersArray;
+
+   return SOAP_OK;
+  }
+
+/*****************************************************************************/
+/********* Get users in a course if modified since a version *****************/
+/*****************************************************************************/
+// If version is 0, users are always returned
+
+static int API_GetUsers (struct soap *soap,
+                         char *wsKey,int courseCode,char *groups,int userRole,int version,
+                         int *modified,int *currentVersion,
+                         struct swad__getUsersOutput *getUsersOut)
+  {
+   int ReturnCode;
+   Rol_Role_t Role;
+
+   /***** Initializations *****/
    Gbl.Hierarchy.Node[Hie_CRS].HieCod = courseCode > 0 ? (long) courseCode :
 							 -1L;
 
@@ -1666,6 +1873,22 @@ int swad__getUsers (struct soap *soap,
 
    /***** Create a list of groups selected *****/
    API_GetLstGrpsSel (groups);
+
+   /***** Check if users have been modified since client version *****/
+   *currentVersion = API_GetVersionFromStamp (API_AddUsrsRequestToStamp (API_DB_GetVersionOfUsrsInCrs (Gbl.Hierarchy.Node[Hie_CRS].HieCod),
+									 userRole));
+   if (version == *currentVersion)
+     {
+      *modified = 0;
+      getUsersOut->numUsers          =
+      getUsersOut->usersArray.__size = 0;
+      getUsersOut->usersArray.__ptr  = NULL;
+      if (Gbl.Crs.Grps.LstGrpsSel.NumGrps)
+	 Grp_FreeListCodSelectedGrps ();
+      return SOAP_OK;
+     }
+   *modified = 1;
+
    if (Gbl.Crs.Grps.LstGrpsSel.NumGrps)
       /***** Get list of groups types and groups in current course *****/
       Grp_GetListGrpTypesInCurrentCrs (Grp_GRP_TYPES_WITH_GROUPS);
@@ -1760,7 +1983,7 @@ int swad__findUsers (struct soap *soap,
 						 Hie_SYS;
       switch (Sch_BuildSearchQuery (SearchQuery,&Search,
 				    "CONCAT_WS(' ',FirstName,Surname1,Surname2)",
-				    NULL,NULL))
+				    NULL,NULL,SchIdx_USR))
 	{
 	 case Err_SUCCESS:
 	    /***** Create temporary table with candidate users *****/
@@ -2934,6 +3157,55 @@ int swad__sendAttendanceUsers (struct soap *soap,
 int swad__getNotifications (struct soap *soap,
                             char *wsKey,long beginTime,					// input
                             struct swad__getNotificationsOutput *getNotificationsOut)	// output
+  {
+   int modified;
+   int currentVersion;
+
+   /***** Initializations *****/
+   API_Set_gSOAP_RuntimeEnv (soap);
+   Gbl.WebService.Function = API_getNotifications;
+
+   /***** Get notifications *****/
+   return API_GetNotifications (soap,wsKey,beginTime,0,
+				&modified,&currentVersion,getNotificationsOut);
+  }
+
+/*****************************************************************************/
+/******** Return notifications of a user if modified since a version *********/
+/*****************************************************************************/
+
+int swad__getNotificationsIfModified (struct soap *soap,
+                                      char *wsKey,long beginTime,int version,				// input
+                                      struct swad__getNotificationsIfModifiedOutput *getNotificationsIfModifiedOut)	// output
+  {
+   struct swad__getNotificationsOutput getNotificationsOut;
+   int ReturnCode;
+
+   /***** Initializations *****/
+   API_Set_gSOAP_RuntimeEnv (soap);
+   Gbl.WebService.Function = API_getNotificationsIfModified;
+
+   /***** Get notifications if modified *****/
+   if ((ReturnCode = API_GetNotifications (soap,wsKey,beginTime,version,
+					   &getNotificationsIfModifiedOut->modified,
+					   &getNotificationsIfModifiedOut->version,
+					   &getNotificationsOut)) != SOAP_OK)
+      return ReturnCode;
+   getNotificationsIfModifiedOut->numNotifications   = getNotificationsOut.numNotifications;
+   getNotificationsIfModifiedOut->notificationsArray = getNotificationsOut.notificationsArray;
+
+   return SOAP_OK;
+  }
+
+/*****************************************************************************/
+/********* Get notifications of a user if modified since a version ***********/
+/*****************************************************************************/
+// If version is 0, notifications are always returned
+
+static int API_GetNotifications (struct soap *soap,
+                                 char *wsKey,long beginTime,int version,
+                                 int *modified,int *currentVersion,
+                                 struct swad__getNotificationsOutput *getNotificationsOut)
   {
    extern Err_SuccessOrError_t (*Hie_GetDataByCod[Hie_NUM_LEVELS]) (struct Hie_Node *Node);
    extern const char *Ntf_WSNotifyEvents[Ntf_NUM_NOTIFY_EVENTS];
@@ -2961,10 +3233,6 @@ int swad__getNotifications (struct soap *soap,
    Hie_Level_t L;
    unsigned Col;
 
-   /***** Initializations *****/
-   API_Set_gSOAP_RuntimeEnv (soap);
-   Gbl.WebService.Function = API_getNotifications;
-
    /***** Check web service key *****/
    if ((ReturnCode = API_CheckAPIKey (wsKey)) != SOAP_OK)
       return ReturnCode;
@@ -2982,6 +3250,19 @@ int swad__getNotifications (struct soap *soap,
    Gbl.Usrs.Me.Logged = true;
    Gbl.Usrs.Me.Role.Logged = Gbl.Usrs.Me.UsrDat.Roles.InCurrentCrs;
 
+   /***** Check if my notifications have been modified since client version *****/
+   *currentVersion = API_GetVersionFromStamp (API_DB_GetVersionOfUsrNotifications (Gbl.Usrs.Me.UsrDat.UsrCod,
+										    (time_t) beginTime));
+   if (version == *currentVersion)
+     {
+      *modified = 0;
+      getNotificationsOut->numNotifications          =
+      getNotificationsOut->notificationsArray.__size = 0;
+      getNotificationsOut->notificationsArray.__ptr  = NULL;
+      return SOAP_OK;
+     }
+   *modified = 1;
+
    /***** Get my language from database *****/
    if ((ReturnCode = API_GetMyLanguage (soap)) != SOAP_OK)
       return ReturnCode;
@@ -4702,18 +4983,65 @@ static void API_GetListGrpsInMatchFromDB (struct soap *soap,
 int swad__getDirectoryTree (struct soap *soap,
                             char *wsKey,int courseCode,int groupCode,int treeCode,	// input
                             struct swad__getDirectoryTreeOutput *getDirectoryTreeOut)	// output
+  {
+   int modified;
+   int currentVersion;
+
+   /***** Initializations *****/
+   API_Set_gSOAP_RuntimeEnv (soap);
+   Gbl.WebService.Function = API_getDirectoryTree;
+
+   /***** Get directory tree *****/
+   return API_GetDirectoryTree (soap,wsKey,courseCode,groupCode,treeCode,0,
+				&modified,&currentVersion,getDirectoryTreeOut);
+  }
+
+/*****************************************************************************/
+/************ Return a directory tree if modified since a version ************/
+/*****************************************************************************/
+
+int swad__getDirectoryTreeIfModified (struct soap *soap,
+                                      char *wsKey,int courseCode,int groupCode,int treeCode,int version,	// input
+                                      struct swad__getDirectoryTreeIfModifiedOutput *getDirectoryTreeIfModifiedOut)	// output
+  {
+   struct swad__getDirectoryTreeOutput getDirectoryTreeOut;
+   int ReturnCode;
+
+   /***** Initializations *****/
+   API_Set_gSOAP_RuntimeEnv (soap);
+   Gbl.WebService.Function = API_getDirectoryTreeIfModified;
+
+   /***** Get directory tree if modified *****/
+   if ((ReturnCode = API_GetDirectoryTree (soap,wsKey,courseCode,groupCode,treeCode,version,
+					   &getDirectoryTreeIfModifiedOut->modified,
+					   &getDirectoryTreeIfModifiedOut->version,
+					   &getDirectoryTreeOut)) != SOAP_OK)
+      return ReturnCode;
+   getDirectoryTreeIfModifiedOut->tree = getDirectoryTreeOut.tree;
+
+   return SOAP_OK;
+  }
+
+/*****************************************************************************/
+/********** Get a directory tree if modified since a version *****************/
+/*****************************************************************************/
+// If version is 0, tree is always returned.
+// The tree is written directly into memory (no temporary file)
+// and its version is the CRC-32 of the XML content
+
+static int API_GetDirectoryTree (struct soap *soap,
+                                 char *wsKey,int courseCode,int groupCode,int treeCode,int version,
+                                 int *modified,int *currentVersion,
+                                 struct swad__getDirectoryTreeOutput *getDirectoryTreeOut)
   {
    extern const char *Brw_RootFolderInternalNames[Brw_NUM_TYPES_FILE_BROWSER];
    int ReturnCode;
-   char XMLFileName[PATH_MAX + 1];
    FILE *XML;
-   unsigned long FileSize;
-   unsigned long NumBytesRead;
+   char *XMLBuffer = NULL;
+   size_t XMLSize = 0;
    long GrpCod;
 
    /***** Initializations *****/
-   API_Set_gSOAP_RuntimeEnv (soap);
-   Gbl.WebService.Function = API_getDirectoryTree;
    Gbl.Hierarchy.Node[Hie_CRS].HieCod = courseCode > 0 ? (long) courseCode :
 	                                                 -1L;
    GrpCod = groupCode > 0 ? (long) groupCode :
@@ -4809,20 +5137,13 @@ int swad__getDirectoryTree (struct soap *soap,
 	     sizeof (Gbl.FileBrowser.FilFolLnk.Name) - 1);
    Brw_SetFullPathInTree ();
 
-   /* Check if exists the directory for HTML output. If not exists, create it */
-   Fil_CreateDirIfNotExists (Cfg_PATH_OUT_PRIVATE);
-
-   /* Create a unique name for the file */
-   snprintf (XMLFileName,sizeof (XMLFileName),"%s/%s.xml",
-             Cfg_PATH_OUT_PRIVATE,Cry_GetUniqueNameEncrypted ());
-
-   /* Open file for writing and reading */
-   if ((XML = fopen (XMLFileName,"w+t")) == NULL)
+   /* Open stream to write the tree in memory */
+   if ((XML = open_memstream (&XMLBuffer,&XMLSize)) == NULL)
       return soap_receiver_fault (soap,
 	                          "Can not get tree",
-	                          "Can not create temporary XML file");
+	                          "Can not create XML buffer");
 
-   /* Get directory tree into XML file */
+   /* Get directory tree into XML buffer */
    XML_WriteStartFile (XML,"tree");
    if (Brw_CheckIfFileOrFolderIsHidden (Brw_IS_FOLDER,
                                         Gbl.FileBrowser.FilFolLnk.Full) == HidVis_VISIBLE)
@@ -4830,20 +5151,26 @@ int swad__getDirectoryTree (struct soap *soap,
                    Gbl.FileBrowser.Path.RootFolder,
                    Brw_RootFolderInternalNames[Gbl.FileBrowser.Type]);
    XML_WriteEndFile (XML,"tree");
+   fclose (XML);	// Buffer and size are updated on close
 
-   /* Compute file size */
-   // fseek (XML,0L,SEEK_END);
-   FileSize = (unsigned long) ftell (XML);
-   fseek (XML,0L,SEEK_SET);
-
-   /* Copy XML content from file to memory */
-   getDirectoryTreeOut->tree = soap_malloc (soap,FileSize + 1);
-   NumBytesRead = fread (getDirectoryTreeOut->tree,1,FileSize,XML);
-   getDirectoryTreeOut->tree[NumBytesRead] = '\0';
+   /* Check if tree has been modified since client version */
+   *currentVersion = API_GetVersionFromStamp (crc32 (0L,(const Bytef *) XMLBuffer,
+						     (uInt) XMLSize));
+   if (version == *currentVersion)
+     {
+      *modified = 0;
+      getDirectoryTreeOut->tree = soap_malloc (soap,1);
+      getDirectoryTreeOut->tree[0] = '\0';
+     }
+   else
+     {
+      *modified = 1;
 
-   /* Close and remove XML file */
-   fclose (XML);
-   unlink (XMLFileName);
+      /* Copy XML content to the response */
+      getDirectoryTreeOut->tree = soap_malloc (soap,XMLSize + 1);
+      memcpy (getDirectoryTreeOut->tree,XMLBuffer,XMLSize + 1);	// Buffer is null-terminated
+     }
+   free (XMLBuffer);
 
    return SOAP_OK;
   }
@@ -33,7 +33,7 @@
 /***************************** Public constants ******************************/
 /*****************************************************************************/
 
-#define API_NUM_FUNCTIONS 35
+#define API_NUM_FUNCTIONS 39
 
 #define API_BYTES_KEY Cry_BYTES_ENCRYPTED_STR_SHA256_BASE64
 
@@ -82,6 +82,10 @@ typedef enum
    API_sendMyLocation		= 33,
    API_getLastLocation		= 34,
    API_getAvailableRoles	= 35,
+   API_getCoursesIfModified	= 36,
+   API_getUsersIfModified	= 37,
+   API_getNotificationsIfModified	= 38,
+   API_getDirectoryTreeIfModified	= 39,
   } API_Function_t;
 
 /*****************************************************************************/
@@ -78,6 +78,107 @@ Exi_Exist_t API_DB_GetDataFromAPIKey (MYSQL_RES **mysql_res,
 			 APIKey);
   }
 
+/*****************************************************************************/
+/********** Get version stamp of the courses of a user (getCourses) **********/
+/*****************************************************************************/
+// Version stamps are computed from the same rows returned by the API,
+// so they change whenever any data sent to the client changes
+
+unsigned API_DB_GetVersionOfUsrCourses (long UsrCod)
+  {
+   return
+   DB_QuerySELECTUnsigned ("can not get version of user's courses",
+			   "SELECT CRC32(CONCAT(COUNT(*),'-',"
+					       "IFNULL(BIT_XOR(CRC32(CONCAT_WS('|',"
+					       "crs_courses.CrsCod,"
+					       "crs_courses.ShortName,"
+					       "crs_courses.FullName,"
+					       "crs_users.Role))),0)))"
+			    " FROM crs_users,"
+				  "crs_courses"
+			   " WHERE crs_users.UsrCod=%ld"
+			     " AND crs_users.CrsCod=crs_courses.CrsCod",
+			   UsrCod);
+  }
+
+/*****************************************************************************/
+/********** Get version stamp of the users of a course (getUsers) ************/
+/*****************************************************************************/
+// Any change in enrolments, groups, names, photos, nicknames or IDs
+// of the users in the course changes the version
+
+unsigned API_DB_GetVersionOfUsrsInCrs (long CrsCod)
+  {
+   return
+   DB_QuerySELECTUnsigned ("can not get version of users in a course",
+			   "SELECT CRC32(CONCAT(COUNT(*),'-',"
+					       "IFNULL(BIT_XOR(Stamp),0)))"
+			    " FROM (SELECT CRC32(CONCAT_WS('|','u',"
+					  "crs_users.UsrCod,"
+					  "crs_users.Role,"
+					  "crs_users.Accepted,"
+					  "usr_data.Surname1,"
+					  "usr_data.Surname2,"
+					  "usr_data.FirstName,"
+					  "usr_data.Photo,"
+					  "usr_data.PhotoVisibility)) AS Stamp"
+				    " FROM crs_users,"
+					  "usr_data"
+				   " WHERE crs_users.CrsCod=%ld"
+				     " AND crs_users.UsrCod=usr_data.UsrCod"
+				   " UNION ALL"
+				  " SELECT CRC32(CONCAT_WS('|','n',"
+					  "usr_nicknames.UsrCod,"
+					  "usr_nicknames.Nickname,"
+					  "usr_nicknames.CreatTime))"
+				    " FROM crs_users,"
+					  "usr_nicknames"
+				   " WHERE crs_users.CrsCod=%ld"
+				     " AND crs_users.UsrCod=usr_nicknames.UsrCod"
+				   " UNION ALL"
+				  " SELECT CRC32(CONCAT_WS('|','i',"
+					  "usr_ids.UsrCod,"
+					  "usr_ids.UsrID,"
+					  "usr_ids.Confirmed))"
+				    " FROM crs_users,"
+					  "usr_ids"
+				   " WHERE crs_users.CrsCod=%ld"
+				     " AND crs_users.UsrCod=usr_ids.UsrCod"
+				   " UNION ALL"
+				  " SELECT CRC32(CONCAT_WS('|','g',"
+					  "grp_users.GrpCod,"
+					  "grp_users.UsrCod))"
+				    " FROM grp_types,"
+					  "grp_groups,"
+					  "grp_users"
+				   " WHERE grp_types.CrsCod=%ld"
+				     " AND grp_types.GrpTypCod=grp_groups.GrpTypCod"
+				     " AND grp_groups.GrpCod=grp_users.GrpCod) AS stamps",
+			   CrsCod,
+			   CrsCod,
+			   CrsCod,
+			   CrsCod);
+  }
+
+/*****************************************************************************/
+/************ Get version stamp of recent notifications of a user ************/
+/*****************************************************************************/
+
+unsigned API_DB_GetVersionOfUsrNotifications (long UsrCod,time_t BeginTime)
+  {
+   return
+   DB_QuerySELECTUnsigned ("can not get version of user's notifications",
+			   "SELECT CRC32(CONCAT(COUNT(*),'-',"
+					       "IFNULL(BIT_XOR(CRC32(CONCAT_WS('|',"
+					       "NtfCod,"
+					       "Status))),0)))"
+			    " FROM ntf_notifications"
+			   " WHERE ToUsrCod=%ld"
+			     " AND TimeNotif>=FROM_UNIXTIME(%ld)",
+			   UsrCod,
+			   (long) BeginTime);
+  }
+
 /*****************************************************************************/
 /***************************** Remove old API keys ***************************/
 /*****************************************************************************/
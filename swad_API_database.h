@@ -28,6 +28,7 @@
 /*****************************************************************************/
 
 #include <mysql/mysql.h>	// To access MySQL databases
+#include <time.h>		// For time_t
 
 #include "swad_API.h"
 #include "swad_exist.h"
@@ -42,6 +43,10 @@ Exi_Exist_t API_DB_CheckIfAPIKeyExists (char APIKey[API_BYTES_KEY + 1]);
 Exi_Exist_t API_DB_GetDataFromAPIKey (MYSQL_RES **mysql_res,
 				      char APIKey[API_BYTES_KEY + 1]);
 
+unsigned API_DB_GetVersionOfUsrCourses (long UsrCod);
+unsigned API_DB_GetVersionOfUsrsInCrs (long CrsCod);
+unsigned API_DB_GetVersionOfUsrNotifications (long UsrCod,time_t BeginTime);
+
 void API_DB_RemoveOldAPIKeys (void);
 
 #endif
@@ -202,6 +202,24 @@ unsigned ID__DB_GetUsrCodsFromUsrID (MYSQL_RES **mysql_res,
    return NumUsrs;
   }
 
+/*****************************************************************************/
+/************* Get users' codes of several users from their IDs **************/
+/*****************************************************************************/
+// IDs is a list of users' IDs between apostrophes separated by commas
+// Several users may have the same ID
+
+unsigned ID__DB_GetUsrIDsAndUsrCodsFromUsrIDs (MYSQL_RES **mysql_res,const char *IDs)
+  {
+   return (unsigned)
+   DB_QuerySELECT (mysql_res,"can not get users' codes",
+		   "SELECT DISTINCT "
+			  "UsrID,"	// row[0]
+			  "UsrCod"	// row[1]
+		    " FROM usr_ids"
+		   " WHERE UsrID IN (%s)",
+		   IDs);
+  }
+
 /*****************************************************************************/
 /**************** Remove one of my user's IDs from database ******************/
 /*****************************************************************************/
@@ -39,6 +39,7 @@ unsigned ID__DB_GetUsrCodsFromUsrID (MYSQL_RES **mysql_res,
                                      const struct Usr_Data *UsrDat,
                                      const char *EncryptedPassword,
                                      ID__OnlyConfirmed_t OnlyConfirmedIDs);
+unsigned ID__DB_GetUsrIDsAndUsrCodsFromUsrIDs (MYSQL_RES **mysql_res,const char *IDs);
 
 void ID__DB_RemoveUsrID (long UsrCod,const char ID[ID__MAX_BYTES_USR_ID + 1]);
 void ID__DB_RemoveUsrIDs (long UsrCod);
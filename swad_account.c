@@ -41,7 +41,7 @@
 #include "swad_box.h"
 #include "swad_browser_database.h"
 #include "swad_calendar.h"
-#include "swad_connected_database.h"
+#include "swad_connected.h"
 #include "swad_database.h"
 #include "swad_duplicate_database.h"
 #include "swad_enrolment_database.h"
@@ -1056,6 +1056,7 @@ void Acc_CompletelyEliminateAccount (struct Usr_Data *UsrDat,
    /***** Remove user from the tables of courses and users *****/
    Set_DB_RemUsrFromAllCrssSettings (UsrDat->UsrCod);
    Enr_DB_RemUsrFromAllCrss (UsrDat->UsrCod);
+   Con_FlushCrssOfUsr (UsrDat->UsrCod);
 
    if (Verbose == Cns_VERBOSE)
       Ale_ShowAlert (Ale_SUCCESS,
@@ -1108,7 +1109,7 @@ void Acc_CompletelyEliminateAccount (struct Usr_Data *UsrDat,
    Ann_DB_RemoveUsrFromSeenAnnouncements (UsrDat->UsrCod);
 
    /***** Remove user from table of connected users *****/
-   Con_DB_RemoveUsrFromConnected (UsrDat->UsrCod);
+   Con_RemoveUsrFromConnected (UsrDat->UsrCod);
 
    /***** Remove all sessions of this user *****/
    Ses_DB_RemoveUsrSessions (UsrDat->UsrCod);
@@ -31,6 +31,7 @@
 #include "swad_database.h"
 #include "swad_global.h"
 #include "swad_photo.h"
+#include "swad_search_index.h"
 
 /*****************************************************************************/
 /************** External global variables from others modules ****************/
@@ -103,10 +104,11 @@ long Acc_DB_CreateNewUsr (const struct Usr_Data *UsrDat)
    extern struct The_Theme The_Themes[The_NUM_THEMES];
    extern const char *Usr_StringsSexDB[Usr_NUM_SEXS];
    char BirthdayStrDB[Usr_BIRTHDAY_STR_DB_LENGTH + 1];
+   long UsrCod;
 
    /***** Create new user *****/
    Usr_CreateBirthdayStrDB (UsrDat,BirthdayStrDB);	// It can include start and ending apostrophes
-   return
+   UsrCod =
    DB_QueryINSERTandReturnCode ("can not create user",
  	                        "INSERT INTO usr_data"
 				" (EncryptedUsrCod,Password,"
@@ -151,6 +153,11 @@ long Acc_DB_CreateNewUsr (const struct Usr_Data *UsrDat)
 				(unsigned) Mnu_MENU_DEFAULT,
 				(unsigned) Cfg_DEFAULT_COLUMNS,
 				(unsigned) PhoSha_SHAPE_DEFAULT);
+
+   /***** Add user's name to search index *****/
+   SchIdx_IndexUsrName (UsrCod,UsrDat->FrstName,UsrDat->Surname1,UsrDat->Surname2);
+
+   return UsrCod;
   }
 
 /*****************************************************************************/
@@ -190,6 +197,10 @@ void Acc_DB_UpdateUsrData (const struct Usr_Data *UsrDat)
 	           UsrDat->Comments ? UsrDat->Comments :
 				      "",
 	           UsrDat->UsrCod);
+
+   /***** Update user's name in search index *****/
+   SchIdx_IndexUsrName (UsrDat->UsrCod,
+			UsrDat->FrstName,UsrDat->Surname1,UsrDat->Surname2);
   }
 
 /*****************************************************************************/
@@ -30,7 +30,7 @@
 #include <mysql/mysql.h>	// To access MySQL databases
 #include <stddef.h>		// For NULL
 #include <stdio.h>		// For asprintf
-#include <stdlib.h>		// For calloc
+#include <stdlib.h>		// For bsearch, calloc, qsort
 #include <string.h>		// For string functions
 
 #include "swad_action_list.h"
@@ -87,6 +87,12 @@ typedef enum
    Att_PRNT_SEL_USR,	// Print selected users
   } Att_TypeOfView_t;
 
+struct Att_CodAndIndex
+  {
+   long Cod;		// Attendance event or user code
+   unsigned Index;	// Position in list of events, users or rows
+  };
+
 /*****************************************************************************/
 /****************************** Private prototypes ***************************/
 /*****************************************************************************/
@@ -133,9 +139,17 @@ static void Att_WriteRowUsrToCallTheRoll (unsigned NumUsr,
                                           Pho_ShowPhotos_t ShowPhotos);
 static void Att_PutLinkEvent (struct Att_Event *Event,
 			      const char *Title,const char *Txt);
-static unsigned Att_GetNumUsrsFromAListWhoAreInEvent (long AttCod,
-						      const struct Usr_ListCods *ListCods);
-static Att_AbsentOrPresent_t Att_CheckIfUsrIsPresentInEvent (long AttCod,long UsrCod);
+static void Att_GetPresenceOfUsrsFromAList (struct Att_Events *Events,
+					    const struct Usr_ListCods *ListCods);
+static void Att_SetCheckedInPresence (struct Att_Events *Events);
+static void Att_FreePresence (struct Att_Presence *Presence);
+static Att_AbsentOrPresent_t Att_GetUsrPresenceInEvent (const struct Att_Presence *Presence,
+							unsigned NumUsr,unsigned NumAttEvent);
+static unsigned Att_GetNumTimesUsrIsPresent (const struct Att_Presence *Presence,
+					     unsigned NumUsr);
+static int Att_CompareCodAndIndex (const void *p1,const void *p2);
+static unsigned Att_FindFirstCod (const struct Att_CodAndIndex *Lst,unsigned Num,
+				  long Cod);
 static Att_AbsentOrPresent_t Att_CheckIfUsrIsPresentInEventAndGetComments (long AttCod,long UsrCod,
 									   char CommentStd[Cns_MAX_BYTES_TEXT + 1],
 									   char CommentTch[Cns_MAX_BYTES_TEXT + 1]);
@@ -169,6 +183,7 @@ static void Att_PutCheckOrCross (Att_AbsentOrPresent_t Present);
 static void Att_ListStdsWithAttEventsDetails (struct Att_Events *Events,
                                               const struct Usr_ListCods *ListCods);
 static void Att_ListAttEventsForAStd (struct Att_Events *Events,
+                                      const struct Att_Event *LstEvents,
                                       unsigned NumUsr,struct Usr_Data *UsrDat);
 
 /*****************************************************************************/
@@ -185,6 +200,10 @@ static void Att_ResetEvents (struct Att_Events *Events)
    Events->ShowDetails        = Lay_DONT_SHOW;
    Events->StrAttCodsSelected = NULL;
    Events->CurrentPage        = 0;
+   Events->Presence.NumUsrs   = 0;
+   Events->Presence.NumWords  = 0;
+   Events->Presence.Bits      = NULL;
+   Events->Presence.Checked   = NULL;
   }
 
 /*****************************************************************************/
@@ -2054,44 +2073,226 @@ void Att_RegisterStudentsInEvent (void)
   }
 
 /*****************************************************************************/
-/********* Get number of users from a list who attended to an event **********/
+/****** Get presence of users from a list in all events, in one query ********/
 /*****************************************************************************/
+// Events->Presence gets one row per user in list, with one bit per event,
+// and Events->Lst[].NumStdsFromList gets the number of users present
 
-static unsigned Att_GetNumUsrsFromAListWhoAreInEvent (long AttCod,
-						      const struct Usr_ListCods *ListCods)
+static void Att_GetPresenceOfUsrsFromAList (struct Att_Events *Events,
+					    const struct Usr_ListCods *ListCods)
   {
+   struct Att_Presence *Presence = &Events->Presence;
+   struct Att_CodAndIndex *EvtIdx;
+   struct Att_CodAndIndex *UsrIdx;
+   const struct Att_CodAndIndex *Evt;
    char *SubQueryUsrs;
-   unsigned NumUsrsInAttEvent;
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   unsigned NumRows;
+   unsigned NumRow;
+   unsigned NumAttEvent;
+   unsigned NumUsr;
+   unsigned i;
+   long AttCod;
+   long UsrCod;
 
-   if (ListCods->NumUsrs)
+   /***** Reset number of students in each event *****/
+   for (NumAttEvent = 0;
+	NumAttEvent < Events->Num;
+	NumAttEvent++)
+      Events->Lst[NumAttEvent].NumStdsFromList = 0;
+
+   /***** Allocate matrix with all bits reset *****/
+   Att_FreePresence (Presence);
+   Presence->NumUsrs  = ListCods->NumUsrs;
+   Presence->NumWords = (Events->Num + 63) / 64;
+   if (!Presence->NumUsrs || !Presence->NumWords)
+      return;
+   if ((Presence->Bits = calloc ((size_t) Presence->NumUsrs * Presence->NumWords,
+                                 sizeof (*Presence->Bits))) == NULL)
+      Err_NotEnoughMemoryExit ();
+   if ((Presence->Checked = calloc ((size_t) Presence->NumWords,
+                                    sizeof (*Presence->Checked))) == NULL)
+      Err_NotEnoughMemoryExit ();
+
+   /***** Sort codes of events and users to locate cells of matrix *****/
+   if ((EvtIdx = malloc ((size_t) Events->Num * sizeof (*EvtIdx))) == NULL)
+      Err_NotEnoughMemoryExit ();
+   for (NumAttEvent = 0;
+	NumAttEvent < Events->Num;
+	NumAttEvent++)
      {
-      /***** Create subquery string *****/
-      Usr_CreateSubqueryUsrCods (ListCods,&SubQueryUsrs);
+      EvtIdx[NumAttEvent].Cod   = Events->Lst[NumAttEvent].AttCod;
+      EvtIdx[NumAttEvent].Index = NumAttEvent;
+     }
+   qsort (EvtIdx,(size_t) Events->Num,sizeof (*EvtIdx),Att_CompareCodAndIndex);
 
-      /***** Get number of users from list in attendance event from database ****/
-      NumUsrsInAttEvent = Att_DB_GetNumStdsFromListWhoAreInEvent (AttCod,SubQueryUsrs);
+   if ((UsrIdx = malloc ((size_t) ListCods->NumUsrs * sizeof (*UsrIdx))) == NULL)
+      Err_NotEnoughMemoryExit ();
+   for (NumUsr = 0;
+	NumUsr < ListCods->NumUsrs;
+	NumUsr++)
+     {
+      UsrIdx[NumUsr].Cod   = ListCods->Lst[NumUsr];
+      UsrIdx[NumUsr].Index = NumUsr;
+     }
+   qsort (UsrIdx,(size_t) ListCods->NumUsrs,sizeof (*UsrIdx),Att_CompareCodAndIndex);
+
+   /***** Get users from list present in events from database *****/
+   Usr_CreateSubqueryUsrCods (ListCods,&SubQueryUsrs);
+   NumRows = Att_DB_GetUsrsFromListPresentInCrsEvents (&mysql_res,
+						       Gbl.Hierarchy.Node[Hie_CRS].HieCod,
+						       SubQueryUsrs);
+   Usr_FreeSubqueryUsrCods (SubQueryUsrs);
+
+   /***** Set a bit for each user present in an event *****/
+   for (NumRow = 0;
+	NumRow < NumRows;
+	NumRow++)
+     {
+      row = mysql_fetch_row (mysql_res);
+
+      /* Get attendance event code (row[0]) and user's code (row[1]) */
+      AttCod = Str_ConvertStrCodToLongCod (row[0]);
+      UsrCod = Str_ConvertStrCodToLongCod (row[1]);
+
+      /* Events not in list (hidden or for other groups) are skipped */
+      if ((Evt = bsearch (&AttCod,EvtIdx,(size_t) Events->Num,sizeof (*EvtIdx),
+			  Att_CompareCodAndIndex)) == NULL)
+	 continue;
+      NumAttEvent = Evt->Index;
 
-      /***** Free memory for subquery string *****/
-      Usr_FreeSubqueryUsrCods (SubQueryUsrs);
+      /* A user may appear several times in list */
+      for (i = Att_FindFirstCod (UsrIdx,ListCods->NumUsrs,UsrCod);
+	   i < ListCods->NumUsrs && UsrIdx[i].Cod == UsrCod;
+	   i++)
+	 Presence->Bits[(size_t) UsrIdx[i].Index * Presence->NumWords +
+			NumAttEvent / 64] |= (uint64_t) 1 << (NumAttEvent % 64);
+
+      Events->Lst[NumAttEvent].NumStdsFromList++;
      }
-   else
-      NumUsrsInAttEvent = 0;
 
-   return NumUsrsInAttEvent;
+   /***** Free structure that stores the query result *****/
+   DB_FreeMySQLResult (&mysql_res);
+
+   /***** Free sorted codes *****/
+   free (UsrIdx);
+   free (EvtIdx);
   }
 
 /*****************************************************************************/
-/***************** Check if a student attended to an event *******************/
+/****************** Set mask with attendance events selected *****************/
 /*****************************************************************************/
 
-static Att_AbsentOrPresent_t Att_CheckIfUsrIsPresentInEvent (long AttCod,long UsrCod)
+static void Att_SetCheckedInPresence (struct Att_Events *Events)
   {
-   Att_AbsentOrPresent_t Present;
-   __attribute__((unused)) Exi_Exist_t UsrExists;
+   unsigned NumAttEvent;
 
-   UsrExists = Att_DB_CheckIfUsrExistsInTableAttUsr (AttCod,UsrCod,&Present);
+   if (Events->Presence.Checked)
+     {
+      memset (Events->Presence.Checked,0,
+	      (size_t) Events->Presence.NumWords * sizeof (*Events->Presence.Checked));
+      for (NumAttEvent = 0;
+	   NumAttEvent < Events->Num;
+	   NumAttEvent++)
+	 if (Events->Lst[NumAttEvent].Checked == HTM_CHECKED)
+	    Events->Presence.Checked[NumAttEvent / 64] |= (uint64_t) 1 << (NumAttEvent % 64);
+     }
+  }
 
-   return Present;
+/*****************************************************************************/
+/****************** Free matrix with presence of users ***********************/
+/*****************************************************************************/
+
+static void Att_FreePresence (struct Att_Presence *Presence)
+  {
+   if (Presence->Bits)
+     {
+      free (Presence->Bits);
+      Presence->Bits = NULL;
+     }
+   if (Presence->Checked)
+     {
+      free (Presence->Checked);
+      Presence->Checked = NULL;
+     }
+   Presence->NumUsrs  = 0;
+   Presence->NumWords = 0;
+  }
+
+/*****************************************************************************/
+/********** Check in matrix if a user from list attended to an event *********/
+/*****************************************************************************/
+
+static Att_AbsentOrPresent_t Att_GetUsrPresenceInEvent (const struct Att_Presence *Presence,
+							unsigned NumUsr,unsigned NumAttEvent)
+  {
+   if (NumUsr >= Presence->NumUsrs ||
+       NumAttEvent / 64 >= Presence->NumWords)
+      return Att_ABSENT;
+
+   return (Presence->Bits[(size_t) NumUsr * Presence->NumWords +
+			  NumAttEvent / 64] >> (NumAttEvent % 64)) & 1 ? Att_PRESENT :
+									 Att_ABSENT;
+  }
+
+/*****************************************************************************/
+/****** Get number of events selected to which a user from list attended *****/
+/*****************************************************************************/
+
+static unsigned Att_GetNumTimesUsrIsPresent (const struct Att_Presence *Presence,
+					     unsigned NumUsr)
+  {
+   const uint64_t *Row;
+   unsigned NumWord;
+   unsigned NumTimesPresent = 0;
+
+   if (NumUsr < Presence->NumUsrs)
+     {
+      Row = &Presence->Bits[(size_t) NumUsr * Presence->NumWords];
+      for (NumWord = 0;
+	   NumWord < Presence->NumWords;
+	   NumWord++)
+	 NumTimesPresent += (unsigned) __builtin_popcountll (Row[NumWord] &
+							     Presence->Checked[NumWord]);
+     }
+
+   return NumTimesPresent;
+  }
+
+/*****************************************************************************/
+/*********************** Compare and find sorted codes ***********************/
+/*****************************************************************************/
+
+static int Att_CompareCodAndIndex (const void *p1,const void *p2)
+  {
+   const struct Att_CodAndIndex *C1 = p1;
+   const struct Att_CodAndIndex *C2 = p2;
+
+   return C1->Cod < C2->Cod ? -1 :
+	  C1->Cod > C2->Cod ?  1 :
+			       0;
+  }
+
+// Return the index of the first element with code >= Cod
+
+static unsigned Att_FindFirstCod (const struct Att_CodAndIndex *Lst,unsigned Num,
+				  long Cod)
+  {
+   unsigned Lo = 0;
+   unsigned Hi = Num;
+   unsigned Mid;
+
+   while (Lo < Hi)
+     {
+      Mid = Lo + (Hi - Lo) / 2;
+      if (Lst[Mid].Cod < Cod)
+	 Lo = Mid + 1;
+      else
+	 Hi = Mid;
+     }
+
+   return Lo;
   }
 
 /*****************************************************************************/
@@ -2197,7 +2398,6 @@ static void Att_ListOrPrintMyAttendanceCrs (Att_TypeOfView_t TypeOfView)
    extern const char *Hlp_USERS_Attendance_attendance_list;
    extern const char *Txt_Attendance;
    struct Att_Events Events;
-   unsigned NumAttEvent;
    struct Usr_ListCods ListCods;
 
    switch (TypeOfView)
@@ -2220,14 +2420,8 @@ static void Att_ListOrPrintMyAttendanceCrs (Att_TypeOfView_t TypeOfView)
 	 /***** Get list of groups selected ******/
 	 Grp_GetParCodsSeveralGrpsToShowUsrs ();
 
-	 /***** Get number of students in each event *****/
-	 for (NumAttEvent = 0;
-	      NumAttEvent < Events.Num;
-	      NumAttEvent++)
-	    /* Get number of students in this event */
-	    Events.Lst[NumAttEvent].NumStdsFromList =
-	    Att_GetNumUsrsFromAListWhoAreInEvent (Events.Lst[NumAttEvent].AttCod,
-						  &ListCods);
+	 /***** Get presence of students in all events *****/
+	 Att_GetPresenceOfUsrsFromAList (&Events,&ListCods);
 
 	 /***** Get list of attendance events selected *****/
 	 Att_GetListSelectedAttCods (&Events);
@@ -2266,6 +2460,9 @@ static void Att_ListOrPrintMyAttendanceCrs (Att_TypeOfView_t TypeOfView)
 	 /***** Free list of groups selected *****/
 	 Grp_FreeListCodSelectedGrps ();
 
+	 /***** Free presence of students in events *****/
+	 Att_FreePresence (&Events.Presence);
+
 	 /***** Free list of attendance events *****/
 	 Att_FreeListEvents (&Events);
 	 break;
@@ -2302,7 +2499,6 @@ static void Att_ListOrPrintUsrsAttendanceCrs (void *TypeOfView)
    extern const char *Txt_Attendance_list;
    struct Att_Events Events;
    struct Usr_ListCods ListCods;
-   unsigned NumAttEvent;
 
    switch (*((Att_TypeOfView_t *) TypeOfView))
      {
@@ -2329,14 +2525,8 @@ static void Att_ListOrPrintUsrsAttendanceCrs (void *TypeOfView)
 	    /***** Get list of attendance events *****/
 	    Att_GetListEvents (&Events,Att_OLDEST_FIRST);
 
-	    /***** Get number of students in each event *****/
-	    for (NumAttEvent = 0;
-		 NumAttEvent < Events.Num;
-		 NumAttEvent++)
-	       /* Get number of students in this event */
-	       Events.Lst[NumAttEvent].NumStdsFromList =
-	       Att_GetNumUsrsFromAListWhoAreInEvent (Events.Lst[NumAttEvent].AttCod,
-						     &ListCods);
+	    /***** Get presence of students in all events *****/
+	    Att_GetPresenceOfUsrsFromAList (&Events,&ListCods);
 
 	    /***** Get list of attendance events selected *****/
 	    Att_GetListSelectedAttCods (&Events);
@@ -2374,6 +2564,9 @@ static void Att_ListOrPrintUsrsAttendanceCrs (void *TypeOfView)
 	    /***** Free memory for list of attendance events selected *****/
 	    free (Events.StrAttCodsSelected);
 
+	    /***** Free presence of students in events *****/
+	    Att_FreePresence (&Events.Presence);
+
 	    /***** Free list of attendance events *****/
 	    Att_FreeListEvents (&Events);
 
@@ -2741,6 +2934,9 @@ static void Att_ListUsrsAttendanceTable (struct Att_Events *Events,
    /***** Get my preference about photos in users' list for current course *****/
    ShowPhotos = Pho_GetMyPrefAboutListWithPhotosFromDB ();
 
+   /***** Set mask of events selected to count presences of each user *****/
+   Att_SetCheckedInPresence (Events);
+
    /***** Initialize structure with user's data *****/
    Usr_UsrDataConstructor (&UsrDat);
 
@@ -2867,8 +3063,6 @@ static void Att_WriteRowUsrSeveralAttEvents (const struct Att_Events *Events,
       [PhoSha_SHAPE_RECTANGLE] = "PHOTOR21x28",
      };
    unsigned NumAttEvent;
-   Att_AbsentOrPresent_t Present;
-   unsigned NumTimesPresent;
 
    /***** Write number of user in the list *****/
    HTM_TR_Begin (NULL);
@@ -2911,29 +3105,21 @@ static void Att_WriteRowUsrSeveralAttEvents (const struct Att_Events *Events,
       HTM_TD_End ();
 
       /***** Check/cross to show if the user is present/absent *****/
-      for (NumAttEvent = 0, NumTimesPresent = 0;
+      for (NumAttEvent = 0;
 	   NumAttEvent < Events->Num;
 	   NumAttEvent++)
 	 if (Events->Lst[NumAttEvent].Checked == HTM_CHECKED)
 	   {
-	    /* Check if this student is already registered in the current event */
-	    // Here it is not necessary to get comments
-	    Present = Att_CheckIfUsrIsPresentInEvent (Events->Lst[NumAttEvent].AttCod,
-						      UsrDat->UsrCod);
-
-	    /* Write check or cross */
 	    HTM_TD_Begin ("class=\"BM %s\"",The_GetColorRows ());
-	       Att_PutCheckOrCross (Present);
+	       Att_PutCheckOrCross (Att_GetUsrPresenceInEvent (&Events->Presence,
+							       NumUsr,NumAttEvent));
 	    HTM_TD_End ();
-
-	    if (Present == Att_PRESENT)
-	       NumTimesPresent++;
 	   }
 
       /***** Last column with the number of times this user is present *****/
       HTM_TD_Begin ("class=\"RM DAT_STRONG_%s %s\"",
                     The_GetSuffix (),The_GetColorRows ());
-	 HTM_Unsigned (NumTimesPresent);
+	 HTM_Unsigned (Att_GetNumTimesUsrIsPresent (&Events->Presence,NumUsr));
       HTM_TD_End ();
 
    HTM_TR_End ();
@@ -2981,9 +3167,26 @@ static void Att_ListStdsWithAttEventsDetails (struct Att_Events *Events,
                                               const struct Usr_ListCods *ListCods)
   {
    extern const char *Txt_Details;
+   struct Att_Event *LstEvents;
    struct Usr_Data UsrDat;
+   unsigned NumAttEvent;
    unsigned NumUsr;
 
+   /***** Get data of selected events from database *****/
+   // Only once, not for each student
+   LstEvents = NULL;
+   if (Events->Num)
+      if ((LstEvents = malloc ((size_t) Events->Num * sizeof (*LstEvents))) == NULL)
+	 Err_NotEnoughMemoryExit ();
+   for (NumAttEvent = 0;
+	NumAttEvent < Events->Num;
+	NumAttEvent++)
+      if (Events->Lst[NumAttEvent].Checked == HTM_CHECKED)
+	{
+	 LstEvents[NumAttEvent].AttCod = Events->Lst[NumAttEvent].AttCod;
+	 Att_GetEventDataByCodAndCheckCrs (&LstEvents[NumAttEvent]);
+	}
+
    /***** Initialize structure with user's data *****/
    Usr_UsrDataConstructor (&UsrDat);
 
@@ -3012,7 +3215,7 @@ static void Att_ListStdsWithAttEventsDetails (struct Att_Events *Events,
 		     UsrDat.Accepted = Enr_CheckIfUsrHasAcceptedInCurrentCrs (&UsrDat);
 
 		     /* Write list of attendance events for this student */
-		     Att_ListAttEventsForAStd (Events,NumUsr,&UsrDat);
+		     Att_ListAttEventsForAStd (Events,LstEvents,NumUsr,&UsrDat);
 		    }
 	      }
 
@@ -3027,6 +3230,9 @@ static void Att_ListStdsWithAttEventsDetails (struct Att_Events *Events,
 
    /***** Free memory used for user's data *****/
    Usr_UsrDataDestructor (&UsrDat);
+
+   /***** Free list of events *****/
+   free (LstEvents);
   }
 
 /*****************************************************************************/
@@ -3034,6 +3240,7 @@ static void Att_ListStdsWithAttEventsDetails (struct Att_Events *Events,
 /*****************************************************************************/
 
 static void Att_ListAttEventsForAStd (struct Att_Events *Events,
+                                      const struct Att_Event *LstEvents,
                                       unsigned NumUsr,struct Usr_Data *UsrDat)
   {
    extern const char *Txt_Student_comment;
@@ -3063,6 +3270,32 @@ static void Att_ListAttEventsForAStd (struct Att_Events *Events,
      } ShowComment;
    char CommentStd[Cns_MAX_BYTES_TEXT + 1];
    char CommentTch[Cns_MAX_BYTES_TEXT + 1];
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   struct Att_CodAndIndex *CommentIdx = NULL;
+   unsigned NumComments;
+   unsigned NumComment;
+
+   /***** Get comments of this student in all events *****/
+   // Only events with comments are retrieved, in one query,
+   // and presence is taken from matrix
+   NumComments = Att_DB_GetCommentsOfUsrInCrsEvents (&mysql_res,
+						     Gbl.Hierarchy.Node[Hie_CRS].HieCod,
+						     UsrDat->UsrCod);
+   if (NumComments)
+     {
+      /* Rows are ordered by event code */
+      if ((CommentIdx = malloc ((size_t) NumComments * sizeof (*CommentIdx))) == NULL)
+	 Err_NotEnoughMemoryExit ();
+      for (NumComment = 0;
+	   NumComment < NumComments;
+	   NumComment++)
+	{
+	 row = mysql_fetch_row (mysql_res);
+	 CommentIdx[NumComment].Cod   = Str_ConvertStrCodToLongCod (row[0]);
+	 CommentIdx[NumComment].Index = NumComment;
+	}
+     }
 
    /***** Write number of student in the list *****/
    NumUsr++;
@@ -3118,19 +3351,29 @@ static void Att_ListAttEventsForAStd (struct Att_Events *Events,
 	NumAttEvent++, UniqueId++)
       if (Events->Lst[NumAttEvent].Checked == HTM_CHECKED)
 	{
-	 /***** Get data of the attendance event from database *****/
-	 Events->Event.AttCod = Events->Lst[NumAttEvent].AttCod;
-	 Att_GetEventDataByCodAndCheckCrs (&Events->Event);
-         Events->Event.NumStdsTotal = Att_DB_GetNumStdsTotalWhoAreInEvent (Events->Event.AttCod);
+	 /***** Get presence and comments for this student *****/
+	 Present = Att_GetUsrPresenceInEvent (&Events->Presence,NumUsr - 1,NumAttEvent);
+	 CommentStd[0] =
+	 CommentTch[0] = '\0';
+	 if (NumComments)
+	   {
+	    NumComment = Att_FindFirstCod (CommentIdx,NumComments,LstEvents[NumAttEvent].AttCod);
+	    if (NumComment < NumComments &&
+		CommentIdx[NumComment].Cod == LstEvents[NumAttEvent].AttCod)
+	      {
+	       mysql_data_seek (mysql_res,(my_ulonglong) CommentIdx[NumComment].Index);
+	       row = mysql_fetch_row (mysql_res);
 
-	 /***** Get comments for this student *****/
-	 Present = Att_CheckIfUsrIsPresentInEventAndGetComments (Events->Event.AttCod,UsrDat->UsrCod,
-								 CommentStd,CommentTch);
+	       /* Get student's (row[1]) and teacher's (row[2]) comment */
+	       Str_Copy (CommentStd,row[1],Cns_MAX_BYTES_TEXT);
+	       Str_Copy (CommentTch,row[2],Cns_MAX_BYTES_TEXT);
+	      }
+	   }
          ShowComment.Std = CommentStd[0] ? Lay_SHOW :
 					   Lay_DONT_SHOW;
 	 ShowComment.Tch = CommentTch[0] &&
 	                   (Gbl.Usrs.Me.Role.Logged == Rol_TCH ||
-	                    Events->Event.CommentTchVisible == HidVis_VISIBLE) ? Lay_SHOW :
+	                    LstEvents[NumAttEvent].CommentTchVisible == HidVis_VISIBLE) ? Lay_SHOW :
 	                							 Lay_DONT_SHOW;
 
 	 /***** Write a row for this event *****/
@@ -3154,8 +3397,8 @@ static void Att_ListAttEventsForAStd (struct Att_Events *Events,
 	       HTM_SPAN_Begin ("id=\"%s\"",Id);
 	       HTM_SPAN_End ();
 	       HTM_BR ();
-	       HTM_Txt (Events->Event.Title);
-	       Dat_WriteLocalDateHMSFromUTC (Id,Events->Event.TimeUTC[Dat_STR_TIME],
+	       HTM_Txt (LstEvents[NumAttEvent].Title);
+	       Dat_WriteLocalDateHMSFromUTC (Id,LstEvents[NumAttEvent].TimeUTC[Dat_STR_TIME],
 					     Gbl.Prefs.DateFormat,Dat_SEPARATOR_COMMA,
 					     Dat_WRITE_TODAY |
 					     Dat_WRITE_DATE_ON_SAME_DAY |
@@ -3215,5 +3458,10 @@ static void Att_ListAttEventsForAStd (struct Att_Events *Events,
 	   }
 	}
 
+   /***** Free comments *****/
+   if (CommentIdx)
+      free (CommentIdx);
+   DB_FreeMySQLResult (&mysql_res);
+
    The_ChangeRowColor ();
   }
@@ -28,6 +28,7 @@
 /*****************************************************************************/
 
 #include <mysql/mysql.h>	// To access MySQL databases
+#include <stdint.h>		// For uint64_t
 
 #include "swad_date.h"
 #include "swad_user.h"
@@ -64,6 +65,14 @@ struct Att_Event
    unsigned NumStdsTotal;	// Number total of students who have assisted to the event
   };
 
+struct Att_Presence
+  {
+   unsigned NumUsrs;		// Number of rows, one per user in list
+   unsigned NumWords;		// Number of 64-bit words in each row, one bit per event
+   uint64_t *Bits;		// Bit NumAttEvent of row NumUsr is set if user is present
+   uint64_t *Checked;		// One bit per event selected
+  };
+
 struct Att_Events
   {
    Cac_Status_t LstReadStatus;	// Is the list already read from database, or it needs to be read?
@@ -78,6 +87,7 @@ struct Att_Events
    struct Att_Event Event;	// Selected/current event
    Lay_Show_t ShowDetails;
    char *StrAttCodsSelected;
+   struct Att_Presence Presence;	// Presence of users from a list in events
    unsigned CurrentPage;
   };
 
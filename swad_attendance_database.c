@@ -428,20 +428,25 @@ unsigned Att_DB_GetNumStdsTotalWhoAreInEvent (long AttCod)
   }
 
 /*****************************************************************************/
-/********** Get number of users from a list in an attendance event ***********/
+/******* Get which users from a list are present in events of a course *******/
 /*****************************************************************************/
 
-unsigned Att_DB_GetNumStdsFromListWhoAreInEvent (long AttCod,const char *SubQueryUsrs)
+unsigned Att_DB_GetUsrsFromListPresentInCrsEvents (MYSQL_RES **mysql_res,
+						   long HieCod,const char *SubQueryUsrs)
   {
    return (unsigned)
-   DB_QueryCOUNT ("can not get number of students from a list"
-		  " who are registered in an event",
-		  "SELECT COUNT(*)"
-		   " FROM att_users"
-		  " WHERE AttCod=%ld"
-		    " AND UsrCod IN (%s)"
-		    " AND Present='Y'",
-		  AttCod,SubQueryUsrs);
+   DB_QuerySELECT (mysql_res,"can not get students from a list"
+			     " who are registered in events",
+		   "SELECT att_users.AttCod,"	// row[0]
+			  "att_users.UsrCod"	// row[1]
+		    " FROM att_events,"
+			  "att_users"
+		   " WHERE att_events.CrsCod=%ld"
+		     " AND att_events.AttCod=att_users.AttCod"
+		     " AND att_users.UsrCod IN (%s)"
+		     " AND att_users.Present='Y'",
+		   HieCod,
+		   SubQueryUsrs);
   }
 
 /*****************************************************************************/
@@ -493,6 +498,30 @@ Exi_Exist_t Att_DB_GetPresentAndComments (MYSQL_RES **mysql_res,
 			 UsrCod);
   }
 
+/*****************************************************************************/
+/*********** Get comments of a user in events of a course, if any ************/
+/*****************************************************************************/
+
+unsigned Att_DB_GetCommentsOfUsrInCrsEvents (MYSQL_RES **mysql_res,
+					     long HieCod,long UsrCod)
+  {
+   return (unsigned)
+   DB_QuerySELECT (mysql_res,"can not get comments of a student in events",
+		   "SELECT att_users.AttCod,"		// row[0]
+			  "att_users.CommentStd,"	// row[1]
+			  "att_users.CommentTch"	// row[2]
+		    " FROM att_events,"
+			  "att_users"
+		   " WHERE att_events.CrsCod=%ld"
+		     " AND att_events.AttCod=att_users.AttCod"
+		     " AND att_users.UsrCod=%ld"
+		     " AND (att_users.CommentStd<>''"
+			" OR att_users.CommentTch<>'')"
+		" ORDER BY att_users.AttCod",
+		   HieCod,
+		   UsrCod);
+  }
+
 /*****************************************************************************/
 /*********** Return a list with the users in an attendance event *************/
 /*****************************************************************************/
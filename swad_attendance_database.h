@@ -74,11 +74,14 @@ void Att_DB_RemoveGroupsOfType (long GrpTypCod);
 void Att_DB_RemoveGrpsAssociatedToAnEvent (long AttCod);
 
 unsigned Att_DB_GetNumStdsTotalWhoAreInEvent (long AttCod);
-unsigned Att_DB_GetNumStdsFromListWhoAreInEvent (long AttCod,const char *SubQueryUsrs);
+unsigned Att_DB_GetUsrsFromListPresentInCrsEvents (MYSQL_RES **mysql_res,
+						   long HieCod,const char *SubQueryUsrs);
 Exi_Exist_t Att_DB_CheckIfUsrExistsInTableAttUsr (long AttCod,long UsrCod,
 					          Att_AbsentOrPresent_t *Present);
 Exi_Exist_t Att_DB_GetPresentAndComments (MYSQL_RES **mysql_res,
 					  long AttCod,long UsrCod);
+unsigned Att_DB_GetCommentsOfUsrInCrsEvents (MYSQL_RES **mysql_res,
+					     long HieCod,long UsrCod);
 unsigned Att_DB_GetListUsrsInEvent (MYSQL_RES **mysql_res,long AttCod);
 void Att_DB_RegUsrInEventChangingComments (long AttCod,long UsrCod,
                                            Att_AbsentOrPresent_t Present,
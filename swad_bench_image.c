@@ -0,0 +1,388 @@
+// swad_bench_image.c: benchmark of in-process image processing against ImageMagick commands
+
+/*
+    SWAD (Shared Workspace At a Distance),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2026 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/*
+   Usage: make bench_image
+      or: ./swad_bench_image [NumIterations]
+
+   Compares the module swad_image, linked in the CGI, with the ImageMagick
+   commands that were run before through system () for the same operations:
+   - resize of an uploaded photo to the size of images in timeline,
+   - extraction of the first frame of an animated GIF,
+   - detection of animated GIF by counting its frames.
+   Input images are generated in a temporary directory with convert.
+   For each operation and path these are reported:
+   p50 and p99 of the time of one operation and operations per second.
+*/
+/*****************************************************************************/
+/********************************* Headers ***********************************/
+/*****************************************************************************/
+
+#define _GNU_SOURCE 		// For asprintf
+#include <linux/limits.h>	// For PATH_MAX
+#include <stdio.h>		// For asprintf, fscanf, printf, snprintf
+#include <stdlib.h>		// For free, malloc, mkdtemp, qsort, system
+#include <sys/wait.h>		// For WEXITSTATUS
+#include <time.h>		// For clock_gettime
+#include <unistd.h>		// For rmdir, unlink
+
+#include "swad_image.h"
+
+/*****************************************************************************/
+/***************************** Private constants *****************************/
+/*****************************************************************************/
+
+#define BenchImg_DEF_NUM_ITERATIONS	50
+
+#define BenchImg_PHOTO_WIDTH		3000	// Size of a photo from a camera
+#define BenchImg_PHOTO_HEIGHT		2000
+#define BenchImg_GIF_WIDTH		400
+#define BenchImg_GIF_HEIGHT		300
+
+#define BenchImg_IMAGE_MAX_WIDTH	768	// Same as Tml_IMAGE_SAVED_MAX_WIDTH
+#define BenchImg_IMAGE_MAX_HEIGHT	768	// Same as Tml_IMAGE_SAVED_MAX_HEIGHT
+#define BenchImg_IMAGE_QUALITY		 90	// Same as Tml_IMAGE_SAVED_QUALITY
+
+/*****************************************************************************/
+/******************************* Private types *******************************/
+/*****************************************************************************/
+
+struct BenchImg_Operation
+  {
+   const char *Name;
+   const char *Path;
+   Err_SuccessOrError_t (*Run) (void);
+  };
+
+/*****************************************************************************/
+/************************* Private global variables **************************/
+/*****************************************************************************/
+
+static char BenchImg_Dir[] = "/tmp/swad_bench_image_XXXXXX";
+static char *BenchImg_Photo;		// Source JPEG photo
+static char *BenchImg_Gif;		// Source animated GIF
+static char *BenchImg_ResizedPhoto;	// Destination of resize
+static char *BenchImg_FirstFrame;	// Destination of first frame
+static char *BenchImg_NumFramesTxt;	// Output of identify
+
+/*****************************************************************************/
+/***************************** Private prototypes ****************************/
+/*****************************************************************************/
+
+static Err_SuccessOrError_t BenchImg_CreateInputImages (void);
+static void BenchImg_RemoveFiles (void);
+static Err_SuccessOrError_t BenchImg_RunCommand (const char *Command);
+
+static Err_SuccessOrError_t BenchImg_ResizeInProcess (void);
+static Err_SuccessOrError_t BenchImg_ResizeWithCommand (void);
+static Err_SuccessOrError_t BenchImg_GetFirstFrameInProcess (void);
+static Err_SuccessOrError_t BenchImg_GetFirstFrameWithCommand (void);
+static Err_SuccessOrError_t BenchImg_DetectAnimatedInProcess (void);
+static Err_SuccessOrError_t BenchImg_DetectAnimatedWithCommand (void);
+
+static double BenchImg_GetTime (void);
+static int BenchImg_CompareTimes (const void *a,const void *b);
+static double BenchImg_GetPercentile (const double *Times,unsigned NumTimes,
+				      unsigned Percent);
+
+static const struct BenchImg_Operation BenchImg_Operations[] =
+  {
+   {"resize"	,"in-process",BenchImg_ResizeInProcess		},
+   {"resize"	,"command"   ,BenchImg_ResizeWithCommand		},
+   {"first frame","in-process",BenchImg_GetFirstFrameInProcess	},
+   {"first frame","command"   ,BenchImg_GetFirstFrameWithCommand	},
+   {"animated"	,"in-process",BenchImg_DetectAnimatedInProcess	},
+   {"animated"	,"command"   ,BenchImg_DetectAnimatedWithCommand	},
+  };
+
+/*****************************************************************************/
+/*********************************** Main ************************************/
+/*****************************************************************************/
+
+int main (int argc,char *argv[])
+  {
+   unsigned NumIterations = BenchImg_DEF_NUM_ITERATIONS;
+   unsigned NumOp;
+   unsigned NumIt;
+   double *Times;
+   double Start;
+   double Total;
+   int ReturnCode = 0;
+
+   if (argc > 1)
+      if (sscanf (argv[1],"%u",&NumIterations) != 1 || NumIterations == 0)
+	{
+	 fprintf (stderr,"Usage: %s [NumIterations]\n",argv[0]);
+	 return 2;
+	}
+
+   /***** Create source images *****/
+   if (BenchImg_CreateInputImages () == Err_ERROR)
+     {
+      fprintf (stderr,"Can not create input images in %s\n",BenchImg_Dir);
+      BenchImg_RemoveFiles ();
+      return 1;
+     }
+
+   if ((Times = malloc (NumIterations * sizeof (*Times))) == NULL)
+     {
+      fprintf (stderr,"Not enough memory\n");
+      BenchImg_RemoveFiles ();
+      return 1;
+     }
+
+   /***** Run each operation, the first time without measuring *****/
+   printf ("%-12s %-10s %9s %9s %9s\n",
+	   "Operation","Path","p50 (ms)","p99 (ms)","Ops/s");
+   for (NumOp = 0;
+	NumOp < sizeof (BenchImg_Operations) / sizeof (BenchImg_Operations[0]);
+	NumOp++)
+     {
+      if (BenchImg_Operations[NumOp].Run () == Err_ERROR)
+	{
+	 fprintf (stderr,"Error in %s (%s)\n",
+		  BenchImg_Operations[NumOp].Name,BenchImg_Operations[NumOp].Path);
+	 ReturnCode = 1;
+	 continue;
+	}
+
+      for (NumIt = 0, Total = 0.0;
+	   NumIt < NumIterations;
+	   NumIt++)
+	{
+	 Start = BenchImg_GetTime ();
+	 BenchImg_Operations[NumOp].Run ();
+	 Times[NumIt] = BenchImg_GetTime () - Start;
+	 Total += Times[NumIt];
+	}
+
+      qsort (Times,NumIterations,sizeof (*Times),BenchImg_CompareTimes);
+      printf ("%-12s %-10s %9.1f %9.1f %9.1f\n",
+	      BenchImg_Operations[NumOp].Name,BenchImg_Operations[NumOp].Path,
+	      BenchImg_GetPercentile (Times,NumIterations,50) * 1000.0,
+	      BenchImg_GetPercentile (Times,NumIterations,99) * 1000.0,
+	      (double) NumIterations / Total);
+     }
+
+   /***** Clean up *****/
+   free (Times);
+   BenchImg_RemoveFiles ();
+   Img_Cleanup ();
+
+   return ReturnCode;
+  }
+
+/*****************************************************************************/
+/************** Create source images in a temporary directory ****************/
+/*****************************************************************************/
+
+static Err_SuccessOrError_t BenchImg_CreateInputImages (void)
+  {
+   char *Command;
+   Err_SuccessOrError_t Success;
+
+   if (mkdtemp (BenchImg_Dir) == NULL)
+      return Err_ERROR;
+
+   if (asprintf (&BenchImg_Photo       ,"%s/photo.jpg"  ,BenchImg_Dir) < 0 ||
+       asprintf (&BenchImg_Gif         ,"%s/anim.gif"   ,BenchImg_Dir) < 0 ||
+       asprintf (&BenchImg_ResizedPhoto,"%s/resized.jpg",BenchImg_Dir) < 0 ||
+       asprintf (&BenchImg_FirstFrame  ,"%s/frame.png"  ,BenchImg_Dir) < 0 ||
+       asprintf (&BenchImg_NumFramesTxt,"%s/frames.txt" ,BenchImg_Dir) < 0)
+      return Err_ERROR;
+
+   /***** Photo with detail, so JPEG is not trivial to decode *****/
+   if (asprintf (&Command,"convert -seed 1 -size %ux%u plasma:fractal -quality 92 %s",
+		 BenchImg_PHOTO_WIDTH,BenchImg_PHOTO_HEIGHT,BenchImg_Photo) < 0)
+      return Err_ERROR;
+   Success = BenchImg_RunCommand (Command);
+   free (Command);
+   if (Success == Err_ERROR)
+      return Err_ERROR;
+
+   /***** Animated GIF with four frames *****/
+   if (asprintf (&Command,"convert -size %ux%u xc:red xc:green xc:blue xc:yellow"
+			  " -loop 0 %s",
+		 BenchImg_GIF_WIDTH,BenchImg_GIF_HEIGHT,BenchImg_Gif) < 0)
+      return Err_ERROR;
+   Success = BenchImg_RunCommand (Command);
+   free (Command);
+
+   return Success;
+  }
+
+/*****************************************************************************/
+/************************ Remove temporary directory *************************/
+/*****************************************************************************/
+
+static void BenchImg_RemoveFiles (void)
+  {
+   char **Paths[] =
+     {
+      &BenchImg_Photo,
+      &BenchImg_Gif,
+      &BenchImg_ResizedPhoto,
+      &BenchImg_FirstFrame,
+      &BenchImg_NumFramesTxt,
+     };
+   unsigned NumPath;
+
+   for (NumPath = 0;
+	NumPath < sizeof (Paths) / sizeof (Paths[0]);
+	NumPath++)
+      if (*Paths[NumPath])
+	{
+	 unlink (*Paths[NumPath]);
+	 free (*Paths[NumPath]);
+	 *Paths[NumPath] = NULL;
+	}
+   rmdir (BenchImg_Dir);
+  }
+
+/*****************************************************************************/
+/*************** Run a shell command as the old code did *********************/
+/*****************************************************************************/
+
+static Err_SuccessOrError_t BenchImg_RunCommand (const char *Command)
+  {
+   int ReturnCode;
+
+   if ((ReturnCode = system (Command)) == -1)
+      return Err_ERROR;
+
+   return WEXITSTATUS (ReturnCode) ? Err_ERROR :
+				     Err_SUCCESS;
+  }
+
+/*****************************************************************************/
+/********************************* Resize ************************************/
+/*****************************************************************************/
+
+static Err_SuccessOrError_t BenchImg_ResizeInProcess (void)
+  {
+   return Img_ResizeImage (BenchImg_Photo,BenchImg_ResizedPhoto,
+			   BenchImg_IMAGE_MAX_WIDTH,BenchImg_IMAGE_MAX_HEIGHT,
+			   Img_SHRINK_TO_FIT,BenchImg_IMAGE_QUALITY);
+  }
+
+static Err_SuccessOrError_t BenchImg_ResizeWithCommand (void)
+  {
+   char Command[256 + PATH_MAX * 2];
+
+   snprintf (Command,sizeof (Command),
+	     "convert %s -resize '%ux%u>' -quality %u %s",
+	     BenchImg_Photo,
+	     BenchImg_IMAGE_MAX_WIDTH,BenchImg_IMAGE_MAX_HEIGHT,
+	     BenchImg_IMAGE_QUALITY,
+	     BenchImg_ResizedPhoto);
+   return BenchImg_RunCommand (Command);
+  }
+
+/*****************************************************************************/
+/************************ First frame of animated GIF ************************/
+/*****************************************************************************/
+
+static Err_SuccessOrError_t BenchImg_GetFirstFrameInProcess (void)
+  {
+   return Img_GetFirstFrame (BenchImg_Gif,BenchImg_FirstFrame);
+  }
+
+static Err_SuccessOrError_t BenchImg_GetFirstFrameWithCommand (void)
+  {
+   char Command[128 + PATH_MAX * 2];
+
+   snprintf (Command,sizeof (Command),"convert '%s[0]' %s",
+	     BenchImg_Gif,BenchImg_FirstFrame);
+   return BenchImg_RunCommand (Command);
+  }
+
+/*****************************************************************************/
+/***************************** Detect animated GIF ***************************/
+/*****************************************************************************/
+
+static Err_SuccessOrError_t BenchImg_DetectAnimatedInProcess (void)
+  {
+   return Img_GetNumFrames (BenchImg_Gif) > 1 ? Err_SUCCESS :
+						Err_ERROR;
+  }
+
+static Err_SuccessOrError_t BenchImg_DetectAnimatedWithCommand (void)
+  {
+   char Command[128 + PATH_MAX * 2];
+   FILE *FileTxt;
+   int NumFrames = 0;
+
+   /***** Command writes number of frames to a text file *****/
+   snprintf (Command,sizeof (Command),
+	     "identify -format '%%n\n' %s | head -1 > %s",
+	     BenchImg_Gif,BenchImg_NumFramesTxt);
+   if (BenchImg_RunCommand (Command) == Err_ERROR)
+      return Err_ERROR;
+
+   /***** Read text file *****/
+   if ((FileTxt = fopen (BenchImg_NumFramesTxt,"rb")) == NULL)
+      return Err_ERROR;
+   if (fscanf (FileTxt,"%d",&NumFrames) != 1)
+      NumFrames = 0;
+   fclose (FileTxt);
+   unlink (BenchImg_NumFramesTxt);
+
+   return NumFrames > 1 ? Err_SUCCESS :
+			  Err_ERROR;
+  }
+
+/*****************************************************************************/
+/****************************** Time in seconds ******************************/
+/*****************************************************************************/
+
+static double BenchImg_GetTime (void)
+  {
+   struct timespec Time;
+
+   clock_gettime (CLOCK_MONOTONIC,&Time);
+   return (double) Time.tv_sec + (double) Time.tv_nsec / 1E9;
+  }
+
+/*****************************************************************************/
+/************************** Percentiles of times *****************************/
+/*****************************************************************************/
+
+static int BenchImg_CompareTimes (const void *a,const void *b)
+  {
+   double TimeA = *(const double *) a;
+   double TimeB = *(const double *) b;
+
+   return (TimeA > TimeB) - (TimeA < TimeB);
+  }
+
+// Times must be sorted. Percentile by nearest rank
+
+static double BenchImg_GetPercentile (const double *Times,unsigned NumTimes,
+				      unsigned Percent)
+  {
+   unsigned Rank = (NumTimes * Percent + 99) / 100;
+
+   return Times[Rank ? Rank - 1 :
+		       0];
+  }
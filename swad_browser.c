@@ -31,7 +31,7 @@
 #include <linux/limits.h>	// For PATH_MAX
 #include <stddef.h>		// For NULL
 #include <stdio.h>		// For asprintf
-#include <stdlib.h>		// For exit, system, free, etc
+#include <stdlib.h>		// For bsearch, exit, system, free, etc
 #include <string.h>		// For string functions
 #include <sys/types.h>		// For lstat, time_t
 #include <sys/stat.h>		// For lstat
@@ -107,6 +107,12 @@ struct Brw_NumObjects
    unsigned NumLinks;
   };
 
+struct Brw_SubfolderInIndex
+  {
+   const char *Name;
+   int NumFilesAndFolders;
+  };
+
 /*****************************************************************************/
 /***************************** Public constants ******************************/
 /*****************************************************************************/
@@ -1134,6 +1140,13 @@ static void Brw_ListDir (unsigned Level,const char *RowId,
                          ConExp_ContractedOrExpanded_t TreeContractedOrExpanded,
                          const char Path[PATH_MAX + 1],
                          const char PathInTree[PATH_MAX + 1]);
+static unsigned Brw_GetSubfoldersFromIndex (MYSQL_RES **mysql_res,
+					    const char PathInTree[PATH_MAX + 1],
+					    struct Brw_SubfolderInIndex **Subfolders);
+static int Brw_CompareSubfolderNames (const void *p1,const void *p2);
+static int Brw_GetNumFilesAndFoldersInSubfolder (const struct Brw_SubfolderInIndex *Subfolders,
+						 unsigned NumSubfolders,
+						 const char *Name);
 static HidVis_HiddenOrVisible_t Brw_WriteRowFileBrowser (unsigned Level,
 							 const char *RowId,
 							 ConExp_ContractedOrExpanded_t TreeContractedOrExpanded,
@@ -2511,7 +2524,11 @@ static void Brw_CreateFoldersAssignmentsIfNotExist (long ZoneUsrCod)
 	    /* Create folder if not exists */
 	    snprintf (PathFolderAsg,sizeof (PathFolderAsg),"%s/%s",
 		      Gbl.FileBrowser.Path.RootFolder,row[0]);
-	    Fil_CreateDirIfNotExists (PathFolderAsg);
+	    if (Fil_CheckIfPathExists (PathFolderAsg) == Exi_DOES_NOT_EXIST)
+	      {
+	       Fil_CreateDirIfNotExists (PathFolderAsg);
+	       BrwSiz_AddFolderToIndex (PathFolderAsg);
+	      }
 	   }
      }
 
@@ -2610,6 +2627,10 @@ Err_SuccessOrError_t Brw_UpdateFoldersAssigmentsIfExistForAllUsrs (const char *O
 		  Brw_DB_RemoveAffectedClipboards (Brw_ADMI_ASG_USR,UsrCod,-1L);
 		  Brw_DB_RemoveAffectedClipboards (Brw_ADMI_ASG_CRS,-1L,UsrCod);
 
+		  /* Folder index will be rebuilt from disk */
+		  Brw_DB_RemoveFolderIndexOfAsgZone (Gbl.Hierarchy.Node[Hie_CRS].HieCod,
+						     UsrCod);
+
 		  /* Rename affected expanded folders */
 		  snprintf (OldPath,sizeof (OldPath),"%s/%s",
 			    Brw_INTERNAL_NAME_ROOT_FOLDER_ASSIGNMENTS,OldFolderName);
@@ -2678,6 +2699,10 @@ void Brw_RemoveFoldersAssignmentsIfExistForAllUsrs (const char *FolderName)
                 Brw_INTERNAL_NAME_ROOT_FOLDER_ASSIGNMENTS,
                 FolderName);
       Fil_RemoveTree (PathFolder);
+
+      /* Folder index will be rebuilt from disk */
+      Brw_DB_RemoveFolderIndexOfAsgZone (Gbl.Hierarchy.Node[Hie_CRS].HieCod,
+					 UsrCod);
      }
 
    /***** Free structure that stores the query result *****/
@@ -3758,10 +3783,17 @@ static void Brw_ListDir (unsigned Level,const char *ParentRowId,
      };
    Brw_IconTree_t IconSubtree = Brw_ICON_TREE_NOTHING;	// Initialized to avoid warning
    __attribute__((unused)) HidVis_HiddenOrVisible_t HiddenOrVisible;
+   MYSQL_RES *mysql_res = NULL;
+   struct Brw_SubfolderInIndex *Subfolders = NULL;
+   unsigned NumSubfolders = 0;
 
    /***** Scan directory *****/
    if ((NumFiles = scandir (Path,&FileList,NULL,alphasort)) >= 0)	// No error
      {
+      /***** Get number of files and folders in all subfolders at once *****/
+      if (Gbl.FileBrowser.ShowFullTree == Lay_DONT_SHOW)
+	 NumSubfolders = Brw_GetSubfoldersFromIndex (&mysql_res,PathInTree,&Subfolders);
+
       /***** List files *****/
       for (NumFile = 0, NumRow = 0;
 	   NumFile < NumFiles;
@@ -3802,22 +3834,28 @@ static void Brw_ListDir (unsigned Level,const char *ParentRowId,
 		  default:
 		     ContractedOrExpandedSubtree = ConExp_CONTRACTED;
 		     /***** Check if this subdirectory has files or folders in it *****/
-		     if ((NumFilesInSubdir = scandir (PathFileRel,&SubdirFileList,NULL,NULL)) >= 0)	// No error
+		     if ((NumFilesInSubdir = Brw_GetNumFilesAndFoldersInSubfolder (Subfolders,NumSubfolders,
+										   FileList[NumFile]->d_name)) < 0)
 		       {
-			if (NumFilesInSubdir > 2)
+			/* Folder not in index ==> scan the subdirectory */
+			if ((NumFilesInSubdir = scandir (PathFileRel,&SubdirFileList,NULL,NULL)) >= 0)	// No error
 			  {
-			   /***** Check if the tree starting at this subdirectory must be expanded *****/
-			   ContractedOrExpandedSubtree = Brw_DB_GetIfContractedOrExpandedFolder (Gbl.FileBrowser.FilFolLnk.Full);
-			   IconSubtree = IconsSubtree[ContractedOrExpandedSubtree];
+			   for (NumFileInSubdir = 0;
+				NumFileInSubdir < NumFilesInSubdir;
+				NumFileInSubdir++)
+			      free (SubdirFileList[NumFileInSubdir]);
+			   free (SubdirFileList);
+			   NumFilesInSubdir -= 2;	// Skip directories "." and ".."
 			  }
-			for (NumFileInSubdir = 0;
-			     NumFileInSubdir < NumFilesInSubdir;
-			     NumFileInSubdir++)
-			   free (SubdirFileList[NumFileInSubdir]);
-			free (SubdirFileList);
+			else
+			   Err_ShowErrorAndExit ("Error while scanning directory.");
+		       }
+		     if (NumFilesInSubdir > 0)
+		       {
+			/***** Check if the tree starting at this subdirectory must be expanded *****/
+			ContractedOrExpandedSubtree = Brw_DB_GetIfContractedOrExpandedFolder (Gbl.FileBrowser.FilFolLnk.Full);
+			IconSubtree = IconsSubtree[ContractedOrExpandedSubtree];
 		       }
-		     else
-			Err_ShowErrorAndExit ("Error while scanning directory.");
 		     break;
 	         }
 
@@ -3845,11 +3883,80 @@ static void Brw_ListDir (unsigned Level,const char *ParentRowId,
 	 free (FileList[NumFile]);
 	}
       free (FileList);
+
+      /***** Free list of subfolders in index *****/
+      free (Subfolders);
+      DB_FreeMySQLResult (&mysql_res);
      }
    else
       Err_ShowErrorAndExit ("Error while scanning directory.");
   }
 
+/*****************************************************************************/
+/********* Get subfolders of a folder in index, with their contents **********/
+/*****************************************************************************/
+// Names in list point to rows in mysql_res, which must be freed after use
+
+static unsigned Brw_GetSubfoldersFromIndex (MYSQL_RES **mysql_res,
+					    const char PathInTree[PATH_MAX + 1],
+					    struct Brw_SubfolderInIndex **Subfolders)
+  {
+   MYSQL_ROW row;
+   unsigned NumSubfolders;
+   unsigned NumSubfolder;
+
+   /***** Get subfolders from database, ordered by name *****/
+   if ((NumSubfolders = Brw_DB_GetNumFilesAndFoldersInSubfoldersFromFolderIndex (mysql_res,
+										 PathInTree)))
+     {
+      if ((*Subfolders = malloc ((size_t) NumSubfolders * sizeof (**Subfolders))) == NULL)
+	 Err_NotEnoughMemoryExit ();
+
+      for (NumSubfolder = 0;
+	   NumSubfolder < NumSubfolders;
+	   NumSubfolder++)
+	{
+	 row = mysql_fetch_row (*mysql_res);
+
+	 /* Get name (row[0]) and number of files and folders (row[1]) */
+	 (*Subfolders)[NumSubfolder].Name = row[0];
+	 if (sscanf (row[1],"%d",&(*Subfolders)[NumSubfolder].NumFilesAndFolders) != 1)
+	    (*Subfolders)[NumSubfolder].NumFilesAndFolders = -1;
+	}
+     }
+
+   return NumSubfolders;
+  }
+
+/*****************************************************************************/
+/************* Compare names of subfolders to search in a list ***************/
+/*****************************************************************************/
+
+static int Brw_CompareSubfolderNames (const void *p1,const void *p2)
+  {
+   return strcmp ((const char *) p1,
+		  ((const struct Brw_SubfolderInIndex *) p2)->Name);
+  }
+
+/*****************************************************************************/
+/*********** Get number of files and folders inside a subfolder **************/
+/*****************************************************************************/
+// Return -1 if the subfolder is not in index
+
+static int Brw_GetNumFilesAndFoldersInSubfolder (const struct Brw_SubfolderInIndex *Subfolders,
+						 unsigned NumSubfolders,
+						 const char *Name)
+  {
+   const struct Brw_SubfolderInIndex *Subfolder;
+
+   if (NumSubfolders)
+      if ((Subfolder = bsearch (Name,Subfolders,(size_t) NumSubfolders,sizeof (*Subfolders),
+				Brw_CompareSubfolderNames)))
+	 return Subfolder->NumFilesAndFolders;
+
+   return -1;
+  }
+
 /*****************************************************************************/
 /*********************** Write a row of a file browser ***********************/
 /*****************************************************************************/
@@ -5126,6 +5233,7 @@ void Brw_RemSubtree (void)
 	        Gbl.FileBrowser.FilFolLnk.Full);
 
       /***** Remove the whole tree *****/
+      BrwSiz_RemoveFromIndex (Path);
       Fil_RemoveTree (Path);
 
       /* If a folder is removed,
@@ -6181,6 +6289,7 @@ static Err_SuccessOrError_t Brw_PasteTreeIntoFolder (struct BrwSiz_BrowserSize *
 			   case Err_SUCCESS:	// Quota not exceeded
 			      /***** Quota will not be exceeded ==> copy the origin file to the destination file *****/
 			      Fil_FastCopyOfFiles (PathOrg,PathDstWithFile);
+			      BrwSiz_AddFileToIndex (PathDstWithFile);
 
 			      /***** Add entry to the table of files/folders *****/
 			      FilCod = Brw_DB_AddPath (Gbl.Usrs.Me.UsrDat.UsrCod,FileType,
@@ -6228,6 +6337,7 @@ static Err_SuccessOrError_t Brw_PasteTreeIntoFolder (struct BrwSiz_BrowserSize *
 			   /* Create directory */
 			   if (mkdir (PathDstWithFile,(mode_t) 0xFFF))
 			      Err_ShowErrorAndExit ("Can not create folder.");
+			   BrwSiz_AddFolderToIndex (PathDstWithFile);
 
 			   /* Add entry to the table of files/folders */
 			   Brw_DB_AddPath (Gbl.Usrs.Me.UsrDat.UsrCod,FileType,
@@ -6613,6 +6723,9 @@ void Brw_CreateFolder (void)
 	       /* Create the new directory */
 	       if (mkdir (Path,(mode_t) 0xFFF) == 0)
 		 {
+		  /* Add the new folder to folder index */
+		  BrwSiz_AddFolderToIndex (Path);
+
 		  /* Check if quota has been exceeded */
 		  BrwSiz_CalcSizeOfDir (Size,Gbl.FileBrowser.Path.RootFolder);
 		  BrwSiz_SetMaxQuota (Size);
@@ -6648,6 +6761,7 @@ void Brw_CreateFolder (void)
 			break;
 		     case Err_ERROR:	// Quota excedeed
 		     default:
+			BrwSiz_RemoveFromIndex (Path);
 			Fil_RemoveTree (Path);
 			Ale_ShowAlert (Ale_WARNING,Txt_Can_not_create_the_folder_X_because_it_would_exceed_the_disk_quota,
 				       Gbl.FileBrowser.NewFilFolLnkName);
@@ -6765,6 +6879,7 @@ void Brw_RenFolder (void)
 					     NewPathInTree);
 		     Brw_DB_RenameChildrenFilesOrFolders (OldPathInTree,
 							  NewPathInTree);
+		     BrwSiz_RenameInIndex (OldPath,NewPath);
 
 		     /* Remove affected clipboards */
 		     Brw_DB_RemoveAffectedClipboards (Gbl.FileBrowser.Type,
@@ -6952,6 +7067,9 @@ static Err_SuccessOrError_t Brw_RcvFileInFileBrw (struct BrwSiz_BrowserSize *Siz
 				   }
 				 else			// Success
 				   {
+				    /* Add the new file to folder index */
+				    BrwSiz_AddFileToIndex (Path);
+
 				    /* Check if quota has been exceeded */
 				    BrwSiz_CalcSizeOfDir (Size,Gbl.FileBrowser.Path.RootFolder);
 				    BrwSiz_SetMaxQuota (Size);
@@ -7024,6 +7142,7 @@ static Err_SuccessOrError_t Brw_RcvFileInFileBrw (struct BrwSiz_BrowserSize *Siz
 					  break;
 				       case Err_ERROR:	// Qupta exceeded
 				       default:
+					  BrwSiz_RemoveFromIndex (Path);
 					  Fil_RemoveTree (Path);
 					  Ale_CreateAlert (Ale_WARNING,NULL,
 							   Txt_UPLOAD_FILE_X_quota_exceeded_NO_HTML,
@@ -7157,6 +7276,9 @@ void Brw_CreateLink (void)
 			   /* Close file */
 			   fclose (FileURL);
 
+			   /* Add the new link to folder index */
+			   BrwSiz_AddFileToIndex (Path);
+
 			   /* Check if quota has been exceeded */
 			   BrwSiz_CalcSizeOfDir (Size,Gbl.FileBrowser.Path.RootFolder);
 			   BrwSiz_SetMaxQuota (Size);
@@ -7218,6 +7340,7 @@ void Brw_CreateLink (void)
 				 break;
 			      case Err_ERROR:	// Quota exceeded
 			      default:
+				 BrwSiz_RemoveFromIndex (Path);
 				 Fil_RemoveTree (Path);
 				 Ale_ShowAlert (Ale_WARNING,Txt_Can_not_create_the_link_X_because_it_would_exceed_the_disk_quota,
 						FileName);
@@ -9835,6 +9958,9 @@ static void Brw_ScanDirRemovingOldFiles (unsigned Level,
 static void Brw_RemoveFileFromDiskAndDB (const char Path[PATH_MAX + 1],
                                          const char FullPathInTree[PATH_MAX + 1])
   {
+   /***** Update folder index *****/
+   BrwSiz_RemoveFromIndex (Path);
+
    /***** Remove file from disk *****/
    if (unlink (Path))
       Err_ShowErrorAndExit ("Can not remove file / link.");
@@ -9854,6 +9980,9 @@ static int Brw_RemoveFolderFromDiskAndDB (const char Path[PATH_MAX + 1],
   {
    int Result;
 
+   /***** Update folder index *****/
+   BrwSiz_RemoveFromIndex (Path);
+
    /***** Remove folder from disk *****/
    Result = rmdir (Path);	// On success, zero is returned.
 				// On error, -1 is returned, and errno is set appropriately.
@@ -9866,6 +9995,9 @@ static int Brw_RemoveFolderFromDiskAndDB (const char Path[PATH_MAX + 1],
       /***** Remove affected expanded folders *****/
       Brw_DB_RemoveAffectedExpandedFolders (FullPathInTree);
      }
+   else
+      /***** Folder not removed ==> restore it in folder index *****/
+      BrwSiz_AddFolderToIndex (Path);
 
    return Result;
   }
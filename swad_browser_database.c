@@ -35,6 +35,7 @@
 #include "swad_global.h"
 #include "swad_private_public.h"
 #include "swad_project.h"
+#include "swad_search_index.h"
 
 /*****************************************************************************/
 /******************** Global variables from other modules ********************/
@@ -167,9 +168,10 @@ long Brw_DB_AddPath (long PublisherUsrCod,Brw_FileType_t FileType,
                      PriPub_PrivateOrPublic_t PrivateOrPublic,Brw_License_t License)
   {
    extern const char PriPub_Public_YN[PriPub_NUM_PRIVATE_PUBLIC];
+   long FilCod;
 
    /***** Add path to the database *****/
-   return
+   FilCod =
    DB_QueryINSERTandReturnCode ("can not add path to database",
 				"INSERT INTO brw_files"
 				" (FileBrowser,Cod,ZoneUsrCod,PublisherUsrCod,"
@@ -185,6 +187,11 @@ long Brw_DB_AddPath (long PublisherUsrCod,Brw_FileType_t FileType,
 				FullPathInTree,
 				PriPub_Public_YN[PrivateOrPublic],
 				(unsigned) License);
+
+   /***** Add file name to search index *****/
+   SchIdx_IndexFileName (FilCod,FullPathInTree);
+
+   return FilCod;
   }
 
 /*****************************************************************************/
@@ -207,6 +214,9 @@ void Brw_DB_RenameOneFolder (const char OldPath[PATH_MAX + 1],
 		   Brw_GetCodForFileBrowser (Gbl.FileBrowser.Type),
 		   Brw_GetZoneUsrCodForFileBrowser (),
 		   OldPath);
+
+   /***** Update file name in search index *****/
+   SchIdx_IndexFileName (Brw_DB_GetFilCodByPath (NewPath,Brw_ANY_FILE),NewPath);
   }
 
 /*****************************************************************************/
@@ -508,6 +518,23 @@ void Brw_DB_RemoveOneFileOrFolder (const char Path[PATH_MAX + 1])
 	          ZoneUsrCod,
 	          Path);
 
+   /***** Remove from database the trigrams used to search these files *****/
+   DB_QueryDELETE ("can not remove trigrams of files from database",
+		  "DELETE FROM sch_trigrams"
+		  " USING brw_files,"
+		         "sch_trigrams"
+		  " WHERE brw_files.FileBrowser=%u"
+		    " AND brw_files.Cod=%ld"
+		    " AND brw_files.ZoneUsrCod=%ld"
+		    " AND brw_files.Path='%s'"
+		    " AND brw_files.FilCod=sch_trigrams.Cod"
+		    " AND sch_trigrams.Idx=%u",
+	          (unsigned) FileBrowser,
+	          Cod,
+	          ZoneUsrCod,
+	          Path,
+	          (unsigned) SchIdx_FIL);
+
    /***** Remove from database the entry that stores the data of a file *****/
    DB_QueryDELETE ("can not remove path from database",
 		   "DELETE FROM brw_files"
@@ -561,6 +588,23 @@ void Brw_DB_RemoveChildrenOfFolder (const char Path[PATH_MAX + 1])
                   ZoneUsrCod,
                   Path);
 
+   /***** Remove from database the trigrams used to search these files *****/
+   DB_QueryDELETE ("can not remove trigrams of files from database",
+		  "DELETE FROM sch_trigrams"
+		  " USING brw_files,"
+		         "sch_trigrams"
+		  " WHERE brw_files.FileBrowser=%u"
+		    " AND brw_files.Cod=%ld"
+		    " AND brw_files.ZoneUsrCod=%ld"
+		    " AND brw_files.Path LIKE '%s/%%'"
+		    " AND brw_files.FilCod=sch_trigrams.Cod"
+		    " AND sch_trigrams.Idx=%u",
+                  (unsigned) FileBrowser,
+                  Cod,
+                  ZoneUsrCod,
+                  Path,
+                  (unsigned) SchIdx_FIL);
+
    /***** Remove from database the entries that store the data of files *****/
    DB_QueryDELETE ("can not remove paths from database",
 		   "DELETE FROM brw_files"
@@ -592,6 +636,20 @@ void Brw_DB_RemoveInsFiles (long HieCod)
 	           (unsigned) Brw_ADMI_SHR_INS,
 	           HieCod);
 
+   /***** Remove from database the trigrams used to search these files *****/
+   DB_QueryDELETE ("can not remove trigrams of files of an institution",
+		   "DELETE FROM sch_trigrams"
+		   " USING brw_files,"
+		          "sch_trigrams"
+		   " WHERE brw_files.FileBrowser IN (%u,%u)"
+		     " AND brw_files.Cod=%ld"
+		     " AND brw_files.FilCod=sch_trigrams.Cod"
+		     " AND sch_trigrams.Idx=%u",
+	           (unsigned) Brw_ADMI_DOC_INS,
+	           (unsigned) Brw_ADMI_SHR_INS,
+	           HieCod,
+	           (unsigned) SchIdx_FIL);
+
    /***** Remove from database expanded folders *****/
    DB_QueryDELETE ("can not remove expanded folders of an institution",
 		   "DELETE LOW_PRIORITY FROM brw_expanded"
@@ -632,6 +690,14 @@ void Brw_DB_RemoveInsFiles (long HieCod)
 	           (unsigned) Brw_ADMI_SHR_INS,
 	           HieCod);
 
+   DB_QueryDELETE ("can not remove folder indexes of file zones of an institution",
+		   "DELETE FROM brw_folders"
+		   " WHERE FileBrowser IN (%u,%u)"
+		     " AND Cod=%ld",
+	           (unsigned) Brw_ADMI_DOC_INS,
+	           (unsigned) Brw_ADMI_SHR_INS,
+	           HieCod);
+
    /***** Remove from database the entries that store the data files *****/
    DB_QueryDELETE ("can not remove files of an institution",
 		   "DELETE FROM brw_files"
@@ -660,6 +726,20 @@ void Brw_DB_RemoveCtrFiles (long HieCod)
 	           (unsigned) Brw_ADMI_SHR_CTR,
 	           HieCod);
 
+   /***** Remove from database the trigrams used to search these files *****/
+   DB_QueryDELETE ("can not remove trigrams of files of a center",
+		   "DELETE FROM sch_trigrams"
+		   " USING brw_files,"
+		          "sch_trigrams"
+		   " WHERE brw_files.FileBrowser IN (%u,%u)"
+		     " AND brw_files.Cod=%ld"
+		     " AND brw_files.FilCod=sch_trigrams.Cod"
+		     " AND sch_trigrams.Idx=%u",
+	           (unsigned) Brw_ADMI_DOC_CTR,
+	           (unsigned) Brw_ADMI_SHR_CTR,
+	           HieCod,
+	           (unsigned) SchIdx_FIL);
+
    /***** Remove from database expanded folders *****/
    DB_QueryDELETE ("can not remove expanded folders of a center",
 		   "DELETE LOW_PRIORITY FROM brw_expanded"
@@ -696,6 +776,14 @@ void Brw_DB_RemoveCtrFiles (long HieCod)
 	           (unsigned) Brw_ADMI_SHR_CTR,
 	           HieCod);
 
+   DB_QueryDELETE ("can not remove folder indexes of file zones of a center",
+		   "DELETE FROM brw_folders"
+		   " WHERE FileBrowser IN (%u,%u)"
+		     " AND Cod=%ld",
+	           (unsigned) Brw_ADMI_DOC_CTR,
+	           (unsigned) Brw_ADMI_SHR_CTR,
+	           HieCod);
+
    /***** Remove from database the entries that store the data files *****/
    DB_QueryDELETE ("can not remove files of a center",
 		   "DELETE FROM brw_files"
@@ -724,6 +812,20 @@ void Brw_DB_RemoveDegFiles (long HieCod)
 	           (unsigned) Brw_ADMI_SHR_DEG,
 	           HieCod);
 
+   /***** Remove from database the trigrams used to search these files *****/
+   DB_QueryDELETE ("can not remove trigrams of files of a degree",
+		   "DELETE FROM sch_trigrams"
+		   " USING brw_files,"
+		          "sch_trigrams"
+		   " WHERE brw_files.FileBrowser IN (%u,%u)"
+		     " AND brw_files.Cod=%ld"
+		     " AND brw_files.FilCod=sch_trigrams.Cod"
+		     " AND sch_trigrams.Idx=%u",
+	           (unsigned) Brw_ADMI_DOC_DEG,
+	           (unsigned) Brw_ADMI_SHR_DEG,
+	           HieCod,
+	           (unsigned) SchIdx_FIL);
+
    /***** Remove from database expanded folders *****/
    DB_QueryDELETE ("can not remove expanded folders of a degree",
 		   "DELETE LOW_PRIORITY FROM brw_expanded"
@@ -760,6 +862,14 @@ void Brw_DB_RemoveDegFiles (long HieCod)
 	           (unsigned) Brw_ADMI_SHR_DEG,
 	           HieCod);
 
+   DB_QueryDELETE ("can not remove folder indexes of file zones of a degree",
+		   "DELETE FROM brw_folders"
+		   " WHERE FileBrowser IN (%u,%u)"
+		     " AND Cod=%ld",
+	           (unsigned) Brw_ADMI_DOC_DEG,
+	           (unsigned) Brw_ADMI_SHR_DEG,
+	           HieCod);
+
    /***** Remove from database the entries that store the data files *****/
    DB_QueryDELETE ("can not remove files of a degree",
 		   "DELETE FROM brw_files"
@@ -826,6 +936,23 @@ void Brw_DB_RemoveCrsFiles (long HieCod)
 	           (unsigned) Brw_ADMI_MRK_CRS,
 	           HieCod);
 
+   DB_QueryDELETE ("can not remove trigrams of files of a course",
+		   "DELETE FROM sch_trigrams"
+		   " USING brw_files,"
+		          "sch_trigrams"
+		   " WHERE brw_files.FileBrowser IN (%u,%u,%u,%u,%u,%u)"
+		     " AND brw_files.Cod=%ld"
+		     " AND brw_files.FilCod=sch_trigrams.Cod"
+		     " AND sch_trigrams.Idx=%u",
+	           (unsigned) Brw_ADMI_DOC_CRS,
+	           (unsigned) Brw_ADMI_TCH_CRS,
+	           (unsigned) Brw_ADMI_SHR_CRS,
+	           (unsigned) Brw_ADMI_ASG_USR,
+	           (unsigned) Brw_ADMI_WRK_USR,
+	           (unsigned) Brw_ADMI_MRK_CRS,
+	           HieCod,
+	           (unsigned) SchIdx_FIL);
+
    /* Remove from group file zones */
    DB_QueryDELETE ("can not remove file views to files of a course",
 		   "DELETE FROM brw_views"
@@ -840,6 +967,21 @@ void Brw_DB_RemoveCrsFiles (long HieCod)
 	           (unsigned) Brw_ADMI_MRK_GRP,
 	           SubqueryGrp);
 
+   DB_QueryDELETE ("can not remove trigrams of files of a course",
+		   "DELETE FROM sch_trigrams"
+		   " USING brw_files,"
+		          "sch_trigrams"
+		   " WHERE brw_files.FileBrowser IN (%u,%u,%u,%u)"
+		     " AND brw_files.Cod IN %s"
+		     " AND brw_files.FilCod=sch_trigrams.Cod"
+		     " AND sch_trigrams.Idx=%u",
+	           (unsigned) Brw_ADMI_DOC_GRP,
+	           (unsigned) Brw_ADMI_TCH_GRP,
+	           (unsigned) Brw_ADMI_SHR_GRP,
+	           (unsigned) Brw_ADMI_MRK_GRP,
+	           SubqueryGrp,
+	           (unsigned) SchIdx_FIL);
+
    /* Remove from project file zones */
    DB_QueryDELETE ("can not remove file views to files of a course",
 		   "DELETE FROM brw_views"
@@ -852,6 +994,19 @@ void Brw_DB_RemoveCrsFiles (long HieCod)
 	           (unsigned) Brw_ADMI_ASS_PRJ,
 	           SubqueryPrj);
 
+   DB_QueryDELETE ("can not remove trigrams of files of a course",
+		   "DELETE FROM sch_trigrams"
+		   " USING brw_files,"
+		          "sch_trigrams"
+		   " WHERE brw_files.FileBrowser IN (%u,%u)"
+		     " AND brw_files.Cod IN %s"
+		     " AND brw_files.FilCod=sch_trigrams.Cod"
+		     " AND sch_trigrams.Idx=%u",
+	           (unsigned) Brw_ADMI_DOC_PRJ,
+	           (unsigned) Brw_ADMI_ASS_PRJ,
+	           SubqueryPrj,
+	           (unsigned) SchIdx_FIL);
+
    /***** Remove from database expanded folders *****/
    /* Remove from course file zones */
    DB_QueryDELETE ("can not remove expanded folders of a course",
@@ -973,6 +1128,18 @@ void Brw_DB_RemoveCrsFiles (long HieCod)
 	           (unsigned) Brw_ADMI_MRK_CRS,
 	           HieCod);
 
+   DB_QueryDELETE ("can not remove folder indexes of file zones of a course",
+		   "DELETE FROM brw_folders"
+		   " WHERE FileBrowser IN (%u,%u,%u,%u,%u,%u)"
+		     " AND Cod=%ld",
+	           (unsigned) Brw_ADMI_DOC_CRS,
+	           (unsigned) Brw_ADMI_TCH_CRS,
+	           (unsigned) Brw_ADMI_SHR_CRS,
+	           (unsigned) Brw_ADMI_ASG_USR,
+	           (unsigned) Brw_ADMI_WRK_USR,
+	           (unsigned) Brw_ADMI_MRK_CRS,
+	           HieCod);
+
    /* Remove from group file zones */
    DB_QueryDELETE ("can not remove sizes of file zones of a course",
 		   "DELETE FROM brw_sizes"
@@ -984,6 +1151,16 @@ void Brw_DB_RemoveCrsFiles (long HieCod)
 	           (unsigned) Brw_ADMI_MRK_GRP,
 	           SubqueryGrp);
 
+   DB_QueryDELETE ("can not remove folder indexes of file zones of a course",
+		   "DELETE FROM brw_folders"
+		   " WHERE FileBrowser IN (%u,%u,%u,%u)"
+		     " AND Cod IN %s",
+	           (unsigned) Brw_ADMI_DOC_GRP,
+	           (unsigned) Brw_ADMI_TCH_GRP,
+	           (unsigned) Brw_ADMI_SHR_GRP,
+	           (unsigned) Brw_ADMI_MRK_GRP,
+	           SubqueryGrp);
+
    /* Remove from project file zones */
    DB_QueryDELETE ("can not remove sizes of file zones of a course",
 		   "DELETE FROM brw_sizes"
@@ -993,6 +1170,14 @@ void Brw_DB_RemoveCrsFiles (long HieCod)
 	           (unsigned) Brw_ADMI_ASS_PRJ,
 	           SubqueryPrj);
 
+   DB_QueryDELETE ("can not remove folder indexes of file zones of a course",
+		   "DELETE FROM brw_folders"
+		   " WHERE FileBrowser IN (%u,%u)"
+		     " AND Cod IN %s",
+	           (unsigned) Brw_ADMI_DOC_PRJ,
+	           (unsigned) Brw_ADMI_ASS_PRJ,
+	           SubqueryPrj);
+
    /***** Remove from database the entries that store the data files *****/
    /* Remove from course file zones */
    DB_QueryDELETE ("can not remove files of a course",
@@ -1060,6 +1245,22 @@ void Brw_DB_RemoveGrpFiles (long GrpCod)
 	           (unsigned) Brw_ADMI_MRK_GRP,
 	           GrpCod);
 
+   /***** Remove from database the trigrams used to search these files *****/
+   DB_QueryDELETE ("can not remove trigrams of files of a group",
+		   "DELETE FROM sch_trigrams"
+		   " USING brw_files,"
+		          "sch_trigrams"
+		   " WHERE brw_files.FileBrowser IN (%u,%u,%u,%u)"
+		     " AND brw_files.Cod=%ld"
+		     " AND brw_files.FilCod=sch_trigrams.Cod"
+		     " AND sch_trigrams.Idx=%u",
+	           (unsigned) Brw_ADMI_DOC_GRP,
+	           (unsigned) Brw_ADMI_TCH_GRP,
+	           (unsigned) Brw_ADMI_SHR_GRP,
+	           (unsigned) Brw_ADMI_MRK_GRP,
+	           GrpCod,
+	           (unsigned) SchIdx_FIL);
+
    /***** Remove from database expanded folders *****/
    DB_QueryDELETE ("can not remove expanded folders of a group",
 		   "DELETE LOW_PRIORITY FROM brw_expanded"
@@ -1104,6 +1305,16 @@ void Brw_DB_RemoveGrpFiles (long GrpCod)
 	           (unsigned) Brw_ADMI_MRK_GRP,
 	           GrpCod);
 
+   DB_QueryDELETE ("can not remove folder indexes of file zones of a group",
+		   "DELETE FROM brw_folders"
+		   " WHERE FileBrowser IN (%u,%u,%u,%u)"
+		   " AND Cod=%ld",
+	           (unsigned) Brw_ADMI_DOC_GRP,
+	           (unsigned) Brw_ADMI_TCH_GRP,
+	           (unsigned) Brw_ADMI_SHR_GRP,
+	           (unsigned) Brw_ADMI_MRK_GRP,
+	           GrpCod);
+
    /***** Remove from database the entries that store the data files *****/
    DB_QueryDELETE ("can not remove files of a group",
 		   "DELETE FROM brw_files"
@@ -1134,6 +1345,20 @@ void Brw_DB_RemovePrjFiles (long PrjCod)
 	           (unsigned) Brw_ADMI_ASS_PRJ,
 	           PrjCod);
 
+   /***** Remove from database the trigrams used to search these files *****/
+   DB_QueryDELETE ("can not remove trigrams of files of a project",
+		   "DELETE FROM sch_trigrams"
+		   " USING brw_files,"
+		          "sch_trigrams"
+		   " WHERE brw_files.FileBrowser IN (%u,%u)"
+		     " AND brw_files.Cod=%ld"
+		     " AND brw_files.FilCod=sch_trigrams.Cod"
+		     " AND sch_trigrams.Idx=%u",
+	           (unsigned) Brw_ADMI_DOC_PRJ,
+	           (unsigned) Brw_ADMI_ASS_PRJ,
+	           PrjCod,
+	           (unsigned) SchIdx_FIL);
+
    /***** Remove from database expanded folders *****/
    DB_QueryDELETE ("can not remove expanded folders of a project",
 		   "DELETE LOW_PRIORITY FROM brw_expanded"
@@ -1170,6 +1395,14 @@ void Brw_DB_RemovePrjFiles (long PrjCod)
 	           (unsigned) Brw_ADMI_ASS_PRJ,
 	           PrjCod);
 
+   DB_QueryDELETE ("can not remove folder indexes of file zones of a project",
+		   "DELETE FROM brw_folders"
+		   " WHERE FileBrowser IN (%u,%u)"
+		     " AND Cod=%ld",
+	           (unsigned) Brw_ADMI_DOC_PRJ,
+	           (unsigned) Brw_ADMI_ASS_PRJ,
+	           PrjCod);
+
    /***** Remove from database the entries that store the data files *****/
    DB_QueryDELETE ("can not remove files of a project",
 		   "DELETE FROM brw_files"
@@ -1302,6 +1535,21 @@ void Brw_DB_RemoveWrkFiles (long HieCod,long UsrCod)
 	           (unsigned) Brw_ADMI_WRK_USR,
 	           HieCod,UsrCod);
 
+   /***** Remove from database the trigrams used to search these files *****/
+   DB_QueryDELETE ("can not remove trigrams of files",
+		   "DELETE FROM sch_trigrams"
+		   " USING brw_files,"
+		          "sch_trigrams"
+		   " WHERE brw_files.FileBrowser IN (%u,%u)"
+		     " AND brw_files.Cod=%ld"
+		     " AND brw_files.ZoneUsrCod=%ld"
+		     " AND brw_files.FilCod=sch_trigrams.Cod"
+		     " AND sch_trigrams.Idx=%u",
+	           (unsigned) Brw_ADMI_ASG_USR,
+	           (unsigned) Brw_ADMI_WRK_USR,
+	           HieCod,UsrCod,
+	           (unsigned) SchIdx_FIL);
+
    /***** Remove from database expanded folders *****/
    DB_QueryDELETE ("can not remove expanded folders of a group",
 		   "DELETE LOW_PRIORITY FROM brw_expanded"
@@ -1332,6 +1580,15 @@ void Brw_DB_RemoveWrkFiles (long HieCod,long UsrCod)
 	           (unsigned) Brw_ADMI_WRK_USR,
 	           HieCod,UsrCod);
 
+   DB_QueryDELETE ("can not remove file browser folder indexes",
+		   "DELETE FROM brw_folders"
+		   " WHERE FileBrowser IN (%u,%u)"
+		     " AND Cod=%ld"
+		     " AND ZoneUsrCod=%ld",
+	           (unsigned) Brw_ADMI_ASG_USR,
+	           (unsigned) Brw_ADMI_WRK_USR,
+	           HieCod,UsrCod);
+
    /***** Remove from database the entries that store the data files *****/
    DB_QueryDELETE ("can not remove files",
 		   "DELETE FROM brw_files"
@@ -1360,6 +1617,17 @@ void Brw_DB_RemoveUsrFiles (long UsrCod)
 		     " AND brw_files.FilCod=brw_views.FilCod",
 	           UsrCod);
 
+   /***** Remove from database the trigrams used to search these files *****/
+   DB_QueryDELETE ("can not remove trigrams of files of a user",
+		   "DELETE FROM sch_trigrams"
+		   " USING brw_files,"
+		          "sch_trigrams"
+		   " WHERE brw_files.ZoneUsrCod=%ld"
+		     " AND brw_files.FilCod=sch_trigrams.Cod"
+		     " AND sch_trigrams.Idx=%u",
+	           UsrCod,
+	           (unsigned) SchIdx_FIL);
+
    /***** Remove from database expanded folders *****/
    DB_QueryDELETE ("can not remove expanded folders for a user",
 		   "DELETE LOW_PRIORITY FROM brw_expanded"
@@ -1384,6 +1652,11 @@ void Brw_DB_RemoveUsrFiles (long UsrCod)
 		   " WHERE ZoneUsrCod=%ld",
 	           UsrCod);
 
+   DB_QueryDELETE ("can not remove folder indexes of user's file zones",
+		   "DELETE FROM brw_folders"
+		   " WHERE ZoneUsrCod=%ld",
+	           UsrCod);
+
    /***** Remove from database the entries that store the data files *****/
    DB_QueryDELETE ("can not remove files in user's file zones",
 		   "DELETE FROM brw_files"
@@ -3738,3 +4011,290 @@ void Brw_DB_GetSizeOfFileBrowser (MYSQL_RES **mysql_res,
 	 break;
      }
   }
+
+/*****************************************************************************/
+/*************** Check if folder index of a file zone is valid ***************/
+/*****************************************************************************/
+// Path is the full path in tree of the root folder
+// Example: descarga
+
+Exi_Exist_t Brw_DB_CheckIfFolderIndexIsValid (const char Path[PATH_MAX + 1])
+  {
+   extern const Brw_FileBrowser_t Brw_DB_FileBrowserForDB_files[Brw_NUM_TYPES_FILE_BROWSER];
+
+   return
+   DB_QueryEXISTS ("can not check if folder index is valid",
+		   "SELECT EXISTS"
+		   "(SELECT *"
+		     " FROM brw_folders"
+		    " WHERE FileBrowser=%u"
+		      " AND Cod=%ld"
+		      " AND ZoneUsrCod=%ld"
+		      " AND PathHash=UNHEX(MD5('%s'))"
+		      " AND VerifyTime>FROM_UNIXTIME(UNIX_TIMESTAMP()-%lu))",
+		   (unsigned) Brw_DB_FileBrowserForDB_files[Gbl.FileBrowser.Type],
+		   Brw_GetCodForFileBrowser (Gbl.FileBrowser.Type),
+		   Brw_GetZoneUsrCodForFileBrowser (),
+		   Path,
+		   Cfg_TIME_TO_VERIFY_BROWSER_FOLDERS);
+  }
+
+/*****************************************************************************/
+/********** Get the size of a file zone adding the folders in index **********/
+/*****************************************************************************/
+
+void Brw_DB_GetSizeFromFolderIndex (MYSQL_RES **mysql_res)
+  {
+   extern const Brw_FileBrowser_t Brw_DB_FileBrowserForDB_files[Brw_NUM_TYPES_FILE_BROWSER];
+
+   DB_QuerySELECT (mysql_res,"can not get size of a file zone",
+		   "SELECT COALESCE(MAX(IF(NumFolders+NumFiles>0,"
+				 "LENGTH(Path)-LENGTH(REPLACE(Path,'/',''))+1,"
+				 "0)),0),"		// row[0]
+			  "COALESCE(SUM(NumFolders),0),"	// row[1]
+			  "COALESCE(SUM(NumFiles),0),"	// row[2]
+			  "COALESCE(SUM(Size),0)"		// row[3]
+		    " FROM brw_folders"
+		   " WHERE FileBrowser=%u"
+		     " AND Cod=%ld"
+		     " AND ZoneUsrCod=%ld",
+		   (unsigned) Brw_DB_FileBrowserForDB_files[Gbl.FileBrowser.Type],
+		   Brw_GetCodForFileBrowser (Gbl.FileBrowser.Type),
+		   Brw_GetZoneUsrCodForFileBrowser ());
+  }
+
+/*****************************************************************************/
+/************* Get number of files and folders inside a folder ***************/
+/*****************************************************************************/
+// Return -1 if the folder is not in index
+
+int Brw_DB_GetNumFilesAndFoldersFromFolderIndex (const char Path[PATH_MAX + 1])
+  {
+   extern const Brw_FileBrowser_t Brw_DB_FileBrowserForDB_files[Brw_NUM_TYPES_FILE_BROWSER];
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   int NumFilesAndFolders = -1;
+
+   /***** Get number of files and folders directly inside a folder *****/
+   if (DB_QuerySELECT (&mysql_res,"can not get number of files in folder",
+		       "SELECT NumFolders+NumFiles"
+			" FROM brw_folders"
+		       " WHERE FileBrowser=%u"
+			 " AND Cod=%ld"
+			 " AND ZoneUsrCod=%ld"
+			 " AND PathHash=UNHEX(MD5('%s'))",
+		       (unsigned) Brw_DB_FileBrowserForDB_files[Gbl.FileBrowser.Type],
+		       Brw_GetCodForFileBrowser (Gbl.FileBrowser.Type),
+		       Brw_GetZoneUsrCodForFileBrowser (),
+		       Path))
+     {
+      row = mysql_fetch_row (mysql_res);
+      if (sscanf (row[0],"%d",&NumFilesAndFolders) != 1)
+	 NumFilesAndFolders = -1;
+     }
+
+   /***** Free structure that stores the query result *****/
+   DB_FreeMySQLResult (&mysql_res);
+
+   return NumFilesAndFolders;
+  }
+
+/*****************************************************************************/
+/****** Get number of files and folders inside each subfolder of a folder ****/
+/*****************************************************************************/
+// Only subfolders directly inside the folder are returned,
+// ordered by name (binary collation, as strcmp)
+
+unsigned Brw_DB_GetNumFilesAndFoldersInSubfoldersFromFolderIndex (MYSQL_RES **mysql_res,
+								  const char Path[PATH_MAX + 1])
+  {
+   extern const Brw_FileBrowser_t Brw_DB_FileBrowserForDB_files[Brw_NUM_TYPES_FILE_BROWSER];
+   unsigned LengthPath = (unsigned) strlen (Path);
+
+   return (unsigned)
+   DB_QuerySELECT (mysql_res,"can not get number of files in folders",
+		   "SELECT SUBSTRING(Path,%u),"		// row[0]: name of subfolder
+			  "NumFolders+NumFiles"		// row[1]
+		    " FROM brw_folders"
+		   " WHERE FileBrowser=%u"
+		     " AND Cod=%ld"
+		     " AND ZoneUsrCod=%ld"
+		     " AND LEFT(Path,%u)='%s/'"
+		     " AND LOCATE('/',Path,%u)=0"
+		" ORDER BY Path",
+		   LengthPath + 2,
+		   (unsigned) Brw_DB_FileBrowserForDB_files[Gbl.FileBrowser.Type],
+		   Brw_GetCodForFileBrowser (Gbl.FileBrowser.Type),
+		   Brw_GetZoneUsrCodForFileBrowser (),
+		   LengthPath + 1,Path,
+		   LengthPath + 2);
+  }
+
+/*****************************************************************************/
+/************************** Add a folder to index ****************************/
+/*****************************************************************************/
+// If the folder is already in index (index rebuilt at the same time
+// by another request), its counters are replaced, so it's never counted twice
+
+void Brw_DB_AddFolderToIndex (const char Path[PATH_MAX + 1],
+			      unsigned long NumFolds,unsigned long NumFiles,
+			      unsigned long long Size)
+  {
+   extern const Brw_FileBrowser_t Brw_DB_FileBrowserForDB_files[Brw_NUM_TYPES_FILE_BROWSER];
+
+   DB_QueryINSERT ("can not add folder to index",
+		   "INSERT INTO brw_folders"
+		   " (FileBrowser,Cod,ZoneUsrCod,Path,PathHash,"
+		     "NumFolders,NumFiles,Size,VerifyTime)"
+		   " VALUES"
+		   " (%u,%ld,%ld,'%s',UNHEX(MD5('%s')),"
+		     "%lu,%lu,%llu,NOW())"
+		   " ON DUPLICATE KEY UPDATE"
+		   " NumFolders=VALUES(NumFolders),"
+		   "NumFiles=VALUES(NumFiles),"
+		   "Size=VALUES(Size),"
+		   "VerifyTime=NOW()",
+		   (unsigned) Brw_DB_FileBrowserForDB_files[Gbl.FileBrowser.Type],
+		   Brw_GetCodForFileBrowser (Gbl.FileBrowser.Type),
+		   Brw_GetZoneUsrCodForFileBrowser (),
+		   Path,Path,
+		   NumFolds,NumFiles,Size);
+  }
+
+/*****************************************************************************/
+/************ Update the counters of a folder in the folder index ************/
+/*****************************************************************************/
+
+void Brw_DB_UpdateFolderInIndex (const char Path[PATH_MAX + 1],
+				 int DeltaFolds,int DeltaFiles,long long DeltaSize)
+  {
+   extern const Brw_FileBrowser_t Brw_DB_FileBrowserForDB_files[Brw_NUM_TYPES_FILE_BROWSER];
+
+   DB_QueryUPDATE ("can not update folder in index",
+		   "UPDATE brw_folders"
+		     " SET NumFolders=GREATEST(NumFolders+(%d),0),"
+			  "NumFiles=GREATEST(NumFiles+(%d),0),"
+			  "Size=GREATEST(Size+(%lld),0)"
+		   " WHERE FileBrowser=%u"
+		     " AND Cod=%ld"
+		     " AND ZoneUsrCod=%ld"
+		     " AND PathHash=UNHEX(MD5('%s'))",
+		   DeltaFolds,DeltaFiles,DeltaSize,
+		   (unsigned) Brw_DB_FileBrowserForDB_files[Gbl.FileBrowser.Type],
+		   Brw_GetCodForFileBrowser (Gbl.FileBrowser.Type),
+		   Brw_GetZoneUsrCodForFileBrowser (),
+		   Path);
+  }
+
+/*****************************************************************************/
+/********** Rename a folder and its subfolders in the folder index ***********/
+/*****************************************************************************/
+
+void Brw_DB_RenameSubtreeInFolderIndex (const char OldPath[PATH_MAX + 1],
+				        const char NewPath[PATH_MAX + 1])
+  {
+   extern const Brw_FileBrowser_t Brw_DB_FileBrowserForDB_files[Brw_NUM_TYPES_FILE_BROWSER];
+   unsigned StartFinalSubpathNotChanged = strlen (OldPath) + 2;
+
+   /***** Remove folders in destination, if any, to not duplicate them *****/
+   Brw_DB_RemoveSubtreeFromFolderIndex (NewPath);
+
+   /***** Rename the folder itself *****/
+   DB_QueryUPDATE ("can not rename folder in index",
+		   "UPDATE brw_folders"
+		     " SET Path='%s',"
+			  "PathHash=UNHEX(MD5('%s'))"
+		   " WHERE FileBrowser=%u"
+		     " AND Cod=%ld"
+		     " AND ZoneUsrCod=%ld"
+		     " AND PathHash=UNHEX(MD5('%s'))",
+		   NewPath,NewPath,
+		   (unsigned) Brw_DB_FileBrowserForDB_files[Gbl.FileBrowser.Type],
+		   Brw_GetCodForFileBrowser (Gbl.FileBrowser.Type),
+		   Brw_GetZoneUsrCodForFileBrowser (),
+		   OldPath);
+
+   /***** Rename its subfolders *****/
+   // Assignments are made from left to right, so hash is computed from new path
+   DB_QueryUPDATE ("can not rename folders in index",
+		   "UPDATE brw_folders"
+		     " SET Path=CONCAT('%s','/',SUBSTRING(Path,%u)),"
+			  "PathHash=UNHEX(MD5(Path))"
+		   " WHERE FileBrowser=%u"
+		     " AND Cod=%ld"
+		     " AND ZoneUsrCod=%ld"
+		     " AND Path LIKE '%s/%%'",
+		   NewPath,StartFinalSubpathNotChanged,
+		   (unsigned) Brw_DB_FileBrowserForDB_files[Gbl.FileBrowser.Type],
+		   Brw_GetCodForFileBrowser (Gbl.FileBrowser.Type),
+		   Brw_GetZoneUsrCodForFileBrowser (),
+		   OldPath);
+  }
+
+/*****************************************************************************/
+/********* Remove a folder and its subfolders from the folder index **********/
+/*****************************************************************************/
+
+void Brw_DB_RemoveSubtreeFromFolderIndex (const char Path[PATH_MAX + 1])
+  {
+   extern const Brw_FileBrowser_t Brw_DB_FileBrowserForDB_files[Brw_NUM_TYPES_FILE_BROWSER];
+
+   DB_QueryDELETE ("can not remove folders from index",
+		   "DELETE FROM brw_folders"
+		   " WHERE FileBrowser=%u"
+		     " AND Cod=%ld"
+		     " AND ZoneUsrCod=%ld"
+		     " AND (PathHash=UNHEX(MD5('%s')) OR Path LIKE '%s/%%')",
+		   (unsigned) Brw_DB_FileBrowserForDB_files[Gbl.FileBrowser.Type],
+		   Brw_GetCodForFileBrowser (Gbl.FileBrowser.Type),
+		   Brw_GetZoneUsrCodForFileBrowser (),
+		   Path,Path);
+  }
+
+/*****************************************************************************/
+/****************** Remove the folder index of a file zone *******************/
+/*****************************************************************************/
+
+void Brw_DB_RemoveFolderIndex (void)
+  {
+   extern const Brw_FileBrowser_t Brw_DB_FileBrowserForDB_files[Brw_NUM_TYPES_FILE_BROWSER];
+
+   DB_QueryDELETE ("can not remove folder index",
+		   "DELETE FROM brw_folders"
+		   " WHERE FileBrowser=%u"
+		     " AND Cod=%ld"
+		     " AND ZoneUsrCod=%ld",
+		   (unsigned) Brw_DB_FileBrowserForDB_files[Gbl.FileBrowser.Type],
+		   Brw_GetCodForFileBrowser (Gbl.FileBrowser.Type),
+		   Brw_GetZoneUsrCodForFileBrowser ());
+  }
+
+/*****************************************************************************/
+/********* Remove the folder index of the assignments of a user **************/
+/*****************************************************************************/
+
+void Brw_DB_RemoveFolderIndexOfAsgZone (long CrsCod,long UsrCod)
+  {
+   DB_QueryDELETE ("can not remove folder index",
+		   "DELETE FROM brw_folders"
+		   " WHERE FileBrowser=%u"
+		     " AND Cod=%ld"
+		     " AND ZoneUsrCod=%ld",
+		   (unsigned) Brw_ADMI_ASG_USR,
+		   CrsCod,
+		   UsrCod);
+  }
+
+/*****************************************************************************/
+/********************* Remove expired folder indexes *************************/
+/*****************************************************************************/
+// Zones not verified recently are removed from index
+// and rebuilt from disk next time they are accessed
+
+void Brw_DB_RemoveExpiredFolderIndexes (void)
+  {
+   DB_QueryDELETE ("can not remove expired folder indexes",
+		   "DELETE LOW_PRIORITY FROM brw_folders"
+		   " WHERE VerifyTime<FROM_UNIXTIME(UNIX_TIMESTAMP()-%lu)",
+                   Cfg_TIME_TO_VERIFY_BROWSER_FOLDERS);
+  }
@@ -131,4 +131,22 @@ void Brw_DB_GetSizeOfFileBrowser (MYSQL_RES **mysql_res,
 				  Hie_Level_t HieLvl,
                                   Brw_FileBrowser_t FileBrowser);
 
+//------------------------ Folder index of file zones -------------------------
+Exi_Exist_t Brw_DB_CheckIfFolderIndexIsValid (const char Path[PATH_MAX + 1]);
+void Brw_DB_GetSizeFromFolderIndex (MYSQL_RES **mysql_res);
+int Brw_DB_GetNumFilesAndFoldersFromFolderIndex (const char Path[PATH_MAX + 1]);
+unsigned Brw_DB_GetNumFilesAndFoldersInSubfoldersFromFolderIndex (MYSQL_RES **mysql_res,
+								  const char Path[PATH_MAX + 1]);
+void Brw_DB_AddFolderToIndex (const char Path[PATH_MAX + 1],
+			      unsigned long NumFolds,unsigned long NumFiles,
+			      unsigned long long Size);
+void Brw_DB_UpdateFolderInIndex (const char Path[PATH_MAX + 1],
+				 int DeltaFolds,int DeltaFiles,long long DeltaSize);
+void Brw_DB_RenameSubtreeInFolderIndex (const char OldPath[PATH_MAX + 1],
+				        const char NewPath[PATH_MAX + 1]);
+void Brw_DB_RemoveSubtreeFromFolderIndex (const char Path[PATH_MAX + 1]);
+void Brw_DB_RemoveFolderIndex (void);
+void Brw_DB_RemoveFolderIndexOfAsgZone (long CrsCod,long UsrCod);
+void Brw_DB_RemoveExpiredFolderIndexes (void);
+
 #endif
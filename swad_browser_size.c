@@ -35,7 +35,9 @@
 #include "swad_browser_size.h"
 #include "swad_database.h"
 #include "swad_error.h"
+#include "swad_file.h"
 #include "swad_global.h"
+#include "swad_string.h"
 
 /*****************************************************************************/
 /**************************** Private constants ******************************/
@@ -126,6 +128,16 @@ static unsigned long long BrwSiz_MAX_QUOTA_BRIEF[Rol_NUM_ROLES] =	// MaxRole is
 #define BrwSiz_MAX_FILES_BRIEF	5000
 #define BrwSiz_MAX_FOLDS_BRIEF	1000
 
+/*****************************************************************************/
+/******************************* Private types *******************************/
+/*****************************************************************************/
+
+typedef enum
+  {
+   BrwSiz_DONT_UPDATE_INDEX,
+   BrwSiz_UPDATE_INDEX,
+  } BrwSiz_UpdateIndex_t;
+
 /*****************************************************************************/
 /************** External global variables from others modules ****************/
 /*****************************************************************************/
@@ -143,7 +155,12 @@ struct BrwSiz_BrowserSize Brw_Size;
 /*****************************************************************************/
 
 static void BrwSiz_CalcSizeOfDirRecursive (struct BrwSiz_BrowserSize *Size,
-                                           unsigned Level,char *Path);
+                                           unsigned Level,char *Path,
+                                           BrwSiz_UpdateIndex_t UpdateIndex);
+static void BrwSiz_GetSizeFromFolderIndex (struct BrwSiz_BrowserSize *Size);
+static const char *BrwSiz_GetPathInTree (const char *Path);
+static void BrwSiz_GetParentPathInTree (const char *PathInTree,
+				        char ParentPathInTree[PATH_MAX + 1]);
 
 /*****************************************************************************/
 /********************* Get pointer to browser size struct ********************/
@@ -314,11 +331,29 @@ void BrwSiz_ResetFileBrowserSize (struct BrwSiz_BrowserSize *Size)
 /*****************************************************************************/
 /********************** Compute the size of a directory **********************/
 /*****************************************************************************/
+// When Path is the root folder of the current file zone,
+// the size is got from the folder index, which is rebuilt from disk
+// if it does not exist or if it has not been verified recently
 
 void BrwSiz_CalcSizeOfDir (struct BrwSiz_BrowserSize *Size,char *Path)
   {
+   const char *PathInTree;
+
    BrwSiz_ResetFileBrowserSize (Size);
-   BrwSiz_CalcSizeOfDirRecursive (Size,1,Path);
+
+   if (strcmp (Path,Gbl.FileBrowser.Path.RootFolder) ||
+       (PathInTree = BrwSiz_GetPathInTree (Path)) == NULL)
+      /***** Not a file zone ==> scan the directory *****/
+      BrwSiz_CalcSizeOfDirRecursive (Size,1,Path,BrwSiz_DONT_UPDATE_INDEX);
+   else if (Brw_DB_CheckIfFolderIndexIsValid (PathInTree) == Exi_EXISTS)
+      /***** Get size from folder index *****/
+      BrwSiz_GetSizeFromFolderIndex (Size);
+   else
+     {
+      /***** Rebuild folder index scanning the whole file zone *****/
+      Brw_DB_RemoveFolderIndex ();
+      BrwSiz_CalcSizeOfDirRecursive (Size,1,Path,BrwSiz_UPDATE_INDEX);
+     }
   }
 
 /*****************************************************************************/
@@ -326,13 +361,18 @@ void BrwSiz_CalcSizeOfDir (struct BrwSiz_BrowserSize *Size,char *Path)
 /*****************************************************************************/
 
 static void BrwSiz_CalcSizeOfDirRecursive (struct BrwSiz_BrowserSize *Size,
-                                           unsigned Level,char *Path)
+                                           unsigned Level,char *Path,
+                                           BrwSiz_UpdateIndex_t UpdateIndex)
   {
    struct dirent **FileList;
    int NumFile;
    int NumFiles;
    char PathFileRel[PATH_MAX + 1];
    struct stat FileStatus;
+   const char *PathInTree;
+   unsigned long NumFoldsInDir = 0;
+   unsigned long NumFilesInDir = 0;
+   unsigned long long SizeOfDir = 0ULL;
 
    /***** Scan the directory *****/
    if ((NumFiles = scandir (Path,&FileList,NULL,NULL)) >= 0)	// No error
@@ -356,14 +396,14 @@ static void BrwSiz_CalcSizeOfDirRecursive (struct BrwSiz_BrowserSize *Size,
 	       Err_ShowErrorAndExit ("Can not get information about a file or folder.");
 	    else if (S_ISDIR (FileStatus.st_mode))		// It's a directory
 	      {
-	       Size->NumFolds++;
-	       Size->TotalSiz += (unsigned long long) FileStatus.st_size;
-	       BrwSiz_CalcSizeOfDirRecursive (Size,Level + 1,PathFileRel);
+	       NumFoldsInDir++;
+	       SizeOfDir += (unsigned long long) FileStatus.st_size;
+	       BrwSiz_CalcSizeOfDirRecursive (Size,Level + 1,PathFileRel,UpdateIndex);
 	      }
 	    else if (S_ISREG (FileStatus.st_mode))		// It's a regular file
 	      {
-	       Size->NumFiles++;
-	       Size->TotalSiz += (unsigned long long) FileStatus.st_size;
+	       NumFilesInDir++;
+	       SizeOfDir += (unsigned long long) FileStatus.st_size;
 	      }
 	   }
 	 free (FileList[NumFile]);
@@ -372,6 +412,179 @@ static void BrwSiz_CalcSizeOfDirRecursive (struct BrwSiz_BrowserSize *Size,
      }
    else
       Err_ShowErrorAndExit ("Error while scanning directory.");
+
+   /***** Update total size *****/
+   Size->NumFolds += NumFoldsInDir;
+   Size->NumFiles += NumFilesInDir;
+   Size->TotalSiz += SizeOfDir;
+
+   /***** Store this folder in folder index *****/
+   if (UpdateIndex == BrwSiz_UPDATE_INDEX)
+      if ((PathInTree = BrwSiz_GetPathInTree (Path)))
+	 Brw_DB_AddFolderToIndex (PathInTree,NumFoldsInDir,NumFilesInDir,SizeOfDir);
+  }
+
+/*****************************************************************************/
+/*************** Get the size of a file zone from folder index ***************/
+/*****************************************************************************/
+
+static void BrwSiz_GetSizeFromFolderIndex (struct BrwSiz_BrowserSize *Size)
+  {
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+
+   /***** Add the sizes of all folders in current file zone *****/
+   Brw_DB_GetSizeFromFolderIndex (&mysql_res);
+   row = mysql_fetch_row (mysql_res);
+
+   /***** Get number of levels (row[0]),
+          number of folders (row[1]),
+          number of files (row[2])
+          and total size (row[3]) *****/
+   if (sscanf (row[0],"%u",&Size->NumLevls) != 1 ||
+       sscanf (row[1],"%lu",&Size->NumFolds) != 1 ||
+       sscanf (row[2],"%lu",&Size->NumFiles) != 1 ||
+       sscanf (row[3],"%llu",&Size->TotalSiz) != 1)
+      Err_ShowErrorAndExit ("Error when getting size of file zone.");
+
+   /***** Free structure that stores the query result *****/
+   DB_FreeMySQLResult (&mysql_res);
+  }
+
+/*****************************************************************************/
+/**************** Update folder index after adding a file ********************/
+/*****************************************************************************/
+// Path is the full path in disk of a new file or link
+
+void BrwSiz_AddFileToIndex (const char *Path)
+  {
+   const char *PathInTree;
+   char ParentPathInTree[PATH_MAX + 1];
+   struct stat FileStatus;
+
+   if ((PathInTree = BrwSiz_GetPathInTree (Path)))
+      if (!lstat (Path,&FileStatus))	// On success ==> 0 is returned
+	 if (S_ISREG (FileStatus.st_mode))
+	   {
+	    BrwSiz_GetParentPathInTree (PathInTree,ParentPathInTree);
+	    Brw_DB_UpdateFolderInIndex (ParentPathInTree,
+					0,1,(long long) FileStatus.st_size);
+	   }
+  }
+
+/*****************************************************************************/
+/********* Update folder index after creating or pasting a folder ************/
+/*****************************************************************************/
+// Path is the full path in disk of a new folder, maybe with content
+
+void BrwSiz_AddFolderToIndex (const char *Path)
+  {
+   const char *PathInTree;
+   char ParentPathInTree[PATH_MAX + 1];
+   char PathCopy[PATH_MAX + 1];
+   struct stat FileStatus;
+   struct BrwSiz_BrowserSize SizeOfSubtree;
+
+   if ((PathInTree = BrwSiz_GetPathInTree (Path)))
+     {
+      /***** If parent folder is not in index, the zone is not indexed *****/
+      BrwSiz_GetParentPathInTree (PathInTree,ParentPathInTree);
+      if (Brw_DB_GetNumFilesAndFoldersFromFolderIndex (ParentPathInTree) < 0)
+	 return;
+
+      if (!lstat (Path,&FileStatus))	// On success ==> 0 is returned
+	 if (S_ISDIR (FileStatus.st_mode))
+	   {
+	    /***** Add the new folder and its subfolders to index *****/
+	    Brw_DB_RemoveSubtreeFromFolderIndex (PathInTree);
+	    Str_Copy (PathCopy,Path,sizeof (PathCopy) - 1);
+	    BrwSiz_ResetFileBrowserSize (&SizeOfSubtree);
+	    BrwSiz_CalcSizeOfDirRecursive (&SizeOfSubtree,1,PathCopy,
+					   BrwSiz_UPDATE_INDEX);
+
+	    /***** Update parent folder *****/
+	    Brw_DB_UpdateFolderInIndex (ParentPathInTree,
+					1,0,(long long) FileStatus.st_size);
+	   }
+     }
+  }
+
+/*****************************************************************************/
+/********* Update folder index before removing a file or a folder ************/
+/*****************************************************************************/
+// Path is the full path in disk of a file, link or folder that will be removed
+
+void BrwSiz_RemoveFromIndex (const char *Path)
+  {
+   const char *PathInTree;
+   char ParentPathInTree[PATH_MAX + 1];
+   struct stat FileStatus;
+
+   if ((PathInTree = BrwSiz_GetPathInTree (Path)))
+      if (!lstat (Path,&FileStatus))	// On success ==> 0 is returned
+	{
+	 BrwSiz_GetParentPathInTree (PathInTree,ParentPathInTree);
+	 if (S_ISDIR (FileStatus.st_mode))
+	   {
+	    Brw_DB_RemoveSubtreeFromFolderIndex (PathInTree);
+	    Brw_DB_UpdateFolderInIndex (ParentPathInTree,
+					-1,0,-(long long) FileStatus.st_size);
+	   }
+	 else if (S_ISREG (FileStatus.st_mode))
+	    Brw_DB_UpdateFolderInIndex (ParentPathInTree,
+					0,-1,-(long long) FileStatus.st_size);
+	}
+  }
+
+/*****************************************************************************/
+/************ Update folder index after renaming a file or folder ************/
+/*****************************************************************************/
+// OldPath and NewPath are full paths in disk, inside the same folder
+
+void BrwSiz_RenameInIndex (const char *OldPath,const char *NewPath)
+  {
+   const char *OldPathInTree;
+   const char *NewPathInTree;
+
+   /***** Only folders are stored in index *****/
+   if ((OldPathInTree = BrwSiz_GetPathInTree (OldPath)) &&
+       (NewPathInTree = BrwSiz_GetPathInTree (NewPath)))
+      if (Fil_CheckIfPathExists (NewPath) == Exi_EXISTS)
+	{
+	 Brw_DB_RemoveSubtreeFromFolderIndex (NewPathInTree);
+	 Brw_DB_RenameSubtreeInFolderIndex (OldPathInTree,NewPathInTree);
+	}
+  }
+
+/*****************************************************************************/
+/************ Get path in tree from full path in disk of a file **************/
+/*****************************************************************************/
+// Return NULL if path is not inside current file zone
+
+static const char *BrwSiz_GetPathInTree (const char *Path)
+  {
+   size_t Length = strlen (Gbl.FileBrowser.Path.AboveRootFolder);
+
+   if (Length &&
+       !strncmp (Path,Gbl.FileBrowser.Path.AboveRootFolder,Length) &&
+       Path[Length] == '/')
+      return &Path[Length + 1];
+
+   return NULL;
+  }
+
+/*****************************************************************************/
+/************* Get path in tree of the folder containing a file **************/
+/*****************************************************************************/
+
+static void BrwSiz_GetParentPathInTree (const char *PathInTree,
+				        char ParentPathInTree[PATH_MAX + 1])
+  {
+   char *Ptr;
+
+   Str_Copy (ParentPathInTree,PathInTree,PATH_MAX);
+   if ((Ptr = strrchr (ParentPathInTree,'/')))
+      *Ptr = '\0';
   }
 
 /*****************************************************************************/
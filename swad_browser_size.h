@@ -68,6 +68,10 @@ Err_SuccessOrError_t BrwSiz_CheckQuota (const struct BrwSiz_BrowserSize *Size);
 
 void BrwSiz_ResetFileBrowserSize (struct BrwSiz_BrowserSize *Size);
 void BrwSiz_CalcSizeOfDir (struct BrwSiz_BrowserSize *Size,char *Path);
+void BrwSiz_AddFileToIndex (const char *Path);
+void BrwSiz_AddFolderToIndex (const char *Path);
+void BrwSiz_RemoveFromIndex (const char *Path);
+void BrwSiz_RenameInIndex (const char *OldPath,const char *NewPath);
 
 void BrwSiz_GetSizeOfFileZone (Hie_Level_t HieLvl,Brw_FileBrowser_t FileBrowser,
                                struct BrwSiz_SizeOfFileZone *SizeOfFileZone);
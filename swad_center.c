@@ -657,11 +657,6 @@ static void Ctr_GetCoordFromRow (MYSQL_RES *mysql_res,
 void Ctr_WriteSelectorOfCenter (void)
   {
    extern const char *Txt_HIERARCHY_SINGUL_Abc[Hie_NUM_LEVELS];
-   MYSQL_RES *mysql_res;
-   MYSQL_ROW row;
-   unsigned NumCtrs;
-   unsigned NumCtr;
-   long HieCod;
 
    /***** Begin form *****/
    Frm_BeginFormGoTo (ActSeeDeg);
@@ -679,32 +674,9 @@ void Ctr_WriteSelectorOfCenter (void)
 							       HTM_NO_ATTR) | HTM_DISABLED,
 		     "[%s]",Txt_HIERARCHY_SINGUL_Abc[Hie_CTR]);
 
+	 /***** List centers of current institution *****/
 	 if (Gbl.Hierarchy.Node[Hie_INS].HieCod > 0)
-	   {
-	    /***** Get centers in current institution from database *****/
-	    NumCtrs = Ctr_DB_GetBasicListOfCtrsInCurrentIns (&mysql_res);
-	    for (NumCtr = 0;
-		 NumCtr < NumCtrs;
-		 NumCtr++)
-	      {
-	       /* Get next center */
-	       row = mysql_fetch_row (mysql_res);
-
-	       /* Get center code (row[0]) */
-	       if ((HieCod = Str_ConvertStrCodToLongCod (row[0])) < 0)
-		  Err_WrongCenterExit ();
-
-	       /* Write option */
-	       HTM_OPTION (HTM_Type_LONG,&HieCod,
-			   Gbl.Hierarchy.Node[Hie_CTR].HieCod > 0 &&
-			   HieCod == Gbl.Hierarchy.Node[Hie_CTR].HieCod ? HTM_SELECTED :
-									  HTM_NO_ATTR,
-			   "%s",row[1]);
-	      }
-
-	    /***** Free structure that stores the query result *****/
-	    DB_FreeMySQLResult (&mysql_res);
-	   }
+	    Hie_WriteOptionsOfChildren (Hie_CTR,Gbl.Hierarchy.Node[Hie_CTR].HieCod);
 
       /***** End selector *****/
       HTM_SELECT_End ();
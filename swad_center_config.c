@@ -47,7 +47,9 @@
 #include "swad_hierarchy_config.h"
 #include "swad_hierarchy_type.h"
 #include "swad_HTML.h"
+#include "swad_image.h"
 #include "swad_logo.h"
+#include "swad_page_cache.h"
 #include "swad_parameter.h"
 #include "swad_place.h"
 #include "swad_www.h"
@@ -855,9 +857,6 @@ void CtrCfg_ReceivePhoto (void)
    char PathFileImgTmp[PATH_MAX + 1];	// Full name (including path and .jpg) of the destination temporary file
    char PathFileImg[PATH_MAX + 1];	// Full name (including path and .jpg) of the destination file
    Err_SuccessOrError_t SuccessOrError;
-   char Command[1024 + PATH_MAX * 2];
-   int ReturnCode;
-   char ErrorMsg[256];
 
    /***** Copy in disk the file received *****/
    Par = Fil_StartReceptionOfFile (Fil_NAME_OF_PARAM_FILENAME_ORG,
@@ -924,32 +923,22 @@ void CtrCfg_ReceivePhoto (void)
 	     (unsigned)  Gbl.Hierarchy.Node[Hie_CTR].HieCod,
 	     (unsigned)  Gbl.Hierarchy.Node[Hie_CTR].HieCod);
 
-   /* Call to program that makes the conversion */
-   snprintf (Command,sizeof (Command),
-             "convert %s -resize '%ux%u>' -quality %u %s",
-             PathFileImgTmp,
-             Ctr_PHOTO_SAVED_MAX_WIDTH,
-             Ctr_PHOTO_SAVED_MAX_HEIGHT,
-             Ctr_PHOTO_SAVED_QUALITY,
-             PathFileImg);
-   ReturnCode = system (Command);
-   if (ReturnCode == -1)
-      Err_ShowErrorAndExit ("Error when running command to process image.");
-
-   /***** Write message depending on return code *****/
-   ReturnCode = WEXITSTATUS(ReturnCode);
-   if (ReturnCode)
+   if (Img_ResizeImage (PathFileImgTmp,PathFileImg,
+			Ctr_PHOTO_SAVED_MAX_WIDTH,
+			Ctr_PHOTO_SAVED_MAX_HEIGHT,
+			Img_SHRINK_TO_FIT,
+			Ctr_PHOTO_SAVED_QUALITY) == Err_ERROR)
      {
-      snprintf (ErrorMsg,sizeof (ErrorMsg),
-	        "Image could not be processed successfully.<br>"
-		"Error code returned by the program of processing: %d",
-	        ReturnCode);
-      Err_ShowErrorAndExit (ErrorMsg);
+      unlink (PathFileImgTmp);
+      Err_ShowErrorAndExit ("Image could not be processed successfully.");
      }
 
    /***** Remove temporary file *****/
    unlink (PathFileImgTmp);
 
+   /***** Photo is shown in cached pages *****/
+   PagCac_RemoveCachedPages ();
+
    /***** Show the center information again *****/
    CtrCfg_ShowConfiguration ();
   }
@@ -28,6 +28,7 @@
 #define _GNU_SOURCE 		// For asprintf
 #include <stdio.h>		// For asprintf
 #include <stdlib.h>		// For free
+#include <string.h>		// For strcmp
 
 #include "swad_center.h"
 #include "swad_center_config.h"
@@ -36,8 +37,11 @@
 #include "swad_global.h"
 #include "swad_hierarchy.h"
 #include "swad_hierarchy_database.h"
+#include "swad_hierarchy_snapshot.h"
 #include "swad_media.h"
+#include "swad_name.h"
 #include "swad_search.h"
+#include "swad_search_index.h"
 #include "swad_www.h"
 
 /*****************************************************************************/
@@ -52,7 +56,9 @@ extern struct Globals Gbl;
 
 long Ctr_DB_CreateCenter (const struct Hie_Node *Ctr,Hie_Status_t Status)
   {
-   return
+   long HieCod;
+
+   HieCod =
    DB_QueryINSERTandReturnCode ("can not create a new center",
 				"INSERT INTO ctr_centers"
 				" (InsCod,PlcCod,Status,RequesterUsrCod,"
@@ -67,6 +73,13 @@ long Ctr_DB_CreateCenter (const struct Hie_Node *Ctr,Hie_Status_t Status)
 				Ctr->ShrtName,
 				Ctr->FullName,
 				Ctr->WWW);
+
+   HieSnp_Invalidate ();
+
+   /***** Add full name to search index *****/
+   SchIdx_IndexName (SchIdx_CTR,HieCod,Ctr->FullName);
+
+   return HieCod;
   }
 
 /*****************************************************************************/
@@ -527,6 +540,8 @@ void Ctr_DB_UpdateCtrIns (long HieCod,long NewInsCod)
 		   " WHERE CtrCod=%ld",
                    NewInsCod,
                    HieCod);
+
+   HieSnp_Invalidate ();
   }
 
 /*****************************************************************************/
@@ -541,6 +556,8 @@ void Ctr_DB_UpdateCtrPlc (long HieCod,long NewPlcCod)
 		   " WHERE CtrCod=%ld",
 	           NewPlcCod,
 	           HieCod);
+
+   HieSnp_Invalidate ();
   }
 
 /*****************************************************************************/
@@ -550,6 +567,8 @@ void Ctr_DB_UpdateCtrPlc (long HieCod,long NewPlcCod)
 void Ctr_DB_UpdateCtrName (long HieCod,
 			   const char *FldName,const char *NewCtrName)
   {
+   extern const char *Nam_Fields[Nam_NUM_SHRT_FULL_NAMES];
+
    /***** Update center changing old name by new name */
    DB_QueryUPDATE ("can not update the name of a center",
 		   "UPDATE ctr_centers"
@@ -557,6 +576,12 @@ void Ctr_DB_UpdateCtrName (long HieCod,
 		   " WHERE CtrCod=%ld",
 	           FldName,NewCtrName,
 	           HieCod);
+
+   HieSnp_Invalidate ();
+
+   /***** Update full name in search index *****/
+   if (!strcmp (FldName,Nam_Fields[Nam_FULL_NAME]))
+      SchIdx_IndexName (SchIdx_CTR,HieCod,NewCtrName);
   }
 
 /*****************************************************************************/
@@ -571,6 +596,8 @@ void Ctr_DB_UpdateCtrWWW (long HieCod,const char NewWWW[WWW_MAX_BYTES_WWW + 1])
 		   " WHERE CtrCod=%ld",
 	           NewWWW,
 	           HieCod);
+
+   HieSnp_Invalidate ();
   }
 
 /*****************************************************************************/
@@ -617,6 +644,8 @@ void Ctr_DB_UpdateCtrStatus (long HieCod,Hie_Status_t NewStatus)
 		   " WHERE CtrCod=%ld",
 	           (unsigned) NewStatus,
 	           HieCod);
+
+   HieSnp_Invalidate ();
   }
 
 /*****************************************************************************/
@@ -810,4 +839,9 @@ void Ctr_DB_RemoveCenter (long HieCod)
 		   "DELETE FROM ctr_centers"
 		   " WHERE CtrCod=%ld",
 		   HieCod);
+
+   HieSnp_Invalidate ();
+
+   /***** Remove full name from search index *****/
+   SchIdx_RemoveName (SchIdx_CTR,HieCod);
   }
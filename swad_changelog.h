@@ -639,10 +639,88 @@ TODO: Al confirmar el DNI de un profesor, sale "Wrong action" en el horario de t
 
 TODO: Javier Fernndez Baldomero. Contemplar los shorts de Youtube https://youtube.com/shorts/fY6Oax_uJBc?si=G3UHqvSH3yEbxm1B
 */
-#define Chl_PLATFORM_VERSION	"SWAD 25.48.1 (2026-07-17)"
+#define Chl_PLATFORM_VERSION	"SWAD 25.73.15 (2026-10-19)"
 #define Chl_CSS_FILE		"swad25.46.css"
-#define Chl_JS_FILE		"swad24.75.js"
+#define Chl_JS_FILE		"swad25.73.js"
 /*
+	Version 25.73.15: Oct 19, 2026	Fixed bugs in bundles of assets: files from changelog and limit of asset name from constant. (359273 lines)
+	Version 25.73.14: Oct 19, 2026	Fix bug: if Markdown text of course information can not be rendered, the HTML rendered previously is shown. (359269 lines)
+	Version 25.73.13: Oct 19, 2026	Optimization: courses of connected users are kept in index of connected users and read from database only when they change. (359265 lines)
+	Version 25.73.12: Oct 19, 2026	Fix bug: users without sessions are removed from table of connected users in one of every seven refreshes. (359147 lines)
+	Version 25.73.11: Oct 19, 2026	Fix bug: temporary sprite sheet of class photo is created in the directory of sprite sheets, so it can be renamed even if private and public directories are in different file systems. (359142 lines)
+	Version 25.73.10: Oct 19, 2026	Fix bug: the average and median photos of a degree are computed keeping only one decoded photo per thread and bounding the memory of histograms. (358752 lines)
+	Version 25.73.9:  Oct 19, 2026	Fix: pages served from cache are logged and checked by firewall. (358769 lines)
+	Version 25.73.8:  Oct 19, 2026	Fix: selectors of institution, center, degree and course in hierarchy menu read from snapshot of hierarchy. (358756 lines)
+	Version 25.73.7:  Oct 19, 2026	Fix: number of files in subfolders of a listed folder got from folder index in one query. (358637 lines)
+	Version 25.73.6:  Oct 19, 2026	Fix: data of selected attendance events are got once before listing details of students, not once per student. (358514 lines)
+	Version 25.73.5:  Oct 19, 2026	Fixed bug in rendering of Markdown: when pandoc or iconv fail, the previous HTML is kept. (358495 lines)
+	Version 25.73.4:  Oct 19, 2026	Fixed bug in API function getUsersIfModified: version depends also on role and groups requested. (358476 lines)
+	Version 25.73.3:  Oct 19, 2026	Fixed bug in folder index: a folder could be stored twice when the index of a file zone was rebuilt by two requests at the same time, so quotas were counted twice. (358430 lines)
+					3 changes necessary in database:
+TRUNCATE TABLE brw_folders;
+ALTER TABLE brw_folders ADD COLUMN PathHash BINARY(16) NOT NULL AFTER Path;
+ALTER TABLE brw_folders DROP INDEX FileBrowser,ADD UNIQUE INDEX(FileBrowser,Cod,ZoneUsrCod,PathHash);
+
+	Version 25.73.2:  Oct 19, 2026	Removed logging of performance of a sample of requests. New load test (make bench) replaying CGI requests against a synthetic database, reporting p50/p99 time, queries and memory per action. (358411 lines)
+					1 change necessary in database:
+DROP TABLE IF EXISTS log_perf;
+
+	Version 25.73.1:  Oct 19, 2026	Fixed bug in page cache: pages are cached with their end and removed when data shown in them are changed from any node. (358538 lines)
+	Version 25.73:    Oct 19, 2026	Automatic refreshes are slowed down when server is loaded, depending on average time to generate pages and on system load. Refreshes in JavaScript use jitter and exponential backoff after errors. (358339 lines)
+	Version 25.72:    Oct 19, 2026	Connected users are kept in an index shared by all processes, bucketed by minute, so right column does not scan table of connected users. (358026 lines)
+	Version 25.71:    Oct 19, 2026	Enrolment of users pasted in a list or selected from clipboard with set-based queries. (356817 lines)
+	Version 25.70:    Oct 19, 2026	Answers of all questions in a survey are got with a single query. Number of users who have chosen each answer in a match is got with a single query. (356161 lines)
+	Version 25.69:    Oct 19, 2026	Exam and test questions are drawn in the program from a seed instead of sorting by RAND(). Seed is stored in exam print. (356059 lines)
+					1 change necessary in database:
+ALTER TABLE exa_prints ADD COLUMN Seed BIGINT UNSIGNED NOT NULL DEFAULT 0 AFTER Score;
+
+	Version 25.68:    Oct 19, 2026	Bundles of style sheets and scripts with hashed names, minified and precompressed, built with make assets and used in pages when available. (355900 lines)
+	Version 25.67:    Oct 19, 2026	Columnar archive of clicks in closed years of log, used to compute global statistics. (355828 lines)
+	Version 25.66:    Oct 19, 2026	Attendance of several users in several events is read in one query into a bitset matrix. (353710 lines)
+	Version 25.65:    Oct 19, 2026	Faster import of test questions: XML parsed in place with elements allocated in blocks, and tags and answers inserted with one query per question. (353437 lines)
+	Version 25.64:    Oct 19, 2026	Index of users' IDs in files of marks, built when the file is received, to show marks of a student without scanning the whole file. (353352 lines)
+	Version 25.63:    Oct 19, 2026	Markdown course info is converted to HTML only when the text changes. API function getCourseInfo returns rich text. (352869 lines)
+	Version 25.62:    Oct 19, 2026	Compressed cache of public pages for users not logged. (352756 lines)
+	Version 25.61:    Oct 19, 2026	Optional tracing spans of the main phases of each request, database queries and external commands, written in Trace Event Format. (352374 lines)
+	Version 25.60:    Oct 19, 2026	Histogram of response time, number of database queries and memory per action, stored for a sample of requests. (352026 lines)
+					1 change necessary in database:
+CREATE TABLE IF NOT EXISTS log_perf (ActCod INT NOT NULL,Bucket TINYINT NOT NULL,NumClicks INT NOT NULL DEFAULT 0,SumTime BIGINT NOT NULL DEFAULT 0,SumQueries BIGINT NOT NULL DEFAULT 0,SumRSS BIGINT NOT NULL DEFAULT 0,MaxRSS BIGINT NOT NULL DEFAULT 0,UNIQUE INDEX(ActCod,Bucket)) ENGINE=MyISAM;
+
+	Version 25.59:    Oct 19, 2026	New API functions getCoursesIfModified, getUsersIfModified, getNotificationsIfModified and getDirectoryTreeIfModified. Directory tree is built in memory. (351885 lines)
+	Version 25.58:    Oct 19, 2026	Denormalized counters of posts, writers and readers in forum threads. (351510 lines)
+					4 changes necessary in database:
+ALTER TABLE for_threads ADD COLUMN NumPsts INT NOT NULL DEFAULT 0 AFTER LastPstCod,ADD COLUMN NumWriters INT NOT NULL DEFAULT 0 AFTER NumPsts,ADD COLUMN NumReaders INT NOT NULL DEFAULT 0 AFTER NumWriters;
+UPDATE for_threads SET NumPsts=(SELECT COUNT(*) FROM for_posts WHERE for_posts.ThrCod=for_threads.ThrCod),NumWriters=(SELECT COUNT(DISTINCT UsrCod) FROM for_posts WHERE for_posts.ThrCod=for_threads.ThrCod),NumReaders=(SELECT COUNT(*) FROM for_read WHERE for_read.ThrCod=for_threads.ThrCod);
+ALTER TABLE for_read ADD COLUMN NumReadPsts INT NOT NULL DEFAULT 0 AFTER ReadTime;
+UPDATE for_read SET NumReadPsts=(SELECT COUNT(*) FROM for_posts WHERE for_posts.ThrCod=for_read.ThrCod AND for_posts.CreatTime<=for_read.ReadTime);
+
+	Version 25.57:    Oct 19, 2026	Recipients of a message are got from database in one query, and received messages and notifications are inserted in one query. (351451 lines)
+	Version 25.56:    Oct 19, 2026	Searches of users, institutions, centers, degrees, courses and files are filtered using trigram indexes. (351226 lines)
+					2 changes necessary in database:
+CREATE TABLE IF NOT EXISTS sch_indexes (Idx TINYINT NOT NULL,LastCod INT NOT NULL DEFAULT -1,Ready ENUM('N','Y') NOT NULL DEFAULT 'N',UNIQUE INDEX(Idx)) ENGINE=MyISAM;
+CREATE TABLE IF NOT EXISTS sch_trigrams (Idx TINYINT NOT NULL,Trigram CHAR(3) COLLATE latin1_bin NOT NULL,Cod INT NOT NULL,UNIQUE INDEX(Idx,Trigram,Cod),INDEX(Idx,Cod)) ENGINE=MyISAM;
+
+	Version 25.55:    Oct 19, 2026	Current hierarchy is got from a snapshot file shared by all processes, rebuilt after changes. (350110 lines)
+	Version 25.54:    Oct 19, 2026	Students take seats in groups with a single conditional query instead of locking group tables for the whole platform. (349223 lines)
+	Version 25.53:    Oct 19, 2026	Per-folder index of number of files, folders and bytes in file zones, updated incrementally on uploads, removals, pastes and renames, and rebuilt from disk daily. (349152 lines)
+					1 change necessary in database:
+CREATE TABLE IF NOT EXISTS brw_folders (FileBrowser TINYINT NOT NULL,Cod INT NOT NULL DEFAULT -1,ZoneUsrCod INT NOT NULL DEFAULT -1,Path TEXT COLLATE latin1_bin NOT NULL,NumFolders INT NOT NULL DEFAULT 0,NumFiles INT NOT NULL DEFAULT 0,Size BIGINT NOT NULL DEFAULT 0,VerifyTime DATETIME NOT NULL,INDEX(FileBrowser,Cod,ZoneUsrCod),INDEX(ZoneUsrCod),INDEX(VerifyTime)) ENGINE=MyISAM;
+
+	Version 25.52:    Oct 19, 2026	Folders and assignments/works are compressed into ZIP64 files by SWAD itself, streaming the files without a temporary copy of the tree and deflating small files in parallel. (348510 lines)
+					The private directory swad/zip is not used anymore and can be removed.
+
+	Version 25.51:    Oct 19, 2026	Images, thumbnails and sprite sheets are processed in-process with MagickWand instead of calling ImageMagick commands. (347695 lines)
+					sudo apt install libmagickwand-dev
+
+	Version 25.50:    Oct 19, 2026	Class photos are drawn from cached sprite sheets with thumbnails of users' photos. Thumbnails are generated when a photo changes. (347442 lines)
+					ImageMagick 'montage' command is needed to build sprite sheets.
+
+	Version 25.49:    Oct 19, 2026	Average and median photos of a degree are computed for all sexs in a single pass by a new program. (347043 lines)
+					Compile foto_promedio_mediana and copy it to the CGI directory, replacing foto_mediana and foto_promedio:
+cd foto_promedio
+make
+sudo cp foto_promedio_mediana /var/www/cgi-bin/
+
 	Version 25.48.1:  Jul 17, 2026	Code refactoring in rubrics.
 					Changes in groups and attendance.(347032 lines)
 	Version 25.48:    Jul 10, 2026	Changes in timeline. Which users to view is stored in the session rather than in the user's preferences. Now users can see the timeline of all. (346990 lines)
@@ -33,6 +33,12 @@
 //#define SWAD_UGR_ES		// Comment this line if not applicable
 //#define SWADBERRY_UGR_ES	// Comment this line if not applicable
 
+/*****************************************************************************/
+/*** Uncomment to trace time spent in phases, queries and commands (debug) ***/
+/*****************************************************************************/
+
+//#define Cfg_TRACE_SPANS	// Write spans of each request to Cfg_PATH_TRACE_PRIVATE
+
 /*****************************************************************************/
 /********************************* Headers ***********************************/
 /*****************************************************************************/
@@ -189,7 +195,9 @@
 #endif
 
 /* Database */
+#ifndef Cfg_DATABASE_DBNAME	// Defined when compiling swad_bench for load tests
 #define Cfg_DATABASE_DBNAME		"swad"				// Database name
+#endif
 #define Cfg_DATABASE_USER		"swad"				// Database user
 
 /* Email */
@@ -268,6 +276,9 @@
 
 /* Config file */
 #define Cfg_FILE_CONFIG				"swad.cfg"
+
+/* Names of bundles of style sheets and scripts, inside public swad directory */
+#define Cfg_FILE_ASSETS_MANIFEST		"swad_assets.manifest"	// Generated with make assets. If not exists, original files are used
 #define Cfg_MAX_BYTES_DATABASE_PASSWORD		256
 #define Cfg_MAX_BYTES_SMTP_PASSWORD		256
 
@@ -307,6 +318,26 @@
 #define Cfg_FOLDER_OUT 				"out"			// Created automatically the first time it is accessed
 #define Cfg_PATH_OUT_PRIVATE			Cfg_PATH_SWAD_PRIVATE "/" Cfg_FOLDER_OUT
 
+/* Folder for cached public pages shown to not logged users, inside private swad directory */
+#define Cfg_FOLDER_PAGE_CACHE			"cache"			// Created automatically the first time it is accessed
+#define Cfg_PATH_PAGE_CACHE_PRIVATE		Cfg_PATH_SWAD_PRIVATE "/" Cfg_FOLDER_PAGE_CACHE
+
+/* Folder for tracing spans of this CGI, inside private swad directory (only if Cfg_TRACE_SPANS is defined) */
+#define Cfg_FOLDER_TRACE			"trace"			// Created automatically the first time it is accessed
+#define Cfg_PATH_TRACE_PRIVATE			Cfg_PATH_SWAD_PRIVATE "/" Cfg_FOLDER_TRACE
+
+/* Folder for the snapshot of the hierarchy shared by all processes of this CGI, inside private swad directory */
+#define Cfg_FOLDER_HIE_SNAPSHOT			"hie"			// Created automatically the first time it is accessed
+#define Cfg_PATH_HIE_SNAPSHOT_PRIVATE		Cfg_PATH_SWAD_PRIVATE "/" Cfg_FOLDER_HIE_SNAPSHOT
+
+/* Folder for the index of connected users shared by all processes of this CGI, inside private swad directory */
+#define Cfg_FOLDER_CONNECTED			"con"			// Created automatically the first time it is accessed
+#define Cfg_PATH_CONNECTED_PRIVATE		Cfg_PATH_SWAD_PRIVATE "/" Cfg_FOLDER_CONNECTED
+
+/* Folder for the load of the server shared by all processes of this CGI, inside private swad directory */
+#define Cfg_FOLDER_LOAD				"load"			// Created automatically the first time it is accessed
+#define Cfg_PATH_LOAD_PRIVATE			Cfg_PATH_SWAD_PRIVATE "/" Cfg_FOLDER_LOAD
+
 /* Folder for temporary public links to file zones, used when displaying file browsers, inside public swad directory */
 #define Cfg_FOLDER_FILE_BROWSER_TMP		"tmp"			// Created automatically the first time it is accessed
 #define Cfg_PATH_FILE_BROWSER_TMP_PUBLIC	Cfg_PATH_SWAD_PUBLIC "/" Cfg_FOLDER_FILE_BROWSER_TMP
@@ -316,14 +347,18 @@
 #define Cfg_FOLDER_MARK				"mark"			// Created automatically the first time it is accessed
 #define Cfg_PATH_MARK_PRIVATE			Cfg_PATH_SWAD_PRIVATE "/" Cfg_FOLDER_MARK
 
+/* Folder for indexes of users' IDs in files of marks, inside private swad directory */
+#define Cfg_FOLDER_MARK_INDEX			"markidx"		// Created automatically the first time it is accessed
+#define Cfg_PATH_MARK_INDEX_PRIVATE		Cfg_PATH_SWAD_PRIVATE "/" Cfg_FOLDER_MARK_INDEX
+
+/* Folder for columnar archive of clicks in closed years, inside private swad directory */
+#define Cfg_FOLDER_LOG_ARCHIVE			"logarc"		// Created automatically the first time it is accessed
+#define Cfg_PATH_LOG_ARCHIVE_PRIVATE		Cfg_PATH_SWAD_PRIVATE "/" Cfg_FOLDER_LOG_ARCHIVE
+
 /* Folder for temporary XML files received to import test questions, inside private swad directory */
 #define Cfg_FOLDER_TEST				"test"			// Created automatically the first time it is accessed
 #define Cfg_PATH_TEST_PRIVATE			Cfg_PATH_SWAD_PRIVATE "/" Cfg_FOLDER_TEST
 
-/* Folder for compression of assignments and works into a zip files, inside private swad directory */
-#define Cfg_FOLDER_ZIP				"zip"			// Created automatically the first time it is accessed
-#define Cfg_PATH_ZIP_PRIVATE			Cfg_PATH_SWAD_PRIVATE "/" Cfg_FOLDER_ZIP
-
 /* Folders for images/videos inside public and private swad directories */
 #define Cfg_FOLDER_MEDIA			"med"			// Created automatically the first time it is accessed
 #define Cfg_PATH_MEDIA_PRIVATE			Cfg_PATH_SWAD_PRIVATE "/" Cfg_FOLDER_MEDIA
@@ -341,6 +376,10 @@
 #define Cfg_PATH_PHOTO_TMP_PRIVATE		Cfg_PATH_PHOTO_PRIVATE "/" Cfg_FOLDER_PHOTO_TMP
 #define Cfg_PATH_PHOTO_TMP_PUBLIC		Cfg_PATH_PHOTO_PUBLIC "/" Cfg_FOLDER_PHOTO_TMP
 #define Cfg_URL_PHOTO_TMP_PUBLIC		Cfg_URL_PHOTO_PUBLIC "/" Cfg_FOLDER_PHOTO_TMP
+/* Folder for cached sprite sheets with class photos, inside public photos directory */
+#define Cfg_FOLDER_PHOTO_SPRITE			"sprite"		// Created automatically the first time it is accessed
+#define Cfg_PATH_PHOTO_SPRITE_PUBLIC		Cfg_PATH_PHOTO_PUBLIC "/" Cfg_FOLDER_PHOTO_SPRITE
+#define Cfg_URL_PHOTO_SPRITE_PUBLIC		Cfg_URL_PHOTO_PUBLIC "/" Cfg_FOLDER_PHOTO_SPRITE
 
 /* Folder for reports, inside public swad directory */
 #define Cfg_FOLDER_REP 				"rep"			// Created automatically the first time it is accessed
@@ -418,9 +457,8 @@
 // %s must be substituted by temporary file with the image received:
 #define Cfg_COMMAND_FACE_DETECTION			"./fotomaton cascade.xml %s 540"
 
-/* Commands to compute the average photo of a degree */
-#define Cfg_COMMAND_DEGREE_PHOTO_MEDIAN			"./foto_mediana"
-#define Cfg_COMMAND_DEGREE_PHOTO_AVERAGE		"./foto_promedio"
+/* Command to compute the median and average photos of a degree, for all sexs in a single pass */
+#define Cfg_COMMAND_DEGREE_PHOTO_MEDIAN_AVERAGE		"./foto_promedio_mediana"
 
 /* Command to send automatic emails, programmed by Antonio F. Daz-Garca and Antonio Caas-Vargas */
 #define Cfg_COMMAND_SEND_AUTOMATIC_EMAIL		"./swad_smtp.py"
@@ -442,13 +480,20 @@
 
 #define Cfg_TIME_TO_REFRESH_TIMELINE			((time_t)(             2UL * 1000UL))	// Initial refresh period of social timeline in miliseconds
 												// This delay is increased 1 second on each refresh
+#define Cfg_MAX_TIME_TO_REFRESH_TIMELINE		((time_t)(            60UL * 1000UL))	// Maximum initial refresh period of social timeline in miliseconds when server is loaded
 
 #define Cfg_SECONDS_TO_REFRESH_MATCH_TCH		1					// Refresh period of match being played in seconds (for teachers)
 #define Cfg_SECONDS_TO_REFRESH_MATCH_STD		3					// Refresh period of match being played in seconds (for students)
 #define Cfg_TIME_TO_REFRESH_MATCH_TCH			((time_t)(Cfg_SECONDS_TO_REFRESH_MATCH_TCH * 1000UL))	// Refresh period of match being played in miliseconds (for teachers)
 #define Cfg_TIME_TO_REFRESH_MATCH_STD			((time_t)(Cfg_SECONDS_TO_REFRESH_MATCH_STD * 1000UL))	// Refresh period of match being played in miliseconds (for students)
+#define Cfg_MAX_TIME_TO_REFRESH_MATCH_TCH		((time_t)(Cfg_TIME_TO_REFRESH_MATCH_TCH * 3UL))	// Maximum refresh period of match being played in miliseconds when server is loaded (for teachers)
+#define Cfg_MAX_TIME_TO_REFRESH_MATCH_STD		((time_t)(Cfg_TIME_TO_REFRESH_MATCH_STD * 3UL))	// Maximum refresh period of match being played in miliseconds when server is loaded (for students)
 
 #define Cfg_TIME_TO_REFRESH_LAST_CLICKS			((time_t)(             1UL * 1000UL))	// Refresh period of last clicks in miliseconds
+#define Cfg_MAX_TIME_TO_REFRESH_LAST_CLICKS		((time_t)(            10UL * 1000UL))	// Maximum refresh period of last clicks in miliseconds when server is loaded
+
+#define Cfg_TIME_TO_GENERATE_PAGE_UNLOADED		(250L * 1000L)		// Average time to generate a page in microseconds when server is not loaded
+#define Cfg_MAX_SLOW_DOWN_REFRESH			8UL			// When server is loaded, automatic refresh periods are multiplied up to this factor
 
 #define Cfg_TIME_TO_CHANGE_BANNER			((time_t)(               2UL * 60UL))	// After these seconds, change banner
 #define Cfg_NUMBER_OF_BANNERS				1					// Number of banners to show simultaneously
@@ -456,22 +501,25 @@
 #define Cfg_TIME_TO_DELETE_API_KEY		((time_t)( 7UL * 24UL * 60UL * 60UL))	// After these seconds, a web service key is removed
 
 #define Cfg_TIME_TO_DELETE_HTML_OUTPUT			((time_t)(              30UL * 60UL))	// Remove the HTML output files older than these seconds
+#define Cfg_TIME_TO_KEEP_CACHED_PAGES			((time_t)(               5UL * 60UL))	// Public pages cached for not logged users are regenerated after these seconds
 
 #define Cfg_TIME_TO_ABORT_FILE_UPLOAD			((time_t)(              55UL * 60UL))	// After these seconds uploading data, abort upload.
 
 #define Cfg_TIME_TO_DELETE_BROWSER_TMP_FILES		((time_t)(        2UL * 60UL * 60UL))  	// Temporary files are deleted after these seconds
 #define Cfg_TIME_TO_DELETE_BROWSER_EXPANDED_FOLDERS	((time_t)( 7UL * 24UL * 60UL * 60UL))	// Past these seconds, remove expired expanded folders
-#define Cfg_TIME_TO_DELETE_BROWSER_ZIP_FILES		((time_t)(        2UL * 60UL * 60UL))  	// Temporary zip files are deleted after these seconds
 #define Cfg_TIME_TO_DELETE_BROWSER_CLIPBOARD		((time_t)(              30UL * 60UL))	// Paths older than these seconds are removed from clipboard
+#define Cfg_TIME_TO_VERIFY_BROWSER_FOLDERS		((time_t)(       24UL * 60UL * 60UL))	// Folder index of a file zone is rebuilt from disk after these seconds
 
 #define Cfg_TIME_TO_DELETE_USER_CLIPBOARD		((time_t)(              30UL * 60UL))	// User clipboards older than these seconds are removed from clipboard
 
 #define Cfg_TIME_TO_DELETE_MARKS_TMP_FILES		((time_t)(        2UL * 60UL * 60UL))  	// Temporary files with students' marks are deleted after these seconds
+#define Cfg_TIME_TO_DELETE_MARKS_INDEXES		((time_t)( 7UL * 24UL * 60UL * 60UL))	// Indexes of files of marks not used during these seconds are deleted
 
 #define Cfg_TIME_TO_DELETE_PARAMS_TO_COMMANDS		((time_t)(              15UL * 60UL))  	// Temporary files with params to commands are deleted after these seconds
 
 #define Cfg_TIME_TO_DELETE_MEDIA_TMP_FILES		((time_t)(        2UL * 60UL * 60UL))  	// Temporary files related to images after these seconds
 #define Cfg_TIME_TO_DELETE_PHOTOS_TMP_FILES		((time_t)(        2UL * 60UL * 60UL))  	// Temporary files related to photos after these seconds
+#define Cfg_TIME_TO_DELETE_PHOTO_SPRITES		((time_t)( 7UL * 24UL * 60UL * 60UL))	// Sprite sheets of class photos not used during these seconds are deleted
 
 #define Cfg_TIME_TO_DELETE_TEST_TMP_FILES		((time_t)(        2UL * 60UL * 60UL))  	// Temporary files related to imported test questions after these seconds
 
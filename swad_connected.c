@@ -36,12 +36,14 @@
 #include "swad_box.h"
 #include "swad_connected.h"
 #include "swad_connected_database.h"
+#include "swad_connected_index.h"
 #include "swad_database.h"
 #include "swad_error.h"
 #include "swad_form.h"
 #include "swad_global.h"
 #include "swad_hierarchy_type.h"
 #include "swad_HTML.h"
+#include "swad_load.h"
 #include "swad_log.h"
 #include "swad_parameter.h"
 #include "swad_photo.h"
@@ -108,7 +110,7 @@ static void Con_ShowConnectedUsrsCurrentLocationOneByOneOnMainZone (Hie_Level_t
 								    Rol_Role_t Role);
 
 /*****************************************************************************/
-/******** Update time to refresh depending on number of open sessions ********/
+/** Update time to refresh depending on number of sessions and server load **/
 /*****************************************************************************/
 
 void Con_SetTimeToRefresh (unsigned NumSessions)
@@ -121,6 +123,11 @@ void Con_SetTimeToRefresh (unsigned NumSessions)
       Con_Connected.TimeToRefresh = Con_MIN_TIME_TO_REFRESH_CONNECTED_IN_MS;
    else if (Con_Connected.TimeToRefresh > Con_MAX_TIME_TO_REFRESH_CONNECTED_IN_MS)
       Con_Connected.TimeToRefresh = Con_MAX_TIME_TO_REFRESH_CONNECTED_IN_MS;
+
+   /***** Refresh less often when server is loaded,
+          but not so slow that sessions are closed *****/
+   Con_Connected.TimeToRefresh = Loa_GetTimeToRefresh (Con_Connected.TimeToRefresh,
+						       Con_MAX_TIME_TO_REFRESH_CONNECTED_IN_MS);
   }
 
 static unsigned long Con_GetTimeToRefresh (void)
@@ -258,14 +265,17 @@ void Con_ShowGlobalConnectedUsrs (void)
    unsigned NumUsrs[Rol_NUM_ROLES];
    unsigned NumUsrsTotal;
 
-   /***** Get number of connected users *****/
+   /***** Get number of connected users
+          from index of connected users or from database *****/
+   if (ConIdx_GetNumUsrsWithRoleInLastCrs (NumUsrs) == Err_ERROR)
+      for (Role  = Rol_GST;
+	   Role <= Rol_SYS_ADM;
+	   Role++)
+	 NumUsrs[Role] = Con_GetConnectedUsrsTotal (Role);
    for (Role  = Rol_GST, NumUsrsTotal = 0;
 	Role <= Rol_SYS_ADM;
 	Role++)
-     {
-      NumUsrs[Role] = Con_GetConnectedUsrsTotal (Role);
       NumUsrsTotal += NumUsrs[Role];
-     }
 
    /***** Number of sessions *****/
    /* Link to view more details about connected users */
@@ -523,11 +533,18 @@ static void Con_GetNumConnectedWithARole (Hie_Level_t HieLvl,Rol_Role_t Role,
    unsigned NumSexs;
    Usr_Sex_t Sex;
 
+   /***** Get number of connected users who belong to current course
+          from index of connected users, without querying database *****/
+   if (HieLvl == Hie_CRS)
+      if (ConIdx_GetNumConnectedInCrs (Gbl.Hierarchy.Node[Hie_CRS].HieCod,
+				       Role,Usrs) == Err_SUCCESS)
+	 return;
+
    /***** Default values *****/
    Usrs->NumUsrs = 0;
    Usrs->Sex = Usr_SEX_UNKNOWN;
 
-   /***** Get number of connected users who belong to current course from database *****/
+   /***** Get number of connected users who belong to current location from database *****/
    if (Con_DB_GetNumConnected (&mysql_res,HieLvl,Role) == Exi_EXISTS)
      {
       row = mysql_fetch_row (mysql_res);
@@ -568,6 +585,35 @@ static void Con_ComputeConnectedUsrsWithARoleCurrentCrsOneByOne (Rol_Role_t Role
    MYSQL_ROW row;
    unsigned NumUsrs;
    unsigned NumUsr = *NumUsrsConnected;	// Save current number of users
+   struct ConIdx_ConnectedUsr Lst[Cfg_MAX_CONNECTED_SHOWN];
+   unsigned NumUsrInLst;
+
+   /***** Get connected users who belong to current course
+          from index of connected users.
+	  Only the users to be listed are got. *****/
+   if (ConIdx_GetConnectedInCrs (Gbl.Hierarchy.Node[Hie_CRS].HieCod,Role,
+				 &NumUsrs,
+				 *NumUsrsToList < Cfg_MAX_CONNECTED_SHOWN ? Cfg_MAX_CONNECTED_SHOWN - *NumUsrsToList :
+									    0,
+				 Lst) == Err_SUCCESS)
+     {
+      *NumUsrsConnected += NumUsrs;
+      *NumUsrsToList    += NumUsrs;
+      if (*NumUsrsToList > Cfg_MAX_CONNECTED_SHOWN)
+	 *NumUsrsToList = Cfg_MAX_CONNECTED_SHOWN;
+
+      for (NumUsrInLst = 0;
+	   NumUsr < *NumUsrsToList;
+	   NumUsr++, NumUsrInLst++)
+	{
+	 Con_Connected.Lst[NumUsr].UsrCod   = Lst[NumUsrInLst].UsrCod;
+	 Con_Connected.Lst[NumUsr].ThisCrs  = (Lst[NumUsrInLst].LastCrsCod ==
+					       Gbl.Hierarchy.Node[Hie_CRS].HieCod);
+	 Con_Connected.Lst[NumUsr].TimeDiff = Dat_GetStartExecutionTimeUTC () -
+					      Lst[NumUsrInLst].LastTime;
+	}
+      return;
+     }
 
    /***** Get connected users who belong to current course from database *****/
    NumUsrs = Con_DB_GetConnectedFromScope (&mysql_res,Hie_CRS,Role);
@@ -848,3 +894,67 @@ void Con_WriteScriptClockConnected (void)
    HTM_TxtF ("\tsetTimeout('refreshConnected()',%lu);\n",
 	     Con_GetTimeToRefresh ());
   }
+
+/*****************************************************************************/
+/**************** Update my entry in list of connected users *****************/
+/*****************************************************************************/
+void Con_UpdateMeInConnectedList (void)
+  {
+   Con_DB_UpdateMeInConnectedList ();
+   ConIdx_UpdateMe ();
+  }
+
+/*****************************************************************************/
+/************ Keep me in list of connected users when refreshing *************/
+/*****************************************************************************/
+void Con_RefreshMeInConnectedList (void)
+  {
+   // Table of connected users is not updated,
+   // as only the index stores when users have refreshed
+   ConIdx_RefreshMe ();
+  }
+
+/*****************************************************************************/
+/******** Remove users without sessions from list of connected users *********/
+/*****************************************************************************/
+// Users without sessions are expired from index of connected users
+// after some time, but if I have closed my last session
+// I should disappear at once
+
+void Con_RemoveOldConnected (void)
+  {
+   Con_DB_RemoveOldConnected ();
+
+   if (Gbl.Usrs.Me.UsrDat.UsrCod > 0)
+      if (Con_DB_CheckIfUsrIsConnected (Gbl.Usrs.Me.UsrDat.UsrCod) == Exi_DOES_NOT_EXIST)
+	 ConIdx_RemoveUsr (Gbl.Usrs.Me.UsrDat.UsrCod);
+  }
+
+/*****************************************************************************/
+/************* Remove a given user from list of connected users **************/
+/*****************************************************************************/
+void Con_RemoveUsrFromConnected (long UsrCod)
+  {
+   Con_DB_RemoveUsrFromConnected (UsrCod);
+   ConIdx_RemoveUsr (UsrCod);
+  }
+
+/*****************************************************************************/
+/****** Courses of a user have changed, update them in connected users *******/
+/*****************************************************************************/
+// Courses are stored in index of connected users and read again
+// in the next click of the user after calling this function
+
+void Con_FlushCrssOfUsr (long UsrCod)
+  {
+   ConIdx_FlushCrssOfUsr (UsrCod);
+  }
+
+/*****************************************************************************/
+/*** Courses of several users have changed, update them in connected users ***/
+/*****************************************************************************/
+
+void Con_FlushCrssOfAllUsrs (void)
+  {
+   ConIdx_FlushCrssOfAllUsrs ();
+  }
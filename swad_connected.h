@@ -60,4 +60,11 @@ void Con_ShowConnectedUsrsBelongingToCurrentCrs (void);
 
 void Con_WriteScriptClockConnected (void);
 
+void Con_UpdateMeInConnectedList (void);
+void Con_RefreshMeInConnectedList (void);
+void Con_RemoveOldConnected (void);
+void Con_RemoveUsrFromConnected (long UsrCod);
+void Con_FlushCrssOfUsr (long UsrCod);
+void Con_FlushCrssOfAllUsrs (void);
+
 #endif
@@ -480,6 +480,71 @@ unsigned Con_DB_GetConnectedFromScope (MYSQL_RES **mysql_res,
      }
   }
 
+/*****************************************************************************/
+/********* Get all connected users to build index of connected users *********/
+/*****************************************************************************/
+
+unsigned Con_DB_GetAllConnected (MYSQL_RES **mysql_res)
+  {
+   return (unsigned)
+   DB_QuerySELECT (mysql_res,"can not get connected users",
+		   "SELECT usr_connected.UsrCod,"			// row[0]
+			  "usr_connected.RoleInLastCrs,"		// row[1]
+			  "usr_connected.LastCrsCod,"			// row[2]
+			  "UNIX_TIMESTAMP(usr_connected.LastTime),"	// row[3]
+			  "usr_data.Sex"				// row[4]
+		    " FROM usr_connected,"
+			  "usr_data"
+		   " WHERE usr_connected.UsrCod=usr_data.UsrCod");
+  }
+
+/*****************************************************************************/
+/************ Get courses of all connected users, sorted by user *************/
+/*****************************************************************************/
+
+unsigned Con_DB_GetCrssOfAllConnected (MYSQL_RES **mysql_res)
+  {
+   return (unsigned)
+   DB_QuerySELECT (mysql_res,"can not get courses of connected users",
+		   "SELECT crs_users.UsrCod,"	// row[0]
+			  "crs_users.CrsCod,"	// row[1]
+			  "crs_users.Role"	// row[2]
+		    " FROM usr_connected,"
+			  "crs_users"
+		   " WHERE usr_connected.UsrCod=crs_users.UsrCod"
+		" ORDER BY crs_users.UsrCod");
+  }
+
+/*****************************************************************************/
+/**************** Get courses of a user and role in each one *****************/
+/*****************************************************************************/
+
+unsigned Con_DB_GetCrssOfUsr (MYSQL_RES **mysql_res,long UsrCod)
+  {
+   return (unsigned)
+   DB_QuerySELECT (mysql_res,"can not get courses of a user",
+		   "SELECT CrsCod,"	// row[0]
+			  "Role"	// row[1]
+		    " FROM crs_users"
+		   " WHERE UsrCod=%ld",
+		   UsrCod);
+  }
+
+/*****************************************************************************/
+/*************** Check if a user is in list of connected users ***************/
+/*****************************************************************************/
+
+Exi_Exist_t Con_DB_CheckIfUsrIsConnected (long UsrCod)
+  {
+   return
+   DB_QueryEXISTS ("can not check if a user is connected",
+		   "SELECT EXISTS"
+		   "(SELECT *"
+		     " FROM usr_connected"
+		    " WHERE UsrCod=%ld)",
+		   UsrCod);
+  }
+
 /*****************************************************************************/
 /********************* Modify my entry in connected list *********************/
 /*****************************************************************************/
@@ -40,6 +40,10 @@ Exi_Exist_t Con_DB_GetNumConnected (MYSQL_RES **mysql_res,
 				    Hie_Level_t HieLvl,Rol_Role_t Role);
 unsigned Con_DB_GetConnectedFromScope (MYSQL_RES **mysql_res,
 				       Hie_Level_t HieLvl,Rol_Role_t Role);
+unsigned Con_DB_GetAllConnected (MYSQL_RES **mysql_res);
+unsigned Con_DB_GetCrssOfAllConnected (MYSQL_RES **mysql_res);
+unsigned Con_DB_GetCrssOfUsr (MYSQL_RES **mysql_res,long UsrCod);
+Exi_Exist_t Con_DB_CheckIfUsrIsConnected (long UsrCod);
 
 void Con_DB_UpdateMeInConnectedList (void);
 
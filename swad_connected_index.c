@@ -0,0 +1,1063 @@
+// swad_connected_index.c: index of connected users shared by all processes
+/*
+    SWAD (Shared Workspace At a Distance),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2026 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/********************************* Headers ***********************************/
+/*****************************************************************************/
+
+#include <fcntl.h>		// For open
+#include <mysql/mysql.h>	// To access MySQL databases
+#include <stdbool.h>		// For boolean type
+#include <stdio.h>		// For sscanf
+#include <string.h>		// For memset
+#include <sys/file.h>		// For flock
+#include <sys/mman.h>		// For mmap, munmap
+#include <sys/stat.h>		// For fstat
+#include <unistd.h>		// For close, ftruncate
+
+#include "swad_config.h"
+#include "swad_connected_database.h"
+#include "swad_connected_index.h"
+#include "swad_database.h"
+#include "swad_file.h"
+#include "swad_global.h"
+#include "swad_string.h"
+
+/*****************************************************************************/
+/************** External global variables from others modules ****************/
+/*****************************************************************************/
+
+extern struct Globals Gbl;
+
+/*****************************************************************************/
+/***************************** Private constants *****************************/
+/*****************************************************************************/
+
+#define ConIdx_FILE_INDEX	"index"
+
+#define ConIdx_MAGIC	0x58444943U	// "CIDX"
+#define ConIdx_FORMAT	2		// Increment when file layout changes
+
+#define ConIdx_MAX_USRS		16384	// Maximum number of connected users in index
+#define ConIdx_NUM_HASH		16384	// Number of chains in hash table of users
+#define ConIdx_MAX_CRSS_PER_USR	   64	// Maximum number of courses stored for each user
+#define ConIdx_MAX_CRSS		65536	// Size of table of counters by course (power of 2)
+
+// A connected user is placed in the bucket of the minute of his/her last
+// click or refresh. The user is expired when that bucket is rotated out,
+// as a session is closed after this time without refreshing.
+#define ConIdx_NUM_BUCKETS	64	// Must be greater than ConIdx_MINUTES_ALIVE
+#define ConIdx_MINUTES_ALIVE	((long) (Cfg_TIME_TO_CLOSE_SESSION_FROM_LAST_REFRESH / 60))
+
+#define ConIdx_NUM_CRS_ROLES	3	// Students, non-editing teachers and teachers
+
+/*****************************************************************************/
+/******************************* Private types *******************************/
+/*****************************************************************************/
+
+/*
+   Layout of index file (native byte order, only used by this program).
+   All links are 1 + index of a user, so 0 is the end of a list
+   and a new file filled with zeros is an empty index.
+*/
+struct ConIdx_Header
+  {
+   unsigned Magic;
+   unsigned Format;
+   unsigned Dirty;				// Set while a process is modifying the index
+   long Minute;					// Last minute rotated
+   unsigned NumUsrsUsed;			// Users entries used at least once
+   unsigned FreeUsrs;				// List of free users entries
+   long UsrsOverflowMinute;			// Last minute when a user did not fit
+   unsigned NumUsrsWithTooManyCrss;		// Users with some courses not counted
+   unsigned CrssOverflow;			// Some course did not fit
+   unsigned CrssStamp;				// Incremented when courses of users change
+   unsigned MinCrssStamp;			// Courses read with an older stamp are not valid
+   unsigned NumUsrs[Rol_NUM_ROLES];		// Connected users by role in last course
+   unsigned HashHeads[ConIdx_NUM_HASH];		// Chains of users with the same hash
+   unsigned BucketHeads[ConIdx_NUM_BUCKETS];	// Lists of users in each minute
+  };
+
+struct ConIdx_Usr
+  {
+   long UsrCod;
+   long LastCrsCod;				// Course of last click
+   time_t LastTime;				// Time of last click
+   long Minute;					// Minute of last click or refresh
+   unsigned HashNext;
+   unsigned BucketPrev;
+   unsigned BucketNext;				// Also next in list of free entries
+   unsigned char RoleInLastCrs;
+   unsigned char Sex;
+   unsigned char NumCrss;
+   unsigned char TooManyCrss;
+   unsigned CrssStamp;				// 1 + CrssStamp when courses were read, 0 if not valid
+   long CrsCods[ConIdx_MAX_CRSS_PER_USR];	// Courses of the user...
+   unsigned char Roles[ConIdx_MAX_CRSS_PER_USR];	// ...and role in each one
+  };
+
+struct ConIdx_Crs	// Open addressing, entries are never removed
+  {
+   long CrsCod;
+   unsigned NumUsrs[ConIdx_NUM_CRS_ROLES][Usr_NUM_SEXS];
+  };
+
+struct ConIdx_Index
+  {
+   struct ConIdx_Header Header;
+   struct ConIdx_Usr Usrs[ConIdx_MAX_USRS];
+   struct ConIdx_Crs Crss[ConIdx_MAX_CRSS];
+  };
+
+struct ConIdx_MyCrss
+  {
+   unsigned NumCrss;
+   long CrsCods[ConIdx_MAX_CRSS_PER_USR];
+   unsigned char Roles[ConIdx_MAX_CRSS_PER_USR];
+   bool TooManyCrss;
+  };
+
+/*****************************************************************************/
+/************************* Private global variables **************************/
+/*****************************************************************************/
+
+static struct
+  {
+   int FileDescriptor;
+   struct ConIdx_Index *Idx;	// NULL if not mapped
+   bool Failed;			// Don't retry mapping in this process
+  } ConIdx_Index =
+  {
+   .FileDescriptor = -1,
+   .Idx            = NULL,
+   .Failed         = false,
+  };
+
+/*****************************************************************************/
+/***************************** Private prototypes ****************************/
+/*****************************************************************************/
+
+static Err_SuccessOrError_t ConIdx_Map (void);
+static struct ConIdx_Index *ConIdx_Lock (void);
+static void ConIdx_Unlock (void);
+static Err_SuccessOrError_t ConIdx_Build (struct ConIdx_Index *Idx);
+static void ConIdx_RotateBuckets (struct ConIdx_Index *Idx,long Minute);
+static void ConIdx_ExpireBucket (struct ConIdx_Index *Idx,unsigned Bucket);
+static void ConIdx_RebuildCrss (struct ConIdx_Index *Idx);
+
+static void ConIdx_GetCrssOfUsr (long UsrCod,struct ConIdx_MyCrss *MyCrss);
+static bool ConIdx_CheckIfUsrCrssAreValid (const struct ConIdx_Index *Idx,
+					   const struct ConIdx_Usr *Usr);
+static struct ConIdx_Usr *ConIdx_FindUsr (struct ConIdx_Index *Idx,long UsrCod);
+static struct ConIdx_Usr *ConIdx_AddUsr (struct ConIdx_Index *Idx,long UsrCod);
+static void ConIdx_RemUsr (struct ConIdx_Index *Idx,struct ConIdx_Usr *Usr);
+static void ConIdx_SetUsrCrss (struct ConIdx_Index *Idx,struct ConIdx_Usr *Usr,
+			       const struct ConIdx_MyCrss *MyCrss);
+static void ConIdx_CountUsr (struct ConIdx_Index *Idx,struct ConIdx_Usr *Usr,int Inc);
+static void ConIdx_CountUsrInCrss (struct ConIdx_Index *Idx,struct ConIdx_Usr *Usr,int Inc);
+static void ConIdx_LinkToBucket (struct ConIdx_Index *Idx,struct ConIdx_Usr *Usr,
+				 long Minute);
+static void ConIdx_UnlinkFromBucket (struct ConIdx_Index *Idx,struct ConIdx_Usr *Usr);
+static struct ConIdx_Crs *ConIdx_FindCrs (struct ConIdx_Index *Idx,long CrsCod,
+					  bool Create);
+static bool ConIdx_CheckIfCrssAreReliable (const struct ConIdx_Index *Idx);
+static long ConIdx_GetCurrentMinute (void);
+
+/*****************************************************************************/
+/********** Insert or update me in index after a click of mine ***************/
+/*****************************************************************************/
+
+void ConIdx_UpdateMe (void)
+  {
+   struct ConIdx_MyCrss MyCrss;
+   struct ConIdx_Index *Idx;
+   struct ConIdx_Usr *Usr;
+   bool MyCrssAreRead = false;
+   unsigned CrssStamp = 0;
+
+   /***** Trivial check *****/
+   if (Gbl.Usrs.Me.UsrDat.UsrCod <= 0)
+      return;
+
+   /***** Lock index *****/
+   if ((Idx = ConIdx_Lock ()) == NULL)
+      return;
+
+   /***** My courses are stored in index until they change.
+	  If they must be read, get them from database
+	  with the index unlocked, so other processes don't wait. *****/
+   if (!ConIdx_CheckIfUsrCrssAreValid (Idx,ConIdx_FindUsr (Idx,Gbl.Usrs.Me.UsrDat.UsrCod)))
+     {
+      CrssStamp = Idx->Header.CrssStamp;
+      ConIdx_Unlock ();
+
+      ConIdx_GetCrssOfUsr (Gbl.Usrs.Me.UsrDat.UsrCod,&MyCrss);
+      MyCrssAreRead = true;
+
+      if ((Idx = ConIdx_Lock ()) == NULL)
+	 return;
+     }
+
+   /***** Update index *****/
+   if ((Usr = ConIdx_FindUsr (Idx,Gbl.Usrs.Me.UsrDat.UsrCod)))
+     {
+      /* Discount old data before updating them */
+      ConIdx_CountUsr (Idx,Usr,-1);
+      ConIdx_UnlinkFromBucket (Idx,Usr);
+     }
+   else if ((Usr = ConIdx_AddUsr (Idx,Gbl.Usrs.Me.UsrDat.UsrCod)) == NULL)
+      Idx->Header.UsrsOverflowMinute = Idx->Header.Minute;	// Index is full
+
+   if (Usr)
+     {
+      Usr->LastCrsCod    = Gbl.Hierarchy.Node[Hie_CRS].HieCod;
+      Usr->LastTime      = Dat_GetStartExecutionTimeUTC ();
+      Usr->RoleInLastCrs = (unsigned char) Gbl.Usrs.Me.Role.Logged;
+      Usr->Sex           = (unsigned char) Gbl.Usrs.Me.UsrDat.Sex;
+      if (MyCrssAreRead)
+	{
+	 ConIdx_SetUsrCrss (Idx,Usr,&MyCrss);
+
+	 /* If courses of some user changed while mine were being read,
+	    mine will be read again in my next click */
+	 Usr->CrssStamp = Idx->Header.CrssStamp == CrssStamp ? CrssStamp + 1 :
+							       0;
+	}
+      ConIdx_CountUsr (Idx,Usr,1);
+      ConIdx_LinkToBucket (Idx,Usr,Idx->Header.Minute);
+     }
+
+   ConIdx_Unlock ();
+  }
+
+/*****************************************************************************/
+/********* Keep me alive in index when refreshing connected users ************/
+/*****************************************************************************/
+
+void ConIdx_RefreshMe (void)
+  {
+   struct ConIdx_Index *Idx;
+   struct ConIdx_Usr *Usr;
+
+   /***** Trivial check *****/
+   if (Gbl.Usrs.Me.UsrDat.UsrCod <= 0)
+      return;
+
+   /***** Move me to the bucket of current minute *****/
+   if ((Idx = ConIdx_Lock ()))
+     {
+      if ((Usr = ConIdx_FindUsr (Idx,Gbl.Usrs.Me.UsrDat.UsrCod)))
+	 // Refreshing does not keep a session open after this time without clicks
+	 if (Dat_GetStartExecutionTimeUTC () - Usr->LastTime < Cfg_TIME_TO_CLOSE_SESSION_FROM_LAST_CLICK)
+	   {
+	    ConIdx_UnlinkFromBucket (Idx,Usr);
+	    ConIdx_LinkToBucket (Idx,Usr,Idx->Header.Minute);
+	   }
+
+      ConIdx_Unlock ();
+     }
+  }
+
+/*****************************************************************************/
+/************************* Remove a user from index **************************/
+/*****************************************************************************/
+
+void ConIdx_RemoveUsr (long UsrCod)
+  {
+   struct ConIdx_Index *Idx;
+   struct ConIdx_Usr *Usr;
+
+   if ((Idx = ConIdx_Lock ()))
+     {
+      if ((Usr = ConIdx_FindUsr (Idx,UsrCod)))
+	 ConIdx_RemUsr (Idx,Usr);
+
+      ConIdx_Unlock ();
+     }
+  }
+
+/*****************************************************************************/
+/************* Courses of a user have changed, read them again ***************/
+/*****************************************************************************/
+
+void ConIdx_FlushCrssOfUsr (long UsrCod)
+  {
+   struct ConIdx_Index *Idx;
+   struct ConIdx_Usr *Usr;
+
+   if ((Idx = ConIdx_Lock ()))
+     {
+      Idx->Header.CrssStamp++;	// For processes reading courses now
+      if ((Usr = ConIdx_FindUsr (Idx,UsrCod)))
+	 Usr->CrssStamp = 0;
+
+      ConIdx_Unlock ();
+     }
+  }
+
+/*****************************************************************************/
+/*********** Courses of several users have changed, read them again **********/
+/*****************************************************************************/
+
+void ConIdx_FlushCrssOfAllUsrs (void)
+  {
+   struct ConIdx_Index *Idx;
+
+   if ((Idx = ConIdx_Lock ()))
+     {
+      Idx->Header.MinCrssStamp = ++Idx->Header.CrssStamp;
+
+      ConIdx_Unlock ();
+     }
+  }
+
+/*****************************************************************************/
+/******************************* Unmap index *********************************/
+/*****************************************************************************/
+
+void ConIdx_Unmap (void)
+  {
+   if (ConIdx_Index.Idx)
+     {
+      munmap (ConIdx_Index.Idx,sizeof (struct ConIdx_Index));
+      ConIdx_Index.Idx = NULL;
+     }
+   if (ConIdx_Index.FileDescriptor >= 0)
+     {
+      close (ConIdx_Index.FileDescriptor);
+      ConIdx_Index.FileDescriptor = -1;
+     }
+  }
+
+/*****************************************************************************/
+/************** Get number of connected users by role in last course *********/
+/*****************************************************************************/
+// Return Err_ERROR if the index can not be used. Then query the database.
+
+Err_SuccessOrError_t ConIdx_GetNumUsrsWithRoleInLastCrs (unsigned NumUsrs[Rol_NUM_ROLES])
+  {
+   struct ConIdx_Index *Idx;
+   Rol_Role_t Role;
+   Err_SuccessOrError_t SuccessOrError = Err_ERROR;
+
+   if ((Idx = ConIdx_Lock ()))
+     {
+      if (Idx->Header.Minute - Idx->Header.UsrsOverflowMinute >= ConIdx_MINUTES_ALIVE)
+	{
+	 for (Role  = (Rol_Role_t) 0;
+	      Role <= (Rol_Role_t) (Rol_NUM_ROLES - 1);
+	      Role++)
+	    NumUsrs[Role] = Idx->Header.NumUsrs[Role];
+	 SuccessOrError = Err_SUCCESS;
+	}
+
+      ConIdx_Unlock ();
+     }
+
+   return SuccessOrError;
+  }
+
+/*****************************************************************************/
+/********* Get number of connected users with a role in a course *************/
+/*****************************************************************************/
+// Role == Rol_UNK means any role
+// Return Err_ERROR if the index can not be used. Then query the database.
+
+Err_SuccessOrError_t ConIdx_GetNumConnectedInCrs (long CrsCod,Rol_Role_t Role,
+						  struct Con_ConnectedUsrs *Usrs)
+  {
+   struct ConIdx_Index *Idx;
+   const struct ConIdx_Crs *Crs;
+   unsigned NumUsrsSex[Usr_NUM_SEXS] = {0};
+   unsigned NumSexs = 0;
+   unsigned RoleIdx;
+   Usr_Sex_t Sex;
+   Err_SuccessOrError_t SuccessOrError = Err_ERROR;
+
+   /***** Default values *****/
+   Usrs->NumUsrs = 0;
+   Usrs->Sex = Usr_SEX_UNKNOWN;
+
+   /***** Check role *****/
+   switch (Role)
+     {
+      case Rol_UNK:	// Here Rol_UNK means "any role"
+      case Rol_STD:
+      case Rol_NET:
+      case Rol_TCH:
+	 break;
+      default:
+	 return Err_ERROR;
+     }
+
+   /***** Get counters of the course *****/
+   if ((Idx = ConIdx_Lock ()))
+     {
+      if (ConIdx_CheckIfCrssAreReliable (Idx))
+	{
+	 if ((Crs = ConIdx_FindCrs (Idx,CrsCod,false)))
+	    for (RoleIdx = 0;
+		 RoleIdx < ConIdx_NUM_CRS_ROLES;
+		 RoleIdx++)
+	       if (Role == Rol_UNK ||
+		   RoleIdx == (unsigned) (Role - Rol_STD))
+		  for (Sex  = (Usr_Sex_t) 0;
+		       Sex <= (Usr_Sex_t) (Usr_NUM_SEXS - 1);
+		       Sex++)
+		     NumUsrsSex[Sex] += Crs->NumUsrs[RoleIdx][Sex];
+	 SuccessOrError = Err_SUCCESS;
+	}
+
+      ConIdx_Unlock ();
+     }
+
+   /***** Number of users and their sex if all have the same *****/
+   for (Sex  = (Usr_Sex_t) 0;
+	Sex <= (Usr_Sex_t) (Usr_NUM_SEXS - 1);
+	Sex++)
+      if (NumUsrsSex[Sex])
+	{
+	 Usrs->NumUsrs += NumUsrsSex[Sex];
+	 Usrs->Sex = Sex;
+	 NumSexs++;
+	}
+   if (NumSexs != 1)
+      Usrs->Sex = Usr_SEX_UNKNOWN;
+
+   return SuccessOrError;
+  }
+
+/*****************************************************************************/
+/************** Get connected users with a role in a course ******************/
+/*****************************************************************************/
+// Get the total number of users in NumUsrs
+// and the MaxUsrs users with more recent clicks in Lst, most recent first.
+// Return Err_ERROR if the index can not be used. Then query the database.
+
+Err_SuccessOrError_t ConIdx_GetConnectedInCrs (long CrsCod,Rol_Role_t Role,
+					       unsigned *NumUsrs,
+					       unsigned MaxUsrs,
+					       struct ConIdx_ConnectedUsr *Lst)
+  {
+   struct ConIdx_Index *Idx;
+   const struct ConIdx_Usr *Usr;
+   unsigned NumUsr;
+   unsigned NumCrs;
+   unsigned NumUsrsInLst = 0;
+   unsigned i;
+   Err_SuccessOrError_t SuccessOrError = Err_ERROR;
+
+   *NumUsrs = 0;
+
+   if ((Idx = ConIdx_Lock ()))
+     {
+      if (ConIdx_CheckIfCrssAreReliable (Idx))
+	{
+	 for (NumUsr = 0;
+	      NumUsr < Idx->Header.NumUsrsUsed;
+	      NumUsr++)
+	   {
+	    Usr = &Idx->Usrs[NumUsr];
+	    if (Usr->UsrCod <= 0)	// Free entry
+	       continue;
+
+	    for (NumCrs = 0;
+		 NumCrs < Usr->NumCrss;
+		 NumCrs++)
+	       if (Usr->CrsCods[NumCrs] == CrsCod)
+		 {
+		  if (Usr->Roles[NumCrs] == (unsigned char) Role)
+		    {
+		     (*NumUsrs)++;
+
+		     /* Insert in list sorted by time of last click */
+		     for (i = NumUsrsInLst;
+			  i > 0 && Lst[i - 1].LastTime < Usr->LastTime;
+			  i--)
+			if (i < MaxUsrs)
+			   Lst[i] = Lst[i - 1];
+		     if (i < MaxUsrs)
+		       {
+			Lst[i].UsrCod     = Usr->UsrCod;
+			Lst[i].LastCrsCod = Usr->LastCrsCod;
+			Lst[i].LastTime   = Usr->LastTime;
+			if (NumUsrsInLst < MaxUsrs)
+			   NumUsrsInLst++;
+		       }
+		    }
+		  break;
+		 }
+	   }
+	 SuccessOrError = Err_SUCCESS;
+	}
+
+      ConIdx_Unlock ();
+     }
+
+   return SuccessOrError;
+  }
+
+/*****************************************************************************/
+/************** Map index file, creating it if it does not exist *************/
+/*****************************************************************************/
+
+static Err_SuccessOrError_t ConIdx_Map (void)
+  {
+   struct stat FileStatus;
+   void *Addr;
+
+   /***** Trivial checks *****/
+   if (ConIdx_Index.Idx)
+      return Err_SUCCESS;
+   if (ConIdx_Index.Failed)
+      return Err_ERROR;
+   ConIdx_Index.Failed = true;	// Until the end of this function
+
+   /***** Open index file, creating it if it does not exist *****/
+   Fil_CreateDirIfNotExists (Cfg_PATH_CONNECTED_PRIVATE);
+   if ((ConIdx_Index.FileDescriptor = open (Cfg_PATH_CONNECTED_PRIVATE "/" ConIdx_FILE_INDEX,
+					    O_RDWR | O_CREAT,0600)) < 0)
+      return Err_ERROR;
+
+   /***** Set size of file. The new file is filled with zeros,
+          so it will be built on first use. *****/
+   if (flock (ConIdx_Index.FileDescriptor,LOCK_EX) != 0)
+     {
+      ConIdx_Unmap ();
+      return Err_ERROR;
+     }
+   if (fstat (ConIdx_Index.FileDescriptor,&FileStatus) == 0)
+      if ((size_t) FileStatus.st_size != sizeof (struct ConIdx_Index))
+	 if (ftruncate (ConIdx_Index.FileDescriptor,0) != 0 ||
+	     ftruncate (ConIdx_Index.FileDescriptor,
+			(off_t) sizeof (struct ConIdx_Index)) != 0)
+	    FileStatus.st_size = 0;
+   flock (ConIdx_Index.FileDescriptor,LOCK_UN);
+   if (fstat (ConIdx_Index.FileDescriptor,&FileStatus) != 0 ||
+       (size_t) FileStatus.st_size != sizeof (struct ConIdx_Index))
+     {
+      ConIdx_Unmap ();
+      return Err_ERROR;
+     }
+
+   /***** Map the whole file.
+          Only pages used are really allocated in memory. *****/
+   if ((Addr = mmap (NULL,sizeof (struct ConIdx_Index),PROT_READ | PROT_WRITE,MAP_SHARED,
+		     ConIdx_Index.FileDescriptor,0)) == MAP_FAILED)
+     {
+      ConIdx_Unmap ();
+      return Err_ERROR;
+     }
+
+   ConIdx_Index.Idx = (struct ConIdx_Index *) Addr;
+   ConIdx_Index.Failed = false;
+   return Err_SUCCESS;
+  }
+
+/*****************************************************************************/
+/**************** Lock index, building and rotating it if needed *************/
+/*****************************************************************************/
+// Return NULL if index can not be used
+
+static struct ConIdx_Index *ConIdx_Lock (void)
+  {
+   struct ConIdx_Index *Idx;
+
+   /***** Map index *****/
+   if (ConIdx_Map () == Err_ERROR)
+      return NULL;
+   Idx = ConIdx_Index.Idx;
+
+   /***** Lock. Critical sections are very short. *****/
+   if (flock (ConIdx_Index.FileDescriptor,LOCK_EX) != 0)
+      return NULL;
+
+   /***** Build index if it is new, has changed its format
+          or other process died while modifying it *****/
+   if (Idx->Header.Magic  != ConIdx_MAGIC  ||
+       Idx->Header.Format != ConIdx_FORMAT ||
+       Idx->Header.Dirty)
+      if (ConIdx_Build (Idx) == Err_ERROR)
+	{
+	 flock (ConIdx_Index.FileDescriptor,LOCK_UN);
+	 return NULL;
+	}
+
+   /***** Expire users in old buckets *****/
+   Idx->Header.Dirty = 1;
+   ConIdx_RotateBuckets (Idx,ConIdx_GetCurrentMinute ());
+
+   return Idx;
+  }
+
+/*****************************************************************************/
+/******************************* Unlock index ********************************/
+/*****************************************************************************/
+
+static void ConIdx_Unlock (void)
+  {
+   ConIdx_Index.Idx->Header.Dirty = 0;
+   flock (ConIdx_Index.FileDescriptor,LOCK_UN);
+  }
+
+/*****************************************************************************/
+/*************** Build index from table of connected users *******************/
+/*****************************************************************************/
+// Index must be locked
+
+static Err_SuccessOrError_t ConIdx_Build (struct ConIdx_Index *Idx)
+  {
+   extern const char *Usr_StringsSexDB[Usr_NUM_SEXS];
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   unsigned NumRow;
+   unsigned NumRows;
+   unsigned NumUsr;
+   long UsrCod;
+   long CurrentMinute = ConIdx_GetCurrentMinute ();
+   struct ConIdx_Usr *Usr;
+   struct ConIdx_MyCrss Crss;
+   Rol_Role_t Role;
+   Usr_Sex_t Sex;
+
+   if (DB_CheckIfDatabaseIsOpen () == CloOpe_CLOSED)
+      return Err_ERROR;
+
+   /***** Reset index.
+          Entries of users are reset when used. *****/
+   memset (&Idx->Header,0,sizeof (Idx->Header));
+   memset (Idx->Crss,0,sizeof (Idx->Crss));
+   Idx->Header.Dirty              = 1;
+   Idx->Header.Minute             = CurrentMinute;
+   Idx->Header.UsrsOverflowMinute = CurrentMinute - ConIdx_MINUTES_ALIVE;
+
+   /***** Remove users without session from table of connected users *****/
+   Con_DB_RemoveOldConnected ();
+
+   /***** Get all connected users.
+          All of them are considered alive in current minute. *****/
+   NumRows = Con_DB_GetAllConnected (&mysql_res);
+   for (NumRow = 0;
+	NumRow < NumRows;
+	NumRow++)
+     {
+      row = mysql_fetch_row (mysql_res);
+
+      /* Get user's code (row[0]) */
+      if ((UsrCod = Str_ConvertStrCodToLongCod (row[0])) <= 0)
+	 continue;
+      if ((Usr = ConIdx_AddUsr (Idx,UsrCod)) == NULL)
+	{
+	 Idx->Header.UsrsOverflowMinute = CurrentMinute;
+	 break;
+	}
+
+      /* Get role in last course (row[1]), last course (row[2]),
+	 time of last click (row[3]) and sex (row[4]) */
+      Role = Rol_ConvertUnsignedStrToRole (row[1]);
+      Usr->RoleInLastCrs = (unsigned char) Role;
+      Usr->LastCrsCod = Str_ConvertStrCodToLongCod (row[2]);
+      if (sscanf (row[3],"%ld",&Usr->LastTime) != 1)
+	 Usr->LastTime = (time_t) 0;
+      Usr->Sex = (unsigned char) Usr_SEX_UNKNOWN;
+      for (Sex  = (Usr_Sex_t) 0;
+	   Sex <= (Usr_Sex_t) (Usr_NUM_SEXS - 1);
+	   Sex++)
+	 if (!strcasecmp (row[4],Usr_StringsSexDB[Sex]))
+	   {
+	    Usr->Sex = (unsigned char) Sex;
+	    break;
+	   }
+
+      Idx->Header.NumUsrs[Role]++;
+      ConIdx_LinkToBucket (Idx,Usr,CurrentMinute);
+     }
+   DB_FreeMySQLResult (&mysql_res);
+
+   /***** Get courses of all connected users, sorted by user *****/
+   NumRows = Con_DB_GetCrssOfAllConnected (&mysql_res);
+   Crss.NumCrss = 0;
+   Crss.TooManyCrss = false;
+   for (NumRow = 0, Usr = NULL;
+	NumRow < NumRows;
+	NumRow++)
+     {
+      row = mysql_fetch_row (mysql_res);
+
+      /* Get user's code (row[0]) */
+      UsrCod = Str_ConvertStrCodToLongCod (row[0]);
+      if (!Usr || Usr->UsrCod != UsrCod)
+	{
+	 if (Usr)
+	    ConIdx_SetUsrCrss (Idx,Usr,&Crss);
+	 Crss.NumCrss = 0;
+	 Crss.TooManyCrss = false;
+	 Usr = ConIdx_FindUsr (Idx,UsrCod);
+	}
+      if (!Usr)
+	 continue;
+
+      /* Get course (row[1]) and role (row[2]) */
+      if (Crss.NumCrss < ConIdx_MAX_CRSS_PER_USR)
+	{
+	 Crss.CrsCods[Crss.NumCrss] = Str_ConvertStrCodToLongCod (row[1]);
+	 Crss.Roles[Crss.NumCrss++] = (unsigned char) Rol_ConvertUnsignedStrToRole (row[2]);
+	}
+      else
+	 Crss.TooManyCrss = true;
+     }
+   if (Usr)
+      ConIdx_SetUsrCrss (Idx,Usr,&Crss);
+   DB_FreeMySQLResult (&mysql_res);
+
+   /***** Courses of all users have just been read *****/
+   for (NumUsr = 0;
+	NumUsr < Idx->Header.NumUsrsUsed;
+	NumUsr++)
+      Idx->Usrs[NumUsr].CrssStamp = Idx->Header.CrssStamp + 1;
+
+   /***** Count users in courses *****/
+   ConIdx_RebuildCrss (Idx);
+
+   /***** Index is valid *****/
+   Idx->Header.Magic  = ConIdx_MAGIC;
+   Idx->Header.Format = ConIdx_FORMAT;
+   return Err_SUCCESS;
+  }
+
+/*****************************************************************************/
+/*********** Rotate buckets until current minute expiring users **************/
+/*****************************************************************************/
+
+static void ConIdx_RotateBuckets (struct ConIdx_Index *Idx,long Minute)
+  {
+   long M;
+   unsigned Bucket;
+
+   if (Minute <= Idx->Header.Minute)	// Nothing to rotate
+      return;
+
+   if (Minute - Idx->Header.Minute >= ConIdx_NUM_BUCKETS)	// All buckets are old
+      for (Bucket = 0;
+	   Bucket < ConIdx_NUM_BUCKETS;
+	   Bucket++)
+	 ConIdx_ExpireBucket (Idx,Bucket);
+   else
+      for (M = Idx->Header.Minute + 1;
+	   M <= Minute;
+	   M++)
+	 ConIdx_ExpireBucket (Idx,(unsigned) ((M - ConIdx_MINUTES_ALIVE) % ConIdx_NUM_BUCKETS));
+
+   Idx->Header.Minute = Minute;
+
+   /***** If some course did not fit, try again after expiring users *****/
+   if (Idx->Header.CrssOverflow)
+      ConIdx_RebuildCrss (Idx);
+  }
+
+/*****************************************************************************/
+/********************** Expire all users in a bucket *************************/
+/*****************************************************************************/
+
+static void ConIdx_ExpireBucket (struct ConIdx_Index *Idx,unsigned Bucket)
+  {
+   while (Idx->Header.BucketHeads[Bucket])
+      ConIdx_RemUsr (Idx,&Idx->Usrs[Idx->Header.BucketHeads[Bucket] - 1]);
+  }
+
+/*****************************************************************************/
+/************ Rebuild table of counters by course from users *****************/
+/*****************************************************************************/
+
+static void ConIdx_RebuildCrss (struct ConIdx_Index *Idx)
+  {
+   unsigned NumUsr;
+
+   memset (Idx->Crss,0,sizeof (Idx->Crss));
+   Idx->Header.CrssOverflow = 0;
+   for (NumUsr = 0;
+	NumUsr < Idx->Header.NumUsrsUsed;
+	NumUsr++)
+      if (Idx->Usrs[NumUsr].UsrCod > 0)
+	 ConIdx_CountUsrInCrss (Idx,&Idx->Usrs[NumUsr],1);
+  }
+
+/*****************************************************************************/
+/************************ Get courses of a user ******************************/
+/*****************************************************************************/
+
+static void ConIdx_GetCrssOfUsr (long UsrCod,struct ConIdx_MyCrss *MyCrss)
+  {
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   unsigned NumCrs;
+   unsigned NumCrss;
+
+   NumCrss = Con_DB_GetCrssOfUsr (&mysql_res,UsrCod);
+   MyCrss->TooManyCrss = (NumCrss > ConIdx_MAX_CRSS_PER_USR);
+   MyCrss->NumCrss = MyCrss->TooManyCrss ? ConIdx_MAX_CRSS_PER_USR :
+					   NumCrss;
+   for (NumCrs = 0;
+	NumCrs < MyCrss->NumCrss;
+	NumCrs++)
+     {
+      row = mysql_fetch_row (mysql_res);
+
+      /* Get course code (row[0]) and role (row[1]) */
+      MyCrss->CrsCods[NumCrs] = Str_ConvertStrCodToLongCod (row[0]);
+      MyCrss->Roles[NumCrs]   = (unsigned char) Rol_ConvertUnsignedStrToRole (row[1]);
+     }
+   DB_FreeMySQLResult (&mysql_res);
+  }
+
+/*****************************************************************************/
+/************** Check if courses of a user in index are valid ****************/
+/*****************************************************************************/
+
+// Usr is NULL if the user is not in index
+
+static bool ConIdx_CheckIfUsrCrssAreValid (const struct ConIdx_Index *Idx,
+					   const struct ConIdx_Usr *Usr)
+  {
+   if (Usr)
+      return Usr->CrssStamp > Idx->Header.MinCrssStamp;
+
+   return false;
+  }
+
+/*****************************************************************************/
+/*************************** Find a user in index ****************************/
+/*****************************************************************************/
+
+static struct ConIdx_Usr *ConIdx_FindUsr (struct ConIdx_Index *Idx,long UsrCod)
+  {
+   unsigned Link;
+
+   for (Link = Idx->Header.HashHeads[(unsigned long) UsrCod % ConIdx_NUM_HASH];
+	Link;
+	Link = Idx->Usrs[Link - 1].HashNext)
+      if (Idx->Usrs[Link - 1].UsrCod == UsrCod)
+	 return &Idx->Usrs[Link - 1];
+
+   return NULL;
+  }
+
+/*****************************************************************************/
+/************************ Add a new user to index ****************************/
+/*****************************************************************************/
+// The user is not counted nor linked to a bucket
+// Return NULL if index is full
+
+static struct ConIdx_Usr *ConIdx_AddUsr (struct ConIdx_Index *Idx,long UsrCod)
+  {
+   unsigned Link;
+   unsigned Hash = (unsigned) ((unsigned long) UsrCod % ConIdx_NUM_HASH);
+   struct ConIdx_Usr *Usr;
+
+   /***** Get a free entry *****/
+   if (Idx->Header.FreeUsrs)
+     {
+      Link = Idx->Header.FreeUsrs;
+      Idx->Header.FreeUsrs = Idx->Usrs[Link - 1].BucketNext;
+     }
+   else if (Idx->Header.NumUsrsUsed < ConIdx_MAX_USRS)
+      Link = ++Idx->Header.NumUsrsUsed;
+   else
+      return NULL;
+
+   /***** Reset entry and link it to hash chain *****/
+   Usr = &Idx->Usrs[Link - 1];
+   memset (Usr,0,sizeof (*Usr));
+   Usr->UsrCod = UsrCod;
+   Usr->HashNext = Idx->Header.HashHeads[Hash];
+   Idx->Header.HashHeads[Hash] = Link;
+
+   return Usr;
+  }
+
+/*****************************************************************************/
+/************************* Remove a user from index **************************/
+/*****************************************************************************/
+
+static void ConIdx_RemUsr (struct ConIdx_Index *Idx,struct ConIdx_Usr *Usr)
+  {
+   unsigned Link = (unsigned) (Usr - Idx->Usrs) + 1;
+   unsigned *Ptr;
+
+   /***** Discount user and unlink from bucket *****/
+   ConIdx_CountUsr (Idx,Usr,-1);
+   ConIdx_UnlinkFromBucket (Idx,Usr);
+
+   /***** Unlink from hash chain *****/
+   for (Ptr = &Idx->Header.HashHeads[(unsigned long) Usr->UsrCod % ConIdx_NUM_HASH];
+	*Ptr;
+	Ptr = &Idx->Usrs[*Ptr - 1].HashNext)
+      if (*Ptr == Link)
+	{
+	 *Ptr = Usr->HashNext;
+	 break;
+	}
+
+   /***** Add entry to list of free entries *****/
+   if (Usr->TooManyCrss)
+      Idx->Header.NumUsrsWithTooManyCrss--;
+   Usr->UsrCod = -1L;
+   Usr->BucketNext = Idx->Header.FreeUsrs;
+   Idx->Header.FreeUsrs = Link;
+  }
+
+/*****************************************************************************/
+/********************* Set the courses of a user in index ********************/
+/*****************************************************************************/
+// The user must not be counted
+
+static void ConIdx_SetUsrCrss (struct ConIdx_Index *Idx,struct ConIdx_Usr *Usr,
+			       const struct ConIdx_MyCrss *MyCrss)
+  {
+   if (Usr->TooManyCrss)
+      Idx->Header.NumUsrsWithTooManyCrss--;
+
+   Usr->NumCrss = (unsigned char) MyCrss->NumCrss;
+   memcpy (Usr->CrsCods,MyCrss->CrsCods,MyCrss->NumCrss * sizeof (Usr->CrsCods[0]));
+   memcpy (Usr->Roles  ,MyCrss->Roles  ,MyCrss->NumCrss * sizeof (Usr->Roles[0]));
+   Usr->TooManyCrss = MyCrss->TooManyCrss;
+
+   if (Usr->TooManyCrss)
+      Idx->Header.NumUsrsWithTooManyCrss++;
+  }
+
+/*****************************************************************************/
+/******* Count (Inc = 1) or discount (Inc = -1) a user in the counters *******/
+/*****************************************************************************/
+
+static void ConIdx_CountUsr (struct ConIdx_Index *Idx,struct ConIdx_Usr *Usr,int Inc)
+  {
+   /***** Global counter by role in last course *****/
+   Idx->Header.NumUsrs[Usr->RoleInLastCrs] += (unsigned) Inc;
+
+   /***** Counters in courses of the user *****/
+   ConIdx_CountUsrInCrss (Idx,Usr,Inc);
+  }
+
+static void ConIdx_CountUsrInCrss (struct ConIdx_Index *Idx,struct ConIdx_Usr *Usr,int Inc)
+  {
+   unsigned NumCrs;
+   struct ConIdx_Crs *Crs;
+   Rol_Role_t Role;
+
+   for (NumCrs = 0;
+	NumCrs < Usr->NumCrss;
+	NumCrs++)
+     {
+      Role = (Rol_Role_t) Usr->Roles[NumCrs];
+      if (Role == Rol_STD ||
+	  Role == Rol_NET ||
+	  Role == Rol_TCH)
+	{
+	 if ((Crs = ConIdx_FindCrs (Idx,Usr->CrsCods[NumCrs],Inc > 0)))
+	    Crs->NumUsrs[Role - Rol_STD][Usr->Sex] += (unsigned) Inc;
+	 else if (Inc > 0)
+	    Idx->Header.CrssOverflow = 1;	// Table of courses is full
+	}
+     }
+  }
+
+/*****************************************************************************/
+/*********** Link a user to the bucket of a minute, and unlink it ************/
+/*****************************************************************************/
+
+static void ConIdx_LinkToBucket (struct ConIdx_Index *Idx,struct ConIdx_Usr *Usr,
+				 long Minute)
+  {
+   unsigned Link = (unsigned) (Usr - Idx->Usrs) + 1;
+   unsigned Bucket = (unsigned) (Minute % ConIdx_NUM_BUCKETS);
+
+   Usr->Minute = Minute;
+   Usr->BucketPrev = 0;
+   Usr->BucketNext = Idx->Header.BucketHeads[Bucket];
+   if (Usr->BucketNext)
+      Idx->Usrs[Usr->BucketNext - 1].BucketPrev = Link;
+   Idx->Header.BucketHeads[Bucket] = Link;
+  }
+
+static void ConIdx_UnlinkFromBucket (struct ConIdx_Index *Idx,struct ConIdx_Usr *Usr)
+  {
+   unsigned Bucket = (unsigned) (Usr->Minute % ConIdx_NUM_BUCKETS);
+
+   if (Usr->BucketPrev)
+      Idx->Usrs[Usr->BucketPrev - 1].BucketNext = Usr->BucketNext;
+   else
+      Idx->Header.BucketHeads[Bucket] = Usr->BucketNext;
+   if (Usr->BucketNext)
+      Idx->Usrs[Usr->BucketNext - 1].BucketPrev = Usr->BucketPrev;
+   Usr->BucketPrev =
+   Usr->BucketNext = 0;
+  }
+
+/*****************************************************************************/
+/************* Find the counters of a course, creating them if asked *********/
+/*****************************************************************************/
+// Return NULL if not found
+
+static struct ConIdx_Crs *ConIdx_FindCrs (struct ConIdx_Index *Idx,long CrsCod,
+					  bool Create)
+  {
+   unsigned Pos = (unsigned) (((unsigned long) CrsCod * 2654435761UL) & (ConIdx_MAX_CRSS - 1));
+   unsigned NumProbes;
+
+   for (NumProbes = 0;
+	NumProbes < ConIdx_MAX_CRSS;
+	NumProbes++, Pos = (Pos + 1) & (ConIdx_MAX_CRSS - 1))
+     {
+      if (Idx->Crss[Pos].CrsCod == CrsCod)
+	 return &Idx->Crss[Pos];
+      if (Idx->Crss[Pos].CrsCod == 0)	// Empty entry
+	{
+	 if (!Create)
+	    return NULL;
+	 Idx->Crss[Pos].CrsCod = CrsCod;
+	 return &Idx->Crss[Pos];
+	}
+     }
+
+   return NULL;	// Table is full
+  }
+
+/*****************************************************************************/
+/************* Check if counters of courses are right now ********************/
+/*****************************************************************************/
+
+static bool ConIdx_CheckIfCrssAreReliable (const struct ConIdx_Index *Idx)
+  {
+   return Idx->Header.Minute - Idx->Header.UsrsOverflowMinute >= ConIdx_MINUTES_ALIVE &&
+	  !Idx->Header.CrssOverflow &&
+	  !Idx->Header.NumUsrsWithTooManyCrss;
+  }
+
+/*****************************************************************************/
+/************************* Get current minute ********************************/
+/*****************************************************************************/
+
+static long ConIdx_GetCurrentMinute (void)
+  {
+   return (long) (Dat_GetStartExecutionTimeUTC () / 60);
+  }
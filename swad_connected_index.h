@@ -0,0 +1,66 @@
+// swad_connected_index.h: index of connected users shared by all processes
+
+#ifndef _SWAD_CON_IDX
+#define _SWAD_CON_IDX
+/*
+    SWAD (Shared Workspace At a Distance),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2026 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/********************************* Headers ***********************************/
+/*****************************************************************************/
+
+#include <time.h>		// For time_t
+
+#include "swad_connected.h"
+#include "swad_error.h"
+#include "swad_role_type.h"
+
+/*****************************************************************************/
+/******************************** Public types *******************************/
+/*****************************************************************************/
+
+struct ConIdx_ConnectedUsr
+  {
+   long UsrCod;
+   long LastCrsCod;	// Course of last click
+   time_t LastTime;	// Time of last click
+  };
+
+/*****************************************************************************/
+/***************************** Public prototypes *****************************/
+/*****************************************************************************/
+
+void ConIdx_UpdateMe (void);
+void ConIdx_RefreshMe (void);
+void ConIdx_RemoveUsr (long UsrCod);
+void ConIdx_FlushCrssOfUsr (long UsrCod);
+void ConIdx_FlushCrssOfAllUsrs (void);
+void ConIdx_Unmap (void);
+
+Err_SuccessOrError_t ConIdx_GetNumUsrsWithRoleInLastCrs (unsigned NumUsrs[Rol_NUM_ROLES]);
+Err_SuccessOrError_t ConIdx_GetNumConnectedInCrs (long CrsCod,Rol_Role_t Role,
+						  struct Con_ConnectedUsrs *Usrs);
+Err_SuccessOrError_t ConIdx_GetConnectedInCrs (long CrsCod,Rol_Role_t Role,
+					       unsigned *NumUsrs,
+					       unsigned MaxUsrs,
+					       struct ConIdx_ConnectedUsr *Lst);
+
+#endif
@@ -35,6 +35,7 @@
 #include "swad_global.h"
 #include "swad_hierarchy.h"
 #include "swad_hierarchy_database.h"
+#include "swad_hierarchy_snapshot.h"
 #include "swad_search.h"
 #include "swad_www.h"
 
@@ -102,6 +103,8 @@ void Cty_DB_CreateCountry (const struct Hie_Node *Cty,
                    Cty->ShrtName,
 		   SubQueryNam2,
 		   SubQueryWWW2);
+
+   HieSnp_Invalidate ();
   }
 
 /*****************************************************************************/
@@ -579,6 +582,8 @@ void Cty_DB_UpdateCtyField (long HieCod,const char *FldName,const char *FldValue
 		   " WHERE CtyCod='%03ld'",
 	           FldName,FldValue,
 	           HieCod);
+
+   HieSnp_Invalidate ();
   }
 
 /*****************************************************************************/
@@ -677,4 +682,6 @@ void Cty_DB_RemoveCty (long HieCod)
 		   "DELETE FROM cty_countrs"
 		   " WHERE CtyCod='%03ld'",
 		   HieCod);
+
+   HieSnp_Invalidate ();
   }
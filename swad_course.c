@@ -37,6 +37,7 @@
 #include "swad_browser_database.h"
 #include "swad_call_for_exam_database.h"
 #include "swad_center_database.h"
+#include "swad_connected.h"
 #include "swad_country_database.h"
 #include "swad_course.h"
 #include "swad_course_config.h"
@@ -185,11 +186,6 @@ unsigned Crs_GetCachedNumCrssWithUsrs (Hie_Level_t HieLvl,Rol_Role_t Role)
 void Crs_WriteSelectorOfCourse (void)
   {
    extern const char *Txt_HIERARCHY_SINGUL_Abc[Hie_NUM_LEVELS];
-   MYSQL_RES *mysql_res;
-   MYSQL_ROW row;
-   unsigned NumCrss;
-   unsigned NumCrs;
-   long HieCod;
 
    /***** Begin form *****/
    Frm_BeginFormGoTo (ActSeeCrsInf);
@@ -207,32 +203,11 @@ void Crs_WriteSelectorOfCourse (void)
 							       HTM_NO_ATTR) | HTM_DISABLED,
 		     "[%s]",Txt_HIERARCHY_SINGUL_Abc[Hie_CRS]);
 
+	 /***** List courses of current degree *****/
 	 if (Gbl.Hierarchy.Node[Hie_DEG].HieCod > 0)
-	   {
-	    /***** Get courses belonging to the current degree from database *****/
-	    NumCrss = Crs_DB_GetCrssInCurrentDegBasic (&mysql_res);
-	    for (NumCrs = 0;
-		 NumCrs < NumCrss;
-		 NumCrs++)
-	      {
-	       /* Get next course */
-	       row = mysql_fetch_row (mysql_res);
-
-	       /* Get course code (row[0]) */
-	       if ((HieCod = Str_ConvertStrCodToLongCod (row[0])) <= 0)
-		  Err_WrongCourseExit ();
-
-	       /* Write option */
-	       HTM_OPTION (HTM_Type_LONG,&HieCod,
-			   Gbl.Hierarchy.HieLvl == Hie_CRS &&	// Course selected
-			   HieCod == Gbl.Hierarchy.Node[Hie_CRS].HieCod ? HTM_SELECTED :
-									  HTM_NO_ATTR,
-			   "%s",row[1]);	// Short name (row[1])
-	      }
-
-	    /***** Free structure that stores the query result *****/
-	    DB_FreeMySQLResult (&mysql_res);
-	   }
+	    Hie_WriteOptionsOfChildren (Hie_CRS,
+				        Gbl.Hierarchy.HieLvl == Hie_CRS ? Gbl.Hierarchy.Node[Hie_CRS].HieCod :	// Course selected
+									  -1L);
 
       /***** End selector of course *****/
       HTM_SELECT_End ();
@@ -1278,6 +1253,7 @@ static void Crs_EmptyCourseCompletely (long HieCod)
       /***** Remove possible users remaining in the course (teachers) *****/
       Set_DB_RemAllUsrsFromCrsSettings (HieCod);
       Enr_DB_RemAllUsrsFromCrs (HieCod);
+      Con_FlushCrssOfAllUsrs ();
 
       /***** Remove directories of the course *****/
       snprintf (PathRelCrs,sizeof (PathRelCrs),"%s/%ld",
@@ -28,6 +28,7 @@
 #define _GNU_SOURCE 		// For asprintf
 #include <stdio.h>		// For asprintf
 #include <stdlib.h>		// For free
+#include <string.h>		// For strcmp
 
 #include "swad_course.h"
 #include "swad_course_config.h"
@@ -36,6 +37,9 @@
 #include "swad_global.h"
 #include "swad_hierarchy.h"
 #include "swad_hierarchy_database.h"
+#include "swad_hierarchy_snapshot.h"
+#include "swad_name.h"
+#include "swad_search_index.h"
 
 /*****************************************************************************/
 /************** External global variables from others modules ****************/
@@ -65,6 +69,11 @@ void Crs_DB_CreateCourse (struct Hie_Node *Crs,Hie_Status_t Status)
 				Gbl.Usrs.Me.UsrDat.UsrCod,
 				Crs->ShrtName,
 				Crs->FullName);
+
+   HieSnp_Invalidate ();
+
+   /***** Add full name to search index *****/
+   SchIdx_IndexName (SchIdx_CRS,Crs->HieCod,Crs->FullName);
   }
 
 /*****************************************************************************/
@@ -507,6 +516,8 @@ void Crs_DB_UpdateInstitutionalCrsCod (long HieCod,const char *NewInstitutionalC
 		   " WHERE CrsCod=%ld",
                    NewInstitutionalCrsCod,
                    HieCod);
+
+   HieSnp_Invalidate ();
   }
 
 /*****************************************************************************/
@@ -521,6 +532,8 @@ void Crs_DB_UpdateCrsYear (long HieCod,unsigned NewYear)
 		   " WHERE CrsCod=%ld",
 	           NewYear,
 	           HieCod);
+
+   HieSnp_Invalidate ();
   }
 
 /*****************************************************************************/
@@ -530,12 +543,20 @@ void Crs_DB_UpdateCrsYear (long HieCod,unsigned NewYear)
 void Crs_DB_UpdateCrsName (long HieCod,
 			   const char *FldName,const char *NewCrsName)
   {
+   extern const char *Nam_Fields[Nam_NUM_SHRT_FULL_NAMES];
+
    DB_QueryUPDATE ("can not update the name of a course",
 		   "UPDATE crs_courses"
 		     " SET %s='%s'"
 		   " WHERE CrsCod=%ld",
 	           FldName,NewCrsName,
 	           HieCod);
+
+   HieSnp_Invalidate ();
+
+   /***** Update full name in search index *****/
+   if (!strcmp (FldName,Nam_Fields[Nam_FULL_NAME]))
+      SchIdx_IndexName (SchIdx_CRS,HieCod,NewCrsName);
   }
 
 /*****************************************************************************/
@@ -550,6 +571,8 @@ void Crs_DB_UpdateDegOfCurrentCrs (long HieCod)
 		   " WHERE CrsCod=%ld",
 	           HieCod,
 	           Gbl.Hierarchy.Node[Hie_CRS].HieCod);
+
+   HieSnp_Invalidate ();
   }
 
 /*****************************************************************************/
@@ -564,6 +587,8 @@ void Crs_DB_UpdateCrsStatus (long HieCod,Hie_Status_t Status)
 		   " WHERE CrsCod=%ld",
                    (unsigned) Status,
                    HieCod);
+
+   HieSnp_Invalidate ();
   }
 
 /*****************************************************************************/
@@ -634,4 +659,9 @@ void Crs_DB_RemoveCrs (long HieCod)
 		   "DELETE FROM crs_courses"
 		   " WHERE CrsCod=%ld",
 		   HieCod);
+
+   HieSnp_Invalidate ();
+
+   /***** Remove full name from search index *****/
+   SchIdx_RemoveName (SchIdx_CRS,HieCod);
   }
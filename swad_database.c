@@ -41,6 +41,8 @@
 #include "swad_global.h"
 #include "swad_HTML.h"
 #include "swad_language.h"
+#include "swad_page_cache.h"
+#include "swad_trace.h"
 
 /*****************************************************************************/
 /************************* Private global variables **************************/
@@ -62,6 +64,7 @@ static struct
 /*****************************************************************************/
 
 static void DB_CreateTable (const char *Query);
+static int DB_RunQuery (const char *Query);
 static unsigned long DB_QuerySELECTusingQueryStr (char *Query,
 					          MYSQL_RES **mysql_res,
 						  const char *MsgError);
@@ -520,6 +523,39 @@ mysql> DESCRIBE brw_files;
 		   "INDEX(PublisherUsrCod)"
 		   ") ENGINE=MyISAM");
 
+   /***** Table brw_folders *****/
+/*
+mysql> DESCRIBE brw_folders;
++-------------+------------+------+-----+---------+-------+
+| Field       | Type       | Null | Key | Default | Extra |
++-------------+------------+------+-----+---------+-------+
+| FileBrowser | tinyint(4) | NO   | PRI | NULL    |       |
+| Cod         | int(11)    | NO   | PRI | -1      |       |
+| ZoneUsrCod  | int(11)    | NO   | PRI | -1      |       |
+| Path        | text       | NO   |     | NULL    |       |
+| PathHash    | binary(16) | NO   | PRI | NULL    |       |
+| NumFolders  | int(11)    | NO   |     | 0       |       |
+| NumFiles    | int(11)    | NO   |     | 0       |       |
+| Size        | bigint(20) | NO   |     | 0       |       |
+| VerifyTime  | datetime   | NO   | MUL | NULL    |       |
++-------------+------------+------+-----+---------+-------+
+9 rows in set (0.00 sec)
+*/
+   DB_CreateTable ("CREATE TABLE IF NOT EXISTS brw_folders ("
+			"FileBrowser TINYINT NOT NULL,"
+			"Cod INT NOT NULL DEFAULT -1,"
+			"ZoneUsrCod INT NOT NULL DEFAULT -1,"
+			"Path TEXT COLLATE latin1_bin NOT NULL,"	// PATH_MAX
+			"PathHash BINARY(16) NOT NULL,"		// UNHEX(MD5(Path)), TEXT can not be a key
+			"NumFolders INT NOT NULL DEFAULT 0,"
+			"NumFiles INT NOT NULL DEFAULT 0,"
+			"Size BIGINT NOT NULL DEFAULT 0,"
+			"VerifyTime DATETIME NOT NULL,"
+		   "UNIQUE INDEX(FileBrowser,Cod,ZoneUsrCod,PathHash),"
+		   "INDEX(ZoneUsrCod),"
+		   "INDEX(VerifyTime)"
+		   ") ENGINE=MyISAM");
+
    /***** Table brw_last *****/
 /*
 mysql> DESCRIBE brw_last;
@@ -1332,19 +1368,20 @@ mysql> DESCRIBE exa_print_questions;
    /***** Table exa_prints *****/
 /*
 mysql> DESCRIBE exa_prints;
-+-----------------+----------+------+-----+---------+----------------+
-| Field           | Type     | Null | Key | Default | Extra          |
-+-----------------+----------+------+-----+---------+----------------+
-| PrnCod          | int(11)  | NO   | PRI | NULL    | auto_increment |
-| SesCod          | int(11)  | NO   | MUL | NULL    |                |
-| UsrCod          | int(11)  | NO   |     | NULL    |                |
-| StartTime       | datetime | NO   |     | NULL    |                |
-| EndTime         | datetime | NO   |     | NULL    |                |
-| NumQsts         | int(11)  | NO   |     | 0       |                |
-| NumQstsNotBlank | int(11)  | NO   |     | 0       |                |
-| Score           | double   | NO   |     | 0       |                |
-+-----------------+----------+------+-----+---------+----------------+
-8 rows in set (0.00 sec)
++-----------------+---------------------+------+-----+---------+----------------+
+| Field           | Type                | Null | Key | Default | Extra          |
++-----------------+---------------------+------+-----+---------+----------------+
+| PrnCod          | int(11)             | NO   | PRI | NULL    | auto_increment |
+| SesCod          | int(11)             | NO   | MUL | NULL    |                |
+| UsrCod          | int(11)             | NO   |     | NULL    |                |
+| StartTime       | datetime            | NO   |     | NULL    |                |
+| EndTime         | datetime            | NO   |     | NULL    |                |
+| NumQsts         | int(11)             | NO   |     | 0       |                |
+| NumQstsNotBlank | int(11)             | NO   |     | 0       |                |
+| Score           | double              | NO   |     | 0       |                |
+| Seed            | bigint(20) unsigned | NO   |     | 0       |                |
++-----------------+---------------------+------+-----+---------+----------------+
+9 rows in set (0.00 sec)
 */
    DB_CreateTable ("CREATE TABLE IF NOT EXISTS exa_prints ("
 			"PrnCod INT NOT NULL AUTO_INCREMENT,"
@@ -1355,6 +1392,7 @@ mysql> DESCRIBE exa_prints;
 			"NumQsts INT NOT NULL DEFAULT 0,"
 			"NumQstsNotBlank INT NOT NULL DEFAULT 0,"
 			"Score DOUBLE PRECISION NOT NULL DEFAULT 0,"
+			"Seed BIGINT UNSIGNED NOT NULL DEFAULT 0,"
 		   "UNIQUE INDEX(PrnCod),"
 		   "UNIQUE INDEX(SesCod,UsrCod)"
 		   ") ENGINE=MyISAM");
@@ -1647,19 +1685,21 @@ mysql> DESCRIBE for_posts;
    /***** Table for_read *****/
 /*
 mysql> DESCRIBE for_read;
-+----------+----------+------+-----+---------+-------+
-| Field    | Type     | Null | Key | Default | Extra |
-+----------+----------+------+-----+---------+-------+
-| ThrCod   | int(11)  | NO   | PRI | NULL    |       |
-| UsrCod   | int(11)  | NO   | PRI | NULL    |       |
-| ReadTime | datetime | NO   |     | NULL    |       |
-+----------+----------+------+-----+---------+-------+
-3 rows in set (0.00 sec)
++-------------+----------+------+-----+---------+-------+
+| Field       | Type     | Null | Key | Default | Extra |
++-------------+----------+------+-----+---------+-------+
+| ThrCod      | int(11)  | NO   | PRI | NULL    |       |
+| UsrCod      | int(11)  | NO   | PRI | NULL    |       |
+| ReadTime    | datetime | NO   |     | NULL    |       |
+| NumReadPsts | int(11)  | NO   |     | 0       |       |
++-------------+----------+------+-----+---------+-------+
+4 rows in set (0.00 sec)
 */
    DB_CreateTable ("CREATE TABLE IF NOT EXISTS for_read ("
 			"ThrCod INT NOT NULL,"
 			"UsrCod INT NOT NULL,"
 			"ReadTime DATETIME NOT NULL,"
+			"NumReadPsts INT NOT NULL DEFAULT 0,"
 		   "UNIQUE INDEX(ThrCod,UsrCod)"
 		   ") ENGINE=MyISAM");
 
@@ -1674,8 +1714,11 @@ mysql> DESCRIBE for_threads;
 | HieCod      | int(11)    | NO   | MUL | -1      |                |
 | FirstPstCod | int(11)    | NO   | UNI | NULL    |                |
 | LastPstCod  | int(11)    | NO   | UNI | NULL    |                |
+| NumPsts     | int(11)    | NO   |     | 0       |                |
+| NumWriters  | int(11)    | NO   |     | 0       |                |
+| NumReaders  | int(11)    | NO   |     | 0       |                |
 +-------------+------------+------+-----+---------+----------------+
-5 rows in set (0.00 sec)
+8 rows in set (0.00 sec)
 */
    DB_CreateTable ("CREATE TABLE IF NOT EXISTS for_threads ("
 			"ThrCod INT NOT NULL AUTO_INCREMENT,"
@@ -1683,6 +1726,9 @@ mysql> DESCRIBE for_threads;
 			"HieCod INT NOT NULL DEFAULT -1,"
 			"FirstPstCod INT NOT NULL,"
 			"LastPstCod INT NOT NULL,"
+			"NumPsts INT NOT NULL DEFAULT 0,"
+			"NumWriters INT NOT NULL DEFAULT 0,"
+			"NumReaders INT NOT NULL DEFAULT 0,"
 		   "UNIQUE INDEX(ThrCod),"
 		   "INDEX(ForumType),"
 		   "INDEX(HieCod),"
@@ -3038,6 +3084,45 @@ mysql> DESCRIBE rub_scores;
 		   "UNIQUE INDEX(Type,Cod,UsrCod,CriCod)"
 		   ") ENGINE=MyISAM");
 
+   /***** Table sch_indexes *****/
+/*
+mysql> DESCRIBE sch_indexes;
++---------+---------------+------+-----+---------+-------+
+| Field   | Type          | Null | Key | Default | Extra |
++---------+---------------+------+-----+---------+-------+
+| Idx     | tinyint(4)    | NO   | PRI | NULL    |       |
+| LastCod | int(11)       | NO   |     | -1      |       |
+| Ready   | enum('N','Y') | NO   |     | N       |       |
++---------+---------------+------+-----+---------+-------+
+3 rows in set (0.00 sec)
+*/
+   DB_CreateTable ("CREATE TABLE IF NOT EXISTS sch_indexes ("
+			"Idx TINYINT NOT NULL,"
+			"LastCod INT NOT NULL DEFAULT -1,"
+			"Ready ENUM('N','Y') NOT NULL DEFAULT 'N',"
+		   "UNIQUE INDEX(Idx)"
+		   ") ENGINE=MyISAM");
+
+   /***** Table sch_trigrams *****/
+/*
+mysql> DESCRIBE sch_trigrams;
++---------+------------+------+-----+---------+-------+
+| Field   | Type       | Null | Key | Default | Extra |
++---------+------------+------+-----+---------+-------+
+| Idx     | tinyint(4) | NO   | PRI | NULL    |       |
+| Trigram | char(3)    | NO   | PRI | NULL    |       |
+| Cod     | int(11)    | NO   | PRI | NULL    |       |
++---------+------------+------+-----+---------+-------+
+3 rows in set (0.00 sec)
+*/
+   DB_CreateTable ("CREATE TABLE IF NOT EXISTS sch_trigrams ("
+			"Idx TINYINT NOT NULL,"
+			"Trigram CHAR(3) COLLATE latin1_bin NOT NULL,"
+			"Cod INT NOT NULL,"
+		   "UNIQUE INDEX(Idx,Trigram,Cod),"
+		   "INDEX(Idx,Cod)"
+		   ") ENGINE=MyISAM");
+
    /***** Table ses_params *****/
 /*
 mysql> DESCRIBE ses_params;
@@ -4295,10 +4380,25 @@ static void DB_CreateTable (const char *Query)
       HTM_Txt (Query);
    HTM_LI_End ();
 
-   if (mysql_query (&DB_Database.mysql,Query))
+   if (DB_RunQuery (Query))
       DB_ExitOnMySQLError ("can not create table");
   }
 
+/*****************************************************************************/
+/************************** Send a query to database *************************/
+/*****************************************************************************/
+
+static int DB_RunQuery (const char *Query)
+  {
+   int Result;
+
+   Trc_BeginSpan ("db",Query);
+   Result = mysql_query (&DB_Database.mysql,Query);	// Returns 0 on success
+   Trc_EndSpan ();
+
+   return Result;
+  }
+
 /*****************************************************************************/
 /********************* Open connection to the database ***********************/
 /*****************************************************************************/
@@ -4596,7 +4696,7 @@ static unsigned long DB_QuerySELECTusingQueryStr (char *Query,
       Err_ShowErrorAndExit ("Wrong query string.");
 
    /***** Query database and free query string pointer *****/
-   Result = mysql_query (&DB_Database.mysql,Query);	// Returns 0 on success
+   Result = DB_RunQuery (Query);	// Returns 0 on success
    free (Query);
    if (Result)
       DB_ExitOnMySQLError (MsgError);
@@ -4714,7 +4814,8 @@ void DB_QueryINSERT (const char *MsgError,const char *fmt,...)
       Err_NotEnoughMemoryExit ();
 
    /***** Query database and free query string pointer *****/
-   Result = mysql_query (&DB_Database.mysql,Query);	// Returns 0 on success
+   Result = DB_RunQuery (Query);	// Returns 0 on success
+   PagCac_RemoveCachedPagesIfQueryModifiesThem (Query);
    free (Query);
    if (Result)
       DB_ExitOnMySQLError (MsgError);
@@ -4738,7 +4839,8 @@ long DB_QueryINSERTandReturnCode (const char *MsgError,const char *fmt,...)
       Err_NotEnoughMemoryExit ();
 
    /***** Query database and free query string pointer *****/
-   Result = mysql_query (&DB_Database.mysql,Query);	// Returns 0 on success
+   Result = DB_RunQuery (Query);	// Returns 0 on success
+   PagCac_RemoveCachedPagesIfQueryModifiesThem (Query);
    free (Query);
    if (Result)
       DB_ExitOnMySQLError (MsgError);
@@ -4747,6 +4849,34 @@ long DB_QueryINSERTandReturnCode (const char *MsgError,const char *fmt,...)
    return (long) mysql_insert_id (&DB_Database.mysql);
   }
 
+/*****************************************************************************/
+/******* Make an INSERT query in database and return number of rows **********/
+/*****************************************************************************/
+
+unsigned long DB_QueryINSERTandReturnNumRows (const char *MsgError,const char *fmt,...)
+  {
+   va_list ap;
+   int NumBytesPrinted;
+   char *Query;
+   int Result;
+
+   va_start (ap,fmt);
+   NumBytesPrinted = vasprintf (&Query,fmt,ap);
+   va_end (ap);
+   if (NumBytesPrinted < 0)	// -1 if no memory or any other error
+      Err_NotEnoughMemoryExit ();
+
+   /***** Query database and free query string pointer *****/
+   Result = DB_RunQuery (Query);	// Returns 0 on success
+   PagCac_RemoveCachedPagesIfQueryModifiesThem (Query);
+   free (Query);
+   if (Result)
+      DB_ExitOnMySQLError (MsgError);
+
+   /***** Return the number of inserted rows *****/
+   return (unsigned long) mysql_affected_rows (&DB_Database.mysql);
+  }
+
 /*****************************************************************************/
 /******************** Make an REPLACE query in database **********************/
 /*****************************************************************************/
@@ -4765,7 +4895,8 @@ void DB_QueryREPLACE (const char *MsgError,const char *fmt,...)
       Err_NotEnoughMemoryExit ();
 
    /***** Query database and free query string pointer *****/
-   Result = mysql_query (&DB_Database.mysql,Query);	// Returns 0 on success
+   Result = DB_RunQuery (Query);	// Returns 0 on success
+   PagCac_RemoveCachedPagesIfQueryModifiesThem (Query);
    free (Query);
    if (Result)
       DB_ExitOnMySQLError (MsgError);
@@ -4789,7 +4920,8 @@ void DB_QueryUPDATE (const char *MsgError,const char *fmt,...)
       Err_NotEnoughMemoryExit ();
 
    /***** Query database and free query string pointer *****/
-   Result = mysql_query (&DB_Database.mysql,Query);	// Returns 0 on success
+   Result = DB_RunQuery (Query);	// Returns 0 on success
+   PagCac_RemoveCachedPagesIfQueryModifiesThem (Query);
    free (Query);
    if (Result)
       DB_ExitOnMySQLError (MsgError);
@@ -4813,7 +4945,8 @@ void DB_QueryDELETE (const char *MsgError,const char *fmt,...)
       Err_NotEnoughMemoryExit ();
 
    /***** Query database and free query string pointer *****/
-   Result = mysql_query (&DB_Database.mysql,Query);	// Returns 0 on success
+   Result = DB_RunQuery (Query);	// Returns 0 on success
+   PagCac_RemoveCachedPagesIfQueryModifiesThem (Query);
    free (Query);
    if (Result)
       DB_ExitOnMySQLError (MsgError);
@@ -4837,7 +4970,7 @@ void DB_CreateTmpTable (const char *fmt,...)
       Err_NotEnoughMemoryExit ();
 
    /***** Query database and free query string pointer *****/
-   Result = mysql_query (&DB_Database.mysql,Query);	// Returns 0 on success
+   Result = DB_RunQuery (Query);	// Returns 0 on success
    free (Query);
    if (Result)
       DB_ExitOnMySQLError ("can not create temporary table");
@@ -4867,7 +5000,8 @@ void DB_Query (const char *MsgError,const char *fmt,...)
       Err_NotEnoughMemoryExit ();
 
    /***** Query database and free query string pointer *****/
-   Result = mysql_query (&DB_Database.mysql,Query);	// Returns 0 on success
+   Result = DB_RunQuery (Query);	// Returns 0 on success
+   PagCac_RemoveCachedPagesIfQueryModifiesThem (Query);
    free (Query);
    if (Result)
       DB_ExitOnMySQLError (MsgError);
@@ -66,6 +66,7 @@ Exi_Exist_t DB_QueryEXISTS (const char *MsgError,const char *fmt,...);
 void DB_QueryINSERT (const char *MsgError,const char *fmt,...);
 
 long DB_QueryINSERTandReturnCode (const char *MsgError,const char *fmt,...);
+unsigned long DB_QueryINSERTandReturnNumRows (const char *MsgError,const char *fmt,...);
 
 void DB_QueryREPLACE (const char *MsgError,const char *fmt,...);
 
@@ -221,11 +221,6 @@ void Deg_DrawDegreeLogoAndNameWithLink (struct Hie_Node *Deg,Act_Action_t Action
 void Deg_WriteSelectorOfDegree (void)
   {
    extern const char *Txt_HIERARCHY_SINGUL_Abc[Hie_NUM_LEVELS];
-   MYSQL_RES *mysql_res;
-   MYSQL_ROW row;
-   unsigned NumDegs;
-   unsigned NumDeg;
-   long HieCod;
 
    /***** Begin form *****/
    Frm_BeginFormGoTo (ActSeeCrs);
@@ -243,34 +238,9 @@ void Deg_WriteSelectorOfDegree (void)
 							        HTM_NO_ATTR) | HTM_DISABLED,
 		     "[%s]",Txt_HIERARCHY_SINGUL_Abc[Hie_DEG]);
 
+	 /***** List degrees of current center *****/
 	 if (Gbl.Hierarchy.Node[Hie_CTR].HieCod > 0)
-	   {
-	    /***** Get degrees belonging to the current center from database *****/
-	    NumDegs = Deg_DB_GetDegsOfCurrentCtrBasic (&mysql_res);
-
-	    /***** Get degrees of this center *****/
-	    for (NumDeg = 0;
-		 NumDeg < NumDegs;
-		 NumDeg++)
-	      {
-	       /* Get next degree */
-	       row = mysql_fetch_row (mysql_res);
-
-	       /* Get degree code (row[0]) */
-	       if ((HieCod = Str_ConvertStrCodToLongCod (row[0])) <= 0)
-		  Err_WrongDegreeExit ();
-
-	       /* Write option */
-	       HTM_OPTION (HTM_Type_LONG,&HieCod,
-			   Gbl.Hierarchy.Node[Hie_DEG].HieCod > 0 &&
-			   HieCod == Gbl.Hierarchy.Node[Hie_DEG].HieCod ? HTM_SELECTED :
-									  HTM_NO_ATTR,
-			   "%s",row[1]);
-	      }
-
-	    /***** Free structure that stores the query result *****/
-	    DB_FreeMySQLResult (&mysql_res);
-	   }
+	    Hie_WriteOptionsOfChildren (Hie_DEG,Gbl.Hierarchy.Node[Hie_DEG].HieCod);
 
       /***** End selector of degree *****/
       HTM_SELECT_End ();
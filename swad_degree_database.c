@@ -25,12 +25,17 @@
 /********************************* Headers ***********************************/
 /*****************************************************************************/
 
+#include <string.h>		// For strcmp
+
 #include "swad_database.h"
 #include "swad_degree_database.h"
 #include "swad_error.h"
 #include "swad_global.h"
 #include "swad_hierarchy.h"
 #include "swad_hierarchy_database.h"
+#include "swad_hierarchy_snapshot.h"
+#include "swad_name.h"
+#include "swad_search_index.h"
 
 /*****************************************************************************/
 /************** External global variables from others modules ****************/
@@ -71,6 +76,11 @@ void Deg_DB_CreateDegree (struct Hie_Node *Deg,Hie_Status_t Status)
 				Deg->ShrtName,
 				Deg->FullName,
 				Deg->WWW);
+
+   HieSnp_Invalidate ();
+
+   /***** Add full name to search index *****/
+   SchIdx_IndexName (SchIdx_DEG,Deg->HieCod,Deg->FullName);
   }
 
 /*****************************************************************************/
@@ -691,12 +701,20 @@ void Deg_DB_UpdateDegTypName (long DegTypCod,
 void Deg_DB_UpdateDegNameDB (long HieCod,
 			     const char *FldName,const char *NewDegName)
   {
+   extern const char *Nam_Fields[Nam_NUM_SHRT_FULL_NAMES];
+
    DB_QueryUPDATE ("can not update the name of a degree",
 		   "UPDATE deg_degrees"
 		     " SET %s='%s'"
 		   " WHERE DegCod=%ld",
 	           FldName,NewDegName,
 	           HieCod);
+
+   HieSnp_Invalidate ();
+
+   /***** Update full name in search index *****/
+   if (!strcmp (FldName,Nam_Fields[Nam_FULL_NAME]))
+      SchIdx_IndexName (SchIdx_DEG,HieCod,NewDegName);
   }
 
 /*****************************************************************************/
@@ -711,6 +729,8 @@ void Deg_DB_UpdateDegCtr (long HieCod,long NewCtrCod)
 		   " WHERE DegCod=%ld",
                    NewCtrCod,
                    HieCod);
+
+   HieSnp_Invalidate ();
   }
 
 /*****************************************************************************/
@@ -725,6 +745,8 @@ void Deg_DB_UpdateDegTyp (long HieCod,long NewDegTypCod)
 		   " WHERE DegCod=%ld",
 	           NewDegTypCod,
 	           HieCod);
+
+   HieSnp_Invalidate ();
   }
 
 /*****************************************************************************/
@@ -739,6 +761,8 @@ void Deg_DB_UpdateDegWWW (long HieCod,const char NewWWW[WWW_MAX_BYTES_WWW + 1])
 		   " WHERE DegCod=%ld",
 	           NewWWW,
 	           HieCod);
+
+   HieSnp_Invalidate ();
   }
 
 /*****************************************************************************/
@@ -753,6 +777,8 @@ void Deg_DB_UpdateDegStatus (long HieCod,Hie_Status_t NewStatus)
 		   " WHERE DegCod=%ld",
                    (unsigned) NewStatus,
                    HieCod);
+
+   HieSnp_Invalidate ();
   }
 
 /*****************************************************************************/
@@ -875,4 +901,9 @@ void Deg_DB_RemoveDeg (long HieCod)
 		   "DELETE FROM deg_degrees"
 		   " WHERE DegCod=%ld",
 		   HieCod);
+
+   HieSnp_Invalidate ();
+
+   /***** Remove full name from search index *****/
+   SchIdx_RemoveName (SchIdx_DEG,HieCod);
   }
@@ -40,6 +40,7 @@
 #include "swad_attendance_database.h"
 #include "swad_box.h"
 #include "swad_browser_database.h"
+#include "swad_connected.h"
 #include "swad_database.h"
 #include "swad_duplicate.h"
 #include "swad_enrolment.h"
@@ -52,11 +53,14 @@
 #include "swad_hierarchy.h"
 #include "swad_HTML.h"
 #include "swad_ID.h"
+#include "swad_ID_database.h"
 #include "swad_info_database.h"
 #include "swad_mail_database.h"
 #include "swad_match.h"
 #include "swad_message.h"
 #include "swad_message_database.h"
+#include "swad_nickname.h"
+#include "swad_nickname_database.h"
 #include "swad_notification.h"
 #include "swad_notification_database.h"
 #include "swad_parameter.h"
@@ -102,6 +106,38 @@ typedef enum
    Enr_REMOVE_USR_PRODUCTION,
   } Enr_RemoveUsrProduction_t;
 
+/* Type of string entered in the text area to enrol/remove users */
+#define Enr_NUM_USR_STR_TYPES 3
+typedef enum
+  {
+   Enr_USR_NICK  = 0,	// Nickname (stored without arrobas)
+   Enr_USR_EMAIL = 1,	// Email
+   Enr_USR_ID    = 2,	// User's ID (stored in capitals and without leading zeros)
+  } Enr_UsrStrType_t;
+
+struct Enr_UsrStr
+  {
+   Enr_UsrStrType_t Type;
+   char Str[Cns_MAX_BYTES_USR_LOGIN + 1];
+   unsigned NumUsrs;	// Number of users found for this string
+  };
+
+struct Enr_UsrFound
+  {
+   long UsrCod;
+   unsigned NumStr;	// Index of the string in the text area which found the user
+  };
+
+/* Nicknames, emails and IDs entered in the text area
+   and users found for them */
+struct Enr_UsrsInTextarea
+  {
+   unsigned NumStrs;		// Number of different strings entered
+   struct Enr_UsrStr *Strs;	// Sorted by type and string
+   unsigned NumUsrsFound;
+   struct Enr_UsrFound *UsrsFound;
+  };
+
 /*****************************************************************************/
 /************** External global variables from others modules ****************/
 /*****************************************************************************/
@@ -114,6 +150,13 @@ extern struct Globals Gbl;
 
 static Enr_EnrRemOneUsrAction_t Enr_EnrRemAction;
 
+static const Ntf_NotifyEvent_t Enr_NotifyEvent[Rol_NUM_ROLES] =
+  {
+   [Rol_STD] = Ntf_EVENT_ENROLMENT_STD,
+   [Rol_NET] = Ntf_EVENT_ENROLMENT_NET,
+   [Rol_TCH] = Ntf_EVENT_ENROLMENT_TCH,
+  };
+
 /*****************************************************************************/
 /***************************** Private prototypes ****************************/
 /*****************************************************************************/
@@ -122,6 +165,8 @@ static void Enr_EnrolUsrInCurrentCrs (struct Usr_Data *UsrDat,Rol_Role_t NewRole
 
 static void Enr_NotifyAfterEnrolment (const struct Usr_Data *UsrDat,
                                       Rol_Role_t NewRole);
+static void Enr_NotifyAfterEnrolmentOfUsrs (Rol_Role_t NewRole,
+					    const char *SubQueryUsrs);
 
 static void Enr_ReqAdminUsrs (Rol_Role_t Role);
 static void Enr_ShowFormEnrRemSeveralUsrs (Rol_Role_t Role);
@@ -130,22 +175,31 @@ static void Enr_PutUsrsClipboard (void);
 static void Enr_PutActionsEnrRemSeveralUsrs (void);
 
 static void Enr_ReceiveUsrsCrs (Rol_Role_t Role);
+static void Enr_GetUsrsInTextarea (const char *ListUsrsIDs,
+				   struct Enr_UsrsInTextarea *Usrs);
+static void Enr_GetUsrCodsFromUsrStrsOfType (struct Enr_UsrsInTextarea *Usrs,
+					     Enr_UsrStrType_t Type);
+static void Enr_FreeUsrsInTextarea (struct Enr_UsrsInTextarea *Usrs);
+static int Enr_CompareUsrStrs (const void *p1,const void *p2);
+static int Enr_CompareUsrCods (const void *p1,const void *p2);
+static void Enr_SortAndRemoveRepeatedUsrCods (struct Usr_ListCods *ListCods);
 static void Enr_InitializeLstUsrsToBeRemoved (Rol_Role_t Role,
 					      const struct Enr_WhatToDo *WhatToDo);
 static void Enr_UpdateLstUsrsToBeRemovedUsingTextarea (Rol_Role_t Role,
 						       const struct Enr_WhatToDo *WhatToDo,
-						       struct Usr_Data *UsrDat,
-						       char *ListUsrsIDs);
+						       const struct Enr_UsrsInTextarea *Usrs);
 static void Enr_UpdateLstUsrsToBeRemovedUsingSelectedUsrs (Rol_Role_t Role,
-							   const struct Enr_WhatToDo *WhatToDo,
-							   struct Usr_Data *UsrDat);
+							   const struct Enr_WhatToDo *WhatToDo);
+static void Enr_UpdateLstUsrsToBeRemovedUsingListCods (Rol_Role_t Role,
+						       const struct Enr_WhatToDo *WhatToDo,
+						       struct Usr_ListCods *ListCods);
 static void Enr_RemoveUsrsMarkedToBeRemoved (Rol_Role_t Role,
 					     const struct Enr_WhatToDo *WhatToDo,
 					     struct Usr_Data *UsrDat,
 					     struct ListCodGrps *LstGrps,
 					     unsigned *NumUsrsRemoved);
 static void Enr_EnrolUsrsFoundInTextarea (Rol_Role_t Role,
-					  char *ListUsrsIDs,
+					  const struct Enr_UsrsInTextarea *Usrs,
 					  struct Usr_Data *UsrDat,
 					  struct ListCodGrps *LstGrps,
 					  unsigned *NumUsrsEnroled);
@@ -153,6 +207,12 @@ static void Enr_EnrolSelectedUsrs (Rol_Role_t Role,
 				   struct Usr_Data *UsrDat,
 				   struct ListCodGrps *LstGrps,
 				   unsigned *NumUsrsEnroled);
+static void Enr_GetListSelectedUsrCods (struct Usr_ListCods *ListCods);
+static void Enr_EnrolUsrs (Rol_Role_t Role,
+			   struct Usr_ListCods *ListCods,
+			   struct Usr_Data *UsrDat,
+			   struct ListCodGrps *LstGrps,
+			   unsigned *NumUsrsEnroled);
 static void Enr_ShowMessageRemoved (unsigned NumUsrsRemoved,
 				    const struct Enr_WhatToDo *WhatToDo);
 static void Enr_ShowMessageEnroled (unsigned NumUsrsEnroled);
@@ -291,6 +351,7 @@ void Enr_ModifyRoleInCurrentCrs (struct Usr_Data *UsrDat,Rol_Role_t NewRole)
 
    /***** Flush caches *****/
    Usr_FlushCachesUsr ();
+   Con_FlushCrssOfUsr (UsrDat->UsrCod);
 
    /***** Set user's roles *****/
    UsrDat->Roles.InCurrentCrs = NewRole;
@@ -334,6 +395,7 @@ static void Enr_EnrolUsrInCurrentCrs (struct Usr_Data *UsrDat,Rol_Role_t NewRole
 
    /***** Flush caches *****/
    Usr_FlushCachesUsr ();
+   Con_FlushCrssOfUsr (UsrDat->UsrCod);
 
    /***** Set roles *****/
    UsrDat->Roles.InCurrentCrs = NewRole;
@@ -354,17 +416,11 @@ static void Enr_NotifyAfterEnrolment (const struct Usr_Data *UsrDat,
                                       Rol_Role_t NewRole)
   {
    extern Ntf_Status_t Ntf_Status[Ntf_NUM_NOTIFY_BY_EMAIL];
-   static Ntf_NotifyEvent_t NotifyEvent[Rol_NUM_ROLES] =
-     {
-      [Rol_STD] = Ntf_EVENT_ENROLMENT_STD,
-      [Rol_NET] = Ntf_EVENT_ENROLMENT_NET,
-      [Rol_TCH] = Ntf_EVENT_ENROLMENT_TCH,
-     };
    Ntf_NotifyByEmail_t NotifyByEmail;
    long HieCods[Hie_NUM_LEVELS];
 
    /***** Check if user's role is allowed *****/
-   if (!NotifyEvent[NewRole])
+   if (!Enr_NotifyEvent[NewRole])
       Err_WrongRoleExit ();
 
    /***** Remove possible enrolment request ******/
@@ -376,20 +432,122 @@ static void Enr_NotifyAfterEnrolment (const struct Usr_Data *UsrDat,
    Ntf_DB_MarkNotifToOneUsrAsRemoved (Ntf_EVENT_ENROLMENT_TCH,-1,UsrDat->UsrCod);
 
    /***** Create new notification ******/
-   if ((UsrDat->NtfEvents.CreateNotif & (1 << NotifyEvent[NewRole])))	// Create notification?
+   if ((UsrDat->NtfEvents.CreateNotif & (1 << Enr_NotifyEvent[NewRole])))	// Create notification?
      {
       NotifyByEmail = Usr_ItsMe (UsrDat->UsrCod) == Usr_OTHER &&
-		      (UsrDat->NtfEvents.SendEmail & (1 << NotifyEvent[NewRole])) ? Ntf_NOTIFY_BY_EMAIL :
+		      (UsrDat->NtfEvents.SendEmail & (1 << Enr_NotifyEvent[NewRole])) ? Ntf_NOTIFY_BY_EMAIL :
 										    Ntf_DONT_NOTIFY_BY_EMAIL;
       HieCods[Hie_INS] = Gbl.Hierarchy.Node[Hie_INS].HieCod;
       HieCods[Hie_CTR] = Gbl.Hierarchy.Node[Hie_CTR].HieCod;
       HieCods[Hie_DEG] = Gbl.Hierarchy.Node[Hie_DEG].HieCod;
       HieCods[Hie_CRS] = Gbl.Hierarchy.Node[Hie_CRS].HieCod;
-      Ntf_DB_StoreNotifyEventToUsr (NotifyEvent[NewRole],UsrDat->UsrCod,-1L,
+      Ntf_DB_StoreNotifyEventToUsr (Enr_NotifyEvent[NewRole],UsrDat->UsrCod,-1L,
 				    Ntf_Status[NotifyByEmail],HieCods);
      }
   }
 
+/*****************************************************************************/
+/***** Create notifications after enrolling several users in current course **/
+/*****************************************************************************/
+// SubQueryUsrs is a list of users' codes separated by commas
+
+static void Enr_NotifyAfterEnrolmentOfUsrs (Rol_Role_t NewRole,
+					    const char *SubQueryUsrs)
+  {
+   extern Ntf_Status_t Ntf_Status[Ntf_NUM_NOTIFY_BY_EMAIL];
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   unsigned NumRow;
+   unsigned NumRows;
+   long ReqCod;
+   long UsrCod;
+   unsigned CreateNotif;
+   unsigned SendEmail;
+   long *NtfUsrCods;
+   Ntf_Status_t *NtfStatus;
+   unsigned NumNtfs = 0;
+   Ntf_NotifyByEmail_t NotifyByEmail;
+   long HieCods[Hie_NUM_LEVELS];
+
+   /***** Check if users' role is allowed *****/
+   if (!Enr_NotifyEvent[NewRole])
+      Err_WrongRoleExit ();
+
+   /***** Remove possible enrolment requests ******/
+   NumRows = Enr_DB_GetUsrsEnrolmentRequestsInCrs (&mysql_res,SubQueryUsrs,
+						   Gbl.Hierarchy.Node[Hie_CRS].HieCod);
+   for (NumRow = 0;
+	NumRow < NumRows;
+	NumRow++)
+     {
+      row = mysql_fetch_row (mysql_res);
+      if ((ReqCod = Str_ConvertStrCodToLongCod (row[0])) > 0)
+	{
+	 /* Mark possible notifications as removed
+	    Important: do this before removing the request */
+	 Ntf_DB_MarkNotifAsRemoved (Ntf_EVENT_ENROLMENT_REQUEST,ReqCod);
+
+	 /* Remove enrolment request */
+	 Enr_DB_RemRequest (ReqCod);
+	}
+     }
+   DB_FreeMySQLResult (&mysql_res);
+
+   /***** Remove old enrolment notifications before inserting the new ones ******/
+   Ntf_DB_MarkNotifInCrsToUsrsAsRemoved (Ntf_EVENT_ENROLMENT_STD,SubQueryUsrs);
+   Ntf_DB_MarkNotifInCrsToUsrsAsRemoved (Ntf_EVENT_ENROLMENT_NET,SubQueryUsrs);
+   Ntf_DB_MarkNotifInCrsToUsrsAsRemoved (Ntf_EVENT_ENROLMENT_TCH,SubQueryUsrs);
+
+   /***** Create new notifications for users who want them ******/
+   if ((NumRows = Usr_DB_GetNtfEventsOfUsrs (&mysql_res,SubQueryUsrs)))
+     {
+      if ((NtfUsrCods = malloc ((size_t) NumRows * sizeof (*NtfUsrCods))) == NULL)
+	 Err_NotEnoughMemoryExit ();
+      if ((NtfStatus = malloc ((size_t) NumRows * sizeof (*NtfStatus))) == NULL)
+	 Err_NotEnoughMemoryExit ();
+
+      for (NumRow = 0;
+	   NumRow < NumRows;
+	   NumRow++)
+	{
+	 row = mysql_fetch_row (mysql_res);
+
+	 /* Get user's code (row[0]) */
+	 UsrCod = Str_ConvertStrCodToLongCod (row[0]);
+
+	 /* Get on which events the user wants to be notified inside the platform (row[1])
+	    and by email (row[2]) */
+	 if (sscanf (row[1],"%u",&CreateNotif) != 1)
+	    CreateNotif = (unsigned) -1;	// 0xFF..FF
+	 if (sscanf (row[2],"%u",&SendEmail) != 1)
+	    SendEmail = 0;
+	 if (SendEmail >= (1 << Ntf_NUM_NOTIFY_EVENTS))	// Maximum binary value for NotifyEvents is 000...0011...11
+	    SendEmail = 0;
+
+	 if ((CreateNotif & (1 << Enr_NotifyEvent[NewRole])))	// Create notification?
+	   {
+	    NotifyByEmail = Usr_ItsMe (UsrCod) == Usr_OTHER &&
+			    (SendEmail & (1 << Enr_NotifyEvent[NewRole])) ? Ntf_NOTIFY_BY_EMAIL :
+									    Ntf_DONT_NOTIFY_BY_EMAIL;
+	    NtfUsrCods[NumNtfs] = UsrCod;
+	    NtfStatus[NumNtfs++] = Ntf_Status[NotifyByEmail];
+	   }
+	}
+
+      HieCods[Hie_INS] = Gbl.Hierarchy.Node[Hie_INS].HieCod;
+      HieCods[Hie_CTR] = Gbl.Hierarchy.Node[Hie_CTR].HieCod;
+      HieCods[Hie_DEG] = Gbl.Hierarchy.Node[Hie_DEG].HieCod;
+      HieCods[Hie_CRS] = Gbl.Hierarchy.Node[Hie_CRS].HieCod;
+      Ntf_DB_StoreNotifyEventToUsrs (Enr_NotifyEvent[NewRole],
+				     NumNtfs,NtfUsrCods,-1L,NtfStatus,
+				     HieCods);
+
+      free (NtfStatus);
+      free (NtfUsrCods);
+     }
+   DB_FreeMySQLResult (&mysql_res);
+  }
+
 /*****************************************************************************/
 /****** Write a form to request another user's ID, @nickname or email ********/
 /*****************************************************************************/
@@ -987,6 +1145,7 @@ static void Enr_ReceiveUsrsCrs (Rol_Role_t Role)
    char *ListUsrsIDs;
    unsigned NumUsrsEnroled = 0;
    unsigned NumUsrsRemoved = 0;
+   struct Enr_UsrsInTextarea UsrsInTextarea;
    struct ListCodGrps LstGrps;
    struct Usr_Data UsrDat;
    Enr_EnrRemUsrsAction_t EnrRemUsrsAction;
@@ -1109,6 +1268,9 @@ static void Enr_ReceiveUsrsCrs (Rol_Role_t Role)
 	    Err_NotEnoughMemoryExit ();
 	 Par_GetParText ("UsrsIDs",ListUsrsIDs,ID__MAX_BYTES_LIST_USRS_IDS);
 
+	 /***** Get users from the list of IDs, nicks and emails *****/
+	 Enr_GetUsrsInTextarea (ListUsrsIDs,&UsrsInTextarea);
+
 	 /***** Get list of selected users if not already got *****/
 	 Usr_GetListsSelectedEncryptedUsrsCods (&Gbl.Usrs.Selected,
 						Usr_GET_LIST_ALL_USRS);
@@ -1131,12 +1293,11 @@ static void Enr_ReceiveUsrsCrs (Rol_Role_t Role)
 	       /* 2.1: Update list of users to be removed
 		       using the form with IDs, nicks and emails */
 	       Enr_UpdateLstUsrsToBeRemovedUsingTextarea (Role,&WhatToDo,
-							  &UsrDat,ListUsrsIDs);
+							  &UsrsInTextarea);
 
 	       /* 2.2: Update list of users to be removed
 		       using list of users selected from clipboard */
-	       Enr_UpdateLstUsrsToBeRemovedUsingSelectedUsrs (Role,&WhatToDo,
-							      &UsrDat);
+	       Enr_UpdateLstUsrsToBeRemovedUsingSelectedUsrs (Role,&WhatToDo);
 
 	       /* Loop 3: Go through list removing users */
 	       Enr_RemoveUsrsMarkedToBeRemoved (Role,&WhatToDo,
@@ -1154,7 +1315,7 @@ static void Enr_ReceiveUsrsCrs (Rol_Role_t Role)
 	 if (WhatToDo.EnrolUsrs)	// TODO: !!!!! NO CAMBIAR EL ROL DE LOS USUARIOS QUE YA ESTN EN LA ASIGNATURA SI HAY MS DE UN USUARIO ENCONTRADO PARA EL MISMO DNI !!!!!!
 	   {
 	    /* Enrol users found in the form with IDs, nicks and emails */
-	    Enr_EnrolUsrsFoundInTextarea (Role,ListUsrsIDs,&UsrDat,&LstGrps,&NumUsrsEnroled);
+	    Enr_EnrolUsrsFoundInTextarea (Role,&UsrsInTextarea,&UsrDat,&LstGrps,&NumUsrsEnroled);
 
 	    /* Enrol users selected from clipboard */
 	    Enr_EnrolSelectedUsrs (Role,&UsrDat,&LstGrps,&NumUsrsEnroled);
@@ -1169,6 +1330,9 @@ static void Enr_ReceiveUsrsCrs (Rol_Role_t Role)
 	 /***** Free memory used by list of selected users' codes *****/
 	 Usr_FreeListsSelectedEncryptedUsrsCods (&Gbl.Usrs.Selected);
 
+	 /***** Free memory used by the users got from the list of IDs *****/
+	 Enr_FreeUsrsInTextarea (&UsrsInTextarea);
+
 	 /***** Free memory used by the list of user's IDs *****/
 	 free (ListUsrsIDs);
 	 break;
@@ -1187,115 +1351,307 @@ static void Enr_ReceiveUsrsCrs (Rol_Role_t Role)
   }
 
 /*****************************************************************************/
-/******************** Initialize list of users to remove *********************/
+/********* Get users from the form with IDs, nicks and emails ****************/
 /*****************************************************************************/
+// All strings of the same type are searched in database with a single query
 
-static void Enr_InitializeLstUsrsToBeRemoved (Rol_Role_t Role,
-					      const struct Enr_WhatToDo *WhatToDo)
-  {
-   unsigned NumUsr;
-
-   for (NumUsr = 0;
-	NumUsr < Gbl.Usrs.LstUsrs[Role].NumUsrs;
-	NumUsr++)
-      Gbl.Usrs.LstUsrs[Role].Lst[NumUsr].Remove = !WhatToDo->RemoveSpecifiedUsrs;
-  }
-
-/*****************************************************************************/
-/*************** Update list of users to be removed        *******************/
-/*************** using the form with IDs, nicks and emails *******************/
-/*****************************************************************************/
-
-static void Enr_UpdateLstUsrsToBeRemovedUsingTextarea (Rol_Role_t Role,
-						       const struct Enr_WhatToDo *WhatToDo,
-						       struct Usr_Data *UsrDat,
-						       char *ListUsrsIDs)
+static void Enr_GetUsrsInTextarea (const char *ListUsrsIDs,
+				   struct Enr_UsrsInTextarea *Usrs)
   {
+   char Str[Cns_MAX_BYTES_USR_LOGIN + 1];
    const char *Ptr;
-   unsigned NumUsr;
-   unsigned NumUsrFound;
-   struct Usr_ListUsrCods ListUsrCods;	// List with users' codes for a given user's ID
+   unsigned MaxStrs;
+   unsigned NumStr;
+   unsigned NumStrs;
+   struct Enr_UsrStr *UsrStr;
+   Enr_UsrStrType_t Type;
+
+   /***** Reset lists *****/
+   Usrs->NumStrs      = 0;
+   Usrs->Strs         = NULL;
+   Usrs->NumUsrsFound = 0;
+   Usrs->UsrsFound    = NULL;
+
+   /***** Count strings in text area *****/
+   for (Ptr = ListUsrsIDs, MaxStrs = 0;
+        *Ptr;
+        MaxStrs++)
+      Str_GetNextStringUntilSeparator (&Ptr,Str,sizeof (Str) - 1);
+   if (!MaxStrs)
+      return;
+
+   /***** Allocate list of strings *****/
+   if ((Usrs->Strs = malloc ((size_t) MaxStrs * sizeof (*Usrs->Strs))) == NULL)
+      Err_NotEnoughMemoryExit ();
 
+   /***** Get strings, checking if each one is
+          a user's ID, a user's nickname or a user's email address *****/
    for (Ptr = ListUsrsIDs;
         *Ptr;
        )
      {
-      /* Reset user */
-      UsrDat->UsrCod = -1L;
-
-      /* Find next string in text */
-      Str_GetNextStringUntilSeparator (&Ptr,UsrDat->UsrIDNickOrEmail,
-				       sizeof (UsrDat->UsrIDNickOrEmail) - 1);
-
-      /* Reset default list of users' codes */
-      ListUsrCods.NumUsrs = 0;
-      ListUsrCods.Lst = NULL;
+      UsrStr = &Usrs->Strs[Usrs->NumStrs];
+      Str_GetNextStringUntilSeparator (&Ptr,UsrStr->Str,sizeof (UsrStr->Str) - 1);
+      UsrStr->NumUsrs = 0;
 
-      /* Check if string is a user's ID, user's nickname or user's email address */
-      switch (Nck_CheckIfNickWithArrIsValid (UsrDat->UsrIDNickOrEmail))
+      switch (Nck_CheckIfNickWithArrIsValid (UsrStr->Str))
 	{
 	 case Err_SUCCESS:		// 1: It's a nickname
-	    if ((UsrDat->UsrCod = Nck_GetUsrCodFromNickname (UsrDat->UsrIDNickOrEmail)) > 0)
-	      {
-	       ListUsrCods.NumUsrs = 1;
-	       Usr_AllocateListUsrCods (&ListUsrCods);
-	       ListUsrCods.Lst[0] = UsrDat->UsrCod;
-	      }
+	    UsrStr->Type = Enr_USR_NICK;
+	    Str_RemoveLeadingArrobas (UsrStr->Str);
+	    Usrs->NumStrs++;
 	    break;
 	 case Err_ERROR:
 	 default:
-	    switch (Mai_CheckIfEmailIsValid (UsrDat->UsrIDNickOrEmail))
+	    switch (Mai_CheckIfEmailIsValid (UsrStr->Str))
 	      {
 	       case Err_SUCCESS:	// 2: It's an email
-		  if ((UsrDat->UsrCod = Mai_DB_GetUsrCodFromEmail (UsrDat->UsrIDNickOrEmail)) > 0)
-		    {
-		     ListUsrCods.NumUsrs = 1;
-		     Usr_AllocateListUsrCods (&ListUsrCods);
-		     ListUsrCods.Lst[0] = UsrDat->UsrCod;
-		    }
+		  UsrStr->Type = Enr_USR_EMAIL;
+		  Usrs->NumStrs++;
 		  break;
-	       case Err_ERROR:	// 3: It looks like a user's ID
+	       case Err_ERROR:		// 3: It looks like a user's ID
 	       default:
 		  // Users' IDs are always stored internally in capitals and without leading zeros
-		  Str_RemoveLeadingZeros (UsrDat->UsrIDNickOrEmail);
-		  if (ID__CheckIfUsrIDSeemsAValidID (UsrDat->UsrIDNickOrEmail) == Err_SUCCESS)
+		  Str_RemoveLeadingZeros (UsrStr->Str);
+		  if (ID__CheckIfUsrIDSeemsAValidID (UsrStr->Str) == Err_SUCCESS)
 		    {
-		     /***** Find users for this user's ID *****/
-		     ID__ReallocateListIDs (UsrDat,1);	// Only one user's ID
-		     Str_Copy (UsrDat->IDs.List[0].ID,UsrDat->UsrIDNickOrEmail,
-			       sizeof (UsrDat->IDs.List[0].ID) - 1);
-		     Str_ConvertToUpperText (UsrDat->IDs.List[0].ID);
-		     ID__GetListUsrCodsFromUsrID (UsrDat,NULL,&ListUsrCods,ID__ANY);
+		     UsrStr->Type = Enr_USR_ID;
+		     Str_ConvertToUpperText (UsrStr->Str);
+		     Usrs->NumStrs++;
 		    }
 		  break;
 	      }
 	    break;
 	}
+     }
+
+   /***** Sort strings by type and string, and remove repeated ones *****/
+   qsort (Usrs->Strs,(size_t) Usrs->NumStrs,sizeof (*Usrs->Strs),
+          Enr_CompareUsrStrs);
+   for (NumStr = 1, NumStrs = Usrs->NumStrs ? 1 : 0;
+	NumStr < Usrs->NumStrs;
+	NumStr++)
+      if (Enr_CompareUsrStrs (&Usrs->Strs[NumStr],&Usrs->Strs[NumStrs - 1]))
+	 Usrs->Strs[NumStrs++] = Usrs->Strs[NumStr];
+   Usrs->NumStrs = NumStrs;
+
+   /***** Get users' codes for all strings of each type *****/
+   for (Type  = (Enr_UsrStrType_t) 0;
+	Type <= (Enr_UsrStrType_t) (Enr_NUM_USR_STR_TYPES - 1);
+	Type++)
+      Enr_GetUsrCodsFromUsrStrsOfType (Usrs,Type);
+  }
+
+/*****************************************************************************/
+/****** Get users' codes from all the strings of a type in the text area *****/
+/*****************************************************************************/
 
-      if (WhatToDo->RemoveSpecifiedUsrs)	// Remove the specified users (of the role)
+static void Enr_GetUsrCodsFromUsrStrsOfType (struct Enr_UsrsInTextarea *Usrs,
+					     Enr_UsrStrType_t Type)
+  {
+   static unsigned (*GetUsrCods[Enr_NUM_USR_STR_TYPES]) (MYSQL_RES **mysql_res,const char *Strs) =
+     {
+      [Enr_USR_NICK ] = Nck_DB_GetUsrCodsFromNicknames,
+      [Enr_USR_EMAIL] = Mai_DB_GetUsrCodsFromEmails,
+      [Enr_USR_ID   ] = ID__DB_GetUsrIDsAndUsrCodsFromUsrIDs,
+     };
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   struct Enr_UsrStr Key;
+   struct Enr_UsrStr *FirstStr = NULL;
+   struct Enr_UsrStr *UsrStr;
+   unsigned NumStr;
+   unsigned NumStrsOfType = 0;
+   unsigned NumRow;
+   unsigned NumRows;
+   char *SubQuery;
+   char *Ptr;
+
+   /***** Get range of strings of this type *****/
+   for (NumStr = 0;
+	NumStr < Usrs->NumStrs;
+	NumStr++)
+      if (Usrs->Strs[NumStr].Type == Type)
 	{
-	 if (ListUsrCods.NumUsrs == 1)		// If more than one user found ==> do not remove
-	    for (NumUsr = 0;
-		 NumUsr < Gbl.Usrs.LstUsrs[Role].NumUsrs;
-		 NumUsr++)
-	       if (Gbl.Usrs.LstUsrs[Role].Lst[NumUsr].UsrCod == ListUsrCods.Lst[0])	// User found
-		  Gbl.Usrs.LstUsrs[Role].Lst[NumUsr].Remove = true;	// Mark as removable
+	 if (!NumStrsOfType)
+	    FirstStr = &Usrs->Strs[NumStr];
+	 NumStrsOfType++;
 	}
-      else	// Remove all users (of the role) except these specified
+   if (!NumStrsOfType)
+      return;
+
+   /***** Build subquery with all strings of this type *****/
+   if ((SubQuery = malloc ((size_t) NumStrsOfType *
+			   (1 + 1 + Cns_MAX_BYTES_USR_LOGIN + 1) + 1)) == NULL)
+      Err_NotEnoughMemoryExit ();
+   for (NumStr = 0, Ptr = SubQuery;
+	NumStr < NumStrsOfType;
+	NumStr++)
+      Ptr += sprintf (Ptr,"%s'%s'",
+		      NumStr ? "," :
+			       "",
+		      FirstStr[NumStr].Str);
+
+   /***** Get strings and users' codes from database *****/
+   if ((NumRows = GetUsrCods[Type] (&mysql_res,SubQuery)))
+     {
+      if ((Usrs->UsrsFound = realloc (Usrs->UsrsFound,
+				      (size_t) (Usrs->NumUsrsFound + NumRows) *
+				      sizeof (*Usrs->UsrsFound))) == NULL)
+	 Err_NotEnoughMemoryExit ();
+
+      Key.Type = Type;
+      for (NumRow = 0;
+	   NumRow < NumRows;
+	   NumRow++)
 	{
-	 for (NumUsr = 0;
-	      NumUsr < Gbl.Usrs.LstUsrs[Role].NumUsrs;
-	      NumUsr++)
-	    for (NumUsrFound = 0;
-		 NumUsrFound < ListUsrCods.NumUsrs;
-		 NumUsrFound++)
-	       if (Gbl.Usrs.LstUsrs[Role].Lst[NumUsr].UsrCod == ListUsrCods.Lst[NumUsrFound])	// User found
-		  Gbl.Usrs.LstUsrs[Role].Lst[NumUsr].Remove = false;	// Mark as not removable
+	 row = mysql_fetch_row (mysql_res);
+
+	 /* Find the string (row[0]) which found this user */
+	 Str_Copy (Key.Str,row[0],sizeof (Key.Str) - 1);
+	 if ((UsrStr = bsearch (&Key,FirstStr,(size_t) NumStrsOfType,
+				sizeof (*FirstStr),Enr_CompareUsrStrs)) == NULL)
+	    continue;
+
+	 /* Only one user for a nickname or an email,
+	    but several users may have the same ID */
+	 if (Type != Enr_USR_ID && UsrStr->NumUsrs)
+	    continue;
+
+	 /* Get user's code (row[1]) */
+	 Usrs->UsrsFound[Usrs->NumUsrsFound].UsrCod = Str_ConvertStrCodToLongCod (row[1]);
+	 Usrs->UsrsFound[Usrs->NumUsrsFound].NumStr = (unsigned) (UsrStr - Usrs->Strs);
+	 Usrs->NumUsrsFound++;
+	 UsrStr->NumUsrs++;
 	}
+     }
+
+   /***** Free structure that stores the query result *****/
+   DB_FreeMySQLResult (&mysql_res);
+
+   /***** Free subquery *****/
+   free (SubQuery);
+  }
 
-      /* Free memory used for list of users' codes found for this ID */
-      Usr_FreeListUsrCods (&ListUsrCods);
+/*****************************************************************************/
+/*************** Free list of users found in the text area *******************/
+/*****************************************************************************/
+
+static void Enr_FreeUsrsInTextarea (struct Enr_UsrsInTextarea *Usrs)
+  {
+   if (Usrs->Strs)
+     {
+      free (Usrs->Strs);
+      Usrs->Strs = NULL;
      }
+   Usrs->NumStrs = 0;
+
+   if (Usrs->UsrsFound)
+     {
+      free (Usrs->UsrsFound);
+      Usrs->UsrsFound = NULL;
+     }
+   Usrs->NumUsrsFound = 0;
+  }
+
+/*****************************************************************************/
+/************** Compare strings entered in the text area *********************/
+/*****************************************************************************/
+// Nicknames, emails and IDs are compared case insensitively, as in database
+
+static int Enr_CompareUsrStrs (const void *p1,const void *p2)
+  {
+   const struct Enr_UsrStr *UsrStr1 = p1;
+   const struct Enr_UsrStr *UsrStr2 = p2;
+
+   if (UsrStr1->Type != UsrStr2->Type)
+      return UsrStr1->Type < UsrStr2->Type ? -1 :
+					      1;
+   return strcasecmp (UsrStr1->Str,UsrStr2->Str);
+  }
+
+/*****************************************************************************/
+/************************ Compare users' codes *******************************/
+/*****************************************************************************/
+
+static int Enr_CompareUsrCods (const void *p1,const void *p2)
+  {
+   long UsrCod1 = *((const long *) p1);
+   long UsrCod2 = *((const long *) p2);
+
+   return (UsrCod1 > UsrCod2) - (UsrCod1 < UsrCod2);
+  }
+
+/*****************************************************************************/
+/******************* Sort a list of users' codes            ******************/
+/******************* removing repeated and wrong codes      ******************/
+/*****************************************************************************/
+
+static void Enr_SortAndRemoveRepeatedUsrCods (struct Usr_ListCods *ListCods)
+  {
+   unsigned NumUsr;
+   unsigned NumUsrs;
+
+   qsort (ListCods->Lst,(size_t) ListCods->NumUsrs,sizeof (*ListCods->Lst),
+	  Enr_CompareUsrCods);
+   for (NumUsr = 0, NumUsrs = 0;
+	NumUsr < ListCods->NumUsrs;
+	NumUsr++)
+      if (ListCods->Lst[NumUsr] > 0)
+	 if (!NumUsrs || ListCods->Lst[NumUsr] != ListCods->Lst[NumUsrs - 1])
+	    ListCods->Lst[NumUsrs++] = ListCods->Lst[NumUsr];
+   ListCods->NumUsrs = NumUsrs;
+  }
+
+/*****************************************************************************/
+/******************** Initialize list of users to remove *********************/
+/*****************************************************************************/
+
+static void Enr_InitializeLstUsrsToBeRemoved (Rol_Role_t Role,
+					      const struct Enr_WhatToDo *WhatToDo)
+  {
+   unsigned NumUsr;
+
+   for (NumUsr = 0;
+	NumUsr < Gbl.Usrs.LstUsrs[Role].NumUsrs;
+	NumUsr++)
+      Gbl.Usrs.LstUsrs[Role].Lst[NumUsr].Remove = !WhatToDo->RemoveSpecifiedUsrs;
+  }
+
+/*****************************************************************************/
+/*************** Update list of users to be removed        *******************/
+/*************** using the form with IDs, nicks and emails *******************/
+/*****************************************************************************/
+
+static void Enr_UpdateLstUsrsToBeRemovedUsingTextarea (Rol_Role_t Role,
+						       const struct Enr_WhatToDo *WhatToDo,
+						       const struct Enr_UsrsInTextarea *Usrs)
+  {
+   struct Usr_ListCods ListCods;
+   unsigned NumUsrFound;
+
+   /***** Get users' codes to be marked *****/
+   ListCods.NumUsrs = 0;
+   ListCods.Lst = NULL;
+   if (Usrs->NumUsrsFound)
+     {
+      if ((ListCods.Lst = malloc ((size_t) Usrs->NumUsrsFound *
+				  sizeof (*ListCods.Lst))) == NULL)
+	 Err_NotEnoughMemoryExit ();
+      for (NumUsrFound = 0;
+	   NumUsrFound < Usrs->NumUsrsFound;
+	   NumUsrFound++)
+	 if (!WhatToDo->RemoveSpecifiedUsrs ||					// Remove all users (of the role) except these specified
+	     Usrs->Strs[Usrs->UsrsFound[NumUsrFound].NumStr].NumUsrs == 1)	// If more than one user found ==> do not remove
+	    ListCods.Lst[ListCods.NumUsrs++] = Usrs->UsrsFound[NumUsrFound].UsrCod;
+     }
+
+   /***** Mark users in list as removable / not removable *****/
+   Enr_UpdateLstUsrsToBeRemovedUsingListCods (Role,WhatToDo,&ListCods);
+
+   /***** Free list of users' codes *****/
+   if (ListCods.Lst)
+      free (ListCods.Lst);
   }
 
 /*****************************************************************************/
@@ -1304,26 +1660,45 @@ static void Enr_UpdateLstUsrsToBeRemovedUsingTextarea (Rol_Role_t Role,
 /*****************************************************************************/
 
 static void Enr_UpdateLstUsrsToBeRemovedUsingSelectedUsrs (Rol_Role_t Role,
-							   const struct Enr_WhatToDo *WhatToDo,
-							   struct Usr_Data *UsrDat)
+							   const struct Enr_WhatToDo *WhatToDo)
+  {
+   struct Usr_ListCods ListCods;
+
+   /***** Get list of selected users' codes *****/
+   Enr_GetListSelectedUsrCods (&ListCods);
+
+   /***** Mark users in list as removable / not removable *****/
+   Enr_UpdateLstUsrsToBeRemovedUsingListCods (Role,WhatToDo,&ListCods);
+
+   /***** Free list of users' codes *****/
+   Usr_FreeListSelectedUsrCods (&ListCods);
+  }
+
+/*****************************************************************************/
+/************** Update list of users to be removed          ******************/
+/************** using a list of users' codes                ******************/
+/*****************************************************************************/
+
+static void Enr_UpdateLstUsrsToBeRemovedUsingListCods (Rol_Role_t Role,
+						       const struct Enr_WhatToDo *WhatToDo,
+						       struct Usr_ListCods *ListCods)
   {
-   const char *Ptr;
    unsigned NumUsr;
 
-   for (Ptr = Gbl.Usrs.Selected.List[Rol_UNK];
-        *Ptr;
-       )
-     {
-      Par_GetNextStrUntilSeparParMult (&Ptr,UsrDat->EnUsrCod,
-				       Cry_BYTES_ENCRYPTED_STR_SHA256_BASE64);
-      Usr_GetUsrCodFromEncryptedUsrCod (UsrDat);
-      if (UsrDat->UsrCod > 0)
-	 for (NumUsr = 0;
-	      NumUsr < Gbl.Usrs.LstUsrs[Role].NumUsrs;
-	      NumUsr++)
-	    if (Gbl.Usrs.LstUsrs[Role].Lst[NumUsr].UsrCod == UsrDat->UsrCod)	// User found
-	       Gbl.Usrs.LstUsrs[Role].Lst[NumUsr].Remove = WhatToDo->RemoveSpecifiedUsrs;
-     }
+   if (!ListCods->NumUsrs)
+      return;
+
+   /***** Sort users' codes to find users in list quickly *****/
+   Enr_SortAndRemoveRepeatedUsrCods (ListCods);
+
+   /***** Go through list of users of the role *****/
+   for (NumUsr = 0;
+	NumUsr < Gbl.Usrs.LstUsrs[Role].NumUsrs;
+	NumUsr++)
+      if (bsearch (&Gbl.Usrs.LstUsrs[Role].Lst[NumUsr].UsrCod,
+		   ListCods->Lst,(size_t) ListCods->NumUsrs,sizeof (*ListCods->Lst),
+		   Enr_CompareUsrCods))	// User found
+	 Gbl.Usrs.LstUsrs[Role].Lst[NumUsr].Remove = WhatToDo->RemoveSpecifiedUsrs;
   }
 
 /*****************************************************************************/
@@ -1388,91 +1763,48 @@ static void Enr_RemoveUsrsMarkedToBeRemoved (Rol_Role_t Role,
 /*****************************************************************************/
 
 static void Enr_EnrolUsrsFoundInTextarea (Rol_Role_t Role,
-					  char *ListUsrsIDs,
+					  const struct Enr_UsrsInTextarea *Usrs,
 					  struct Usr_Data *UsrDat,
 					  struct ListCodGrps *LstGrps,
 					  unsigned *NumUsrsEnroled)
   {
-   const char *Ptr;
-   bool ItLooksLikeAUsrID;
-   struct Usr_ListUsrCods ListUsrCods;	// List with users' codes for a given user's ID
+   struct Usr_ListCods ListCods;
    unsigned NumUsrFound;
+   unsigned NumStr;
 
-   /***** Get users from a list of users' IDs ******/
-   for (Ptr = ListUsrsIDs;
-        *Ptr;
-       )
+   /***** Enrol all users found at once *****/
+   if (Usrs->NumUsrsFound)
      {
-      /* Reset user */
-      UsrDat->UsrCod = -1L;
-      ItLooksLikeAUsrID = false;
-
-      /* Find next string in text */
-      Str_GetNextStringUntilSeparator (&Ptr,UsrDat->UsrIDNickOrEmail,
-				       sizeof (UsrDat->UsrIDNickOrEmail) - 1);
-
-      /* Reset default list of users' codes */
-      ListUsrCods.NumUsrs = 0;
-      ListUsrCods.Lst = NULL;
+      /* Get list of users' codes found */
+      ListCods.NumUsrs = Usrs->NumUsrsFound;
+      if ((ListCods.Lst = malloc ((size_t) ListCods.NumUsrs *
+				  sizeof (*ListCods.Lst))) == NULL)
+	 Err_NotEnoughMemoryExit ();
+      for (NumUsrFound = 0;
+	   NumUsrFound < Usrs->NumUsrsFound;
+	   NumUsrFound++)
+	 ListCods.Lst[NumUsrFound] = Usrs->UsrsFound[NumUsrFound].UsrCod;
+
+      /* Enrol users */
+      Enr_EnrolUsrs (Role,&ListCods,UsrDat,LstGrps,NumUsrsEnroled);
+
+      /* Free list of users' codes */
+      free (ListCods.Lst);
+     }
 
-      /* Check if the string is a user's ID, a user's nickname or a user's email address */
-      switch (Nck_CheckIfNickWithArrIsValid (UsrDat->UsrIDNickOrEmail))
+   /***** Users' IDs not found belong to new users. Enrol them using ID *****/
+   for (NumStr = 0;
+	NumStr < Usrs->NumStrs;
+	NumStr++)
+      if (Usrs->Strs[NumStr].Type == Enr_USR_ID &&
+	  !Usrs->Strs[NumStr].NumUsrs)
 	{
-	 case Err_SUCCESS:		// 1: It's a nickname
-	    if ((UsrDat->UsrCod = Nck_GetUsrCodFromNickname (UsrDat->UsrIDNickOrEmail)) > 0)
-	      {
-	       ListUsrCods.NumUsrs = 1;
-	       Usr_AllocateListUsrCods (&ListUsrCods);
-	       ListUsrCods.Lst[0] = UsrDat->UsrCod;
-	      }
-	    break;
-	 case Err_ERROR:
-	 default:
-	    switch (Mai_CheckIfEmailIsValid (UsrDat->UsrIDNickOrEmail))
-	      {
-	       case Err_SUCCESS:	// 2: It's an email
-		  if ((UsrDat->UsrCod = Mai_DB_GetUsrCodFromEmail (UsrDat->UsrIDNickOrEmail)) > 0)
-		    {
-		     ListUsrCods.NumUsrs = 1;
-		     Usr_AllocateListUsrCods (&ListUsrCods);
-		     ListUsrCods.Lst[0] = UsrDat->UsrCod;
-		    }
-		  break;
-	       case Err_ERROR:		// 3: It looks like a user's ID
-	       default:
-		  // Users' IDs are always stored internally in capitals and without leading zeros
-		  Str_RemoveLeadingZeros (UsrDat->UsrIDNickOrEmail);
-		  if (ID__CheckIfUsrIDSeemsAValidID (UsrDat->UsrIDNickOrEmail) == Err_SUCCESS)
-		    {
-		     ItLooksLikeAUsrID = true;
-
-		     /* Find users for this user's ID */
-		     ID__ReallocateListIDs (UsrDat,1);	// Only one user's ID
-		     Str_Copy (UsrDat->IDs.List[0].ID,UsrDat->UsrIDNickOrEmail,
-			       sizeof (UsrDat->IDs.List[0].ID) - 1);
-		     Str_ConvertToUpperText (UsrDat->IDs.List[0].ID);
-		     ID__GetListUsrCodsFromUsrID (UsrDat,NULL,&ListUsrCods,ID__ANY);
-		    }
-		  break;
-	      }
-	    break;
-	}
-
-      /* Enrol user(s) */
-      if (ListUsrCods.NumUsrs)	// User(s) found
-	 for (NumUsrFound = 0;
-	      NumUsrFound < ListUsrCods.NumUsrs;
-	      NumUsrFound++)
-	   {
-	    UsrDat->UsrCod = ListUsrCods.Lst[NumUsrFound];
-	    Enr_EnrolUsr (UsrDat,Role,LstGrps,NumUsrsEnroled);
-	   }
-      else if (ItLooksLikeAUsrID)	// User not found. He/she is a new user. Enrol him/her using ID
+	 UsrDat->UsrCod = -1L;
+	 ID__ReallocateListIDs (UsrDat,1);	// Only one user's ID
+	 Str_Copy (UsrDat->IDs.List[0].ID,Usrs->Strs[NumStr].Str,
+		   sizeof (UsrDat->IDs.List[0].ID) - 1);
 	 Enr_EnrolUsr (UsrDat,Role,LstGrps,NumUsrsEnroled);
-
-      /* Free memory used for list of users' codes found for this ID */
-      Usr_FreeListUsrCods (&ListUsrCods);
-     }
+	}
   }
 
 /*****************************************************************************/
@@ -1484,18 +1816,162 @@ static void Enr_EnrolSelectedUsrs (Rol_Role_t Role,
 				   struct ListCodGrps *LstGrps,
 				   unsigned *NumUsrsEnroled)
   {
-   const char *Ptr;
+   struct Usr_ListCods ListCods;
 
-   for (Ptr = Gbl.Usrs.Selected.List[Rol_UNK];
-        *Ptr;
-       )
+   /***** Get list of selected users' codes *****/
+   Enr_GetListSelectedUsrCods (&ListCods);
+
+   /***** Enrol users *****/
+   Enr_EnrolUsrs (Role,&ListCods,UsrDat,LstGrps,NumUsrsEnroled);
+
+   /***** Free list of users' codes *****/
+   if (ListCods.Lst)
+      free (ListCods.Lst);
+  }
+
+/*****************************************************************************/
+/******************* Get list of users selected from clipboard ***************/
+/*****************************************************************************/
+
+static void Enr_GetListSelectedUsrCods (struct Usr_ListCods *ListCods)
+  {
+   ListCods->Lst = NULL;
+   if ((ListCods->NumUsrs = Usr_CountNumUsrsInListOfSelectedEncryptedUsrCods (&Gbl.Usrs.Selected)))
+      Usr_GetListSelectedUsrCods (&Gbl.Usrs.Selected,ListCods);
+  }
+
+/*****************************************************************************/
+/************ Enrol several existing users in the current course *************/
+/*****************************************************************************/
+// Users not belonging to the course are inserted with a few queries for all,
+// regardless of the number of users.
+// Only users already in the course whose role must be changed,
+// or all users if there are groups in the course, are processed one by one.
+
+static void Enr_EnrolUsrs (Rol_Role_t Role,
+			   struct Usr_ListCods *ListCods,
+			   struct Usr_Data *UsrDat,
+			   struct ListCodGrps *LstGrps,
+			   unsigned *NumUsrsEnroled)
+  {
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   unsigned NumRow;
+   unsigned NumRows;
+   long UsrCod;
+   const long *FoundUsrCod;
+   Rol_Role_t *Roles;
+   struct Usr_ListCods NewUsrs;
+   char *SubQueryUsrs;
+   unsigned NumUsr;
+
+   /***** Check if I can enrol these users *****/
+   if (Gbl.Usrs.Me.Role.Logged == Rol_TCH &&	// A teacher only can enrol several users...
+       !(Role == Rol_STD ||			// ...as students...
+	 Role == Rol_NET))			// ...or non-editing teachers
+      Err_NoPermissionExit ();
+
+   /***** Remove repeated users *****/
+   Enr_SortAndRemoveRepeatedUsrCods (ListCods);
+   if (!ListCods->NumUsrs)
+      return;
+
+   /***** Enrol users in current course in database *****/
+   if (Gbl.Hierarchy.HieLvl == Hie_CRS)	// Course selected
      {
-      Par_GetNextStrUntilSeparParMult (&Ptr,UsrDat->EnUsrCod,
-				       Cry_BYTES_ENCRYPTED_STR_SHA256_BASE64);
-      Usr_GetUsrCodFromEncryptedUsrCod (UsrDat);
-      if (UsrDat->UsrCod > 0)
-	 Enr_EnrolUsr (UsrDat,Role,LstGrps,NumUsrsEnroled);
+      /***** Trivial check: check if users' role is allowed *****/
+      switch (Role)
+	{
+	 case Rol_STD:
+	 case Rol_NET:
+	 case Rol_TCH:
+	    break;
+	 default:
+	    Err_WrongRoleExit ();
+	}
+
+      /***** Get current roles in course of these users *****/
+      if ((Roles = malloc ((size_t) ListCods->NumUsrs * sizeof (*Roles))) == NULL)
+	 Err_NotEnoughMemoryExit ();
+      for (NumUsr = 0;
+	   NumUsr < ListCods->NumUsrs;
+	   NumUsr++)
+	 Roles[NumUsr] = Rol_UNK;	// Does not belong to course
+
+      Usr_CreateSubqueryUsrCods (ListCods,&SubQueryUsrs);
+      NumRows = Enr_DB_GetRolesOfUsrsInCurrentCrs (&mysql_res,SubQueryUsrs);
+      for (NumRow = 0;
+	   NumRow < NumRows;
+	   NumRow++)
+	{
+	 row = mysql_fetch_row (mysql_res);
+
+	 /* Get user's code (row[0]) and role (row[1]) */
+	 UsrCod = Str_ConvertStrCodToLongCod (row[0]);
+	 if ((FoundUsrCod = bsearch (&UsrCod,ListCods->Lst,(size_t) ListCods->NumUsrs,
+				     sizeof (*ListCods->Lst),Enr_CompareUsrCods)))
+	    Roles[FoundUsrCod - ListCods->Lst] = Rol_ConvertUnsignedStrToRole (row[1]);
+	}
+      DB_FreeMySQLResult (&mysql_res);
+      Usr_FreeSubqueryUsrCods (SubQueryUsrs);
+
+      /***** Enrol users not belonging to the course *****/
+      if ((NewUsrs.Lst = malloc ((size_t) ListCods->NumUsrs *
+				 sizeof (*NewUsrs.Lst))) == NULL)
+	 Err_NotEnoughMemoryExit ();
+      for (NumUsr = 0, NewUsrs.NumUsrs = 0;
+	   NumUsr < ListCods->NumUsrs;
+	   NumUsr++)
+	 if (Roles[NumUsr] == Rol_UNK)
+	    NewUsrs.Lst[NewUsrs.NumUsrs++] = ListCods->Lst[NumUsr];
+      if (NewUsrs.NumUsrs)
+	{
+	 Usr_CreateSubqueryUsrCods (&NewUsrs,&SubQueryUsrs);
+
+	 /* Enrol users in current course in database */
+	 Enr_DB_InsertUsrsInCurrentCrs (SubQueryUsrs,Role);
+	 Con_FlushCrssOfAllUsrs ();
+
+	 /* Create last prefs in current course in database */
+	 Set_DB_InsertUsrsInCrsSettings (SubQueryUsrs,Gbl.Hierarchy.Node[Hie_CRS].HieCod);
+
+	 /* Create notifications for these users */
+	 Enr_NotifyAfterEnrolmentOfUsrs (Role,SubQueryUsrs);
+
+	 Usr_FreeSubqueryUsrCods (SubQueryUsrs);
+	}
+      free (NewUsrs.Lst);
+
+      /***** Flush caches *****/
+      Usr_FlushCachesUsr ();
+
+      /***** Modify role of users already in the course
+             and enrol users in the selected groups *****/
+      for (NumUsr = 0;
+	   NumUsr < ListCods->NumUsrs;
+	   NumUsr++)
+	 if ((Roles[NumUsr] != Rol_UNK && Roles[NumUsr] != Role) ||
+	     Gbl.Crs.Grps.NumGrps)	// If there are groups in the course
+	   {
+	    /* Get user's data */
+	    UsrDat->UsrCod = ListCods->Lst[NumUsr];
+	    Usr_GetAllUsrDataFromUsrCod (UsrDat,
+					 Usr_DONT_GET_PREFS,
+					 Usr_GET_ROLE_IN_CRS);
+
+	    /* Modify role */
+	    if (Roles[NumUsr] != Rol_UNK && Roles[NumUsr] != Role)	// The role must be updated
+	       Enr_ModifyRoleInCurrentCrs (UsrDat,Role);
+
+	    /* Enrol user in the selected groups */
+	    if (Gbl.Crs.Grps.NumGrps)
+	       Grp_EnrolUsrIntoGroups (UsrDat,Role,LstGrps);
+	   }
+
+      free (Roles);
      }
+
+   (*NumUsrsEnroled) += ListCods->NumUsrs;
   }
 
 /*****************************************************************************/
@@ -3580,6 +4056,7 @@ static void Enr_EffectivelyRemUsrFromCrs (struct Usr_Data *UsrDat,
 
 	 /***** Flush caches *****/
 	 Usr_FlushCachesUsr ();
+	 Con_FlushCrssOfUsr (UsrDat->UsrCod);
 
 	 /***** If it's me, change my roles *****/
 	 switch (Usr_ItsMe (UsrDat->UsrCod))
@@ -53,6 +53,44 @@ void Enr_DB_InsertUsrInCurrentCrs (long UsrCod,Rol_Role_t NewRole)
 	           (unsigned) NewRole);
   }
 
+/*****************************************************************************/
+/*********** Register several users in current course in database ************/
+/*****************************************************************************/
+// SubQueryUsrs is a list of users' codes separated by commas
+// Before calling this function, you must be sure that
+// the users do not belong to the current course
+
+void Enr_DB_InsertUsrsInCurrentCrs (const char *SubQueryUsrs,Rol_Role_t NewRole)
+  {
+   DB_QueryINSERT ("can not register users in course",
+		   "INSERT INTO crs_users"
+		   " (CrsCod,UsrCod,Role,Accepted)"
+		   " SELECT %ld,UsrCod,%u,'N'"
+		     " FROM usr_data"
+		    " WHERE UsrCod IN (%s)",
+	           Gbl.Hierarchy.Node[Hie_CRS].HieCod,
+	           (unsigned) NewRole,
+	           SubQueryUsrs);
+  }
+
+/*****************************************************************************/
+/******** Get roles in current course of those users who belong to it ********/
+/*****************************************************************************/
+// SubQueryUsrs is a list of users' codes separated by commas
+
+unsigned Enr_DB_GetRolesOfUsrsInCurrentCrs (MYSQL_RES **mysql_res,const char *SubQueryUsrs)
+  {
+   return (unsigned)
+   DB_QuerySELECT (mysql_res,"can not get roles of users in course",
+		   "SELECT UsrCod,"	// row[0]
+			  "Role"	// row[1]
+		    " FROM crs_users"
+		   " WHERE CrsCod=%ld"
+		     " AND UsrCod IN (%s)",
+		   Gbl.Hierarchy.Node[Hie_CRS].HieCod,
+		   SubQueryUsrs);
+  }
+
 /*****************************************************************************/
 /********* Set a user's acceptation to true in the current course ************/
 /*****************************************************************************/
@@ -1628,6 +1666,24 @@ long Enr_DB_GetUsrEnrolmentRequestInCrs (long UsrCod,long HieCod)
 		       UsrCod);
   }
 
+/*****************************************************************************/
+/*********** Get enrolment requests from several users in a course ***********/
+/*****************************************************************************/
+// SubQueryUsrs is a list of users' codes separated by commas
+
+unsigned Enr_DB_GetUsrsEnrolmentRequestsInCrs (MYSQL_RES **mysql_res,
+					       const char *SubQueryUsrs,long HieCod)
+  {
+   return (unsigned)
+   DB_QuerySELECT (mysql_res,"can not get enrolment requests",
+		   "SELECT ReqCod"	// row[0]
+		    " FROM crs_requests"
+		   " WHERE CrsCod=%ld"
+		     " AND UsrCod IN (%s)",
+		   HieCod,
+		   SubQueryUsrs);
+  }
+
 /*****************************************************************************/
 /************************** Remove enrolment request *************************/
 /*****************************************************************************/
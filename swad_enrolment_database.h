@@ -36,6 +36,8 @@
 
 //------------------------------ Users in courses -----------------------------
 void Enr_DB_InsertUsrInCurrentCrs (long UsrCod,Rol_Role_t NewRole);
+void Enr_DB_InsertUsrsInCurrentCrs (const char *SubQueryUsrs,Rol_Role_t NewRole);
+unsigned Enr_DB_GetRolesOfUsrsInCurrentCrs (MYSQL_RES **mysql_res,const char *SubQueryUsrs);
 void Enr_DB_AcceptUsrInCrs (long UsrCod,long HieCod);
 
 void Enr_DB_CreateTmpTableMyCourses (void);
@@ -74,6 +76,8 @@ unsigned Enr_DB_GetEnrolmentRequests (MYSQL_RES **mysql_res,
 				      Hie_Level_t HieLvl,unsigned RolesSelected);
 Exi_Exist_t Enr_DB_GetEnrolmentRequestByCod (MYSQL_RES **mysql_res,long ReqCod);
 long Enr_DB_GetUsrEnrolmentRequestInCrs (long UsrCod,long HieCod);
+unsigned Enr_DB_GetUsrsEnrolmentRequestsInCrs (MYSQL_RES **mysql_res,
+					       const char *SubQueryUsrs,long HieCod);
 
 void Enr_DB_RemRequest (long ReqCod);
 void Enr_DB_RemCrsRequests (long HieCod);
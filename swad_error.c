@@ -32,8 +32,11 @@
 #include "swad_error.h"
 #include "swad_global.h"
 #include "swad_layout.h"
+#include "swad_load.h"
 #include "swad_log.h"
+#include "swad_page_cache.h"
 #include "swad_statistic.h"
+#include "swad_trace.h"
 
 /*****************************************************************************/
 /************** External global variables from others modules ****************/
@@ -41,6 +44,12 @@
 
 extern struct Globals Gbl;
 
+/*****************************************************************************/
+/***************************** Private prototypes ****************************/
+/*****************************************************************************/
+
+static void Err_SendPendingOutput (FILE *FileOut);
+
 /*****************************************************************************/
 /********** Write error message and exit when not enough memory **************/
 /*****************************************************************************/
@@ -618,21 +627,28 @@ void Err_ShowErrorAndExit (const char *Txt)
    /***** Page is generated (except </body> and </html>).
           Compute time to generate page *****/
    if (!Gbl.Action.IsAJAXAutoRefresh)
+     {
       Dat_ComputeTimeToGeneratePage ();
+      Loa_UpdateAvgTimeToGenerate (Dat_GetTimeGenerationInMicroseconds ());
+     }
 
    if (Gbl.WebService.IsWebService)		// Serving a plugin request
+     {
       /***** Log access *****/
+      Trc_BeginSpan ("main","Log_LogAccess");
       Log_LogAccess (Txt);
+      Trc_EndSpan ();
+     }
    else
      {
       /***** Send page.
              The HTML output is now in output file ==>
-             ==> copy it to standard output *****/
+             ==> copy it to standard output.
+             Output file is kept open to write the end of the page *****/
       FileOut = Fil_GetOutputFile ();
-      rewind (FileOut);
-      Fil_FastCopyOfOpenFiles (FileOut,stdout);
-      Fil_CloseAndRemoveFileForHTMLOutput ();
-      // Now output file is stdout
+      Trc_BeginSpan ("main","Fil_FastCopyOfOpenFiles");
+      Err_SendPendingOutput (FileOut);
+      Trc_EndSpan ();
 
       if (!Gbl.Action.IsAJAXAutoRefresh)
 	{
@@ -640,7 +656,9 @@ void Err_ShowErrorAndExit (const char *Txt)
 	 Dat_ComputeTimeToSendPage ();
 
 	 /***** Log access *****/
+	 Trc_BeginSpan ("main","Log_LogAccess");
 	 Log_LogAccess (Txt);
+	 Trc_EndSpan ();
 
 	 /***** Update last data for next time *****/
 	 if (Gbl.Usrs.Me.Logged)
@@ -658,15 +676,42 @@ void Err_ShowErrorAndExit (const char *Txt)
 	    HTM_Txt ("</body>\n"
 		     "</html>\n");
 	    Lay_SetLayoutStatus (Lay_HTML_END_WRITTEN);
+	    Err_SendPendingOutput (FileOut);
 	   }
 	}
+
+      /***** Store the whole page in cache, including its end *****/
+      if (!Txt)
+	 PagCac_StoreCurrentPage (FileOut);
+      Fil_CloseAndRemoveFileForHTMLOutput ();
      }
 
    /***** Close database connection *****/
    DB_CloseDBConnection ();
 
+   /***** Write tracing spans of this request *****/
+   Trc_WriteSpans ();
+
    /***** Exit *****/
    if (Gbl.WebService.IsWebService)
       API_Exit (Txt);
    exit (0);
   }
+
+/*****************************************************************************/
+/******* Copy to standard output the part of output file not sent yet ********/
+/*****************************************************************************/
+// Output file remains open and positioned at its end to continue writing
+
+static void Err_SendPendingOutput (FILE *FileOut)
+  {
+   static long NumBytesSent = 0L;
+
+   if (FileOut == NULL || FileOut == stdout)	// Output is written directly
+      return;
+
+   fseek (FileOut,NumBytesSent,SEEK_SET);
+   Fil_FastCopyOfOpenFiles (FileOut,stdout);
+   fseek (FileOut,0L,SEEK_END);
+   NumBytesSent = ftell (FileOut);
+  }
@@ -934,11 +934,14 @@ unsigned Exa_DB_GetQstsFromSet (MYSQL_RES **mysql_res,long SetCod)
   }
 
 /*****************************************************************************/
-/******************* Get some random questions from a set ********************/
+/************ Get candidate questions from a set to draw a print *************/
 /*****************************************************************************/
 
-unsigned Exa_DB_GetSomeQstsFromSetToPrint (MYSQL_RES **mysql_res,
-                                           long SetCod,unsigned NumQstsToPrint)
+// The random sample is drawn in ExaPrn_GetSomeQstsFromSetToPrint.
+// Rows are always got in the same order,
+// so the same seed draws the same questions.
+
+unsigned Exa_DB_GetQstsFromSetToPrint (MYSQL_RES **mysql_res,long SetCod)
   {
    return (unsigned)
    DB_QuerySELECT (mysql_res,"can not get questions from set",
@@ -947,10 +950,8 @@ unsigned Exa_DB_GetSomeQstsFromSetToPrint (MYSQL_RES **mysql_res,
 			  "Shuffle"	// row[2]
 		    " FROM exa_set_questions"
 		   " WHERE SetCod=%ld"
-		" ORDER BY RAND()"	// Don't use RAND(NOW()) because the same ordering will be repeated across sets
-		   " LIMIT %u",
-		   SetCod,
-		   NumQstsToPrint);
+		" ORDER BY QstCod",
+		   SetCod);
   }
 
 /*****************************************************************************/
@@ -1857,15 +1858,16 @@ long Exa_DB_CreatePrint (const struct ExaPrn_Print *Print,
    DB_QueryINSERTandReturnCode ("can not create new exam print",
 				"INSERT INTO exa_prints"
 				" (SesCod,UsrCod,StartTime,EndTime,"
-				  "NumQsts,NumQstsNotBlank,Score)"
+				  "NumQsts,NumQstsNotBlank,Score,Seed)"
 				" VALUES"
 				" (%ld,%ld,%s,%s,"
-				  "%u,0,0)",
+				  "%u,0,0,%llu)",
 				Print->SesCod,
 				Print->UsrCod,
 				TimeStr[UpdateDates],
 				TimeStr[UpdateDates],
-				Print->NumQsts.All);
+				Print->NumQsts.All,
+				Print->Seed);
   }
 
 /*****************************************************************************/
@@ -1922,7 +1924,8 @@ Exi_Exist_t Exa_DB_GetPrintDataByPrnCod (MYSQL_RES **mysql_res,long PrnCod)
 				"UNIX_TIMESTAMP(EndTime),"	// row[4]
 				"NumQsts,"			// row[5]
 				"NumQstsNotBlank,"		// row[6]
-				"Score"				// row[7]
+				"Score,"			// row[7]
+				"Seed"				// row[8]
 			  " FROM exa_prints"
 			 " WHERE PrnCod=%ld",
 			 PrnCod);
@@ -1944,7 +1947,8 @@ Exi_Exist_t Exa_DB_GetPrintDataBySesCodAndUsrCod (MYSQL_RES **mysql_res,
 				"UNIX_TIMESTAMP(EndTime),"	// row[4]
 				"NumQsts,"			// row[5]
 				"NumQstsNotBlank,"		// row[6]
-				"Score"				// row[7]
+				"Score,"			// row[7]
+				"Seed"				// row[8]
 			  " FROM exa_prints"
 			 " WHERE SesCod=%ld"
 			   " AND UsrCod=%ld",
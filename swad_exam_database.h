@@ -83,8 +83,7 @@ void Exa_DB_ChangeValidityQst (long QstCod,long SetCod,long ExaCod,long HieCod,
                                ExaSet_Validity_t Validity);
 unsigned Exa_DB_GetNumQstsInSet (long SetCod);
 unsigned Exa_DB_GetQstsFromSet (MYSQL_RES **mysql_res,long SetCod);
-unsigned Exa_DB_GetSomeQstsFromSetToPrint (MYSQL_RES **mysql_res,
-                                           long SetCod,unsigned NumQstsToPrint);
+unsigned Exa_DB_GetQstsFromSetToPrint (MYSQL_RES **mysql_res,long SetCod);
 Exi_Exist_t Exa_DB_GetQstDataByCod (MYSQL_RES **mysql_res,long QstCod);
 Exi_Exist_t Exa_DB_GetValidityAndAnswerType (MYSQL_RES **mysql_res,long QstCod);
 Exi_Exist_t Exa_DB_GetAnswerType (MYSQL_RES **mysql_res,long QstCod);
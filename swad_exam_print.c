@@ -82,7 +82,8 @@ static unsigned ExaPrn_GetSomeQstsFromSetToPrint (struct ExaPrn_Print *Print,
                                                   struct ExaSet_Set *Set,
                                                   unsigned *NumQstsInPrint);
 static void ExaPrn_GenerateChoiceIndexes (struct Qst_PrintedQuestion *PrintedQst,
-					  Qst_Shuffle_t Shuffle);
+					  Qst_Shuffle_t Shuffle,
+					  unsigned long long *RandomState);
 static void ExaPrn_CreatePrint (struct ExaPrn_Print *Print,
 				ExaPrn_UpdateDates_t UpdateDates);
 
@@ -131,6 +132,7 @@ void ExaPrn_ResetPrint (struct ExaPrn_Print *Print)
    Print->NumQsts.Valid.Total          = 0;
    Print->Score.All   =
    Print->Score.Valid = 0.0;
+   Print->Seed = 0ULL;
   }
 
 /*****************************************************************************/
@@ -195,6 +197,10 @@ void ExaPrn_GetQstsPrint (struct Exa_Exams *Exams,
       Print->SesCod = Session->SesCod;
       Print->UsrCod = UsrDat->UsrCod;
 
+      /***** Get a new seed to draw questions.
+             It's stored in the print to be able to draw it again *****/
+      Print->Seed = Qst_GetNewRandomSeed ();
+
       /***** Get questions from database *****/
       ExaPrn_GetQuestionsForNewPrintFromDB (Print,Exams->Exam.ExaCod);
 
@@ -288,6 +294,7 @@ static void ExaPrn_GetPrintDataFromRow (MYSQL_RES **mysql_res,
 	 row[5]: NumQsts
 	 row[6]: NumQstsNotBlank
 	 row[7]: Score
+	 row[8]: Seed
 	 */
 	 /* Get print code (row[0]), session code (row[1]) and user code (row[2]) */
 	 Print->PrnCod = Str_ConvertStrCodToLongCod (row[0]);
@@ -309,6 +316,10 @@ static void ExaPrn_GetPrintDataFromRow (MYSQL_RES **mysql_res,
 	 if (sscanf (row[7],"%lf",&Print->Score.All) != 1)
 	    Print->Score.All = 0.0;
 	 Str_SetDecimalPointToLocal ();	// Return to local system
+
+	 /* Get seed used to draw questions (row[8]) */
+	 if (sscanf (row[8],"%llu",&Print->Seed) != 1)
+	    Print->Seed = 0ULL;
 	 break;
       case Exi_DOES_NOT_EXIST:
       default:
@@ -372,21 +383,37 @@ static unsigned ExaPrn_GetSomeQstsFromSetToPrint (struct ExaPrn_Print *Print,
    MYSQL_RES *mysql_res;
    MYSQL_ROW row;
    unsigned NumQstsInSet;
+   unsigned NumQstsToPrint;
    unsigned NumQstInSet;
+   unsigned *Indexes;
+   unsigned long long RandomState;
    Qst_AnswerType_t AnswerType;
    Qst_Shuffle_t Shuffle;
 
-   /***** Get questions from database *****/
-   NumQstsInSet = Exa_DB_GetSomeQstsFromSetToPrint (&mysql_res,
-                                                    Set->SetCod,
-                                                    Set->NumQstsToPrint);
+   /***** Get all candidate questions from database *****/
+   NumQstsInSet = Exa_DB_GetQstsFromSetToPrint (&mysql_res,Set->SetCod);
+   NumQstsToPrint = Set->NumQstsToPrint < NumQstsInSet ? Set->NumQstsToPrint :
+							 NumQstsInSet;
+   if (NumQstsToPrint == 0)
+     {
+      DB_FreeMySQLResult (&mysql_res);
+      return 0;
+     }
+
+   /***** Draw the questions to print.
+          Sets in the same print get different samples from the same seed *****/
+   if ((Indexes = malloc (NumQstsInSet * sizeof (*Indexes))) == NULL)
+      Err_NotEnoughMemoryExit ();
+   RandomState = Qst_GetRandomStateFromSeed (Print->Seed,Set->SetCod);
+   Qst_DrawRandomSample (&RandomState,Indexes,NumQstsInSet,NumQstsToPrint);
 
    /***** Questions in this set *****/
    for (NumQstInSet = 0, The_ResetRowColor ();
-	NumQstInSet < NumQstsInSet;
+	NumQstInSet < NumQstsToPrint;
 	NumQstInSet++, (*NumQstsInPrint)++, The_ChangeRowColor ())
      {
       /***** Get question data *****/
+      mysql_data_seek (mysql_res,(my_ulonglong) Indexes[NumQstInSet]);
       row = mysql_fetch_row (mysql_res);
       /*
       row[0] QstCod
@@ -420,7 +447,7 @@ static unsigned ExaPrn_GetSomeQstsFromSetToPrint (struct ExaPrn_Print *Print,
             /* If answer type is unique or multiple option,
                generate indexes of answers depending on shuffle */
 	    ExaPrn_GenerateChoiceIndexes (&Print->PrintedQsts[*NumQstsInPrint],
-					  Shuffle);
+					  Shuffle,&RandomState);
 	    break;
 	 default:
 	    break;
@@ -436,7 +463,13 @@ static unsigned ExaPrn_GetSomeQstsFromSetToPrint (struct ExaPrn_Print *Print,
       Print->PrintedQsts[*NumQstsInPrint].Answer.Score = 0.0;
      }
 
-   return NumQstsInSet;
+   /***** Free memory used for indexes *****/
+   free (Indexes);
+
+   /***** Free structure that stores the query result *****/
+   DB_FreeMySQLResult (&mysql_res);
+
+   return NumQstsToPrint;
   }
 
 /*****************************************************************************/
@@ -444,13 +477,15 @@ static unsigned ExaPrn_GetSomeQstsFromSetToPrint (struct ExaPrn_Print *Print,
 /*****************************************************************************/
 
 static void ExaPrn_GenerateChoiceIndexes (struct Qst_PrintedQuestion *PrintedQst,
-					  Qst_Shuffle_t Shuffle)
+					  Qst_Shuffle_t Shuffle,
+					  unsigned long long *RandomState)
   {
    struct Qst_Question Qst;
    unsigned NumOpt;
    MYSQL_RES *mysql_res;
    MYSQL_ROW row;
    unsigned Index;
+   unsigned Order[Qst_MAX_OPTS_PER_QST];
    Err_SuccessOrError_t ErrorInIndex;
    char StrInd[1 + Cns_MAX_DIGITS_UINT + 1];
 
@@ -458,9 +493,15 @@ static void ExaPrn_GenerateChoiceIndexes (struct Qst_PrintedQuestion *PrintedQst
    Qst_QstConstructor (&Qst);
    Qst.QstCod = PrintedQst->QstCod;
 
-      /***** Get answers of question from database *****/
+      /***** Get answers of question from database, always in the same order,
+             and shuffle them here, so they can be drawn again from the seed *****/
       Qst.Answer.NumOpts = Qst_DB_GetQstIndexesFromQst (&mysql_res,"exa_set_answers",
-							Qst.QstCod,Shuffle);
+							Qst.QstCod,Qst_DONT_SHUFFLE);
+      if (Qst.Answer.NumOpts > Qst_MAX_OPTS_PER_QST)
+	 Err_WrongAnswerIndexExit ();
+      Qst_DrawRandomSample (RandomState,Order,Qst.Answer.NumOpts,
+			    Shuffle == Qst_SHUFFLE ? Qst.Answer.NumOpts :
+						     0);
 
       /***** Reset string of indexes *****/
       PrintedQst->StrIndexes[0] = '\0';
@@ -470,6 +511,7 @@ static void ExaPrn_GenerateChoiceIndexes (struct Qst_PrintedQuestion *PrintedQst
 	   NumOpt++)
 	{
 	 /***** Get next answer *****/
+	 mysql_data_seek (mysql_res,(my_ulonglong) Order[NumOpt]);
 	 row = mysql_fetch_row (mysql_res);
 	 /*
 	 row[0] AnsInd
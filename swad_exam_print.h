@@ -68,6 +68,7 @@ struct ExaPrn_Print
    time_t TimeUTC[Dat_NUM_START_END_TIME];
    struct ExaPrn_NumQuestions NumQsts;
    struct ExaPrn_Score Score;
+   unsigned long long Seed;	// Seed used to draw questions and shuffle answers
    struct Qst_PrintedQuestion PrintedQsts[ExaPrn_MAX_QUESTIONS_PER_EXAM_PRINT];
   };
 
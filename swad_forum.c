@@ -367,16 +367,16 @@ static void For_WriteLinkToForum (const struct For_Forums *Forums,
                                   Lay_Last_t IsLastItemInLevel[1 + For_FORUM_MAX_LEVELS]);
 static unsigned For_GetNumThrsWithNewPstsInForum (const struct For_Forum *Forum,
                                                   unsigned NumThreads);
-static unsigned For_GetNumOfUnreadPostsInThr (long ThrCod,unsigned NumPostsInThr);
 
 static void For_WriteNumberOfThrs (unsigned NumThrs);
 
 static void For_PutIconsThreads (void *Forums);
 static void For_PutParsNewThread (void *Forums);
 static void For_ListForumThrs (struct For_Forums *Forums,
-	                       long ThrCods[Pag_ITEMS_PER_PAGE],
+	                       const struct For_Thread Thrs[Pag_ITEMS_PER_PAGE],
                                long ThrCodHighlighted,
                                struct Pag_Pagination *PaginationThrs);
+static void For_GetThreadDataFromRow (MYSQL_ROW row,struct For_Thread *Thr);
 
 static void For_LinkToFirstPageWithSubject (const struct For_Forums *Forums,
 					    const struct For_Thread *Thr,
@@ -491,11 +491,18 @@ static long For_InsertForumPst (long ThrCod,long UsrCod,
                                 const char *Subject,const char *Content,
                                 struct Med_Media *Media)
   {
+   long PstCod;
+
    /***** Store media in filesystem and database *****/
    Med_RemoveKeepOrStoreMedia (-1L,Media);
 
    /***** Insert forum post in the database *****/
-   return For_DB_InsertForumPst (ThrCod,UsrCod,Subject,Content,Media->MedCod);
+   PstCod = For_DB_InsertForumPst (ThrCod,UsrCod,Subject,Content,Media->MedCod);
+
+   /***** Update the counters of the thread *****/
+   For_DB_UpdateThrNumPstsAndWriters (ThrCod);
+
+   return PstCod;
   }
 
 /*****************************************************************************/
@@ -524,9 +531,12 @@ static bool For_RemoveForumPst (long PstCod,long MedCod)
    /***** Delete post from forum post table *****/
    For_DB_RemovePst (PstCod);
 
-   /***** Update the last post of the thread *****/
+   /***** Update the last post and the counters of the thread *****/
    if (!ThreadDeleted)
+     {
       For_DB_UpdateThrLastPst (ThrCod,For_DB_GetThrLastPst (ThrCod));
+      For_DB_UpdateThrNumPstsAndWriters (ThrCod);
+     }
 
    return ThreadDeleted;
   }
@@ -850,7 +860,7 @@ void For_ShowPostsOfAThread (struct For_Forums *Forums,
 		     default:
 			break;
 		    }
-		  if (Thread.NumMyPosts)
+		  if (Thread.MyPosts == Exi_EXISTS)
 		     Ntf_DB_MarkNotifAsSeenUsingCod (Ntf_EVENT_FORUM_REPLY,
 		                                     Forums->PstCod);
 		 }
@@ -2006,30 +2016,6 @@ static unsigned For_GetNumThrsWithNewPstsInForum (const struct For_Forum *Forum,
    return NumThrsWithNewPosts;
   }
 
-/*****************************************************************************/
-/** Get number of unread posts in a thread since my last read of that thread */
-/*****************************************************************************/
-
-static unsigned For_GetNumOfUnreadPostsInThr (long ThrCod,unsigned NumPostsInThr)
-  {
-   MYSQL_RES *mysql_res;
-   MYSQL_ROW row;
-   unsigned NumUnreadPosts = NumPostsInThr;	// By default, all posts are unread by me
-
-   /***** Get last time I read this thread from database *****/
-   if (For_DB_GetLastTimeIReadThread (&mysql_res,ThrCod) == Exi_EXISTS)
-     {
-      /***** Get the number of posts in thread with a modify time > newest read time for me (row[0]) *****/
-      row = mysql_fetch_row (mysql_res);
-      NumUnreadPosts = For_DB_GetNumPstsInThrNewerThan (ThrCod,row[0]);
-     }
-
-   /***** Free structure that stores the query result *****/
-   DB_FreeMySQLResult (&mysql_res);
-
-   return NumUnreadPosts;
-  }
-
 /*****************************************************************************/
 /************** Get and write total number of threads and posts **************/
 /*****************************************************************************/
@@ -2086,19 +2072,20 @@ void For_ShowForumThreadsHighlightingOneThread (struct For_Forums *Forums,
    MYSQL_RES *mysql_res;
    char FrameTitle[128 + For_MAX_BYTES_FORUM_NAME];
    char ForumName[For_MAX_BYTES_FORUM_NAME + 1];
-   unsigned NumThr;
+   MYSQL_ROW row;
    unsigned NumThrs;
+   unsigned NumThrsInScreen;
    unsigned NumThrInScreen;	// From 0 to Pag_ITEMS_PER_PAGE-1
    Dat_StartEndTime_t Order;
-   long ThrCods[Pag_ITEMS_PER_PAGE];
+   struct For_Thread Thrs[Pag_ITEMS_PER_PAGE];
    struct Pag_Pagination PaginationThrs;
 
    /***** Set forum name *****/
    For_SetForumName (&Forums->Forum,ForumName,
 		     Gbl.Prefs.Language,For_USE_HTML_ENTITIES);
 
-   /***** Get threads of a forum from database *****/
-   NumThrs = For_DB_GetForumThreads (&mysql_res,Forums);
+   /***** Get number of threads of a forum from database *****/
+   NumThrs = For_DB_GetNumThrsInForum (&Forums->Forum);
 
    /***** Compute variables related to pagination of threads *****/
    PaginationThrs.NumItems = NumThrs;
@@ -2107,17 +2094,28 @@ void For_ShowForumThreadsHighlightingOneThread (struct For_Forums *Forums,
    PaginationThrs.Anchor = For_FORUM_THREADS_SECTION_ID;
    Forums->CurrentPageThrs = (unsigned) PaginationThrs.CurrentPage;
 
-   /***** Fill the list of threads for current page *****/
-   mysql_data_seek (mysql_res,(my_ulonglong) (PaginationThrs.FirstItemVisible - 1));
-   for (NumThr  = PaginationThrs.FirstItemVisible, NumThrInScreen = 0;
-        NumThr <= PaginationThrs.LastItemVisible;
-        NumThr++, NumThrInScreen++)
-      /* Get thread code(row[0]) */
-      if ((ThrCods[NumThrInScreen] = DB_GetNextCode (mysql_res)) < 0)
+   /***** Get data of the threads in current page from database *****/
+   if (NumThrs)
+     {
+      NumThrsInScreen = For_DB_GetForumThreads (&mysql_res,Forums,
+						PaginationThrs.FirstItemVisible - 1,
+						PaginationThrs.LastItemVisible -
+						PaginationThrs.FirstItemVisible + 1);
+      if (NumThrsInScreen != PaginationThrs.LastItemVisible -
+			     PaginationThrs.FirstItemVisible + 1)
          Err_ShowErrorAndExit ("Error when getting thread of a forum.");
 
-   /***** Free structure that stores the query result *****/
-   DB_FreeMySQLResult (&mysql_res);
+      for (NumThrInScreen = 0;
+	   NumThrInScreen < NumThrsInScreen;
+	   NumThrInScreen++)
+	{
+	 row = mysql_fetch_row (mysql_res);
+	 For_GetThreadDataFromRow (row,&Thrs[NumThrInScreen]);
+	}
+
+      /***** Free structure that stores the query result *****/
+      DB_FreeMySQLResult (&mysql_res);
+     }
 
    /***** Show alert after action *****/
    HTM_SECTION_Begin (For_FORUM_THREADS_SECTION_ID);
@@ -2182,7 +2180,7 @@ void For_ShowForumThreadsHighlightingOneThread (struct For_Forums *Forums,
 	       HTM_TR_End ();
 
 	       /***** List the threads *****/
-	       For_ListForumThrs (Forums,ThrCods,Forums->Thread.Current,&PaginationThrs);
+	       For_ListForumThrs (Forums,Thrs,Forums->Thread.Current,&PaginationThrs);
 
 	    /***** End table *****/
 	    HTM_TABLE_End ();
@@ -2240,7 +2238,7 @@ static void For_PutParsNewThread (void *Forums)
 /*****************************************************************************/
 
 static void For_ListForumThrs (struct For_Forums *Forums,
-	                       long ThrCods[Pag_ITEMS_PER_PAGE],
+	                       const struct For_Thread Thrs[Pag_ITEMS_PER_PAGE],
                                long ThrCodHighlighted,
                                struct Pag_Pagination *PaginationThrs)
   {
@@ -2283,8 +2281,7 @@ static void For_ListForumThrs (struct For_Forums *Forums,
         NumThr++, NumThrInScreen++, The_ChangeRowColor ())
      {
       /***** Get the data of this thread *****/
-      Thr.ThrCod = ThrCods[NumThrInScreen];
-      For_GetThreadData (&Thr);
+      Thr = Thrs[NumThrInScreen];
       Forums->Thread.Current = Thr.ThrCod;
       Class = Thr.NumUnreadPosts ? "MSG_AUT_NEW" :
 	                           "MSG_AUT";
@@ -2296,7 +2293,7 @@ static void For_ListForumThrs (struct For_Forums *Forums,
 
          /***** Show my photo if I have any posts in this thread *****/
 	 HTM_TD_Begin ("class=\"BT %s\"",BgColor);
-	    if (Thr.NumMyPosts)
+	    if (Thr.MyPosts == Exi_EXISTS)
 	       HTM_IMG (Gbl.Usrs.Me.PhotoURL[0] ? Gbl.Usrs.Me.PhotoURL :
 						  Cfg_URL_ICON_PUBLIC,
 			Gbl.Usrs.Me.PhotoURL[0] ? NULL :
@@ -2501,66 +2498,94 @@ static void For_LinkToFirstPageWithSubject (const struct For_Forums *Forums,
 
 void For_GetThreadData (struct For_Thread *Thr)
   {
-   extern const char *Txt_no_subject;
    MYSQL_RES *mysql_res;
    MYSQL_ROW row;
-   Dat_StartEndTime_t Order;
 
    /***** Get data of a thread from database *****/
    if (For_DB_GetThreadDataFromThrCod (&mysql_res,Thr->ThrCod) == Exi_DOES_NOT_EXIST)
       Err_WrongThreadExit ();
    row = mysql_fetch_row (mysql_res);
+   For_GetThreadDataFromRow (row,Thr);
 
-   /***** Get the codes of the first (row[0])
-          and the last post (row[1]) in this thread *****/
-   Thr->PstCod[Dat_STR_TIME] = Str_ConvertStrCodToLongCod (row[0]);
-   Thr->PstCod[Dat_END_TIME] = Str_ConvertStrCodToLongCod (row[1]);
+   /***** Free structure that stores the query result *****/
+   DB_FreeMySQLResult (&mysql_res);
+  }
+
+/*****************************************************************************/
+/*********************** Get data of a thread from row ***********************/
+/*****************************************************************************/
 
-   /***** Get the code of the first message (row[0])
-          and the last message (row[1]) in this thread *****/
-   if (sscanf (row[0],"%ld",&(Thr->PstCod[Dat_STR_TIME])) != 1)
+static void For_GetThreadDataFromRow (MYSQL_ROW row,struct For_Thread *Thr)
+  {
+   extern const char *Txt_no_subject;
+   static For_Disabled_t Disabled[2] =
+     {
+      [false] = For_ENABLED,
+      [true ] = For_DISABLED,
+     };
+   Dat_StartEndTime_t Order;
+   /*
+   row[ 0]: ThrCod
+   row[ 1]: PstCod of first post
+   row[ 2]: PstCod of last post
+   row[ 3]: UsrCod of author of first post
+   row[ 4]: UsrCod of author of last post
+   row[ 5]: UNIX_TIMESTAMP(CreatTime) of first post
+   row[ 6]: UNIX_TIMESTAMP(CreatTime) of last post
+   row[ 7]: Subject
+   row[ 8]: Is first post disabled?
+   row[ 9]: Is last post disabled?
+   row[10]: Number of posts in thread
+   row[11]: Number of unread (by me) posts in thread
+   row[12]: Are there posts written by me in thread?
+   row[13]: Number of users who have written posts in thread
+   row[14]: Number of users who have read thread
+   */
+   /***** Get the code of this thread (row[0]) *****/
+   if ((Thr->ThrCod = Str_ConvertStrCodToLongCod (row[0])) <= 0)
+      Err_WrongThreadExit ();
+
+   /***** Get the code of the first post (row[1])
+          and the last post (row[2]) in this thread *****/
+   if (sscanf (row[1],"%ld",&(Thr->PstCod[Dat_STR_TIME])) != 1)
       Err_WrongPostExit ();
-   if (sscanf (row[1],"%ld",&(Thr->PstCod[Dat_END_TIME])) != 1)
+   if (sscanf (row[2],"%ld",&(Thr->PstCod[Dat_END_TIME])) != 1)
       Err_WrongPostExit ();
 
-   /***** Get the author of the first post in this thread (row[2])
-          and the author of the last  post in this thread (row[3]) *****/
-   Thr->UsrCod[Dat_STR_TIME] = Str_ConvertStrCodToLongCod (row[2]);
-   Thr->UsrCod[Dat_END_TIME] = Str_ConvertStrCodToLongCod (row[3]);
+   /***** Get the author of the first post in this thread (row[3])
+          and the author of the last  post in this thread (row[4]) *****/
+   Thr->UsrCod[Dat_STR_TIME] = Str_ConvertStrCodToLongCod (row[3]);
+   Thr->UsrCod[Dat_END_TIME] = Str_ConvertStrCodToLongCod (row[4]);
 
-   /***** Get the date of the first post in this thread (row[4])
-          and the date of the last  post in this thread (row[5]) *****/
-   Thr->WriteTime[Dat_STR_TIME] = Dat_GetUNIXTimeFromStr (row[4]);
-   Thr->WriteTime[Dat_END_TIME] = Dat_GetUNIXTimeFromStr (row[5]);
+   /***** Get the date of the first post in this thread (row[5])
+          and the date of the last  post in this thread (row[6]) *****/
+   Thr->WriteTime[Dat_STR_TIME] = Dat_GetUNIXTimeFromStr (row[5]);
+   Thr->WriteTime[Dat_END_TIME] = Dat_GetUNIXTimeFromStr (row[6]);
 
-   /***** Get the subject of this thread (row[6]) *****/
-   Str_Copy (Thr->Subject,row[6],sizeof (Thr->Subject) - 1);
+   /***** Get the subject of this thread (row[7]) *****/
+   Str_Copy (Thr->Subject,row[7],sizeof (Thr->Subject) - 1);
    if (!Thr->Subject[0])
       snprintf (Thr->Subject,sizeof (Thr->Subject),"[%s]",Txt_no_subject);
 
-   /***** Free structure that stores the query result *****/
-   DB_FreeMySQLResult (&mysql_res);
-
-   /***** Get if first or last message are enabled *****/
+   /***** Get if first (row[8]) or last post (row[9]) are disabled *****/
    for (Order  = (Dat_StartEndTime_t) 0;
 	Order <= (Dat_StartEndTime_t) (Dat_NUM_START_END_TIME - 1);
 	Order++)
-      Thr->Disabled[Order] = For_DB_GetIfPstIsDisabled (Thr->PstCod[Order]);
-
-   /***** Get number of posts in this thread *****/
-   Thr->NumPosts = For_DB_GetNumPstsInThr (Thr->ThrCod);
-
-   /***** Get number of unread (by me) posts in this thread *****/
-   Thr->NumUnreadPosts = For_GetNumOfUnreadPostsInThr (Thr->ThrCod,Thr->NumPosts);
+      Thr->Disabled[Order] = Disabled[row[8 + Order][0] == '1'];
 
-   /***** Get number of posts that I have written in this thread *****/
-   Thr->NumMyPosts = For_DB_GetNumMyPstsInThr (Thr->ThrCod);
+   /***** Get number of posts in this thread (row[10])
+          and number of unread (by me) posts in this thread (row[11]) *****/
+   Thr->NumPosts       = Str_ConvertStrToUnsigned (row[10]);
+   Thr->NumUnreadPosts = Str_ConvertStrToUnsigned (row[11]);
 
-   /***** Get number of users who have write posts in this thread *****/
-   Thr->NumWriters = For_DB_GetNumOfWritersInThr (Thr->ThrCod);
+   /***** Get if I have written posts in this thread (row[12]) *****/
+   Thr->MyPosts = row[12][0] == '1' ? Exi_EXISTS :
+				      Exi_DOES_NOT_EXIST;
 
-   /***** Get number of users who have read this thread *****/
-   Thr->NumReaders = For_DB_GetNumReadersOfThr (Thr->ThrCod);
+   /***** Get number of users who have written posts in this thread (row[13])
+          and number of users who have read this thread (row[14]) *****/
+   Thr->NumWriters = Str_ConvertStrToUnsigned (row[13]);
+   Thr->NumReaders = Str_ConvertStrToUnsigned (row[14]);
   }
 
 /*****************************************************************************/
@@ -29,6 +29,7 @@
 
 #include "swad_alert.h"
 #include "swad_date.h"
+#include "swad_exist.h"
 #include "swad_language.h"
 #include "swad_notification.h"
 
@@ -92,7 +93,7 @@ struct For_Thread
    char Subject[Cns_MAX_BYTES_SUBJECT + 1];
    unsigned NumPosts;
    unsigned NumUnreadPosts;	// Number of my unread posts in thread
-   unsigned NumMyPosts;		// Number of posts written by me in thread
+   Exi_Exist_t MyPosts;		// Are there posts written by me in thread?
    unsigned NumWriters;
    unsigned NumReaders;
   };
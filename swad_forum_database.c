@@ -396,6 +396,18 @@ unsigned For_DB_GetPublishersInThreadExceptMe (MYSQL_RES **mysql_res,long PstCod
 
 void For_DB_RemovePst (long PstCod)
   {
+   /***** Decrease number of read posts of users who have read this post *****/
+   DB_QueryUPDATE ("can not update the number of read posts in a thread",
+		   "UPDATE for_read,"
+			  "for_posts"
+		     " SET for_read.NumReadPsts=for_read.NumReadPsts-1"
+		   " WHERE for_posts.PstCod=%ld"
+		     " AND for_posts.ThrCod=for_read.ThrCod"
+		     " AND for_posts.CreatTime<=for_read.ReadTime"
+		     " AND for_read.NumReadPsts>0",
+		   PstCod);
+
+   /***** Remove post *****/
    DB_QueryDELETE ("can not remove a post from a forum",
 		   "DELETE FROM for_posts"
 		   " WHERE PstCod=%ld",
@@ -465,16 +477,18 @@ void For_DB_UpdateThrLastPst (long ThrCod,long LastPstCod)
   }
 
 /*****************************************************************************/
-/********** Show available threads of a forum highlighting a thread **********/
+/******** Get data of the threads of a forum shown in a page of threads ******/
 /*****************************************************************************/
+// Columns must be the same as in For_DB_GetThreadDataFromThrCod
 
 unsigned For_DB_GetForumThreads (MYSQL_RES **mysql_res,
-                                 const struct For_Forums *Forums)
+                                 const struct For_Forums *Forums,
+                                 unsigned FirstThr,unsigned NumThrs)
   {
-   static const char *FieldPstCod[Dat_NUM_START_END_TIME] =
+   static const char *Table[Dat_NUM_START_END_TIME] =
      {
-      [Dat_STR_TIME] = "FirstPstCod",
-      [Dat_END_TIME] = "LastPstCod",
+      [Dat_STR_TIME] = "m0",	// First post
+      [Dat_END_TIME] = "m1",	// Last post
      };
    char SubQuery[256];
 
@@ -486,40 +500,95 @@ unsigned For_DB_GetForumThreads (MYSQL_RES **mysql_res,
       SubQuery[0] = '\0';
 
    return (unsigned)
-   DB_QuerySELECT (mysql_res,"can not get thread of a forum",
-		   "SELECT for_threads.ThrCod"	// row[0]
-		    " FROM for_threads,"
-			  "for_posts"
+   DB_QuerySELECT (mysql_res,"can not get threads of a forum",
+		   "SELECT for_threads.ThrCod,"			// row[ 0]
+			  "m0.PstCod,"				// row[ 1]
+			  "m1.PstCod,"				// row[ 2]
+			  "m0.UsrCod,"				// row[ 3]
+			  "m1.UsrCod,"				// row[ 4]
+			  "UNIX_TIMESTAMP(m0.CreatTime),"	// row[ 5]
+			  "UNIX_TIMESTAMP(m1.CreatTime),"	// row[ 6]
+			  "m0.Subject,"				// row[ 7]
+			  "d0.PstCod IS NOT NULL,"		// row[ 8]
+			  "d1.PstCod IS NOT NULL,"		// row[ 9]
+			  "for_threads.NumPsts,"		// row[10]
+			  "GREATEST(for_threads.NumPsts-"
+			  "IFNULL(for_read.NumReadPsts,0),0),"	// row[11]
+			  "EXISTS"
+			  "(SELECT *"
+			    " FROM for_posts"
+			   " WHERE ThrCod=for_threads.ThrCod"
+			     " AND UsrCod=%ld),"		// row[12]
+			  "for_threads.NumWriters,"		// row[13]
+			  "for_threads.NumReaders"		// row[14]
+		    " FROM for_threads"
+		    " JOIN for_posts AS m0"
+		      " ON for_threads.FirstPstCod=m0.PstCod"
+		    " JOIN for_posts AS m1"
+		      " ON for_threads.LastPstCod=m1.PstCod"
+		    " LEFT JOIN for_disabled AS d0"
+		      " ON m0.PstCod=d0.PstCod"
+		    " LEFT JOIN for_disabled AS d1"
+		      " ON m1.PstCod=d1.PstCod"
+		    " LEFT JOIN for_read"
+		      " ON for_threads.ThrCod=for_read.ThrCod"
+		     " AND for_read.UsrCod=%ld"
 		   " WHERE for_threads.ForumType=%u"
 		     "%s"
-		     " AND for_threads.%s=for_posts.PstCod"
-		" ORDER BY for_posts.CreatTime DESC",
+		" ORDER BY %s.CreatTime DESC"
+		   " LIMIT %u,%u",
+		   Gbl.Usrs.Me.UsrDat.UsrCod,
+		   Gbl.Usrs.Me.UsrDat.UsrCod,
 		   (unsigned) Forums->Forum.Type,
 		   SubQuery,
-		   FieldPstCod[Forums->ThreadsOrder]);
+		   Table[Forums->ThreadsOrder],
+		   FirstThr,NumThrs);
   }
 
 /*****************************************************************************/
 /***************************** Get data of a thread **************************/
 /*****************************************************************************/
+// Columns must be the same as in For_DB_GetForumThreads
 
 Exi_Exist_t For_DB_GetThreadDataFromThrCod (MYSQL_RES **mysql_res,long ThrCod)
   {
    return
    DB_QuerySELECTunique (mysql_res,"can not get data of a thread of a forum",
-			 "SELECT m0.PstCod,"			// row[0]
-			        "m1.PstCod,"			// row[1]
-			        "m0.UsrCod,"			// row[2]
-			        "m1.UsrCod,"			// row[3]
-			        "UNIX_TIMESTAMP(m0.CreatTime),"	// row[4]
-			        "UNIX_TIMESTAMP(m1.CreatTime),"	// row[5]
-			        "m0.Subject"
-			  " FROM for_threads,"
-			        "for_posts AS m0,"
-			        "for_posts AS m1"
-			 " WHERE for_threads.ThrCod=%ld"
-			   " AND for_threads.FirstPstCod=m0.PstCod"
-			   " AND for_threads.LastPstCod=m1.PstCod",
+			 "SELECT for_threads.ThrCod,"			// row[ 0]
+				"m0.PstCod,"				// row[ 1]
+				"m1.PstCod,"				// row[ 2]
+				"m0.UsrCod,"				// row[ 3]
+				"m1.UsrCod,"				// row[ 4]
+				"UNIX_TIMESTAMP(m0.CreatTime),"		// row[ 5]
+				"UNIX_TIMESTAMP(m1.CreatTime),"		// row[ 6]
+				"m0.Subject,"				// row[ 7]
+				"d0.PstCod IS NOT NULL,"		// row[ 8]
+				"d1.PstCod IS NOT NULL,"		// row[ 9]
+				"for_threads.NumPsts,"			// row[10]
+				"GREATEST(for_threads.NumPsts-"
+				"IFNULL(for_read.NumReadPsts,0),0),"	// row[11]
+				"EXISTS"
+				"(SELECT *"
+				  " FROM for_posts"
+				 " WHERE ThrCod=for_threads.ThrCod"
+				   " AND UsrCod=%ld),"			// row[12]
+				"for_threads.NumWriters,"		// row[13]
+				"for_threads.NumReaders"		// row[14]
+			  " FROM for_threads"
+			  " JOIN for_posts AS m0"
+			    " ON for_threads.FirstPstCod=m0.PstCod"
+			  " JOIN for_posts AS m1"
+			    " ON for_threads.LastPstCod=m1.PstCod"
+			  " LEFT JOIN for_disabled AS d0"
+			    " ON m0.PstCod=d0.PstCod"
+			  " LEFT JOIN for_disabled AS d1"
+			    " ON m1.PstCod=d1.PstCod"
+			  " LEFT JOIN for_read"
+			    " ON for_threads.ThrCod=for_read.ThrCod"
+			   " AND for_read.UsrCod=%ld"
+			 " WHERE for_threads.ThrCod=%ld",
+			 Gbl.Usrs.Me.UsrDat.UsrCod,
+			 Gbl.Usrs.Me.UsrDat.UsrCod,
 			 ThrCod);
   }
 
@@ -605,64 +674,26 @@ void For_DB_GetThrSubject (long ThrCod,char Subject[Cns_MAX_BYTES_SUBJECT + 1])
   }
 
 /*****************************************************************************/
-/********** Get number of users that have write posts in a thread ************/
-/*****************************************************************************/
-
-unsigned For_DB_GetNumOfWritersInThr (long ThrCod)
-  {
-   /***** Get number of distinct writers in a thread from database *****/
-   return DB_QueryCOUNT ("can not get the number of writers in a thread of a forum",
-			 "SELECT COUNT(DISTINCT UsrCod)"
-			  " FROM for_posts"
-			 " WHERE ThrCod=%ld",
-			 ThrCod);
-  }
-
-/*****************************************************************************/
-/********************** Get number of posts in a thread **********************/
-/*****************************************************************************/
-
-unsigned For_DB_GetNumPstsInThr (long ThrCod)
-  {
-   /***** Get number of posts in a thread from database *****/
-   return (unsigned)
-   DB_QueryCOUNT ("can not get the number of posts in a thread of a forum",
-		  "SELECT COUNT(*)"
-		   " FROM for_posts"
-		  " WHERE ThrCod=%ld",
-		  ThrCod);
-  }
-
-/*****************************************************************************/
-/************** Get whether there are posts of mine in a thread **************/
-/*****************************************************************************/
-
-unsigned For_DB_GetNumMyPstsInThr (long ThrCod)
-  {
-   return (unsigned)
-   DB_QueryCOUNT ("can not check if you have written posts in a thead of a forum",
-		  "SELECT COUNT(*)"
-		   " FROM for_posts"
-		  " WHERE ThrCod=%ld"
-		    " AND UsrCod=%ld",
-		  ThrCod,
-		  Gbl.Usrs.Me.UsrDat.UsrCod);
-  }
-
-/*****************************************************************************/
-/**** Get number of posts in thread with a modify time > a specified time ****/
+/********* Update number of posts and number of writers in a thread **********/
 /*****************************************************************************/
+// Must be called after inserting or removing posts in a thread
 
-unsigned For_DB_GetNumPstsInThrNewerThan (long ThrCod,const char *Time)
+void For_DB_UpdateThrNumPstsAndWriters (long ThrCod)
   {
-   return (unsigned)
-   DB_QueryCOUNT ("can not check if there are new posts in a thread of a forum",
-		  "SELECT COUNT(*)"
-		   " FROM for_posts"
-		  " WHERE ThrCod=%ld"
-		    " AND ModifTime>'%s'",
-		  ThrCod,
-		  Time);
+   DB_QueryUPDATE ("can not update the number of posts in a thread of a forum",
+		   "UPDATE for_threads"
+		     " SET NumPsts="
+			  "(SELECT COUNT(*)"
+			    " FROM for_posts"
+			   " WHERE ThrCod=%ld),"
+			  "NumWriters="
+			  "(SELECT COUNT(DISTINCT UsrCod)"
+			    " FROM for_posts"
+			   " WHERE ThrCod=%ld)"
+		   " WHERE ThrCod=%ld",
+		   ThrCod,
+		   ThrCod,
+		   ThrCod);
   }
 
 /*****************************************************************************/
@@ -685,34 +716,36 @@ void For_DB_RemoveThread (long ThrCod)
 // (even if any previous pages have been no read actually)
 // Note that database is not updated with the current time,
 // but with the creation time of the most recent post in this thread read by me.
+// The number of posts created until that time is stored too,
+// so unread posts in a thread can be got without counting them.
 
 void For_DB_UpdateThrReadTime (long ThrCod,
                                time_t CreatTimeUTCOfTheMostRecentPostRead)
   {
-   /***** Insert or replace pair ThrCod-UsrCod in for_read *****/
-   DB_QueryREPLACE ("can not update the status of reading"
-		    " of a thread of a forum",
-		    "REPLACE INTO for_read"
-		    " (ThrCod,UsrCod,ReadTime)"
-		    " VALUES"
-		    " (%ld,%ld,FROM_UNIXTIME(%ld))",
-	            ThrCod,
-	            Gbl.Usrs.Me.UsrDat.UsrCod,
-	            (long) CreatTimeUTCOfTheMostRecentPostRead);
-  }
-
-/*****************************************************************************/
-/**************** Get number of users that have read a thread ****************/
-/*****************************************************************************/
-
-unsigned For_DB_GetNumReadersOfThr (long ThrCod)
-  {
-   return (unsigned)
-   DB_QueryCOUNT ("can not get the number of readers of a thread of a forum",
-		  "SELECT COUNT(*)"
-		   " FROM for_read"
-		  " WHERE ThrCod=%ld",
-		  ThrCod);
+   /***** Insert or update pair ThrCod-UsrCod in for_read *****/
+   // Number of affected rows is 1 only when a new row is inserted
+   if (DB_QueryINSERTandReturnNumRows ("can not update the status of reading"
+				       " of a thread of a forum",
+				       "INSERT INTO for_read"
+				       " (ThrCod,UsrCod,ReadTime,NumReadPsts)"
+				       " SELECT %ld,%ld,FROM_UNIXTIME(%ld),COUNT(*)"
+					 " FROM for_posts"
+					" WHERE ThrCod=%ld"
+					  " AND CreatTime<=FROM_UNIXTIME(%ld)"
+				       " ON DUPLICATE KEY UPDATE"
+				       " ReadTime=VALUES(ReadTime),"
+				       "NumReadPsts=VALUES(NumReadPsts)",
+				       ThrCod,
+				       Gbl.Usrs.Me.UsrDat.UsrCod,
+				       (long) CreatTimeUTCOfTheMostRecentPostRead,
+				       ThrCod,
+				       (long) CreatTimeUTCOfTheMostRecentPostRead) == 1)
+      /***** I'm a new reader of this thread *****/
+      DB_QueryUPDATE ("can not update the number of readers of a thread",
+		      "UPDATE for_threads"
+		        " SET NumReaders=NumReaders+1"
+		      " WHERE ThrCod=%ld",
+		      ThrCod);
   }
 
 /*****************************************************************************/
@@ -760,22 +793,6 @@ Exi_Exist_t For_DB_GetLastTimeIReadForum (MYSQL_RES **mysql_res,
 			 SubQuery);
   }
 
-/*****************************************************************************/
-/*********************** Get last time I read a thread ***********************/
-/*****************************************************************************/
-
-Exi_Exist_t For_DB_GetLastTimeIReadThread (MYSQL_RES **mysql_res,long ThrCod)
-  {
-   return
-   DB_QuerySELECTunique (mysql_res,"can not get the date of reading of a thread",
-			 "SELECT ReadTime"	// row[0]
-			  " FROM for_read"
-			 " WHERE ThrCod=%ld"
-			   " AND UsrCod=%ld",
-			 ThrCod,
-			 Gbl.Usrs.Me.UsrDat.UsrCod);
-  }
-
 /*****************************************************************************/
 /********************* Remove thread read status for a thread ****************/
 /*****************************************************************************/
@@ -795,6 +812,17 @@ void For_DB_RemoveThrFromReadThrs (long ThrCod)
 
 void For_DB_RemoveUsrFromReadThrs (long UsrCod)
   {
+   /***** Decrease number of readers of threads read by this user *****/
+   DB_QueryUPDATE ("can not update the number of readers of threads",
+		   "UPDATE for_threads,"
+			  "for_read"
+		     " SET for_threads.NumReaders=for_threads.NumReaders-1"
+		   " WHERE for_read.UsrCod=%ld"
+		     " AND for_read.ThrCod=for_threads.ThrCod"
+		     " AND for_threads.NumReaders>0",
+		   UsrCod);
+
+   /***** Remove threads read by this user *****/
    DB_QueryDELETE ("can not remove the status of reading by a user"
 		   " of all threads in a forum",
 		   "DELETE FROM for_read"
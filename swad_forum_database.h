@@ -69,26 +69,22 @@ long For_DB_InsertForumThread (const struct For_Forums *Forums,long FirstPstCod)
 void For_DB_UpdateThrFirstAndLastPst (long ThrCod,long FirstPstCod,long LastPstCod);
 void For_DB_UpdateThrLastPst (long ThrCod,long LastPstCod);
 unsigned For_DB_GetForumThreads (MYSQL_RES **mysql_res,
-                                 const struct For_Forums *Forums);
+                                 const struct For_Forums *Forums,
+                                 unsigned FirstThr,unsigned NumThrs);
 Exi_Exist_t For_DB_GetThreadDataFromThrCod (MYSQL_RES **mysql_res,long ThrCod);
 void For_DB_GetThreadTitleFromThrCod (long ThrCod,char *Subject,size_t TitleSize);
 Exi_Exist_t For_DB_CheckIfThrExistsInForum (long ThrCod,const struct For_Forum *Forum);
 long For_DB_GetThrLastPst (long ThrCod);
 void For_DB_GetThrSubject (long ThrCod,char Subject[Cns_MAX_BYTES_SUBJECT + 1]);
-unsigned For_DB_GetNumOfWritersInThr (long ThrCod);
-unsigned For_DB_GetNumPstsInThr (long ThrCod);
-unsigned For_DB_GetNumMyPstsInThr (long ThrCod);
-unsigned For_DB_GetNumPstsInThrNewerThan (long ThrCod,const char *Time);
+void For_DB_UpdateThrNumPstsAndWriters (long ThrCod);
 void For_DB_RemoveThread (long ThrCod);
 
 //----------------------------- Thread read -----------------------------------
 void For_DB_UpdateThrReadTime (long ThrCod,
                                time_t CreatTimeUTCOfTheMostRecentPostRead);
-unsigned For_DB_GetNumReadersOfThr (long ThrCod);
 Exi_Exist_t For_DB_GetThrReadTimeFromThrCod (MYSQL_RES **mysql_res,long ThrCod);
 Exi_Exist_t For_DB_GetLastTimeIReadForum (MYSQL_RES **mysql_res,
                                           const struct For_Forum *Forum);
-Exi_Exist_t For_DB_GetLastTimeIReadThread (MYSQL_RES **mysql_res,long ThrCod);
 void For_DB_RemoveThrFromReadThrs (long ThrCod);
 void For_DB_RemoveUsrFromReadThrs (long UsrCod);
 
@@ -40,14 +40,17 @@
 #include "swad_call_for_exam.h"
 #include "swad_changed.h"
 #include "swad_config.h"
+#include "swad_connected_index.h"
 #include "swad_constant.h"
 #include "swad_degree_type.h"
 #include "swad_department.h"
 #include "swad_follow.h"
 #include "swad_global.h"
 #include "swad_hierarchy.h"
+#include "swad_hierarchy_snapshot.h"
 #include "swad_hierarchy_type.h"
 #include "swad_icon.h"
+#include "swad_image.h"
 #include "swad_parameter.h"
 #include "swad_plugin.h"
 #include "swad_process.h"
@@ -253,4 +256,7 @@ void Gbl_Cleanup (void)
    Usr_FreeListsSelectedEncryptedUsrsCods (&Gbl.Usrs.Selected);
    Par_FreePars ();
    Ale_ResetAllAlerts ();
+   Img_Cleanup ();
+   HieSnp_Unmap ();
+   ConIdx_Unmap ();
   }
@@ -107,9 +107,9 @@ static Err_SuccessOrError_t Grp_CheckIfNotClosedOrFull (struct ListCodGrps *LstG
 static void Grp_RemoveUsrFromGrps (Usr_MeOrOther_t MeOrOther,
 				   struct ListCodGrps *LstGrpsWant,
 				   struct ListCodGrps *LstGrpsBelong);
-static void Grp_EnrolUsrInGrps (Usr_MeOrOther_t MeOrOther,
-				struct ListCodGrps *LstGrpsWant,
-				struct ListCodGrps *LstGrpsBelong);
+static Err_SuccessOrError_t Grp_EnrolUsrInGrps (Usr_MeOrOther_t MeOrOther,
+						struct ListCodGrps *LstGrpsWant,
+						struct ListCodGrps *LstGrpsBelong);
 
 static void Grp_ConstructorListGrpAlreadySelec (struct ListGrpsAlreadySelec **AlreadyExistsGroupOfType);
 static void Grp_DestructorListGrpAlreadySelec (struct ListGrpsAlreadySelec **AlreadyExistsGroupOfType);
@@ -843,10 +843,6 @@ Err_SuccessOrError_t Grp_ChangeGrpsAtomically (Usr_MeOrOther_t MeOrOther,
    struct ListCodGrps LstGrpsUsrBelongs;
    Err_SuccessOrError_t SelectionIsValid;
 
-   /***** Lock tables to make the enrolment atomic *****/
-   if (Usr_UsrDat[MeOrOther]->Roles.InCurrentCrs == Rol_STD)
-      Grp_DB_LockTables ();
-
    /***** Get list of groups types and groups in this course *****/
    Grp_GetListGrpTypesAndGrpsInThisCrs (Grp_GRP_TYPES_WITH_GROUPS);
 
@@ -864,18 +860,17 @@ Err_SuccessOrError_t Grp_ChangeGrpsAtomically (Usr_MeOrOther_t MeOrOther,
 
    if (SelectionIsValid == Err_SUCCESS)
      {
-      /***** Go across the list of groups user belongs to,
-	     removing her/him from those groups not wanted *****/
-      Grp_RemoveUsrFromGrps (MeOrOther,LstGrpsUsrWants,&LstGrpsUsrBelongs);
-
       /***** Go across the list of groups wanted,
 	     adding user to those groups to which user doesn't belong to *****/
-      Grp_EnrolUsrInGrps (MeOrOther,LstGrpsUsrWants,&LstGrpsUsrBelongs);
-     }
+      // Seats are taken before leaving the old groups,
+      // so the user does not lose any group if a new group became full
+      SelectionIsValid = Grp_EnrolUsrInGrps (MeOrOther,LstGrpsUsrWants,&LstGrpsUsrBelongs);
 
-   /***** Unlock tables after changes in groups *****/
-   if (Usr_UsrDat[MeOrOther]->Roles.InCurrentCrs == Rol_STD)
-      DB_UnlockTables ();
+      /***** Go across the list of groups user belongs to,
+	     removing her/him from those groups not wanted *****/
+      if (SelectionIsValid == Err_SUCCESS)
+	 Grp_RemoveUsrFromGrps (MeOrOther,LstGrpsUsrWants,&LstGrpsUsrBelongs);
+     }
 
    /***** Free memory with the list of groups which user belonged to *****/
    Grp_FreeListCodGrp (&LstGrpsUsrBelongs);
@@ -1007,13 +1002,15 @@ static void Grp_RemoveUsrFromGrps (Usr_MeOrOther_t MeOrOther,
 /****** Go across the received list of groups that I want to enrol in, *******/
 /****** adding me to those groups that I don't belong to               *******/
 /*****************************************************************************/
+// Return Err_SUCCESS if user has been enroled in all wanted groups
 
-static void Grp_EnrolUsrInGrps (Usr_MeOrOther_t MeOrOther,
-				   struct ListCodGrps *LstGrpsWant,
-				   struct ListCodGrps *LstGrpsBelong)
+static Err_SuccessOrError_t Grp_EnrolUsrInGrps (Usr_MeOrOther_t MeOrOther,
+						struct ListCodGrps *LstGrpsWant,
+						struct ListCodGrps *LstGrpsBelong)
   {
    extern struct Usr_Data *Usr_UsrDat[Usr_NUM_ME_OR_OTHER];
    unsigned NumGrpWant;
+   unsigned NumGrpEnroled;
    long GrpCodWant;
 
    for (NumGrpWant = 0;
@@ -1024,8 +1021,30 @@ static void Grp_EnrolUsrInGrps (Usr_MeOrOther_t MeOrOther,
 
       if (Grp_CheckIfGrpExistsInList (GrpCodWant,
 				      LstGrpsBelong) == Exi_DOES_NOT_EXIST)	// User wants this group but he/she don't belong to it
-	 Grp_DB_AddUsrToGrp (Usr_UsrDat[MeOrOther]->UsrCod,GrpCodWant);
+        {
+	 if (MeOrOther == Usr_ME && Gbl.Usrs.Me.Role.Logged == Rol_STD)	// It's me, a student, trying to changing my groups
+	   {
+	    /* Take a seat only if the group is still open and not full */
+	    if (Grp_DB_AddStdToGrpIfOpenAndNotFull (Usr_UsrDat[MeOrOther]->UsrCod,
+						    GrpCodWant) == Err_ERROR)
+	      {
+	       /* Group closed or full ==> release seats taken before */
+	       for (NumGrpEnroled = 0;
+		    NumGrpEnroled < NumGrpWant;
+		    NumGrpEnroled++)
+		  if (Grp_CheckIfGrpExistsInList (LstGrpsWant->GrpCods[NumGrpEnroled],
+						  LstGrpsBelong) == Exi_DOES_NOT_EXIST)
+		     Grp_DB_RemoveUsrFromGrp (Usr_UsrDat[MeOrOther]->UsrCod,
+					      LstGrpsWant->GrpCods[NumGrpEnroled]);
+	       return Err_ERROR;
+	      }
+	   }
+	 else
+	    Grp_DB_AddUsrToGrp (Usr_UsrDat[MeOrOther]->UsrCod,GrpCodWant);
+        }
      }
+
+   return Err_SUCCESS;
   }
 
 /*****************************************************************************/
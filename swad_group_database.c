@@ -40,23 +40,6 @@
 
 extern struct Globals Gbl;
 
-/*****************************************************************************/
-/*********** Lock tables to make the registration in groups atomic ***********/
-/*****************************************************************************/
-
-void Grp_DB_LockTables (void)
-  {
-   DB_Query ("can not lock tables to change user's groups",
-	     "LOCK TABLES "
-	          "grp_types WRITE,"
-	          "grp_groups WRITE,"
-	          "grp_users WRITE,"
-	          "crs_users READ,"
-	          "crs_user_settings READ,"
-	          "roo_rooms READ");
-   DB_SetThereAreLockedTables ();
-  }
-
 /*****************************************************************************/
 /************************** Create a new group type **************************/
 /*****************************************************************************/
@@ -500,7 +483,6 @@ unsigned Grp_DB_GetGrpTypesWithGrpsInCrs (MYSQL_RES **mysql_res,long HieCod)
 
 unsigned Grp_DB_GetAllGrpTypesInCrs (MYSQL_RES **mysql_res,long HieCod)
   {
-   // The tables in the second part of the UNION requires ALIAS in order to LOCK TABLES when registering in groups
    return (unsigned)
    DB_QuerySELECT (mysql_res,"can not get types of group of a course",
 		   "(SELECT grp_types.GrpTypCod,"			// row[0]
@@ -1137,6 +1119,45 @@ void Grp_DB_AddUsrToGrp (long UsrCod,long GrpCod)
                    UsrCod);
   }
 
+/*****************************************************************************/
+/******** Add a student to a group if the group is open and not full *********/
+/*****************************************************************************/
+// Seats are checked and taken in only one query,
+// so two students can not get the last seat of a group at the same time
+// Return Err_SUCCESS if the student has been added to the group
+
+Err_SuccessOrError_t Grp_DB_AddStdToGrpIfOpenAndNotFull (long UsrCod,long GrpCod)
+  {
+   return
+   DB_QueryINSERTandReturnNumRows ("can not add a user to a group",
+				   "INSERT IGNORE INTO grp_users"
+				   " (GrpCod,UsrCod)"
+				   " SELECT grp_groups.GrpCod,"
+					   "%ld"
+				     " FROM grp_groups,"
+					  "(SELECT COUNT(*) AS NumStds"
+					    " FROM grp_users,"
+						  "grp_groups,"
+						  "grp_types,"
+						  "crs_users"
+					   " WHERE grp_users.GrpCod=%ld"
+					     " AND grp_users.GrpCod=grp_groups.GrpCod"
+					     " AND grp_groups.GrpTypCod=grp_types.GrpTypCod"
+					     " AND grp_types.CrsCod=crs_users.CrsCod"
+					     " AND grp_users.UsrCod=crs_users.UsrCod"
+					     " AND crs_users.Role=%u) AS grp_seats"
+				    " WHERE grp_groups.GrpCod=%ld"
+				      " AND grp_groups.Open='Y'"
+				      " AND (grp_groups.MaxStudents>%u"
+					 " OR grp_groups.MaxStudents>grp_seats.NumStds)",
+				   UsrCod,
+				   GrpCod,
+				   (unsigned) Rol_STD,
+				   GrpCod,
+				   Grp_MAX_STUDENTS_IN_A_GROUP) ? Err_SUCCESS :
+								  Err_ERROR;
+  }
+
 /*****************************************************************************/
 /************************* Remove a user from a group ************************/
 /*****************************************************************************/
@@ -37,8 +37,6 @@
 /**************************** Public prototypes ******************************/
 /*****************************************************************************/
 
-void Grp_DB_LockTables (void);
-
 long Grp_DB_CreateGroupType (const struct GroupType *GrpTyp);
 void Grp_DB_CreateGroup (long GrpTypCod,const struct Group *Grp);
 
@@ -112,6 +110,7 @@ void Grp_DB_RenameGrp (long GrpCod,
                        const char NewNameGrp[Grp_MAX_BYTES_GROUP_NAME + 1]);
 
 void Grp_DB_AddUsrToGrp (long UsrCod,long GrpCod);
+Err_SuccessOrError_t Grp_DB_AddStdToGrpIfOpenAndNotFull (long UsrCod,long GrpCod);
 
 void Grp_DB_RemoveUsrFromGrp (long UsrCod,long GrpCod);
 void Grp_DB_RemUsrFromAllGrpsInCrs (long UsrCod,long HieCod);
@@ -45,6 +45,7 @@
 #include "swad_help.h"
 #include "swad_hierarchy.h"
 #include "swad_hierarchy_database.h"
+#include "swad_hierarchy_snapshot.h"
 #include "swad_hierarchy_type.h"
 #include "swad_HTML.h"
 #include "swad_institution_database.h"
@@ -116,6 +117,8 @@ static FigCch_FigureCached_t Hie_FiguresCached[Hie_NUM_LEVELS] =
 /***************************** Private prototypes ****************************/
 /*****************************************************************************/
 
+static void Hie_WriteOptionOfChild (Hie_Level_t HieLvl,long HieCod,long SelectedCod,
+				    const char *ShrtName);
 static void Hie_DrawLogo (void);
 
 static Hie_StatusTxt_t Hie_GetStatusTxtFromStatusBits (Hie_Status_t Status);
@@ -267,6 +270,99 @@ void Hie_WriteMenuHierarchy (void)
    HTM_TABLE_End ();
   }
 
+/*****************************************************************************/
+/****** Write options of a selector with the children of current node ********/
+/*****************************************************************************/
+// HieLvl is the level of the children (institution, center, degree or course)
+// Children are got from snapshot of hierarchy, or from database if not available
+
+void Hie_WriteOptionsOfChildren (Hie_Level_t HieLvl,long SelectedCod)
+  {
+   struct HieSnp_Child *Children;
+   unsigned NumChildren;
+   unsigned NumChild;
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+
+   switch (HieSnp_GetChildren (HieLvl,Gbl.Hierarchy.Node[HieLvl - 1].HieCod,
+			       &NumChildren,&Children))
+     {
+      case Err_SUCCESS:
+	 /***** Write children from snapshot *****/
+	 for (NumChild = 0;
+	      NumChild < NumChildren;
+	      NumChild++)
+	    Hie_WriteOptionOfChild (HieLvl,Children[NumChild].HieCod,SelectedCod,
+				    Children[NumChild].ShrtName);
+
+	 /***** Free list of children *****/
+	 free (Children);
+	 break;
+      case Err_ERROR:
+      default:
+	 /***** Get children from database *****/
+	 switch (HieLvl)
+	   {
+	    case Hie_INS:
+	       NumChildren = Ins_DB_GetInssInCtyOrderedByShrtName (&mysql_res,
+								   Gbl.Hierarchy.Node[Hie_CTY].HieCod);
+	       break;
+	    case Hie_CTR:
+	       NumChildren = Ctr_DB_GetBasicListOfCtrsInCurrentIns (&mysql_res);
+	       break;
+	    case Hie_DEG:
+	       NumChildren = Deg_DB_GetDegsOfCurrentCtrBasic (&mysql_res);
+	       break;
+	    case Hie_CRS:
+	       NumChildren = Crs_DB_GetCrssInCurrentDegBasic (&mysql_res);
+	       break;
+	    default:
+	       Err_WrongHierarchyLevelExit ();
+	       return;
+	   }
+
+	 /***** Write children from database *****/
+	 for (NumChild = 0;
+	      NumChild < NumChildren;
+	      NumChild++)
+	   {
+	    /* Get code (row[0]) and short name (row[1]) */
+	    row = mysql_fetch_row (mysql_res);
+	    Hie_WriteOptionOfChild (HieLvl,Str_ConvertStrCodToLongCod (row[0]),SelectedCod,
+				    row[1]);
+	   }
+
+	 /***** Free structure that stores the query result *****/
+	 DB_FreeMySQLResult (&mysql_res);
+	 break;
+     }
+  }
+
+/*****************************************************************************/
+/************** Write an option of a selector with a child node **************/
+/*****************************************************************************/
+
+static void Hie_WriteOptionOfChild (Hie_Level_t HieLvl,long HieCod,long SelectedCod,
+				    const char *ShrtName)
+  {
+   static void (*WrongCodExit[Hie_NUM_LEVELS]) (void) =
+     {
+      [Hie_INS] = Err_WrongInstitExit,
+      [Hie_CTR] = Err_WrongCenterExit,
+      [Hie_DEG] = Err_WrongDegreeExit,
+      [Hie_CRS] = Err_WrongCourseExit,
+     };
+
+   if (HieCod <= 0)
+      WrongCodExit[HieLvl] ();
+
+   HTM_OPTION (HTM_Type_LONG,&HieCod,
+	       SelectedCod > 0 &&
+	       HieCod == SelectedCod ? HTM_SELECTED :
+				       HTM_NO_ATTR,
+	       "%s",ShrtName);
+  }
+
 /*****************************************************************************/
 /************* Write hierarchy breadcrumb in the top of the page *************/
 /*****************************************************************************/
@@ -588,7 +684,7 @@ void Hie_InitHierarchy (void)
 
    /***** If course code is available, get course data *****/
    if (Gbl.Hierarchy.Node[Hie_CRS].HieCod > 0)
-      switch (Hie_GetDataByCod[Hie_CRS] (&Gbl.Hierarchy.Node[Hie_CRS]))	// Course found?
+      switch (HieSnp_GetDataByCod (Hie_CRS,&Gbl.Hierarchy.Node[Hie_CRS]))	// Course found?
 	{
 	 case Err_SUCCESS:
 	    Gbl.Hierarchy.Node[Hie_DEG].HieCod = Gbl.Hierarchy.Node[Hie_CRS].PrtCod;
@@ -601,11 +697,11 @@ void Hie_InitHierarchy (void)
 
    /***** If degree code is available, get degree data *****/
    if (Gbl.Hierarchy.Node[Hie_DEG].HieCod > 0)
-      switch (Hie_GetDataByCod[Hie_DEG] (&Gbl.Hierarchy.Node[Hie_DEG]))	// Degree found?
+      switch (HieSnp_GetDataByCod (Hie_DEG,&Gbl.Hierarchy.Node[Hie_DEG]))	// Degree found?
 	{
 	 case Err_SUCCESS:
 	    Gbl.Hierarchy.Node[Hie_CTR].HieCod = Gbl.Hierarchy.Node[Hie_DEG].PrtCod;
-	    Gbl.Hierarchy.Node[Hie_INS].HieCod = Deg_DB_GetInsCodOfDegreeByCod (Gbl.Hierarchy.Node[Hie_DEG].HieCod);
+	    // Institution code is got below from center
 	    break;
 	 case Err_ERROR:
 	 default:
@@ -615,7 +711,7 @@ void Hie_InitHierarchy (void)
 
    /***** If center code is available, get center data *****/
    if (Gbl.Hierarchy.Node[Hie_CTR].HieCod > 0)
-      switch (Hie_GetDataByCod[Hie_CTR] (&Gbl.Hierarchy.Node[Hie_CTR]))	// Center found?
+      switch (HieSnp_GetDataByCod (Hie_CTR,&Gbl.Hierarchy.Node[Hie_CTR]))	// Center found?
 	{
 	 case Err_SUCCESS:
 	    Gbl.Hierarchy.Node[Hie_INS].HieCod = Gbl.Hierarchy.Node[Hie_CTR].PrtCod;
@@ -628,7 +724,7 @@ void Hie_InitHierarchy (void)
 
    /***** If institution code is available, get institution data *****/
    if (Gbl.Hierarchy.Node[Hie_INS].HieCod > 0)
-      switch (Hie_GetDataByCod[Hie_INS] (&Gbl.Hierarchy.Node[Hie_INS]))	// Institution found?
+      switch (HieSnp_GetDataByCod (Hie_INS,&Gbl.Hierarchy.Node[Hie_INS]))	// Institution found?
 	{
 	 case Err_SUCCESS:
 	    Gbl.Hierarchy.Node[Hie_CTY].HieCod = Gbl.Hierarchy.Node[Hie_INS].PrtCod;
@@ -641,7 +737,7 @@ void Hie_InitHierarchy (void)
 
    /***** If country code is available, get country data *****/
    if (Gbl.Hierarchy.Node[Hie_CTY].HieCod > 0)
-      switch (Hie_GetDataByCod[Hie_CTY] (&Gbl.Hierarchy.Node[Hie_CTY]))	// Country found?
+      switch (HieSnp_GetDataByCod (Hie_CTY,&Gbl.Hierarchy.Node[Hie_CTY]))	// Country found?
 	{
 	 case Err_SUCCESS:
 	    break;
@@ -46,6 +46,7 @@ long Hie_GetHieCod (Hie_Level_t HieLvl);
 void Hie_SeePending (void);
 
 void Hie_WriteMenuHierarchy (void);
+void Hie_WriteOptionsOfChildren (Hie_Level_t HieLvl,long SelectedCod);
 void Hie_WriteHierarchyInBreadcrumb (void);
 void Hie_WriteBigNameCtyInsCtrDegCrs (void);
 
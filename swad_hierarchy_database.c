@@ -25,12 +25,21 @@
 /********************************* Headers ***********************************/
 /*****************************************************************************/
 
+#include <stdio.h>		// For snprintf
 #include <string.h>		// For string functions
 
 #include "swad_database.h"
 #include "swad_hierarchy.h"
 #include "swad_hierarchy_database.h"
 #include "swad_hierarchy_type.h"
+#include "swad_language.h"
+#include "swad_string.h"
+
+/*****************************************************************************/
+/***************************** Private constants *****************************/
+/*****************************************************************************/
+
+#define Hie_DB_MAX_BYTES_SUBQUERY_CTYS	((1 + Lan_NUM_LANGUAGES) * 32)
 
 /*****************************************************************************/
 /****************************** Public constants *****************************/
@@ -114,3 +123,106 @@ unsigned Hie_DB_GetInsCtrDegAdminBy (MYSQL_RES **mysql_res,long UsrCod)
 		   (unsigned) Hie_CTR,UsrCod,Hie_GetDBStrFromLevel (Hie_CTR),
 		   (unsigned) Hie_DEG,UsrCod,Hie_GetDBStrFromLevel (Hie_DEG));
   }
+
+/*****************************************************************************/
+/********* Get all nodes in a level of the hierarchy to build snapshot *******/
+/*****************************************************************************/
+// Only for institutions, centers, degrees and courses.
+// Sorted by parent and short name, as in selectors of children
+
+unsigned Hie_DB_GetAllNodesForSnapshot (MYSQL_RES **mysql_res,Hie_Level_t HieLvl)
+  {
+   static const struct
+     {
+      const char *Fields;
+      const char *Table;
+     } Query[Hie_NUM_LEVELS] =
+     {
+      [Hie_INS] = {"InsCod,"		// row[0]
+		   "CtyCod,"		// row[1]
+		   "-1,"		// row[2]
+		   "Status,"		// row[3]
+		   "RequesterUsrCod,"	// row[4]
+		   "'',"		// row[5]
+		   "ShortName,"		// row[6]
+		   "FullName,"		// row[7]
+		   "WWW",		// row[8]
+		   "ins_instits"},
+      [Hie_CTR] = {"CtrCod,"		// row[0]
+		   "InsCod,"		// row[1]
+		   "PlcCod,"		// row[2]
+		   "Status,"		// row[3]
+		   "RequesterUsrCod,"	// row[4]
+		   "'',"		// row[5]
+		   "ShortName,"		// row[6]
+		   "FullName,"		// row[7]
+		   "WWW",		// row[8]
+		   "ctr_centers"},
+      [Hie_DEG] = {"DegCod,"		// row[0]
+		   "CtrCod,"		// row[1]
+		   "DegTypCod,"		// row[2]
+		   "Status,"		// row[3]
+		   "RequesterUsrCod,"	// row[4]
+		   "'',"		// row[5]
+		   "ShortName,"		// row[6]
+		   "FullName,"		// row[7]
+		   "WWW",		// row[8]
+		   "deg_degrees"},
+      [Hie_CRS] = {"CrsCod,"		// row[0]
+		   "DegCod,"		// row[1]
+		   "Year,"		// row[2]
+		   "Status,"		// row[3]
+		   "RequesterUsrCod,"	// row[4]
+		   "InsCrsCod,"		// row[5]
+		   "ShortName,"		// row[6]
+		   "FullName,"		// row[7]
+		   "''",		// row[8]
+		   "crs_courses"},
+     };
+
+   return (unsigned)
+   DB_QuerySELECT (mysql_res,"can not get nodes of hierarchy",
+		   "SELECT %s"
+		    " FROM %s"
+		" ORDER BY 2,7",	// Sorted by parent code and short name
+		   Query[HieLvl].Fields,
+		   Query[HieLvl].Table);
+  }
+
+/*****************************************************************************/
+/********** Get all countries in all languages to build snapshot *************/
+/*****************************************************************************/
+
+unsigned Hie_DB_GetAllCtysForSnapshot (MYSQL_RES **mysql_res)
+  {
+   extern const char *Lan_STR_LANG_ID[1 + Lan_NUM_LANGUAGES];
+   char StrField[32];
+   char SubQueryNam[Hie_DB_MAX_BYTES_SUBQUERY_CTYS + 1];
+   char SubQueryWWW[Hie_DB_MAX_BYTES_SUBQUERY_CTYS + 1];
+   Lan_Language_t Lan;
+
+   /***** Build subqueries with names and webs in all languages *****/
+   SubQueryNam[0] = '\0';
+   SubQueryWWW[0] = '\0';
+   for (Lan  = (Lan_Language_t) 1;
+	Lan <= (Lan_Language_t) Lan_NUM_LANGUAGES;
+	Lan++)
+     {
+      snprintf (StrField,sizeof (StrField),",Name_%s",Lan_STR_LANG_ID[Lan]);
+      Str_Concat (SubQueryNam,StrField,sizeof (SubQueryNam) - 1);
+
+      snprintf (StrField,sizeof (StrField),",WWW_%s",Lan_STR_LANG_ID[Lan]);
+      Str_Concat (SubQueryWWW,StrField,sizeof (SubQueryWWW) - 1);
+     }
+
+   /***** Query database *****/
+   return (unsigned)
+   DB_QuerySELECT (mysql_res,"can not get countries",
+		   "SELECT CtyCod,"	// row[0]
+			  "Alpha2"	// row[1]
+			  "%s"		// row[2...1+Lan_NUM_LANGUAGES]
+			  "%s"		// row[2+Lan_NUM_LANGUAGES...]
+		    " FROM cty_countrs"
+		" ORDER BY CtyCod",
+		   SubQueryNam,SubQueryWWW);
+  }
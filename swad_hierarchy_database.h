@@ -47,4 +47,7 @@ typedef enum
 void Hie_DB_BuildSubquery (char SubQuery[128],Hie_Level_t HieLvl,long HieCod);
 unsigned Hie_DB_GetInsCtrDegAdminBy (MYSQL_RES **mysql_res,long UsrCod);
 
+unsigned Hie_DB_GetAllNodesForSnapshot (MYSQL_RES **mysql_res,Hie_Level_t HieLvl);
+unsigned Hie_DB_GetAllCtysForSnapshot (MYSQL_RES **mysql_res);
+
 #endif
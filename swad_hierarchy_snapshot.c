@@ -0,0 +1,771 @@
+// swad_hierarchy_snapshot.c: read-only snapshot of the hierarchy shared by all processes
+/*
+    SWAD (Shared Workspace At a Distance),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2026 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/********************************* Headers ***********************************/
+/*****************************************************************************/
+
+#define _GNU_SOURCE 		// For asprintf
+#include <fcntl.h>		// For open
+#include <stdio.h>		// For asprintf, fopen, fwrite, rename
+#include <stdlib.h>		// For bsearch, free, malloc, qsort, realloc
+#include <string.h>		// For memcpy, strlen
+#include <sys/file.h>		// For flock
+#include <sys/mman.h>		// For mmap, munmap
+#include <sys/stat.h>		// For fstat, stat
+#include <time.h>		// For struct timespec
+#include <unistd.h>		// For close, getpid, unlink
+
+#include "swad_config.h"
+#include "swad_database.h"
+#include "swad_degree.h"
+#include "swad_error.h"
+#include "swad_file.h"
+#include "swad_global.h"
+#include "swad_hierarchy.h"
+#include "swad_hierarchy_database.h"
+#include "swad_hierarchy_snapshot.h"
+#include "swad_language.h"
+#include "swad_string.h"
+
+/*****************************************************************************/
+/************** External global variables from others modules ****************/
+/*****************************************************************************/
+
+extern struct Globals Gbl;
+
+/*****************************************************************************/
+/***************************** Private constants *****************************/
+/*****************************************************************************/
+
+#define HieSnp_FILE_SNAPSHOT	"snapshot"	// Snapshot mapped by readers
+#define HieSnp_FILE_STAMP	"stamp"		// Touched each time the hierarchy changes
+#define HieSnp_FILE_LOCK	"lock"		// Locked while snapshot is being built
+
+#define HieSnp_MAGIC	0x504E5348U	// "HSNP"
+#define HieSnp_FORMAT	2		// Increment when file layout changes
+
+/*****************************************************************************/
+/******************************* Private types *******************************/
+/*****************************************************************************/
+
+/*
+   Layout of snapshot file (native byte order, only read by this program):
+   header
+   sorted array of countries
+   sorted array of institutions
+   sorted array of centers
+   sorted array of degrees
+   sorted array of courses
+   for institutions, centers, degrees and courses,
+   array of indexes in sorted array ordered by parent and short name
+   pool of strings (offset 0 is the empty string)
+*/
+struct HieSnp_Header
+  {
+   unsigned Magic;
+   unsigned Format;
+   struct timespec BuildTime;			// Time when building began
+   unsigned NumNodes[Hie_NUM_LEVELS];		// Number of nodes in each level
+   size_t NodesOffset[Hie_NUM_LEVELS];		// Offset of array of nodes in each level
+   size_t ByPrtOffset[Hie_NUM_LEVELS];		// Offset of array of indexes by parent
+   size_t PoolOffset;				// Offset of pool of strings
+   size_t Size;					// Total size of file
+  };
+
+struct HieSnp_Cty	// HieCod must be the first field, used in binary search
+  {
+   long HieCod;
+   unsigned Alpha2;				// Offsets in pool of strings
+   unsigned Name[1 + Lan_NUM_LANGUAGES];
+   unsigned WWW [1 + Lan_NUM_LANGUAGES];
+  };
+
+struct HieSnp_Node	// HieCod must be the first field, used in binary search
+  {
+   long HieCod;
+   long PrtCod;
+   long Specific;				// Place, degree type or year
+   unsigned Status;
+   long RequesterUsrCod;
+   unsigned InstitutionalCod;			// Offsets in pool of strings
+   unsigned ShrtName;
+   unsigned FullName;
+   unsigned WWW;
+  };
+
+struct HieSnp_NodeInRow	// Node and its position in query result
+  {
+   struct HieSnp_Node Node;			// Must be the first field, used in sorting
+   unsigned NumRow;
+  };
+
+struct HieSnp_Pool
+  {
+   char *Str;
+   size_t Size;
+   size_t Allocated;
+  };
+
+/*****************************************************************************/
+/************************* Private global variables **************************/
+/*****************************************************************************/
+
+static struct
+  {
+   const char *Addr;	// NULL if not mapped
+   size_t Size;
+  } HieSnp_Snapshot =
+  {
+   .Addr = NULL,
+  };
+
+/*****************************************************************************/
+/***************************** Private prototypes ****************************/
+/*****************************************************************************/
+
+static Err_SuccessOrError_t HieSnp_MapFile (void);
+static Err_SuccessOrError_t HieSnp_Build (void);
+static Err_SuccessOrError_t HieSnp_WriteFile (const char *PathTmp);
+static void HieSnp_GetCtys (struct HieSnp_Header *Header,
+			    struct HieSnp_Cty **Ctys,
+			    struct HieSnp_Pool *Pool);
+static void HieSnp_GetNodes (Hie_Level_t HieLvl,
+			     struct HieSnp_Header *Header,
+			     struct HieSnp_Node **Nodes,
+			     unsigned **ByPrt,
+			     struct HieSnp_Pool *Pool);
+static unsigned HieSnp_AddStrToPool (struct HieSnp_Pool *Pool,const char *Str);
+static int HieSnp_CompareCods (const void *Key,const void *Item);
+
+/*****************************************************************************/
+/************** Invalidate snapshot after a change in hierarchy **************/
+/*****************************************************************************/
+// Must be called after the change has been written into database
+
+void HieSnp_Invalidate (void)
+  {
+   int FileDescriptor;
+
+   /***** Touch stamp file (snapshots built before are no longer valid) *****/
+   Fil_CreateDirIfNotExists (Cfg_PATH_HIE_SNAPSHOT_PRIVATE);
+   if ((FileDescriptor = open (Cfg_PATH_HIE_SNAPSHOT_PRIVATE "/" HieSnp_FILE_STAMP,
+			       O_WRONLY | O_CREAT,0600)) >= 0)
+     {
+      futimens (FileDescriptor,NULL);	// Set modification time to now
+      close (FileDescriptor);
+     }
+
+   /***** The snapshot mapped by this process is no longer valid *****/
+   HieSnp_Unmap ();
+  }
+
+/*****************************************************************************/
+/******** Map a valid snapshot of the hierarchy, building it if needed *******/
+/*****************************************************************************/
+// Return Err_ERROR if no valid snapshot is available,
+// for example if other process is building it right now.
+// In that case the caller should query the database.
+
+Err_SuccessOrError_t HieSnp_Map (void)
+  {
+   if (HieSnp_MapFile () == Err_SUCCESS)
+      return Err_SUCCESS;
+
+   if (HieSnp_Build () == Err_ERROR)
+      return Err_ERROR;
+
+   return HieSnp_MapFile ();
+  }
+
+/*****************************************************************************/
+/************************ Unmap snapshot of hierarchy ************************/
+/*****************************************************************************/
+
+void HieSnp_Unmap (void)
+  {
+   if (HieSnp_Snapshot.Addr)
+     {
+      munmap ((void *) HieSnp_Snapshot.Addr,HieSnp_Snapshot.Size);
+      HieSnp_Snapshot.Addr = NULL;
+     }
+  }
+
+/*****************************************************************************/
+/********** Map snapshot file if it exists and it is not outdated ************/
+/*****************************************************************************/
+
+static Err_SuccessOrError_t HieSnp_MapFile (void)
+  {
+   int FileDescriptor;
+   struct stat FileStatus;
+   struct stat StampStatus;
+   void *Addr;
+   const struct HieSnp_Header *Header;
+   Err_SuccessOrError_t SuccessOrError = Err_ERROR;
+
+   /***** Trivial check: already mapped? *****/
+   if (HieSnp_Snapshot.Addr)
+      return Err_SUCCESS;
+
+   /***** Open snapshot file *****/
+   if ((FileDescriptor = open (Cfg_PATH_HIE_SNAPSHOT_PRIVATE "/" HieSnp_FILE_SNAPSHOT,
+			       O_RDONLY)) < 0)
+      return Err_ERROR;
+
+   if (fstat (FileDescriptor,&FileStatus) == 0 &&
+       (size_t) FileStatus.st_size >= sizeof (struct HieSnp_Header))
+     {
+      /***** Map the whole file.
+             The file is never modified, only replaced by rename,
+             so the mapping remains consistent while in use *****/
+      if ((Addr = mmap (NULL,(size_t) FileStatus.st_size,PROT_READ,MAP_SHARED,
+                        FileDescriptor,0)) != MAP_FAILED)
+	{
+	 Header = (const struct HieSnp_Header *) Addr;
+
+	 /***** Check header and compare with stamp *****/
+	 if (Header->Magic  == HieSnp_MAGIC &&
+	     Header->Format == HieSnp_FORMAT &&
+	     Header->Size   == (size_t) FileStatus.st_size)
+	   {
+	    if (stat (Cfg_PATH_HIE_SNAPSHOT_PRIVATE "/" HieSnp_FILE_STAMP,
+		      &StampStatus) != 0)	// No stamp ==> never changed
+	       SuccessOrError = Err_SUCCESS;
+	    else if (Header->BuildTime.tv_sec  >  StampStatus.st_mtim.tv_sec ||
+		     (Header->BuildTime.tv_sec  == StampStatus.st_mtim.tv_sec &&
+		      Header->BuildTime.tv_nsec >  StampStatus.st_mtim.tv_nsec))
+	       SuccessOrError = Err_SUCCESS;	// Built after last change
+	   }
+
+	 switch (SuccessOrError)
+	   {
+	    case Err_SUCCESS:
+	       HieSnp_Snapshot.Addr = (const char *) Addr;
+	       HieSnp_Snapshot.Size = (size_t) FileStatus.st_size;
+	       break;
+	    case Err_ERROR:
+	    default:
+	       munmap (Addr,(size_t) FileStatus.st_size);
+	       break;
+	   }
+	}
+     }
+
+   /***** The mapping does not need the file descriptor *****/
+   close (FileDescriptor);
+
+   return SuccessOrError;
+  }
+
+/*****************************************************************************/
+/********************* Build a new snapshot of hierarchy *********************/
+/*****************************************************************************/
+// Only one process builds the snapshot at a time.
+// The others don't wait and use the database meanwhile.
+
+static Err_SuccessOrError_t HieSnp_Build (void)
+  {
+   int LockFileDescriptor;
+   char *PathTmp;
+   Err_SuccessOrError_t SuccessOrError = Err_ERROR;
+
+   /***** Lock *****/
+   Fil_CreateDirIfNotExists (Cfg_PATH_HIE_SNAPSHOT_PRIVATE);
+   if ((LockFileDescriptor = open (Cfg_PATH_HIE_SNAPSHOT_PRIVATE "/" HieSnp_FILE_LOCK,
+				   O_RDWR | O_CREAT,0600)) < 0)
+      return Err_ERROR;
+   if (flock (LockFileDescriptor,LOCK_EX | LOCK_NB) != 0)	// Other process is building it
+     {
+      close (LockFileDescriptor);
+      return Err_ERROR;
+     }
+
+   /***** Other process may have built it while we were checking *****/
+   if (HieSnp_MapFile () == Err_SUCCESS)
+      SuccessOrError = Err_SUCCESS;
+   else
+     {
+      /***** Write snapshot into a temporary file
+             and replace old snapshot atomically *****/
+      if (asprintf (&PathTmp,"%s/%s.%d",
+		    Cfg_PATH_HIE_SNAPSHOT_PRIVATE,HieSnp_FILE_SNAPSHOT,
+		    (int) getpid ()) < 0)
+	 Err_NotEnoughMemoryExit ();
+
+      if (HieSnp_WriteFile (PathTmp) == Err_SUCCESS)
+	 if (rename (PathTmp,Cfg_PATH_HIE_SNAPSHOT_PRIVATE "/" HieSnp_FILE_SNAPSHOT) == 0)
+	    SuccessOrError = Err_SUCCESS;
+      if (SuccessOrError == Err_ERROR)
+	 unlink (PathTmp);
+
+      free (PathTmp);
+     }
+
+   /***** Unlock *****/
+   flock (LockFileDescriptor,LOCK_UN);
+   close (LockFileDescriptor);
+
+   return SuccessOrError;
+  }
+
+/*****************************************************************************/
+/********************** Write snapshot into a new file ***********************/
+/*****************************************************************************/
+
+static Err_SuccessOrError_t HieSnp_WriteFile (const char *PathTmp)
+  {
+   FILE *FileTmp;
+   struct stat FileStatus;
+   struct HieSnp_Header Header;
+   struct HieSnp_Cty *Ctys = NULL;
+   struct HieSnp_Node *Nodes[Hie_NUM_LEVELS] = {NULL};
+   unsigned *ByPrt[Hie_NUM_LEVELS] = {NULL};
+   struct HieSnp_Pool Pool =
+     {
+      .Str       = NULL,
+      .Size      = 0,
+      .Allocated = 0,
+     };
+   Hie_Level_t HieLvl;
+   size_t Offset;
+   Err_SuccessOrError_t SuccessOrError = Err_SUCCESS;
+
+   /***** Create temporary file *****/
+   if ((FileTmp = fopen (PathTmp,"wb")) == NULL)
+      return Err_ERROR;
+
+   /***** Build time is the modification time of the new file,
+          taken before reading the database, so that any change
+          made while building will outdate this snapshot.
+          The same clock is used to set the time of the stamp. *****/
+   memset (&Header,0,sizeof (Header));
+   if (fstat (fileno (FileTmp),&FileStatus) != 0)
+     {
+      fclose (FileTmp);
+      return Err_ERROR;
+     }
+   Header.Magic     = HieSnp_MAGIC;
+   Header.Format    = HieSnp_FORMAT;
+   Header.BuildTime = FileStatus.st_mtim;
+
+   /***** Get all nodes from database *****/
+   HieSnp_AddStrToPool (&Pool,"");	// Offset 0 is the empty string
+   HieSnp_GetCtys (&Header,&Ctys,&Pool);
+   for (HieLvl  = Hie_INS;
+	HieLvl <= Hie_CRS;
+	HieLvl++)
+      HieSnp_GetNodes (HieLvl,&Header,&Nodes[HieLvl],&ByPrt[HieLvl],&Pool);
+
+   /***** Compute offsets *****/
+   Offset = sizeof (Header);
+   Header.NodesOffset[Hie_CTY] = Offset;
+   Offset += Header.NumNodes[Hie_CTY] * sizeof (struct HieSnp_Cty);
+   for (HieLvl  = Hie_INS;
+	HieLvl <= Hie_CRS;
+	HieLvl++)
+     {
+      Header.NodesOffset[HieLvl] = Offset;
+      Offset += Header.NumNodes[HieLvl] * sizeof (struct HieSnp_Node);
+     }
+   for (HieLvl  = Hie_INS;
+	HieLvl <= Hie_CRS;
+	HieLvl++)
+     {
+      Header.ByPrtOffset[HieLvl] = Offset;
+      Offset += Header.NumNodes[HieLvl] * sizeof (unsigned);
+     }
+   Header.PoolOffset = Offset;
+   Header.Size = Offset + Pool.Size;
+
+   /***** Write file *****/
+   if (fwrite (&Header,sizeof (Header),1,FileTmp) != 1)
+      SuccessOrError = Err_ERROR;
+   if (SuccessOrError == Err_SUCCESS && Header.NumNodes[Hie_CTY])
+      if (fwrite (Ctys,sizeof (struct HieSnp_Cty),Header.NumNodes[Hie_CTY],
+		  FileTmp) != Header.NumNodes[Hie_CTY])
+	 SuccessOrError = Err_ERROR;
+   for (HieLvl  = Hie_INS;
+	HieLvl <= Hie_CRS;
+	HieLvl++)
+      if (SuccessOrError == Err_SUCCESS && Header.NumNodes[HieLvl])
+	 if (fwrite (Nodes[HieLvl],sizeof (struct HieSnp_Node),Header.NumNodes[HieLvl],
+		     FileTmp) != Header.NumNodes[HieLvl])
+	    SuccessOrError = Err_ERROR;
+   for (HieLvl  = Hie_INS;
+	HieLvl <= Hie_CRS;
+	HieLvl++)
+      if (SuccessOrError == Err_SUCCESS && Header.NumNodes[HieLvl])
+	 if (fwrite (ByPrt[HieLvl],sizeof (unsigned),Header.NumNodes[HieLvl],
+		     FileTmp) != Header.NumNodes[HieLvl])
+	    SuccessOrError = Err_ERROR;
+   if (SuccessOrError == Err_SUCCESS)
+      if (fwrite (Pool.Str,1,Pool.Size,FileTmp) != Pool.Size)
+	 SuccessOrError = Err_ERROR;
+   if (fclose (FileTmp) != 0)
+      SuccessOrError = Err_ERROR;
+
+   /***** Free memory *****/
+   free (Pool.Str);
+   for (HieLvl  = Hie_INS;
+	HieLvl <= Hie_CRS;
+	HieLvl++)
+     {
+      free (ByPrt[HieLvl]);
+      free (Nodes[HieLvl]);
+     }
+   free (Ctys);
+
+   return SuccessOrError;
+  }
+
+/*****************************************************************************/
+/************** Get all countries from database into snapshot ****************/
+/*****************************************************************************/
+
+static void HieSnp_GetCtys (struct HieSnp_Header *Header,
+			    struct HieSnp_Cty **Ctys,
+			    struct HieSnp_Pool *Pool)
+  {
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   unsigned NumCty;
+   struct HieSnp_Cty *Cty;
+   Lan_Language_t Lan;
+
+   /***** Get countries from database *****/
+   if ((Header->NumNodes[Hie_CTY] = Hie_DB_GetAllCtysForSnapshot (&mysql_res)))
+     {
+      if ((*Ctys = calloc ((size_t) Header->NumNodes[Hie_CTY],
+			   sizeof (struct HieSnp_Cty))) == NULL)
+	 Err_NotEnoughMemoryExit ();
+
+      for (NumCty = 0, Cty = *Ctys;
+	   NumCty < Header->NumNodes[Hie_CTY];
+	   NumCty++, Cty++)
+	{
+	 row = mysql_fetch_row (mysql_res);
+	 /*
+	 row[0]:			CtyCod
+	 row[1]:			Alpha2
+	 row[2...1+NumLanguages]:	Name in each language
+	 row[2+NumLanguages...]:	WWW in each language
+	 */
+	 Cty->HieCod = Str_ConvertStrCodToLongCod (row[0]);
+	 Cty->Alpha2 = HieSnp_AddStrToPool (Pool,row[1]);
+	 for (Lan  = (Lan_Language_t) 1;
+	      Lan <= (Lan_Language_t) Lan_NUM_LANGUAGES;
+	      Lan++)
+	   {
+	    Cty->Name[Lan] = HieSnp_AddStrToPool (Pool,row[1 + Lan]);
+	    Cty->WWW [Lan] = HieSnp_AddStrToPool (Pool,row[1 + Lan_NUM_LANGUAGES + Lan]);
+	   }
+	}
+     }
+
+   /***** Free structure that stores the query result *****/
+   DB_FreeMySQLResult (&mysql_res);
+  }
+
+/*****************************************************************************/
+/******* Get all nodes in a level from database into snapshot ****************/
+/*****************************************************************************/
+// Nodes are sorted by code.
+// ByPrt gets the indexes of nodes ordered by parent and short name
+
+static void HieSnp_GetNodes (Hie_Level_t HieLvl,
+			     struct HieSnp_Header *Header,
+			     struct HieSnp_Node **Nodes,
+			     unsigned **ByPrt,
+			     struct HieSnp_Pool *Pool)
+  {
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   unsigned NumNode;
+   struct HieSnp_NodeInRow *Rows;
+   struct HieSnp_Node *Node;
+
+   /***** Get nodes from database, ordered by parent and short name *****/
+   if ((Header->NumNodes[HieLvl] = Hie_DB_GetAllNodesForSnapshot (&mysql_res,HieLvl)))
+     {
+      if ((Rows = calloc ((size_t) Header->NumNodes[HieLvl],
+			  sizeof (struct HieSnp_NodeInRow))) == NULL)
+	 Err_NotEnoughMemoryExit ();
+
+      for (NumNode = 0;
+	   NumNode < Header->NumNodes[HieLvl];
+	   NumNode++)
+	{
+	 row = mysql_fetch_row (mysql_res);
+	 Rows[NumNode].NumRow = NumNode;
+	 Node = &Rows[NumNode].Node;
+	 /*
+	 row[0]: HieCod
+	 row[1]: PrtCod
+	 row[2]: PlcCod, DegTypCod or Year
+	 row[3]: Status
+	 row[4]: RequesterUsrCod
+	 row[5]: InstitutionalCod
+	 row[6]: ShortName
+	 row[7]: FullName
+	 row[8]: WWW
+	 */
+	 Node->HieCod   = Str_ConvertStrCodToLongCod (row[0]);
+	 Node->PrtCod   = Str_ConvertStrCodToLongCod (row[1]);
+	 Node->Specific = HieLvl == Hie_CRS ? (long) Deg_ConvStrToYear (row[2]) :
+					      Str_ConvertStrCodToLongCod (row[2]);
+	 if (sscanf (row[3],"%u",&Node->Status) != 1)
+	    Err_WrongStatusExit ();
+	 Node->RequesterUsrCod  = Str_ConvertStrCodToLongCod (row[4]);
+	 Node->InstitutionalCod = HieSnp_AddStrToPool (Pool,row[5]);
+	 Node->ShrtName         = HieSnp_AddStrToPool (Pool,row[6]);
+	 Node->FullName         = HieSnp_AddStrToPool (Pool,row[7]);
+	 Node->WWW              = HieSnp_AddStrToPool (Pool,row[8]);
+	}
+
+      /***** Sort nodes by code and keep their order by parent *****/
+      qsort (Rows,(size_t) Header->NumNodes[HieLvl],sizeof (struct HieSnp_NodeInRow),
+	     HieSnp_CompareCods);	// HieCod is the first field
+      if ((*Nodes = malloc ((size_t) Header->NumNodes[HieLvl] *
+			    sizeof (struct HieSnp_Node))) == NULL)
+	 Err_NotEnoughMemoryExit ();
+      if ((*ByPrt = malloc ((size_t) Header->NumNodes[HieLvl] *
+			    sizeof (unsigned))) == NULL)
+	 Err_NotEnoughMemoryExit ();
+      for (NumNode = 0;
+	   NumNode < Header->NumNodes[HieLvl];
+	   NumNode++)
+	{
+	 (*Nodes)[NumNode] = Rows[NumNode].Node;
+	 (*ByPrt)[Rows[NumNode].NumRow] = NumNode;
+	}
+
+      free (Rows);
+     }
+
+   /***** Free structure that stores the query result *****/
+   DB_FreeMySQLResult (&mysql_res);
+  }
+
+/*****************************************************************************/
+/*********** Add a string to pool and return its offset in pool **************/
+/*****************************************************************************/
+
+static unsigned HieSnp_AddStrToPool (struct HieSnp_Pool *Pool,const char *Str)
+  {
+   size_t Length;
+   size_t Offset;
+
+   /***** Empty strings share offset 0 *****/
+   if (Pool->Size && (Str == NULL || Str[0] == '\0'))
+      return 0;
+
+   /***** Enlarge pool if needed *****/
+   Length = strlen (Str) + 1;
+   if (Pool->Size + Length > Pool->Allocated)
+     {
+      Pool->Allocated = Pool->Allocated ? Pool->Allocated * 2 :
+					  64 * 1024;
+      while (Pool->Size + Length > Pool->Allocated)
+	 Pool->Allocated *= 2;
+      if ((Pool->Str = realloc (Pool->Str,Pool->Allocated)) == NULL)
+	 Err_NotEnoughMemoryExit ();
+     }
+
+   /***** Append string *****/
+   memcpy (&Pool->Str[Pool->Size],Str,Length);
+   Offset = Pool->Size;
+   Pool->Size += Length;
+
+   return (unsigned) Offset;
+  }
+
+/*****************************************************************************/
+/********** Get data of a node from the snapshot given its code **************/
+/*****************************************************************************/
+// Fill the same fields as Hie_GetDataByCod[HieLvl],
+// which is used instead if snapshot is not available
+
+Err_SuccessOrError_t HieSnp_GetDataByCod (Hie_Level_t HieLvl,struct Hie_Node *Node)
+  {
+   extern Err_SuccessOrError_t (*Hie_GetDataByCod[Hie_NUM_LEVELS]) (struct Hie_Node *Node);
+   const struct HieSnp_Header *Header;
+   const char *Pool;
+   const struct HieSnp_Cty *Cty;
+   const struct HieSnp_Node *Snp;
+
+   /***** Use database if code is not valid or snapshot is not available *****/
+   if (Node->HieCod <= 0 || HieSnp_Map () == Err_ERROR)
+      return Hie_GetDataByCod[HieLvl] (Node);
+
+   Header = (const struct HieSnp_Header *) HieSnp_Snapshot.Addr;
+   Pool = HieSnp_Snapshot.Addr + Header->PoolOffset;
+
+   /***** Clear data *****/
+   Node->PrtCod          = -1L;
+   Node->Specific.PlcCod = -1L;
+   Node->Specific.TypCod = -1L;
+   Node->Specific.Year   = 0;
+   Node->Status          = (Hie_Status_t) 0;
+   Node->RequesterUsrCod = -1L;
+   Node->ShrtName[0]     = '\0';
+   Node->FullName[0]     = '\0';
+   Node->WWW[0]          = '\0';
+   Node->NumUsrsWhoClaimToBelong.Status = Cac_INVALID;
+
+   switch (HieLvl)
+     {
+      case Hie_CTY:
+	 if ((Cty = bsearch (&Node->HieCod,
+			     HieSnp_Snapshot.Addr + Header->NodesOffset[Hie_CTY],
+			     (size_t) Header->NumNodes[Hie_CTY],
+			     sizeof (struct HieSnp_Cty),
+			     HieSnp_CompareCods)) == NULL)
+	    return Err_ERROR;
+
+	 /* Alpha-2 code, and name and web of the country in current language */
+	 Str_Copy (Node->ShrtName,Pool + Cty->Alpha2,
+		   sizeof (Node->ShrtName) - 1);
+	 Str_Copy (Node->FullName,Pool + Cty->Name[Gbl.Prefs.Language],
+		   sizeof (Node->FullName) - 1);
+	 Str_Copy (Node->WWW     ,Pool + Cty->WWW [Gbl.Prefs.Language],
+		   sizeof (Node->WWW     ) - 1);
+	 return Err_SUCCESS;
+      case Hie_INS:
+      case Hie_CTR:
+      case Hie_DEG:
+      case Hie_CRS:
+	 if ((Snp = bsearch (&Node->HieCod,
+			     HieSnp_Snapshot.Addr + Header->NodesOffset[HieLvl],
+			     (size_t) Header->NumNodes[HieLvl],
+			     sizeof (struct HieSnp_Node),
+			     HieSnp_CompareCods)) == NULL)
+	    return Err_ERROR;
+
+	 Node->PrtCod          = Snp->PrtCod;
+	 Node->Status          = (Hie_Status_t) Snp->Status;
+	 Node->RequesterUsrCod = Snp->RequesterUsrCod;
+	 switch (HieLvl)
+	   {
+	    case Hie_CTR:
+	       Node->Specific.PlcCod = Snp->Specific;
+	       break;
+	    case Hie_DEG:
+	       Node->Specific.TypCod = Snp->Specific;
+	       break;
+	    case Hie_CRS:
+	       Node->Specific.Year = (unsigned) Snp->Specific;
+	       Str_Copy (Node->InstitutionalCod,Pool + Snp->InstitutionalCod,
+			 sizeof (Node->InstitutionalCod) - 1);
+	       break;
+	    default:
+	       break;
+	   }
+	 Str_Copy (Node->ShrtName,Pool + Snp->ShrtName,sizeof (Node->ShrtName) - 1);
+	 Str_Copy (Node->FullName,Pool + Snp->FullName,sizeof (Node->FullName) - 1);
+	 Str_Copy (Node->WWW     ,Pool + Snp->WWW     ,sizeof (Node->WWW     ) - 1);
+	 return Err_SUCCESS;
+      default:
+	 return Hie_GetDataByCod[HieLvl] (Node);
+     }
+  }
+
+/*****************************************************************************/
+/**** Get children of a node from the snapshot, ordered by short name ********/
+/*****************************************************************************/
+// Return Err_ERROR if snapshot is not available. In that case
+// the caller should query the database.
+// Names point to the mapped snapshot, so they must be used
+// before calling HieSnp_Invalidate or HieSnp_Unmap.
+// List of children must be freed by the caller.
+
+Err_SuccessOrError_t HieSnp_GetChildren (Hie_Level_t HieLvl,long PrtCod,
+					 unsigned *NumChildren,
+					 struct HieSnp_Child **Children)
+  {
+   const struct HieSnp_Header *Header;
+   const char *Pool;
+   const struct HieSnp_Node *Nodes;
+   const unsigned *ByPrt;
+   unsigned Begin;
+   unsigned End;
+   unsigned Middle;
+   unsigned NumChild;
+
+   *NumChildren = 0;
+   *Children = NULL;
+
+   /***** Only levels with parent in snapshot *****/
+   if (HieLvl < Hie_INS || HieLvl > Hie_CRS)
+      return Err_ERROR;
+   if (HieSnp_Map () == Err_ERROR)
+      return Err_ERROR;
+
+   Header = (const struct HieSnp_Header *) HieSnp_Snapshot.Addr;
+   Pool  = HieSnp_Snapshot.Addr + Header->PoolOffset;
+   Nodes = (const struct HieSnp_Node *) (HieSnp_Snapshot.Addr + Header->NodesOffset[HieLvl]);
+   ByPrt = (const unsigned *)           (HieSnp_Snapshot.Addr + Header->ByPrtOffset[HieLvl]);
+
+   /***** Find first child of this parent *****/
+   for (Begin = 0, End = Header->NumNodes[HieLvl];
+	Begin < End;)
+     {
+      Middle = Begin + (End - Begin) / 2;
+      if (Nodes[ByPrt[Middle]].PrtCod < PrtCod)
+	 Begin = Middle + 1;
+      else
+	 End = Middle;
+     }
+
+   /***** Count children, which are consecutive *****/
+   for (End = Begin;
+	End < Header->NumNodes[HieLvl] && Nodes[ByPrt[End]].PrtCod == PrtCod;
+	End++);
+
+   /***** Build list of children *****/
+   if ((*NumChildren = End - Begin))
+     {
+      if ((*Children = malloc ((size_t) *NumChildren * sizeof (**Children))) == NULL)
+	 Err_NotEnoughMemoryExit ();
+      for (NumChild = 0;
+	   NumChild < *NumChildren;
+	   NumChild++)
+	{
+	 (*Children)[NumChild].HieCod   = Nodes[ByPrt[Begin + NumChild]].HieCod;
+	 (*Children)[NumChild].ShrtName = Pool + Nodes[ByPrt[Begin + NumChild]].ShrtName;
+	}
+     }
+
+   return Err_SUCCESS;
+  }
+
+/*****************************************************************************/
+/************** Compare codes for binary search and sorting ******************/
+/*****************************************************************************/
+
+static int HieSnp_CompareCods (const void *Key,const void *Item)
+  {
+   long Cod1 = *((const long *) Key);
+   long Cod2 = *((const long *) Item);	// HieCod is the first field
+
+   return (Cod1 > Cod2) - (Cod1 < Cod2);
+  }
@@ -0,0 +1,56 @@
+// swad_hierarchy_snapshot.h: read-only snapshot of the hierarchy shared by all processes
+
+#ifndef _SWAD_HIE_SNP
+#define _SWAD_HIE_SNP
+/*
+    SWAD (Shared Workspace At a Distance),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2026 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/********************************* Headers ***********************************/
+/*****************************************************************************/
+
+#include "swad_error.h"
+#include "swad_hierarchy_type.h"
+
+/*****************************************************************************/
+/******************************* Public types ********************************/
+/*****************************************************************************/
+
+struct HieSnp_Child
+  {
+   long HieCod;
+   const char *ShrtName;	// Points to the mapped snapshot
+  };
+
+/*****************************************************************************/
+/***************************** Public prototypes *****************************/
+/*****************************************************************************/
+
+void HieSnp_Invalidate (void);
+Err_SuccessOrError_t HieSnp_Map (void);
+void HieSnp_Unmap (void);
+
+Err_SuccessOrError_t HieSnp_GetDataByCod (Hie_Level_t HieLvl,struct Hie_Node *Node);
+Err_SuccessOrError_t HieSnp_GetChildren (Hie_Level_t HieLvl,long PrtCod,
+					 unsigned *NumChildren,
+					 struct HieSnp_Child **Children);
+
+#endif
@@ -0,0 +1,318 @@
+// swad_image.c: in-process image processing
+
+/*
+    SWAD (Shared Workspace At a Distance),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2026 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/********************************* Headers ***********************************/
+/*****************************************************************************/
+
+#define _GNU_SOURCE 		// For asprintf
+#include <stdbool.h>		// For boolean type
+#include <stdio.h>		// For asprintf, snprintf
+#include <stdlib.h>		// For free
+#include <wand/MagickWand.h>	// For image processing library
+
+#include "swad_image.h"
+
+/*****************************************************************************/
+/************************* Private global variables **************************/
+/*****************************************************************************/
+
+static bool Img_LibraryInitialized = false;
+
+static struct
+  {
+   MagickWand *Wand;	// Canvas being built
+   unsigned NumCols;
+   unsigned NumRows;
+   unsigned Width;	// Width of each image in sprite sheet
+   unsigned Height;	// Height of each image in sprite sheet
+  } Img_Sprite =
+  {
+   .Wand = NULL,
+  };
+
+/*****************************************************************************/
+/***************************** Private prototypes ****************************/
+/*****************************************************************************/
+
+static MagickWand *Img_NewWand (void);
+static void Img_SetSizeHint (MagickWand *Wand,unsigned Width,unsigned Height);
+static MagickBooleanType Img_Resize (MagickWand *Wand,
+				     unsigned Width,unsigned Height,
+				     Img_HowToResize_t HowToResize);
+
+/*****************************************************************************/
+/************ Create a new wand, initializing library if needed **************/
+/*****************************************************************************/
+// The library is initialized only in the few requests that process images
+
+static MagickWand *Img_NewWand (void)
+  {
+   if (!Img_LibraryInitialized)
+     {
+      MagickWandGenesis ();
+      Img_LibraryInitialized = true;
+     }
+
+   return NewMagickWand ();
+  }
+
+/*****************************************************************************/
+/****************** Release image library at end of program *****************/
+/*****************************************************************************/
+
+void Img_Cleanup (void)
+  {
+   if (Img_Sprite.Wand)
+      Img_Sprite.Wand = DestroyMagickWand (Img_Sprite.Wand);
+
+   if (Img_LibraryInitialized)
+     {
+      MagickWandTerminus ();
+      Img_LibraryInitialized = false;
+     }
+  }
+
+/*****************************************************************************/
+/******************* Give a size hint to the JPEG decoder ********************/
+/*****************************************************************************/
+// The JPEG decoder can scale down by 1/2, 1/4 or 1/8 while decoding,
+// which is much faster than decoding the full image and resizing it.
+// It is ignored for other formats.
+
+static void Img_SetSizeHint (MagickWand *Wand,unsigned Width,unsigned Height)
+  {
+   char Size[2 * 10 + 1 + 1];
+
+   snprintf (Size,sizeof (Size),"%ux%u",Width,Height);
+   MagickSetOption (Wand,"jpeg:size",Size);
+  }
+
+/*****************************************************************************/
+/******************** Resize the current image in a wand *********************/
+/*****************************************************************************/
+
+static MagickBooleanType Img_Resize (MagickWand *Wand,
+				     unsigned Width,unsigned Height,
+				     Img_HowToResize_t HowToResize)
+  {
+   size_t OrgWidth  = MagickGetImageWidth  (Wand);
+   size_t OrgHeight = MagickGetImageHeight (Wand);
+   size_t NewWidth;
+   size_t NewHeight;
+
+   switch (HowToResize)
+     {
+      case Img_EXACT_SIZE:
+	 NewWidth  = Width;
+	 NewHeight = Height;
+	 break;
+      case Img_SHRINK_TO_FIT:
+      default:
+	 if (OrgWidth <= Width && OrgHeight <= Height)
+	    return MagickTrue;	// Small enough ==> nothing to do
+
+	 /* Scale to the most restrictive dimension */
+	 if (OrgWidth * Height > OrgHeight * Width)
+	   {
+	    NewWidth  = Width;
+	    NewHeight = (OrgHeight * Width + OrgWidth / 2) / OrgWidth;
+	   }
+	 else
+	   {
+	    NewHeight = Height;
+	    NewWidth  = (OrgWidth * Height + OrgHeight / 2) / OrgHeight;
+	   }
+	 if (NewWidth == 0)
+	    NewWidth = 1;
+	 if (NewHeight == 0)
+	    NewHeight = 1;
+	 break;
+     }
+
+   if (NewWidth == OrgWidth && NewHeight == OrgHeight)
+      return MagickTrue;
+
+   return MagickResizeImage (Wand,NewWidth,NewHeight,LanczosFilter,1.0);
+  }
+
+/*****************************************************************************/
+/*************** Resize an image and save it in another file *****************/
+/*****************************************************************************/
+// Format of destination file is taken from its extension
+
+Err_SuccessOrError_t Img_ResizeImage (const char *PathSrc,const char *PathDst,
+				      unsigned Width,unsigned Height,
+				      Img_HowToResize_t HowToResize,
+				      unsigned Quality)
+  {
+   MagickWand *Wand = Img_NewWand ();
+   MagickBooleanType Success;
+
+   Img_SetSizeHint (Wand,Width,Height);
+   Success = MagickReadImage (Wand,PathSrc);
+   if (Success == MagickTrue)
+      Success = Img_Resize (Wand,Width,Height,HowToResize);
+   if (Success == MagickTrue)
+      Success = MagickSetImageCompressionQuality (Wand,Quality);
+   if (Success == MagickTrue)
+      Success = MagickWriteImage (Wand,PathDst);
+
+   DestroyMagickWand (Wand);
+
+   return Success == MagickTrue ? Err_SUCCESS :
+				  Err_ERROR;
+  }
+
+/*****************************************************************************/
+/************** Save the first frame of an image in another file *************/
+/*****************************************************************************/
+// Format of destination file is taken from its extension
+
+Err_SuccessOrError_t Img_GetFirstFrame (const char *PathSrc,const char *PathDst)
+  {
+   MagickWand *Wand = Img_NewWand ();
+   char *PathFirstFrame;
+   MagickBooleanType Success = MagickFalse;
+
+   /***** Read only the first frame, using suffix [0] *****/
+   if (asprintf (&PathFirstFrame,"%s[0]",PathSrc) >= 0)
+     {
+      Success = MagickReadImage (Wand,PathFirstFrame);
+      free (PathFirstFrame);
+     }
+   if (Success == MagickTrue)
+      Success = MagickWriteImage (Wand,PathDst);
+
+   DestroyMagickWand (Wand);
+
+   return Success == MagickTrue ? Err_SUCCESS :
+				  Err_ERROR;
+  }
+
+/*****************************************************************************/
+/********************* Get the number of frames of an image ******************/
+/*****************************************************************************/
+// Only headers are read, pixels are not decoded
+// Return 0 on error
+
+unsigned Img_GetNumFrames (const char *Path)
+  {
+   MagickWand *Wand = Img_NewWand ();
+   unsigned NumFrames = 0;
+
+   if (MagickPingImage (Wand,Path) == MagickTrue)
+      NumFrames = (unsigned) MagickGetNumberImages (Wand);
+
+   DestroyMagickWand (Wand);
+
+   return NumFrames;
+  }
+
+/*****************************************************************************/
+/**************** Begin a sprite sheet with a grid of images *****************/
+/*****************************************************************************/
+
+Err_SuccessOrError_t Img_BeginSprite (unsigned NumCols,unsigned NumRows,
+				      unsigned Width,unsigned Height)
+  {
+   PixelWand *Background;
+   MagickBooleanType Success;
+
+   /***** Destroy a previous sprite sheet not ended *****/
+   if (Img_Sprite.Wand)
+      Img_Sprite.Wand = DestroyMagickWand (Img_Sprite.Wand);
+
+   /***** Create blank canvas *****/
+   Img_Sprite.Wand    = Img_NewWand ();
+   Img_Sprite.NumCols = NumCols;
+   Img_Sprite.NumRows = NumRows;
+   Img_Sprite.Width   = Width;
+   Img_Sprite.Height  = Height;
+
+   Background = NewPixelWand ();
+   PixelSetColor (Background,"white");
+   Success = MagickNewImage (Img_Sprite.Wand,
+			     (size_t) NumCols * Width,
+			     (size_t) NumRows * Height,
+			     Background);
+   DestroyPixelWand (Background);
+
+   if (Success == MagickFalse)
+     {
+      Img_Sprite.Wand = DestroyMagickWand (Img_Sprite.Wand);
+      return Err_ERROR;
+     }
+   return Err_SUCCESS;
+  }
+
+/*****************************************************************************/
+/*********** Draw an image in its cell (row-major) of sprite sheet ***********/
+/*****************************************************************************/
+
+Err_SuccessOrError_t Img_AddImageToSprite (const char *Path,unsigned NumImg)
+  {
+   MagickWand *Wand;
+   MagickBooleanType Success;
+
+   if (!Img_Sprite.Wand ||
+       NumImg >= Img_Sprite.NumCols * Img_Sprite.NumRows)
+      return Err_ERROR;
+
+   Wand = Img_NewWand ();
+   Img_SetSizeHint (Wand,Img_Sprite.Width,Img_Sprite.Height);
+   Success = MagickReadImage (Wand,Path);
+   if (Success == MagickTrue)
+      Success = Img_Resize (Wand,Img_Sprite.Width,Img_Sprite.Height,Img_EXACT_SIZE);
+   if (Success == MagickTrue)
+      Success = MagickCompositeImage (Img_Sprite.Wand,Wand,OverCompositeOp,
+				      (ssize_t) ((NumImg % Img_Sprite.NumCols) * Img_Sprite.Width),
+				      (ssize_t) ((NumImg / Img_Sprite.NumCols) * Img_Sprite.Height));
+   DestroyMagickWand (Wand);
+
+   return Success == MagickTrue ? Err_SUCCESS :
+				  Err_ERROR;
+  }
+
+/*****************************************************************************/
+/*********************** Save sprite sheet as JPEG ***************************/
+/*****************************************************************************/
+
+Err_SuccessOrError_t Img_EndSprite (const char *PathDst,unsigned Quality)
+  {
+   MagickBooleanType Success;
+
+   if (!Img_Sprite.Wand)
+      return Err_ERROR;
+
+   Success = MagickSetImageFormat (Img_Sprite.Wand,"JPEG");
+   if (Success == MagickTrue)
+      Success = MagickSetImageCompressionQuality (Img_Sprite.Wand,Quality);
+   if (Success == MagickTrue)
+      Success = MagickWriteImage (Img_Sprite.Wand,PathDst);
+
+   Img_Sprite.Wand = DestroyMagickWand (Img_Sprite.Wand);
+
+   return Success == MagickTrue ? Err_SUCCESS :
+				  Err_ERROR;
+  }
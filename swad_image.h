@@ -0,0 +1,60 @@
+// swad_image.h: in-process image processing
+
+#ifndef _SWAD_IMG
+#define _SWAD_IMG
+/*
+    SWAD (Shared Workspace At a Distance),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2026 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/********************************* Headers ***********************************/
+/*****************************************************************************/
+
+#include "swad_error.h"
+
+/*****************************************************************************/
+/******************************* Public types ********************************/
+/*****************************************************************************/
+
+typedef enum
+  {
+   Img_SHRINK_TO_FIT,	// Shrink only if bigger, keeping aspect ratio (like 'WxH>')
+   Img_EXACT_SIZE,	// Resize to exactly the given size (like 'WxH!')
+  } Img_HowToResize_t;
+
+/*****************************************************************************/
+/***************************** Public prototypes *****************************/
+/*****************************************************************************/
+
+void Img_Cleanup (void);
+
+Err_SuccessOrError_t Img_ResizeImage (const char *PathSrc,const char *PathDst,
+				      unsigned Width,unsigned Height,
+				      Img_HowToResize_t HowToResize,
+				      unsigned Quality);
+Err_SuccessOrError_t Img_GetFirstFrame (const char *PathSrc,const char *PathDst);
+unsigned Img_GetNumFrames (const char *Path);
+
+Err_SuccessOrError_t Img_BeginSprite (unsigned NumCols,unsigned NumRows,
+				      unsigned Width,unsigned Height);
+Err_SuccessOrError_t Img_AddImageToSprite (const char *Path,unsigned NumImg);
+Err_SuccessOrError_t Img_EndSprite (const char *PathDst,unsigned Quality);
+
+#endif
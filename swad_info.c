@@ -31,6 +31,7 @@
 #include <stdlib.h>		// For getenv, etc
 #include <stdsoap2.h>		// For SOAP_OK and soap functions
 #include <string.h>		// For string functions
+#include <sys/wait.h>		// For WIFEXITED, WEXITSTATUS
 #include <unistd.h>		// For unlink
 
 #include "swad_action.h"
@@ -38,8 +39,10 @@
 #include "swad_alert.h"
 #include "swad_autolink.h"
 #include "swad_box.h"
+#include "swad_cryptography.h"
 #include "swad_database.h"
 #include "swad_error.h"
+#include "swad_file.h"
 #include "swad_form.h"
 #include "swad_global.h"
 #include "swad_HTML.h"
@@ -47,6 +50,7 @@
 #include "swad_info_database.h"
 #include "swad_parameter.h"
 #include "swad_string.h"
+#include "swad_trace.h"
 #include "swad_tree.h"
 #include "swad_tree_database.h"
 #include "swad_tree_specific.h"
@@ -244,6 +248,11 @@ static Exi_Exist_t Inf_CheckAndShowPlainTxt (Inf_Type_t InfoType);
 
 static Exi_Exist_t Inf_CheckRichTxt (Inf_Type_t InfoType);
 static Exi_Exist_t Inf_CheckAndShowRichTxt (Inf_Type_t InfoType);
+static void Inf_GetMathJaxURL (char MathJaxURL[PATH_MAX + 1]);
+static Err_SuccessOrError_t Inf_RenderMarkdownIntoFile (const char *TxtMD,
+						       const char *MathJaxURL,
+						       const char *Hash,
+						       const char *PathFileHTML);
 
 /*****************************************************************************/
 /*************************** Before and after tree ***************************/
@@ -1820,14 +1829,7 @@ static Exi_Exist_t Inf_CheckAndShowRichTxt (Inf_Type_t InfoType)
    extern const char *Txt_INFO_TITLE[Inf_NUM_TYPES];
    char TxtHTML[Cns_MAX_BYTES_LONG_TEXT + 1];
    char TxtMD[Cns_MAX_BYTES_LONG_TEXT + 1];
-   char PathFileMD[PATH_MAX + 1];
-   char PathFileHTML[PATH_MAX + 1];
-   const char *UniqueNameEncrypted;
-   FILE *FileMD;		// Temporary Markdown file
-   FILE *FileHTML;		// Temporary HTML file
-   char MathJaxURL[PATH_MAX + 1];
-   char Command[512 + PATH_MAX * 3]; // Command to call the program of preprocessing of photos
-   int ReturnCode;
+   FILE *FileHTML;		// HTML rendered from Markdown
 
    /***** Get info text from database *****/
    Inf_GetInfoTxtFromDB (Gbl.Hierarchy.Node[Hie_CRS].HieCod,InfoType,
@@ -1847,113 +1849,215 @@ static Exi_Exist_t Inf_CheckAndShowRichTxt (Inf_Type_t InfoType)
 
       HTM_DIV_Begin ("id=\"crs_info\" class=\"LM CRS_INFO_%s\"",The_GetSuffix ());
 
-	 /***** Store text into a temporary .md file in HTML output directory *****/
-	 // TODO: change to another directory?
-	 /* Create a unique name for the .md file */
-	 UniqueNameEncrypted = Cry_GetUniqueNameEncrypted ();
-	 snprintf (PathFileMD,sizeof (PathFileMD),"%s/%s.md",
-		   Cfg_PATH_OUT_PRIVATE,UniqueNameEncrypted);
-	 snprintf (PathFileHTML,sizeof (PathFileHTML),"%s/%s.md.html",	// Do not use only .html because that is the output temporary file
-		   Cfg_PATH_OUT_PRIVATE,UniqueNameEncrypted);
+	 /***** Copy HTML rendered from Markdown to HTML output *****/
+	 if ((FileHTML = Inf_OpenRichTxtAsHTML (Gbl.Hierarchy.Node[Hie_CRS].HieCod,
+						InfoType,TxtMD)) == NULL)
+	    Err_ShowErrorAndExit ("Can not convert from Markdown to HTML.");
+	 Fil_FastCopyOfOpenFiles (FileHTML,Fil_GetOutputFile ());
+	 fclose (FileHTML);
+
+      HTM_DIV_End ();
 
-	 /* Open Markdown file for writing */
-	 if ((FileMD = fopen (PathFileMD,"wb")) == NULL)
-	    Err_ShowErrorAndExit ("Can not create temporary Markdown file.");
+      return Exi_EXISTS;
+     }
 
-	 /* Write text into Markdown file */
-	 fprintf (FileMD,"%s",TxtMD);
+   return Exi_DOES_NOT_EXIST;
+  }
+
+/*****************************************************************************/
+/**** Open HTML rendered from Markdown, rendering it only if text changed ****/
+/*****************************************************************************/
+// HTML is stored in the private directory of the course,
+// after a first line with a hash of the Markdown text and the options used.
+// If rendering fails, the HTML rendered before from an older text is used.
+// Return the file positioned after that line, or NULL on error
+
+FILE *Inf_OpenRichTxtAsHTML (long HieCod,Inf_Type_t InfoType,const char *TxtMD)
+  {
+   char MathJaxURL[PATH_MAX + 1];
+   char Key[PATH_MAX + 1 + Cns_MAX_BYTES_LONG_TEXT + 1];
+   char Hash[Cry_BYTES_ENCRYPTED_STR_SHA256_BASE64 + 1];
+   char PathDir[PATH_MAX + 1];
+   char PathFileHTML[PATH_MAX + 1];
+   char FirstLine[Cry_BYTES_ENCRYPTED_STR_SHA256_BASE64 + 2];	// Hash + \n
+   FILE *FileHTML;
+
+   /***** Compute hash of options and text *****/
+   Inf_GetMathJaxURL (MathJaxURL);
+   snprintf (Key,sizeof (Key),"%s\n%s",MathJaxURL,TxtMD);
+   Cry_EncryptSHA256Base64 (Key,Hash);
+
+   /***** Build path to HTML file *****/
+   snprintf (PathDir,sizeof (PathDir),"%s/%ld",
+	     Cfg_PATH_CRS_PRIVATE,HieCod);
+   snprintf (PathFileHTML,sizeof (PathFileHTML),"%s/%s.md.html",
+	     PathDir,Inf_FileNamesForInfoType[InfoType]);
+
+   /***** If HTML was rendered from the same text, use it *****/
+   if ((FileHTML = fopen (PathFileHTML,"rb")) != NULL)
+     {
+      if (fgets (FirstLine,sizeof (FirstLine),FileHTML))
+	 if (!strncmp (FirstLine,Hash,Cry_BYTES_ENCRYPTED_STR_SHA256_BASE64))
+	    return FileHTML;
+      fclose (FileHTML);
+     }
+
+   /***** Else render HTML again.
+          On error, the previous HTML file is not replaced,
+          so it is served until the text can be rendered. *****/
+   Fil_CreateDirIfNotExists (PathDir);
+   if (Inf_RenderMarkdownIntoFile (TxtMD,MathJaxURL,Hash,PathFileHTML) == Err_ERROR)
+      if (Fil_CheckIfPathExists (PathFileHTML) == Exi_DOES_NOT_EXIST)
+	 return NULL;	// No previous HTML
+   if ((FileHTML = fopen (PathFileHTML,"rb")) == NULL)
+      return NULL;
+   if (!fgets (FirstLine,sizeof (FirstLine),FileHTML))	// Skip hash
+     {
+      fclose (FileHTML);
+      return NULL;
+     }
+   return FileHTML;
+  }
 
-	 /* Close Markdown file */
-	 fclose (FileMD);
+/*****************************************************************************/
+/***************** Get URL of MathJax to be passed to pandoc *****************/
+/*****************************************************************************/
 
-	 /***** Convert from Markdown to HTML *****/
-	 /* MathJax 2.5.1
+static void Inf_GetMathJaxURL (char MathJaxURL[PATH_MAX + 1])
+  {
+   /* MathJax 2.5.1
 #ifdef Cfg_MATHJAX_LOCAL
-	 // Use the local copy of MathJax
-	 snprintf (MathJaxURL,sizeof (MathJaxURL),
-		   "=%s/MathJax/MathJax.js?config=TeX-AMS-MML_HTMLorMML",
-		   Cfg_URL_SWAD_PUBLIC);
+   // Use the local copy of MathJax
+   snprintf (MathJaxURL,PATH_MAX + 1,
+	     "=%s/MathJax/MathJax.js?config=TeX-AMS-MML_HTMLorMML",
+	     Cfg_URL_SWAD_PUBLIC);
 #else
-	 // Use the MathJax Content Delivery Network (CDN)
-	 MathJaxURL[0] = '\0';
+   // Use the MathJax Content Delivery Network (CDN)
+   MathJaxURL[0] = '\0';
 #endif
-	 */
-	 /* MathJax 3.0.1
-	 // https://pandoc.org/MANUAL.html#math-rendering-in-html
-	 // https://docs.mathjax.org/en/latest/input/tex/
-	 //
+   */
+   /* MathJax 3.0.1
+   // https://pandoc.org/MANUAL.html#math-rendering-in-html
+   // https://docs.mathjax.org/en/latest/input/tex/
+   //
 #ifdef Cfg_MATHJAX_LOCAL
-	 // Use the local copy of MathJax
-	 snprintf (MathJaxURL,sizeof (MathJaxURL),"=%s/mathjax/tex-chtml.js",
-		   Cfg_URL_SWAD_PUBLIC);
+   // Use the local copy of MathJax
+   snprintf (MathJaxURL,PATH_MAX + 1,"=%s/mathjax/tex-chtml.js",
+	     Cfg_URL_SWAD_PUBLIC);
 #else
-	 // Use the MathJax Content Delivery Network (CDN)
-	 MathJaxURL[0] = '\0';
+   // Use the MathJax Content Delivery Network (CDN)
+   MathJaxURL[0] = '\0';
 #endif
-	 // --ascii uses only ascii characters in output
-	 //         (uses numerical entities instead of UTF-8)
-	 //         is mandatory in order to convert (with iconv) the UTF-8 output of pandoc to WINDOWS-1252
-	 snprintf (Command,sizeof (Command),
-		   "iconv -f WINDOWS-1252 -t UTF-8 %s"
-		   " | "
-		   "pandoc --ascii --mathjax%s -f markdown_github+tex_math_dollars -t html5"
-		   " | "
-		   "iconv -f UTF-8 -t WINDOWS-1252 -o %s",
-		   PathFileMD,
-		   MathJaxURL,
-		   PathFileHTML);
-	 */
-	 /* MathJax 4.1.0 */
-	 // https://pandoc.org/MANUAL.html#math-rendering-in-html
-	 // https://docs.mathjax.org/en/latest/input/tex/
-	 //
+   // Command was:
+   //    "pandoc --ascii --mathjax%s -f markdown_github+tex_math_dollars -t html5"
+   */
+   /* MathJax 4.1.0 */
+   // https://pandoc.org/MANUAL.html#math-rendering-in-html
+   // https://docs.mathjax.org/en/latest/input/tex/
+   //
 #ifdef Cfg_MATHJAX_LOCAL
-	 // Use the local copy of MathJax
-	 snprintf (MathJaxURL,sizeof (MathJaxURL),"=%s/mathjax/tex-chtml.js",
-		   Cfg_URL_SWAD_PUBLIC);
+   // Use the local copy of MathJax
+   snprintf (MathJaxURL,PATH_MAX + 1,"=%s/mathjax/tex-chtml.js",
+	     Cfg_URL_SWAD_PUBLIC);
 #else
-	 // Use the MathJax Content Delivery Network (CDN)
-	 MathJaxURL[0] = '\0';
+   // Use the MathJax Content Delivery Network (CDN)
+   MathJaxURL[0] = '\0';
 #endif
-	 // --ascii uses only ascii characters in output
-	 //         (uses numerical entities instead of UTF-8)
-	 //         is mandatory in order to convert (with iconv) the UTF-8 output of pandoc to WINDOWS-1252
-	 snprintf (Command,sizeof (Command),
-		   "iconv -f WINDOWS-1252 -t UTF-8 %s"
-		   " | "
-		   // "pandoc --ascii --mathjax%s -f markdown+tex_math_dollars+tex_math_single_backslash -t html5"
-		   "pandoc --ascii --mathjax%s -f markdown+tex_math_single_backslash -t html5"
-		   " | "
-		   "iconv -f UTF-8 -t WINDOWS-1252 -o %s",
-		   PathFileMD,
-		   MathJaxURL,
-		   PathFileHTML);
-
-	 ReturnCode = system (Command);
-	 if (ReturnCode == -1)
-	    Err_ShowErrorAndExit ("Error when running command to convert from Markdown to HTML.");
-
-	 /***** Remove Markdown file *****/
-	 unlink (PathFileMD);
-
-	 /***** Copy HTML file just created to HTML output *****/
-	 /* Open temporary HTML file for reading */
-	 if ((FileHTML = fopen (PathFileHTML,"rb")) == NULL)
-	    Err_ShowErrorAndExit ("Can not open temporary HTML file.");
-
-	 /* Copy from temporary HTML file to output file */
-	 Fil_FastCopyOfOpenFiles (FileHTML,Fil_GetOutputFile ());
+  }
 
-	 /* Close and remove temporary HTML file */
-	 fclose (FileHTML);
-	 unlink (PathFileHTML);
+/*****************************************************************************/
+/**** Convert Markdown text to HTML file, starting with a line with hash *****/
+/*****************************************************************************/
 
-      HTM_DIV_End ();
+static Err_SuccessOrError_t Inf_RenderMarkdownIntoFile (const char *TxtMD,
+						       const char *MathJaxURL,
+						       const char *Hash,
+						       const char *PathFileHTML)
+  {
+   const char *UniqueNameEncrypted;
+   char PathFileMD[PATH_MAX + 1];
+   char PathFileMDUTF8[PATH_MAX + 1];
+   char PathFileHTMLUTF8[PATH_MAX + 1];
+   char PathFileTmp[PATH_MAX + 1 + Cry_BYTES_ENCRYPTED_STR_SHA256_BASE64 + 5];
+   FILE *FileMD;		// Temporary Markdown file
+   FILE *FileTmp;		// Temporary HTML file
+   char Command[512 + PATH_MAX * 6]; // Command to convert from Markdown to HTML
+   int ReturnCode;
 
-      return Exi_EXISTS;
+   /***** Store text into a temporary .md file in HTML output directory *****/
+   /* Create a unique name for the .md file */
+   UniqueNameEncrypted = Cry_GetUniqueNameEncrypted ();
+   snprintf (PathFileMD,sizeof (PathFileMD),"%s/%s.md",
+	     Cfg_PATH_OUT_PRIVATE,UniqueNameEncrypted);
+   snprintf (PathFileMDUTF8,sizeof (PathFileMDUTF8),"%s/%s.utf8.md",
+	     Cfg_PATH_OUT_PRIVATE,UniqueNameEncrypted);
+   snprintf (PathFileHTMLUTF8,sizeof (PathFileHTMLUTF8),"%s/%s.utf8.html",
+	     Cfg_PATH_OUT_PRIVATE,UniqueNameEncrypted);
+
+   /* Open Markdown file for writing */
+   if ((FileMD = fopen (PathFileMD,"wb")) == NULL)
+      Err_ShowErrorAndExit ("Can not create temporary Markdown file.");
+
+   /* Write text into Markdown file */
+   fprintf (FileMD,"%s",TxtMD);
+
+   /* Close Markdown file */
+   fclose (FileMD);
+
+   /***** Write hash into a temporary HTML file next to the final one *****/
+   snprintf (PathFileTmp,sizeof (PathFileTmp),"%s.%s.tmp",
+	     PathFileHTML,UniqueNameEncrypted);
+   if ((FileTmp = fopen (PathFileTmp,"wb")) == NULL)
+     {
+      unlink (PathFileMD);
+      return Err_ERROR;
+     }
+   fprintf (FileTmp,"%s\n",Hash);
+   fclose (FileTmp);
+
+   /***** Convert from Markdown to HTML appending to temporary HTML file *****/
+   // --ascii uses only ascii characters in output
+   //         (uses numerical entities instead of UTF-8)
+   //         is mandatory in order to convert (with iconv) the UTF-8 output of pandoc to WINDOWS-1252
+   // Steps are joined with && instead of a pipe,
+   // so the exit status is not 0 if any of them fails
+   snprintf (Command,sizeof (Command),
+	     "iconv -f WINDOWS-1252 -t UTF-8 %s > %s"
+	     " && "
+	     // "pandoc --ascii --mathjax%s -f markdown+tex_math_dollars+tex_math_single_backslash -t html5"
+	     "pandoc --ascii --mathjax%s -f markdown+tex_math_single_backslash -t html5 -o %s %s"
+	     " && "
+	     "iconv -f UTF-8 -t WINDOWS-1252 %s >> %s",
+	     PathFileMD,PathFileMDUTF8,
+	     MathJaxURL,PathFileHTMLUTF8,PathFileMDUTF8,
+	     PathFileHTMLUTF8,PathFileTmp);
+
+   Trc_BeginSpan ("system",Command);
+   ReturnCode = system (Command);
+   Trc_EndSpan ();
+
+   /***** Remove Markdown and intermediate files *****/
+   unlink (PathFileMD);
+   unlink (PathFileMDUTF8);
+   unlink (PathFileHTMLUTF8);
+
+   /***** If command could not be run or conversion failed,
+          keep the previous HTML file *****/
+   if (ReturnCode == -1 ||
+       !WIFEXITED (ReturnCode) || WEXITSTATUS (ReturnCode) != 0)
+     {
+      unlink (PathFileTmp);
+      return Err_ERROR;
      }
 
-   return Exi_DOES_NOT_EXIST;
+   /***** Replace HTML file atomically *****/
+   if (rename (PathFileTmp,PathFileHTML))
+     {
+      unlink (PathFileTmp);
+      return Err_ERROR;
+     }
+
+   return Err_SUCCESS;
   }
 
 /*****************************************************************************/
@@ -2261,6 +2365,7 @@ void Inf_ReceivePagInfo (void)
    char PathRelFileZIP[PATH_MAX + 1 + NAME_MAX + 1];
    char MIMEType[Brw_MAX_BYTES_MIME_TYPE + 1];
    char StrUnzip[128 + PATH_MAX + 1 + NAME_MAX + 1 + PATH_MAX + 1];
+   int ReturnCode;
    Err_SuccessOrError_t SuccessOrError;
    Err_SuccessOrError_t FileIsOK = Err_ERROR;
 
@@ -2327,7 +2432,10 @@ void Inf_ReceivePagInfo (void)
 		  /* Uncompress ZIP */
 		  snprintf (StrUnzip,sizeof (StrUnzip),"unzip -qq -o %s -d %s",
 			    PathRelFileZIP,PathRelDirHTML);
-		  if (system (StrUnzip) == 0)
+		  Trc_BeginSpan ("system",StrUnzip);
+		  ReturnCode = system (StrUnzip);
+		  Trc_EndSpan ();
+		  if (ReturnCode == 0)
 		    {
 		     /* Check if uploaded file is index.html or index.htm */
 		     snprintf (PathRelFileHTML,sizeof (PathRelFileHTML),
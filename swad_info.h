@@ -27,6 +27,8 @@
 /********************************* Headers ***********************************/
 /*****************************************************************************/
 
+#include <stdio.h>		// For FILE
+
 #include "swad_constant.h"
 #include "swad_www.h"
 
@@ -130,6 +132,7 @@ void Inf_ChangeIHaveReadInfo (void);
 
 //-----------------------------------------------------------------------------
 void Inf_BuildPathPage (long HieCod,Inf_Type_t InfoType,char PathDir[PATH_MAX + 1]);
+FILE *Inf_OpenRichTxtAsHTML (long HieCod,Inf_Type_t InfoType,const char *TxtMD);
 void Inf_WriteURLIntoTxtBuffer (Inf_Type_t InfoType,
 				char TxtBuffer[WWW_MAX_BYTES_WWW + 1]);
 void Inf_SetInfoSrc (void);
@@ -819,11 +819,6 @@ void Ins_GetShrtNameAndCtyOfInstitution (struct Hie_Node *Ins,
 void Ins_WriteSelectorOfInstitution (void)
   {
    extern const char *Txt_HIERARCHY_SINGUL_Abc[Hie_NUM_LEVELS];
-   MYSQL_RES *mysql_res;
-   MYSQL_ROW row;
-   unsigned NumInss;
-   unsigned NumIns;
-   long HieCod;
 
    /***** Begin form *****/
    Frm_BeginFormGoTo (ActSeeCtr);
@@ -841,34 +836,9 @@ void Ins_WriteSelectorOfInstitution (void)
 							       HTM_NO_ATTR) | HTM_DISABLED,
 		     "[%s]",Txt_HIERARCHY_SINGUL_Abc[Hie_INS]);
 
+	 /***** List institutions of current country *****/
 	 if (Gbl.Hierarchy.Node[Hie_CTY].HieCod > 0)
-	   {
-	    /***** Get institutions of current country *****/
-	    NumInss = Ins_DB_GetInssInCtyOrderedByShrtName (&mysql_res,Gbl.Hierarchy.Node[Hie_CTY].HieCod);
-
-	    /***** List institutions *****/
-	    for (NumIns = 0;
-		 NumIns < NumInss;
-		 NumIns++)
-	      {
-	       /* Get next institution */
-	       row = mysql_fetch_row (mysql_res);
-
-	       /* Get institution code (row[0]) */
-	       if ((HieCod = Str_ConvertStrCodToLongCod (row[0])) <= 0)
-		  Err_WrongInstitExit ();
-
-	       /* Write option */
-	       HTM_OPTION (HTM_Type_LONG,&HieCod,
-			   Gbl.Hierarchy.Node[Hie_INS].HieCod > 0 &&
-			   HieCod == Gbl.Hierarchy.Node[Hie_INS].HieCod ? HTM_SELECTED :
-									  HTM_NO_ATTR,
-			   "%s",row[1]);
-	      }
-
-	    /***** Free structure that stores the query result *****/
-	    DB_FreeMySQLResult (&mysql_res);
-	   }
+	    Hie_WriteOptionsOfChildren (Hie_INS,Gbl.Hierarchy.Node[Hie_INS].HieCod);
 
       /***** End selector *****/
       HTM_SELECT_End ();
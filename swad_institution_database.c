@@ -26,14 +26,18 @@
 /*****************************************************************************/
 
 #include <stdlib.h>		// For exit, system, malloc, free, rand, etc.
+#include <string.h>		// For strcmp
 
 #include "swad_database.h"
 #include "swad_error.h"
 #include "swad_global.h"
 #include "swad_hierarchy.h"
 #include "swad_hierarchy_database.h"
+#include "swad_hierarchy_snapshot.h"
 #include "swad_institution.h"
 #include "swad_institution_database.h"
+#include "swad_name.h"
+#include "swad_search_index.h"
 
 /*****************************************************************************/
 /************** External global variables from others modules ****************/
@@ -47,7 +51,9 @@ extern struct Globals Gbl;
 
 long Ins_DB_CreateInstitution (const struct Hie_Node *Ins,Hie_Status_t Status)
   {
-   return
+   long HieCod;
+
+   HieCod =
    DB_QueryINSERTandReturnCode ("can not create institution",
 				"INSERT INTO ins_instits"
 				" (CtyCod,Status,RequesterUsrCod,"
@@ -61,6 +67,13 @@ long Ins_DB_CreateInstitution (const struct Hie_Node *Ins,Hie_Status_t Status)
 				Ins->ShrtName,
 				Ins->FullName,
 				Ins->WWW);
+
+   HieSnp_Invalidate ();
+
+   /***** Add full name to search index *****/
+   SchIdx_IndexName (SchIdx_INS,HieCod,Ins->FullName);
+
+   return HieCod;
   }
 
 /*****************************************************************************/
@@ -75,6 +88,8 @@ void Ins_DB_UpdateInsCty (long HieCods[Hie_NUM_LEVELS])
 		   " WHERE InsCod=%ld",
                    HieCods[Hie_CTY],
                    HieCods[Hie_INS]);
+
+   HieSnp_Invalidate ();
   }
 
 /*****************************************************************************/
@@ -89,6 +104,8 @@ void Ins_DB_UpdateInsStatus (long HieCod,Hie_Status_t Status)
 		   " WHERE InsCod=%ld",
                    (unsigned) Status,
                    HieCod);
+
+   HieSnp_Invalidate ();
   }
 
 /*****************************************************************************/
@@ -97,6 +114,8 @@ void Ins_DB_UpdateInsStatus (long HieCod,Hie_Status_t Status)
 
 void Ins_DB_UpdateInsName (long HieCod,const char *FldName,const char *NewName)
   {
+   extern const char *Nam_Fields[Nam_NUM_SHRT_FULL_NAMES];
+
    /***** Update institution changing old name by new name */
    DB_QueryUPDATE ("can not update the name of an institution",
 		   "UPDATE ins_instits"
@@ -104,6 +123,12 @@ void Ins_DB_UpdateInsName (long HieCod,const char *FldName,const char *NewName)
 		   " WHERE InsCod=%ld",
 	           FldName,NewName,
 	           HieCod);
+
+   HieSnp_Invalidate ();
+
+   /***** Update full name in search index *****/
+   if (!strcmp (FldName,Nam_Fields[Nam_FULL_NAME]))
+      SchIdx_IndexName (SchIdx_INS,HieCod,NewName);
   }
 
 /*****************************************************************************/
@@ -119,6 +144,8 @@ void Ins_DB_UpdateInsWWW (long HieCod,const char NewWWW[WWW_MAX_BYTES_WWW + 1])
 		   " WHERE InsCod=%ld",
 	           NewWWW,
 	           HieCod);
+
+   HieSnp_Invalidate ();
   }
 
 /*****************************************************************************/
@@ -853,4 +880,9 @@ void Ins_DB_RemoveInstitution (long HieCod)
 		   "DELETE FROM ins_instits"
 		   " WHERE InsCod=%ld",
 		   HieCod);
+
+   HieSnp_Invalidate ();
+
+   /***** Remove full name from search index *****/
+   SchIdx_RemoveName (SchIdx_INS,HieCod);
   }
@@ -36,11 +36,13 @@
 #include "swad_API.h"
 #include "swad_banner.h"
 #include "swad_box.h"
+#include "swad_browser_database.h"
 #include "swad_calendar.h"
 #include "swad_call_for_exam.h"
 #include "swad_changelog.h"
 #include "swad_config.h"
 #include "swad_connected.h"
+#include "swad_connected_database.h"
 #include "swad_database.h"
 #include "swad_error.h"
 #include "swad_exam_session.h"
@@ -55,8 +57,10 @@
 #include "swad_holiday.h"
 #include "swad_HTML.h"
 #include "swad_language.h"
+#include "swad_load.h"
 #include "swad_system_link.h"
 #include "swad_log.h"
+#include "swad_log_archive.h"
 #include "swad_log_database.h"
 #include "swad_logo.h"
 #include "swad_match.h"
@@ -65,6 +69,7 @@
 #include "swad_notification.h"
 #include "swad_parameter.h"
 #include "swad_process.h"
+#include "swad_search_index.h"
 #include "swad_setting.h"
 #include "swad_setting_database.h"
 #include "swad_tab.h"
@@ -102,11 +107,29 @@ const char *Lay_HighlightClass[Lay_NUM_HIGHLIGHT] =
 
 Lay_LayoutStatus_t Lay_LayoutStatus = Lay_NOTHING_WRITTEN;
 
+#define Lay_MAX_BYTES_ASSET_NAME 63
+
+#define Lay_STR(x) #x
+#define Lay_SCANF_STR(Size) "%" Lay_STR(Size) "s"	// Limit of a string in fscanf
+
+static struct
+  {
+   bool Read;					// Manifest already read?
+   char CSS[Lay_MAX_BYTES_ASSET_NAME + 1];	// Bundle of style sheets, empty if not available
+   char JS [Lay_MAX_BYTES_ASSET_NAME + 1];	// Bundle of scripts, empty if not available
+  } Lay_Assets =
+  {
+   .Read = false,
+  };
+
 /*****************************************************************************/
 /***************************** Private prototypes ****************************/
 /*****************************************************************************/
 
+static void Lay_WriteHTTPHeaderTimeToRefresh (void);
+
 static void Lay_WritePageTitle (void);
+static void Lay_GetAssetBundles (void);
 
 static void Lay_WriteScripts (void);
 static void Lay_WriteScriptMathJax (void);
@@ -165,7 +188,9 @@ void Lay_WriteStartOfPage (void)
    if (Gbl.Action.UsesAJAX)
      // Don't generate a full HTML page, only the content of a DIV or similar
      {
-      HTM_Txt ("Content-Type: text/html; charset=windows-1252\r\n\r\n");
+      HTM_Txt ("Content-Type: text/html; charset=windows-1252\r\n");
+      Lay_WriteHTTPHeaderTimeToRefresh ();
+      HTM_Txt ("\r\n");
       Lay_SetLayoutStatus (Lay_DIVS_END_WRITTEN);
       return;
      }
@@ -236,19 +261,24 @@ void Lay_WriteStartOfPage (void)
    HTM_TxtF ("<link type=\"image/x-icon\" href=\"%s/favicon.ico\" rel=\"shortcut icon\">\n",
 	     Cfg_URL_ICON_PUBLIC);
 
-   /* Style sheet for SWAD */
-   HTM_TxtF ("<link rel=\"stylesheet\" href=\"%s/%s\" type=\"text/css\">\n",
-             Cfg_URL_SWAD_PUBLIC,Chl_CSS_FILE);
-
-   /* Style sheets for Font Awesome */
-   HTM_TxtF ("<link rel=\"stylesheet\""
-	     " href=\"%s/fontawesome/css/fontawesome.css\""
-	     " type=\"text/css\">\n",
-             Cfg_URL_SWAD_PUBLIC);
-   HTM_TxtF ("<link rel=\"stylesheet\""
-	     " href=\"%s/fontawesome/css/solid.css\""
-	     " type=\"text/css\">\n",
-             Cfg_URL_SWAD_PUBLIC);
+   /* Style sheets for SWAD and Font Awesome */
+   Lay_GetAssetBundles ();
+   if (Lay_Assets.CSS[0])	// Bundle with all style sheets
+      HTM_TxtF ("<link rel=\"stylesheet\" href=\"%s/%s\" type=\"text/css\">\n",
+		Cfg_URL_SWAD_PUBLIC,Lay_Assets.CSS);
+   else
+     {
+      HTM_TxtF ("<link rel=\"stylesheet\" href=\"%s/%s\" type=\"text/css\">\n",
+		Cfg_URL_SWAD_PUBLIC,Chl_CSS_FILE);
+      HTM_TxtF ("<link rel=\"stylesheet\""
+		" href=\"%s/fontawesome/css/fontawesome.css\""
+		" type=\"text/css\">\n",
+		Cfg_URL_SWAD_PUBLIC);
+      HTM_TxtF ("<link rel=\"stylesheet\""
+		" href=\"%s/fontawesome/css/solid.css\""
+		" type=\"text/css\">\n",
+		Cfg_URL_SWAD_PUBLIC);
+     }
 
    /* Style sheet for Dropzone.js (http://www.dropzonejs.com/) */
    // The public directory dropzone must hold:
@@ -403,6 +433,37 @@ void Lay_WriteStartOfPage (void)
 		     Usr_InformAboutNumClicksBeforePhoto ();
   }
 
+/*****************************************************************************/
+/********* Write recommended time to next automatic refresh via AJAX *********/
+/*****************************************************************************/
+// Time depends on server load. JavaScript reads it from this HTTP header.
+// Connected users and last clicks send their time at start of content.
+
+static void Lay_WriteHTTPHeaderTimeToRefresh (void)
+  {
+   unsigned long TimeToRefresh;
+
+   switch (Gbl.Action.Act)
+     {
+      case ActRefNewPubGblTL:
+	 TimeToRefresh = Loa_GetTimeToRefresh (Cfg_TIME_TO_REFRESH_TIMELINE,
+					       Cfg_MAX_TIME_TO_REFRESH_TIMELINE);
+	 break;
+      case ActRefMchStd:
+	 TimeToRefresh = Loa_GetTimeToRefresh (Cfg_TIME_TO_REFRESH_MATCH_STD,
+					       Cfg_MAX_TIME_TO_REFRESH_MATCH_STD);
+	 break;
+      case ActRefMchTch:
+	 TimeToRefresh = Loa_GetTimeToRefresh (Cfg_TIME_TO_REFRESH_MATCH_TCH,
+					       Cfg_MAX_TIME_TO_REFRESH_MATCH_TCH);
+	 break;
+      default:
+	 return;
+     }
+
+   HTM_TxtF ("X-Refresh-Delay: %lu\r\n",TimeToRefresh);
+  }
+
 /*****************************************************************************/
 /*********************** Write status 204 No Content *************************/
 /*****************************************************************************/
@@ -480,6 +541,42 @@ static void Lay_WritePageTitle (void)
    HTM_TITLE_End ();
   }
 
+/*****************************************************************************/
+/************* Get names of bundles of style sheets and scripts **************/
+/*****************************************************************************/
+// Bundles have names with a hash of their content, so they can be cached
+// by browsers forever. They are built with make assets (py/swad_assets.py).
+// Manifest has one line per bundle: "css <name>" and "js <name>"
+
+static void Lay_GetAssetBundles (void)
+  {
+   FILE *FileManifest;
+   char Type[3 + 1];
+   char Name[Lay_MAX_BYTES_ASSET_NAME + 1];
+
+   if (Lay_Assets.Read)
+      return;
+   Lay_Assets.Read = true;
+
+   Lay_Assets.CSS[0] =
+   Lay_Assets.JS[0]  = '\0';
+   if ((FileManifest = fopen (Cfg_PATH_SWAD_PUBLIC "/" Cfg_FILE_ASSETS_MANIFEST,"rb")) == NULL)
+      return;	// No bundles ==> use original files
+
+   while (fscanf (FileManifest,"%3s " Lay_SCANF_STR (Lay_MAX_BYTES_ASSET_NAME),Type,Name) == 2)
+      /* Names are written in pages, so only safe characters are allowed */
+      if (!strncmp (Name,"swad-",5) &&
+	  !Name[strspn (Name,"0123456789abcdef.-swadcjs")])
+	{
+	 if (!strcmp (Type,"css"))
+	    Str_Copy (Lay_Assets.CSS,Name,sizeof (Lay_Assets.CSS) - 1);
+	 else if (!strcmp (Type,"js"))
+	    Str_Copy (Lay_Assets.JS ,Name,sizeof (Lay_Assets.JS ) - 1);
+	}
+
+   fclose (FileManifest);
+  }
+
 /*****************************************************************************/
 /************ Write some scripts depending on the current action *************/
 /*****************************************************************************/
@@ -494,10 +591,23 @@ static void Lay_WriteScripts (void)
    unsigned DayOfWeek; /* 0, 1, 2, 3, 4, 5, 6 */
    unsigned NumHld;
    unsigned NumExamAnnouncement;	// Number of exam announcement
+   char *URL;
 
    /***** General scripts for swad *****/
-   HTM_SCRIPT_Begin (Cfg_URL_SWAD_PUBLIC "/" Chl_JS_FILE,NULL);
-   HTM_SCRIPT_End ();
+   Lay_GetAssetBundles ();
+   if (Lay_Assets.JS[0])	// Bundle with general scripts and MathJax configuration
+     {
+      if (asprintf (&URL,"%s/%s",Cfg_URL_SWAD_PUBLIC,Lay_Assets.JS) < 0)
+	 Err_NotEnoughMemoryExit ();
+      HTM_SCRIPT_Begin (URL,NULL);
+      HTM_SCRIPT_End ();
+      free (URL);
+     }
+   else
+     {
+      HTM_SCRIPT_Begin (Cfg_URL_SWAD_PUBLIC "/" Chl_JS_FILE,NULL);
+      HTM_SCRIPT_End ();
+     }
 
    /***** Script for MathJax *****/
    Lay_WriteScriptMathJax ();
@@ -719,9 +829,10 @@ static void Lay_WriteScriptMathJax (void)
    where MathJax doesn't get properly configured,
    and they would seem to occur randomly.
    */
-   HTM_TxtF ("<script src=\"%s/mathjax-config.js\" defer>\n"
-	     "</script>\n",
-	     Cfg_URL_SWAD_PUBLIC);
+   if (!Lay_Assets.JS[0])	// Already included in bundle of scripts
+      HTM_TxtF ("<script src=\"%s/mathjax-config.js\" defer>\n"
+		"</script>\n",
+		Cfg_URL_SWAD_PUBLIC);
 
 #ifdef Cfg_MATHJAX_LOCAL
    // Use the local copy of MathJax
@@ -819,11 +930,17 @@ static void Lay_WriteScriptInit (void)
       Dat_WriteScriptMonths ();
 
       if (Refresh.NewTimeline)		// Refresh new timeline via AJAX
-	 HTM_TxtF ("\tvar delayNewTml = %lu;\n",Cfg_TIME_TO_REFRESH_TIMELINE);
+	 HTM_TxtF ("\tvar delayNewTml = %lu;\n",
+		   Loa_GetTimeToRefresh (Cfg_TIME_TO_REFRESH_TIMELINE,
+					 Cfg_MAX_TIME_TO_REFRESH_TIMELINE));
       else if (Refresh.MatchStd)	// Refresh match via AJAX
-	 HTM_TxtF ("\tconst delayMatch = %lu;\n",Cfg_TIME_TO_REFRESH_MATCH_STD);
+	 HTM_TxtF ("\tconst delayMatch = %lu;\n",
+		   Loa_GetTimeToRefresh (Cfg_TIME_TO_REFRESH_MATCH_STD,
+					 Cfg_MAX_TIME_TO_REFRESH_MATCH_STD));
       else if (Refresh.MatchTch)	// Refresh match via AJAX
-	 HTM_TxtF ("\tconst delayMatch = %lu;\n",Cfg_TIME_TO_REFRESH_MATCH_TCH);
+	 HTM_TxtF ("\tconst delayMatch = %lu;\n",
+		   Loa_GetTimeToRefresh (Cfg_TIME_TO_REFRESH_MATCH_TCH,
+					 Cfg_MAX_TIME_TO_REFRESH_MATCH_TCH));
 
       /***** Function init () ******/
       HTM_TxtF ("\tfunction init() {\n"
@@ -834,7 +951,8 @@ static void Lay_WriteScriptInit (void)
 
 	 if (Refresh.LastClicks)	// Refresh last clicks via AJAX
 	    HTM_TxtF ("\tsetTimeout('refreshLastClicks()',%lu);\n",
-		      Cfg_TIME_TO_REFRESH_LAST_CLICKS);
+		      Loa_GetTimeToRefresh (Cfg_TIME_TO_REFRESH_LAST_CLICKS,
+					    Cfg_MAX_TIME_TO_REFRESH_LAST_CLICKS));
 	 else if (Refresh.NewTimeline ||
 	          Refresh.OldTimeline)	// Refresh timeline via AJAX
 	   {
@@ -1392,9 +1510,7 @@ void Lay_RefreshRightColumn (void)
                              Cfg_TIME_TO_DELETE_MEDIA_TMP_FILES,
                              Fil_DONT_REMOVE_DIRECTORY);
    else if (!(PID % 137))
-      Fil_RemoveOldTmpFiles (Cfg_PATH_ZIP_PRIVATE,
-                             Cfg_TIME_TO_DELETE_BROWSER_ZIP_FILES,
-                             Fil_DONT_REMOVE_DIRECTORY);
+      Brw_DB_RemoveExpiredFolderIndexes ();	// Remove folder indexes of file zones not verified recently
    else if (!(PID % 139))
       Fil_RemoveOldTmpFiles (Cfg_PATH_MARK_PRIVATE,
                              Cfg_TIME_TO_DELETE_MARKS_TMP_FILES,
@@ -1403,6 +1519,28 @@ void Lay_RefreshRightColumn (void)
       Fil_RemoveOldTmpFiles (Cfg_PATH_TEST_PRIVATE,
                              Cfg_TIME_TO_DELETE_TEST_TMP_FILES,
                              Fil_DONT_REMOVE_DIRECTORY);
+   else if (!(PID % 151))
+      Fil_RemoveOldTmpFiles (Cfg_PATH_PHOTO_SPRITE_PUBLIC,
+                             Cfg_TIME_TO_DELETE_PHOTO_SPRITES,
+                             Fil_DONT_REMOVE_DIRECTORY);
+   else if (!(PID % 157))
+      SchIdx_ContinueBuildingIndexes ();
+   else if (!(PID % 163))
+      Fil_RemoveOldTmpFiles (Cfg_PATH_PAGE_CACHE_PRIVATE,
+                             Cfg_TIME_TO_KEEP_CACHED_PAGES,
+                             Fil_DONT_REMOVE_DIRECTORY);
+   else if (!(PID % 167))
+      Fil_RemoveOldTmpFiles (Cfg_PATH_MARK_INDEX_PRIVATE,
+                             Cfg_TIME_TO_DELETE_MARKS_INDEXES,
+                             Fil_DONT_REMOVE_DIRECTORY);
+   else if (!(PID % 173))
+      LogArc_ContinueArchiving ();	// Archive one more day of closed years of log
+
+   /***** Remove users without sessions from table of connected users.
+          It is not chained to the tasks above,
+          so it is done often enough to keep the table small *****/
+   if (!(PID % 7))
+      Con_DB_RemoveOldConnected ();
 
    Con_RefreshConnected ();
   }
@@ -1418,7 +1556,8 @@ void Lay_RefreshLastClicks (void)
       return;
 
    /***** Send, before the HTML, the refresh time *****/
-   HTM_TxtF ("%lu|",Cfg_TIME_TO_REFRESH_LAST_CLICKS);
+   HTM_TxtF ("%lu|",Loa_GetTimeToRefresh (Cfg_TIME_TO_REFRESH_LAST_CLICKS,
+					  Cfg_MAX_TIME_TO_REFRESH_LAST_CLICKS));
 
    /***** Get and show last clicks *****/
    Log_GetAndShowLastClicks ();
@@ -0,0 +1,213 @@
+// swad_load.c: load of the server, used to slow down automatic refreshes
+/*
+    SWAD (Shared Workspace At a Distance),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2026 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/********************************* Headers ***********************************/
+/*****************************************************************************/
+
+#include <fcntl.h>		// For open
+#include <stdbool.h>		// For boolean type
+#include <stdlib.h>		// For getloadavg
+#include <sys/file.h>		// For flock
+#include <unistd.h>		// For close, pread, pwrite, sysconf, unlink
+
+#include "swad_config.h"
+#include "swad_date.h"
+#include "swad_file.h"
+#include "swad_load.h"
+
+/*****************************************************************************/
+/***************************** Private constants *****************************/
+/*****************************************************************************/
+
+#define Loa_FILE_LOAD	"load"
+
+#define Loa_MAGIC	0x44414F4CU	// "LOAD"
+
+#define Loa_WEIGHT_OF_AVG	7	// Average time has this weight, new time has weight 1
+#define Loa_TIME_TO_FORGET_AVG	((time_t) (5UL * 60UL))	// After these seconds without updates, average is not valid
+
+/*****************************************************************************/
+/******************************* Private types *******************************/
+/*****************************************************************************/
+
+struct Loa_Load
+  {
+   unsigned Magic;
+   long AvgTimeToGenerate;	// In microseconds
+   time_t TimeLastUpdate;
+  };
+
+/*****************************************************************************/
+/************************* Private global variables **************************/
+/*****************************************************************************/
+
+static struct
+  {
+   bool Computed;
+   unsigned long SlowDown;	// Percentage, 100 means no slow down
+  } Loa_SlowDown =
+  {
+   .Computed = false,
+  };
+
+/*****************************************************************************/
+/***************************** Private prototypes ****************************/
+/*****************************************************************************/
+
+static unsigned long Loa_GetSlowDown (void);
+static long Loa_GetAvgTimeToGenerate (void);
+
+/*****************************************************************************/
+/************ Update average time to generate a page in this server **********/
+/*****************************************************************************/
+// Called at the end of each request, except automatic refreshes
+
+void Loa_UpdateAvgTimeToGenerate (long TimeInMicroseconds)
+  {
+   int FileDescriptor;
+   struct Loa_Load Load;
+   time_t Now = Dat_GetStartExecutionTimeUTC ();
+
+   /***** Open file with load, creating it if it does not exist *****/
+   Fil_CreateDirIfNotExists (Cfg_PATH_LOAD_PRIVATE);
+   if ((FileDescriptor = open (Cfg_PATH_LOAD_PRIVATE "/" Loa_FILE_LOAD,
+			       O_RDWR | O_CREAT,0600)) < 0)
+      return;
+
+   /***** Update exponential moving average.
+	  If it is not valid, start again with this time. *****/
+   if (flock (FileDescriptor,LOCK_EX) == 0)
+     {
+      if (pread (FileDescriptor,&Load,sizeof (Load),0) != (ssize_t) sizeof (Load) ||
+	  Load.Magic != Loa_MAGIC ||
+	  Now - Load.TimeLastUpdate >= Loa_TIME_TO_FORGET_AVG)
+	{
+	 Load.Magic = Loa_MAGIC;
+	 Load.AvgTimeToGenerate = TimeInMicroseconds;
+	}
+      else
+	 Load.AvgTimeToGenerate = (Load.AvgTimeToGenerate * Loa_WEIGHT_OF_AVG +
+				   TimeInMicroseconds) / (Loa_WEIGHT_OF_AVG + 1);
+      Load.TimeLastUpdate = Now;
+
+      if (pwrite (FileDescriptor,&Load,sizeof (Load),0) != (ssize_t) sizeof (Load))
+	 unlink (Cfg_PATH_LOAD_PRIVATE "/" Loa_FILE_LOAD);	// It will be created again
+
+      flock (FileDescriptor,LOCK_UN);
+     }
+
+   close (FileDescriptor);
+  }
+
+/*****************************************************************************/
+/************ Get time to refresh depending on load of the server ************/
+/*****************************************************************************/
+// TimeToRefresh is the period when the server is not loaded
+// The period is increased when the server is loaded, up to MaxTimeToRefresh
+
+unsigned long Loa_GetTimeToRefresh (unsigned long TimeToRefresh,
+				    unsigned long MaxTimeToRefresh)
+  {
+   unsigned long SlowTimeToRefresh = TimeToRefresh * Loa_GetSlowDown () / 100UL;
+
+   if (SlowTimeToRefresh > MaxTimeToRefresh)
+      SlowTimeToRefresh = MaxTimeToRefresh;
+
+   return SlowTimeToRefresh > TimeToRefresh ? SlowTimeToRefresh :
+					      TimeToRefresh;
+  }
+
+/*****************************************************************************/
+/***************** Compute how much refreshes are slowed down ****************/
+/*****************************************************************************/
+// Return a percentage: 100 means the server is not loaded
+// It is computed from the average time to generate pages
+// and from the number of processes waiting for each CPU
+
+static unsigned long Loa_GetSlowDown (void)
+  {
+   long AvgTimeToGenerate;
+   double LoadAvg;
+   long NumCPUs;
+   unsigned long SlowDown;
+
+   if (!Loa_SlowDown.Computed)
+     {
+      Loa_SlowDown.SlowDown = 100UL;
+
+      /***** Slow down by latency of requests *****/
+      if ((AvgTimeToGenerate = Loa_GetAvgTimeToGenerate ()) > 0)
+	{
+	 SlowDown = (unsigned long) (AvgTimeToGenerate * 100L /
+				     Cfg_TIME_TO_GENERATE_PAGE_UNLOADED);
+	 if (SlowDown > Loa_SlowDown.SlowDown)
+	    Loa_SlowDown.SlowDown = SlowDown;
+	}
+
+      /***** Slow down by processes in run queue *****/
+      if (getloadavg (&LoadAvg,1) == 1)
+	 if ((NumCPUs = sysconf (_SC_NPROCESSORS_ONLN)) > 0)
+	   {
+	    SlowDown = (unsigned long) (LoadAvg * 100.0 / (double) NumCPUs);
+	    if (SlowDown > Loa_SlowDown.SlowDown)
+	       Loa_SlowDown.SlowDown = SlowDown;
+	   }
+
+      if (Loa_SlowDown.SlowDown > Cfg_MAX_SLOW_DOWN_REFRESH * 100UL)
+	 Loa_SlowDown.SlowDown = Cfg_MAX_SLOW_DOWN_REFRESH * 100UL;
+
+      Loa_SlowDown.Computed = true;
+     }
+
+   return Loa_SlowDown.SlowDown;
+  }
+
+/*****************************************************************************/
+/************ Get average time to generate a page in this server *************/
+/*****************************************************************************/
+// Return 0 if not known
+
+static long Loa_GetAvgTimeToGenerate (void)
+  {
+   int FileDescriptor;
+   struct Loa_Load Load;
+   long AvgTimeToGenerate = 0L;
+
+   if ((FileDescriptor = open (Cfg_PATH_LOAD_PRIVATE "/" Loa_FILE_LOAD,
+			       O_RDONLY)) < 0)
+      return 0L;
+
+   if (flock (FileDescriptor,LOCK_SH) == 0)
+     {
+      if (pread (FileDescriptor,&Load,sizeof (Load),0) == (ssize_t) sizeof (Load))
+	 if (Load.Magic == Loa_MAGIC &&
+	     Dat_GetStartExecutionTimeUTC () - Load.TimeLastUpdate < Loa_TIME_TO_FORGET_AVG)
+	    AvgTimeToGenerate = Load.AvgTimeToGenerate;
+
+      flock (FileDescriptor,LOCK_UN);
+     }
+
+   close (FileDescriptor);
+
+   return AvgTimeToGenerate;
+  }
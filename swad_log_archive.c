@@ -0,0 +1,1807 @@
+// swad_log_archive.c: columnar archive of clicks in closed years of log
+
+/*
+    SWAD (Shared Workspace At a Distance),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2026 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/********************************** Headers **********************************/
+/*****************************************************************************/
+
+#define _GNU_SOURCE 		// For asprintf, tm_gmtoff
+#include <fcntl.h>		// For open
+#include <linux/limits.h>	// For PATH_MAX
+#include <stdbool.h>		// For boolean type
+#include <stdint.h>		// For int32_t, int64_t, uint8_t, uint16_t, uint32_t, uint64_t
+#include <stdio.h>		// For asprintf, rename, snprintf
+#include <stdlib.h>		// For calloc, free, getenv, malloc, realloc, setenv
+#include <string.h>		// For memset, strdup, strspn, strstr
+#include <sys/file.h>		// For flock
+#include <sys/mman.h>		// For mmap, munmap
+#include <sys/stat.h>		// For fstat, stat
+#include <time.h>		// For localtime_r, time, tzset
+#include <unistd.h>		// For close, ftruncate, getpid, pread, pwrite, unlink
+
+#include "swad_action.h"
+#include "swad_config.h"
+#include "swad_database.h"
+#include "swad_error.h"
+#include "swad_file.h"
+#include "swad_global.h"
+#include "swad_log_archive.h"
+#include "swad_log_archive_database.h"
+#include "swad_statistic_database.h"
+#include "swad_string.h"
+
+/*****************************************************************************/
+/*************** External global variables from others modules ***************/
+/*****************************************************************************/
+
+extern struct Globals Gbl;
+
+/*****************************************************************************/
+/***************************** Private constants *****************************/
+/*****************************************************************************/
+
+#define LogArc_FILE_HEADER	"header"	// Rewritten after each day archived
+#define LogArc_FILE_LOCK	"lock"		// Locked while a day is being archived
+#define LogArc_SUFFIX_PARTIAL	"part"		// Directory of a year not completely archived
+
+#define LogArc_MAGIC	0x4352414CU	// "LARC"
+#define LogArc_FORMAT	1		// Increment when file layout changes
+
+#define LogArc_MAX_ACTS		65536		// Entry of action is stored in 16 bits
+#define LogArc_ROWS_PER_CHUNK	4096		// Rows processed together, column by column
+#define LogArc_MAX_BYTES_VALUES	(64 * 1024)	// Values inserted at once in temporary table
+
+#define LogArc_PATH_ZONEINFO	"/usr/share/zoneinfo"	// Time zones known by the C library
+
+#define LogArc_SECONDS_PER_DAY	(24L * 60L * 60L)
+
+/*****************************************************************************/
+/******************************* Private types *******************************/
+/*****************************************************************************/
+
+/*
+   Each year is stored in a directory with one file per column
+   and one file per dictionary (native byte order, only read by this program).
+   Clicks are sorted by time, so a range of dates is a range of rows.
+   While a year is being archived, one day each time,
+   its directory has the suffix LogArc_SUFFIX_PARTIAL.
+*/
+#define LogArc_NUM_FILES 8
+typedef enum
+  {
+   LogArc_COL_TIME,	// uint32_t: seconds since the beginning of year
+   LogArc_COL_ACT,	// uint16_t: entry in dictionary of actions
+   LogArc_COL_HIE,	// uint32_t: entry in dictionary of hierarchy
+   LogArc_COL_USR,	// uint32_t: entry in dictionary of users
+   LogArc_COL_ROLE,	// uint8_t: two roles in each byte, 4 bits each
+   LogArc_DIC_ACT,	// int32_t: codes of actions
+   LogArc_DIC_HIE,	// int32_t[5]: codes of country, institution, center, degree and course
+   LogArc_DIC_USR,	// int32_t: codes of users
+  } LogArc_File_t;
+
+#define LogArc_NUM_DICS 3
+typedef enum
+  {
+   LogArc_ACTS,
+   LogArc_HIES,
+   LogArc_USRS,
+  } LogArc_Dic_t;
+
+#define LogArc_HIE_WIDTH (Hie_CRS - Hie_CTY + 1)	// Codes in an entry of hierarchy
+
+struct LogArc_Header
+  {
+   unsigned Magic;
+   unsigned Format;
+   unsigned Year;
+   unsigned NumDays;				// Number of days in year
+   unsigned NextDay;				// Next day to archive, NumDays if complete
+   time_t StartTime;				// UTC time of the beginning of year
+   time_t EndTime;				// UTC time of the beginning of next year
+   size_t NumRows;				// Number of clicks
+   unsigned NumEntries[LogArc_NUM_DICS];	// Number of entries in dictionaries
+  };
+
+struct LogArc_Dic	// Dictionary with a hash table to find entries
+  {
+   unsigned Width;		// Number of codes in each entry
+   unsigned NumEntries;
+   unsigned MaxEntries;		// Number of entries allocated
+   int32_t *Cods;		// Codes of all entries
+   unsigned NumSlots;		// Size of hash table, power of 2
+   unsigned *Slots;		// Entry + 1 in each slot, 0 if empty
+  };
+
+struct LogArc_Set	// Set of 64-bit keys
+  {
+   size_t NumKeys;
+   size_t NumSlots;		// Size of hash table, power of 2
+   uint64_t *Slots;		// LogArc_EMPTY_KEY if empty
+  };
+#define LogArc_EMPTY_KEY UINT64_MAX
+
+struct LogArc_Year	// Files of a year mapped in memory
+  {
+   struct LogArc_Header Header;
+   const void *Addr[LogArc_NUM_FILES];	// NULL if file is empty
+   size_t Size[LogArc_NUM_FILES];
+  };
+
+struct LogArc_Segment	// Interval with constant time zone offset
+  {
+   time_t Start;		// Offset is valid from this time to start of next segment
+   long Offset;			// Local time - UTC time, in seconds
+  };
+
+struct LogArc_Query
+  {
+   const struct Sta_Stats *Stats;
+   time_t StartTime;		// Range of time in archive (both included)
+   time_t EndTime;
+
+   /* Filters */
+   uint8_t RoleOK[16];		// 1 if clicks with this role are counted
+   long ActCod;			// Only clicks in this action, or -1 for all
+   long UsrCod;			// Only clicks of this user, or -1 for all
+   int HieIdx;			// Only clicks in this node (index in entry of hierarchy)...
+   long HieCod;			// ...or -1 for all
+
+   /* Offsets of browser time zone */
+   struct
+     {
+      unsigned Num;
+      struct LogArc_Segment *Lst;
+      long Min;
+      long Max;
+     } TZ;
+
+   /* Groups */
+   long FirstDay;		// First local day, in days since 1970-01-01
+   unsigned NumDays;		// Number of local days in range
+   unsigned *GroupOfDay;	// For weeks, months and years
+   uint32_t *KeyOfGroup;	// Week, month or year of each group
+   struct LogArc_Dic Cods;	// For actions and hierarchy: code of each group
+   unsigned NumGroups;
+   unsigned MaxGroups;		// Number of groups allocated
+   uint64_t *NumClicks;		// Number of clicks in each group
+   uint64_t *NumUsrs;		// Number of distinct users in each group
+   bool CountUsrs;		// Count distinct users?
+   struct LogArc_Set Pairs;	// Pairs (group,user) already counted
+  };
+
+/*****************************************************************************/
+/************************* Private global variables **************************/
+/*****************************************************************************/
+
+static const char *LogArc_FileName[LogArc_NUM_FILES] =
+  {
+   [LogArc_COL_TIME] = "time",
+   [LogArc_COL_ACT ] = "act",
+   [LogArc_COL_HIE ] = "hie",
+   [LogArc_COL_USR ] = "usr",
+   [LogArc_COL_ROLE] = "role",
+   [LogArc_DIC_ACT ] = "act.dic",
+   [LogArc_DIC_HIE ] = "hie.dic",
+   [LogArc_DIC_USR ] = "usr.dic",
+  };
+
+/*****************************************************************************/
+/**************************** Private prototypes *****************************/
+/*****************************************************************************/
+
+static unsigned LogArc_GetYearToArchive (void);
+static void LogArc_ArchiveNextDay (unsigned Year);
+static Err_SuccessOrError_t LogArc_AppendClicks (const struct LogArc_Header *Header,
+						 int FileDescriptor[LogArc_NUM_FILES],
+						 struct LogArc_Dic Dics[LogArc_NUM_DICS],
+						 MYSQL_RES *mysql_res,unsigned NumClicks);
+static void LogArc_BuildPath (char Path[PATH_MAX + 1],unsigned Year,bool Partial);
+static Err_SuccessOrError_t LogArc_ReadHeader (const char *PathDir,
+					       struct LogArc_Header *Header);
+static Err_SuccessOrError_t LogArc_WriteHeader (const char *PathDir,
+						const struct LogArc_Header *Header);
+static Exi_Exist_t LogArc_CheckIfYearIsArchived (unsigned Year,
+						 struct LogArc_Header *Header);
+static size_t LogArc_GetFileSize (const struct LogArc_Header *Header,
+				  LogArc_File_t File);
+static unsigned LogArc_GetNumDaysInYear (unsigned Year);
+
+static Err_SuccessOrError_t LogArc_MapYear (unsigned Year,struct LogArc_Year *Arc);
+static void LogArc_UnmapYear (struct LogArc_Year *Arc);
+
+static bool LogArc_CheckIfCanGetHits (const struct Sta_Stats *Stats);
+static void LogArc_SetFilters (struct LogArc_Query *Query);
+static Err_SuccessOrError_t LogArc_GetTimeZone (struct LogArc_Query *Query,
+						const char *BrowserTimeZone);
+static void LogArc_AddSegment (struct LogArc_Query *Query,time_t Start,long Offset);
+static long LogArc_GetOffset (time_t Time);
+static void LogArc_SetTimeGroups (struct LogArc_Query *Query);
+static void LogArc_AllocateGroups (struct LogArc_Query *Query,unsigned NumGroups);
+static void LogArc_ScanYear (struct LogArc_Query *Query,const struct LogArc_Year *Arc);
+static size_t LogArc_GetFirstRowAtOrAfter (const uint32_t *Time,size_t NumRows,
+					   int64_t Seconds);
+static void LogArc_ScanChunk (struct LogArc_Query *Query,const struct LogArc_Year *Arc,
+			      const uint8_t *HieOK,const uint8_t *ActOK,const uint8_t *UsrOK,
+			      const unsigned *GroupOfEntry,
+			      size_t FirstRow,unsigned NumRows,long Offset);
+static void LogArc_InsertHitsIntoTmpTable (const struct LogArc_Query *Query);
+static void LogArc_FreeQuery (struct LogArc_Query *Query);
+
+static void LogArc_InitDic (struct LogArc_Dic *Dic,unsigned Width);
+static void LogArc_FreeDic (struct LogArc_Dic *Dic);
+static unsigned LogArc_GetEntryInDic (struct LogArc_Dic *Dic,const int32_t *Cods);
+static void LogArc_ResizeSlotsOfDic (struct LogArc_Dic *Dic);
+static unsigned LogArc_HashCods (const int32_t *Cods,unsigned Width);
+static bool LogArc_AddKeyToSet (struct LogArc_Set *Set,uint64_t Key);
+
+static long LogArc_GetDaysFromCivil (long Year,unsigned Month,unsigned Day);
+static void LogArc_GetCivilFromDays (long Days,
+				     unsigned *Year,unsigned *Month,unsigned *Day);
+static uint32_t LogArc_GetKeyOfDay (Sta_ClicksGroupedBy_t ClicksGroupedBy,long Days);
+
+/*****************************************************************************/
+/********* Archive one more day of the most recent year not archived *********/
+/*****************************************************************************/
+// Called from time to time.
+// Years are archived from the most recent closed year backwards.
+
+void LogArc_ContinueArchiving (void)
+  {
+   unsigned Year;
+   int LockFileDescriptor;
+
+   /***** Get year to archive *****/
+   if ((Year = LogArc_GetYearToArchive ()) == 0)	// All years archived
+      return;
+
+   /***** Lock (other processes don't wait) *****/
+   Fil_CreateDirIfNotExists (Cfg_PATH_LOG_ARCHIVE_PRIVATE);
+   if ((LockFileDescriptor = open (Cfg_PATH_LOG_ARCHIVE_PRIVATE "/" LogArc_FILE_LOCK,
+				   O_RDWR | O_CREAT,0600)) < 0)
+      return;
+   if (flock (LockFileDescriptor,LOCK_EX | LOCK_NB) == 0)
+     {
+      /***** Archive next day *****/
+      LogArc_ArchiveNextDay (Year);
+
+      /***** Unlock *****/
+      flock (LockFileDescriptor,LOCK_UN);
+     }
+   close (LockFileDescriptor);
+  }
+
+/*****************************************************************************/
+/************* Get the most recent closed year not archived yet **************/
+/*****************************************************************************/
+// Return 0 if all years are archived
+
+static unsigned LogArc_GetYearToArchive (void)
+  {
+   time_t YesterdayTime = time (NULL) - LogArc_SECONDS_PER_DAY;
+   struct tm tm;
+   unsigned Year;
+   unsigned FirstYear;
+   struct LogArc_Header Header;
+
+   /***** A year is closed one day after its end,
+          so clicks logged just before midnight are already in log *****/
+   if (localtime_r (&YesterdayTime,&tm) == NULL)
+      return 0;
+
+   /***** Skip years already archived *****/
+   for (Year = (unsigned) tm.tm_year + 1900 - 1;
+	Year;
+	Year--)
+      if (LogArc_CheckIfYearIsArchived (Year,&Header) == Exi_DOES_NOT_EXIST)
+	 break;
+
+   /***** Years before the first click are not archived *****/
+   FirstYear = LogArc_DB_GetFirstYearInLog ();
+   return FirstYear && Year >= FirstYear ? Year :
+					   0;
+  }
+
+/*****************************************************************************/
+/******** Append clicks in next day of a year to its partial archive *********/
+/*****************************************************************************/
+
+static void LogArc_ArchiveNextDay (unsigned Year)
+  {
+   static const unsigned Width[LogArc_NUM_DICS] =
+     {
+      [LogArc_ACTS] = 1,
+      [LogArc_HIES] = LogArc_HIE_WIDTH,
+      [LogArc_USRS] = 1,
+     };
+   char PathDir[PATH_MAX + 1];
+   char PathYear[PATH_MAX + 1];
+   char *PathFile;
+   struct LogArc_Header Header;
+   int FileDescriptor[LogArc_NUM_FILES];
+   struct LogArc_Dic Dics[LogArc_NUM_DICS];
+   LogArc_File_t File;
+   LogArc_Dic_t Dic;
+   int32_t *Cods;
+   size_t Size;
+   unsigned NumEntry;
+   MYSQL_RES *mysql_res;
+   unsigned NumClicks;
+   Err_SuccessOrError_t SuccessOrError = Err_SUCCESS;
+
+   /***** Get header of partial archive or begin a new one *****/
+   LogArc_BuildPath (PathDir,Year,true);
+   Fil_CreateDirIfNotExists (PathDir);
+   if (LogArc_ReadHeader (PathDir,&Header) == Err_ERROR ||
+       Header.Year != Year)
+     {
+      memset (&Header,0,sizeof (Header));
+      Header.Magic   = LogArc_MAGIC;
+      Header.Format  = LogArc_FORMAT;
+      Header.Year    = Year;
+      Header.NumDays = LogArc_GetNumDaysInYear (Year);
+      if (LogArc_DB_GetYearLimits (Year,&Header.StartTime,&Header.EndTime) == Err_ERROR)
+	 return;
+     }
+
+   /***** Open files, discarding anything written after last header,
+          for example by a process that did not finish *****/
+   for (File  = (LogArc_File_t) 0;
+	File <= (LogArc_File_t) (LogArc_NUM_FILES - 1);
+	File++)
+     {
+      if (asprintf (&PathFile,"%s/%s",PathDir,LogArc_FileName[File]) < 0)
+	 Err_NotEnoughMemoryExit ();
+      FileDescriptor[File] = open (PathFile,O_RDWR | O_CREAT,0600);
+      free (PathFile);
+      if (FileDescriptor[File] < 0)
+	 SuccessOrError = Err_ERROR;
+      else if (ftruncate (FileDescriptor[File],
+			  (off_t) LogArc_GetFileSize (&Header,File)) != 0)
+	 SuccessOrError = Err_ERROR;
+     }
+
+   /***** Load dictionaries *****/
+   for (Dic  = (LogArc_Dic_t) 0;
+	Dic <= (LogArc_Dic_t) (LogArc_NUM_DICS - 1);
+	Dic++)
+     {
+      LogArc_InitDic (&Dics[Dic],Width[Dic]);
+      if (SuccessOrError == Err_SUCCESS && Header.NumEntries[Dic])
+	{
+	 File = LogArc_DIC_ACT + Dic;
+	 Size = LogArc_GetFileSize (&Header,File);
+	 if ((Cods = malloc (Size)) == NULL)
+	    Err_NotEnoughMemoryExit ();
+	 if (pread (FileDescriptor[File],Cods,Size,0) == (ssize_t) Size)
+	    for (NumEntry = 0;
+		 NumEntry < Header.NumEntries[Dic];
+		 NumEntry++)
+	       LogArc_GetEntryInDic (&Dics[Dic],&Cods[NumEntry * Width[Dic]]);
+	 else
+	    SuccessOrError = Err_ERROR;
+	 free (Cods);
+	}
+     }
+
+   if (SuccessOrError == Err_SUCCESS)
+     {
+      /***** Get clicks in next day from database *****/
+      NumClicks = LogArc_DB_GetClicksInDay (&mysql_res,Year,Header.NextDay);
+
+      /***** Append clicks to files *****/
+      if (LogArc_AppendClicks (&Header,FileDescriptor,Dics,
+			       mysql_res,NumClicks) == Err_SUCCESS)
+	{
+	 /***** Header is written last, so data not referenced by it
+		will be discarded if something fails before *****/
+	 Header.NextDay++;
+	 Header.NumRows += NumClicks;
+	 for (Dic  = (LogArc_Dic_t) 0;
+	      Dic <= (LogArc_Dic_t) (LogArc_NUM_DICS - 1);
+	      Dic++)
+	    Header.NumEntries[Dic] = Dics[Dic].NumEntries;
+	 if (LogArc_WriteHeader (PathDir,&Header) == Err_SUCCESS)
+	    /***** Last day? ==> the year is complete *****/
+	    if (Header.NextDay >= Header.NumDays)
+	      {
+	       LogArc_BuildPath (PathYear,Year,false);
+	       Fil_RemoveTree (PathYear);	// Archive with an old format
+	       rename (PathDir,PathYear);
+	      }
+	}
+
+      /***** Free structure that stores the query result *****/
+      DB_FreeMySQLResult (&mysql_res);
+     }
+
+   /***** Free dictionaries and close files *****/
+   for (Dic  = (LogArc_Dic_t) 0;
+	Dic <= (LogArc_Dic_t) (LogArc_NUM_DICS - 1);
+	Dic++)
+      LogArc_FreeDic (&Dics[Dic]);
+   for (File  = (LogArc_File_t) 0;
+	File <= (LogArc_File_t) (LogArc_NUM_FILES - 1);
+	File++)
+      if (FileDescriptor[File] >= 0)
+	 close (FileDescriptor[File]);
+  }
+
+/*****************************************************************************/
+/******** Append clicks got from database to columns and dictionaries ********/
+/*****************************************************************************/
+
+static Err_SuccessOrError_t LogArc_AppendClicks (const struct LogArc_Header *Header,
+						 int FileDescriptor[LogArc_NUM_FILES],
+						 struct LogArc_Dic Dics[LogArc_NUM_DICS],
+						 MYSQL_RES *mysql_res,unsigned NumClicks)
+  {
+   MYSQL_ROW row;
+   unsigned NumClick;
+   time_t ClickTime;
+   int32_t Cods[LogArc_HIE_WIDTH];
+   unsigned NumCod;
+   unsigned Role;
+   unsigned Entry;
+   unsigned NumOldEntries[LogArc_NUM_DICS];
+   size_t NumRole;
+   uint32_t *Time;
+   uint16_t *Act;
+   uint32_t *Hie;
+   uint32_t *Usr;
+   uint8_t *Roles;
+   LogArc_Dic_t Dic;
+   LogArc_File_t File;
+   size_t Size;
+   const void *Buffer[LogArc_NUM_FILES];
+   size_t BufferSize[LogArc_NUM_FILES];
+   off_t Offset[LogArc_NUM_FILES];
+   Err_SuccessOrError_t SuccessOrError = Err_SUCCESS;
+
+   /***** Allocate columns for new clicks *****/
+   Size = (size_t) NumClicks + 1;
+   if ((Time  = malloc (Size * sizeof (*Time ))) == NULL ||
+       (Act   = malloc (Size * sizeof (*Act  ))) == NULL ||
+       (Hie   = malloc (Size * sizeof (*Hie  ))) == NULL ||
+       (Usr   = malloc (Size * sizeof (*Usr  ))) == NULL ||
+       (Roles = calloc (Size / 2 + 1,sizeof (*Roles))) == NULL)
+      Err_NotEnoughMemoryExit ();
+
+   /***** If the number of rows is odd,
+          the last byte of roles is rewritten with a new role *****/
+   NumRole = Header->NumRows & 1;
+   if (NumRole)
+      if (pread (FileDescriptor[LogArc_COL_ROLE],Roles,1,
+		 (off_t) (Header->NumRows / 2)) != 1)
+	 SuccessOrError = Err_ERROR;
+
+   for (Dic  = (LogArc_Dic_t) 0;
+	Dic <= (LogArc_Dic_t) (LogArc_NUM_DICS - 1);
+	Dic++)
+      NumOldEntries[Dic] = Dics[Dic].NumEntries;
+
+   /***** Convert each click to entries in dictionaries *****/
+   for (NumClick = 0;
+	SuccessOrError == Err_SUCCESS && NumClick < NumClicks;
+	NumClick++, NumRole++)
+     {
+      row = mysql_fetch_row (mysql_res);
+
+      /* Get time (row[0]) */
+      ClickTime = Dat_GetUNIXTimeFromStr (row[0]);
+      if (ClickTime < Header->StartTime)
+	 ClickTime = Header->StartTime;
+      else if (ClickTime >= Header->EndTime)
+	 ClickTime = Header->EndTime - 1;
+      Time[NumClick] = (uint32_t) (ClickTime - Header->StartTime);
+
+      /* Get action (row[1]) */
+      Cods[0] = (int32_t) Str_ConvertStrCodToLongCod (row[1]);
+      if ((Entry = LogArc_GetEntryInDic (&Dics[LogArc_ACTS],Cods)) >= LogArc_MAX_ACTS)
+	 SuccessOrError = Err_ERROR;
+      Act[NumClick] = (uint16_t) Entry;
+
+      /* Get country, institution, center, degree and course (row[2]...row[6]) */
+      for (NumCod = 0;
+	   NumCod < LogArc_HIE_WIDTH;
+	   NumCod++)
+	 Cods[NumCod] = (int32_t) Str_ConvertStrCodToLongCod (row[2 + NumCod]);
+      Hie[NumClick] = LogArc_GetEntryInDic (&Dics[LogArc_HIES],Cods);
+
+      /* Get user (row[7]) */
+      Cods[0] = (int32_t) Str_ConvertStrCodToLongCod (row[7]);
+      Usr[NumClick] = LogArc_GetEntryInDic (&Dics[LogArc_USRS],Cods);
+
+      /* Get role (row[8]) */
+      if (sscanf (row[8],"%u",&Role) != 1 || Role > 15)
+	 Role = (unsigned) Rol_UNK;
+      Roles[NumRole / 2] |= (uint8_t) (Role << ((NumRole & 1) << 2));
+     }
+
+   /***** Write new clicks at the end of columns
+          and new entries at the end of dictionaries *****/
+   if (SuccessOrError == Err_SUCCESS)
+     {
+      Buffer[LogArc_COL_TIME] = Time;
+      Buffer[LogArc_COL_ACT ] = Act;
+      Buffer[LogArc_COL_HIE ] = Hie;
+      Buffer[LogArc_COL_USR ] = Usr;
+      Buffer[LogArc_COL_ROLE] = Roles;
+      BufferSize[LogArc_COL_TIME] = (size_t) NumClicks * sizeof (*Time);
+      BufferSize[LogArc_COL_ACT ] = (size_t) NumClicks * sizeof (*Act );
+      BufferSize[LogArc_COL_HIE ] = (size_t) NumClicks * sizeof (*Hie );
+      BufferSize[LogArc_COL_USR ] = (size_t) NumClicks * sizeof (*Usr );
+      BufferSize[LogArc_COL_ROLE] = (Header->NumRows + NumClicks + 1) / 2 -
+				     Header->NumRows / 2;
+      for (File  = LogArc_COL_TIME;
+	   File <= LogArc_COL_USR;
+	   File++)
+	 Offset[File] = (off_t) LogArc_GetFileSize (Header,File);
+      Offset[LogArc_COL_ROLE] = (off_t) (Header->NumRows / 2);
+
+      for (Dic  = (LogArc_Dic_t) 0;
+	   Dic <= (LogArc_Dic_t) (LogArc_NUM_DICS - 1);
+	   Dic++)
+	{
+	 File = LogArc_DIC_ACT + Dic;
+	 Buffer[File]     = &Dics[Dic].Cods[NumOldEntries[Dic] * Dics[Dic].Width];
+	 BufferSize[File] = (size_t) (Dics[Dic].NumEntries - NumOldEntries[Dic]) *
+			    Dics[Dic].Width * sizeof (int32_t);
+	 Offset[File]     = (off_t) LogArc_GetFileSize (Header,File);
+	}
+
+      for (File  = (LogArc_File_t) 0;
+	   SuccessOrError == Err_SUCCESS && File <= (LogArc_File_t) (LogArc_NUM_FILES - 1);
+	   File++)
+	 if (BufferSize[File])
+	    if (pwrite (FileDescriptor[File],Buffer[File],BufferSize[File],
+			Offset[File]) != (ssize_t) BufferSize[File])
+	       SuccessOrError = Err_ERROR;
+     }
+
+   /***** Free columns *****/
+   free (Roles);
+   free (Usr);
+   free (Hie);
+   free (Act);
+   free (Time);
+
+   return SuccessOrError;
+  }
+
+/*****************************************************************************/
+/********************* Build path to directory of a year *********************/
+/*****************************************************************************/
+
+static void LogArc_BuildPath (char Path[PATH_MAX + 1],unsigned Year,bool Partial)
+  {
+   if (Partial)
+      snprintf (Path,PATH_MAX + 1,"%s/%u.%s",
+		Cfg_PATH_LOG_ARCHIVE_PRIVATE,Year,LogArc_SUFFIX_PARTIAL);
+   else
+      snprintf (Path,PATH_MAX + 1,"%s/%u",
+		Cfg_PATH_LOG_ARCHIVE_PRIVATE,Year);
+  }
+
+/*****************************************************************************/
+/********************** Read and write header of a year **********************/
+/*****************************************************************************/
+
+static Err_SuccessOrError_t LogArc_ReadHeader (const char *PathDir,
+					       struct LogArc_Header *Header)
+  {
+   char *PathFile;
+   int FileDescriptor;
+   Err_SuccessOrError_t SuccessOrError = Err_ERROR;
+
+   if (asprintf (&PathFile,"%s/%s",PathDir,LogArc_FILE_HEADER) < 0)
+      Err_NotEnoughMemoryExit ();
+   if ((FileDescriptor = open (PathFile,O_RDONLY)) >= 0)
+     {
+      if (pread (FileDescriptor,Header,sizeof (*Header),0) == (ssize_t) sizeof (*Header))
+	 if (Header->Magic  == LogArc_MAGIC &&
+	     Header->Format == LogArc_FORMAT &&
+	     Header->NextDay <= Header->NumDays &&
+	     Header->EndTime > Header->StartTime)
+	    SuccessOrError = Err_SUCCESS;
+      close (FileDescriptor);
+     }
+   free (PathFile);
+
+   return SuccessOrError;
+  }
+
+static Err_SuccessOrError_t LogArc_WriteHeader (const char *PathDir,
+						const struct LogArc_Header *Header)
+  {
+   char *PathFile;
+   char *PathTmp;
+   int FileDescriptor;
+   Err_SuccessOrError_t SuccessOrError = Err_ERROR;
+
+   /***** Write into a temporary file and replace old header atomically *****/
+   if (asprintf (&PathFile,"%s/%s",PathDir,LogArc_FILE_HEADER) < 0)
+      Err_NotEnoughMemoryExit ();
+   if (asprintf (&PathTmp,"%s.%d",PathFile,(int) getpid ()) < 0)
+      Err_NotEnoughMemoryExit ();
+   if ((FileDescriptor = open (PathTmp,O_WRONLY | O_CREAT | O_TRUNC,0600)) >= 0)
+     {
+      if (write (FileDescriptor,Header,sizeof (*Header)) == (ssize_t) sizeof (*Header))
+	 SuccessOrError = Err_SUCCESS;
+      if (close (FileDescriptor) != 0)
+	 SuccessOrError = Err_ERROR;
+      if (SuccessOrError == Err_SUCCESS)
+	 if (rename (PathTmp,PathFile) != 0)
+	    SuccessOrError = Err_ERROR;
+      if (SuccessOrError == Err_ERROR)
+	 unlink (PathTmp);
+     }
+   free (PathTmp);
+   free (PathFile);
+
+   return SuccessOrError;
+  }
+
+/*****************************************************************************/
+/****************** Check if a year is completely archived *******************/
+/*****************************************************************************/
+
+static Exi_Exist_t LogArc_CheckIfYearIsArchived (unsigned Year,
+						 struct LogArc_Header *Header)
+  {
+   char PathDir[PATH_MAX + 1];
+
+   LogArc_BuildPath (PathDir,Year,false);
+   if (LogArc_ReadHeader (PathDir,Header) == Err_SUCCESS)
+      if (Header->Year == Year &&
+	  Header->NextDay == Header->NumDays)
+	 return Exi_EXISTS;
+
+   return Exi_DOES_NOT_EXIST;
+  }
+
+/*****************************************************************************/
+/*********** Get size of a file of a year according to its header ************/
+/*****************************************************************************/
+
+static size_t LogArc_GetFileSize (const struct LogArc_Header *Header,
+				  LogArc_File_t File)
+  {
+   switch (File)
+     {
+      case LogArc_COL_TIME:
+      case LogArc_COL_HIE:
+      case LogArc_COL_USR:
+	 return Header->NumRows * sizeof (uint32_t);
+      case LogArc_COL_ACT:
+	 return Header->NumRows * sizeof (uint16_t);
+      case LogArc_COL_ROLE:
+	 return (Header->NumRows + 1) / 2;
+      case LogArc_DIC_ACT:
+	 return (size_t) Header->NumEntries[LogArc_ACTS] * sizeof (int32_t);
+      case LogArc_DIC_HIE:
+	 return (size_t) Header->NumEntries[LogArc_HIES] * LogArc_HIE_WIDTH * sizeof (int32_t);
+      case LogArc_DIC_USR:
+	 return (size_t) Header->NumEntries[LogArc_USRS] * sizeof (int32_t);
+      default:
+	 return 0;
+     }
+  }
+
+/*****************************************************************************/
+/*********************** Get number of days in a year ************************/
+/*****************************************************************************/
+
+static unsigned LogArc_GetNumDaysInYear (unsigned Year)
+  {
+   return (Year % 4 == 0 && Year % 100 != 0) || Year % 400 == 0 ? 366 :
+								  365;
+  }
+
+/*****************************************************************************/
+/********************* Map all files of an archived year *********************/
+/*****************************************************************************/
+
+static Err_SuccessOrError_t LogArc_MapYear (unsigned Year,struct LogArc_Year *Arc)
+  {
+   char PathDir[PATH_MAX + 1];
+   char *PathFile;
+   int FileDescriptor;
+   struct stat FileStatus;
+   void *Addr;
+   LogArc_File_t File;
+   Err_SuccessOrError_t SuccessOrError = Err_SUCCESS;
+
+   for (File  = (LogArc_File_t) 0;
+	File <= (LogArc_File_t) (LogArc_NUM_FILES - 1);
+	File++)
+     {
+      Arc->Addr[File] = NULL;
+      Arc->Size[File] = 0;
+     }
+
+   /***** Get header *****/
+   if (LogArc_CheckIfYearIsArchived (Year,&Arc->Header) == Exi_DOES_NOT_EXIST)
+      return Err_ERROR;
+
+   /***** Map files.
+          Files are never modified once the year is complete,
+          so mappings remain consistent while in use *****/
+   LogArc_BuildPath (PathDir,Year,false);
+   for (File  = (LogArc_File_t) 0;
+	SuccessOrError == Err_SUCCESS && File <= (LogArc_File_t) (LogArc_NUM_FILES - 1);
+	File++)
+     {
+      Arc->Size[File] = LogArc_GetFileSize (&Arc->Header,File);
+      if (Arc->Size[File])
+	{
+	 SuccessOrError = Err_ERROR;
+	 if (asprintf (&PathFile,"%s/%s",PathDir,LogArc_FileName[File]) < 0)
+	    Err_NotEnoughMemoryExit ();
+	 if ((FileDescriptor = open (PathFile,O_RDONLY)) >= 0)
+	   {
+	    if (fstat (FileDescriptor,&FileStatus) == 0 &&
+		(size_t) FileStatus.st_size == Arc->Size[File])
+	       if ((Addr = mmap (NULL,Arc->Size[File],PROT_READ,MAP_SHARED,
+				 FileDescriptor,0)) != MAP_FAILED)
+		 {
+		  Arc->Addr[File] = Addr;
+		  SuccessOrError = Err_SUCCESS;
+		 }
+	    close (FileDescriptor);
+	   }
+	 free (PathFile);
+	}
+     }
+
+   if (SuccessOrError == Err_ERROR)
+      LogArc_UnmapYear (Arc);
+
+   return SuccessOrError;
+  }
+
+static void LogArc_UnmapYear (struct LogArc_Year *Arc)
+  {
+   LogArc_File_t File;
+
+   for (File  = (LogArc_File_t) 0;
+	File <= (LogArc_File_t) (LogArc_NUM_FILES - 1);
+	File++)
+      if (Arc->Addr[File])
+	{
+	 munmap ((void *) Arc->Addr[File],Arc->Size[File]);
+	 Arc->Addr[File] = NULL;
+	}
+  }
+
+/*****************************************************************************/
+/********** Get hits in archived years into temporary table of hits **********/
+/*****************************************************************************/
+// Return Err_ERROR if archive can not be used for these statistics.
+// On success, *LiveStartTime is the time from which clicks
+// must be taken from database and added to the temporary table;
+// if it's after the range, the temporary table already has all the hits.
+
+Err_SuccessOrError_t LogArc_GetHits (const struct Sta_Stats *Stats,
+				     const char BrowserTimeZone[Dat_MAX_BYTES_TIME_ZONE + 1],
+				     time_t *LiveStartTime)
+  {
+   struct LogArc_Query Query;
+   struct LogArc_Header Header;
+   struct LogArc_Year Arc;
+   time_t StartTime = Dat_GetRangeTimeUTC (Dat_STR_TIME);
+   time_t EndTime   = Dat_GetRangeTimeUTC (Dat_END_TIME);
+   struct tm tm;
+   unsigned FirstYear = 0;
+   unsigned LastYear;
+   unsigned Year;
+
+   /***** Check if archive can give these statistics *****/
+   if (!LogArc_CheckIfCanGetHits (Stats))
+      return Err_ERROR;
+
+   /***** Find archived year which contains the beginning of the range *****/
+   if (localtime_r (&StartTime,&tm) == NULL)
+      return Err_ERROR;
+   for (Year  = (unsigned) tm.tm_year + 1900 - 1;
+	Year <= (unsigned) tm.tm_year + 1900 + 1;
+	Year++)
+      if (LogArc_CheckIfYearIsArchived (Year,&Header) == Exi_EXISTS)
+	 if (StartTime >= Header.StartTime &&
+	     StartTime <  Header.EndTime)
+	   {
+	    FirstYear = Year;
+	    break;
+	   }
+   if (!FirstYear)
+      return Err_ERROR;
+
+   /***** Find the following archived years in the range *****/
+   for (LastYear = FirstYear, *LiveStartTime = Header.EndTime;
+	EndTime >= *LiveStartTime &&
+	LogArc_CheckIfYearIsArchived (LastYear + 1,&Header) == Exi_EXISTS &&
+	Header.StartTime == *LiveStartTime;
+	LastYear++)
+      *LiveStartTime = Header.EndTime;
+
+   /***** Distinct users can not be added to those in database *****/
+   if (Stats->CountType != Sta_TOTAL_CLICKS &&
+       EndTime >= *LiveStartTime)
+      return Err_ERROR;
+
+   /***** Initialize query *****/
+   memset (&Query,0,sizeof (Query));
+   Query.Stats     = Stats;
+   Query.StartTime = StartTime;
+   Query.EndTime   = EndTime < *LiveStartTime ? EndTime :
+					        *LiveStartTime - 1;
+   Query.CountUsrs = Stats->CountType != Sta_TOTAL_CLICKS;
+   LogArc_InitDic (&Query.Cods,1);
+   LogArc_SetFilters (&Query);
+   if (LogArc_GetTimeZone (&Query,BrowserTimeZone) == Err_ERROR)
+     {
+      LogArc_FreeQuery (&Query);
+      return Err_ERROR;
+     }
+   LogArc_SetTimeGroups (&Query);
+
+   /***** Scan archived years, one by one *****/
+   for (Year  = FirstYear;
+	Year <= LastYear;
+	Year++)
+     {
+      if (LogArc_MapYear (Year,&Arc) == Err_ERROR)
+	{
+	 LogArc_FreeQuery (&Query);
+	 return Err_ERROR;
+	}
+      LogArc_ScanYear (&Query,&Arc);
+      LogArc_UnmapYear (&Arc);
+     }
+
+   /***** Store hits in temporary table *****/
+   LogArc_InsertHitsIntoTmpTable (&Query);
+
+   LogArc_FreeQuery (&Query);
+
+   return Err_SUCCESS;
+  }
+
+/*****************************************************************************/
+/************* Check if statistics can be computed from archive **************/
+/*****************************************************************************/
+// Only grouped global statistics of number of clicks or users.
+// Clicks joined with other tables or with times to generate
+// and send pages are not archived.
+
+static bool LogArc_CheckIfCanGetHits (const struct Sta_Stats *Stats)
+  {
+   if (Stats->GlobalOrCourse != Sta_SHOW_GLOBAL_ACCESSES)
+      return false;
+
+   switch (Stats->CountType)
+     {
+      case Sta_TOTAL_CLICKS:
+      case Sta_DISTINCT_USRS:
+      case Sta_CLICKS_PER_USR:
+	 break;
+      default:
+	 return false;
+     }
+
+   switch (Stats->ClicksGroupedBy)
+     {
+      case Sta_CLICKS_GBL_PER_DAY:
+      case Sta_CLICKS_GBL_PER_DAY_AND_HOUR:
+      case Sta_CLICKS_GBL_PER_WEEK:
+      case Sta_CLICKS_GBL_PER_MONTH:
+      case Sta_CLICKS_GBL_PER_YEAR:
+      case Sta_CLICKS_GBL_PER_HOUR:
+      case Sta_CLICKS_GBL_PER_MINUTE:
+      case Sta_CLICKS_GBL_PER_ACTION:
+      case Sta_CLICKS_GBL_PER_COUNTRY:
+      case Sta_CLICKS_GBL_PER_INSTITUTION:
+      case Sta_CLICKS_GBL_PER_CENTER:
+      case Sta_CLICKS_GBL_PER_DEGREE:
+      case Sta_CLICKS_GBL_PER_COURSE:
+	 return true;
+      default:
+	 return false;
+     }
+  }
+
+/*****************************************************************************/
+/************ Set filters of query, the same as in database query ************/
+/*****************************************************************************/
+
+static void LogArc_SetFilters (struct LogArc_Query *Query)
+  {
+   static const Rol_Role_t RoleOfStat[Sta_NUM_ROLES_STAT] =
+     {
+      [Sta_ROLE_INS_ADMINS          ] = Rol_INS_ADM,
+      [Sta_ROLE_CTR_ADMINS          ] = Rol_CTR_ADM,
+      [Sta_ROLE_DEG_ADMINS          ] = Rol_DEG_ADM,
+      [Sta_ROLE_TEACHERS            ] = Rol_TCH,
+      [Sta_ROLE_NON_EDITING_TEACHERS] = Rol_NET,
+      [Sta_ROLE_STUDENTS            ] = Rol_STD,
+      [Sta_ROLE_USERS               ] = Rol_USR,
+      [Sta_ROLE_GUESTS              ] = Rol_GST,
+      [Sta_ROLE_UNKNOWN_USRS        ] = Rol_UNK,
+     };
+   const struct Sta_Stats *Stats = Query->Stats;
+   unsigned Role;
+
+   /***** Scope *****/
+   Query->HieIdx = -1;
+   Query->HieCod = -1L;
+   switch (Stats->HieLvl)
+     {
+      case Hie_CTY:
+      case Hie_INS:
+      case Hie_CTR:
+      case Hie_DEG:
+	 if (Gbl.Hierarchy.Node[Stats->HieLvl].HieCod > 0)
+	   {
+	    Query->HieIdx = (int) (Stats->HieLvl - Hie_CTY);
+	    Query->HieCod = Gbl.Hierarchy.Node[Stats->HieLvl].HieCod;
+	   }
+	 break;
+      case Hie_CRS:
+	 if (Gbl.Hierarchy.HieLvl == Hie_CRS)
+	   {
+	    Query->HieIdx = (int) (Hie_CRS - Hie_CTY);
+	    Query->HieCod = Gbl.Hierarchy.Node[Hie_CRS].HieCod;
+	   }
+	 break;
+      default:
+	 break;
+     }
+
+   /***** Type of users *****/
+   Query->UsrCod = -1L;
+   for (Role = 0;
+	Role < 16;
+	Role++)
+      switch (Stats->Role)
+	{
+	 case Sta_ROLE_IDENTIFIED_USRS:
+	    Query->RoleOK[Role] = (Role != (unsigned) Rol_UNK);
+	    break;
+	 case Sta_ROLE_ALL_USRS:
+	    Query->RoleOK[Role] = Query->CountUsrs ? (Role != (unsigned) Rol_UNK) :
+						     1;
+	    break;
+	 case Sta_ROLE_ME:
+	    Query->RoleOK[Role] = 1;
+	    Query->UsrCod = Gbl.Usrs.Me.UsrDat.UsrCod;
+	    break;
+	 default:
+	    Query->RoleOK[Role] = (Role == (unsigned) RoleOfStat[Stats->Role]);
+	    break;
+	}
+
+   /***** Action *****/
+   Query->ActCod = Stats->NumAction == ActAll ? -1L :
+						Act_GetActCod (Stats->NumAction);
+  }
+
+/*****************************************************************************/
+/******** Get offsets of browser time zone in the range of the query *********/
+/*****************************************************************************/
+// MySQL CONVERT_TZ is emulated using time zone database of the C library.
+// If the time zone is not known here, the query is made in database.
+
+static Err_SuccessOrError_t LogArc_GetTimeZone (struct LogArc_Query *Query,
+						const char *BrowserTimeZone)
+  {
+   static const char *AllowedChars = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+				     "abcdefghijklmnopqrstuvwxyz"
+				     "0123456789/_+-";
+   char Sign;
+   unsigned Hours;
+   unsigned Minutes;
+   char *PathZone;
+   struct stat FileStatus;
+   char *OldTZ;
+   time_t Time;
+   time_t Lo;
+   time_t Hi;
+   time_t Mid;
+   long Offset;
+   Err_SuccessOrError_t SuccessOrError = Err_ERROR;
+
+   /***** Fixed offset, +hh:mm or -hh:mm *****/
+   if (sscanf (BrowserTimeZone,"%c%u:%u",&Sign,&Hours,&Minutes) == 3 &&
+       (Sign == '+' || Sign == '-') && Hours <= 14 && Minutes < 60)
+     {
+      Offset = (long) (Hours * 60 + Minutes) * 60;
+      LogArc_AddSegment (Query,Query->StartTime,Sign == '-' ? -Offset :
+							       Offset);
+      return Err_SUCCESS;
+     }
+
+   /***** Name of a time zone, for example Europe/Madrid *****/
+   if (!BrowserTimeZone[0] ||
+       BrowserTimeZone[0] == '/' ||
+       BrowserTimeZone[strspn (BrowserTimeZone,AllowedChars)] ||
+       strstr (BrowserTimeZone,".."))
+      return Err_ERROR;
+   if (asprintf (&PathZone,"%s/%s",LogArc_PATH_ZONEINFO,BrowserTimeZone) < 0)
+      Err_NotEnoughMemoryExit ();
+   if (stat (PathZone,&FileStatus) == 0 && S_ISREG (FileStatus.st_mode))
+     {
+      /***** Set time zone temporarily *****/
+      OldTZ = getenv ("TZ");
+      if (OldTZ)
+	 if ((OldTZ = strdup (OldTZ)) == NULL)
+	    Err_NotEnoughMemoryExit ();
+      setenv ("TZ",BrowserTimeZone,1);
+      tzset ();
+
+      /***** Get offset at the beginning of each day
+             and find the exact time of each change *****/
+      Offset = LogArc_GetOffset (Query->StartTime);
+      LogArc_AddSegment (Query,Query->StartTime,Offset);
+      for (Time = Query->StartTime;
+	   Time < Query->EndTime;
+	   Time += LogArc_SECONDS_PER_DAY)
+	{
+	 Hi = Time + LogArc_SECONDS_PER_DAY;
+	 if (Hi > Query->EndTime)
+	    Hi = Query->EndTime;
+	 if (LogArc_GetOffset (Hi) != Offset)
+	   {
+	    /* Binary search of the first second with the new offset */
+	    for (Lo = Time;
+		 Hi - Lo > 1;
+		)
+	      {
+	       Mid = Lo + (Hi - Lo) / 2;
+	       if (LogArc_GetOffset (Mid) == Offset)
+		  Lo = Mid;
+	       else
+		  Hi = Mid;
+	      }
+	    Offset = LogArc_GetOffset (Hi);
+	    LogArc_AddSegment (Query,Hi,Offset);
+	   }
+	}
+
+      /***** Restore time zone *****/
+      if (OldTZ)
+	{
+	 setenv ("TZ",OldTZ,1);
+	 free (OldTZ);
+	}
+      else
+	 unsetenv ("TZ");
+      tzset ();
+
+      SuccessOrError = Err_SUCCESS;
+     }
+   free (PathZone);
+
+   return SuccessOrError;
+  }
+
+static void LogArc_AddSegment (struct LogArc_Query *Query,time_t Start,long Offset)
+  {
+   if ((Query->TZ.Lst = realloc (Query->TZ.Lst,(Query->TZ.Num + 1) *
+					       sizeof (*Query->TZ.Lst))) == NULL)
+      Err_NotEnoughMemoryExit ();
+   Query->TZ.Lst[Query->TZ.Num].Start  = Start;
+   Query->TZ.Lst[Query->TZ.Num].Offset = Offset;
+   if (!Query->TZ.Num || Offset < Query->TZ.Min)
+      Query->TZ.Min = Offset;
+   if (!Query->TZ.Num || Offset > Query->TZ.Max)
+      Query->TZ.Max = Offset;
+   Query->TZ.Num++;
+  }
+
+static long LogArc_GetOffset (time_t Time)
+  {
+   struct tm tm;
+
+   return localtime_r (&Time,&tm) ? tm.tm_gmtoff :
+				    0;
+  }
+
+/*****************************************************************************/
+/***** Set groups of local days, weeks, months, years, hours or minutes ******/
+/*****************************************************************************/
+
+static void LogArc_SetTimeGroups (struct LogArc_Query *Query)
+  {
+   long LastDay;
+   unsigned NumDay;
+   uint32_t Key;
+
+   /***** Range of local days *****/
+   Query->FirstDay = (Query->StartTime + Query->TZ.Min) / LogArc_SECONDS_PER_DAY;
+   LastDay         = (Query->EndTime   + Query->TZ.Max) / LogArc_SECONDS_PER_DAY;
+   Query->NumDays  = (unsigned) (LastDay - Query->FirstDay + 1);
+
+   switch (Query->Stats->ClicksGroupedBy)
+     {
+      case Sta_CLICKS_GBL_PER_DAY:
+	 LogArc_AllocateGroups (Query,Query->NumDays);
+	 break;
+      case Sta_CLICKS_GBL_PER_DAY_AND_HOUR:
+	 LogArc_AllocateGroups (Query,Query->NumDays * 24);
+	 break;
+      case Sta_CLICKS_GBL_PER_WEEK:
+      case Sta_CLICKS_GBL_PER_MONTH:
+      case Sta_CLICKS_GBL_PER_YEAR:
+	 /* Keys of consecutive days never decrease,
+	    so a new group begins when key changes */
+	 if ((Query->GroupOfDay = malloc ((size_t) Query->NumDays *
+					  sizeof (*Query->GroupOfDay))) == NULL ||
+	     (Query->KeyOfGroup = malloc ((size_t) Query->NumDays *
+					  sizeof (*Query->KeyOfGroup))) == NULL)
+	    Err_NotEnoughMemoryExit ();
+	 for (NumDay = 0;
+	      NumDay < Query->NumDays;
+	      NumDay++)
+	   {
+	    Key = LogArc_GetKeyOfDay (Query->Stats->ClicksGroupedBy,
+				      Query->FirstDay + (long) NumDay);
+	    if (!NumDay || Key != Query->KeyOfGroup[Query->NumGroups - 1])
+	       Query->KeyOfGroup[Query->NumGroups++] = Key;
+	    Query->GroupOfDay[NumDay] = Query->NumGroups - 1;
+	   }
+	 LogArc_AllocateGroups (Query,Query->NumGroups);
+	 break;
+      case Sta_CLICKS_GBL_PER_HOUR:
+	 LogArc_AllocateGroups (Query,24);
+	 break;
+      case Sta_CLICKS_GBL_PER_MINUTE:
+	 LogArc_AllocateGroups (Query,24 * 60);
+	 break;
+      default:	// Groups of codes are added while scanning
+	 break;
+     }
+  }
+
+static void LogArc_AllocateGroups (struct LogArc_Query *Query,unsigned NumGroups)
+  {
+   unsigned MaxGroups;
+
+   if (NumGroups > Query->MaxGroups)
+     {
+      MaxGroups = Query->MaxGroups ? Query->MaxGroups : 256;
+      while (MaxGroups < NumGroups)
+	 MaxGroups *= 2;
+      if ((Query->NumClicks = realloc (Query->NumClicks,
+				       MaxGroups * sizeof (*Query->NumClicks))) == NULL ||
+	  (Query->NumUsrs   = realloc (Query->NumUsrs,
+				       MaxGroups * sizeof (*Query->NumUsrs  ))) == NULL)
+	 Err_NotEnoughMemoryExit ();
+      memset (&Query->NumClicks[Query->MaxGroups],0,
+	      (MaxGroups - Query->MaxGroups) * sizeof (*Query->NumClicks));
+      memset (&Query->NumUsrs[Query->MaxGroups],0,
+	      (MaxGroups - Query->MaxGroups) * sizeof (*Query->NumUsrs));
+      Query->MaxGroups = MaxGroups;
+     }
+   Query->NumGroups = NumGroups;
+  }
+
+/*****************************************************************************/
+/********* Scan clicks of an archived year in the range of the query *********/
+/*****************************************************************************/
+
+static void LogArc_ScanYear (struct LogArc_Query *Query,const struct LogArc_Year *Arc)
+  {
+   const uint32_t *Time        = Arc->Addr[LogArc_COL_TIME];
+   const int32_t  *ActCods     = Arc->Addr[LogArc_DIC_ACT];
+   const int32_t  *HieCods     = Arc->Addr[LogArc_DIC_HIE];
+   const int32_t  *UsrCods     = Arc->Addr[LogArc_DIC_USR];
+   const unsigned NumActs = Arc->Header.NumEntries[LogArc_ACTS];
+   const unsigned NumHies = Arc->Header.NumEntries[LogArc_HIES];
+   const unsigned NumUsrs = Arc->Header.NumEntries[LogArc_USRS];
+   time_t Base = Arc->Header.StartTime;
+   uint8_t *HieOK;
+   uint8_t *ActOK;
+   uint8_t *UsrOK;
+   unsigned *GroupOfEntry = NULL;
+   unsigned Entry;
+   size_t FirstRow;
+   size_t EndRow;
+   size_t SegFirstRow;
+   size_t SegEndRow;
+   size_t Row;
+   unsigned NumSeg;
+   unsigned NumRows;
+
+   if (!Arc->Header.NumRows)
+      return;
+
+   /***** Rows in range of time (clicks are sorted by time) *****/
+   FirstRow = LogArc_GetFirstRowAtOrAfter (Time,Arc->Header.NumRows,
+					   (int64_t) (Query->StartTime - Base));
+   EndRow   = LogArc_GetFirstRowAtOrAfter (Time,Arc->Header.NumRows,
+					   (int64_t) (Query->EndTime - Base) + 1);
+   if (FirstRow >= EndRow)
+      return;
+
+   /***** Which entries of dictionaries pass the filters *****/
+   if ((HieOK = malloc ((size_t) NumHies + 1)) == NULL ||
+       (ActOK = malloc ((size_t) NumActs + 1)) == NULL ||
+       (UsrOK = malloc ((size_t) NumUsrs + 1)) == NULL)
+      Err_NotEnoughMemoryExit ();
+   for (Entry = 0;
+	Entry < NumHies;
+	Entry++)
+      HieOK[Entry] = Query->HieIdx < 0 ||
+		     HieCods[Entry * LogArc_HIE_WIDTH + Query->HieIdx] == Query->HieCod;
+   for (Entry = 0;
+	Entry < NumActs;
+	Entry++)
+      ActOK[Entry] = Query->ActCod < 0 ||
+		     ActCods[Entry] == Query->ActCod;
+   for (Entry = 0;
+	Entry < NumUsrs;
+	Entry++)
+      UsrOK[Entry] = Query->UsrCod < 0 ||
+		     UsrCods[Entry] == Query->UsrCod;
+
+   /***** Group of each entry when grouping by codes *****/
+   switch (Query->Stats->ClicksGroupedBy)
+     {
+      case Sta_CLICKS_GBL_PER_ACTION:
+	 if ((GroupOfEntry = malloc ((size_t) NumActs * sizeof (*GroupOfEntry) + 1)) == NULL)
+	    Err_NotEnoughMemoryExit ();
+	 for (Entry = 0;
+	      Entry < NumActs;
+	      Entry++)
+	    GroupOfEntry[Entry] = LogArc_GetEntryInDic (&Query->Cods,&ActCods[Entry]);
+	 LogArc_AllocateGroups (Query,Query->Cods.NumEntries);
+	 break;
+      case Sta_CLICKS_GBL_PER_COUNTRY:
+      case Sta_CLICKS_GBL_PER_INSTITUTION:
+      case Sta_CLICKS_GBL_PER_CENTER:
+      case Sta_CLICKS_GBL_PER_DEGREE:
+      case Sta_CLICKS_GBL_PER_COURSE:
+	 if ((GroupOfEntry = malloc ((size_t) NumHies * sizeof (*GroupOfEntry) + 1)) == NULL)
+	    Err_NotEnoughMemoryExit ();
+	 for (Entry = 0;
+	      Entry < NumHies;
+	      Entry++)
+	    GroupOfEntry[Entry] = LogArc_GetEntryInDic (&Query->Cods,
+							&HieCods[Entry * LogArc_HIE_WIDTH +
+								 (Query->Stats->ClicksGroupedBy -
+								  Sta_CLICKS_GBL_PER_COUNTRY)]);
+	 LogArc_AllocateGroups (Query,Query->Cods.NumEntries);
+	 break;
+      default:
+	 break;
+     }
+
+   /***** Scan rows in each interval with constant time zone offset,
+          in chunks processed column by column *****/
+   for (NumSeg = 0;
+	NumSeg < Query->TZ.Num;
+	NumSeg++)
+     {
+      SegFirstRow = NumSeg ? LogArc_GetFirstRowAtOrAfter (Time,Arc->Header.NumRows,
+							  (int64_t) (Query->TZ.Lst[NumSeg].Start - Base)) :
+			     FirstRow;
+      SegEndRow   = NumSeg + 1 < Query->TZ.Num ? LogArc_GetFirstRowAtOrAfter (Time,Arc->Header.NumRows,
+									      (int64_t) (Query->TZ.Lst[NumSeg + 1].Start - Base)) :
+						 EndRow;
+      if (SegFirstRow < FirstRow)
+	 SegFirstRow = FirstRow;
+      if (SegEndRow > EndRow)
+	 SegEndRow = EndRow;
+
+      for (Row = SegFirstRow;
+	   Row < SegEndRow;
+	   Row += NumRows)
+	{
+	 NumRows = SegEndRow - Row < LogArc_ROWS_PER_CHUNK ? (unsigned) (SegEndRow - Row) :
+							     LogArc_ROWS_PER_CHUNK;
+	 LogArc_ScanChunk (Query,Arc,HieOK,ActOK,UsrOK,GroupOfEntry,
+			   Row,NumRows,Query->TZ.Lst[NumSeg].Offset);
+	}
+     }
+
+   /***** Free filters and groups *****/
+   free (GroupOfEntry);
+   free (UsrOK);
+   free (ActOK);
+   free (HieOK);
+  }
+
+static size_t LogArc_GetFirstRowAtOrAfter (const uint32_t *Time,size_t NumRows,
+					   int64_t Seconds)
+  {
+   size_t Lo = 0;
+   size_t Hi = NumRows;
+   size_t Mid;
+
+   if (Seconds <= 0)
+      return 0;
+   if (Seconds > (int64_t) UINT32_MAX)
+      return NumRows;
+
+   while (Lo < Hi)
+     {
+      Mid = Lo + (Hi - Lo) / 2;
+      if ((int64_t) Time[Mid] < Seconds)
+	 Lo = Mid + 1;
+      else
+	 Hi = Mid;
+     }
+
+   return Lo;
+  }
+
+/*****************************************************************************/
+/*********** Count clicks and users in a chunk of consecutive rows ***********/
+/*****************************************************************************/
+// Each step is a simple loop over one column, without branches,
+// which the compiler can vectorize
+
+static void LogArc_ScanChunk (struct LogArc_Query *Query,const struct LogArc_Year *Arc,
+			      const uint8_t *HieOK,const uint8_t *ActOK,const uint8_t *UsrOK,
+			      const unsigned *GroupOfEntry,
+			      size_t FirstRow,unsigned NumRows,long Offset)
+  {
+   const uint32_t *Time  = (const uint32_t *) Arc->Addr[LogArc_COL_TIME] + FirstRow;
+   const uint16_t *Act   = (const uint16_t *) Arc->Addr[LogArc_COL_ACT ] + FirstRow;
+   const uint32_t *Hie   = (const uint32_t *) Arc->Addr[LogArc_COL_HIE ] + FirstRow;
+   const uint32_t *Usr   = (const uint32_t *) Arc->Addr[LogArc_COL_USR ] + FirstRow;
+   const uint8_t  *Roles = Arc->Addr[LogArc_COL_ROLE];
+   const int32_t  *UsrCods = Arc->Addr[LogArc_DIC_USR];
+   uint8_t Mask[LogArc_ROWS_PER_CHUNK];
+   unsigned Group[LogArc_ROWS_PER_CHUNK];
+   int64_t Local;
+   int64_t Base = (int64_t) Arc->Header.StartTime + Offset -
+		  (int64_t) Query->FirstDay * LogArc_SECONDS_PER_DAY;
+   size_t Row;
+   unsigned i;
+
+   /***** Filter *****/
+   for (i = 0;
+	i < NumRows;
+	i++)
+     {
+      Row = FirstRow + i;
+      Mask[i] = Query->RoleOK[(Roles[Row >> 1] >> ((Row & 1) << 2)) & 15] &
+		HieOK[Hie[i]] &
+		ActOK[Act[i]] &
+		UsrOK[Usr[i]];
+     }
+
+   /***** Group of each row *****/
+   // Local is seconds since the beginning of first local day
+   switch (Query->Stats->ClicksGroupedBy)
+     {
+      case Sta_CLICKS_GBL_PER_DAY:
+	 for (i = 0;
+	      i < NumRows;
+	      i++)
+	    Group[i] = (unsigned) ((Base + Time[i]) / LogArc_SECONDS_PER_DAY);
+	 break;
+      case Sta_CLICKS_GBL_PER_DAY_AND_HOUR:
+	 for (i = 0;
+	      i < NumRows;
+	      i++)
+	    Group[i] = (unsigned) ((Base + Time[i]) / (60 * 60));
+	 break;
+      case Sta_CLICKS_GBL_PER_WEEK:
+      case Sta_CLICKS_GBL_PER_MONTH:
+      case Sta_CLICKS_GBL_PER_YEAR:
+	 for (i = 0;
+	      i < NumRows;
+	      i++)
+	    Group[i] = Query->GroupOfDay[(Base + Time[i]) / LogArc_SECONDS_PER_DAY];
+	 break;
+      case Sta_CLICKS_GBL_PER_HOUR:
+	 for (i = 0;
+	      i < NumRows;
+	      i++)
+	   {
+	    Local = Base + Time[i];
+	    Group[i] = (unsigned) ((Local % LogArc_SECONDS_PER_DAY) / (60 * 60));
+	   }
+	 break;
+      case Sta_CLICKS_GBL_PER_MINUTE:
+	 for (i = 0;
+	      i < NumRows;
+	      i++)
+	   {
+	    Local = Base + Time[i];
+	    Group[i] = (unsigned) ((Local % LogArc_SECONDS_PER_DAY) / 60);
+	   }
+	 break;
+      case Sta_CLICKS_GBL_PER_ACTION:
+	 for (i = 0;
+	      i < NumRows;
+	      i++)
+	    Group[i] = GroupOfEntry[Act[i]];
+	 break;
+      default:	// Country, institution, center, degree or course
+	 for (i = 0;
+	      i < NumRows;
+	      i++)
+	    Group[i] = GroupOfEntry[Hie[i]];
+	 break;
+     }
+
+   /***** Count clicks *****/
+   for (i = 0;
+	i < NumRows;
+	i++)
+      Query->NumClicks[Group[i]] += Mask[i];
+
+   /***** Count distinct users *****/
+   if (Query->CountUsrs)
+      for (i = 0;
+	   i < NumRows;
+	   i++)
+	 if (Mask[i])
+	    if (LogArc_AddKeyToSet (&Query->Pairs,
+				    (uint64_t) Group[i] << 32 |
+				    (uint32_t) UsrCods[Usr[i]]))
+	       Query->NumUsrs[Group[i]]++;
+  }
+
+/*****************************************************************************/
+/********** Insert hits of groups with clicks into temporary table ***********/
+/*****************************************************************************/
+
+static void LogArc_InsertHitsIntoTmpTable (const struct LogArc_Query *Query)
+  {
+   char *Values;
+   size_t Length = 0;
+   unsigned Group;
+   unsigned Year;
+   unsigned Month;
+   unsigned Day;
+   char Key1[Cns_MAX_DIGITS_LONG + 1];
+   char Key2[2 + 1];
+   char Num[Cns_MAX_DIGITS_ULONGLONG + 1 + 6 + 1];	// Integer part, point and 6 decimals
+
+   if ((Values = malloc (LogArc_MAX_BYTES_VALUES + 256)) == NULL)
+      Err_NotEnoughMemoryExit ();
+   Values[0] = '\0';
+
+   Sta_DB_CreateTmpTableHits ();
+
+   for (Group = 0;
+	Group < Query->NumGroups;
+	Group++)
+      if (Query->NumClicks[Group])
+	{
+	 /***** Key of group, as formatted by database *****/
+	 Key2[0] = '\0';
+	 switch (Query->Stats->ClicksGroupedBy)
+	   {
+	    case Sta_CLICKS_GBL_PER_DAY:
+	       LogArc_GetCivilFromDays (Query->FirstDay + (long) Group,&Year,&Month,&Day);
+	       snprintf (Key1,sizeof (Key1),"%04u%02u%02u",Year,Month,Day);
+	       break;
+	    case Sta_CLICKS_GBL_PER_DAY_AND_HOUR:
+	       LogArc_GetCivilFromDays (Query->FirstDay + (long) (Group / 24),&Year,&Month,&Day);
+	       snprintf (Key1,sizeof (Key1),"%04u%02u%02u",Year,Month,Day);
+	       snprintf (Key2,sizeof (Key2),"%02u",Group % 24);
+	       break;
+	    case Sta_CLICKS_GBL_PER_WEEK:
+	    case Sta_CLICKS_GBL_PER_MONTH:
+	       snprintf (Key1,sizeof (Key1),"%06u",(unsigned) Query->KeyOfGroup[Group]);
+	       break;
+	    case Sta_CLICKS_GBL_PER_YEAR:
+	       snprintf (Key1,sizeof (Key1),"%04u",(unsigned) Query->KeyOfGroup[Group]);
+	       break;
+	    case Sta_CLICKS_GBL_PER_HOUR:
+	       snprintf (Key1,sizeof (Key1),"%02u",Group);
+	       break;
+	    case Sta_CLICKS_GBL_PER_MINUTE:
+	       snprintf (Key1,sizeof (Key1),"%02u%02u",Group / 60,Group % 60);
+	       break;
+	    default:	// Code of action, country, institution, center, degree or course
+	       snprintf (Key1,sizeof (Key1),"%d",(int) Query->Cods.Cods[Group]);
+	       break;
+	   }
+
+	 /***** Number *****/
+	 switch (Query->Stats->CountType)
+	   {
+	    case Sta_DISTINCT_USRS:
+	       snprintf (Num,sizeof (Num),"%llu",
+			 (unsigned long long) Query->NumUsrs[Group]);
+	       break;
+	    case Sta_CLICKS_PER_USR:
+	       snprintf (Num,sizeof (Num),"%.6f",
+			 (double) Query->NumClicks[Group] /
+			 (double) (Query->NumUsrs[Group] ? Query->NumUsrs[Group] :
+							   1));
+	       break;
+	    case Sta_TOTAL_CLICKS:
+	    default:
+	       snprintf (Num,sizeof (Num),"%llu",
+			 (unsigned long long) Query->NumClicks[Group]);
+	       break;
+	   }
+
+	 /***** Add to values and insert if too long *****/
+	 Length += (size_t) snprintf (&Values[Length],256,"%s('%s','%s',%s)",
+				      Length ? "," : "",Key1,Key2,Num);
+	 if (Length >= LogArc_MAX_BYTES_VALUES)
+	   {
+	    Sta_DB_InsertIntoTmpTableHits (Values);
+	    Length = 0;
+	    Values[0] = '\0';
+	   }
+	}
+   if (Length)
+      Sta_DB_InsertIntoTmpTableHits (Values);
+
+   free (Values);
+  }
+
+/*****************************************************************************/
+/************************ Free memory used by a query ************************/
+/*****************************************************************************/
+
+static void LogArc_FreeQuery (struct LogArc_Query *Query)
+  {
+   free (Query->TZ.Lst);
+   free (Query->GroupOfDay);
+   free (Query->KeyOfGroup);
+   LogArc_FreeDic (&Query->Cods);
+   free (Query->NumClicks);
+   free (Query->NumUsrs);
+   free (Query->Pairs.Slots);
+  }
+
+/*****************************************************************************/
+/*************************** Dictionaries of codes ***************************/
+/*****************************************************************************/
+
+static void LogArc_InitDic (struct LogArc_Dic *Dic,unsigned Width)
+  {
+   Dic->Width      = Width;
+   Dic->NumEntries = 0;
+   Dic->MaxEntries = 0;
+   Dic->Cods       = NULL;
+   Dic->NumSlots   = 0;
+   Dic->Slots      = NULL;
+  }
+
+static void LogArc_FreeDic (struct LogArc_Dic *Dic)
+  {
+   free (Dic->Slots);
+   free (Dic->Cods);
+   LogArc_InitDic (Dic,Dic->Width);
+  }
+
+// Return the entry with these codes, adding it if it's not in dictionary
+
+static unsigned LogArc_GetEntryInDic (struct LogArc_Dic *Dic,const int32_t *Cods)
+  {
+   unsigned Slot;
+   unsigned Entry;
+   unsigned NumCod;
+
+   /***** Keep the hash table at most half full *****/
+   if (2 * (Dic->NumEntries + 1) > Dic->NumSlots)
+      LogArc_ResizeSlotsOfDic (Dic);
+
+   /***** Search entry *****/
+   for (Slot = LogArc_HashCods (Cods,Dic->Width) & (Dic->NumSlots - 1);
+	Dic->Slots[Slot];
+	Slot = (Slot + 1) & (Dic->NumSlots - 1))
+     {
+      Entry = Dic->Slots[Slot] - 1;
+      for (NumCod = 0;
+	   NumCod < Dic->Width;
+	   NumCod++)
+	 if (Dic->Cods[Entry * Dic->Width + NumCod] != Cods[NumCod])
+	    break;
+      if (NumCod == Dic->Width)	// Found
+	 return Entry;
+     }
+
+   /***** Not found ==> add a new entry *****/
+   if (Dic->NumEntries == Dic->MaxEntries)
+     {
+      Dic->MaxEntries = Dic->MaxEntries ? Dic->MaxEntries * 2 :
+					  256;
+      if ((Dic->Cods = realloc (Dic->Cods,(size_t) Dic->MaxEntries * Dic->Width *
+					  sizeof (*Dic->Cods))) == NULL)
+	 Err_NotEnoughMemoryExit ();
+     }
+   Entry = Dic->NumEntries++;
+   for (NumCod = 0;
+	NumCod < Dic->Width;
+	NumCod++)
+      Dic->Cods[Entry * Dic->Width + NumCod] = Cods[NumCod];
+   Dic->Slots[Slot] = Entry + 1;
+
+   return Entry;
+  }
+
+static void LogArc_ResizeSlotsOfDic (struct LogArc_Dic *Dic)
+  {
+   unsigned Entry;
+   unsigned Slot;
+
+   Dic->NumSlots = Dic->NumSlots ? Dic->NumSlots * 2 :
+				   1024;
+   free (Dic->Slots);
+   if ((Dic->Slots = calloc ((size_t) Dic->NumSlots,sizeof (*Dic->Slots))) == NULL)
+      Err_NotEnoughMemoryExit ();
+
+   for (Entry = 0;
+	Entry < Dic->NumEntries;
+	Entry++)
+     {
+      for (Slot = LogArc_HashCods (&Dic->Cods[Entry * Dic->Width],Dic->Width) &
+		  (Dic->NumSlots - 1);
+	   Dic->Slots[Slot];
+	   Slot = (Slot + 1) & (Dic->NumSlots - 1));
+      Dic->Slots[Slot] = Entry + 1;
+     }
+  }
+
+static unsigned LogArc_HashCods (const int32_t *Cods,unsigned Width)
+  {
+   uint64_t Hash = 0;
+   unsigned NumCod;
+
+   for (NumCod = 0;
+	NumCod < Width;
+	NumCod++)
+      Hash = (Hash + (uint32_t) Cods[NumCod]) * 0x9E3779B97F4A7C15ULL;
+
+   return (unsigned) (Hash >> 32);
+  }
+
+/*****************************************************************************/
+/**************************** Set of 64-bit keys *****************************/
+/*****************************************************************************/
+// Return true if the key was not in the set
+
+static bool LogArc_AddKeyToSet (struct LogArc_Set *Set,uint64_t Key)
+  {
+   uint64_t *OldSlots;
+   size_t OldNumSlots;
+   size_t NumSlot;
+   size_t Slot;
+
+   /***** Keep the hash table at most half full *****/
+   if (2 * (Set->NumKeys + 1) > Set->NumSlots)
+     {
+      OldSlots    = Set->Slots;
+      OldNumSlots = Set->NumSlots;
+      Set->NumSlots = OldNumSlots ? OldNumSlots * 2 :
+				    4096;
+      if ((Set->Slots = malloc (Set->NumSlots * sizeof (*Set->Slots))) == NULL)
+	 Err_NotEnoughMemoryExit ();
+      memset (Set->Slots,0xFF,Set->NumSlots * sizeof (*Set->Slots));	// LogArc_EMPTY_KEY
+      Set->NumKeys = 0;
+      for (NumSlot = 0;
+	   NumSlot < OldNumSlots;
+	   NumSlot++)
+	 if (OldSlots[NumSlot] != LogArc_EMPTY_KEY)
+	    LogArc_AddKeyToSet (Set,OldSlots[NumSlot]);
+      free (OldSlots);
+     }
+
+   /***** Search key *****/
+   for (Slot = (size_t) ((Key * 0x9E3779B97F4A7C15ULL) >> 32) & (Set->NumSlots - 1);
+	Set->Slots[Slot] != LogArc_EMPTY_KEY;
+	Slot = (Slot + 1) & (Set->NumSlots - 1))
+      if (Set->Slots[Slot] == Key)
+	 return false;
+
+   /***** Not found ==> add it *****/
+   Set->Slots[Slot] = Key;
+   Set->NumKeys++;
+   return true;
+  }
+
+/*****************************************************************************/
+/************ Conversions between days since 1970-01-01 and dates ************/
+/*****************************************************************************/
+// Algorithms from http://howardhinnant.github.io/date_algorithms.html
+
+static long LogArc_GetDaysFromCivil (long Year,unsigned Month,unsigned Day)
+  {
+   long Era;
+   unsigned YearOfEra;
+   unsigned DayOfYear;
+   unsigned DayOfEra;
+
+   Year -= Month <= 2;
+   Era = (Year >= 0 ? Year : Year - 399) / 400;
+   YearOfEra = (unsigned) (Year - Era * 400);
+   DayOfYear = (153 * (Month > 2 ? Month - 3 : Month + 9) + 2) / 5 + Day - 1;
+   DayOfEra = YearOfEra * 365 + YearOfEra / 4 - YearOfEra / 100 + DayOfYear;
+
+   return Era * 146097 + (long) DayOfEra - 719468;
+  }
+
+static void LogArc_GetCivilFromDays (long Days,
+				     unsigned *Year,unsigned *Month,unsigned *Day)
+  {
+   long Era;
+   unsigned DayOfEra;
+   unsigned YearOfEra;
+   unsigned DayOfYear;
+   unsigned MonthFromMarch;
+
+   Days += 719468;
+   Era = (Days >= 0 ? Days : Days - 146096) / 146097;
+   DayOfEra = (unsigned) (Days - Era * 146097);
+   YearOfEra = (DayOfEra - DayOfEra / 1460 + DayOfEra / 36524 - DayOfEra / 146096) / 365;
+   DayOfYear = DayOfEra - (365 * YearOfEra + YearOfEra / 4 - YearOfEra / 100);
+   MonthFromMarch = (5 * DayOfYear + 2) / 153;
+   *Day   = DayOfYear - (153 * MonthFromMarch + 2) / 5 + 1;
+   *Month = MonthFromMarch < 10 ? MonthFromMarch + 3 :
+				  MonthFromMarch - 9;
+   *Year  = (unsigned) ((long) YearOfEra + Era * 400 + (*Month <= 2));
+  }
+
+/*****************************************************************************/
+/********* Get key of a day as number in the same format as database *********/
+/*****************************************************************************/
+// Weeks as in DATE_FORMAT %x%v (starting on monday)
+// or %X%V (starting on sunday), depending on preferences
+
+static uint32_t LogArc_GetKeyOfDay (Sta_ClicksGroupedBy_t ClicksGroupedBy,long Days)
+  {
+   unsigned Year;
+   unsigned Month;
+   unsigned Day;
+   long WeekDay;	// 0 = sunday
+   long FirstDayOfWeek;
+   long DayInWeek;	// Thursday in ISO weeks, sunday in others
+
+   switch (ClicksGroupedBy)
+     {
+      case Sta_CLICKS_GBL_PER_WEEK:
+	 WeekDay = ((Days % 7) + 7 + 4) % 7;	// 1970-01-01 was thursday
+	 if (Gbl.Prefs.FirstDayOfWeek == 0)	// ISO weeks, from monday to sunday
+	   {
+	    FirstDayOfWeek = Days - (WeekDay + 6) % 7;
+	    DayInWeek = FirstDayOfWeek + 3;	// The year of a week is the year of its thursday
+	   }
+	 else					// From sunday to saturday
+	   {
+	    FirstDayOfWeek = Days - WeekDay;
+	    DayInWeek = FirstDayOfWeek;		// The year of a week is the year of its sunday
+	   }
+	 LogArc_GetCivilFromDays (DayInWeek,&Year,&Month,&Day);
+	 return Year * 100 +
+		(unsigned) ((DayInWeek - LogArc_GetDaysFromCivil ((long) Year,1,1)) / 7) + 1;
+      case Sta_CLICKS_GBL_PER_MONTH:
+	 LogArc_GetCivilFromDays (Days,&Year,&Month,&Day);
+	 return Year * 100 + Month;
+      case Sta_CLICKS_GBL_PER_YEAR:
+	 LogArc_GetCivilFromDays (Days,&Year,&Month,&Day);
+	 return Year;
+      default:
+	 return 0;
+     }
+  }
@@ -0,0 +1,103 @@
+// swad_log_archive_database.c: columnar archive of log, operations with database
+
+/*
+    SWAD (Shared Workspace At a Distance),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2026 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/********************************** Headers **********************************/
+/*****************************************************************************/
+
+#include "swad_database.h"
+#include "swad_date.h"
+#include "swad_log_archive_database.h"
+
+/*****************************************************************************/
+/******************** Get year of the oldest click in log ********************/
+/*****************************************************************************/
+// Return 0 if log is empty
+
+unsigned LogArc_DB_GetFirstYearInLog (void)
+  {
+   return
+   DB_QuerySELECTUnsigned ("can not get oldest click",
+			   "SELECT YEAR(MIN(ClickTime))"
+			    " FROM log");
+  }
+
+/*****************************************************************************/
+/********* Get UTC times of the beginning of a year and the next one *********/
+/*****************************************************************************/
+// Dates in log are stored in the time zone of the database server
+
+Err_SuccessOrError_t LogArc_DB_GetYearLimits (unsigned Year,
+					      time_t *StartTime,time_t *EndTime)
+  {
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   Err_SuccessOrError_t SuccessOrError = Err_ERROR;
+
+   if (DB_QuerySELECTunique (&mysql_res,"can not get limits of a year",
+			     "SELECT UNIX_TIMESTAMP('%u-01-01'),"	// row[0]
+				    "UNIX_TIMESTAMP('%u-01-01')",	// row[1]
+			     Year,
+			     Year + 1) == Exi_EXISTS)
+     {
+      row = mysql_fetch_row (mysql_res);
+      if (row[0] && row[1])
+	{
+	 *StartTime = Dat_GetUNIXTimeFromStr (row[0]);
+	 *EndTime   = Dat_GetUNIXTimeFromStr (row[1]);
+	 if (*StartTime > 0 && *EndTime > *StartTime)
+	    SuccessOrError = Err_SUCCESS;
+	}
+     }
+
+   /***** Free structure that stores the query result *****/
+   DB_FreeMySQLResult (&mysql_res);
+
+   return SuccessOrError;
+  }
+
+/*****************************************************************************/
+/************* Get all clicks in a day of a year, sorted by time *************/
+/*****************************************************************************/
+
+unsigned LogArc_DB_GetClicksInDay (MYSQL_RES **mysql_res,
+				   unsigned Year,unsigned NumDay)
+  {
+   return (unsigned)
+   DB_QuerySELECT (mysql_res,"can not get clicks to archive",
+		   "SELECT UNIX_TIMESTAMP(ClickTime),"	// row[0]
+			  "ActCod,"			// row[1]
+			  "CtyCod,"			// row[2]
+			  "InsCod,"			// row[3]
+			  "CtrCod,"			// row[4]
+			  "DegCod,"			// row[5]
+			  "CrsCod,"			// row[6]
+			  "UsrCod,"			// row[7]
+			  "Role"			// row[8]
+		    " FROM log"
+		   " WHERE ClickTime>=DATE_ADD('%u-01-01',INTERVAL %u DAY)"
+		     " AND ClickTime<DATE_ADD('%u-01-01',INTERVAL %u DAY)"
+		" ORDER BY ClickTime",
+		   Year,NumDay,
+		   Year,NumDay + 1);
+  }
@@ -0,0 +1,45 @@
+// swad_log_archive_database.h: columnar archive of log, operations with database
+
+#ifndef _SWAD_LOG_ARC_DB
+#define _SWAD_LOG_ARC_DB
+/*
+    SWAD (Shared Workspace At a Distance),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2026 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/********************************** Headers **********************************/
+/*****************************************************************************/
+
+#include <mysql/mysql.h>	// To access MySQL databases
+#include <time.h>		// For time_t
+
+#include "swad_error.h"
+
+/*****************************************************************************/
+/***************************** Public prototypes *****************************/
+/*****************************************************************************/
+
+unsigned LogArc_DB_GetFirstYearInLog (void);
+Err_SuccessOrError_t LogArc_DB_GetYearLimits (unsigned Year,
+					      time_t *StartTime,time_t *EndTime);
+unsigned LogArc_DB_GetClicksInDay (MYSQL_RES **mysql_res,
+				   unsigned Year,unsigned NumDay);
+
+#endif
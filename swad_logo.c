@@ -41,6 +41,7 @@
 #include "swad_form.h"
 #include "swad_global.h"
 #include "swad_HTML.h"
+#include "swad_page_cache.h"
 #include "swad_scope.h"
 #include "swad_theme.h"
 
@@ -350,6 +351,9 @@ void Lgo_ReceiveLogo (Hie_Level_t HieLvl)
 		   (unsigned)  HieCod);
 	 if (Fil_EndReceptionOfFile (FileNameLogo,Par) == Err_ERROR)
 	    Ale_ShowAlert (Ale_ERROR,"Error copying file.");
+
+	 /* Logo is shown in cached pages */
+	 PagCac_RemoveCachedPages ();
          break;
       case Err_ERROR:
       default:
@@ -374,4 +378,7 @@ void Lgo_RemoveLogo (Hie_Level_t HieLvl)
 	     (unsigned)  HieCod,
 	     (unsigned)  HieCod);
    Fil_RemoveTree (FileNameLogo);
+
+   /***** Logo is shown in cached pages *****/
+   PagCac_RemoveCachedPages ();
   }
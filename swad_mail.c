@@ -48,6 +48,7 @@
 #include "swad_parameter.h"
 #include "swad_QR.h"
 #include "swad_tab.h"
+#include "swad_trace.h"
 
 /*****************************************************************************/
 /************** External global variables from others modules ****************/
@@ -1778,7 +1779,9 @@ int Mai_SendMailMsg (const char FileNameMail[PATH_MAX + 1],
              ToEmail,
              Cfg_PLATFORM_SHORT_NAME,Subject,
              FileNameMail);
+   Trc_BeginSpan ("system",Command);
    ReturnCode = system (Command);
+   Trc_EndSpan ();
    if (ReturnCode == -1)	// The value returned is -1 on error
       Err_ShowErrorAndExit ("Error when running script to send email.");
 
@@ -124,6 +124,24 @@ long Mai_DB_GetUsrCodFromEmail (const char Email[Cns_MAX_BYTES_EMAIL_ADDRESS + 1
 			      Email);
   }
 
+/*****************************************************************************/
+/************ Get users' codes of several users from their emails ************/
+/*****************************************************************************/
+// Emails is a list of emails between apostrophes separated by commas
+
+unsigned Mai_DB_GetUsrCodsFromEmails (MYSQL_RES **mysql_res,const char *Emails)
+  {
+   return (unsigned)
+   DB_QuerySELECT (mysql_res,"can not get users' codes",
+		   "SELECT usr_emails.E_mail,"	// row[0]
+			  "usr_emails.UsrCod"	// row[1]
+		    " FROM usr_emails,"
+			  "usr_data"
+		   " WHERE usr_emails.E_mail IN (%s)"
+		     " AND usr_emails.UsrCod=usr_data.UsrCod",
+		   Emails);
+  }
+
 /*****************************************************************************/
 /******************** Check if a user's email is confirmed *******************/
 /*****************************************************************************/
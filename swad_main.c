@@ -34,7 +34,6 @@
 #include "swad_action_list.h"
 #include "swad_announcement.h"
 #include "swad_config.h"
-#include "swad_connected_database.h"
 #include "swad_database.h"
 #include "swad_error.h"
 #include "swad_firewall.h"
@@ -44,10 +43,12 @@
 #include "swad_hierarchy_type.h"
 #include "swad_MFU.h"
 #include "swad_notification.h"
+#include "swad_page_cache.h"
 #include "swad_parameter.h"
 #include "swad_session.h"
 #include "swad_session_database.h"
 #include "swad_setting.h"
+#include "swad_trace.h"
 #include "swad_user.h"
 
 /*****************************************************************************/
@@ -97,33 +98,44 @@ int main (void)
    Gbl_InitializeGlobals ();
    Cfg_GetConfigFromFile ();
 
+   /***** Trace the whole request (span ended on exit) *****/
+   Trc_BeginSpan ("main","main");
+
    /***** Open database connection *****/
+   Trc_BeginSpan ("main","DB_OpenDBConnection");
    DB_OpenDBConnection ();
+   Trc_EndSpan ();
 
    /***** Read parameters *****/
+   Trc_BeginSpan ("main","Par_GetQueryString");
    if (Par_GetQueryString () == Err_SUCCESS)
      {
       /***** Get parameters *****/
       Par_CreateListOfPars ();
       Par_GetMainPars ();
+      Trc_EndSpan ();
 
       /***** Kick out banned IPs *****/
+      Trc_BeginSpan ("main","Fir_CheckFirewallAndExitIfBanned");
       Fir_CheckFirewallAndExitIfBanned ();
+      Trc_EndSpan ();
 
       /**** Initialize current country, institution, center, degree and course *****/
+      Trc_BeginSpan ("main","Hie_InitHierarchy");
       Hie_InitHierarchy ();
+      Trc_EndSpan ();
 
       if (!Gbl.WebService.IsWebService)
 	{
+	 /***** Send public page from cache if user is not logged *****/
+	 PagCac_ServeCachedPageIfExists ();
+
 	 /***** Create file for HTML output *****/
 	 Fil_CreateFileForHTMLOutput ();
 
 	 /***** Remove old (expired) sessions *****/
 	 Ses_DB_RemoveExpiredSessions ();
 
-	 /***** Remove old users from connected list *****/
-	 Con_DB_RemoveOldConnected ();
-
 	 /***** Get number of sessions *****/
 	 switch (Act_GetBrowserTab (Gbl.Action.Act))
 	   {
@@ -136,27 +148,37 @@ int main (void)
 	   }
 
 	 /***** Check user and get user's data *****/
+	 Trc_BeginSpan ("main","Usr_ChkUsrGetUsrDataAndAdjustAction");
 	 Usr_ChkUsrGetUsrDataAndAdjustAction ();
+	 Trc_EndSpan ();
 	}
 
       /***** Mitigate automatized attacks from the same IP-user *****/
       // If this execution is web service, no user is logged at this moment...
       // ...so only IP is checked and it could be banned...
       // ...if many users use the web service from the same IP
+      Trc_BeginSpan ("main","Fir_CheckFirewallAndExitIfTooManyRequests");
       Fir_DB_LogAccess ();
       Fir_CheckFirewallAndExitIfTooManyRequests ();
+      Trc_EndSpan ();
 
       /***** Check if the user have permission to execute the action *****/
       if (Act_CheckIfICanExecuteAction (Gbl.Action.Act) == Usr_CAN_NOT)
 	 Err_NoPermissionExit ();
 
       /***** Update most frequently used actions *****/
+      Trc_BeginSpan ("main","MFU_UpdateMFUActions");
       MFU_UpdateMFUActions ();
+      Trc_EndSpan ();
 
       /***** Execute a function depending on the action *****/
       FunctionPriori = Act_GetFunctionPriori (Gbl.Action.Act);
       if (FunctionPriori != NULL)
-	  FunctionPriori ();
+	{
+	 Trc_BeginSpan ("main","FunctionPriori");
+	 FunctionPriori ();
+	 Trc_EndSpan ();
+	}
 
       if (Act_GetBrowserTab (Gbl.Action.Act) == Act_204)
 	 /***** Write HTTP Status 204 No Content *****/
@@ -183,7 +205,11 @@ int main (void)
       /***** Make a processing or other depending on the action *****/
       FunctionPosteriori = Act_GetFunctionPosteriori (Gbl.Action.Act);
       if (FunctionPosteriori != NULL)
-	  FunctionPosteriori ();
+	{
+	 Trc_BeginSpan ("main","FunctionPosteriori");
+	 FunctionPosteriori ();
+	 Trc_EndSpan ();
+	}
 
       /* When updating a small zone via AJAX, all output is already done */
       switch (Act_GetBrowserTab (Gbl.Action.Act))
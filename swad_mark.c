@@ -46,6 +46,7 @@
 #include "swad_ID.h"
 #include "swad_mark.h"
 #include "swad_mark_database.h"
+#include "swad_mark_index.h"
 #include "swad_notification.h"
 #include "swad_parameter.h"
 #include "swad_string.h"
@@ -67,15 +68,12 @@ static const char *Mrk_HeadOrFootStr[Brw_NUM_HEAD_FOOT] =	// Names of fields in
    "Footer",
   };
 
-#define Mrk_MAX_BYTES_IN_CELL_CONTENT	1024	// Cell of a table containing one or several user's IDs
-
 /*****************************************************************************/
 /**************************** Private prototypes *****************************/
 /*****************************************************************************/
 
 static void Mrk_GetNumRowsHeaderAndFooter (struct Mrk_Properties *Marks);
 static void Mrk_ChangeNumRowsHeaderOrFooter (Brw_HeadOrFoot_t HeaderOrFooter);
-static bool Mrk_CheckIfCellContainsOnlyIDs (const char *CellContent);
 static Err_SuccessOrError_t Mrk_GetUsrMarks (FILE *FileUsrMarks,
 					     struct Usr_Data *UsrDat,
 					     const char *PathFileAllMarks,
@@ -226,13 +224,11 @@ Err_SuccessOrError_t Mrk_CheckFileOfMarks (const char *Path,struct Mrk_Propertie
   {
    extern const char *Txt_There_are_more_than_one_table_in_the_file_of_marks;
    extern const char *Txt_Table_not_found_in_the_file_of_marks;
-   char CellContent[Mrk_MAX_BYTES_IN_CELL_CONTENT + 1];
    FILE *FileAllMarks;
    __attribute__((unused)) Exi_Exist_t StrFound;
-   bool EndOfHead = false;
-   bool EndOfTable = false;
    Err_SuccessOrError_t SuccessOrError = Err_SUCCESS;
-   unsigned NumRowsStds = 0;
+   struct MrkIdx_Index Index;
+   unsigned NumRow;
 
    Marks->Header = Marks->Footer = 0;
 
@@ -257,68 +253,27 @@ Err_SuccessOrError_t Mrk_CheckFileOfMarks (const char *Path,struct Mrk_Propertie
 	       break;
 	    case Exi_DOES_NOT_EXIST:
 	    default:
-	       /* Return to table start */
-	       rewind (FileAllMarks);
-	       StrFound = Str_FindStrInFile (FileAllMarks,"<table",Str_NO_SKIP_HTML_COMMENTS);
-	       StrFound = Str_FindStrInFile (FileAllMarks,">",Str_NO_SKIP_HTML_COMMENTS);
-
-	       /* We assume that the structure of the table has several rows of header until the first row of students is found,
-		  then it has a number of rows of students, including some dummy rows without students,
-		  and finally it has several rows of footer from the last row of students until the end of the table */
-
-	       /***** Count rows of header *****/
-	       while (!EndOfHead)
-		  switch (Str_FindStrInFile (FileAllMarks,"<tr",
-					     Str_NO_SKIP_HTML_COMMENTS))	// Go to the next row
-		    {
-		     case Exi_EXISTS:
-			// All user's IDs must be in the first column of the row
-			Str_GetCellFromHTMLTableSkipComments (FileAllMarks,CellContent,Mrk_MAX_BYTES_IN_CELL_CONTENT);
-
-			/* Check if only user's IDs
-			   or other stuff found in this table cell */
-			if (Mrk_CheckIfCellContainsOnlyIDs (CellContent))
-			  {
-			   // Only user's IDs found in this cell
-			   EndOfHead = true;
-			   NumRowsStds++;
-			  }
-			else
-			   // Other stuff found ==> continue in header
-			   Marks->Header++;
-			break;
-		     case Exi_DOES_NOT_EXIST:
-		     default:
-			EndOfHead = true;	// No more rows
-			break;
-		    }
-
-	       /***** Count rows of students and rows of footer *****/
-	       while (!EndOfTable)
-		  switch (Str_FindStrInFile (FileAllMarks,"<tr",
-					     Str_NO_SKIP_HTML_COMMENTS))	// Go to the next row
-		    {
-		     case Exi_EXISTS:
-			// All user's IDs must be in the first column of the row
-			Str_GetCellFromHTMLTableSkipComments (FileAllMarks,CellContent,Mrk_MAX_BYTES_IN_CELL_CONTENT);
-
-			/* Check if only user's IDs
-			   or other stuff found in this table cell */
-			if (Mrk_CheckIfCellContainsOnlyIDs (CellContent))
-			  {
-			   // Only user's IDs found in this cell
-			   NumRowsStds++;
-			   Marks->Footer = 0;
-			  }
-			else
-			   // Other stuff found ==> continue in header
-			   Marks->Footer++;
-			break;
-		     case Exi_DOES_NOT_EXIST:
-		     default:
-			EndOfTable = true;	// No more rows
-			break;
-		    }
+	       /***** Scan rows of the table getting users' IDs *****/
+	       MrkIdx_ResetIndex (&Index);
+	       StrFound = MrkIdx_ScanTable (FileAllMarks,&Index);
+
+	       /***** Count rows of header until the first row of students *****/
+	       for (NumRow = 0;
+		    NumRow < Index.NumRows && !Index.Rows[NumRow].OnlyIDs;
+		    NumRow++)
+		  Marks->Header++;
+
+	       /***** Count rows of footer from the last row of students *****/
+	       if (Marks->Header < Index.NumRows)	// There are rows of students
+		  for (NumRow = Index.NumRows;
+		       !Index.Rows[NumRow - 1].OnlyIDs;
+		       NumRow--)
+		     Marks->Footer++;
+
+	       /***** Store index to show marks of each student
+		      without scanning the file again *****/
+	       MrkIdx_StoreIndex (Path,&Index);
+	       MrkIdx_FreeIndex (&Index);
 	       break;
 	   }
         }
@@ -336,45 +291,6 @@ Err_SuccessOrError_t Mrk_CheckFileOfMarks (const char *Path,struct Mrk_Propertie
    return SuccessOrError;
   }
 
-/*****************************************************************************/
-/******* Check if only user's IDs or other stuff found in a table cell *******/
-/*****************************************************************************/
-
-static bool Mrk_CheckIfCellContainsOnlyIDs (const char *CellContent)
-  {
-   char UsrIDFromTable[ID__MAX_BYTES_USR_ID + 1];
-   const char *Ptr = CellContent;
-   Exi_Exist_t UsrIDFound = Exi_DOES_NOT_EXIST;
-   bool StuffNotUsrIDFound = false;
-
-   /***** Get strings in this table cell
-          and check if they look like user's IDs or not *****/
-   while (*Ptr && !StuffNotUsrIDFound)
-     {
-      /* Find next string in text until space, comma or semicolon (leading and trailing spaces are removed) */
-      Str_GetNextStringUntilSeparator (&Ptr,UsrIDFromTable,ID__MAX_BYTES_USR_ID);
-
-      // Users' IDs are always stored internally in capitals and without leading zeros
-      Str_RemoveLeadingZeros (UsrIDFromTable);
-      Str_ConvertToUpperText (UsrIDFromTable);
-      if (UsrIDFromTable[0])	// Something found
-	 switch (ID__CheckIfUsrIDIsValid (UsrIDFromTable))
-	   {
-	    case Err_SUCCESS:
-	       UsrIDFound = Exi_EXISTS;
-	       break;
-	    case Err_ERROR:
-	    default:
-	       StuffNotUsrIDFound = true;
-	       break;
-	   }
-     }
-
-   /***** Check if only user's IDs
-          or other stuff found in this table cell *****/
-   return (UsrIDFound == Exi_EXISTS && !StuffNotUsrIDFound);
-  }
-
 /*****************************************************************************/
 /*************************** Show the marks of a user ************************/
 /*****************************************************************************/
@@ -385,171 +301,45 @@ static Err_SuccessOrError_t Mrk_GetUsrMarks (FILE *FileUsrMarks,
 					     struct Mrk_Properties *Marks)
   {
    extern const char *Txt_THE_USER_X_is_not_found_in_the_file_of_marks;
-   unsigned Row;
-   char CellContent[Mrk_MAX_BYTES_IN_CELL_CONTENT + 1];
-   const char *Ptr;
-   char UsrIDFromTable[ID__MAX_BYTES_USR_ID + 1];
-   FILE *FileAllMarks;
-   unsigned NumID;
-   Exi_Exist_t UsrIDFound;
-   __attribute__((unused)) Exi_Exist_t StrFound;
-   bool EndOfTable;
-
-   /***** Open HTML file with the table of marks *****/
-   if (!(FileAllMarks = fopen (PathFileAllMarks,"rb")))
+   struct MrkIdx_Index Index;
+   unsigned NumRow;
+   Err_SuccessOrError_t SuccessOrError;
+
+   /***** Get index of the table of marks,
+          building it if the file has changed *****/
+   MrkIdx_ResetIndex (&Index);
+   if (MrkIdx_GetIndex (PathFileAllMarks,&Index) == Err_ERROR)
      {  // Can't open the file with the table of marks
       Ale_CreateAlert (Ale_ERROR,NULL,
 		       "Can not open file of marks.");
       return Err_ERROR;
      }
 
-   /***** Check if it exists a user's ID in the first column of the table of marks *****/
-   /* Jump to table start */
-   StrFound = Str_FindStrInFile (FileAllMarks,"<table",Str_NO_SKIP_HTML_COMMENTS);
-   StrFound = Str_FindStrInFile (FileAllMarks,">",Str_NO_SKIP_HTML_COMMENTS);
-
-   /* Skip header */
-   for (Row = 1;
-	Row <= Marks->Header;
-	Row++)
-      StrFound = Str_FindStrInFile (FileAllMarks,"<tr",Str_NO_SKIP_HTML_COMMENTS);   // Go to the next row
-
-   /* Get user's IDs from table row by row until footer */
-   UsrIDFound = Exi_DOES_NOT_EXIST;
-   EndOfTable = false;
-   while (UsrIDFound == Exi_DOES_NOT_EXIST && !EndOfTable)
-      switch (Str_FindStrInFile (FileAllMarks,"<tr",
-				 Str_NO_SKIP_HTML_COMMENTS))	// Go to the next row
-	{
-	 case Exi_EXISTS:
-	    // All user's IDs must be in the first column of the row
-	    Str_GetCellFromHTMLTableSkipComments (FileAllMarks,CellContent,Mrk_MAX_BYTES_IN_CELL_CONTENT);
-
-	    /* Get user's IDs */
-	    Ptr = CellContent;
-	    while (*Ptr && UsrIDFound == Exi_DOES_NOT_EXIST)
-	      {
-	       /* Find next string in text until separator (leading and trailing spaces are removed) */
-	       Str_GetNextStringUntilSeparator (&Ptr,UsrIDFromTable,ID__MAX_BYTES_USR_ID);
-
-	       // Users' IDs are always stored internally in capitals and without leading zeros
-	       Str_RemoveLeadingZeros (UsrIDFromTable);
-	       Str_ConvertToUpperText (UsrIDFromTable);
-
-	       if (ID__CheckIfUsrIDIsValid (UsrIDFromTable) == Err_SUCCESS)
-		  // A valid user's ID is found in the first column of table, and stored in UsrIDFromTable.
-		  // Compare UsrIDFromTable with all confirmed user's IDs in list
-		  for (NumID = 0;
-		       NumID < UsrDat->IDs.Num && UsrIDFound == Exi_DOES_NOT_EXIST;
-		       NumID++)
-		     if (UsrDat->IDs.List[NumID].Confirmed == ID__CONFIRMED)
-			if (!strcasecmp (UsrDat->IDs.List[NumID].ID,UsrIDFromTable))
-			   UsrIDFound = Exi_EXISTS;
-	      }
-	    break;
-	 case Exi_DOES_NOT_EXIST:
-	 default:
-	    EndOfTable = true;	// No more rows
-	    break;
-	}
-
-   if (UsrIDFound == Exi_EXISTS)
+   /***** Check if it exists a user's ID
+          in the first column of a row after the header *****/
+   switch (MrkIdx_GetRowOfUsr (&Index,UsrDat,Marks->Header,&NumRow))
      {
-      /***** Write all until the header (included) *****/
-      /* Go to start of file */
-      rewind (FileAllMarks);
-
-      /* Write until table start */
-      Str_WriteUntilStrFoundInFileIncludingStr (FileUsrMarks,FileAllMarks,"<table",Str_NO_SKIP_HTML_COMMENTS);
-      Str_WriteUntilStrFoundInFileIncludingStr (FileUsrMarks,FileAllMarks,">",Str_NO_SKIP_HTML_COMMENTS);
-
-      /* Write header */
-      for (Row = 1;
-	   Row <= Marks->Header;
-	   Row++)
-	 Str_WriteUntilStrFoundInFileIncludingStr (FileUsrMarks,FileAllMarks,"</tr>",Str_NO_SKIP_HTML_COMMENTS);
-
-      /****** Write the row corresponding to the student *****/
-      /* Find user's ID */
-      UsrIDFound = Exi_DOES_NOT_EXIST;
-      EndOfTable = false;
-      while (UsrIDFound == Exi_DOES_NOT_EXIST && !EndOfTable)
-	 switch (Str_FindStrInFile (FileAllMarks,"<tr",
-				    Str_NO_SKIP_HTML_COMMENTS))	// Go to the next row
-	   {
-	    case Exi_EXISTS:
-	       // All user's IDs must be in the first column of the row
-	       Str_GetCellFromHTMLTableSkipComments (FileAllMarks,CellContent,Mrk_MAX_BYTES_IN_CELL_CONTENT);
-
-	       /* Get user's IDs */
-	       Ptr = CellContent;
-	       while (*Ptr && UsrIDFound == Exi_DOES_NOT_EXIST)
-		 {
-		  /* Find next string in text until comma or semicolon (leading and trailing spaces are removed) */
-		  Str_GetNextStringUntilSeparator (&Ptr,UsrIDFromTable,ID__MAX_BYTES_USR_ID);
-
-		  // Users' IDs are always stored internally in capitals and without leading zeros
-		  Str_RemoveLeadingZeros (UsrIDFromTable);
-		  Str_ConvertToUpperText (UsrIDFromTable);
-		  if (ID__CheckIfUsrIDIsValid (UsrIDFromTable) == Err_SUCCESS)
-		     // A valid user's ID is found in the first column of table, and stored in UsrIDFromTable.
-		     // Compare UsrIDFromTable with all confirmed user's IDs in list
-		     for (NumID = 0;
-			  NumID < UsrDat->IDs.Num && UsrIDFound == Exi_DOES_NOT_EXIST;
-			  NumID++)
-			if (UsrDat->IDs.List[NumID].Confirmed == ID__CONFIRMED)
-			   if (!strcasecmp (UsrDat->IDs.List[NumID].ID,UsrIDFromTable))
-			      UsrIDFound = Exi_EXISTS;
-		 }
-	       break;
-	    case Exi_DOES_NOT_EXIST:
-	    default:
-	       EndOfTable = true;	// No more rows
-	       break;
-	   }
-
-      if (UsrIDFound == Exi_EXISTS)	// This should happen always, because the check was already made
-	{
-	 /* Find backward until "<tr" */
-	 StrFound = Str_FindStrInFileBack (FileAllMarks,"<tr",Str_NO_SKIP_HTML_COMMENTS);
-
-	 /* Write until "</tr>" */
-	 Str_WriteUntilStrFoundInFileIncludingStr (FileUsrMarks,FileAllMarks,"</tr>",Str_NO_SKIP_HTML_COMMENTS);
-
-	 /***** Write the footer and all until the end *****/
-	 /* Find the footer of the table */
-	 StrFound = Str_FindStrInFile (FileAllMarks,"</table>",Str_NO_SKIP_HTML_COMMENTS);
-	 StrFound = Str_FindStrInFileBack (FileAllMarks,"</table>",Str_NO_SKIP_HTML_COMMENTS);
-
-	 for (Row = 1;
-	      Row <= Marks->Footer;
-	      Row++)
-	    StrFound = Str_FindStrInFileBack (FileAllMarks,"<tr",Str_NO_SKIP_HTML_COMMENTS);
-
-	 /* Write the footer of the table */
-	 for (Row = 1;
-	      Row <= Marks->Footer;
-	      Row++)
-	    Str_WriteUntilStrFoundInFileIncludingStr (FileUsrMarks,FileAllMarks,"</tr>",Str_NO_SKIP_HTML_COMMENTS);
-
-	 /* Write the end */
-	 StrFound = Str_FindStrInFile (FileAllMarks,"</table>",Str_NO_SKIP_HTML_COMMENTS);
-	 StrFound = Str_FindStrInFileBack (FileAllMarks,"</table>",Str_NO_SKIP_HTML_COMMENTS);
-	 Fil_FastCopyOfOpenFiles (FileAllMarks,FileUsrMarks);
-
-	 /***** The file of marks is no longer needed. Close it. *****/
-	 fclose (FileAllMarks);
-
-	 return Err_SUCCESS;
-	}
+      case Exi_EXISTS:
+	 /***** Write header, row of the user, footer and all until the end *****/
+	 if ((SuccessOrError = MrkIdx_WriteUsrMarks (FileUsrMarks,PathFileAllMarks,
+						     &Index,NumRow,Marks)) == Err_ERROR)
+	    Ale_CreateAlert (Ale_ERROR,NULL,
+			     "Can not read file of marks.");
+	 break;
+      case Exi_DOES_NOT_EXIST:
+      default:
+	 /***** User's ID not found in table *****/
+	 Ale_CreateAlert (Ale_WARNING,NULL,
+			  Txt_THE_USER_X_is_not_found_in_the_file_of_marks,
+			  UsrDat->FullName);
+	 SuccessOrError = Err_ERROR;
+	 break;
      }
 
-   /***** User's ID not found in table *****/
-   fclose (FileAllMarks);
-   Ale_CreateAlert (Ale_WARNING,NULL,
-		    Txt_THE_USER_X_is_not_found_in_the_file_of_marks,
-		    UsrDat->FullName);
-   return Err_ERROR;
+   /***** Free index *****/
+   MrkIdx_FreeIndex (&Index);
+
+   return SuccessOrError;
   }
 
 /*****************************************************************************/
@@ -759,7 +549,7 @@ void Mrk_GetNotifMyMarks (char SummaryStr[Ntf_MAX_BYTES_SUMMARY + 1],
 	    if ((FileUsrMarks = fopen (FileNameUsrMarks,"wb")))
 	      {
 	       /***** Get user's marks *****/
-	       if (Mrk_GetUsrMarks (FileUsrMarks,&UsrDat,PathMarks,&Marks))
+	       if (Mrk_GetUsrMarks (FileUsrMarks,&UsrDat,PathMarks,&Marks) == Err_SUCCESS)
 		 {
 		  SizeOfMyMarks = (size_t) ftell (FileUsrMarks);
 		  fclose (FileUsrMarks);
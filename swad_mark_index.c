@@ -0,0 +1,593 @@
+// swad_mark_index.c: index of users' IDs in files of marks
+/*
+    SWAD (Shared Workspace At a Distance),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2026 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/********************************** Headers **********************************/
+/*****************************************************************************/
+
+#define _GNU_SOURCE 		// For asprintf
+#include <fcntl.h>		// For open
+#include <linux/limits.h>	// For PATH_MAX
+#include <stdio.h>		// For asprintf, fopen, fread, fwrite, rename
+#include <stdlib.h>		// For free, malloc, qsort, realloc
+#include <string.h>		// For memset, strcmp
+#include <sys/stat.h>		// For fstat, stat
+#include <time.h>		// For struct timespec
+#include <unistd.h>		// For close, getpid, pread, unlink
+#include <utime.h>		// For utime
+
+#include "swad_config.h"
+#include "swad_error.h"
+#include "swad_file.h"
+#include "swad_mark_index.h"
+#include "swad_string.h"
+
+/*****************************************************************************/
+/***************************** Private constants *****************************/
+/*****************************************************************************/
+
+#define MrkIdx_MAGIC	0x584B524DU	// "MRKX"
+#define MrkIdx_FORMAT	1		// Increment when file layout changes
+
+#define MrkIdx_MAX_BYTES_IN_CELL_CONTENT	1024	// Cell of a table containing one or several user's IDs
+
+#define MrkIdx_NUM_BYTES_PER_CHUNK	4096
+
+/*****************************************************************************/
+/******************************* Private types *******************************/
+/*****************************************************************************/
+
+/*
+   Layout of index file (native byte order, only read by this program):
+   header
+   array of rows
+   sorted array of users' IDs
+   The file is named after device and inode of the file of marks,
+   so it remains valid when a received file is renamed into place.
+*/
+struct MrkIdx_Header
+  {
+   unsigned Magic;
+   unsigned Format;
+   ino_t Ino;				// Inode, size and modification time of the file of marks,
+   off_t Size;				// used to check if the index is outdated
+   struct timespec MTime;
+   off_t TableBegin;
+   off_t TableEnd;
+   unsigned NumRows;
+   unsigned NumIDs;
+  };
+
+/*****************************************************************************/
+/**************************** Private prototypes *****************************/
+/*****************************************************************************/
+
+static void MrkIdx_AddRow (struct MrkIdx_Index *Index,off_t Begin);
+static bool MrkIdx_AddIDsInCell (struct MrkIdx_Index *Index,
+				 unsigned NumRow,const char *CellContent);
+static void MrkIdx_BuildPathIndex (const struct stat *FileStatus,
+				   char PathIndex[PATH_MAX + 1]);
+static Err_SuccessOrError_t MrkIdx_ReadIndex (const char *PathIndex,
+					      const struct stat *FileStatus,
+					      struct MrkIdx_Index *Index);
+static Err_SuccessOrError_t MrkIdx_WriteFile (const char *PathTmp,
+					      const struct stat *FileStatus,
+					      const struct MrkIdx_Index *Index);
+static Err_SuccessOrError_t MrkIdx_CopyRange (int FileDescriptor,FILE *FileTgt,
+					      off_t Begin,off_t End);
+static int MrkIdx_CompareIDs (const void *Item1,const void *Item2);
+
+/*****************************************************************************/
+/******************************** Reset index ********************************/
+/*****************************************************************************/
+
+void MrkIdx_ResetIndex (struct MrkIdx_Index *Index)
+  {
+   Index->Size       =
+   Index->TableBegin =
+   Index->TableEnd   = (off_t) 0;
+   Index->NumRows    = 0;
+   Index->Rows       = NULL;
+   Index->NumIDs     = 0;
+   Index->IDs        = NULL;
+  }
+
+/*****************************************************************************/
+/******************************** Free index *********************************/
+/*****************************************************************************/
+
+void MrkIdx_FreeIndex (struct MrkIdx_Index *Index)
+  {
+   free (Index->Rows);
+   free (Index->IDs);
+   MrkIdx_ResetIndex (Index);
+  }
+
+/*****************************************************************************/
+/*********** Scan the table in a file of marks building the index ************/
+/*****************************************************************************/
+
+/* We assume that the structure of the table has several rows of header until the first row of students is found,
+   then it has a number of rows of students, including some dummy rows without students,
+   and finally it has several rows of footer from the last row of students until the end of the table.
+   The index stores the position of every row and the users' IDs found in the first cell of every row,
+   so the number of rows of header and footer can be changed later without rebuilding it. */
+// Return Exi_DOES_NOT_EXIST if there is no table in the file
+
+Exi_Exist_t MrkIdx_ScanTable (FILE *FileAllMarks,struct MrkIdx_Index *Index)
+  {
+   char CellContent[MrkIdx_MAX_BYTES_IN_CELL_CONTENT + 1];
+   struct stat FileStatus;
+   __attribute__((unused)) Exi_Exist_t StrFound;
+   bool EndOfTable = false;
+   unsigned NumRow;
+
+   /***** Get size of file *****/
+   if (fstat (fileno (FileAllMarks),&FileStatus))
+      return Exi_DOES_NOT_EXIST;
+   Index->Size = FileStatus.st_size;
+
+   /***** Jump to table start *****/
+   rewind (FileAllMarks);
+   if (Str_FindStrInFile (FileAllMarks,"<table",
+			  Str_NO_SKIP_HTML_COMMENTS) == Exi_DOES_NOT_EXIST)
+      return Exi_DOES_NOT_EXIST;
+   StrFound = Str_FindStrInFile (FileAllMarks,">",Str_NO_SKIP_HTML_COMMENTS);
+   Index->TableBegin = (off_t) ftell (FileAllMarks);
+
+   /***** Get rows one by one *****/
+   while (!EndOfTable)
+      switch (Str_FindStrInFile (FileAllMarks,"<tr",
+				 Str_NO_SKIP_HTML_COMMENTS))	// Go to the next row
+	{
+	 case Exi_EXISTS:
+	    NumRow = Index->NumRows;
+	    MrkIdx_AddRow (Index,(off_t) ftell (FileAllMarks) - 3);
+
+	    // All user's IDs must be in the first column of the row
+	    Str_GetCellFromHTMLTableSkipComments (FileAllMarks,CellContent,MrkIdx_MAX_BYTES_IN_CELL_CONTENT);
+	    Index->Rows[NumRow].OnlyIDs = MrkIdx_AddIDsInCell (Index,NumRow,CellContent);
+
+	    /* Go to the end of the row */
+	    if (Str_FindStrInFile (FileAllMarks,"</tr>",
+				   Str_NO_SKIP_HTML_COMMENTS) == Exi_EXISTS)
+	       Index->Rows[NumRow].End = (off_t) ftell (FileAllMarks);
+	    else
+	      {
+	       Index->Rows[NumRow].End = Index->Size;
+	       EndOfTable = true;
+	      }
+	    break;
+	 case Exi_DOES_NOT_EXIST:
+	 default:
+	    EndOfTable = true;	// No more rows
+	    break;
+	}
+
+   /***** Get table end *****/
+   if (Index->NumRows)
+      fseek (FileAllMarks,(long) Index->Rows[Index->NumRows - 1].End,SEEK_SET);
+   else
+      fseek (FileAllMarks,(long) Index->TableBegin,SEEK_SET);
+   if (Str_FindStrInFile (FileAllMarks,"</table>",
+			  Str_NO_SKIP_HTML_COMMENTS) == Exi_EXISTS)
+      Index->TableEnd = (off_t) ftell (FileAllMarks) - 8;
+   else
+      Index->TableEnd = Index->Size;
+
+   /***** Sort users' IDs to allow binary search *****/
+   if (Index->NumIDs)
+      qsort (Index->IDs,Index->NumIDs,sizeof (Index->IDs[0]),
+	     MrkIdx_CompareIDs);
+
+   return Exi_EXISTS;
+  }
+
+/*****************************************************************************/
+/************************** Add a new row to index ***************************/
+/*****************************************************************************/
+
+static void MrkIdx_AddRow (struct MrkIdx_Index *Index,off_t Begin)
+  {
+   /***** Allocate space for rows in blocks *****/
+   if ((Index->NumRows % 64) == 0)
+      if ((Index->Rows = realloc (Index->Rows,
+				  (Index->NumRows + 64) * sizeof (Index->Rows[0]))) == NULL)
+	 Err_NotEnoughMemoryExit ();
+
+   /***** Add row *****/
+   Index->Rows[Index->NumRows].Begin   = Begin;
+   Index->Rows[Index->NumRows].End     = Begin;
+   Index->Rows[Index->NumRows].OnlyIDs = false;
+   Index->NumRows++;
+  }
+
+/*****************************************************************************/
+/****************** Add users' IDs in a table cell to index ******************/
+/*****************************************************************************/
+
+// Return true if only user's IDs found in this table cell
+
+static bool MrkIdx_AddIDsInCell (struct MrkIdx_Index *Index,
+				 unsigned NumRow,const char *CellContent)
+  {
+   char UsrIDFromTable[ID__MAX_BYTES_USR_ID + 1];
+   const char *Ptr = CellContent;
+   Exi_Exist_t UsrIDFound = Exi_DOES_NOT_EXIST;
+   bool StuffNotUsrIDFound = false;
+
+   /***** Get strings in this table cell
+          and check if they look like user's IDs or not *****/
+   while (*Ptr)
+     {
+      /* Find next string in text until space, comma or semicolon (leading and trailing spaces are removed) */
+      Str_GetNextStringUntilSeparator (&Ptr,UsrIDFromTable,ID__MAX_BYTES_USR_ID);
+
+      // Users' IDs are always stored internally in capitals and without leading zeros
+      Str_RemoveLeadingZeros (UsrIDFromTable);
+      Str_ConvertToUpperText (UsrIDFromTable);
+      if (UsrIDFromTable[0])	// Something found
+	 switch (ID__CheckIfUsrIDIsValid (UsrIDFromTable))
+	   {
+	    case Err_SUCCESS:
+	       UsrIDFound = Exi_EXISTS;
+
+	       /* Allocate space for users' IDs in blocks */
+	       if ((Index->NumIDs % 64) == 0)
+		  if ((Index->IDs = realloc (Index->IDs,
+					     (Index->NumIDs + 64) * sizeof (Index->IDs[0]))) == NULL)
+		     Err_NotEnoughMemoryExit ();
+
+	       /* Add user's ID */
+	       Str_Copy (Index->IDs[Index->NumIDs].ID,UsrIDFromTable,
+			 sizeof (Index->IDs[Index->NumIDs].ID) - 1);
+	       Index->IDs[Index->NumIDs].NumRow = NumRow;
+	       Index->NumIDs++;
+	       break;
+	    case Err_ERROR:
+	    default:
+	       StuffNotUsrIDFound = true;
+	       break;
+	   }
+     }
+
+   /***** Check if only user's IDs
+          or other stuff found in this table cell *****/
+   return (UsrIDFound == Exi_EXISTS && !StuffNotUsrIDFound);
+  }
+
+/*****************************************************************************/
+/********************** Store index of a file of marks ***********************/
+/*****************************************************************************/
+
+// The index is stored only if the file of marks has not changed since it was scanned
+
+void MrkIdx_StoreIndex (const char *PathFileAllMarks,
+			const struct MrkIdx_Index *Index)
+  {
+   struct stat FileStatus;
+   char PathIndex[PATH_MAX + 1];
+   char *PathTmp;
+
+   /***** Get status of the file of marks *****/
+   if (stat (PathFileAllMarks,&FileStatus))
+      return;
+   if (FileStatus.st_size != Index->Size)
+      return;
+
+   /***** Write index into a temporary file
+          and replace old index atomically *****/
+   MrkIdx_BuildPathIndex (&FileStatus,PathIndex);
+   if (asprintf (&PathTmp,"%s.%d",PathIndex,(int) getpid ()) < 0)
+      Err_NotEnoughMemoryExit ();
+
+   if (MrkIdx_WriteFile (PathTmp,&FileStatus,Index) == Err_ERROR ||
+       rename (PathTmp,PathIndex))
+      unlink (PathTmp);
+
+   free (PathTmp);
+  }
+
+/*****************************************************************************/
+/********** Get index of a file of marks, building it if not valid ***********/
+/*****************************************************************************/
+
+// Return Err_ERROR if the file of marks can not be read or it has no table
+
+Err_SuccessOrError_t MrkIdx_GetIndex (const char *PathFileAllMarks,
+				      struct MrkIdx_Index *Index)
+  {
+   struct stat FileStatus;
+   char PathIndex[PATH_MAX + 1];
+   FILE *FileAllMarks;
+   Exi_Exist_t TableExists;
+
+   /***** Get status of the file of marks *****/
+   if (stat (PathFileAllMarks,&FileStatus))
+      return Err_ERROR;
+
+   /***** Try to read a valid index *****/
+   MrkIdx_BuildPathIndex (&FileStatus,PathIndex);
+   if (MrkIdx_ReadIndex (PathIndex,&FileStatus,Index) == Err_SUCCESS)
+     {
+      utime (PathIndex,NULL);	// Update index modification time to avoid its removal
+      return Err_SUCCESS;
+     }
+
+   /***** Index does not exist or it is outdated ==> build it *****/
+   if (!(FileAllMarks = fopen (PathFileAllMarks,"rb")))
+      return Err_ERROR;
+   TableExists = MrkIdx_ScanTable (FileAllMarks,Index);
+   fclose (FileAllMarks);
+
+   switch (TableExists)
+     {
+      case Exi_EXISTS:
+	 MrkIdx_StoreIndex (PathFileAllMarks,Index);
+	 return Err_SUCCESS;
+      case Exi_DOES_NOT_EXIST:
+      default:
+	 MrkIdx_FreeIndex (Index);
+	 return Err_ERROR;
+     }
+  }
+
+/*****************************************************************************/
+/********* Build path to index file from status of the file of marks *********/
+/*****************************************************************************/
+
+static void MrkIdx_BuildPathIndex (const struct stat *FileStatus,
+				   char PathIndex[PATH_MAX + 1])
+  {
+   Fil_CreateDirIfNotExists (Cfg_PATH_MARK_INDEX_PRIVATE);
+   snprintf (PathIndex,PATH_MAX + 1,"%s/%lx_%lx.idx",
+	     Cfg_PATH_MARK_INDEX_PRIVATE,
+	     (unsigned long) FileStatus->st_dev,
+	     (unsigned long) FileStatus->st_ino);
+  }
+
+/*****************************************************************************/
+/************ Read index file if it exists and it is not outdated ************/
+/*****************************************************************************/
+
+static Err_SuccessOrError_t MrkIdx_ReadIndex (const char *PathIndex,
+					      const struct stat *FileStatus,
+					      struct MrkIdx_Index *Index)
+  {
+   FILE *FileIndex;
+   struct MrkIdx_Header Header;
+   Err_SuccessOrError_t SuccessOrError = Err_ERROR;
+
+   if (!(FileIndex = fopen (PathIndex,"rb")))
+      return Err_ERROR;
+
+   /***** Read header and check that file of marks has not changed *****/
+   if (fread (&Header,sizeof (Header),1,FileIndex) == 1)
+      if (Header.Magic  == MrkIdx_MAGIC  &&
+	  Header.Format == MrkIdx_FORMAT &&
+	  Header.Ino    == FileStatus->st_ino  &&
+	  Header.Size   == FileStatus->st_size &&
+	  Header.MTime.tv_sec  == FileStatus->st_mtim.tv_sec &&
+	  Header.MTime.tv_nsec == FileStatus->st_mtim.tv_nsec)
+	{
+	 Index->Size       = Header.Size;
+	 Index->TableBegin = Header.TableBegin;
+	 Index->TableEnd   = Header.TableEnd;
+	 Index->NumRows    = Header.NumRows;
+	 Index->NumIDs     = Header.NumIDs;
+
+	 /***** Read rows and users' IDs *****/
+	 if ((Index->Rows = malloc (Index->NumRows * sizeof (Index->Rows[0]) + 1)) == NULL ||
+	     (Index->IDs  = malloc (Index->NumIDs  * sizeof (Index->IDs[0] ) + 1)) == NULL)
+	    Err_NotEnoughMemoryExit ();
+	 if (fread (Index->Rows,sizeof (Index->Rows[0]),Index->NumRows,FileIndex) == Index->NumRows &&
+	     fread (Index->IDs ,sizeof (Index->IDs[0] ),Index->NumIDs ,FileIndex) == Index->NumIDs)
+	    SuccessOrError = Err_SUCCESS;
+	 else
+	    MrkIdx_FreeIndex (Index);
+	}
+
+   fclose (FileIndex);
+
+   return SuccessOrError;
+  }
+
+/*****************************************************************************/
+/*************************** Write index into file ***************************/
+/*****************************************************************************/
+
+static Err_SuccessOrError_t MrkIdx_WriteFile (const char *PathTmp,
+					      const struct stat *FileStatus,
+					      const struct MrkIdx_Index *Index)
+  {
+   FILE *FileTmp;
+   struct MrkIdx_Header Header;
+   Err_SuccessOrError_t SuccessOrError = Err_ERROR;
+
+   /***** Fill header *****/
+   memset (&Header,0,sizeof (Header));	// Padding is written too
+   Header.Magic      = MrkIdx_MAGIC;
+   Header.Format     = MrkIdx_FORMAT;
+   Header.Ino        = FileStatus->st_ino;
+   Header.Size       = FileStatus->st_size;
+   Header.MTime      = FileStatus->st_mtim;
+   Header.TableBegin = Index->TableBegin;
+   Header.TableEnd   = Index->TableEnd;
+   Header.NumRows    = Index->NumRows;
+   Header.NumIDs     = Index->NumIDs;
+
+   /***** Write header, rows and users' IDs *****/
+   if ((FileTmp = fopen (PathTmp,"wb")))
+     {
+      if (fwrite (&Header,sizeof (Header),1,FileTmp) == 1 &&
+	  fwrite (Index->Rows,sizeof (Index->Rows[0]),Index->NumRows,FileTmp) == Index->NumRows &&
+	  fwrite (Index->IDs ,sizeof (Index->IDs[0] ),Index->NumIDs ,FileTmp) == Index->NumIDs)
+	 SuccessOrError = Err_SUCCESS;
+      if (fclose (FileTmp))
+	 SuccessOrError = Err_ERROR;
+     }
+
+   return SuccessOrError;
+  }
+
+/*****************************************************************************/
+/******** Get the first row, after header, containing an ID of a user ********/
+/*****************************************************************************/
+
+// Only confirmed user's IDs are taken into account
+
+Exi_Exist_t MrkIdx_GetRowOfUsr (const struct MrkIdx_Index *Index,
+				const struct Usr_Data *UsrDat,
+				unsigned FirstRow,unsigned *NumRow)
+  {
+   struct MrkIdx_UsrID Key;
+   unsigned NumID;
+   unsigned Low;
+   unsigned High;
+   unsigned Mid;
+   Exi_Exist_t UsrIDFound = Exi_DOES_NOT_EXIST;
+
+   for (NumID = 0;
+	NumID < UsrDat->IDs.Num;
+	NumID++)
+      if (UsrDat->IDs.List[NumID].Confirmed == ID__CONFIRMED)
+	{
+	 Str_Copy (Key.ID,UsrDat->IDs.List[NumID].ID,sizeof (Key.ID) - 1);
+	 Str_ConvertToUpperText (Key.ID);
+	 Key.NumRow = FirstRow;
+
+	 /***** Binary search of the first entry not less than (ID,FirstRow) *****/
+	 for (Low = 0, High = Index->NumIDs;
+	      Low < High;
+	      )
+	   {
+	    Mid = Low + (High - Low) / 2;
+	    if (MrkIdx_CompareIDs (&Index->IDs[Mid],&Key) < 0)
+	       Low = Mid + 1;
+	    else
+	       High = Mid;
+	   }
+
+	 /***** If it has the same ID, it is in the first row after header *****/
+	 if (Low < Index->NumIDs)
+	    if (!strcmp (Index->IDs[Low].ID,Key.ID))
+	       if (UsrIDFound == Exi_DOES_NOT_EXIST || Index->IDs[Low].NumRow < *NumRow)
+		 {
+		  *NumRow = Index->IDs[Low].NumRow;
+		  UsrIDFound = Exi_EXISTS;
+		 }
+	}
+
+   return UsrIDFound;
+  }
+
+/*****************************************************************************/
+/******* Write the marks of a user: header, user's row, footer and end *******/
+/*****************************************************************************/
+
+Err_SuccessOrError_t MrkIdx_WriteUsrMarks (FILE *FileUsrMarks,
+					   const char *PathFileAllMarks,
+					   const struct MrkIdx_Index *Index,
+					   unsigned NumRow,
+					   const struct Mrk_Properties *Marks)
+  {
+   int FileDescriptor;
+   unsigned Header = Marks->Header < Index->NumRows ? Marks->Header :
+						      Index->NumRows;
+   unsigned Footer = Marks->Footer < Index->NumRows ? Marks->Footer :
+						      Index->NumRows;
+   Err_SuccessOrError_t SuccessOrError = Err_SUCCESS;
+
+   if (NumRow >= Index->NumRows)
+      return Err_ERROR;
+
+   if ((FileDescriptor = open (PathFileAllMarks,O_RDONLY)) < 0)
+      return Err_ERROR;
+
+   /***** Write all until the header (included) *****/
+   if (MrkIdx_CopyRange (FileDescriptor,FileUsrMarks,(off_t) 0,
+			 Header ? Index->Rows[Header - 1].End :
+				  Index->TableBegin) == Err_ERROR)
+      SuccessOrError = Err_ERROR;
+
+   /***** Write the row corresponding to the user *****/
+   if (MrkIdx_CopyRange (FileDescriptor,FileUsrMarks,
+			 Index->Rows[NumRow].Begin,
+			 Index->Rows[NumRow].End) == Err_ERROR)
+      SuccessOrError = Err_ERROR;
+
+   /***** Write the footer *****/
+   if (Footer)
+      if (MrkIdx_CopyRange (FileDescriptor,FileUsrMarks,
+			    Index->Rows[Index->NumRows - Footer].Begin,
+			    Index->Rows[Index->NumRows - 1].End) == Err_ERROR)
+	 SuccessOrError = Err_ERROR;
+
+   /***** Write all from the end of the table *****/
+   if (MrkIdx_CopyRange (FileDescriptor,FileUsrMarks,
+			 Index->TableEnd,Index->Size) == Err_ERROR)
+      SuccessOrError = Err_ERROR;
+
+   close (FileDescriptor);
+
+   return SuccessOrError;
+  }
+
+/*****************************************************************************/
+/************** Copy a range of bytes of a file into other file **************/
+/*****************************************************************************/
+
+static Err_SuccessOrError_t MrkIdx_CopyRange (int FileDescriptor,FILE *FileTgt,
+					      off_t Begin,off_t End)
+  {
+   char Bytes[MrkIdx_NUM_BYTES_PER_CHUNK];
+   ssize_t NumBytesRead;
+   size_t NumBytesToRead;
+
+   while (Begin < End)
+     {
+      NumBytesToRead = (End - Begin) < (off_t) sizeof (Bytes) ? (size_t) (End - Begin) :
+								 sizeof (Bytes);
+      if ((NumBytesRead = pread (FileDescriptor,Bytes,NumBytesToRead,Begin)) <= 0)
+	 return Err_ERROR;
+      if (fwrite (Bytes,1,(size_t) NumBytesRead,FileTgt) != (size_t) NumBytesRead)
+	 return Err_ERROR;
+      Begin += NumBytesRead;
+     }
+
+   return Err_SUCCESS;
+  }
+
+/*****************************************************************************/
+/****** Compare two users' IDs in index, used for sorting and searching ******/
+/*****************************************************************************/
+
+static int MrkIdx_CompareIDs (const void *Item1,const void *Item2)
+  {
+   const struct MrkIdx_UsrID *UsrID1 = (const struct MrkIdx_UsrID *) Item1;
+   const struct MrkIdx_UsrID *UsrID2 = (const struct MrkIdx_UsrID *) Item2;
+   int Cmp;
+
+   if ((Cmp = strcmp (UsrID1->ID,UsrID2->ID)))
+      return Cmp;
+   return (UsrID1->NumRow > UsrID2->NumRow) - (UsrID1->NumRow < UsrID2->NumRow);
+  }
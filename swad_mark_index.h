@@ -0,0 +1,90 @@
+// swad_mark_index.h: index of users' IDs in files of marks
+
+#ifndef _SWAD_MRK_IDX
+#define _SWAD_MRK_IDX
+/*
+    SWAD (Shared Workspace At a Distance),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2026 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/********************************** Headers **********************************/
+/*****************************************************************************/
+
+#include <stdbool.h>		// For boolean type
+#include <stdio.h>		// For FILE
+#include <sys/types.h>		// For off_t
+
+#include "swad_error.h"
+#include "swad_exist.h"
+#include "swad_ID.h"
+#include "swad_mark.h"
+#include "swad_user_type.h"
+
+/*****************************************************************************/
+/******************************* Public types ********************************/
+/*****************************************************************************/
+
+struct MrkIdx_Row
+  {
+   off_t Begin;		// Position of "<tr"
+   off_t End;		// Position just after "</tr>"
+   bool OnlyIDs;	// First cell contains only users' IDs
+  };
+
+struct MrkIdx_UsrID
+  {
+   char ID[ID__MAX_BYTES_USR_ID + 1];	// In capitals and without leading zeros
+   unsigned NumRow;
+  };
+
+struct MrkIdx_Index
+  {
+   off_t Size;			// Size of file of marks
+   off_t TableBegin;		// Position just after "<table ...>"
+   off_t TableEnd;		// Position of "</table>"
+   unsigned NumRows;
+   struct MrkIdx_Row *Rows;
+   unsigned NumIDs;
+   struct MrkIdx_UsrID *IDs;	// Sorted by ID and row
+  };
+
+/*****************************************************************************/
+/***************************** Public prototypes *****************************/
+/*****************************************************************************/
+
+void MrkIdx_ResetIndex (struct MrkIdx_Index *Index);
+void MrkIdx_FreeIndex (struct MrkIdx_Index *Index);
+
+Exi_Exist_t MrkIdx_ScanTable (FILE *FileAllMarks,struct MrkIdx_Index *Index);
+void MrkIdx_StoreIndex (const char *PathFileAllMarks,
+			const struct MrkIdx_Index *Index);
+Err_SuccessOrError_t MrkIdx_GetIndex (const char *PathFileAllMarks,
+				      struct MrkIdx_Index *Index);
+
+Exi_Exist_t MrkIdx_GetRowOfUsr (const struct MrkIdx_Index *Index,
+				const struct Usr_Data *UsrDat,
+				unsigned FirstRow,unsigned *NumRow);
+Err_SuccessOrError_t MrkIdx_WriteUsrMarks (FILE *FileUsrMarks,
+					   const char *PathFileAllMarks,
+					   const struct MrkIdx_Index *Index,
+					   unsigned NumRow,
+					   const struct Mrk_Properties *Marks);
+
+#endif
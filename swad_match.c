@@ -208,6 +208,8 @@ static void Mch_WriteAnswersMatchResult (const struct Mch_Match *Match,
 static void Mch_WriteChoiceAnsViewMatch (const struct Mch_Match *Match,
                                          struct Qst_Question *Qst,
                                          const char *Class,Lay_Show_t ShowResult);
+static unsigned Mch_GetNumUsrsWhoHaveChosenEachAns (const struct Mch_Match *Match,
+						    unsigned NumUsrs[Qst_MAX_OPTS_PER_QST]);
 static void Mch_ShowQuestionAndAnswersStd (const struct Mch_Match *Match,
 					   const struct Mch_UsrAnswer *UsrAnswer,
 					   Mch_Update_t Update);
@@ -2845,12 +2847,13 @@ static void Mch_WriteChoiceAnsViewMatch (const struct Mch_Match *Match,
   {
    unsigned NumOpt;
    bool RowIsOpen = false;
-   unsigned NumRespondersQst;
-   unsigned NumRespondersAns;
+   unsigned NumRespondersQst = 0;
+   unsigned NumRespondersAns[Qst_MAX_OPTS_PER_QST];	// Number of users who have chosen each answer
    unsigned Indexes[Qst_MAX_OPTS_PER_QST];	// Indexes of all answers of this question
 
-   /***** Get number of users who have answered this question from database *****/
-   NumRespondersQst = Mch_DB_GetNumUsrsWhoAnsweredQst (Match->MchCod,Match->Status.QstInd);
+   /***** Get number of users who have chosen each answer from database *****/
+   if (ShowResult == Lay_SHOW)
+      NumRespondersQst = Mch_GetNumUsrsWhoHaveChosenEachAns (Match,NumRespondersAns);
 
    /***** Change format of answers text *****/
    Qst_ChangeFormatOptionsText (Qst);
@@ -2892,11 +2895,8 @@ static void Mch_WriteChoiceAnsViewMatch (const struct Mch_Match *Match,
 	       switch (ShowResult)
 		 {
 		  case Lay_SHOW:
-		     /* Get number of users who selected this answer */
-		     NumRespondersAns = Mch_DB_GetNumUsrsWhoHaveChosenAns (Match->MchCod,Match->Status.QstInd,Indexes[NumOpt]);
-
 		     /* Draw proportional bar for this answer */
-		     Mch_DrawBarNumUsrs (NumRespondersAns,NumRespondersQst,
+		     Mch_DrawBarNumUsrs (NumRespondersAns[Indexes[NumOpt]],NumRespondersQst,
 					 Qst->Answer.Options[Indexes[NumOpt]].Correct);
 		     break;
 		  case Lay_DONT_SHOW:
@@ -2926,6 +2926,56 @@ static void Mch_WriteChoiceAnsViewMatch (const struct Mch_Match *Match,
    HTM_TABLE_End ();
   }
 
+/*****************************************************************************/
+/**** Get number of users who have chosen each answer of current question ****/
+/*****************************************************************************/
+// Returns the number of users who have answered the question
+
+static unsigned Mch_GetNumUsrsWhoHaveChosenEachAns (const struct Mch_Match *Match,
+						    unsigned NumUsrs[Qst_MAX_OPTS_PER_QST])
+  {
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   unsigned NumRows;
+   unsigned NumRow;
+   unsigned AnsInd;
+   unsigned NumUsrsThisAns;
+   unsigned NumUsrsQst = 0;
+
+   /***** Reset counters *****/
+   for (AnsInd = 0;
+	AnsInd < Qst_MAX_OPTS_PER_QST;
+	AnsInd++)
+      NumUsrs[AnsInd] = 0;
+
+   /***** Get counters of all answers with a single query *****/
+   NumRows = Mch_DB_GetNumUsrsWhoHaveChosenEachAns (&mysql_res,
+						    Match->MchCod,
+						    Match->Status.QstInd);
+   for (NumRow = 0;
+	NumRow < NumRows;
+	NumRow++)
+     {
+      row = mysql_fetch_row (mysql_res);
+      /*
+      row[0] AnsInd
+      row[1] COUNT(*)
+      */
+      if (sscanf (row[0],"%u",&AnsInd) == 1 &&
+	  sscanf (row[1],"%u",&NumUsrsThisAns) == 1)
+	{
+	 if (AnsInd < Qst_MAX_OPTS_PER_QST)
+	    NumUsrs[AnsInd] = NumUsrsThisAns;
+	 NumUsrsQst += NumUsrsThisAns;
+	}
+     }
+
+   /***** Free structure that stores the query result *****/
+   DB_FreeMySQLResult (&mysql_res);
+
+   return NumUsrsQst;
+  }
+
 /*****************************************************************************/
 /***** Show question and its answers when playing a match (as a student) *****/
 /*****************************************************************************/
@@ -723,21 +723,22 @@ unsigned Mch_DB_GetNumUsrsWhoAnsweredQst (long MchCod,unsigned QstInd)
   }
 
 /*****************************************************************************/
-/*** Get number of users who have chosen a given answer of a game question ***/
+/**** Get number of users who have chosen each answer of a match question ****/
 /*****************************************************************************/
 
-unsigned Mch_DB_GetNumUsrsWhoHaveChosenAns (long MchCod,unsigned QstInd,unsigned AnsInd)
+unsigned Mch_DB_GetNumUsrsWhoHaveChosenEachAns (MYSQL_RES **mysql_res,
+                                                long MchCod,unsigned QstInd)
   {
    return (unsigned)
-   DB_QueryCOUNT ("can not get number of users who have chosen an answer",
-		  "SELECT COUNT(*)"
-		   " FROM mch_answers"
-		  " WHERE MchCod=%ld"
-		    " AND QstInd=%u"
-		    " AND AnsInd=%u",
-		  MchCod,
-		  QstInd,
-		  AnsInd);
+   DB_QuerySELECT (mysql_res,"can not get number of users who have chosen answers",
+		   "SELECT AnsInd,"	// row[0]
+			  "COUNT(*)"	// row[1]
+		    " FROM mch_answers"
+		   " WHERE MchCod=%ld"
+		     " AND QstInd=%u"
+		" GROUP BY AnsInd",
+		   MchCod,
+		   QstInd);
   }
 
 /*****************************************************************************/
@@ -82,7 +82,8 @@ void Mch_DB_UpdateIndexesOfQstsGreaterThan (long GamCod,unsigned QstInd);
 Exi_Exist_t Mch_DB_GetUsrAnsToQst (MYSQL_RES **mysql_res,
                                    long MchCod,long UsrCod,unsigned QstInd);
 unsigned Mch_DB_GetNumUsrsWhoAnsweredQst (long MchCod,unsigned QstInd);
-unsigned Mch_DB_GetNumUsrsWhoHaveChosenAns (long MchCod,unsigned QstInd,unsigned AnsInd);
+unsigned Mch_DB_GetNumUsrsWhoHaveChosenEachAns (MYSQL_RES **mysql_res,
+                                                long MchCod,unsigned QstInd);
 
 void Mch_DB_RemoveMyAnswerToMatchQuestion (const struct Mch_Match *Match);
 void Mch_DB_RemUsrAnswersOfAQuestion (long GamCod,unsigned QstInd);
@@ -32,7 +32,6 @@
 #include <string.h>		// For string functions
 #include <sys/stat.h>		// For lstat
 #include <sys/types.h>		// For lstat
-#include <sys/wait.h>		// For the macro WEXITSTATUS
 #include <unistd.h>		// For unlink, lstat
 
 #include "swad_action_list.h"
@@ -47,6 +46,7 @@
 #include "swad_form.h"
 #include "swad_global.h"
 #include "swad_HTML.h"
+#include "swad_image.h"
 #include "swad_media.h"
 #include "swad_media_database.h"
 #include "swad_parameter.h"
@@ -120,8 +120,7 @@ static void Usr_GetURLFromForm (const char *ParName,struct Med_Media *Media);
 static void Usr_GetTitleFromForm (const char *ParName,struct Med_Media *Media);
 static void Med_GetAndProcessFileFromForm (const char *ParFile,
                                            struct Med_Media *Media);
-static Err_SuccessOrError_t Med_DetectIfAnimated (struct Med_Media *Media,
-						  const char PathFileOrg[PATH_MAX + 1]);
+static Err_SuccessOrError_t Med_DetectIfAnimated (const char PathFileOrg[PATH_MAX + 1]);
 
 static void Med_ProcessJPG (struct Med_Media *Media,
 			    const char PathFileOrg[PATH_MAX + 1]);
@@ -130,12 +129,6 @@ static void Med_ProcessGIF (struct Med_Media *Media,
 static void Med_ProcessVideo (struct Med_Media *Media,
 			      const char PathFileOrg[PATH_MAX + 1]);
 
-static int Med_ResizeImage (struct Med_Media *Media,
-                            const char PathFileOriginal[PATH_MAX + 1],
-                            const char PathFileProcessed[PATH_MAX + 1]);
-static int Med_GetFirstFrame (const char PathFileOriginal[PATH_MAX + 1],
-                              const char PathFileProcessed[PATH_MAX + 1]);
-
 static void Med_GetAndProcessYouTubeFromForm (const char *ParURL,
                                               struct Med_Media *Media);
 static void Med_GetAndProcessEmbedFromForm (const char *ParURL,
@@ -806,7 +799,7 @@ static void Med_GetAndProcessFileFromForm (const char *ParFile,
      {
       /***** Detect if animated GIF *****/
       if (Media->Type == Med_GIF)
-	 if (Med_DetectIfAnimated (Media,PathFileOrg) == Err_ERROR)
+	 if (Med_DetectIfAnimated (PathFileOrg) == Err_ERROR)
             Media->Type = Med_JPG;
 
       /***** Process media depending on the media file extension *****/
@@ -824,42 +817,11 @@ static void Med_GetAndProcessFileFromForm (const char *ParFile,
 /*****************************************************************************/
 // Return if animated
 
-static Err_SuccessOrError_t Med_DetectIfAnimated (struct Med_Media *Media,
-						  const char PathFileOrg[PATH_MAX + 1])
+static Err_SuccessOrError_t Med_DetectIfAnimated (const char PathFileOrg[PATH_MAX + 1])
   {
-   char PathFileTxtTmp[PATH_MAX + 1];
-   char Command[128 + PATH_MAX * 2];
-   int ReturnCode;
-   FILE *FileTxtTmp;	// Temporary file with the output of the command
-   int NumFrames = 0;
-
-   /***** Build path to temporary text file *****/
-   snprintf (PathFileTxtTmp,sizeof (PathFileTxtTmp),"%s/%s.txt",
-             Cfg_PATH_MEDIA_TMP_PRIVATE,Media->Name);
-
-   /***** Execute system command to get number of frames in GIF *****/
-   snprintf (Command,sizeof (Command),
-             "identify -format '%%n\n' %s | head -1 > %s",
-             PathFileOrg,PathFileTxtTmp);
-   ReturnCode = system (Command);
-   if (ReturnCode == -1)
-      return Err_ERROR;		// Error
-   ReturnCode = WEXITSTATUS(ReturnCode);
-   if (ReturnCode)
-      return Err_ERROR;		// Error
-
-   /***** Read temporary file *****/
-   if ((FileTxtTmp = fopen (PathFileTxtTmp,"rb")) == NULL)
-      return Err_ERROR;		// Error
-   if (fscanf (FileTxtTmp,"%d",&NumFrames) != 1)
-      return Err_ERROR;		// Error
-   fclose (FileTxtTmp);
-
-   /***** Remove temporary file *****/
-   unlink (PathFileTxtTmp);
-
-   return NumFrames > 1 ? Err_SUCCESS :	// NumFrames > 1 ==> Animated
-			  Err_ERROR;
+   /***** Get number of frames in GIF (only headers are read) *****/
+   return Img_GetNumFrames (PathFileOrg) > 1 ? Err_SUCCESS :	// NumFrames > 1 ==> Animated
+					       Err_ERROR;
   }
 
 /*****************************************************************************/
@@ -871,11 +833,12 @@ static void Med_ProcessJPG (struct Med_Media *Media,
   {
    char PathFileJPGTmp[PATH_MAX + 1];	// Full name of temporary processed file
 
-   /***** Convert original media to temporary JPG processed file
-	  by calling to program that makes the conversion *****/
+   /***** Convert original media to temporary JPG processed file *****/
    snprintf (PathFileJPGTmp,sizeof (PathFileJPGTmp),"%s/%s.%s",
 	     Cfg_PATH_MEDIA_TMP_PRIVATE,Media->Name,Med_Extensions[Med_JPG]);
-   if (Med_ResizeImage (Media,PathFileOrg,PathFileJPGTmp) == 0)	// On success ==> 0 is returned
+   if (Img_ResizeImage (PathFileOrg,PathFileJPGTmp,
+			Media->Width,Media->Height,Img_SHRINK_TO_FIT,
+			Media->Quality) == Err_SUCCESS)
       /* Success */
       Media->Status = Med_PROCESSED;
    else // Error processing media
@@ -913,7 +876,7 @@ static void Med_ProcessGIF (struct Med_Media *Media,
 		and save it on temporary PNG file */
 	 snprintf (PathFilePNGTmp,sizeof (PathFilePNGTmp),"%s/%s.png",
 		   Cfg_PATH_MEDIA_TMP_PRIVATE,Media->Name);
-	 if (Med_GetFirstFrame (PathFileOrg,PathFilePNGTmp) == 0)	// On success ==> 0 is returned
+	 if (Img_GetFirstFrame (PathFileOrg,PathFilePNGTmp) == Err_SUCCESS)
 	   {
 	    /* Success */
 	    /***** Move original GIF file to temporary GIF file *****/
@@ -999,58 +962,6 @@ static void Med_ProcessVideo (struct Med_Media *Media,
       Med_ErrorProcessingMediaFile ();
   }
 
-/*****************************************************************************/
-/****************************** Resize image *********************************/
-/*****************************************************************************/
-// Return 0 on success
-// Return != 0 on error
-
-static int Med_ResizeImage (struct Med_Media *Media,
-                            const char PathFileOriginal[PATH_MAX + 1],
-                            const char PathFileProcessed[PATH_MAX + 1])
-  {
-   char Command[256 + PATH_MAX * 2];
-   int ReturnCode;
-
-   snprintf (Command,sizeof (Command),
-             "convert %s -resize '%ux%u>' -quality %u %s",
-             PathFileOriginal,
-             Media->Width,
-             Media->Height,
-             Media->Quality,
-             PathFileProcessed);
-   ReturnCode = system (Command);
-   if (ReturnCode == -1)
-      Err_ShowErrorAndExit ("Error when running command to process media.");
-
-   ReturnCode = WEXITSTATUS(ReturnCode);
-   return ReturnCode;
-  }
-
-/*****************************************************************************/
-/************ Process original media generating processed media **************/
-/*****************************************************************************/
-// Return 0 on success
-// Return != 0 on error
-
-static int Med_GetFirstFrame (const char PathFileOriginal[PATH_MAX + 1],
-                              const char PathFileProcessed[PATH_MAX + 1])
-  {
-   char Command[128 + PATH_MAX * 2];
-   int ReturnCode;
-
-   snprintf (Command,sizeof (Command),"convert '%s[0]' %s",
-             PathFileOriginal,
-             PathFileProcessed);
-   ReturnCode = system (Command);
-   if (ReturnCode == -1)
-      Err_ShowErrorAndExit ("Error when running command to process media.");
-
-   ReturnCode = WEXITSTATUS(ReturnCode);
-
-   return ReturnCode;
-  }
-
 /*****************************************************************************/
 /************* Get link from form and transform to YouTube code **************/
 /*****************************************************************************/
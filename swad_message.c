@@ -777,9 +777,8 @@ void Msg_RecMsgFromUsr (void)
    switch (SuccessOrError)
      {
       case Err_SUCCESS:
-	 /***** Loop over the list Gbl.Usrs.Selected.List[Rol_UNK],
-		that holds the list of the recipients,
-		creating a received message for each recipient *****/
+	 /***** Get the recipients in the list Gbl.Usrs.Selected.List[Rol_UNK]
+		and create a received message for each recipient *****/
 	 Msg_CreateRcvMsgForEachRecipient (&Messages);
 
 	 /***** Update received message setting Replied field to true *****/
@@ -819,9 +818,9 @@ void Msg_RecMsgFromUsr (void)
   }
 
 /*****************************************************************************/
-/************ Loop over the list Gbl.Usrs.Selected.List[Rol_UNK], ************/
-/************ that holds the list of the recipients,              ************/
-/************ creating a received message for each recipient      ************/
+/************ Get the recipients in Gbl.Usrs.Selected.List[Rol_UNK] **********/
+/************ from database with only one query and create         **********/
+/************ the received messages for all of them at once        **********/
 /*****************************************************************************/
 
 static void Msg_CreateRcvMsgForEachRecipient (struct Msg_Messages *Messages)
@@ -838,7 +837,20 @@ static void Msg_CreateRcvMsgForEachRecipient (struct Msg_Messages *Messages)
      };
    struct Med_Media Media;
    struct Usr_Data UsrDstData;
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
    const char *Ptr;
+   char *EnUsrCods;
+   char *PtrEnUsrCods;
+   unsigned NumUsrsSelected;
+   unsigned NumUsrs;
+   unsigned NumUsr;
+   long *RcvUsrCods;			// Recipients of the message
+   Ntf_NotifyByEmail_t *RcvNotifyByEmail;
+   unsigned NumRcvs = 0;
+   long *NtfUsrCods;			// Recipients who want to be notified
+   Ntf_Status_t *NtfStatus;
+   unsigned NumNtfs = 0;
    bool MsgAlreadyInserted = false;
    long NewMsgCod = -1L;	// Initiliazed to avoid warning
    Ntf_NotifyByEmail_t NotifyByEmail;
@@ -852,95 +864,153 @@ static void Msg_CreateRcvMsgForEachRecipient (struct Msg_Messages *Messages)
    Med_GetMediaFromForm (-1L,-1L,-1,&Media,NULL,NULL);
    Ale_ShowAlerts (NULL);
 
-      /***** Initialize user's data *****/
-      Usr_UsrDataConstructor (&UsrDstData);
+   /***** Initialize user's data *****/
+   Usr_UsrDataConstructor (&UsrDstData);
 
-         /***** Change content format *****/
-	 Str_ChangeFormat (Str_FROM_FORM,Str_TO_RIGOROUS_HTML,
-			   Messages->Content,Cns_MAX_BYTES_LONG_TEXT,Str_DONT_REMOVE_SPACES);
+   /***** Change content format *****/
+   Str_ChangeFormat (Str_FROM_FORM,Str_TO_RIGOROUS_HTML,
+		     Messages->Content,Cns_MAX_BYTES_LONG_TEXT,Str_DONT_REMOVE_SPACES);
 
-	 /***** Loop over list of recipients *****/
-	 for (Ptr = Gbl.Usrs.Selected.List[Rol_UNK],
-	      Messages->Rcv.NumRecipients = Messages->Rcv.NumErrors = 0;
-	      *Ptr;
-	     )
-	   {
-	    Par_GetNextStrUntilSeparParMult (&Ptr,UsrDstData.EnUsrCod,
-					     Cry_BYTES_ENCRYPTED_STR_SHA256_BASE64);
-	    Usr_GetUsrCodFromEncryptedUsrCod (&UsrDstData);
-	    switch (Usr_ChkUsrCodAndGetAllUsrDataFromUsrCod (&UsrDstData,	// Get recipient's data from database
-							     Usr_DONT_GET_PREFS,
-							     Usr_DONT_GET_ROLE_IN_CRS))
-	      {
-	       case Exi_EXISTS:
-		  /***** Check if recipient has banned me *****/
-		  if (Msg_DB_CheckIfUsrIsBanned (Gbl.Usrs.Me.UsrDat.UsrCod,
-						 UsrDstData.UsrCod))
-		     /***** Show an alert indicating that the message has not been sent successfully *****/
-		     Ale_ShowAlert (Ale_WARNING,Txt_message_not_sent_to_X,
-				    UsrDstData.FullName);
-		  else
-		    {
-		     /***** Create message *****/
-		     if (!MsgAlreadyInserted)
-		       {
-			// The message is inserted only once in the table of messages sent
-			NewMsgCod = Msg_InsertNewMsg (Messages->Subject,Messages->Content,&Media);
-			MsgAlreadyInserted = true;
-		       }
+   /***** Build list of encrypted codes of recipients
+	  'Code1','Code2',... to get all of them in one query *****/
+   // Each code will be enclosed between apostrophes and followed by a comma
+   if ((EnUsrCods = malloc (strlen (Gbl.Usrs.Selected.List[Rol_UNK]) * 3 + 1)) == NULL)
+      Err_NotEnoughMemoryExit ();
+   EnUsrCods[0] = '\0';
+   for (Ptr = Gbl.Usrs.Selected.List[Rol_UNK], PtrEnUsrCods = EnUsrCods,
+	NumUsrsSelected = 0;
+	*Ptr;
+       )
+     {
+      Par_GetNextStrUntilSeparParMult (&Ptr,UsrDstData.EnUsrCod,
+				       Cry_BYTES_ENCRYPTED_STR_SHA256_BASE64);
+      if (UsrDstData.EnUsrCod[0])
+	 PtrEnUsrCods += sprintf (PtrEnUsrCods,"%s'%s'",
+				  NumUsrsSelected++ ? "," :
+						      "",
+				  UsrDstData.EnUsrCod);
+     }
 
-		     /***** If this recipient is the original sender of a message been replied, set Replied *****/
-		     Messages->Reply.Replied = Messages->Reply.IsReply == Msg_IS_REPLY &&
-					       UsrDstData.UsrCod == Gbl.Usrs.Other.UsrDat.UsrCod ? Msg_REPLIED :
-												   Msg_NOT_REPLIED;
+   /***** Get recipients from database,
+          checking if each of them has banned me *****/
+   NumUsrs = NumUsrsSelected ? Msg_DB_GetRecipients (&mysql_res,EnUsrCods) :
+			       0;
+   free (EnUsrCods);
+
+   /***** Allocate lists of recipients and notifications *****/
+   if ((RcvUsrCods       = malloc ((NumUsrs + 1) * sizeof (*RcvUsrCods      ))) == NULL ||
+       (RcvNotifyByEmail = malloc ((NumUsrs + 1) * sizeof (*RcvNotifyByEmail))) == NULL ||
+       (NtfUsrCods       = malloc ((NumUsrs + 1) * sizeof (*NtfUsrCods      ))) == NULL ||
+       (NtfStatus        = malloc ((NumUsrs + 1) * sizeof (*NtfStatus       ))) == NULL)
+      Err_NotEnoughMemoryExit ();
 
-		     /***** Create received message and optional notification for this recipient *****/
-		     if ((UsrDstData.NtfEvents.CreateNotif & (1 << Ntf_EVENT_MESSAGE)))	// Create notification?
-		       {
-			NotifyByEmail = UsrDstData.UsrCod != Gbl.Usrs.Me.UsrDat.UsrCod &&
-					(UsrDstData.NtfEvents.SendEmail & (1 << Ntf_EVENT_MESSAGE)) ? Ntf_NOTIFY_BY_EMAIL :
-												      Ntf_DONT_NOTIFY_BY_EMAIL;
-
-			/* Create the received message for this recipient */
-			Msg_DB_CreateRcvMsg (NewMsgCod,UsrDstData.UsrCod,NotifyByEmail);
-
-			/* Create notification for this recipient.
-			   If this recipient wants to receive notifications by -mail,
-			   activate the sending of a notification */
-			HieCods[Hie_INS] = Gbl.Hierarchy.Node[Hie_INS].HieCod;
-			HieCods[Hie_CTR] = Gbl.Hierarchy.Node[Hie_CTR].HieCod;
-			HieCods[Hie_DEG] = Gbl.Hierarchy.Node[Hie_DEG].HieCod;
-			HieCods[Hie_CRS] = Gbl.Hierarchy.Node[Hie_CRS].HieCod;
-			Ntf_DB_StoreNotifyEventToUsr (Ntf_EVENT_MESSAGE,
-						      UsrDstData.UsrCod,NewMsgCod,
-						      Ntf_Status[NotifyByEmail],
-						      HieCods);
-		       }
-		     else
-			/* Create the received message for this recipient */
-		        Msg_DB_CreateRcvMsg (NewMsgCod,UsrDstData.UsrCod,
-					     NotifyByEmail = Ntf_DONT_NOTIFY_BY_EMAIL);
+   /***** Loop over recipients got from database *****/
+   Messages->Rcv.NumRecipients = 0;
+   Messages->Rcv.NumErrors = NumUsrsSelected > NumUsrs ? NumUsrsSelected - NumUsrs :
+							 0;
+   Messages->Reply.Replied = Msg_NOT_REPLIED;
+   for (NumUsr = 0;
+	NumUsr < NumUsrs;
+	NumUsr++)
+     {
+      row = mysql_fetch_row (mysql_res);
 
-		     /***** Show an alert indicating that the message has been sent successfully *****/
-		     Ale_ShowAlert (Ale_SUCCESS,
-				    *Msg[NotifyByEmail],UsrDstData.FullName);
+      /* Get user's code (row[0]) */
+      UsrDstData.UsrCod = Str_ConvertStrCodToLongCod (row[0]);
+
+      /* Get name (row[1], row[2], row[3]) */
+      Str_Copy (UsrDstData.Surname1,row[1],sizeof (UsrDstData.Surname1) - 1);
+      Str_Copy (UsrDstData.Surname2,row[2],sizeof (UsrDstData.Surname2) - 1);
+      Str_Copy (UsrDstData.FrstName,row[3],sizeof (UsrDstData.FrstName) - 1);
+      Str_ConvertToTitleType (UsrDstData.Surname1);
+      Str_ConvertToTitleType (UsrDstData.Surname2);
+      Str_ConvertToTitleType (UsrDstData.FrstName);
+      Usr_BuildFullName (&UsrDstData);
+
+      /* Get on which events the user wants to be notified
+	 inside the platform (row[4]) and by email (row[5]) */
+      if (sscanf (row[4],"%u",&UsrDstData.NtfEvents.CreateNotif) != 1)
+	 UsrDstData.NtfEvents.CreateNotif = (unsigned) -1;	// 0xFF..FF
+      if (sscanf (row[5],"%u",&UsrDstData.NtfEvents.SendEmail) != 1)
+	 UsrDstData.NtfEvents.SendEmail = 0;
+
+      /***** Check if recipient has banned me (row[6]) *****/
+      if (row[6][0] == '1')
+	 /***** Show an alert indicating that the message has not been sent successfully *****/
+	 Ale_ShowAlert (Ale_WARNING,Txt_message_not_sent_to_X,
+			UsrDstData.FullName);
+      else
+	{
+	 /***** Create message *****/
+	 if (!MsgAlreadyInserted)
+	   {
+	    // The message is inserted only once in the table of messages sent
+	    NewMsgCod = Msg_InsertNewMsg (Messages->Subject,Messages->Content,&Media);
+	    MsgAlreadyInserted = true;
+	   }
 
-		     /***** Increment number of recipients *****/
-		     Messages->Rcv.NumRecipients++;
-		    }
-		  break;
-	       case Exi_DOES_NOT_EXIST:
-	       default:
-		  Ale_ShowAlert (Ale_ERROR,Txt_Error_getting_data_from_a_recipient);
-		  Messages->Rcv.NumErrors++;
-		  break;
-	      }
+	 /***** If this recipient is the original sender of a message been replied, set Replied *****/
+	 if (Messages->Reply.IsReply == Msg_IS_REPLY &&
+	     UsrDstData.UsrCod == Gbl.Usrs.Other.UsrDat.UsrCod)
+	    Messages->Reply.Replied = Msg_REPLIED;
+
+	 /***** Add received message and optional notification for this recipient *****/
+	 if ((UsrDstData.NtfEvents.CreateNotif & (1 << Ntf_EVENT_MESSAGE)))	// Create notification?
+	   {
+	    NotifyByEmail = UsrDstData.UsrCod != Gbl.Usrs.Me.UsrDat.UsrCod &&
+			    (UsrDstData.NtfEvents.SendEmail & (1 << Ntf_EVENT_MESSAGE)) ? Ntf_NOTIFY_BY_EMAIL :
+											  Ntf_DONT_NOTIFY_BY_EMAIL;
+
+	    /* Add notification for this recipient.
+	       If this recipient wants to receive notifications by -mail,
+	       activate the sending of a notification */
+	    NtfUsrCods[NumNtfs] = UsrDstData.UsrCod;
+	    NtfStatus[NumNtfs++] = Ntf_Status[NotifyByEmail];
 	   }
+	 else
+	    NotifyByEmail = Ntf_DONT_NOTIFY_BY_EMAIL;
 
-      /***** Free memory used for user's data *****/
-      Usr_UsrDataDestructor (&UsrDstData);
+	 /* Add the received message for this recipient */
+	 RcvUsrCods[NumRcvs] = UsrDstData.UsrCod;
+	 RcvNotifyByEmail[NumRcvs++] = NotifyByEmail;
+
+	 /***** Show an alert indicating that the message has been sent successfully *****/
+	 Ale_ShowAlert (Ale_SUCCESS,
+			*Msg[NotifyByEmail],UsrDstData.FullName);
 
-   /***** Free image *****/
+	 /***** Increment number of recipients *****/
+	 Messages->Rcv.NumRecipients++;
+	}
+     }
+
+   /***** Free structure that stores the query result *****/
+   if (NumUsrsSelected)
+      DB_FreeMySQLResult (&mysql_res);
+
+   /***** Create the received messages for all recipients *****/
+   Msg_DB_CreateRcvMsgs (NewMsgCod,NumRcvs,RcvUsrCods,RcvNotifyByEmail);
+
+   /***** Create notifications for all recipients who want them *****/
+   HieCods[Hie_INS] = Gbl.Hierarchy.Node[Hie_INS].HieCod;
+   HieCods[Hie_CTR] = Gbl.Hierarchy.Node[Hie_CTR].HieCod;
+   HieCods[Hie_DEG] = Gbl.Hierarchy.Node[Hie_DEG].HieCod;
+   HieCods[Hie_CRS] = Gbl.Hierarchy.Node[Hie_CRS].HieCod;
+   Ntf_DB_StoreNotifyEventToUsrs (Ntf_EVENT_MESSAGE,
+				  NumNtfs,NtfUsrCods,NewMsgCod,NtfStatus,
+				  HieCods);
+
+   /***** Show an alert for recipients not found *****/
+   for (NumUsr = 0;
+	NumUsr < Messages->Rcv.NumErrors;
+	NumUsr++)
+      Ale_ShowAlert (Ale_ERROR,Txt_Error_getting_data_from_a_recipient);
+
+   /***** Free memory *****/
+   free (NtfStatus);
+   free (NtfUsrCods);
+   free (RcvNotifyByEmail);
+   free (RcvUsrCods);
+   Usr_UsrDataDestructor (&UsrDstData);
    Med_MediaDestructor (&Media);
   }
 
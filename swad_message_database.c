@@ -37,6 +37,12 @@
 #include "swad_message.h"
 #include "swad_message_database.h"
 
+/*****************************************************************************/
+/***************************** Private constants *****************************/
+/*****************************************************************************/
+
+#define Msg_DB_MAX_BYTES_RCV_ROW (1 + 2 * Cns_MAX_DIGITS_LONG + 22)	// ",(MsgCod,UsrCod,'N','N','N','N')"
+
 /*****************************************************************************/
 /************** External global variables from others modules ****************/
 /*****************************************************************************/
@@ -105,6 +111,52 @@ void Msg_DB_CreateRcvMsg (long MsgCod,long UsrCod,Ntf_NotifyByEmail_t NotifyByEm
 	           NotifyByEmail_YN[NotifyByEmail]);
   }
 
+/*****************************************************************************/
+/******* Insert a message in the table of received messages of several *******/
+/******* recipients using only one query                                *******/
+/*****************************************************************************/
+
+void Msg_DB_CreateRcvMsgs (long MsgCod,unsigned NumUsrs,
+			   const long *UsrCods,
+			   const Ntf_NotifyByEmail_t *NotifyByEmail)
+  {
+   static const char NotifyByEmail_YN[Ntf_NUM_NOTIFY_BY_EMAIL] =
+     {
+      [Ntf_DONT_NOTIFY_BY_EMAIL] = 'N',
+      [Ntf_NOTIFY_BY_EMAIL     ] = 'Y',
+     };
+   char *Values;
+   char *Ptr;
+   unsigned NumUsr;
+
+   /***** Trivial check *****/
+   if (NumUsrs == 0)
+      return;
+
+   /***** Build rows to be inserted *****/
+   if ((Values = malloc ((size_t) NumUsrs * Msg_DB_MAX_BYTES_RCV_ROW + 1)) == NULL)
+      Err_NotEnoughMemoryExit ();
+   for (NumUsr = 0, Ptr = Values;
+	NumUsr < NumUsrs;
+	NumUsr++)
+      Ptr += sprintf (Ptr,"%s(%ld,%ld,'%c','N','N','N')",
+		      NumUsr ? "," :
+			       "",
+		      MsgCod,
+		      UsrCods[NumUsr],
+		      NotifyByEmail_YN[NotifyByEmail[NumUsr]]);
+
+   /***** Insert all rows *****/
+   DB_QueryINSERT ("can not create received messages",
+		   "INSERT INTO msg_rcv"
+		   " (MsgCod,UsrCod,Notified,Open,Replied,Expanded)"
+		   " VALUES"
+		   " %s",
+		   Values);
+
+   free (Values);
+  }
+
 /*****************************************************************************/
 /******** Update received message by setting Replied field to true ***********/
 /*****************************************************************************/
@@ -1690,6 +1742,36 @@ bool Msg_DB_CheckIfUsrIsBanned (long FromUsrCod,long ToUsrCod)
 		   ToUsrCod) == Exi_EXISTS;
   }
 
+/*****************************************************************************/
+/************ Get data of the recipients of a message, checking **************/
+/************ if each recipient has banned the sender           **************/
+/*****************************************************************************/
+// EnUsrCods is a list of encrypted user's codes between apostrophes separated by commas
+
+unsigned Msg_DB_GetRecipients (MYSQL_RES **mysql_res,const char *EnUsrCods)
+  {
+   return (unsigned)
+   DB_QuerySELECT (mysql_res,"can not get recipients",
+		   "SELECT usr_data.UsrCod,"			// row[0]
+			  "usr_data.Surname1,"			// row[1]
+			  "usr_data.Surname2,"			// row[2]
+			  "usr_data.FirstName,"			// row[3]
+			  "usr_data.NotifNtfEvents,"		// row[4]
+			  "usr_data.EmailNtfEvents,"		// row[5]
+			  "msg_banned.FromUsrCod IS NOT NULL"	// row[6]
+		    " FROM usr_data"
+		    " LEFT JOIN msg_banned"
+		      " ON msg_banned.FromUsrCod=%ld"
+		     " AND msg_banned.ToUsrCod=usr_data.UsrCod"
+		   " WHERE usr_data.EncryptedUsrCod IN (%s)"
+		" ORDER BY usr_data.Surname1,"
+			  "usr_data.Surname2,"
+			  "usr_data.FirstName,"
+			  "usr_data.UsrCod",
+		   Gbl.Usrs.Me.UsrDat.UsrCod,
+		   EnUsrCods);
+  }
+
 /*****************************************************************************/
 /**** Remove pair (sender's code - recipient's code) from table of banned ****/
 /*****************************************************************************/
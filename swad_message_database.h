@@ -46,6 +46,9 @@
 long Msg_DB_CreateNewMsg (const char *Subject,const char *Content,long MedCod);
 void Msg_DB_CreateSntMsg (long MsgCod,long HieCod);
 void Msg_DB_CreateRcvMsg (long MsgCod,long UsrCod,Ntf_NotifyByEmail_t NotifyByEmail);
+void Msg_DB_CreateRcvMsgs (long MsgCod,unsigned NumUsrs,
+			   const long *UsrCods,
+			   const Ntf_NotifyByEmail_t *NotifyByEmail);
 void Msg_DB_SetRcvMsgAsReplied (long MsgCod);
 void Msg_DB_ExpandSntMsg (long MsgCod);
 void Msg_DB_ExpandRcvMsg (long MsgCod);
@@ -90,6 +93,7 @@ void Msg_DB_CreateUsrsPairIntoBanned (long FromUsrCod,long ToUsrCod);
 unsigned Msg_DB_GetNumUsrsBannedBy (long UsrCod);
 unsigned Msg_DB_GetUsrsBannedBy (MYSQL_RES **mysql_res,long UsrCod);
 bool Msg_DB_CheckIfUsrIsBanned (long FromUsrCod,long ToUsrCod);
+unsigned Msg_DB_GetRecipients (MYSQL_RES **mysql_res,const char *EnUsrCods);
 
 void Msg_DB_RemoveUsrsPairFromBanned (long FromUsrCod,long ToUsrCod);
 void Msg_DB_RemoveUsrFromBanned (long UsrCod);
@@ -58,6 +58,24 @@ long Nck_DB_GetUsrCodFromNickname (const char *NickWithoutArr)
 			      NickWithoutArr);
   }
 
+/*****************************************************************************/
+/********** Get users' codes of several users from their nicknames ***********/
+/*****************************************************************************/
+// Nicks is a list of nicknames without arrobas, between apostrophes, separated by commas
+
+unsigned Nck_DB_GetUsrCodsFromNicknames (MYSQL_RES **mysql_res,const char *Nicks)
+  {
+   return (unsigned)
+   DB_QuerySELECT (mysql_res,"can not get users' codes",
+		   "SELECT usr_nicknames.Nickname,"	// row[0]
+			  "usr_nicknames.UsrCod"	// row[1]
+		    " FROM usr_nicknames,"
+			  "usr_data"
+		   " WHERE usr_nicknames.Nickname IN (%s)"
+		     " AND usr_nicknames.UsrCod=usr_data.UsrCod",
+		   Nicks);
+  }
+
 /*****************************************************************************/
 /************* Get nickname of a user from his/her user's code ***************/
 /*****************************************************************************/
@@ -36,6 +36,7 @@
 void Nck_DB_UpdateNick (long UsrCod,const char *NewNickname);
 
 long Nck_DB_GetUsrCodFromNickname (const char *NickWithoutArr);
+unsigned Nck_DB_GetUsrCodsFromNicknames (MYSQL_RES **mysql_res,const char *Nicks);
 void Nck_DB_GetNicknameFromUsrCod (long UsrCod,
                                    char NickWithoutArr[Nck_MAX_BYTES_NICK_WITHOUT_ARROBA + 1]);
 unsigned Nck_DB_GetUsrNicknames (MYSQL_RES **mysql_res,long UsrCod);
@@ -25,11 +25,20 @@
 /********************************* Headers ***********************************/
 /*****************************************************************************/
 
+#include <stdio.h>		// For sprintf
+#include <stdlib.h>		// For free, malloc
+
 #include "swad_database.h"
 #include "swad_error.h"
 #include "swad_global.h"
 #include "swad_notification_database.h"
 
+/*****************************************************************************/
+/***************************** Private constants *****************************/
+/*****************************************************************************/
+
+#define Ntf_DB_MAX_BYTES_NOTIF_ROW (1 + 8 * (Cns_MAX_DIGITS_LONG + 1) + 8)	// ",(NotifyEvent,ToUsrCod,...,NOW(),Status)"
+
 /*****************************************************************************/
 /************** External global variables from others modules ****************/
 /*****************************************************************************/
@@ -62,6 +71,56 @@ void Ntf_DB_StoreNotifyEventToUsr (Ntf_NotifyEvent_t NotifyEvent,
 	           (unsigned) Status);
   }
 
+/*****************************************************************************/
+/************ Store a notify event to several users into database ************/
+/************ using only one query                                ************/
+/*****************************************************************************/
+
+void Ntf_DB_StoreNotifyEventToUsrs (Ntf_NotifyEvent_t NotifyEvent,
+                                    unsigned NumUsrs,
+                                    const long *ToUsrCods,long Cod,
+                                    const Ntf_Status_t *Status,
+                                    long HieCods[Hie_NUM_LEVELS])
+  {
+   char *Values;
+   char *Ptr;
+   unsigned NumUsr;
+
+   /***** Trivial check *****/
+   if (NumUsrs == 0)
+      return;
+
+   /***** Build rows to be inserted *****/
+   if ((Values = malloc ((size_t) NumUsrs * Ntf_DB_MAX_BYTES_NOTIF_ROW + 1)) == NULL)
+      Err_NotEnoughMemoryExit ();
+   for (NumUsr = 0, Ptr = Values;
+	NumUsr < NumUsrs;
+	NumUsr++)
+      Ptr += sprintf (Ptr,"%s(%u,%ld,%ld,%ld,%ld,%ld,%ld,%ld,NOW(),%u)",
+		      NumUsr ? "," :
+			       "",
+		      (unsigned) NotifyEvent,
+		      ToUsrCods[NumUsr],
+		      Gbl.Usrs.Me.UsrDat.UsrCod,
+		      HieCods[Hie_INS],
+		      HieCods[Hie_CTR],
+		      HieCods[Hie_DEG],
+		      HieCods[Hie_CRS],
+		      Cod,
+		      (unsigned) Status[NumUsr]);
+
+   /***** Insert all rows *****/
+   DB_QueryINSERT ("can not create new notification events",
+		   "INSERT INTO ntf_notifications"
+		   " (NotifyEvent,ToUsrCod,FromUsrCod,"
+		     "InsCod,CtrCod,DegCod,CrsCod,Cod,TimeNotif,Status)"
+		   " VALUES"
+		   " %s",
+		   Values);
+
+   free (Values);
+  }
+
 /*****************************************************************************/
 /***************** Update my last access to notifications ********************/
 /*****************************************************************************/
@@ -214,6 +273,25 @@ void Ntf_DB_MarkNotifToOneUsrAsRemoved (Ntf_NotifyEvent_t NotifyEvent,long Cod,l
 		      Gbl.Hierarchy.Node[Hie_CRS].HieCod);
   }
 
+/*****************************************************************************/
+/* Set notifications of a type to several users in current course as removed */
+/*****************************************************************************/
+// SubQueryUsrs is a list of users' codes separated by commas
+
+void Ntf_DB_MarkNotifInCrsToUsrsAsRemoved (Ntf_NotifyEvent_t NotifyEvent,const char *SubQueryUsrs)
+  {
+   DB_QueryUPDATE ("can not set notification(s) as removed",
+		   "UPDATE ntf_notifications"
+		     " SET Status=(Status | %u)"
+		   " WHERE ToUsrCod IN (%s)"
+		     " AND NotifyEvent=%u"
+		     " AND CrsCod=%ld",
+		   (unsigned) Ntf_STATUS_BIT_REMOVED,
+		   SubQueryUsrs,
+		   (unsigned) NotifyEvent,
+		   Gbl.Hierarchy.Node[Hie_CRS].HieCod);
+  }
+
 /*****************************************************************************/
 /*********** Set possible notifications from a course as removed *************/
 /*****************************************************************************/
@@ -37,6 +37,11 @@
 void Ntf_DB_StoreNotifyEventToUsr (Ntf_NotifyEvent_t NotifyEvent,
                                    long ToUsrCod,long Cod,Ntf_Status_t Status,
                                    long HieCods[Hie_NUM_LEVELS]);
+void Ntf_DB_StoreNotifyEventToUsrs (Ntf_NotifyEvent_t NotifyEvent,
+                                    unsigned NumUsrs,
+                                    const long *ToUsrCods,long Cod,
+                                    const Ntf_Status_t *Status,
+                                    long HieCods[Hie_NUM_LEVELS]);
 void Ntf_DB_UpdateMyLastAccessToNotifications (void);
 void Ntf_DB_MarkAllMyNotifAsSeen (void);
 void Ntf_DB_MarkPendingNtfsAsSent (long ToUsrCod);
@@ -45,6 +50,7 @@ void Ntf_DB_MarkNotifAsSeenUsingCod (Ntf_NotifyEvent_t NotifyEvent,long Cod);
 void Ntf_DB_MarkNotifsInCrsAsSeen (Ntf_NotifyEvent_t NotifyEvent);
 void Ntf_DB_MarkNotifsAsSeen (Ntf_NotifyEvent_t NotifyEvent);
 void Ntf_DB_MarkNotifToOneUsrAsRemoved (Ntf_NotifyEvent_t NotifyEvent,long Cod,long ToUsrCod);
+void Ntf_DB_MarkNotifInCrsToUsrsAsRemoved (Ntf_NotifyEvent_t NotifyEvent,const char *SubQueryUsrs);
 void Ntf_DB_MarkNotifInCrsAsRemoved (long ToUsrCod,long HieCod);
 void Ntf_DB_MarkNotifAsRemoved (Ntf_NotifyEvent_t NotifyEvent,long Cod);
 void Ntf_DB_MarkNotifFilesInGroupAsRemoved (long GrpCod);
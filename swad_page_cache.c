@@ -0,0 +1,382 @@
+// swad_page_cache.c: cache of public pages shown to users not logged
+
+/*
+    SWAD (Shared Workspace At a Distance),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2026 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/********************************* Headers ***********************************/
+/*****************************************************************************/
+
+#define _GNU_SOURCE 		// For asprintf
+#include <linux/limits.h>	// For PATH_MAX
+#include <stdbool.h>		// For boolean type
+#include <stdio.h>		// For asprintf, fprintf
+#include <stdlib.h>		// For exit, free, getenv
+#include <string.h>		// For strstr
+#include <sys/stat.h>		// For stat
+#include <unistd.h>		// For unlink
+#include <utime.h>		// For utime
+#include <zlib.h>		// For gzopen, gzread, gzwrite...
+
+#include "swad_action.h"
+#include "swad_action_list.h"
+#include "swad_config.h"
+#include "swad_cryptography.h"
+#include "swad_database.h"
+#include "swad_date.h"
+#include "swad_error.h"
+#include "swad_file.h"
+#include "swad_firewall.h"
+#include "swad_firewall_database.h"
+#include "swad_global.h"
+#include "swad_log.h"
+#include "swad_page_cache.h"
+#include "swad_parameter.h"
+#include "swad_process.h"
+#include "swad_trace.h"
+
+/*****************************************************************************/
+/***************************** Private constants *****************************/
+/*****************************************************************************/
+
+#define PagCac_NUM_BYTES_PER_CHUNK 4096
+
+// Its modification time is the time of the last change in any cached page
+#define PagCac_FILE_MODIFIED Cfg_PATH_PAGE_CACHE_PRIVATE "/modified"
+
+// Tables whose data are shown in cached pages
+static const char *PagCac_Tables[] =
+  {
+   "cty_countrs",
+   "ins_instits",
+   "ctr_centers",
+   "deg_types",
+   "deg_degrees",
+   "crs_courses",
+   "crs_users",
+   "usr_admins",
+   "crs_info_src",
+   "crs_info_txt",
+   "crs_bibliography",
+   "tre_nodes",
+   "plc_places",
+   "dpt_departments",
+   "hld_holidays",
+  };
+#define PagCac_NUM_TABLES (sizeof (PagCac_Tables) / sizeof (PagCac_Tables[0]))
+
+/*****************************************************************************/
+/************** External global variables from others modules ****************/
+/*****************************************************************************/
+
+extern struct Globals Gbl;
+
+/*****************************************************************************/
+/************************* Private global variables **************************/
+/*****************************************************************************/
+
+static struct
+  {
+   Act_Action_t Action;		// Action of the page being cached (ActUnk if not cacheable)
+   bool Removed;		// Cached pages already removed in this request
+   char PathDir[PATH_MAX + 1];	// Directory with cached pages of current hierarchy node
+   char PathFile[PATH_MAX + 1];	// Compressed page
+  } PagCac_Page =
+  {
+   .Action = ActUnk,
+   .Removed = false,
+  };
+
+/*****************************************************************************/
+/***************************** Private prototypes ****************************/
+/*****************************************************************************/
+
+static bool PagCac_CheckIfActionIsCacheable (Act_Action_t Action);
+static void PagCac_SetPathDirOfCurrentNode (char PathDir[PATH_MAX + 1]);
+static Err_SuccessOrError_t PagCac_SendCachedPage (void);
+static time_t PagCac_GetTimeOfLastModification (void);
+
+/*****************************************************************************/
+/** Check if an action shows a public page, equal for all users not logged ***/
+/*****************************************************************************/
+
+static bool PagCac_CheckIfActionIsCacheable (Act_Action_t Action)
+  {
+   switch (Action)
+     {
+      case ActSeeCal:
+      case ActPrnCal:
+      case ActSeeCty:
+      case ActSeeCtyInf:
+      case ActSeeIns:
+      case ActSeeInsInf:
+      case ActSeeCtr:
+      case ActSeePlc:
+      case ActSeeDpt:
+      case ActSeeHld:
+      case ActSeeCtrInf:
+      case ActSeeDeg:
+      case ActSeeDegInf:
+      case ActSeeCrs:
+      case ActSeeCrsInf:
+      case ActSeeTchGui:
+      case ActSeeSyl:
+      case ActSeeBib:
+	 return true;
+      default:
+	 return false;
+     }
+  }
+
+/*****************************************************************************/
+/********* Get directory with cached pages of current hierarchy node *********/
+/*****************************************************************************/
+
+static void PagCac_SetPathDirOfCurrentNode (char PathDir[PATH_MAX + 1])
+  {
+   snprintf (PathDir,PATH_MAX + 1,"%s/%u_%ld",
+	     Cfg_PATH_PAGE_CACHE_PRIVATE,
+	     (unsigned) Gbl.Hierarchy.HieLvl,
+	     Gbl.Hierarchy.Node[Gbl.Hierarchy.HieLvl].HieCod);
+  }
+
+/*****************************************************************************/
+/**** If a user not logged requests a public page already cached, send it ****/
+/*****************************************************************************/
+
+// Called before checking user, so the rest of the request is avoided
+
+void PagCac_ServeCachedPageIfExists (void)
+  {
+   const char *QueryStr;
+   char *Key;
+   char KeyEncrypted[Cry_BYTES_ENCRYPTED_STR_SHA256_BASE64 + 1];
+   struct stat FileStatus;
+
+   /***** Only requests without session to public pages can be cached *****/
+   if (Gbl.Session.Status != Ses_NOT_OPEN ||
+       !PagCac_CheckIfActionIsCacheable (Gbl.Action.Act) ||
+       (QueryStr = Par_GetQueryStr ()) == NULL)
+      return;
+
+   /***** Build key from everything that can change the page *****/
+   if (asprintf (&Key,"%ld %u %ld %ld %ld %ld %ld %u %u %u %u %u %u %u %u %s",
+		 Act_GetActCod (Gbl.Action.Act),
+		 (unsigned) Gbl.Hierarchy.HieLvl,
+		 Gbl.Hierarchy.Node[Hie_CTY].HieCod,
+		 Gbl.Hierarchy.Node[Hie_INS].HieCod,
+		 Gbl.Hierarchy.Node[Hie_CTR].HieCod,
+		 Gbl.Hierarchy.Node[Hie_DEG].HieCod,
+		 Gbl.Hierarchy.Node[Hie_CRS].HieCod,
+		 (unsigned) Gbl.Prefs.Language,
+		 Gbl.Prefs.FirstDayOfWeek,
+		 (unsigned) Gbl.Prefs.DateFormat,
+		 (unsigned) Gbl.Prefs.IconSet,
+		 (unsigned) Gbl.Prefs.Menu,
+		 (unsigned) Gbl.Prefs.Theme,
+		 Gbl.Prefs.SideCols,
+		 (unsigned) Gbl.Prefs.PhotoShape,
+		 QueryStr) < 0)
+      Err_NotEnoughMemoryExit ();
+   Cry_EncryptSHA256Base64 (Key,KeyEncrypted);	// Base64 URL is valid for file names
+   free (Key);
+
+   /***** Set paths to cached page *****/
+   PagCac_SetPathDirOfCurrentNode (PagCac_Page.PathDir);
+   snprintf (PagCac_Page.PathFile,sizeof (PagCac_Page.PathFile),"%s/%s.gz",
+	     PagCac_Page.PathDir,KeyEncrypted);
+   PagCac_Page.Action = Gbl.Action.Act;	// Store page at the end if not cached
+
+   /***** Check if page is cached and not too old *****/
+   if (stat (PagCac_Page.PathFile,&FileStatus))	// Not cached
+      return;
+   if (FileStatus.st_mtime < Dat_GetStartExecutionTimeUTC () - Cfg_TIME_TO_KEEP_CACHED_PAGES)
+      return;	// Too old ==> generate it again
+   if (FileStatus.st_mtime <= PagCac_GetTimeOfLastModification ())
+      return;	// Data changed after caching it ==> generate it again
+
+   /***** Mitigate automatized attacks, as with pages not cached *****/
+   Fir_DB_LogAccess ();
+   Fir_CheckFirewallAndExitIfTooManyRequests ();
+
+   /***** Send cached page *****/
+   Dat_ComputeTimeToGeneratePage ();
+   if (PagCac_SendCachedPage () == Err_ERROR)
+      return;	// Probably removed meanwhile ==> generate it again
+   Dat_ComputeTimeToSendPage ();
+
+   /***** Log access, so it is counted in statistics *****/
+   Log_LogAccess (NULL);
+
+   /***** Page sent ==> exit *****/
+   DB_CloseDBConnection ();
+   Trc_WriteSpans ();
+   exit (0);
+  }
+
+/*****************************************************************************/
+/******************* Send a cached page to standard output *******************/
+/*****************************************************************************/
+
+static Err_SuccessOrError_t PagCac_SendCachedPage (void)
+  {
+   const char *AcceptEncoding = getenv ("HTTP_ACCEPT_ENCODING");
+   FILE *FileCached;
+   gzFile FileGz;
+   char Bytes[PagCac_NUM_BYTES_PER_CHUNK];
+   int NumBytesRead;
+
+   if (AcceptEncoding && strstr (AcceptEncoding,"gzip"))
+     {
+      /***** Browser accepts compressed content ==> send file as is *****/
+      if ((FileCached = fopen (PagCac_Page.PathFile,"rb")) == NULL)
+	 return Err_ERROR;
+      fprintf (stdout,"Content-type: text/html; charset=windows-1252\r\n"
+		      "Content-Encoding: gzip\r\n"
+		      "Vary: Accept-Encoding\r\n\r\n");
+      Fil_FastCopyOfOpenFiles (FileCached,stdout);
+      fclose (FileCached);
+     }
+   else
+     {
+      /***** Uncompress file *****/
+      if ((FileGz = gzopen (PagCac_Page.PathFile,"rb")) == NULL)
+	 return Err_ERROR;
+      fprintf (stdout,"Content-type: text/html; charset=windows-1252\r\n\r\n");
+      while ((NumBytesRead = gzread (FileGz,Bytes,sizeof (Bytes))) > 0)
+	 fwrite (Bytes,sizeof (Bytes[0]),(size_t) NumBytesRead,stdout);
+      gzclose (FileGz);
+     }
+
+   return Err_SUCCESS;
+  }
+
+/*****************************************************************************/
+/******** Store current page in cache if it is public and not cached *********/
+/*****************************************************************************/
+
+// FileOut holds the whole HTML content after the HTTP header and <!DOCTYPE html>
+
+void PagCac_StoreCurrentPage (FILE *FileOut)
+  {
+   char PathFileTmp[PATH_MAX + 1 + 32];
+   gzFile FileGz;
+   char Bytes[PagCac_NUM_BYTES_PER_CHUNK];
+   size_t NumBytesRead;
+   bool Error = false;
+
+   /***** Store only the page requested, if nothing changed while generating it *****/
+   if (PagCac_Page.Action == ActUnk ||
+       Gbl.Action.Act != PagCac_Page.Action ||
+       Gbl.Usrs.Me.Logged)
+      return;
+
+   /***** Don't store the page if data changed while generating it *****/
+   if (PagCac_GetTimeOfLastModification () >= Dat_GetStartExecutionTimeUTC ())
+      return;
+
+   /***** Create directories if not exist *****/
+   Fil_CreateDirIfNotExists (Cfg_PATH_PAGE_CACHE_PRIVATE);
+   Fil_CreateDirIfNotExists (PagCac_Page.PathDir);
+
+   /***** Write compressed page in a temporary file... *****/
+   snprintf (PathFileTmp,sizeof (PathFileTmp),"%s.%d.tmp",
+	     PagCac_Page.PathFile,(int) Prc_GetPID ());
+   if ((FileGz = gzopen (PathFileTmp,"wb6")) == NULL)
+      return;	// Cache must not disturb the request
+   if (gzputs (FileGz,"<!DOCTYPE html>\n") < 0)
+      Error = true;
+   rewind (FileOut);
+   while (!Error &&
+	  (NumBytesRead = fread (Bytes,sizeof (Bytes[0]),sizeof (Bytes),FileOut)))
+      if (gzwrite (FileGz,Bytes,(unsigned) NumBytesRead) == 0)
+	 Error = true;
+   if (gzclose (FileGz) != Z_OK)
+      Error = true;
+
+   /***** ...and replace cached page atomically *****/
+   if (Error || rename (PathFileTmp,PagCac_Page.PathFile))
+      unlink (PathFileTmp);
+  }
+
+/*****************************************************************************/
+/********* Remove cached pages if a query writes data shown in them **********/
+/*****************************************************************************/
+
+// Called for every query that writes in database.
+// Edits made from any node (for example a course edited from its degree)
+// are also detected, since only the tables written are checked
+
+void PagCac_RemoveCachedPagesIfQueryModifiesThem (const char *Query)
+  {
+   size_t NumTable;
+
+   if (PagCac_Page.Removed)	// Already removed in this request
+      return;
+
+   for (NumTable = 0;
+	NumTable < PagCac_NUM_TABLES;
+	NumTable++)
+      if (strstr (Query,PagCac_Tables[NumTable]))
+	{
+	 PagCac_RemoveCachedPages ();
+	 return;
+	}
+  }
+
+/*****************************************************************************/
+/************************** Remove all cached pages **************************/
+/*****************************************************************************/
+
+// Pages are not really removed, but marked as old,
+// so they are regenerated the next time they are requested
+
+void PagCac_RemoveCachedPages (void)
+  {
+   FILE *FileModified;
+
+   if (PagCac_Page.Removed)	// Already removed in this request
+      return;
+   PagCac_Page.Removed = true;
+
+   /***** Update modification time of file *****/
+   if (utime (PagCac_FILE_MODIFIED,NULL))	// Probably file does not exist
+     {
+      /* Create file */
+      Fil_CreateDirIfNotExists (Cfg_PATH_PAGE_CACHE_PRIVATE);
+      if ((FileModified = fopen (PagCac_FILE_MODIFIED,"wb")) != NULL)
+	 fclose (FileModified);
+     }
+  }
+
+/*****************************************************************************/
+/********* Get time of the last change in data shown in cached pages *********/
+/*****************************************************************************/
+
+static time_t PagCac_GetTimeOfLastModification (void)
+  {
+   struct stat FileStatus;
+
+   if (stat (PagCac_FILE_MODIFIED,&FileStatus))	// Never modified
+      return (time_t) 0;
+
+   return FileStatus.st_mtime;
+  }
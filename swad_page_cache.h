@@ -0,0 +1,41 @@
+// swad_page_cache.h: cache of public pages shown to users not logged
+
+#ifndef _SWAD_PAG_CAC
+#define _SWAD_PAG_CAC
+/*
+    SWAD (Shared Workspace At a Distance),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2026 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/********************************* Headers ***********************************/
+/*****************************************************************************/
+
+#include <stdio.h>		// For FILE
+
+/*****************************************************************************/
+/***************************** Public prototypes *****************************/
+/*****************************************************************************/
+
+void PagCac_ServeCachedPageIfExists (void);
+void PagCac_StoreCurrentPage (FILE *FileOut);
+void PagCac_RemoveCachedPagesIfQueryModifiesThem (const char *Query);
+void PagCac_RemoveCachedPages (void);
+
+#endif
@@ -216,6 +216,16 @@ Par_Method_t Par_GetMethod (void)
    return Par_Pars.Method;
   }
 
+/*****************************************************************************/
+/************* Get the query string (NULL if data were received) *************/
+/*****************************************************************************/
+
+const char *Par_GetQueryStr (void)
+  {
+   return Par_Pars.ContentReceivedByCGI == Act_NORM ? Par_Pars.QueryString :
+						      NULL;
+  }
+
 /*****************************************************************************/
 /**************************** Get boundary string ****************************/
 /*****************************************************************************/
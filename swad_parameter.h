@@ -71,6 +71,7 @@ Act_Content_t Par_GetContentReceivedByCGI (void);
 
 Err_SuccessOrError_t Par_GetQueryString (void);
 Par_Method_t Par_GetMethod (void);
+const char *Par_GetQueryStr (void);
 void Par_CreateListOfPars (void);
 void Par_FreePars (void);
 unsigned Par_GetPar (Par_ParamType_t ParType,const char *ParName,
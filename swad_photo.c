@@ -34,6 +34,7 @@
 #include <string.h>		// For string functions
 #include <sys/wait.h>		// For the macro WEXITSTATUS
 #include <unistd.h>		// For unlink
+#include <utime.h>		// For utime
 
 #include "swad_account.h"
 #include "swad_action.h"
@@ -42,6 +43,7 @@
 #include "swad_box.h"
 #include "swad_browser.h"
 #include "swad_config.h"
+#include "swad_cryptography.h"
 #include "swad_database.h"
 #include "swad_enrolment.h"
 #include "swad_error.h"
@@ -52,6 +54,7 @@
 #include "swad_hierarchy.h"
 #include "swad_hierarchy_type.h"
 #include "swad_HTML.h"
+#include "swad_image.h"
 #include "swad_logo.h"
 #include "swad_parameter.h"
 #include "swad_parameter_code.h"
@@ -63,6 +66,7 @@
 #include "swad_setting_database.h"
 #include "swad_statistic.h"
 #include "swad_theme.h"
+#include "swad_trace.h"
 #include "swad_user.h"
 
 /*****************************************************************************/
@@ -80,11 +84,9 @@ static const char *Pho_StrAvgPhotoDirs[Pho_NUM_AVERAGE_PHOTO_TYPES] =
    Cfg_FOLDER_DEGREE_PHOTO_MEDIAN,
    Cfg_FOLDER_DEGREE_PHOTO_AVERAGE,
   };
-static const char *Pho_StrAvgPhotoPrograms[Pho_NUM_AVERAGE_PHOTO_TYPES] =
-  {
-   Cfg_COMMAND_DEGREE_PHOTO_MEDIAN,
-   Cfg_COMMAND_DEGREE_PHOTO_AVERAGE,
-  };
+
+// Transparent 1x1 GIF used as source of images drawn from a sprite sheet
+#define Pho_TRANSPARENT_PIXEL "data:image/gif;base64,R0lGODlhAQABAIAAAAAAAP///yH5BAEAAAAALAAAAAABAAEAAAIBRAA7"
 
 /*****************************************************************************/
 /************************* Private global variables **************************/
@@ -113,15 +115,28 @@ static void Pho_ChangePhoto2 (void);
 
 static Exi_Exist_t Pho_CheckIfPrivPhotoExists (long UsrCod,
 					       char PathPrivRelPhoto[PATH_MAX + 1]);
+static void Pho_BuildPathThumbnail (long UsrCod,char PathThumbnail[PATH_MAX + 1]);
+static Err_SuccessOrError_t Pho_BuildThumbnail (long UsrCod);
+static void Pho_BuildHTMLUsrPhotoOrSprite (const struct Usr_Data *UsrDat,
+					   const char *PhotoURL,const char *SpriteStyle,
+					   const char *ClassPhoto,Pho_Zoom_t Zoom,
+					   char **ImgStr,
+					   char **CaptionStr);
+static void Pho_ShowUsrPhotoOrSprite (const struct Usr_Data *UsrDat,
+				      const char *PhotoURL,const char *SpriteStyle,
+				      const char *ClassPhoto,Pho_Zoom_t Zoom);
+static Err_SuccessOrError_t Pho_CreateClassPhotoSprite (Rol_Role_t Role,
+							const struct Pho_Sprite *Sprite,
+							const char PathSprite[PATH_MAX + 1]);
 
 static long Pho_GetDegWithAvgPhotoLeastRecentlyUpdated (void);
 static long Pho_GetTimeAvgPhotoWasComputed (long HieCod);
 static long Pho_GetTimeToComputeAvgPhoto (long HieCod);
-static void Pho_ComputeAveragePhoto (long HieCod,Usr_Sex_t Sex,Rol_Role_t Role,
-                                     Pho_AvgPhotoTypeOfAverage_t TypeOfAverage,
-                                     const char *DirAvgPhotosRelPath,
-                                     unsigned *NumStds,unsigned *NumStdsWithPhoto,
-                                     long *TimeToComputeAvgPhotoInMicroseconds);
+static void Pho_ComputeAveragePhotos (long HieCod,Rol_Role_t Role,
+                                      char DirAvgPhotosRelPath[Pho_NUM_AVERAGE_PHOTO_TYPES][PATH_MAX + 1],
+                                      unsigned NumStds[Usr_NUM_SEXS],
+                                      unsigned NumStdsWithPhoto[Usr_NUM_SEXS],
+                                      long *TimeToComputeAvgPhotoInMicroseconds);
 static void Pho_ShowOrPrintPhotoDegree (Pho_AvgPhotoSeeOrPrint_t SeeOrPrint);
 static void Pho_PutParsDegPhoto (void *DegPhotos);
 static void Pho_PutSelectorForTypeOfAvg (const struct Pho_DegPhotos *DegPhotos);
@@ -760,7 +775,9 @@ static Exi_Exist_t Pho_ReceivePhotoAndDetectFaces (Usr_MeOrOther_t MeOrOther,
    /***** Call to program that makes photo processing / face detection *****/
    snprintf (Command,sizeof (Command),Cfg_COMMAND_FACE_DETECTION,
 	     FileNamePhotoTmp);
+   Trc_BeginSpan ("system",Command);
    ReturnCode = system (Command);
+   Trc_EndSpan ();
    if (ReturnCode == -1)
       Err_ShowErrorAndExit ("Error when running command to process photo and detect faces.");
 
@@ -1148,6 +1165,37 @@ static Exi_Exist_t Pho_CheckIfPrivPhotoExists (long UsrCod,
    return Fil_CheckIfPathExists (PathPrivRelPhoto);
   }
 
+/*****************************************************************************/
+/**************** Build path to the thumbnail of a user's photo **************/
+/*****************************************************************************/
+
+static void Pho_BuildPathThumbnail (long UsrCod,char PathThumbnail[PATH_MAX + 1])
+  {
+   snprintf (PathThumbnail,PATH_MAX + 1,"%s/%02u/%ld_thumb.jpg",
+             Cfg_PATH_PHOTO_PRIVATE,(unsigned) (UsrCod % 100),UsrCod);
+  }
+
+/*****************************************************************************/
+/************ Build a fixed-size thumbnail from a user's photo ***************/
+/*****************************************************************************/
+// Thumbnails are used to build the sprite sheets of class photos
+
+static Err_SuccessOrError_t Pho_BuildThumbnail (long UsrCod)
+  {
+   char PathPrivRelPhoto[PATH_MAX + 1];
+   char PathThumbnail[PATH_MAX + 1];
+
+   /***** Check if photo exists *****/
+   if (Pho_CheckIfPrivPhotoExists (UsrCod,PathPrivRelPhoto) == Exi_DOES_NOT_EXIST)
+      return Err_ERROR;
+
+   /***** Resize photo to thumbnail *****/
+   Pho_BuildPathThumbnail (UsrCod,PathThumbnail);
+   return Img_ResizeImage (PathPrivRelPhoto,PathThumbnail,
+			   Pho_THUMBNAIL_WIDTH,Pho_THUMBNAIL_HEIGHT,
+			   Img_EXACT_SIZE,Pho_THUMBNAIL_QUALITY);
+  }
+
 /*****************************************************************************/
 /********************* Build HTML code for user's photo **********************/
 /*****************************************************************************/
@@ -1156,6 +1204,23 @@ void Pho_BuildHTMLUsrPhoto (const struct Usr_Data *UsrDat,const char *PhotoURL,
 			    const char *ClassPhoto,Pho_Zoom_t Zoom,
 			    char **ImgStr,
 			    char **CaptionStr)
+  {
+   Pho_BuildHTMLUsrPhotoOrSprite (UsrDat,PhotoURL,NULL,
+				  ClassPhoto,Zoom,
+				  ImgStr,CaptionStr);
+  }
+
+/*****************************************************************************/
+/***** Build HTML code for user's photo, drawn alone or from a sprite sheet **/
+/*****************************************************************************/
+// If SpriteStyle is not NULL, the image is drawn as a background
+// taken from a sprite sheet, and PhotoURL is used only for zoom
+
+static void Pho_BuildHTMLUsrPhotoOrSprite (const struct Usr_Data *UsrDat,
+					   const char *PhotoURL,const char *SpriteStyle,
+					   const char *ClassPhoto,Pho_Zoom_t Zoom,
+					   char **ImgStr,
+					   char **CaptionStr)
   {
    extern const char *Rol_Icons[Rol_NUM_ROLES];
    extern const char *Txt_Following;
@@ -1320,10 +1385,18 @@ void Pho_BuildHTMLUsrPhoto (const struct Usr_Data *UsrDat,const char *PhotoURL,
       switch (PhotoExists)
 	{
 	 case Exi_EXISTS:
-	    if (asprintf (ImgStr,"<img src=\"%s\" alt=\"\" title=\"%s\" class=\"%s\""
+	    if (asprintf (ImgStr,"<img src=\"%s\" alt=\"\" title=\"%s\" class=\"%s\"%s%s%s"
 				 " onmouseover=\"zoom(this,'%s','%s');\""
 				 " onmouseout=\"noZoom();\">",
-			  PhotoURL,UsrDat->FullName,ClassPhoto,
+			  SpriteStyle ? Pho_TRANSPARENT_PIXEL :
+					PhotoURL,
+			  UsrDat->FullName,ClassPhoto,
+			  SpriteStyle ? " style=\"" :
+					"",
+			  SpriteStyle ? SpriteStyle :
+					"",
+			  SpriteStyle ? "\"" :
+					"",
 			  PhotoURL,IdCaption) < 0)
 	       Err_NotEnoughMemoryExit ();
 	    break;
@@ -1341,8 +1414,16 @@ void Pho_BuildHTMLUsrPhoto (const struct Usr_Data *UsrDat,const char *PhotoURL,
       switch (PhotoExists)
 	{
 	 case Exi_EXISTS:
-	    if (asprintf (ImgStr,"<img src=\"%s\" alt=\"\" title=\"%s\" class=\"%s\">",
-			  PhotoURL,UsrDat->FullName,ClassPhoto) < 0)
+	    if (asprintf (ImgStr,"<img src=\"%s\" alt=\"\" title=\"%s\" class=\"%s\"%s%s%s>",
+			  SpriteStyle ? Pho_TRANSPARENT_PIXEL :
+					PhotoURL,
+			  UsrDat->FullName,ClassPhoto,
+			  SpriteStyle ? " style=\"" :
+					"",
+			  SpriteStyle ? SpriteStyle :
+					"",
+			  SpriteStyle ? "\"" :
+					"") < 0)
 	       Err_NotEnoughMemoryExit ();
 	    break;
 	 case Exi_DOES_NOT_EXIST:
@@ -1360,6 +1441,17 @@ void Pho_BuildHTMLUsrPhoto (const struct Usr_Data *UsrDat,const char *PhotoURL,
 
 void Pho_ShowUsrPhoto (const struct Usr_Data *UsrDat,const char *PhotoURL,
                        const char *ClassPhoto,Pho_Zoom_t Zoom)
+  {
+   Pho_ShowUsrPhotoOrSprite (UsrDat,PhotoURL,NULL,ClassPhoto,Zoom);
+  }
+
+/*****************************************************************************/
+/************ Show a user's photo, alone or from a sprite sheet **************/
+/*****************************************************************************/
+
+static void Pho_ShowUsrPhotoOrSprite (const struct Usr_Data *UsrDat,
+				      const char *PhotoURL,const char *SpriteStyle,
+				      const char *ClassPhoto,Pho_Zoom_t Zoom)
   {
    Act_BrowserTab_t BrowserTab = Act_GetBrowserTab (Gbl.Action.Act);
    bool BrowserTabIs1stTab = (BrowserTab == Act_1ST ||
@@ -1380,10 +1472,10 @@ void Pho_ShowUsrPhoto (const struct Usr_Data *UsrDat,const char *PhotoURL,
      }
 
    /***** Hidden div to pass user's name to Javascript *****/
-   Pho_BuildHTMLUsrPhoto (UsrDat,PhotoURL,
-			  ClassPhoto,Zoom,
-			  &CaptionStr,
-			  &ImgStr);
+   Pho_BuildHTMLUsrPhotoOrSprite (UsrDat,PhotoURL,SpriteStyle,
+				  ClassPhoto,Zoom,
+				  &CaptionStr,
+				  &ImgStr);
    HTM_Txt (CaptionStr);
    HTM_Txt (ImgStr);
    free (ImgStr);
@@ -1397,6 +1489,220 @@ void Pho_ShowUsrPhoto (const struct Usr_Data *UsrDat,const char *PhotoURL,
      }
   }
 
+/*****************************************************************************/
+/*********** Get or build the sprite sheet of a class photo ******************/
+/*****************************************************************************/
+// The sprite sheet contains the thumbnails of the users in list
+// whose photos can be seen by me. It is cached in a public file
+// whose name is a hash of users' codes and photo names, so it changes
+// when the members of the class or their photos change.
+// When sprite sheet can not be built, Sprite->URL is empty.
+
+void Pho_BuildClassPhotoSprite (Rol_Role_t Role,struct Pho_Sprite *Sprite)
+  {
+   struct Usr_Data UsrDat;
+   unsigned NumUsr;
+   unsigned NumPhotos = 0;
+   char *Key;
+   size_t Length = 0;
+   size_t MaxLength;
+   char SpriteName[Cry_BYTES_ENCRYPTED_STR_SHA256_BASE64 + 1];
+   char PathSprite[PATH_MAX + 1];
+
+   /***** Reset sprite *****/
+   Sprite->URL[0] = '\0';
+   Sprite->NumCols =
+   Sprite->NumRows = 0;
+   Sprite->NumPhoto = NULL;
+   if (!Gbl.Usrs.LstUsrs[Role].NumUsrs)
+      return;
+
+   /***** Allocate memory for positions and key *****/
+   if ((Sprite->NumPhoto = malloc ((size_t) Gbl.Usrs.LstUsrs[Role].NumUsrs *
+				   sizeof (*Sprite->NumPhoto))) == NULL)
+      Err_NotEnoughMemoryExit ();
+   MaxLength = (size_t) Gbl.Usrs.LstUsrs[Role].NumUsrs *
+	       (Cns_MAX_DIGITS_LONG + 1 + Cry_BYTES_ENCRYPTED_STR_SHA256_BASE64 + 1) +
+	       Cns_MAX_DIGITS_UINT * 2 + 2 + 1;
+   if ((Key = malloc (MaxLength)) == NULL)
+      Err_NotEnoughMemoryExit ();
+
+   /***** Key starts with thumbnail size, so sprites are rebuilt if it changes *****/
+   Length += (size_t) snprintf (Key,MaxLength,"%ux%u|",
+				Pho_THUMBNAIL_WIDTH,Pho_THUMBNAIL_HEIGHT);
+
+   /***** Get the users whose photos I can see *****/
+   Usr_UsrDataConstructor (&UsrDat);
+      for (NumUsr = 0;
+	   NumUsr < Gbl.Usrs.LstUsrs[Role].NumUsrs;
+	   NumUsr++)
+	{
+	 Usr_CopyBasicUsrDataFromList (&UsrDat,
+				       &Gbl.Usrs.LstUsrs[Role].Lst[NumUsr]);
+	 if (UsrDat.Photo[0] &&
+	     Pri_CheckIfICanView (UsrDat.PhotoVisibility,&UsrDat) == Usr_CAN)
+	   {
+	    Sprite->NumPhoto[NumUsr] = NumPhotos++;
+	    Length += (size_t) snprintf (&Key[Length],MaxLength - Length,"%ld:%s;",
+					 UsrDat.UsrCod,UsrDat.Photo);
+	   }
+	 else
+	    Sprite->NumPhoto[NumUsr] = Pho_NOT_IN_SPRITE;
+	}
+   Usr_UsrDataDestructor (&UsrDat);
+
+   if (NumPhotos)
+     {
+      /***** Compute size of the grid *****/
+      Sprite->NumCols = NumPhotos < Pho_SPRITE_MAX_COLS ? NumPhotos :
+							  Pho_SPRITE_MAX_COLS;
+      Sprite->NumRows = (NumPhotos + Sprite->NumCols - 1) / Sprite->NumCols;
+
+      /***** Build the name of the sprite sheet from the key *****/
+      Cry_EncryptSHA256Base64 (Key,SpriteName);
+      snprintf (PathSprite,sizeof (PathSprite),"%s/%s.jpg",
+		Cfg_PATH_PHOTO_SPRITE_PUBLIC,SpriteName);
+
+      /***** If the sprite sheet exists, update its time to prevent removing;
+             if not, create it *****/
+      if (utime (PathSprite,NULL) == 0 ||
+	  Pho_CreateClassPhotoSprite (Role,Sprite,PathSprite) == Err_SUCCESS)
+	 snprintf (Sprite->URL,sizeof (Sprite->URL),"%s/%s.jpg",
+		   Cfg_URL_PHOTO_SPRITE_PUBLIC,SpriteName);
+     }
+
+   free (Key);
+  }
+
+/*****************************************************************************/
+/******************* Create the sprite sheet of a class photo ****************/
+/*****************************************************************************/
+// Public links to photos are also created here, so they exist
+// while the sprite sheet exists, and they are used for zoom
+
+static Err_SuccessOrError_t Pho_CreateClassPhotoSprite (Rol_Role_t Role,
+							const struct Pho_Sprite *Sprite,
+							const char PathSprite[PATH_MAX + 1])
+  {
+   struct Usr_Data UsrDat;
+   unsigned NumUsr;
+   char PhotoURL[WWW_MAX_BYTES_WWW + 1];
+   char PathThumbnail[PATH_MAX + 1];
+   char PathSpriteTmp[PATH_MAX + 1];
+   Err_SuccessOrError_t SuccessOrError;
+
+   /***** Create directories if not exist *****/
+   Fil_CreateDirIfNotExists (Cfg_PATH_PHOTO_PUBLIC);
+   Fil_CreateDirIfNotExists (Cfg_PATH_PHOTO_SPRITE_PUBLIC);
+
+   /***** Begin sprite sheet *****/
+   if (Img_BeginSprite (Sprite->NumCols,Sprite->NumRows,
+			Pho_THUMBNAIL_WIDTH,Pho_THUMBNAIL_HEIGHT) == Err_ERROR)
+      return Err_ERROR;
+
+   /***** Draw thumbnails in sprite sheet *****/
+   Usr_UsrDataConstructor (&UsrDat);
+      for (NumUsr = 0;
+	   NumUsr < Gbl.Usrs.LstUsrs[Role].NumUsrs;
+	   NumUsr++)
+	 if (Sprite->NumPhoto[NumUsr] != Pho_NOT_IN_SPRITE)
+	   {
+	    Usr_CopyBasicUsrDataFromList (&UsrDat,
+					  &Gbl.Usrs.LstUsrs[Role].Lst[NumUsr]);
+
+	    /* Create public link to photo */
+	    Pho_BuildLinkToPhoto (&UsrDat,PhotoURL);
+
+	    /* Create thumbnail if not exists (photos uploaded before thumbnails) */
+	    Pho_BuildPathThumbnail (UsrDat.UsrCod,PathThumbnail);
+	    if (Fil_CheckIfPathExists (PathThumbnail) == Exi_DOES_NOT_EXIST)
+	       if (Pho_BuildThumbnail (UsrDat.UsrCod) == Err_ERROR)
+		  snprintf (PathThumbnail,sizeof (PathThumbnail),"%s/usr_bl.jpg",
+			    Cfg_PATH_ICON_PUBLIC);
+
+	    /* Draw thumbnail in its cell (a failed one is left blank) */
+	    Img_AddImageToSprite (PathThumbnail,Sprite->NumPhoto[NumUsr]);
+	   }
+   Usr_UsrDataDestructor (&UsrDat);
+
+   /***** Save sprite sheet in a temporary file and then rename it,
+          so no incomplete sprite sheet is ever served.
+          The temporary file is in the same directory as the sprite sheet,
+          so rename can not fail because of different file systems *****/
+   snprintf (PathSpriteTmp,sizeof (PathSpriteTmp),"%s/tmp_%s.jpg",
+	     Cfg_PATH_PHOTO_SPRITE_PUBLIC,Cry_GetUniqueNameEncrypted ());
+   SuccessOrError = Img_EndSprite (PathSpriteTmp,Pho_THUMBNAIL_QUALITY);
+   if (SuccessOrError == Err_SUCCESS)
+      if (rename (PathSpriteTmp,PathSprite))
+	 SuccessOrError = Err_ERROR;
+   if (SuccessOrError == Err_ERROR)
+      unlink (PathSpriteTmp);
+
+   return SuccessOrError;
+  }
+
+/*****************************************************************************/
+/*********************** Free the sprite of a class photo ********************/
+/*****************************************************************************/
+
+void Pho_FreeClassPhotoSprite (struct Pho_Sprite *Sprite)
+  {
+   if (Sprite->NumPhoto)
+     {
+      free (Sprite->NumPhoto);
+      Sprite->NumPhoto = NULL;
+     }
+  }
+
+/*****************************************************************************/
+/****************** Show a user's photo from a sprite sheet ******************/
+/*****************************************************************************/
+// NumUsr is the index of the user in the list used to build the sprite
+
+void Pho_ShowUsrPhotoInSprite (struct Usr_Data *UsrDat,
+			       const struct Pho_Sprite *Sprite,unsigned NumUsr,
+			       const char *ClassPhoto,Pho_Zoom_t Zoom)
+  {
+   unsigned NumPhoto;
+   char PhotoURL[WWW_MAX_BYTES_WWW + 1];
+   char *SpriteStyle;
+
+   /***** If no sprite sheet is available, show photo alone *****/
+   if (!Sprite->URL[0])
+     {
+      Pho_ShowUsrPhotoIfAllowed (UsrDat,ClassPhoto,Zoom);
+      return;
+     }
+
+   /***** If the photo is not in sprite sheet, show blank photo *****/
+   if ((NumPhoto = Sprite->NumPhoto[NumUsr]) == Pho_NOT_IN_SPRITE)
+     {
+      Pho_ShowUsrPhoto (UsrDat,NULL,ClassPhoto,Zoom);
+      return;
+     }
+
+   /***** Public link to photo was created when sprite sheet was created *****/
+   snprintf (PhotoURL,sizeof (PhotoURL),"%s/%s.jpg",
+	     Cfg_URL_PHOTO_PUBLIC,UsrDat->Photo);
+
+   /***** Position of the thumbnail in the sprite sheet, as percentages *****/
+   if (asprintf (&SpriteStyle,"background:url('%s') %.4f%% %.4f%%/%u%% %u%% no-repeat;",
+		 Sprite->URL,
+		 Sprite->NumCols > 1 ? (double) (NumPhoto % Sprite->NumCols) * 100.0 /
+				       (double) (Sprite->NumCols - 1) :
+				       0.0,
+		 Sprite->NumRows > 1 ? (double) (NumPhoto / Sprite->NumCols) * 100.0 /
+				       (double) (Sprite->NumRows - 1) :
+				       0.0,
+		 Sprite->NumCols * 100,
+		 Sprite->NumRows * 100) < 0)
+      Err_NotEnoughMemoryExit ();
+
+   Pho_ShowUsrPhotoOrSprite (UsrDat,PhotoURL,SpriteStyle,ClassPhoto,Zoom);
+
+   free (SpriteStyle);
+  }
+
 /*****************************************************************************/
 /************************** Remove a user's photo ****************************/
 /*****************************************************************************/
@@ -1428,6 +1734,12 @@ Err_SuccessOrError_t Pho_RemovePhoto (struct Usr_Data *UsrDat)
          if (unlink (PathPrivRelPhoto))                        		// Remove photo
             NumErrors++;
 
+      /***** Remove thumbnail *****/
+      Pho_BuildPathThumbnail (UsrDat->UsrCod,PathPrivRelPhoto);
+      if (Fil_CheckIfPathExists (PathPrivRelPhoto) == Exi_EXISTS)	// Thumbnail exists
+         if (unlink (PathPrivRelPhoto))					// Remove thumbnail
+            NumErrors++;
+
       /***** Remove original photo *****/
       snprintf (PathPrivRelPhoto,sizeof (PathPrivRelPhoto),
                 "%s/%02u/%ld_original.jpg",
@@ -1460,6 +1772,7 @@ Err_SuccessOrError_t Pho_RemovePhoto (struct Usr_Data *UsrDat)
 void Pho_UpdatePhotoName (struct Usr_Data *UsrDat)
   {
    char PathPublPhoto[PATH_MAX + 1];
+   char PhotoURL[WWW_MAX_BYTES_WWW + 1];
    const char *UniqueNameEncrypted = Cry_GetUniqueNameEncrypted ();
 
    /***** Update photo name in database *****/
@@ -1472,6 +1785,11 @@ void Pho_UpdatePhotoName (struct Usr_Data *UsrDat)
 
    /***** Update photo name in user's data *****/
    Str_Copy (UsrDat->Photo,UniqueNameEncrypted,sizeof (UsrDat->Photo) - 1);
+
+   /***** Create public link and thumbnail of the new photo,
+          so class photos do not have to do it when drawn *****/
+   Pho_BuildLinkToPhoto (UsrDat,PhotoURL);
+   Pho_BuildThumbnail (UsrDat->UsrCod);
   }
 
 /*****************************************************************************/
@@ -1575,10 +1893,11 @@ void Pho_CalcPhotoDegree (void)
    Pho_AvgPhotoTypeOfAverage_t TypeOfAverage;
    long HieCod = -1L;
    char DirAvgPhotosRelPath[Pho_NUM_AVERAGE_PHOTO_TYPES][PATH_MAX + 1];
-   unsigned NumStds;
-   unsigned NumStdsWithPhoto;
+   unsigned NumStds[Usr_NUM_SEXS];
+   unsigned NumStdsWithPhoto[Usr_NUM_SEXS];
    Usr_Sex_t Sex;
-   long TotalTimeToComputeAvgPhotoInMicroseconds,PartialTimeToComputeAvgPhotoInMicroseconds;
+   long TotalTimeToComputeAvgPhotoInMicroseconds;
+   long PartialTimeToComputeAvgPhotoInMicroseconds;
 
    /***** Create public directories for average photos if not exist *****/
    Fil_CreateDirIfNotExists (Cfg_PATH_PHOTO_PUBLIC);
@@ -1606,24 +1925,28 @@ void Pho_CalcPhotoDegree (void)
       /***** Get list of students in this degree *****/
       Usr_GetUnorderedStdsCodesInDeg (HieCod);
 
+      /***** Compute average and median photos of students belonging this degree,
+             for all sexs in a single pass *****/
+      Pho_ComputeAveragePhotos (HieCod,Rol_STD,DirAvgPhotosRelPath,
+				NumStds,NumStdsWithPhoto,
+				&TotalTimeToComputeAvgPhotoInMicroseconds);
+
+      /***** Store stats in database *****/
+      // The time is shared out among sexs, so that its sum is the total time
       for (Sex  = (Usr_Sex_t) 0;
 	   Sex <= (Usr_Sex_t) (Usr_NUM_SEXS - 1);
 	   Sex++)
 	{
-	 TotalTimeToComputeAvgPhotoInMicroseconds = 0;
-	 for (TypeOfAverage  = (Pho_AvgPhotoTypeOfAverage_t) 0;
-	      TypeOfAverage <= (Pho_AvgPhotoTypeOfAverage_t) (Pho_NUM_AVERAGE_PHOTO_TYPES - 1);
-	      TypeOfAverage++)
+	 if (TotalTimeToComputeAvgPhotoInMicroseconds < 0)
+	    PartialTimeToComputeAvgPhotoInMicroseconds = -1L;
+	 else
 	   {
-	    /***** Compute average photos of students belonging this degree *****/
-	    Pho_ComputeAveragePhoto (HieCod,Sex,Rol_STD,
-				     TypeOfAverage,DirAvgPhotosRelPath[TypeOfAverage],
-				     &NumStds,&NumStdsWithPhoto,&PartialTimeToComputeAvgPhotoInMicroseconds);
-	    TotalTimeToComputeAvgPhotoInMicroseconds += PartialTimeToComputeAvgPhotoInMicroseconds;
+	    PartialTimeToComputeAvgPhotoInMicroseconds = TotalTimeToComputeAvgPhotoInMicroseconds / Usr_NUM_SEXS;
+	    if (Sex == Usr_SEX_ALL)
+	       PartialTimeToComputeAvgPhotoInMicroseconds += TotalTimeToComputeAvgPhotoInMicroseconds % Usr_NUM_SEXS;
 	   }
-
-	 /***** Store stats in database *****/
-	 Pho_DB_UpdateDegStats (HieCod,Sex,NumStds,NumStdsWithPhoto,TotalTimeToComputeAvgPhotoInMicroseconds);
+	 Pho_DB_UpdateDegStats (HieCod,Sex,NumStds[Sex],NumStdsWithPhoto[Sex],
+				PartialTimeToComputeAvgPhotoInMicroseconds);
 	}
 
       /***** Free memory for students list *****/
@@ -1727,20 +2050,23 @@ static long Pho_GetTimeToComputeAvgPhoto (long HieCod)
   }
 
 /*****************************************************************************/
-/********************** Compute the average photo of a list ******************/
+/********* Compute the average and median photos of a list, by sex **********/
 /*****************************************************************************/
-// Returns number of users in list with photo
+// A single call to the external program computes median and average photos
+// of all sexs, decoding each photo only once
 
-static void Pho_ComputeAveragePhoto (long HieCod,Usr_Sex_t Sex,Rol_Role_t Role,
-                                     Pho_AvgPhotoTypeOfAverage_t TypeOfAverage,
-                                     const char *DirAvgPhotosRelPath,
-                                     unsigned *NumStds,unsigned *NumStdsWithPhoto,
-                                     long *TimeToComputeAvgPhotoInMicroseconds)
+static void Pho_ComputeAveragePhotos (long HieCod,Rol_Role_t Role,
+                                      char DirAvgPhotosRelPath[Pho_NUM_AVERAGE_PHOTO_TYPES][PATH_MAX + 1],
+                                      unsigned NumStds[Usr_NUM_SEXS],
+                                      unsigned NumStdsWithPhoto[Usr_NUM_SEXS],
+                                      long *TimeToComputeAvgPhotoInMicroseconds)
   {
    extern const char *Usr_StringsSexDB[Usr_NUM_SEXS];
+   Pho_AvgPhotoTypeOfAverage_t TypeOfAverage;
+   Usr_Sex_t Sex;
    unsigned NumUsr;
    char PathPrivRelPhoto[PATH_MAX + 1];	// Relative path to private photo, to calculate average face
-   char *PathRelAvgPhoto;
+   char PathRelAvgPhoto[PATH_MAX + 1];
    char *FileNamePhotoNames;
    FILE *FilePhotoNames = NULL;	// Initialized to avoid warning
    char StrCallToProgram[3 * (PATH_MAX + 1)];	// Call to photo processing program
@@ -1754,16 +2080,24 @@ static void Pho_ComputeAveragePhoto (long HieCod,Usr_Sex_t Sex,Rol_Role_t Role,
    gettimeofday (&tvStartComputingStat,&tz);
 
    /***** Reset number of students in this degree *****/
-   *NumStds = *NumStdsWithPhoto = 0;
-
-   /***** Build name for file with average photo *****/
-   if (asprintf (&PathRelAvgPhoto,"%s/%ld_%s.jpg",
-                 DirAvgPhotosRelPath,HieCod,Usr_StringsSexDB[Sex]) < 0)
-      Err_NotEnoughMemoryExit ();
-
-   /***** Remove old file if exists *****/
-   if (Fil_CheckIfPathExists (PathRelAvgPhoto) == Exi_EXISTS)  // If file exists
-      unlink (PathRelAvgPhoto);
+   for (Sex  = (Usr_Sex_t) 0;
+	Sex <= (Usr_Sex_t) (Usr_NUM_SEXS - 1);
+	Sex++)
+      NumStds[Sex] = NumStdsWithPhoto[Sex] = 0;
+
+   /***** Remove old files if exist *****/
+   for (TypeOfAverage  = (Pho_AvgPhotoTypeOfAverage_t) 0;
+	TypeOfAverage <= (Pho_AvgPhotoTypeOfAverage_t) (Pho_NUM_AVERAGE_PHOTO_TYPES - 1);
+	TypeOfAverage++)
+      for (Sex  = (Usr_Sex_t) 0;
+	   Sex <= (Usr_Sex_t) (Usr_NUM_SEXS - 1);
+	   Sex++)
+	{
+	 snprintf (PathRelAvgPhoto,sizeof (PathRelAvgPhoto),"%s/%ld_%s.jpg",
+		   DirAvgPhotosRelPath[TypeOfAverage],HieCod,Usr_StringsSexDB[Sex]);
+	 if (Fil_CheckIfPathExists (PathRelAvgPhoto) == Exi_EXISTS)  // If file exists
+	    unlink (PathRelAvgPhoto);
+	}
 
    /***** Build names for text file with photo paths *****/
    if (asprintf (&FileNamePhotoNames,"%s/%ld.txt",
@@ -1772,35 +2106,39 @@ static void Pho_ComputeAveragePhoto (long HieCod,Usr_Sex_t Sex,Rol_Role_t Role,
    if ((FilePhotoNames = fopen (FileNamePhotoNames,"wb")) == NULL)
       Err_ShowErrorAndExit ("Can not open file to compute average photo.");
 
-   /***** Loop writing file names in text file *****/
+   /***** Loop writing sexs and file names in text file *****/
    for (NumUsr = 0;
 	NumUsr < Gbl.Usrs.LstUsrs[Role].NumUsrs;
 	NumUsr++)
      {
-      Gbl.Usrs.Other.UsrDat.Sex = Gbl.Usrs.LstUsrs[Role].Lst[NumUsr].Sex;
-      if (Sex == Usr_SEX_ALL || Sex == Gbl.Usrs.Other.UsrDat.Sex)
+      Sex = Gbl.Usrs.LstUsrs[Role].Lst[NumUsr].Sex;
+      if (Sex == Usr_SEX_ALL)	// Should not happen
+	 Sex = Usr_SEX_UNKNOWN;
+      NumStds[Sex]++;
+      NumStds[Usr_SEX_ALL]++;
+
+      /***** Add photo to file for average face calculation *****/
+      if (Pho_CheckIfPrivPhotoExists (Gbl.Usrs.LstUsrs[Role].Lst[NumUsr].UsrCod,
+				      PathPrivRelPhoto) == Exi_EXISTS)
 	{
-	 (*NumStds)++;
-
-	 /***** Add photo to file for average face calculation *****/
-	 Gbl.Usrs.Other.UsrDat.UsrCod = Gbl.Usrs.LstUsrs[Role].Lst[NumUsr].UsrCod;
-	 if (Pho_CheckIfPrivPhotoExists (Gbl.Usrs.Other.UsrDat.UsrCod,
-					 PathPrivRelPhoto) == Exi_EXISTS)
-	   {
-	    (*NumStdsWithPhoto)++;
-	    fprintf (FilePhotoNames,"%s\n",PathPrivRelPhoto);
-	   }
+	 NumStdsWithPhoto[Sex]++;
+	 NumStdsWithPhoto[Usr_SEX_ALL]++;
+	 fprintf (FilePhotoNames,"%s %s\n",Usr_StringsSexDB[Sex],PathPrivRelPhoto);
 	}
      }
    fclose (FilePhotoNames);
 
-   /***** Call to program to calculate average photo *****/
-   if (*NumStdsWithPhoto)
+   /***** Call to program to calculate median and average photos *****/
+   if (NumStdsWithPhoto[Usr_SEX_ALL])
      {
-      snprintf (StrCallToProgram,sizeof (StrCallToProgram),"%s %s %s",
-	        Pho_StrAvgPhotoPrograms[TypeOfAverage],
-	        FileNamePhotoNames,PathRelAvgPhoto);
+      snprintf (StrCallToProgram,sizeof (StrCallToProgram),"%s %s %s/%ld %s/%ld",
+	        Cfg_COMMAND_DEGREE_PHOTO_MEDIAN_AVERAGE,
+	        FileNamePhotoNames,
+	        DirAvgPhotosRelPath[Pho_PHOTO_MEDIAN_ALL ],HieCod,
+	        DirAvgPhotosRelPath[Pho_PHOTO_AVERAGE_ALL],HieCod);
+      Trc_BeginSpan ("system",StrCallToProgram);
       ReturnCode = system (StrCallToProgram);
+      Trc_EndSpan ();
       if (ReturnCode == -1)
 	 Err_ShowErrorAndExit ("Error when running program that computes the average photo.");
 
@@ -1809,7 +2147,6 @@ static void Pho_ComputeAveragePhoto (long HieCod,Usr_Sex_t Sex,Rol_Role_t Role,
 	 Err_ShowErrorAndExit ("The average photo has not been computed successfully.");
      }
 
-   free (PathRelAvgPhoto);
    free (FileNamePhotoNames);
 
    /***** Time used to compute the stats of this degree *****/
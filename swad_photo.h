@@ -66,6 +66,12 @@ void Pho_BuildHTMLUsrPhoto (const struct Usr_Data *UsrDat,const char *PhotoURL,
 void Pho_ShowUsrPhoto (const struct Usr_Data *UsrDat,const char *PhotoURL,
                        const char *ClassPhoto,Pho_Zoom_t Zoom);
 
+void Pho_BuildClassPhotoSprite (Rol_Role_t Role,struct Pho_Sprite *Sprite);
+void Pho_FreeClassPhotoSprite (struct Pho_Sprite *Sprite);
+void Pho_ShowUsrPhotoInSprite (struct Usr_Data *UsrDat,
+			       const struct Pho_Sprite *Sprite,unsigned NumUsr,
+			       const char *ClassPhoto,Pho_Zoom_t Zoom);
+
 Err_SuccessOrError_t Pho_RemovePhoto (struct Usr_Data *UsrDat);
 void Pho_UpdatePhotoName (struct Usr_Data *UsrDat);
 
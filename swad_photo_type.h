@@ -24,6 +24,12 @@
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+/*****************************************************************************/
+/********************************* Headers ***********************************/
+/*****************************************************************************/
+
+#include "swad_www.h"
+
 /*****************************************************************************/
 /************************* Public types and constants ************************/
 /*****************************************************************************/
@@ -31,6 +37,23 @@
 #define Pho_PHOTO_REAL_WIDTH		186
 #define Pho_PHOTO_REAL_HEIGHT		248
 
+/***** Thumbnails and sprite sheets for class photos *****/
+#define Pho_THUMBNAIL_WIDTH		 90	// Twice the biggest size in class photos,
+#define Pho_THUMBNAIL_HEIGHT		120	// to look sharp on high density screens
+#define Pho_THUMBNAIL_QUALITY		 85	// 1 to 100
+
+#define Pho_SPRITE_MAX_COLS		 20	// Maximum number of thumbnails in each row of a sprite sheet
+#define Pho_NOT_IN_SPRITE		((unsigned) -1)
+
+struct Pho_Sprite
+  {
+   char URL[WWW_MAX_BYTES_WWW + 1];	// Empty if no sprite sheet is available
+   unsigned NumCols;
+   unsigned NumRows;
+   unsigned *NumPhoto;			// Position in sprite sheet of each user in list,
+					// or Pho_NOT_IN_SPRITE if his/her photo is not shown
+  };
+
 /***** Zoom? *****/
 typedef enum
   {
@@ -27,8 +27,11 @@
 
 #define _GNU_SOURCE 		// For asprintf
 #include <stdio.h>		// For asprintf
-#include <stdlib.h>		// For free
+#include <stdlib.h>		// For free, rand
 #include <string.h>		// For string functions
+#include <sys/random.h>		// For getrandom
+#include <time.h>		// For time
+#include <unistd.h>		// For getpid
 
 #include "swad_action_list.h"
 #include "swad_alert.h"
@@ -3177,3 +3180,86 @@ double Qst_ComputeGrade (unsigned NumQsts,double Score,double MaxGrade)
 
    return Grade;
   }
+
+/*****************************************************************************/
+/********************* Get a new seed to draw questions **********************/
+/*****************************************************************************/
+
+unsigned long long Qst_GetNewRandomSeed (void)
+  {
+   unsigned long long Seed;
+
+   /***** Get seed from kernel random source.
+          rand() is not used alone because it is seeded with the start time,
+          so several prints created in the same second would be equal *****/
+   if (getrandom (&Seed,sizeof (Seed),GRND_NONBLOCK) != (ssize_t) sizeof (Seed))
+      Seed = ((unsigned long long) time (NULL) << 32) ^
+	     ((unsigned long long) getpid () << 16) ^
+	      (unsigned long long) rand ();
+
+   return Seed;
+  }
+
+/*****************************************************************************/
+/*********** Get initial state of generator from a seed and a code ***********/
+/*****************************************************************************/
+
+// The same seed gives different sequences for different codes (i.e. sets)
+
+unsigned long long Qst_GetRandomStateFromSeed (unsigned long long Seed,long Cod)
+  {
+   return Seed ^ ((unsigned long long) Cod * 0xD6E8FEB86659FD93ULL);
+  }
+
+/*****************************************************************************/
+/**************** Get a pseudorandom number in [0,NumValues) *****************/
+/*****************************************************************************/
+
+// SplitMix64 generator: given the same initial state,
+// it always gives the same sequence on any platform
+
+unsigned Qst_GetRandomNumber (unsigned long long *State,unsigned NumValues)
+  {
+   unsigned long long z;
+
+   z = (*State += 0x9E3779B97F4A7C15ULL);
+   z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+   z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+   z ^= z >> 31;
+
+   /***** Scale upper 32 bits to range without modulo *****/
+   return (unsigned) (((z >> 32) * (unsigned long long) NumValues) >> 32);
+  }
+
+/*****************************************************************************/
+/*********************** Draw a random sample of rows ************************/
+/*****************************************************************************/
+
+// Partial Fisher-Yates shuffle of indexes 0...NumRows-1:
+// on return, the first NumToDraw indexes are the sample, in random order.
+// Indexes must have room for NumRows elements.
+
+void Qst_DrawRandomSample (unsigned long long *State,
+                           unsigned *Indexes,unsigned NumRows,unsigned NumToDraw)
+  {
+   unsigned i;
+   unsigned j;
+   unsigned Tmp;
+
+   for (i = 0;
+	i < NumRows;
+	i++)
+      Indexes[i] = i;
+
+   if (NumToDraw > NumRows)
+      NumToDraw = NumRows;
+   for (i = 0;
+	i < NumToDraw;
+	i++)
+     {
+      j = i + Qst_GetRandomNumber (State,NumRows - i);
+      Tmp        = Indexes[i];
+      Indexes[i] = Indexes[j];
+      Indexes[j] = Tmp;
+     }
+  }
@@ -190,4 +190,10 @@ void Qst_ComputeAnswerScore (const char *Table,
 void Qst_ComputeAndShowGrade (unsigned NumQsts,double Score,double MaxGrade);
 double Qst_ComputeGrade (unsigned NumQsts,double Score,double MaxGrade);
 
+unsigned long long Qst_GetNewRandomSeed (void);
+unsigned long long Qst_GetRandomStateFromSeed (unsigned long long Seed,long Cod);
+unsigned Qst_GetRandomNumber (unsigned long long *State,unsigned NumValues);
+void Qst_DrawRandomSample (unsigned long long *State,
+                           unsigned *Indexes,unsigned NumRows,unsigned NumToDraw);
+
 #endif
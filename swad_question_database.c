@@ -25,6 +25,9 @@
 /*********************************** Headers *********************************/
 /*****************************************************************************/
 
+#define _GNU_SOURCE 		// For asprintf
+#include <stdio.h>		// For asprintf
+#include <stdlib.h>		// For free
 #include <string.h>		// For string functions
 
 #include "swad_alert.h"
@@ -192,20 +195,15 @@ void Qst_DB_CreateIntAnswer (const struct Qst_Question *Qst)
 
 void Qst_DB_CreateFltAnswer (const struct Qst_Question *Qst)
   {
-   unsigned i;
-
    Str_SetDecimalPointToUS ();		// To print the floating point as a dot
-   for (i = 0;
-	i < 2;
-	i++)
-      DB_QueryINSERT ("can not create answer",
-		      "INSERT INTO tst_answers"
-		      " (QstCod,AnsInd,Answer,Feedback,MedCod,Correct)"
-		      " VALUES"
-		      " (%ld,%u,'%.15lg','',-1,'Y')",
-		      Qst->QstCod,
-		      i,
-		      Qst->Answer.FloatingPoint[i]);
+   DB_QueryINSERT ("can not create answer",
+		   "INSERT INTO tst_answers"
+		   " (QstCod,AnsInd,Answer,Feedback,MedCod,Correct)"
+		   " VALUES"
+		   " (%ld,0,'%.15lg','',-1,'Y'),"
+		   "(%ld,1,'%.15lg','',-1,'Y')",
+		   Qst->QstCod,Qst->Answer.FloatingPoint[0],
+		   Qst->QstCod,Qst->Answer.FloatingPoint[1]);
    Str_SetDecimalPointToLocal ();	// Return to local system
   }
 
@@ -226,36 +224,57 @@ void Qst_DB_CreateTF_Answer (const struct Qst_Question *Qst)
   }
 
 /*****************************************************************************/
-/***************************** Create T/F answer *****************************/
+/************************** Create choice answers ****************************/
 /*****************************************************************************/
 
 void Qst_DB_CreateChoAnswer (struct Qst_Question *Qst)
   {
    extern const char Qst_Correct_YN[Qst_NUM_WRONG_CORRECT];
    unsigned NumOpt;
+   char *Values = NULL;
+   char *NewValues;
 
+   /***** Build list of rows, one for each option with text or media *****/
    for (NumOpt = 0;
 	NumOpt < Qst->Answer.NumOpts;
 	NumOpt++)
       if (Qst->Answer.Options[NumOpt].Text[0] ||			// Text
 	  Qst->Answer.Options[NumOpt].Media.Type != Med_TYPE_NONE)	// or media
 	{
-	 DB_QueryINSERT ("can not create answer",
-			 "INSERT INTO tst_answers"
-			 " (QstCod,AnsInd,Answer,Feedback,MedCod,Correct)"
-			 " VALUES"
-			 " (%ld,%u,'%s','%s',%ld,'%c')",
-			 Qst->QstCod,NumOpt,
-			 Qst->Answer.Options[NumOpt].Text,
-			 Qst->Answer.Options[NumOpt].Feedback ? Qst->Answer.Options[NumOpt].Feedback :
-								     "",
-			 Qst->Answer.Options[NumOpt].Media.MedCod,
-			 Qst_Correct_YN[Qst->Answer.Options[NumOpt].Correct]);
-
-	 /* Update image status */
+	 if (asprintf (&NewValues,"%s%s(%ld,%u,'%s','%s',%ld,'%c')",
+		       Values ? Values :
+				"",
+		       Values ? "," :
+				"",
+		       Qst->QstCod,NumOpt,
+		       Qst->Answer.Options[NumOpt].Text,
+		       Qst->Answer.Options[NumOpt].Feedback ? Qst->Answer.Options[NumOpt].Feedback :
+							      "",
+		       Qst->Answer.Options[NumOpt].Media.MedCod,
+		       Qst_Correct_YN[Qst->Answer.Options[NumOpt].Correct]) < 0)
+	    Err_NotEnoughMemoryExit ();
+	 free (Values);
+	 Values = NewValues;
+	}
+
+   if (Values)
+     {
+      /***** Insert all answers with one query *****/
+      DB_QueryINSERT ("can not create answers",
+		      "INSERT INTO tst_answers"
+		      " (QstCod,AnsInd,Answer,Feedback,MedCod,Correct)"
+		      " VALUES"
+		      " %s",
+		      Values);
+      free (Values);
+
+      /***** Update image status *****/
+      for (NumOpt = 0;
+	   NumOpt < Qst->Answer.NumOpts;
+	   NumOpt++)
 	 if (Qst->Answer.Options[NumOpt].Media.Type != Med_TYPE_NONE)
 	    Qst->Answer.Options[NumOpt].Media.Status = Med_STORED_IN_DB;
-	}
+     }
   }
 
 /*****************************************************************************/
@@ -408,7 +427,6 @@ unsigned Qst_DB_GetQstsForNewTestPrint (MYSQL_RES **mysql_res,
    char LongStr[Cns_MAX_DIGITS_LONG + 1];
    char UnsignedStr[Cns_MAX_DIGITS_UINT + 1];
    Qst_AnswerType_t AnswerType;
-   char StrNumQsts[Cns_MAX_DIGITS_UINT + 1];
 
    /***** Allocate space for query *****/
    if ((Query = malloc (Qst_MAX_BYTES_QUERY_QUESTIONS + 1)) == NULL)
@@ -486,10 +504,10 @@ unsigned Qst_DB_GetQstsForNewTestPrint (MYSQL_RES **mysql_res,
       Str_Concat (Query,")",Qst_MAX_BYTES_QUERY_QUESTIONS);
      }
 
-   /* End query */
-   Str_Concat (Query," ORDER BY RAND() LIMIT ",Qst_MAX_BYTES_QUERY_QUESTIONS);
-   snprintf (StrNumQsts,sizeof (StrNumQsts),"%u",Qsts->NumQsts);
-   Str_Concat (Query,StrNumQsts,Qst_MAX_BYTES_QUERY_QUESTIONS);
+   /* End query.
+      All candidate questions are got, and the sample is drawn
+      in Tst_GetQuestionsForNewTest, to avoid sorting them by RAND() */
+   Str_Concat (Query," ORDER BY tst_questions.QstCod",Qst_MAX_BYTES_QUERY_QUESTIONS);
 /*
    if (Gbl.Usrs.Me.Roles.LoggedRole == Rol_SYS_ADM)
       Lay_ShowAlert (Lay_INFO,Query);
@@ -63,7 +63,7 @@ static void QstImp_GetAndWriteTagsXML (long QstCod,FILE *FileXML);
 static void QstImp_WriteAnswersOfAQstXML (const struct Qst_Question *Qst,
                                           FILE *FileXML);
 static void QstImp_ReadQuestionsFromXMLFileAndStoreInDB (const char *FileNameXML);
-static void QstImp_ImportQuestionsFromXMLBuffer (const char *XMLBuffer);
+static void QstImp_ImportQuestionsFromXMLBuffer (char *XMLBuffer);
 static Qst_AnswerType_t QstImp_ConvertFromStrAnsTypXMLToAnsTyp (const char *StrAnsTypeXML);
 static void QstImp_GetAnswerFromXML (struct XMLElement *AnswerElem,
                                      struct Qst_Question *Qst);
@@ -476,12 +476,12 @@ static void QstImp_ReadQuestionsFromXMLFileAndStoreInDB (const char *FileNameXML
 /******************** Import questions from XML buffer ***********************/
 /*****************************************************************************/
 
-static void QstImp_ImportQuestionsFromXMLBuffer (const char *XMLBuffer)
+static void QstImp_ImportQuestionsFromXMLBuffer (char *XMLBuffer)
   {
    extern const char *Hlp_ASSESSMENT_Tests;
    extern const char *Txt_XML_file_content;
    extern const char *Txt_Imported_questions;
-   struct XMLElement *RootElem;
+   struct XMLTree Tree;
    struct XMLElement *TestElem = NULL;
    struct XMLElement *QuestionElem;
    struct XMLElement *TagsElem;
@@ -493,9 +493,11 @@ static void QstImp_ImportQuestionsFromXMLBuffer (const char *XMLBuffer)
    struct Qst_Question Qst;
    Exi_Exist_t QstExists;
    Err_SuccessOrError_t AnswerTypeFound;
+   unsigned NumNewQsts = 0;
 
    /***** Allocate and get XML tree *****/
-   XML_GetTree (XMLBuffer,&RootElem);
+   // XML buffer is modified and it must not be freed before the tree
+   XML_GetTree (XMLBuffer,&Tree);
 
    /***** Begin box *****/
    Box_BoxBegin (Txt_Imported_questions,NULL,NULL,
@@ -506,15 +508,15 @@ static void QstImp_ImportQuestionsFromXMLBuffer (const char *XMLBuffer)
 	 HTM_TEXTAREA_Begin (HTM_DISABLED,
 			     "title=\"%s\" cols=\"60\" rows=\"5\""
 			     " spellcheck=\"false\"",Txt_XML_file_content);
-	    XML_PrintTree (RootElem);
+	    XML_PrintTree (Tree.Root);
 	 HTM_TEXTAREA_End ();
       HTM_DIV_End ();
 
       /***** Get questions from XML tree and print them *****/
       /* Go to <test> element */
-      if (RootElem->FirstChild)
+      if (Tree.Root->FirstChild)
 	{
-	 TestElem = RootElem->FirstChild;
+	 TestElem = Tree.Root->FirstChild;
 	 if (strcmp (TestElem->TagName,"test"))	// <test> must be at level 1
 	    TestElem = NULL;
 	}
@@ -647,12 +649,18 @@ static void QstImp_ImportQuestionsFromXMLBuffer (const char *XMLBuffer)
 							  &Qst,QstExists);
 
 			      /***** If a new question ==> insert question, tags and answer in the database *****/
+			      // Tags and answers are inserted with one query each.
+			      // New questions do not leave unused tags,
+			      // so unused tags are removed only once at the end
 			      if (QstExists == Exi_DOES_NOT_EXIST)
 				{
 				 Qst.QstCod = -1L;
-				 Qst_InsertOrUpdateQstTagsAnsIntoDB (&Qst);
+				 Qst_InsertOrUpdateQstIntoDB (&Qst);
 				 if (Qst.QstCod <= 0)
 				    Err_ShowErrorAndExit ("Can not create question.");
+				 Tag_InsertTagsIntoDB (Qst.QstCod,&Qst.Tags);
+				 Qst_InsertAnswersIntoDB (&Qst);
+				 NumNewQsts++;
 				}
 			     }
 			   break;
@@ -668,6 +676,10 @@ static void QstImp_ImportQuestionsFromXMLBuffer (const char *XMLBuffer)
 	      }
 
 	 HTM_TABLE_End ();
+
+	 /***** Remove unused tags in current course *****/
+	 if (NumNewQsts)
+	    Tag_DB_RemoveUnusedTagsFromCrs (Gbl.Hierarchy.Node[Hie_CRS].HieCod);
 	}
       else	// TestElem not found
 	 Ale_ShowAlert (Ale_ERROR,"Root element &lt;test&gt; not found.");
@@ -676,7 +688,7 @@ static void QstImp_ImportQuestionsFromXMLBuffer (const char *XMLBuffer)
    Box_BoxEnd ();
 
    /***** Free XML tree *****/
-   XML_FreeTree (RootElem);
+   XML_FreeTree (&Tree);
   }
 
 /*****************************************************************************/
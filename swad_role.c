@@ -27,7 +27,7 @@
 
 #include "swad_action_list.h"
 #include "swad_admin_database.h"
-#include "swad_connected_database.h"
+#include "swad_connected.h"
 #include "swad_database.h"
 #include "swad_form.h"
 #include "swad_global.h"
@@ -499,7 +499,7 @@ void Rol_ChangeMyRole (void)
 	 Ses_DB_UpdateSession ();
 
 	 /* ...and update logged role in list of connected */
-	 Con_DB_UpdateMeInConnectedList ();
+	 Con_UpdateMeInConnectedList ();
 	}
      }
   }
@@ -500,7 +500,8 @@ static unsigned Sch_SearchCountrsInDB (Hie_Level_t HieLvl,const char *RangeQuery
 	 snprintf (FldName,sizeof (FldName),"Name_%s",
 		   Lan_STR_LANG_ID[Gbl.Prefs.Language]);
 	 if (Sch_BuildSearchQuery (SearchQuery,Sch_GetSearch (),
-	                           FldName,NULL,NULL) == Err_SUCCESS)
+	                           FldName,NULL,NULL,
+				   SchIdx_NONE) == Err_SUCCESS)
 	   {
 	    /***** Query database and list countries found *****/
 	    NumCtys = Cty_DB_SearchCtys (&mysql_res,SearchQuery,RangeQuery);
@@ -532,7 +533,8 @@ static unsigned Sch_SearchInstitsInDB (Hie_Level_t HieLvl,const char *RangeQuery
       if (Sch_CheckIfICanSearch (Sch_SEARCH_INSTITS) == Usr_CAN)
 	 /***** Split institutions string into words *****/
 	 if (Sch_BuildSearchQuery (SearchQuery,Sch_GetSearch (),
-	                           "ins_instits.FullName",NULL,NULL) == Err_SUCCESS)
+	                           "ins_instits.FullName",NULL,NULL,
+				   SchIdx_INS) == Err_SUCCESS)
 	   {
 	    /***** Query database and list institutions found *****/
 	    NumInss = Ins_DB_SearchInss (&mysql_res,SearchQuery,RangeQuery);
@@ -561,7 +563,8 @@ static unsigned Sch_SearchCentersInDB (Hie_Level_t HieLvl,const char *RangeQuery
       if (Sch_CheckIfICanSearch (Sch_SEARCH_CENTERS) == Usr_CAN)
 	 /***** Split center string into words *****/
 	 if (Sch_BuildSearchQuery (SearchQuery,Sch_GetSearch (),
-	                           "ctr_centers.FullName",NULL,NULL) == Err_SUCCESS)
+	                           "ctr_centers.FullName",NULL,NULL,
+				   SchIdx_CTR) == Err_SUCCESS)
 	   {
 	    /***** Query database and list centers found *****/
 	    NumCtrs = Ctr_DB_SearchCtrs (&mysql_res,SearchQuery,RangeQuery);
@@ -589,7 +592,8 @@ static unsigned Sch_SearchDegreesInDB (Hie_Level_t HieLvl,const char *RangeQuery
       if (Sch_CheckIfICanSearch (Sch_SEARCH_DEGREES) == Usr_CAN)
 	 /***** Split degree string into words *****/
 	 if (Sch_BuildSearchQuery (SearchQuery,Sch_GetSearch (),
-	                           "deg_degrees.FullName",NULL,NULL) == Err_SUCCESS)
+	                           "deg_degrees.FullName",NULL,NULL,
+				   SchIdx_DEG) == Err_SUCCESS)
 	   {
 	    /***** Query database and list degrees found *****/
 	    NumDegs = Deg_DB_SearchDegs (&mysql_res,SearchQuery,RangeQuery);
@@ -615,7 +619,8 @@ static unsigned Sch_SearchCoursesInDB (const char *RangeQuery)
    if (Sch_CheckIfICanSearch (Sch_SEARCH_COURSES) == Usr_CAN)
       /***** Split course string into words *****/
       if (Sch_BuildSearchQuery (SearchQuery,Sch_GetSearch (),
-                                "crs_courses.FullName",NULL,NULL) == Err_SUCCESS)
+                                "crs_courses.FullName",NULL,NULL,
+				SchIdx_CRS) == Err_SUCCESS)
 	{
 	 /***** Query database and list courses found *****/
 	 NumCrss = Crs_DB_SearchCrss (&mysql_res,SearchQuery,RangeQuery);
@@ -640,7 +645,7 @@ static unsigned Sch_SearchUsrsInDB (Hie_Level_t HieLvl,Rol_Role_t Role)
    /***** Split user string into words *****/
    switch (Sch_BuildSearchQuery (SearchQuery,Sch_GetSearch (),
 				 "CONCAT_WS(' ',FirstName,Surname1,Surname2)",
-				 NULL,NULL))
+				 NULL,NULL,SchIdx_USR))
      {
       case Err_SUCCESS:
 	 /***** Query database and list users found *****/
@@ -677,7 +682,8 @@ static unsigned Sch_SearchOpenDocumentsInDB (const char *RangeQuery)
       /***** Split document string into words *****/
       if (Sch_BuildSearchQuery (SearchQuery,Sch_GetSearch (),
                                 "SUBSTRING_INDEX(brw_files.Path,'/',-1)",
-				"_latin1 "," COLLATE latin1_general_ci") == Err_SUCCESS)
+				"_latin1 "," COLLATE latin1_general_ci",
+				SchIdx_FIL) == Err_SUCCESS)
 	{
 	 /***** Query database *****/
 	 NumDocs = Brw_DB_SearchPublicFiles (&mysql_res,RangeQuery,SearchQuery);
@@ -710,7 +716,8 @@ static unsigned Sch_SearchDocumentsInMyCoursesInDB (const char *RangeQuery)
       /***** Split document string into words *****/
       if (Sch_BuildSearchQuery (SearchQuery,Sch_GetSearch (),
                                 "SUBSTRING_INDEX(brw_files.Path,'/',-1)",
-				"_latin1 "," COLLATE latin1_general_ci") == Err_SUCCESS)
+				"_latin1 "," COLLATE latin1_general_ci",
+				SchIdx_FIL) == Err_SUCCESS)
 	{
 	 /***** Query database *****/
 	 NumDocs = Brw_DB_SearchFilesInMyCrss (&mysql_res,RangeQuery,SearchQuery);
@@ -743,7 +750,8 @@ static unsigned Sch_SearchMyDocumentsInDB (const char *RangeQuery)
       /***** Split document string into words *****/
       if (Sch_BuildSearchQuery (SearchQuery,Sch_GetSearch (),
                                 "SUBSTRING_INDEX(brw_files.Path,'/',-1)",
-				"_latin1 "," COLLATE latin1_general_ci") == Err_SUCCESS)
+				"_latin1 "," COLLATE latin1_general_ci",
+				SchIdx_FIL) == Err_SUCCESS)
 	{
 	 /***** Query database *****/
 	 NumDocs = Brw_DB_SearchMyFiles (&mysql_res,RangeQuery,SearchQuery);
@@ -768,7 +776,8 @@ static unsigned Sch_SearchMyDocumentsInDB (const char *RangeQuery)
 Err_SuccessOrError_t Sch_BuildSearchQuery (char SearchQuery[Sch_MAX_BYTES_SEARCH_QUERY + 1],
 					   const struct Sch_Search *Search,
 					   const char *FldName,
-					   const char *CharSet,const char *Collate)
+					   const char *CharSet,const char *Collate,
+					   SchIdx_Index_t Index)
   {
    const char *Ptr;
    unsigned NumWords;
@@ -777,6 +786,8 @@ Err_SuccessOrError_t Sch_BuildSearchQuery (char SearchQuery[Sch_MAX_BYTES_SEARCH
    size_t LengthTotal = 0;
    size_t MaxLengthWord = 0;
    char SearchWords[Sch_MAX_WORDS_IN_SEARCH][Sch_MAX_BYTES_SEARCH_WORD + 1];
+   const char *ValidWords[Sch_MAX_WORDS_IN_SEARCH];
+   unsigned NumValidWords = 0;
    Err_SuccessOrError_t SearchWordIsValid;
 
    if (Search->Str[0])
@@ -820,7 +831,7 @@ Err_SuccessOrError_t Sch_BuildSearchQuery (char SearchQuery[Sch_MAX_BYTES_SEARCH
 	    if (strlen (SearchQuery) + 128 + LengthWord >
 	        Sch_MAX_BYTES_SEARCH_QUERY)	// Prevent string overflow
 	       break;
-	    if (NumWords)
+	    if (SearchQuery[0])
 	       Str_Concat (SearchQuery," AND ",Sch_MAX_BYTES_SEARCH_QUERY);
 	    Str_Concat (SearchQuery,FldName,Sch_MAX_BYTES_SEARCH_QUERY);
 	    Str_Concat (SearchQuery," LIKE ",Sch_MAX_BYTES_SEARCH_QUERY);
@@ -833,6 +844,7 @@ Err_SuccessOrError_t Sch_BuildSearchQuery (char SearchQuery[Sch_MAX_BYTES_SEARCH
 	    if (Collate)
 	       if (Collate[0])
 		  Str_Concat (SearchQuery,Collate,Sch_MAX_BYTES_SEARCH_QUERY);
+	    ValidWords[NumValidWords++] = SearchWords[NumWords];
 	   }
 	}
 
@@ -841,6 +853,10 @@ Err_SuccessOrError_t Sch_BuildSearchQuery (char SearchQuery[Sch_MAX_BYTES_SEARCH
 	  MaxLengthWord < Sch_MIN_LENGTH_LONGEST_WORD)
 	 return Err_ERROR;
 
+      /***** Use index to check only names that may contain the words *****/
+      SchIdx_AddFilterToSearchQuery (SearchQuery,Sch_MAX_BYTES_SEARCH_QUERY,
+				     Index,NumValidWords,ValidWords);
+
       return Err_SUCCESS;
      }
 
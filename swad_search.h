@@ -28,6 +28,7 @@
 /*****************************************************************************/
 
 #include "swad_icon.h"
+#include "swad_search_index.h"
 
 /*****************************************************************************/
 /****************************** Public constants *****************************/
@@ -92,7 +93,8 @@ void Sch_SysSearch (void);
 Err_SuccessOrError_t Sch_BuildSearchQuery (char SearchQuery[Sch_MAX_BYTES_SEARCH_QUERY + 1],
 					   const struct Sch_Search *Search,
 					   const char *FldName,
-					   const char *CharSet,const char *Collate);
+					   const char *CharSet,const char *Collate,
+					   SchIdx_Index_t Index);
 
 void Sch_PutLinkToSearchCoursesPars (__attribute__((unused)) void *Args);
 
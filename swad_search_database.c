@@ -0,0 +1,193 @@
+// swad_search_database.c: search operations with database
+
+/*
+    SWAD (Shared Workspace At a Distance),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2026 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/********************************* Headers ***********************************/
+/*****************************************************************************/
+
+#include "swad_database.h"
+#include "swad_search_database.h"
+
+/*****************************************************************************/
+/***************************** Private constants *****************************/
+/*****************************************************************************/
+
+/***** Tables with the names indexed in each trigram index *****/
+static const struct
+  {
+   const char *Table;
+   const char *CodFld;
+   const char *NameFld;
+  } Sch_DB_IndexedNames[SchIdx_NUM_INDEXES] =
+  {
+   [SchIdx_USR] = {"usr_data"   ,"UsrCod","CONCAT_WS(' ',FirstName,Surname1,Surname2)"},
+   [SchIdx_INS] = {"ins_instits","InsCod","FullName"},
+   [SchIdx_CTR] = {"ctr_centers","CtrCod","FullName"},
+   [SchIdx_DEG] = {"deg_degrees","DegCod","FullName"},
+   [SchIdx_CRS] = {"crs_courses","CrsCod","FullName"},
+   [SchIdx_FIL] = {"brw_files"  ,"FilCod","SUBSTRING_INDEX(Path,'/',-1)"},
+  };
+
+/*****************************************************************************/
+/************************ Add trigrams of some names *************************/
+/*****************************************************************************/
+// Values is a list of (Idx,'Trigram',Cod) separated by commas
+
+void Sch_DB_AddTrigrams (const char *Values)
+  {
+   DB_QueryINSERT ("can not add trigrams",
+		   "INSERT IGNORE INTO sch_trigrams"
+		   " (Idx,Trigram,Cod)"
+		   " VALUES"
+		   " %s",
+		   Values);
+  }
+
+/*****************************************************************************/
+/********************* Remove all trigrams of a name *************************/
+/*****************************************************************************/
+
+void Sch_DB_RemoveTrigrams (SchIdx_Index_t Index,long Cod)
+  {
+   DB_QueryDELETE ("can not remove trigrams",
+		   "DELETE FROM sch_trigrams"
+		   " WHERE Idx=%u"
+		     " AND Cod=%ld",
+		   (unsigned) Index,
+		   Cod);
+  }
+
+/*****************************************************************************/
+/************ Get codes of names containing all given trigrams ***************/
+/*****************************************************************************/
+// Trigrams is a list of 'Trigram' separated by commas
+// Returns up to MaxCandidates + 1 rows,
+// so that the caller can know if there are more than MaxCandidates
+
+unsigned Sch_DB_GetCandidates (MYSQL_RES **mysql_res,SchIdx_Index_t Index,
+			       const char *Trigrams,unsigned NumTrigrams,
+			       unsigned MaxCandidates)
+  {
+   return (unsigned)
+   DB_QuerySELECT (mysql_res,"can not get candidates",
+		   "SELECT Cod"		// row[0]
+		    " FROM sch_trigrams"
+		   " WHERE Idx=%u"
+		     " AND Trigram IN (%s)"
+		" GROUP BY Cod"
+		  " HAVING COUNT(*)=%u"
+		   " LIMIT %u",
+		   (unsigned) Index,
+		   Trigrams,
+		   NumTrigrams,
+		   MaxCandidates + 1);
+  }
+
+/*****************************************************************************/
+/************** Remove trigrams of names that no longer exist ****************/
+/*****************************************************************************/
+
+void Sch_DB_RemoveOrphanTrigrams (SchIdx_Index_t Index)
+  {
+   DB_QueryDELETE ("can not remove orphan trigrams",
+		   "DELETE sch_trigrams"
+		    " FROM sch_trigrams"
+		    " LEFT JOIN %s"
+		      " ON sch_trigrams.Cod=%s.%s"
+		   " WHERE sch_trigrams.Idx=%u"
+		     " AND %s.%s IS NULL",
+		   Sch_DB_IndexedNames[Index].Table,
+		   Sch_DB_IndexedNames[Index].Table,Sch_DB_IndexedNames[Index].CodFld,
+		   (unsigned) Index,
+		   Sch_DB_IndexedNames[Index].Table,Sch_DB_IndexedNames[Index].CodFld);
+  }
+
+/*****************************************************************************/
+/************* Check if a trigram index is completely built ******************/
+/*****************************************************************************/
+
+Exi_Exist_t Sch_DB_CheckIfIndexIsReady (SchIdx_Index_t Index)
+  {
+   return
+   DB_QueryEXISTS ("can not check if index is ready",
+		   "SELECT EXISTS"
+		   "(SELECT *"
+		     " FROM sch_indexes"
+		    " WHERE Idx=%u"
+		      " AND Ready='Y')",
+		   (unsigned) Index);
+  }
+
+/*****************************************************************************/
+/********** Get code of last name indexed while building an index ************/
+/*****************************************************************************/
+
+long Sch_DB_GetLastIndexedCod (SchIdx_Index_t Index)
+  {
+   return DB_QuerySELECTCode ("can not get last indexed code",
+			      "SELECT LastCod"
+			       " FROM sch_indexes"
+			      " WHERE Idx=%u",
+			      (unsigned) Index);
+  }
+
+/*****************************************************************************/
+/******************* Update state of building of an index ********************/
+/*****************************************************************************/
+
+void Sch_DB_UpdateIndexState (SchIdx_Index_t Index,long LastCod,
+			      SchIdx_Ready_t Ready)
+  {
+   DB_QueryREPLACE ("can not update index state",
+		    "REPLACE INTO sch_indexes"
+		    " (Idx,LastCod,Ready)"
+		    " VALUES"
+		    " (%u,%ld,'%c')",
+		    (unsigned) Index,
+		    LastCod,
+		    Ready == SchIdx_READY ? 'Y' :
+					    'N');
+  }
+
+/*****************************************************************************/
+/************ Get next names to add to an index being built ******************/
+/*****************************************************************************/
+
+unsigned Sch_DB_GetNamesToIndex (MYSQL_RES **mysql_res,SchIdx_Index_t Index,
+				 long LastCod,unsigned MaxNames)
+  {
+   return (unsigned)
+   DB_QuerySELECT (mysql_res,"can not get names to index",
+		   "SELECT %s,"		// row[0]
+			  "%s"		// row[1]
+		    " FROM %s"
+		   " WHERE %s>%ld"
+		" ORDER BY %s"
+		   " LIMIT %u",
+		   Sch_DB_IndexedNames[Index].CodFld,
+		   Sch_DB_IndexedNames[Index].NameFld,
+		   Sch_DB_IndexedNames[Index].Table,
+		   Sch_DB_IndexedNames[Index].CodFld,LastCod,
+		   Sch_DB_IndexedNames[Index].CodFld,
+		   MaxNames);
+  }
@@ -0,0 +1,53 @@
+// swad_search_database.h: search operations with database
+
+#ifndef _SWAD_SCH_DB
+#define _SWAD_SCH_DB
+/*
+    SWAD (Shared Workspace At a Distance),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2026 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/********************************* Headers ***********************************/
+/*****************************************************************************/
+
+#include <mysql/mysql.h>	// To access MySQL databases
+
+#include "swad_exist.h"
+#include "swad_search_index.h"
+
+/*****************************************************************************/
+/***************************** Public prototypes *****************************/
+/*****************************************************************************/
+
+void Sch_DB_AddTrigrams (const char *Values);
+void Sch_DB_RemoveTrigrams (SchIdx_Index_t Index,long Cod);
+unsigned Sch_DB_GetCandidates (MYSQL_RES **mysql_res,SchIdx_Index_t Index,
+			       const char *Trigrams,unsigned NumTrigrams,
+			       unsigned MaxCandidates);
+void Sch_DB_RemoveOrphanTrigrams (SchIdx_Index_t Index);
+
+Exi_Exist_t Sch_DB_CheckIfIndexIsReady (SchIdx_Index_t Index);
+long Sch_DB_GetLastIndexedCod (SchIdx_Index_t Index);
+void Sch_DB_UpdateIndexState (SchIdx_Index_t Index,long LastCod,
+			      SchIdx_Ready_t Ready);
+unsigned Sch_DB_GetNamesToIndex (MYSQL_RES **mysql_res,SchIdx_Index_t Index,
+				 long LastCod,unsigned MaxNames);
+
+#endif
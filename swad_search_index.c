@@ -0,0 +1,475 @@
+// swad_search_index.c: trigram indexes used to search names
+
+/*
+    SWAD (Shared Workspace At a Distance),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2026 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/********************************* Headers ***********************************/
+/*****************************************************************************/
+
+#define _GNU_SOURCE 		// For asprintf
+#include <stdbool.h>		// For boolean type
+#include <stdio.h>		// For asprintf, snprintf
+#include <stdlib.h>		// For free, malloc, realloc
+#include <string.h>		// For strlen, strrchr
+
+#include "swad_database.h"
+#include "swad_error.h"
+#include "swad_search_database.h"
+#include "swad_search_index.h"
+#include "swad_string.h"
+
+/*****************************************************************************/
+/***************************** Private constants *****************************/
+/*****************************************************************************/
+
+/*
+   A name is indexed by its trigrams,
+   that is, by every 3 consecutive letters or digits in the name,
+   once converted to lowercase and without accents.
+   A search word can only be found in the names containing all its trigrams,
+   so candidate names are got intersecting the lists of names
+   of each trigram. The usual LIKE condition on candidates
+   keeps the same results as without index.
+*/
+#define SchIdx_MAX_TRIGRAMS_IN_SEARCH	32	// Enough to select few candidates
+#define SchIdx_MAX_CANDIDATES		1000	// If more, it's faster to check all names
+#define SchIdx_NAMES_PER_BATCH		500	// Names indexed each time while building
+#define SchIdx_MAX_BYTES_VALUES		(64 * 1024)	// Trigrams inserted in a query
+
+static const char *SchIdx_CodFld[SchIdx_NUM_INDEXES] =
+  {
+   [SchIdx_NONE] = NULL,
+   [SchIdx_USR ] = "usr_data.UsrCod",
+   [SchIdx_INS ] = "ins_instits.InsCod",
+   [SchIdx_CTR ] = "ctr_centers.CtrCod",
+   [SchIdx_DEG ] = "deg_degrees.DegCod",
+   [SchIdx_CRS ] = "crs_courses.CrsCod",
+   [SchIdx_FIL ] = "brw_files.FilCod",
+  };
+
+/*****************************************************************************/
+/******************************* Private types *******************************/
+/*****************************************************************************/
+
+struct SchIdx_Values	// Rows to be inserted into table of trigrams
+  {
+   char *Str;
+   size_t Length;
+   size_t Allocated;
+  };
+
+/*****************************************************************************/
+/***************************** Private prototypes ****************************/
+/*****************************************************************************/
+
+static unsigned SchIdx_GetTrigrams (const char *Str,
+				    char (*Trigrams)[3 + 1],
+				    unsigned NumTrigrams,unsigned MaxTrigrams);
+static char SchIdx_FoldChar (unsigned char Ch);
+
+static void SchIdx_AddNameToValues (struct SchIdx_Values *Values,
+				    SchIdx_Index_t Index,long Cod,const char *Name);
+static void SchIdx_InsertValues (struct SchIdx_Values *Values);
+
+static void SchIdx_BuildNextBatch (SchIdx_Index_t Index);
+
+/*****************************************************************************/
+/************************ Index a name (new or changed) **********************/
+/*****************************************************************************/
+
+void SchIdx_IndexName (SchIdx_Index_t Index,long Cod,const char *Name)
+  {
+   struct SchIdx_Values Values =
+     {
+      .Str       = NULL,
+      .Length    = 0,
+      .Allocated = 0,
+     };
+
+   /***** Trivial check: code should be > 0 *****/
+   if (Cod <= 0)
+      return;
+
+   /***** Remove old trigrams and insert the new ones *****/
+   Sch_DB_RemoveTrigrams (Index,Cod);
+   SchIdx_AddNameToValues (&Values,Index,Cod,Name);
+   SchIdx_InsertValues (&Values);
+   free (Values.Str);
+  }
+
+/*****************************************************************************/
+/*************************** Index a user's name *****************************/
+/*****************************************************************************/
+// Same string searched in database: CONCAT_WS(' ',FirstName,Surname1,Surname2)
+
+void SchIdx_IndexUsrName (long UsrCod,
+			  const char *FrstName,
+			  const char *Surname1,const char *Surname2)
+  {
+   char *FullName;
+
+   if (asprintf (&FullName,"%s %s %s",FrstName,Surname1,Surname2) < 0)
+      Err_NotEnoughMemoryExit ();
+   SchIdx_IndexName (SchIdx_USR,UsrCod,FullName);
+   free (FullName);
+  }
+
+/*****************************************************************************/
+/**************** Index the name of a file or folder *************************/
+/*****************************************************************************/
+// Only the last component of the path is searched
+
+void SchIdx_IndexFileName (long FilCod,const char *Path)
+  {
+   const char *FileName;
+
+   if ((FileName = strrchr (Path,'/')))
+      FileName++;
+   else
+      FileName = Path;
+   SchIdx_IndexName (SchIdx_FIL,FilCod,FileName);
+  }
+
+/*****************************************************************************/
+/************************* Remove a name from index **************************/
+/*****************************************************************************/
+
+void SchIdx_RemoveName (SchIdx_Index_t Index,long Cod)
+  {
+   if (Cod > 0)
+      Sch_DB_RemoveTrigrams (Index,Cod);
+  }
+
+/*****************************************************************************/
+/******* Restrict a search query to candidates got from trigram index ********/
+/*****************************************************************************/
+// SearchQuery already has a LIKE condition for each search word
+// If index is not ready or it is not selective enough, query is not changed
+
+void SchIdx_AddFilterToSearchQuery (char *SearchQuery,size_t MaxLength,
+				    SchIdx_Index_t Index,
+				    unsigned NumWords,const char *Words[])
+  {
+   static SchIdx_Ready_t Ready[SchIdx_NUM_INDEXES];
+   static bool ReadyIsKnown[SchIdx_NUM_INDEXES] = {false};
+   char Trigrams[SchIdx_MAX_TRIGRAMS_IN_SEARCH][3 + 1];
+   unsigned NumTrigrams = 0;
+   unsigned NumTrigram;
+   unsigned NumWord;
+   char TrigramsList[SchIdx_MAX_TRIGRAMS_IN_SEARCH * (1 + 3 + 1 + 1) + 1];
+   MYSQL_RES *mysql_res;
+   unsigned NumCandidates;
+   unsigned NumCandidate;
+   char StrCod[Cns_MAX_DIGITS_LONG + 1 + 1];
+
+   /***** Trivial check: this search uses an index? *****/
+   if (Index == SchIdx_NONE)
+      return;
+
+   /***** Check if index has been completely built *****/
+   if (!ReadyIsKnown[Index])
+     {
+      Ready[Index] = Sch_DB_CheckIfIndexIsReady (Index) == Exi_EXISTS ? SchIdx_READY :
+									SchIdx_NOT_READY;
+      ReadyIsKnown[Index] = true;
+     }
+   if (Ready[Index] == SchIdx_NOT_READY)
+      return;
+
+   /***** Get trigrams of all words *****/
+   for (NumWord = 0;
+	NumWord < NumWords;
+	NumWord++)
+      NumTrigrams = SchIdx_GetTrigrams (Words[NumWord],Trigrams,
+					NumTrigrams,SchIdx_MAX_TRIGRAMS_IN_SEARCH);
+   if (NumTrigrams == 0)	// Too short words
+      return;
+
+   /***** Build list of trigrams *****/
+   TrigramsList[0] = '\0';
+   for (NumTrigram = 0;
+	NumTrigram < NumTrigrams;
+	NumTrigram++)
+     {
+      if (NumTrigram)
+	 Str_Concat (TrigramsList,",",sizeof (TrigramsList) - 1);
+      Str_Concat (TrigramsList,"'",sizeof (TrigramsList) - 1);
+      Str_Concat (TrigramsList,Trigrams[NumTrigram],sizeof (TrigramsList) - 1);
+      Str_Concat (TrigramsList,"'",sizeof (TrigramsList) - 1);
+     }
+
+   /***** Get codes of names containing all trigrams *****/
+   NumCandidates = Sch_DB_GetCandidates (&mysql_res,Index,
+					 TrigramsList,NumTrigrams,
+					 SchIdx_MAX_CANDIDATES);
+
+   /***** Add condition if there are not too many candidates *****/
+   if (NumCandidates <= SchIdx_MAX_CANDIDATES &&
+       strlen (SearchQuery) + strlen (" AND  IN (-1)") + strlen (SchIdx_CodFld[Index]) +
+       (size_t) NumCandidates * (Cns_MAX_DIGITS_LONG + 1) <= MaxLength)
+     {
+      Str_Concat (SearchQuery," AND ",MaxLength);
+      Str_Concat (SearchQuery,SchIdx_CodFld[Index],MaxLength);
+      Str_Concat (SearchQuery," IN (-1",MaxLength);	// -1 ==> no candidates
+      for (NumCandidate = 0;
+	   NumCandidate < NumCandidates;
+	   NumCandidate++)
+	{
+	 snprintf (StrCod,sizeof (StrCod),",%ld",DB_GetNextCode (mysql_res));
+	 Str_Concat (SearchQuery,StrCod,MaxLength);
+	}
+      Str_Concat (SearchQuery,")",MaxLength);
+     }
+
+   /***** Free structure that stores the query result *****/
+   DB_FreeMySQLResult (&mysql_res);
+  }
+
+/*****************************************************************************/
+/*********** Get distinct trigrams of a string, appending them ***************/
+/*****************************************************************************/
+// Return the new number of trigrams
+
+static unsigned SchIdx_GetTrigrams (const char *Str,
+				    char (*Trigrams)[3 + 1],
+				    unsigned NumTrigrams,unsigned MaxTrigrams)
+  {
+   char Window[3 + 1] = {'\0','\0','\0','\0'};
+   unsigned NumConsecutive = 0;
+   unsigned NumTrigram;
+   char Ch;
+
+   for (;
+	*Str && NumTrigrams < MaxTrigrams;
+	Str++)
+      if ((Ch = SchIdx_FoldChar ((unsigned char) *Str)))
+	{
+	 /* Shift window */
+	 Window[0] = Window[1];
+	 Window[1] = Window[2];
+	 Window[2] = Ch;
+
+	 /* Add trigram if new */
+	 if (++NumConsecutive >= 3)
+	   {
+	    for (NumTrigram = 0;
+		 NumTrigram < NumTrigrams;
+		 NumTrigram++)
+	       if (!strcmp (Trigrams[NumTrigram],Window))
+		  break;
+	    if (NumTrigram == NumTrigrams)	// Not found
+	       Str_Copy (Trigrams[NumTrigrams++],Window,3);
+	   }
+	}
+      else	// Not a letter or a digit
+	 NumConsecutive = 0;
+
+   return NumTrigrams;
+  }
+
+/*****************************************************************************/
+/************ Convert a Latin-1 character to lowercase without accents *******/
+/*****************************************************************************/
+// Return '\0' if it is not a letter or a digit
+// Characters equal in the collations used in names
+// (latin1_spanish_ci and latin1_general_ci) are converted to the same
+
+static char SchIdx_FoldChar (unsigned char Ch)
+  {
+   if (Ch >= 'a' && Ch <= 'z')
+      return (char) Ch;
+   if (Ch >= 'A' && Ch <= 'Z')
+      return (char) (Ch - 'A' + 'a');
+   if (Ch >= '0' && Ch <= '9')
+      return (char) Ch;
+
+   switch (Ch)
+     {
+      case 0xAA:			// ª
+      case 0xC0: case 0xC1: case 0xC2:	// À Á Â
+      case 0xC3: case 0xC4: case 0xC5:	// Ã Ä Å
+      case 0xE0: case 0xE1: case 0xE2:	// à á â
+      case 0xE3: case 0xE4: case 0xE5:	// ã ä å
+	 return 'a';
+      case 0xC7: case 0xE7:		// Ç ç
+	 return 'c';
+      case 0xD0: case 0xF0:		// Ð ð
+	 return 'd';
+      case 0xC8: case 0xC9: case 0xCA: case 0xCB:	// È É Ê Ë
+      case 0xE8: case 0xE9: case 0xEA: case 0xEB:	// è é ê ë
+	 return 'e';
+      case 0xCC: case 0xCD: case 0xCE: case 0xCF:	// Ì Í Î Ï
+      case 0xEC: case 0xED: case 0xEE: case 0xEF:	// ì í î ï
+	 return 'i';
+      case 0xD1: case 0xF1:		// Ñ ñ
+	 return 'n';
+      case 0xBA:			// º
+      case 0xD2: case 0xD3: case 0xD4:	// Ò Ó Ô
+      case 0xD5: case 0xD6: case 0xD8:	// Õ Ö Ø
+      case 0xF2: case 0xF3: case 0xF4:	// ò ó ô
+      case 0xF5: case 0xF6: case 0xF8:	// õ ö ø
+	 return 'o';
+      case 0xD9: case 0xDA: case 0xDB: case 0xDC:	// Ù Ú Û Ü
+      case 0xF9: case 0xFA: case 0xFB: case 0xFC:	// ù ú û ü
+	 return 'u';
+      case 0xDD: case 0xFD: case 0xFF:	// Ý ý ÿ
+	 return 'y';
+      default:
+	 return '\0';
+     }
+  }
+
+/*****************************************************************************/
+/******* Add rows (Idx,'Trigram',Cod) for all trigrams of a name *************/
+/*****************************************************************************/
+
+static void SchIdx_AddNameToValues (struct SchIdx_Values *Values,
+				    SchIdx_Index_t Index,long Cod,const char *Name)
+  {
+   char (*Trigrams)[3 + 1];
+   unsigned MaxTrigrams;
+   unsigned NumTrigrams;
+   unsigned NumTrigram;
+   char Row[1 + 10 + 1 + 1 + 3 + 1 + 1 + Cns_MAX_DIGITS_LONG + 1 + 1 + 1];
+   size_t LengthRow;
+
+   /***** Get trigrams of name *****/
+   if ((MaxTrigrams = (unsigned) strlen (Name)) < 3)
+      return;
+   if ((Trigrams = malloc ((size_t) MaxTrigrams * sizeof (*Trigrams))) == NULL)
+      Err_NotEnoughMemoryExit ();
+   NumTrigrams = SchIdx_GetTrigrams (Name,Trigrams,0,MaxTrigrams);
+
+   /***** Append one row for each trigram *****/
+   for (NumTrigram = 0;
+	NumTrigram < NumTrigrams;
+	NumTrigram++)
+     {
+      LengthRow = (size_t) snprintf (Row,sizeof (Row),"%s(%u,'%s',%ld)",
+				     Values->Length ? "," :
+						      "",
+				     (unsigned) Index,Trigrams[NumTrigram],Cod);
+      if (Values->Length + LengthRow + 1 > Values->Allocated)
+	{
+	 Values->Allocated = Values->Allocated ? Values->Allocated * 2 :
+						 4 * 1024;
+	 if ((Values->Str = realloc (Values->Str,Values->Allocated)) == NULL)
+	    Err_NotEnoughMemoryExit ();
+	}
+      memcpy (&Values->Str[Values->Length],Row,LengthRow + 1);
+      Values->Length += LengthRow;
+     }
+
+   free (Trigrams);
+  }
+
+/*****************************************************************************/
+/**************** Insert pending rows into table of trigrams *****************/
+/*****************************************************************************/
+
+static void SchIdx_InsertValues (struct SchIdx_Values *Values)
+  {
+   if (Values->Length)
+     {
+      Sch_DB_AddTrigrams (Values->Str);
+      Values->Length = 0;
+     }
+  }
+
+/*****************************************************************************/
+/********** Add some names to indexes which are not completely built *********/
+/*****************************************************************************/
+// Called from time to time until all indexes are built.
+// New and changed names are indexed immediately,
+// so it's only necessary to index names existing before.
+
+void SchIdx_ContinueBuildingIndexes (void)
+  {
+   SchIdx_Index_t Index;
+
+   for (Index  = SchIdx_USR;
+	Index <= SchIdx_FIL;
+	Index++)
+      if (Sch_DB_CheckIfIndexIsReady (Index) == Exi_DOES_NOT_EXIST)
+	{
+	 SchIdx_BuildNextBatch (Index);
+	 return;	// Only one batch each time
+	}
+  }
+
+/*****************************************************************************/
+/********************** Add next names to an index ***************************/
+/*****************************************************************************/
+
+static void SchIdx_BuildNextBatch (SchIdx_Index_t Index)
+  {
+   MYSQL_RES *mysql_res;
+   MYSQL_ROW row;
+   unsigned NumNames;
+   unsigned NumName;
+   long LastCod;
+   long Cod;
+   struct SchIdx_Values Values =
+     {
+      .Str       = NULL,
+      .Length    = 0,
+      .Allocated = 0,
+     };
+
+   /***** Get next names from database *****/
+   LastCod = Sch_DB_GetLastIndexedCod (Index);	// -1 if not begun
+   NumNames = Sch_DB_GetNamesToIndex (&mysql_res,Index,
+				      LastCod,SchIdx_NAMES_PER_BATCH);
+
+   /***** Insert trigrams of names, several names in each query *****/
+   for (NumName = 0;
+	NumName < NumNames;
+	NumName++)
+     {
+      row = mysql_fetch_row (mysql_res);
+
+      /* Get code (row[0]) and name (row[1]) */
+      if ((Cod = Str_ConvertStrCodToLongCod (row[0])) > 0)
+	{
+	 SchIdx_AddNameToValues (&Values,Index,Cod,row[1]);
+	 LastCod = Cod;
+	}
+
+      if (Values.Length >= SchIdx_MAX_BYTES_VALUES)
+	 SchIdx_InsertValues (&Values);
+     }
+   SchIdx_InsertValues (&Values);
+   free (Values.Str);
+
+   /***** Free structure that stores the query result *****/
+   DB_FreeMySQLResult (&mysql_res);
+
+   /***** Store where to continue next time *****/
+   if (NumNames < SchIdx_NAMES_PER_BATCH)	// Last batch
+     {
+      /* Names removed while building could have left some trigrams */
+      Sch_DB_RemoveOrphanTrigrams (Index);
+      Sch_DB_UpdateIndexState (Index,LastCod,SchIdx_READY);
+     }
+   else
+      Sch_DB_UpdateIndexState (Index,LastCod,SchIdx_NOT_READY);
+  }
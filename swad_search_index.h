@@ -0,0 +1,71 @@
+// swad_search_index.h: trigram indexes used to search names
+
+#ifndef _SWAD_SCH_IDX
+#define _SWAD_SCH_IDX
+/*
+    SWAD (Shared Workspace At a Distance),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2026 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/********************************* Headers ***********************************/
+/*****************************************************************************/
+
+#include <stddef.h>		// For size_t
+
+/*****************************************************************************/
+/******************************* Public types ********************************/
+/*****************************************************************************/
+
+#define SchIdx_NUM_INDEXES 7
+typedef enum	// Don't change these values! They are stored in database as numbers
+  {
+   SchIdx_NONE = 0,	// Not indexed
+   SchIdx_USR  = 1,	// Users' names
+   SchIdx_INS  = 2,	// Institutions' full names
+   SchIdx_CTR  = 3,	// Centers' full names
+   SchIdx_DEG  = 4,	// Degrees' full names
+   SchIdx_CRS  = 5,	// Courses' full names
+   SchIdx_FIL  = 6,	// Names of files and folders
+  } SchIdx_Index_t;
+
+typedef enum
+  {
+   SchIdx_NOT_READY,	// Index is being built
+   SchIdx_READY,	// Index contains all names
+  } SchIdx_Ready_t;
+
+/*****************************************************************************/
+/***************************** Public prototypes *****************************/
+/*****************************************************************************/
+
+void SchIdx_IndexName (SchIdx_Index_t Index,long Cod,const char *Name);
+void SchIdx_IndexUsrName (long UsrCod,
+			  const char *FrstName,
+			  const char *Surname1,const char *Surname2);
+void SchIdx_IndexFileName (long FilCod,const char *Path);
+void SchIdx_RemoveName (SchIdx_Index_t Index,long Cod);
+
+void SchIdx_AddFilterToSearchQuery (char *SearchQuery,size_t MaxLength,
+				    SchIdx_Index_t Index,
+				    unsigned NumWords,const char *Words[]);
+
+void SchIdx_ContinueBuildingIndexes (void);
+
+#endif
@@ -31,7 +31,7 @@
 #include <string.h>		// For string functions
 
 #include "swad_action_list.h"
-#include "swad_connected_database.h"
+#include "swad_connected.h"
 #include "swad_database.h"
 #include "swad_error.h"
 #include "swad_file_database.h"
@@ -86,7 +86,7 @@ void Ses_CreateSession (void)
    Ses_DB_InsertSession (Search->WhatToSearch);
 
    /***** Update time and course in connected list *****/
-   Con_DB_UpdateMeInConnectedList ();
+   Con_UpdateMeInConnectedList ();
 
    /***** Update number of open sessions in order to show them properly *****/
    Ses_GetNumSessions ();
@@ -107,7 +107,7 @@ void Ses_CloseSession (void)
    Gbl.Session.Id[0] = '\0';
 
    /***** If there are no more sessions for current user ==> remove user from connected list *****/
-   Con_DB_RemoveOldConnected ();
+   Con_RemoveOldConnected ();
 
    /***** Remove unused data associated to expired sessions *****/
    Ses_DB_RemoveParsFromExpiredSessions ();
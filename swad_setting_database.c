@@ -261,6 +261,33 @@ void Set_DB_InsertUsrInCrsSettings (long UsrCod,long HieCod)
 							   'N');
   }
 
+/*****************************************************************************/
+/********* Register last prefs in a course of several users at once **********/
+/*****************************************************************************/
+// SubQueryUsrs is a list of users' codes separated by commas
+
+void Set_DB_InsertUsrsInCrsSettings (const char *SubQueryUsrs,long HieCod)
+  {
+   DB_QueryINSERT ("can not register users in course",
+		   "INSERT INTO crs_user_settings"
+		   " (UsrCod,CrsCod,"
+		     "LastDowGrpCod,LastComGrpCod,LastAssGrpCod,"
+		     "NumAccTst,LastAccTst,NumQstsLastTst,"
+		     "UsrListType,ListWithPhotos)"
+		   " SELECT UsrCod,%ld,"
+			   "-1,-1,-1,"
+			   "0,FROM_UNIXTIME(%ld),0,"
+			   "'%s','%c'"
+		     " FROM usr_data"
+		    " WHERE UsrCod IN (%s)",
+		   HieCod,
+		   (long) (time_t) 0,	// The users never accessed to tests in this course
+		   Set_DB_StringsUsrListTypes[Set_SHOW_USRS_TYPE_DEFAULT],
+		   Pho_PHOTOS_DEFAULT == Pho_PHOTOS_SHOW ? 'Y' :
+							   'N',
+		   SubQueryUsrs);
+  }
+
 /*****************************************************************************/
 /******** Update the group of my last access to a file browser zone **********/
 /*****************************************************************************/
@@ -45,6 +45,7 @@ Exi_Exist_t Set_DB_GetMyLanguage (MYSQL_RES **mysql_res);
 
 //-------------------- User settings in the current course --------------------
 void Set_DB_InsertUsrInCrsSettings (long UsrCod,long HieCod);
+void Set_DB_InsertUsrsInCrsSettings (const char *SubQueryUsrs,long HieCod);
 
 void Set_DB_UpdateGrpMyLastAccZone (const char *FieldNameDB,long GrpCod);
 void Set_DB_UpdateMyUsrListType (void);
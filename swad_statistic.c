@@ -44,6 +44,7 @@
 #include "swad_HTML.h"
 #include "swad_ID.h"
 #include "swad_log.h"
+#include "swad_log_archive.h"
 #include "swad_log_database.h"
 #include "swad_parameter_code.h"
 #include "swad_plugin.h"
@@ -109,6 +110,11 @@ static void Sta_WriteSelectorAction (const struct Sta_Stats *Stats);
 static void Sta_WriteSelectorScope (void);
 static void Sta_WriteSelectorCountType (const struct Sta_Stats *Stats);
 static void Sta_ShowHits (Sta_GlobalOrCourseAccesses_t GlobalOrCourse);
+static unsigned Sta_GetHits (MYSQL_RES **mysql_res,
+                             const struct Sta_Stats *Stats,
+                             const char *LogTable,
+                             const char BrowserTimeZone[Dat_MAX_BYTES_TIME_ZONE + 1],
+                             const struct Usr_ListCods *ListCods);
 static void Sta_ShowDetailedAccessesList (const struct Sta_Stats *Stats,
                                           unsigned NumHits,MYSQL_RES *mysql_res);
 static void Sta_WriteLogComments (long LogCod);
@@ -972,8 +978,8 @@ static void Sta_ShowHits (Sta_GlobalOrCourseAccesses_t GlobalOrCourse)
 		 NULL,NULL,NULL,Box_NOT_CLOSABLE);
 
       /***** Make the query *****/
-      if ((NumHits = Sta_DB_GetHits (&mysql_res,&Stats,LogTable,BrowserTimeZone,
-				     &ListCods)))
+      if ((NumHits = Sta_GetHits (&mysql_res,&Stats,LogTable,BrowserTimeZone,
+				  &ListCods)))
 	{
 	 HTM_TABLE_BeginWidePadding (Sta_CellPadding[Stats.ClicksGroupedBy]);
 	    ShowHits[Stats.ClicksGroupedBy] (&Stats,NumHits,mysql_res);
@@ -1024,6 +1030,39 @@ static void Sta_ShowHits (Sta_GlobalOrCourseAccesses_t GlobalOrCourse)
      }
   }
 
+/*****************************************************************************/
+/***************** Get hits from log archive and/or database *****************/
+/*****************************************************************************/
+// Clicks in closed years are got from columnar archive when possible
+
+static unsigned Sta_GetHits (MYSQL_RES **mysql_res,
+                             const struct Sta_Stats *Stats,
+                             const char *LogTable,
+                             const char BrowserTimeZone[Dat_MAX_BYTES_TIME_ZONE + 1],
+                             const struct Usr_ListCods *ListCods)
+  {
+   time_t LiveStartTime;
+   unsigned NumHits;
+
+   /***** Try to get hits in closed years from archive *****/
+   if (!strcmp (LogTable,"log"))
+      if (LogArc_GetHits (Stats,BrowserTimeZone,&LiveStartTime) == Err_SUCCESS)
+	{
+	 /***** Add hits after archive got from database *****/
+	 if (LiveStartTime <= Dat_GetRangeTimeUTC (Dat_END_TIME))
+	    Sta_DB_InsertLiveHitsIntoTmpTable (Stats,LogTable,BrowserTimeZone,ListCods,
+					       LiveStartTime);
+
+	 /***** Get all hits *****/
+	 NumHits = Sta_DB_GetHitsFromTmpTable (mysql_res,Stats);
+	 Sta_DB_DropTmpTableHits ();
+	 return NumHits;
+	}
+
+   /***** Get all hits from database *****/
+   return Sta_DB_GetHits (mysql_res,Stats,LogTable,BrowserTimeZone,ListCods);
+  }
+
 /*****************************************************************************/
 /******************* Show a listing of detailed clicks ***********************/
 /*****************************************************************************/
@@ -43,24 +43,173 @@
 extern struct Globals Gbl;
 
 /*****************************************************************************/
-/******************** Compute and show access statistics ********************/
+/***************************** Private constants *****************************/
 /*****************************************************************************/
 
 #define Sta_DB_MAX_BYTES_QUERY (1024 + (10 + ID__MAX_BYTES_USR_ID) * 5000 - 1)
 
+/*****************************************************************************/
+/**************************** Private prototypes *****************************/
+/*****************************************************************************/
+
+static void Sta_DB_BuildQueryHits (char Query[Sta_DB_MAX_BYTES_QUERY + 1],
+                                   const struct Sta_Stats *Stats,
+                                   const char *LogTable,
+                                   const char BrowserTimeZone[Dat_MAX_BYTES_TIME_ZONE + 1],
+                                   const struct Usr_ListCods *ListCods,
+                                   time_t StartTime);
+
+/*****************************************************************************/
+/******************** Compute and show access statistics ********************/
+/*****************************************************************************/
+
 unsigned Sta_DB_GetHits (MYSQL_RES **mysql_res,
                          const struct Sta_Stats *Stats,
                          const char *LogTable,
                          const char BrowserTimeZone[Dat_MAX_BYTES_TIME_ZONE + 1],
                          const struct Usr_ListCods *ListCods)
+  {
+   char *Query;
+   unsigned NumHits;
+
+   /***** Allocate memory for the query *****/
+   if ((Query = malloc (Sta_DB_MAX_BYTES_QUERY + 1)) == NULL)
+      Err_NotEnoughMemoryExit ();
+
+   /***** Build the query *****/
+   Sta_DB_BuildQueryHits (Query,Stats,LogTable,BrowserTimeZone,ListCods,
+                          Dat_GetRangeTimeUTC (Dat_STR_TIME));
+
+   /***** Make the query *****/
+   NumHits = (unsigned)
+   DB_QuerySELECT (mysql_res,"can not get clicks","%s",Query);
+
+   /* Free memory for the query */
+   free (Query);
+
+   return NumHits;
+  }
+
+/*****************************************************************************/
+/********** Temporary table with hits got from archive and database **********/
+/*****************************************************************************/
+// Used when hits in closed years are got from log archive
+
+void Sta_DB_CreateTmpTableHits (void)
+  {
+   DB_DropTmpTable ("sta_hits_tmp");
+   DB_CreateTmpTable ("CREATE TEMPORARY TABLE sta_hits_tmp"
+		      " (Key1 CHAR(11) NOT NULL,"
+		        "Key2 CHAR(2) NOT NULL DEFAULT '',"
+		        "Num DOUBLE NOT NULL)"
+		      " ENGINE=MEMORY");
+  }
+
+void Sta_DB_InsertIntoTmpTableHits (const char *Values)
+  {
+   DB_QueryINSERT ("can not store hits",
+		   "INSERT INTO sta_hits_tmp"
+		   " (Key1,Key2,Num)"
+		   " VALUES"
+		   " %s",
+		   Values);
+  }
+
+void Sta_DB_InsertLiveHitsIntoTmpTable (const struct Sta_Stats *Stats,
+                                        const char *LogTable,
+                                        const char BrowserTimeZone[Dat_MAX_BYTES_TIME_ZONE + 1],
+                                        const struct Usr_ListCods *ListCods,
+                                        time_t StartTime)
+  {
+   char *Query;
+
+   /***** Allocate memory for the query *****/
+   if ((Query = malloc (Sta_DB_MAX_BYTES_QUERY + 1)) == NULL)
+      Err_NotEnoughMemoryExit ();
+
+   /***** Build the query of hits from start time *****/
+   Sta_DB_BuildQueryHits (Query,Stats,LogTable,BrowserTimeZone,ListCods,
+                          StartTime);
+
+   /***** Insert hits got from database *****/
+   DB_QueryINSERT ("can not store hits",
+		   Stats->ClicksGroupedBy == Sta_CLICKS_GBL_PER_DAY_AND_HOUR ?
+		   "INSERT INTO sta_hits_tmp"
+		   " (Key1,Key2,Num)"
+		   " %s" :
+		   "INSERT INTO sta_hits_tmp"
+		   " (Key1,Num)"
+		   " %s",
+		   Query);
+
+   /* Free memory for the query */
+   free (Query);
+  }
+
+unsigned Sta_DB_GetHitsFromTmpTable (MYSQL_RES **mysql_res,
+                                     const struct Sta_Stats *Stats)
+  {
+   static const char *OrderBy[Sta_NUM_CLICKS_GROUPED_BY] =
+     {
+      [Sta_CLICKS_GBL_PER_DAY         ] = "Key1 DESC",
+      [Sta_CLICKS_GBL_PER_DAY_AND_HOUR] = "Key1 DESC,Key2",
+      [Sta_CLICKS_GBL_PER_WEEK        ] = "Key1 DESC",
+      [Sta_CLICKS_GBL_PER_MONTH       ] = "Key1 DESC",
+      [Sta_CLICKS_GBL_PER_YEAR        ] = "Key1 DESC",
+      [Sta_CLICKS_GBL_PER_HOUR        ] = "Key1",
+      [Sta_CLICKS_GBL_PER_MINUTE      ] = "Key1",
+      [Sta_CLICKS_GBL_PER_ACTION      ] = "Num DESC",
+      [Sta_CLICKS_GBL_PER_COUNTRY     ] = "Num DESC",
+      [Sta_CLICKS_GBL_PER_INSTITUTION ] = "Num DESC",
+      [Sta_CLICKS_GBL_PER_CENTER      ] = "Num DESC",
+      [Sta_CLICKS_GBL_PER_DEGREE      ] = "Num DESC",
+      [Sta_CLICKS_GBL_PER_COURSE      ] = "Num DESC",
+     };
+
+   if (Stats->ClicksGroupedBy == Sta_CLICKS_GBL_PER_DAY_AND_HOUR)
+      return (unsigned)
+      DB_QuerySELECT (mysql_res,"can not get clicks",
+		      "SELECT Key1,"	// row[0]
+			     "Key2,"	// row[1]
+			     "SUM(Num)"	// row[2]
+		       " FROM sta_hits_tmp"
+		   " GROUP BY Key1,"
+			     "Key2"
+		   " ORDER BY %s",
+		      OrderBy[Stats->ClicksGroupedBy]);
+
+   return (unsigned)
+   DB_QuerySELECT (mysql_res,"can not get clicks",
+		   "SELECT Key1,"		// row[0]
+			  "SUM(Num) AS Num"	// row[1]
+		    " FROM sta_hits_tmp"
+		" GROUP BY Key1"
+		" ORDER BY %s",
+		   OrderBy[Stats->ClicksGroupedBy] ? OrderBy[Stats->ClicksGroupedBy] :
+						     "Key1");
+  }
+
+void Sta_DB_DropTmpTableHits (void)
+  {
+   DB_DropTmpTable ("sta_hits_tmp");
+  }
+
+/*****************************************************************************/
+/********* Build query to get hits from a start time to end of range *********/
+/*****************************************************************************/
+
+static void Sta_DB_BuildQueryHits (char Query[Sta_DB_MAX_BYTES_QUERY + 1],
+                                   const struct Sta_Stats *Stats,
+                                   const char *LogTable,
+                                   const char BrowserTimeZone[Dat_MAX_BYTES_TIME_ZONE + 1],
+                                   const struct Usr_ListCods *ListCods,
+                                   time_t StartTime)
   {
    char SubQueryCountType[256];
    char SubQueryRole[256];
    char SubQuery[512];
-   char *Query = NULL;
    long LengthQuery;
    unsigned NumUsr;
-   unsigned NumHits;
 
    /***** Build subquery depending on the type of count *****/
    switch (Stats->CountType)
@@ -85,10 +234,6 @@ unsigned Sta_DB_GetHits (MYSQL_RES **mysql_res,
 	 break;
      }
 
-   /***** Allocate memory for the query *****/
-   if ((Query = malloc (Sta_DB_MAX_BYTES_QUERY + 1)) == NULL)
-      Err_NotEnoughMemoryExit ();
-
    /***** Begin building the query *****/
    switch (Stats->ClicksGroupedBy)
      {
@@ -269,7 +414,7 @@ unsigned Sta_DB_GetHits (MYSQL_RES **mysql_res,
 	             " BETWEEN FROM_UNIXTIME(%ld)"
 	                 " AND FROM_UNIXTIME(%ld)",
             LogTable,
-            (long) Dat_GetRangeTimeUTC (Dat_STR_TIME),
+            (long) StartTime,
             (long) Dat_GetRangeTimeUTC (Dat_END_TIME));
    Str_Concat (Query,SubQuery,Sta_DB_MAX_BYTES_QUERY);
 
@@ -549,13 +694,4 @@ unsigned Sta_DB_GetHits (MYSQL_RES **mysql_res,
          Str_Concat (Query,SubQuery,Sta_DB_MAX_BYTES_QUERY);
 	 break;
      }
-
-   /***** Make the query *****/
-   NumHits = (unsigned)
-   DB_QuerySELECT (mysql_res,"can not get clicks","%s",Query);
-
-   /* Free memory for the query */
-   free (Query);
-
-   return NumHits;
   }
@@ -28,6 +28,7 @@
 /*****************************************************************************/
 
 #include <mysql/mysql.h>	// To access MySQL databases
+#include <time.h>		// For time_t
 
 #include "swad_statistic.h"
 
@@ -41,4 +42,15 @@ unsigned Sta_DB_GetHits (MYSQL_RES **mysql_res,
                          const char BrowserTimeZone[Dat_MAX_BYTES_TIME_ZONE + 1],
                          const struct Usr_ListCods *ListCods);
 
+void Sta_DB_CreateTmpTableHits (void);
+void Sta_DB_InsertIntoTmpTableHits (const char *Values);
+void Sta_DB_InsertLiveHitsIntoTmpTable (const struct Sta_Stats *Stats,
+                                        const char *LogTable,
+                                        const char BrowserTimeZone[Dat_MAX_BYTES_TIME_ZONE + 1],
+                                        const struct Usr_ListCods *ListCods,
+                                        time_t StartTime);
+unsigned Sta_DB_GetHitsFromTmpTable (MYSQL_RES **mysql_res,
+                                     const struct Sta_Stats *Stats);
+void Sta_DB_DropTmpTableHits (void);
+
 #endif
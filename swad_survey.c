@@ -124,6 +124,7 @@ static void Svy_PutIconToAddNewQuestion (void *Surveys);
 static void Svy_WriteQstStem (const char *Stem);
 static void Svy_WriteAnswersOfAQst (struct Svy_Survey *Svy,
                                     struct Svy_Question *SvyQst,
+                                    MYSQL_RES *mysql_res_ans,
                                     Frm_PutForm_t PutFormAnswerSurvey);
 static void Svy_WriteCommentsOfAQst (struct Svy_Survey *Svy,
                                      struct Svy_Question *SvyQst,
@@ -2594,6 +2595,7 @@ static void Svy_ListSvyQuestions (struct Svy_Surveys *Surveys)
    extern const char *Txt_SURVEY_STR_ANSWER_TYPES[Svy_NUM_ANS_TYPES];
    extern const char *Txt_This_survey_has_no_questions;
    MYSQL_RES *mysql_res;
+   MYSQL_RES *mysql_res_ans;
    unsigned NumQsts;
    unsigned NumQst;
    struct Svy_Question SvyQst;
@@ -2617,6 +2619,9 @@ static void Svy_ListSvyQuestions (struct Svy_Surveys *Surveys)
       /***** Get data of questions from database *****/
       if ((NumQsts = Svy_DB_GetSurveyQsts (&mysql_res,Surveys->Svy.SvyCod)))
 	{
+	 /***** Get answers of all questions with a single query *****/
+	 Svy_DB_GetAnswersSvy (&mysql_res_ans,Surveys->Svy.SvyCod);
+
 	 if (PutFormAnswerSurvey == Frm_PUT_FORM)
 	   {
 	    /***** Begin form to send answers to survey *****/
@@ -2682,7 +2687,7 @@ static void Svy_ListSvyQuestions (struct Svy_Surveys *Surveys)
 		  HTM_TD_Begin ("class=\"LT DAT_%s %s\"",
 				The_GetSuffix (),The_GetColorRows ());
 		     Svy_WriteQstStem (Stem);
-		     Svy_WriteAnswersOfAQst (&Surveys->Svy,&SvyQst,
+		     Svy_WriteAnswersOfAQst (&Surveys->Svy,&SvyQst,mysql_res_ans,
 					     PutFormAnswerSurvey);
 		     if (SvyQst.AllowCommentsByStds == DenAll_ALLOW)
 			Svy_WriteCommentsOfAQst (&Surveys->Svy,&SvyQst,
@@ -2695,6 +2700,9 @@ static void Svy_ListSvyQuestions (struct Svy_Surveys *Surveys)
 
 	 HTM_TABLE_End ();
 
+	 /***** Free structure that stores the answers *****/
+	 DB_FreeMySQLResult (&mysql_res_ans);
+
 	 if (PutFormAnswerSurvey == Frm_PUT_FORM)
 	   {
 	    /***** Button to create/modify survey *****/
@@ -2793,20 +2801,30 @@ static void Svy_WriteQstStem (const char *Stem)
 /*****************************************************************************/
 /************** Get and write the answers of a survey question ***************/
 /*****************************************************************************/
+// mysql_res_ans holds the answers of all questions in the survey,
+// in the same order as the questions (result of Svy_DB_GetAnswersSvy).
+// On return, it points to the first answer of the next question.
 
 static void Svy_WriteAnswersOfAQst (struct Svy_Survey *Svy,
                                     struct Svy_Question *SvyQst,
+                                    MYSQL_RES *mysql_res_ans,
                                     Frm_PutForm_t PutFormAnswerSurvey)
   {
    unsigned NumAnswers;
    unsigned NumAns;
-   MYSQL_RES *mysql_res;
+   MYSQL_ROW_OFFSET FirstAns;
    MYSQL_ROW row;
    unsigned NumUsrsThisAnswer;
    char StrAns[32];
 
-   /***** Get answers of this question *****/
-   NumAnswers = Svy_DB_GetAnswersQst (&mysql_res,SvyQst->QstCod);	// Result: AnsInd,NumUsrs,Answer
+   /***** Count answers of this question (next rows in result) *****/
+   FirstAns = mysql_row_tell (mysql_res_ans);
+   for (NumAnswers = 0;
+	(row = mysql_fetch_row (mysql_res_ans)) != NULL;
+	NumAnswers++)
+      if (Str_ConvertStrCodToLongCod (row[0]) != SvyQst->QstCod)
+	 break;
+   mysql_row_seek (mysql_res_ans,FirstAns);
 
    /***** Write the answers *****/
    if (NumAnswers)
@@ -2822,18 +2840,24 @@ static void Svy_WriteAnswersOfAQst (struct Svy_Survey *Svy,
 	      NumAns < NumAnswers;
 	      NumAns++)
 	   {
-	    row = mysql_fetch_row (mysql_res);
-
-	    /* Get number of users who have marked this answer (row[1]) */
-	    if (sscanf (row[1],"%u",&NumUsrsThisAnswer) != 1)
+	    row = mysql_fetch_row (mysql_res_ans);
+	    /*
+	    row[0] QstCod
+	    row[1] AnsInd
+	    row[2] NumUsrs
+	    row[3] Answer
+	    */
+
+	    /* Get number of users who have marked this answer (row[2]) */
+	    if (sscanf (row[2],"%u",&NumUsrsThisAnswer) != 1)
 	       Err_ShowErrorAndExit ("Error when getting number of users who have marked an answer.");
 
-	    /* Convert the answer (row[2]), that is in HTML, to rigorous HTML */
+	    /* Convert the answer (row[3]), that is in HTML, to rigorous HTML */
 	    if (Svy_AllocateTextChoiceAnswer (SvyQst,NumAns) == Err_ERROR)
 	       /* Abort on error */
 	       Ale_ShowAlertsAndExit ();
 
-	    Str_Copy (SvyQst->AnsChoice[NumAns].Text,row[2],Svy_MAX_BYTES_ANSWER);
+	    Str_Copy (SvyQst->AnsChoice[NumAns].Text,row[3],Svy_MAX_BYTES_ANSWER);
 	    Str_ChangeFormat (Str_FROM_HTML,Str_TO_RIGOROUS_HTML,
 			      SvyQst->AnsChoice[NumAns].Text,Svy_MAX_BYTES_ANSWER,
 			      Str_DONT_REMOVE_SPACES);
@@ -2903,9 +2927,6 @@ static void Svy_WriteAnswersOfAQst (struct Svy_Survey *Svy,
      }
    else
       HTM_BR ();
-
-   /***** Free structure that stores the query result *****/
-   DB_FreeMySQLResult (&mysql_res);
   }
 
 /*****************************************************************************/
@@ -1130,6 +1130,30 @@ unsigned Svy_DB_GetAnswersQst (MYSQL_RES **mysql_res,long QstCod)
 		   QstCod);
   }
 
+/*****************************************************************************/
+/********** Get answers of all questions in a survey from database ***********/
+/*****************************************************************************/
+
+// Answers are ordered by question index, in the same order as questions,
+// so they can be read in a single pass while the questions are listed
+
+unsigned Svy_DB_GetAnswersSvy (MYSQL_RES **mysql_res,long SvyCod)
+  {
+   return (unsigned)
+   DB_QuerySELECT (mysql_res,"can not get answers of a survey",
+		   "SELECT svy_answers.QstCod,"		// row[0]
+			  "svy_answers.AnsInd,"		// row[1]
+			  "svy_answers.NumUsrs,"	// row[2]
+			  "svy_answers.Answer"		// row[3]
+		    " FROM svy_questions,"
+			  "svy_answers"
+		   " WHERE svy_questions.SvyCod=%ld"
+		     " AND svy_questions.QstCod=svy_answers.QstCod"
+		" ORDER BY svy_questions.QstInd,"
+			  "svy_answers.AnsInd",
+		   SvyCod);
+  }
+
 /*****************************************************************************/
 /*********** Convert a string with the answer type to answer type ************/
 /*****************************************************************************/
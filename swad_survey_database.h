@@ -101,6 +101,7 @@ void Svy_DB_IncreaseAnswer (long QstCod,unsigned AnsInd);
 
 Exi_Exist_t Svy_DB_CheckIfAnswerExists (long QstCod,unsigned AnsInd);
 unsigned Svy_DB_GetAnswersQst (MYSQL_RES **mysql_res,long QstCod);
+unsigned Svy_DB_GetAnswersSvy (MYSQL_RES **mysql_res,long SvyCod);
 Svy_AnswerType_t Svy_DB_ConvertFromStrAnsTypDBToAnsTyp (const char *StrAnsTypeDB);
 
 void Svy_DB_RemoveAnswerQst (long QstCod,unsigned AnsInd);
@@ -211,24 +211,24 @@ void Tag_InsertTagsIntoDB (long QstCod,const struct Tag_Tags *Tags)
   {
    unsigned NumTag;
    unsigned TagInd;
-   long TagCod;
+   long TagCods[Tag_MAX_TAGS_PER_QUESTION];
 
    /***** For each tag... *****/
    for (NumTag = 0, TagInd = 0;
-        TagInd < Tags->Num;
+        TagInd < Tags->Num && NumTag < Tag_MAX_TAGS_PER_QUESTION;
         NumTag++)
       if (Tags->Txt[NumTag][0])
         {
          /***** Check if this tag exists for current course *****/
-         if ((TagCod = Tag_DB_GetTagCodFromTagTxt (Tags->Txt[NumTag])) < 0)
+         if ((TagCods[TagInd] = Tag_DB_GetTagCodFromTagTxt (Tags->Txt[NumTag])) < 0)
             /* This tag is new for current course. Add it to tags table */
-            TagCod = Tag_DB_CreateNewTag (Gbl.Hierarchy.Node[Hie_CRS].HieCod,Tags->Txt[NumTag]);
-
-         /***** Insert tag in tst_question_tags *****/
-         Tag_DB_AddTagToQst (QstCod,TagCod,TagInd);
+            TagCods[TagInd] = Tag_DB_CreateNewTag (Gbl.Hierarchy.Node[Hie_CRS].HieCod,Tags->Txt[NumTag]);
 
          TagInd++;
         }
+
+   /***** Insert all tags in tst_question_tags *****/
+   Tag_DB_AddTagsToQst (QstCod,TagInd,TagCods);
   }
 
 /*****************************************************************************/
@@ -25,6 +25,8 @@
 /*********************************** Headers *********************************/
 /*****************************************************************************/
 
+#include <stdio.h>		// For snprintf
+
 #include "swad_database.h"
 #include "swad_global.h"
 #include "swad_tag.h"
@@ -54,19 +56,36 @@ long Tag_DB_CreateNewTag (long HieCod,const char *TagTxt)
   }
 
 /*****************************************************************************/
-/*************************** Add tag to a question ***************************/
+/************************** Add tags to a question ***************************/
 /*****************************************************************************/
 
-void Tag_DB_AddTagToQst (long QstCod,long TagCod,unsigned TagInd)
+void Tag_DB_AddTagsToQst (long QstCod,unsigned NumTags,const long TagCods[])
   {
-   DB_QueryINSERT ("can not create tag",
+   char Values[Tag_MAX_TAGS_PER_QUESTION * (1 + 1 + Cns_MAX_DIGITS_LONG + 1 +
+						   Cns_MAX_DIGITS_LONG + 1 +
+						   Cns_MAX_DIGITS_UINT + 1) + 1];
+   size_t Length = 0;
+   unsigned TagInd;
+
+   if (!NumTags)
+      return;
+
+   /***** Build list of rows, one for each tag *****/
+   for (TagInd = 0;
+	TagInd < NumTags && TagInd < Tag_MAX_TAGS_PER_QUESTION;
+	TagInd++)
+      Length += snprintf (&Values[Length],sizeof (Values) - Length,"%s(%ld,%ld,%u)",
+			  TagInd ? "," :
+				   "",
+			  QstCod,TagCods[TagInd],TagInd);
+
+   /***** Insert all tags with one query *****/
+   DB_QueryINSERT ("can not create tags",
 		   "INSERT INTO tst_question_tags"
 		   " (QstCod,TagCod,TagInd)"
 		   " VALUES"
-		   " (%ld,%ld,%u)",
-		   QstCod,
-		   TagCod,
-		   TagInd);
+		   " %s",
+		   Values);
   }
 
 /*****************************************************************************/
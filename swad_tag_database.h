@@ -36,7 +36,7 @@
 /*****************************************************************************/
 
 long Tag_DB_CreateNewTag (long HieCod,const char *TagTxt);
-void Tag_DB_AddTagToQst (long QstCod,long TagCod,unsigned TagInd);
+void Tag_DB_AddTagsToQst (long QstCod,unsigned NumTags,const long TagCods[]);
 void Tag_DB_CreateTmpTableQuestionsWithTag (long TagCod);
 void Tag_DB_DropTmpTableQuestionsWithTag (void);
 void Tag_DB_ComplexRenameTag (long TagCodOldTxt,long ExistingTagCodNewTxt);
@@ -521,6 +521,9 @@ static void Tst_GetQuestionsForNewTest (struct Qst_Questions *Qsts,
    MYSQL_ROW row;
    Qst_AnswerType_t AnswerType;
    Qst_Shuffle_t Shuffle;
+   unsigned NumCandidates;
+   unsigned *Indexes;
+   unsigned long long RandomState;
    unsigned QstInd;
 
    /***** Trivial check: number of questions *****/
@@ -528,15 +531,25 @@ static void Tst_GetQuestionsForNewTest (struct Qst_Questions *Qsts,
        Qsts->NumQsts > TstCfg_MAX_QUESTIONS_PER_TEST)
       Err_ShowErrorAndExit ("Wrong number of questions.");
 
-   /***** Get questions and answers from database *****/
-   Print->NumQsts.All =
-   Qsts->NumQsts = Qst_DB_GetQstsForNewTestPrint (&mysql_res,Qsts);
+   /***** Get all candidate questions from database *****/
+   NumCandidates = Qst_DB_GetQstsForNewTestPrint (&mysql_res,Qsts);
+   if (Qsts->NumQsts > NumCandidates)
+      Qsts->NumQsts = NumCandidates;
+   Print->NumQsts.All = Qsts->NumQsts;
+
+   /***** Draw the questions of the test *****/
+   if ((Indexes = malloc ((NumCandidates ? NumCandidates :
+					   1) * sizeof (*Indexes))) == NULL)
+      Err_NotEnoughMemoryExit ();
+   RandomState = Qst_GetNewRandomSeed ();
+   Qst_DrawRandomSample (&RandomState,Indexes,NumCandidates,Qsts->NumQsts);
 
    for (QstInd = 0;
 	QstInd < Print->NumQsts.All;
 	QstInd++)
      {
       /* Get question row */
+      mysql_data_seek (mysql_res,(my_ulonglong) Indexes[QstInd]);
       row = mysql_fetch_row (mysql_res);
       /*
       QstCod	row[0]
@@ -582,6 +595,12 @@ static void Tst_GetQuestionsForNewTest (struct Qst_Questions *Qsts,
       Print->PrintedQsts[QstInd].Answer.Str[0] = '\0';
      }
 
+   /***** Free memory used for indexes *****/
+   free (Indexes);
+
+   /***** Free structure that stores the query result *****/
+   DB_FreeMySQLResult (&mysql_res);
+
    /***** Get if test print will be visible by teachers *****/
    Print->DenyOrAllowTchs = Par_GetParBool ("AllowTchs") ? DenAll_ALLOW :
 							   DenAll_DENY;
@@ -0,0 +1,221 @@
+// swad_trace.c: tracing spans of the phases of each request
+
+/*
+    SWAD (Shared Workspace At a Distance),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2026 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/********************************* Headers ***********************************/
+/*****************************************************************************/
+
+#include "swad_trace.h"
+
+#ifdef Cfg_TRACE_SPANS
+
+#include <linux/limits.h>	// For PATH_MAX
+#include <stdio.h>		// For fprintf, snprintf
+#include <sys/time.h>		// For gettimeofday
+#include <unistd.h>		// For getpid
+
+#include "swad_action.h"
+#include "swad_file.h"
+#include "swad_global.h"
+
+/*****************************************************************************/
+/***************************** Private constants *****************************/
+/*****************************************************************************/
+
+#define Trc_MAX_SPANS		1024	// Size of ring buffer. When full, oldest spans are overwritten
+#define Trc_MAX_DEPTH		  32	// Maximum number of nested open spans
+#define Trc_MAX_BYTES_NAME	  95	// Names (for example queries) are truncated to this length
+
+/*****************************************************************************/
+/******************************* Private types *******************************/
+/*****************************************************************************/
+
+struct Trc_Span
+  {
+   const char *Category;
+   char Name[Trc_MAX_BYTES_NAME + 1];
+   long long Begin;	// Microseconds since the epoch
+   long long Duration;	// In microseconds
+   unsigned Depth;
+  };
+
+/*****************************************************************************/
+/************** External global variables from others modules ****************/
+/*****************************************************************************/
+
+extern struct Globals Gbl;
+
+/*****************************************************************************/
+/************************* Private global variables **************************/
+/*****************************************************************************/
+
+static struct
+  {
+   struct Trc_Span Spans[Trc_MAX_SPANS];	// Ring buffer of finished spans
+   unsigned long NumSpans;			// Total number of finished spans
+   struct Trc_Span Open[Trc_MAX_DEPTH];		// Stack of open spans
+   unsigned Depth;				// Number of open spans (may exceed Trc_MAX_DEPTH)
+  } Trc_Trace =
+  {
+   .NumSpans = 0UL,
+   .Depth    = 0,
+  };
+
+/*****************************************************************************/
+/***************************** Private prototypes ****************************/
+/*****************************************************************************/
+
+static long long Trc_GetTime (void);
+static void Trc_WriteJSONString (FILE *FileTrace,const char *Str);
+
+/*****************************************************************************/
+/********************* Get current time in microseconds **********************/
+/*****************************************************************************/
+
+static long long Trc_GetTime (void)
+  {
+   struct timeval tv;
+
+   gettimeofday (&tv,NULL);
+   return (long long) tv.tv_sec * 1000000LL + (long long) tv.tv_usec;
+  }
+
+/*****************************************************************************/
+/******************************* Begin a span ********************************/
+/*****************************************************************************/
+
+void Trc_BeginSpan (const char *Category,const char *Name)
+  {
+   struct Trc_Span *Span;
+
+   if (Trc_Trace.Depth < Trc_MAX_DEPTH)
+     {
+      Span = &Trc_Trace.Open[Trc_Trace.Depth];
+      Span->Category = Category;
+      snprintf (Span->Name,sizeof (Span->Name),"%s",Name);	// Truncate long names
+      Span->Depth = Trc_Trace.Depth;
+      Span->Begin = Trc_GetTime ();
+     }
+   Trc_Trace.Depth++;
+  }
+
+/*****************************************************************************/
+/********************* End the most recently begun span **********************/
+/*****************************************************************************/
+
+void Trc_EndSpan (void)
+  {
+   struct Trc_Span *Span;
+
+   if (Trc_Trace.Depth == 0)	// No span open
+      return;
+
+   Trc_Trace.Depth--;
+   if (Trc_Trace.Depth < Trc_MAX_DEPTH)
+     {
+      Span = &Trc_Trace.Spans[Trc_Trace.NumSpans % Trc_MAX_SPANS];
+      *Span = Trc_Trace.Open[Trc_Trace.Depth];
+      Span->Duration = Trc_GetTime () - Span->Begin;
+      Trc_Trace.NumSpans++;
+     }
+  }
+
+/*****************************************************************************/
+/******************* Write spans of this request to a file *******************/
+/*****************************************************************************/
+
+// Spans are written in Trace Event Format,
+// so they can be loaded in chrome://tracing, Perfetto, etc.
+
+void Trc_WriteSpans (void)
+  {
+   char PathFileTrace[PATH_MAX + 1];
+   FILE *FileTrace;
+   unsigned long FirstSpan;
+   unsigned long NumSpan;
+   const struct Trc_Span *Span;
+   pid_t PID = getpid ();
+
+   /***** Spans not ended (for example when exiting on error) end now *****/
+   while (Trc_Trace.Depth)
+      Trc_EndSpan ();
+
+   if (Trc_Trace.NumSpans == 0)
+      return;
+
+   FirstSpan = Trc_Trace.NumSpans > Trc_MAX_SPANS ? Trc_Trace.NumSpans - Trc_MAX_SPANS :
+						    0UL;	// Older spans were overwritten
+
+   /***** Create file *****/
+   Fil_CreateDirIfNotExists (Cfg_PATH_TRACE_PRIVATE);
+   snprintf (PathFileTrace,sizeof (PathFileTrace),"%s/%lld-%d.json",
+	     Cfg_PATH_TRACE_PRIVATE,
+	     Trc_Trace.Spans[FirstSpan % Trc_MAX_SPANS].Begin,(int) PID);
+   if ((FileTrace = fopen (PathFileTrace,"wb")) == NULL)
+      return;	// Tracing must not disturb the request
+
+   /***** Write spans in ring buffer, from oldest to newest *****/
+   fprintf (FileTrace,"{\"otherData\":{\"ActCod\":%ld,\"DroppedSpans\":%lu},\n"
+		      "\"traceEvents\":[",
+	    Act_GetActCod (Gbl.Action.Act),FirstSpan);
+   for (NumSpan = FirstSpan;
+	NumSpan < Trc_Trace.NumSpans;
+	NumSpan++)
+     {
+      Span = &Trc_Trace.Spans[NumSpan % Trc_MAX_SPANS];
+      fprintf (FileTrace,"%s\n{\"ph\":\"X\",\"pid\":%d,\"tid\":%d,"
+			 "\"ts\":%lld,\"dur\":%lld,\"cat\":\"%s\",\"name\":",
+	       NumSpan == FirstSpan ? "" :
+				      ",",
+	       (int) PID,(int) PID,
+	       Span->Begin,Span->Duration,Span->Category);
+      Trc_WriteJSONString (FileTrace,Span->Name);
+      fprintf (FileTrace,",\"args\":{\"depth\":%u}}",Span->Depth);
+     }
+   fprintf (FileTrace,"\n]}\n");
+
+   fclose (FileTrace);
+  }
+
+/*****************************************************************************/
+/**************** Write a string quoted and escaped for JSON *****************/
+/*****************************************************************************/
+
+static void Trc_WriteJSONString (FILE *FileTrace,const char *Str)
+  {
+   unsigned char Ch;
+
+   fputc ('"',FileTrace);
+   for (;
+	(Ch = (unsigned char) *Str);
+	Str++)
+      if (Ch == '"' || Ch == '\\')
+	 fprintf (FileTrace,"\\%c",Ch);
+      else if (Ch < 0x20 || Ch >= 0x7f)	// Control or ISO-8859-1 (U+0080 to U+00FF)
+	 fprintf (FileTrace,"\\u%04x",(unsigned) Ch);
+      else
+	 fputc (Ch,FileTrace);
+   fputc ('"',FileTrace);
+  }
+
+#endif
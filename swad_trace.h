@@ -0,0 +1,52 @@
+// swad_trace.h: tracing spans of the phases of each request
+
+#ifndef _SWAD_TRC
+#define _SWAD_TRC
+/*
+    SWAD (Shared Workspace At a Distance),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2026 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/********************************* Headers ***********************************/
+/*****************************************************************************/
+
+#include "swad_config.h"
+
+/*****************************************************************************/
+/***************************** Public prototypes *****************************/
+/*****************************************************************************/
+
+// When Cfg_TRACE_SPANS is not defined, calls are removed at compile time
+
+#ifdef Cfg_TRACE_SPANS
+
+void Trc_BeginSpan (const char *Category,const char *Name);
+void Trc_EndSpan (void);
+void Trc_WriteSpans (void);
+
+#else
+
+#define Trc_BeginSpan(Category,Name)	((void) 0)
+#define Trc_EndSpan()			((void) 0)
+#define Trc_WriteSpans()		((void) 0)
+
+#endif
+
+#endif
@@ -47,7 +47,7 @@
 #include "swad_center_database.h"
 #include "swad_config.h"
 #include "swad_constant.h"
-#include "swad_connected_database.h"
+#include "swad_connected.h"
 #include "swad_country_database.h"
 #include "swad_course.h"
 #include "swad_database.h"
@@ -1737,12 +1737,15 @@ void Usr_ChkUsrGetUsrDataAndAdjustAction (void)
 		  Usr_SetMyPrefsAndRoles ();
 
 		  if (Gbl.Action.IsAJAXAutoRefresh)	// If refreshing ==> don't refresh LastTime in session
+		    {
 		     Ses_DB_UpdateSessionLastRefresh ();
+		     Con_RefreshMeInConnectedList ();
+		    }
 		  else
 		    {
 		     Act_AdjustCurrentAction ();
 		     Ses_DB_UpdateSession ();
-		     Con_DB_UpdateMeInConnectedList ();
+		     Con_UpdateMeInConnectedList ();
 		    }
 		  break;
 	       case Err_ERROR:
@@ -6284,6 +6287,7 @@ static void Usr_DrawClassPhoto (struct Usr_SelectedUsrs *SelectedUsrs,
      };
    unsigned NumUsr;
    struct Usr_Data UsrDat;
+   struct Pho_Sprite Sprite;
 
    if (Gbl.Usrs.LstUsrs[Role].NumUsrs)
      {
@@ -6295,6 +6299,11 @@ static void Usr_DrawClassPhoto (struct Usr_SelectedUsrs *SelectedUsrs,
 	 HTM_DIV_End ();
 	}
 
+      /***** Get the sprite sheet with the photos of all users,
+             so the class photo is downloaded as a single image *****/
+      if (ShowPhotos == Pho_PHOTOS_SHOW)
+	 Pho_BuildClassPhotoSprite (Role,&Sprite);
+
       /***** Initialize structure with user's data *****/
       Usr_UsrDataConstructor (&UsrDat);
 
@@ -6323,9 +6332,9 @@ static void Usr_DrawClassPhoto (struct Usr_SelectedUsrs *SelectedUsrs,
 
 	       /***** Show photo *****/
 	       if (ShowPhotos == Pho_PHOTOS_SHOW)
-		  Pho_ShowUsrPhotoIfAllowed (&UsrDat,
-					     ClassPhoto[ClassPhotoType][Gbl.Prefs.PhotoShape],
-					     Pho_ZOOM);
+		  Pho_ShowUsrPhotoInSprite (&UsrDat,&Sprite,NumUsr,
+					    ClassPhoto[ClassPhotoType][Gbl.Prefs.PhotoShape],
+					    Pho_ZOOM);
 
 	       /***** Photo foot *****/
 	       HTM_DIV_Begin ("class=\"CLASSPHOTO_CAPTION CLASSPHOTO_%s\"",
@@ -6355,6 +6364,10 @@ static void Usr_DrawClassPhoto (struct Usr_SelectedUsrs *SelectedUsrs,
 
       /***** Free memory used for user's data *****/
       Usr_UsrDataDestructor (&UsrDat);
+
+      /***** Free sprite sheet *****/
+      if (ShowPhotos == Pho_PHOTOS_SHOW)
+	 Pho_FreeClassPhotoSprite (&Sprite);
      }
   }
 
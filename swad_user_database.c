@@ -31,6 +31,7 @@
 #include "swad_database.h"
 #include "swad_error.h"
 #include "swad_global.h"
+#include "swad_search_index.h"
 #include "swad_user_database.h"
 
 /*****************************************************************************/
@@ -214,6 +215,23 @@ long Usr_DB_GetUsrCodFromIDPwd (const char *ID,const char *Password)
 		       Password);
   }
 
+/*****************************************************************************/
+/*********** Get events on which several users want to be notified ***********/
+/*****************************************************************************/
+// SubQueryUsrs is a list of users' codes separated by commas
+
+unsigned Usr_DB_GetNtfEventsOfUsrs (MYSQL_RES **mysql_res,const char *SubQueryUsrs)
+  {
+   return (unsigned)
+   DB_QuerySELECT (mysql_res,"can not get users' notification events",
+		   "SELECT UsrCod,"		// row[0]
+			  "NotifNtfEvents,"	// row[1]
+			  "EmailNtfEvents"	// row[2]
+		    " FROM usr_data"
+		   " WHERE UsrCod IN (%s)",
+		   SubQueryUsrs);
+  }
+
 /*****************************************************************************/
 /************ Get user's data from database giving a user's code *************/
 /*****************************************************************************/
@@ -1476,6 +1494,9 @@ void Usr_DB_RemoveUsrData (long UsrCod)
 		   "DELETE FROM usr_data"
 		   " WHERE UsrCod=%ld",
 		   UsrCod);
+
+   /***** Remove user's name from search index *****/
+   SchIdx_RemoveName (SchIdx_USR,UsrCod);
   }
 
 /*****************************************************************************/
@@ -51,6 +51,7 @@ long Usr_DB_GetUsrCodFromEmail (const char *Email);
 long Usr_DB_GetUsrCodFromEmailPwd (const char *Email,const char *Password);
 long Usr_DB_GetUsrCodFromID (const char *ID);
 long Usr_DB_GetUsrCodFromIDPwd (const char *ID,const char *Password);
+unsigned Usr_DB_GetNtfEventsOfUsrs (MYSQL_RES **mysql_res,const char *SubQueryUsrs);
 Exi_Exist_t Usr_DB_GetUsrDataFromUsrCod (MYSQL_RES **mysql_res,long UsrCod,
                                          Usr_GetPrefs_t GetPrefs);
 Exi_Exist_t Usr_DB_GetSomeUsrDataFromUsrCod (MYSQL_RES **mysql_res,long UsrCod);
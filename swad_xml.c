@@ -26,8 +26,8 @@
 /*****************************************************************************/
 
 #include <ctype.h>		// For isspace()
-#include <stddef.h>		// For NULL
-#include <stdlib.h>		// For free ()
+#include <stddef.h>		// For NULL, max_align_t
+#include <stdlib.h>		// For calloc (), free ()
 #include <string.h>		// For strlen (), etc.
 
 #include "swad_changelog.h"
@@ -37,18 +37,36 @@
 #include "swad_xml.h"
 
 /*****************************************************************************/
-/************************* Private global variables **************************/
+/***************************** Private constants *****************************/
 /*****************************************************************************/
 
-static const char *XML_Ptr;
+#define XML_ARENA_BLOCK_SIZE	(64 * 1024)	// Size of each block where elements and attributes are allocated
+
+/*****************************************************************************/
+/******************************* Private types *******************************/
+/*****************************************************************************/
+
+struct XMLArenaBlock
+  {
+   struct XMLArenaBlock *Next;
+   size_t Used;			// Bytes used in Data
+   max_align_t Data[];		// Aligned for any element or attribute
+  };
+
+struct XML_Parser
+  {
+   char *Ptr;			// Current position in XML buffer
+   struct XMLTree *Tree;	// Tree being built
+  };
 
 /*****************************************************************************/
 /***************************** Private prototypes ****************************/
 /*****************************************************************************/
 
-static void XML_GetElement (struct XMLElement *ParentElem);
-static void XML_GetAttributes (struct XMLElement *Elem);
-static void XML_SkipSpaces (void);
+static void XML_GetElement (struct XML_Parser *Parser,struct XMLElement *ParentElem);
+static void XML_GetAttributes (struct XML_Parser *Parser,struct XMLElement *Elem);
+static void XML_SkipSpaces (struct XML_Parser *Parser);
+static void *XML_AllocateInArena (struct XMLTree *Tree,size_t Size);
 
 /*****************************************************************************/
 /****** Write the start of an XML file with author and date of creation ******/
@@ -79,82 +97,83 @@ void XML_WriteEndFile (FILE *FileTgt,const char *Type)
 /****************** Get the content of XML root element **********************/
 /*****************************************************************************/
 
-void XML_GetTree (const char *XMLBuffer,struct XMLElement **XMLRootElem)
+void XML_GetTree (char *XMLBuffer,struct XMLTree *Tree)
   {
+   struct XML_Parser Parser;
+
    /***** Allocate space for the root element *****/
-   if ((*XMLRootElem = calloc ((size_t) 1,sizeof (**XMLRootElem))) == NULL)
-      Err_NotEnoughMemoryExit ();
+   Tree->Arena = NULL;
+   Tree->Root = XML_AllocateInArena (Tree,sizeof (*Tree->Root));
 
-   XML_Ptr = XMLBuffer;
-   XML_GetElement (*XMLRootElem);
+   /***** Parse XML buffer in a single pass *****/
+   Parser.Ptr  = XMLBuffer;
+   Parser.Tree = Tree;
+   XML_GetElement (&Parser,Tree->Root);
   }
 
 /*****************************************************************************/
 /******************* Get the content of an XML element ***********************/
 /*****************************************************************************/
 
-static void XML_GetElement (struct XMLElement *ParentElem)
+static void XML_GetElement (struct XML_Parser *Parser,struct XMLElement *ParentElem)
   {
    struct XMLElement *ChildElem;
-   const char *StartContent;
+   char *StartContent;
    const char *Ptr;
    size_t ContentLength;
    size_t EndTagNameLength;
    size_t TagLength;
+   char EndOfTagName;
    char ErrorTxt[128];
 
    /*
    <parent...>  element content  </parent>
               ^
-             XML_Ptr
+           Parser->Ptr
    */
    /* Skip spaces */
-   XML_SkipSpaces ();
+   XML_SkipSpaces (Parser);
 
-   StartContent = XML_Ptr;
+   StartContent = Parser->Ptr;
    ContentLength = strcspn (StartContent,"<");
-   XML_Ptr += ContentLength;
+   Parser->Ptr += ContentLength;
 
-   while (*XML_Ptr == '<')	// For each child until parent end tag
+   while (*Parser->Ptr == '<')	// For each child until parent end tag
      {
-      XML_Ptr++;
-      if (*XML_Ptr == '/')	// Parent end tag
+      Parser->Ptr++;
+      if (*Parser->Ptr == '/')	// Parent end tag
         {
          /*
          <parent>  element content  </parent>
                                      ^
-                                    XML_Ptr
+                                  Parser->Ptr
          */
          /***** Check tag name *****/
-         XML_Ptr++;
+         Parser->Ptr++;
          /*
          <parent>  element content  </parent>
                                       ^
-                                     XML_Ptr
+                                   Parser->Ptr
          */
-         EndTagNameLength = strcspn (XML_Ptr,">");
-         if (ParentElem->TagNameLength != EndTagNameLength)
-           {
-            snprintf (ErrorTxt,sizeof (ErrorTxt),
-	              "XML syntax error. Expect end tag &lt;/%s&gt;.",
-		      ParentElem->TagName);
-            Err_ShowErrorAndExit (ErrorTxt);
-           }
-         if (strncmp (ParentElem->TagName,XML_Ptr,EndTagNameLength))	// XML tags are case sensitive
+         EndTagNameLength = strcspn (Parser->Ptr,">");
+         if (ParentElem->TagNameLength != EndTagNameLength ||
+             strncmp (ParentElem->TagName,Parser->Ptr,EndTagNameLength))	// XML tags are case sensitive
            {
             snprintf (ErrorTxt,sizeof (ErrorTxt),
-	              "XML syntax error. Expect end tag &lt;/%s&gt;.",
-		      ParentElem->TagName);
+	              "XML syntax error. Expect end tag &lt;/%.*s&gt;.",
+		      (int) ParentElem->TagNameLength,
+		      ParentElem->TagName ? ParentElem->TagName :
+					    "");
             Err_ShowErrorAndExit (ErrorTxt);
            }
 
          // End of parent element found!
-         XML_Ptr += EndTagNameLength;
-         XML_Ptr++;
+         Parser->Ptr += EndTagNameLength;
+         Parser->Ptr++;
          /*
          <parent>  element content  </parent>
                                              ^
-                                            XML_Ptr
+                                          Parser->Ptr
          */
          /* Remove trailing spaces in content */
          for (Ptr = StartContent + ContentLength - 1;
@@ -163,36 +182,34 @@ static void XML_GetElement (struct XMLElement *ParentElem)
             if (!isspace ((int) *Ptr))
                break;
 
-         /* Copy content */
+         /* Content is not copied, it is ended in XML buffer
+            (the character after content has already been parsed) */
          if (ContentLength)
            {
-            if ((ParentElem->Content = malloc (ContentLength + 1)) == NULL)
-               Err_NotEnoughMemoryExit ();
-            strncpy (ParentElem->Content,StartContent,ContentLength);
-            ParentElem->Content[ContentLength] = '\0';
+            StartContent[ContentLength] = '\0';
+            ParentElem->Content = StartContent;
             ParentElem->ContentLength = ContentLength;
            }
 
          return;
         }
-      else if (*XML_Ptr == '!' ||
-               *XML_Ptr == '?')	// Skip <!...> and <?...>
+      else if (*Parser->Ptr == '!' ||
+               *Parser->Ptr == '?')	// Skip <!...> and <?...>
         {
-         TagLength = strcspn (XML_Ptr,">");
-         XML_Ptr += TagLength;
-         if (*XML_Ptr == '>')
-           XML_Ptr++;
+         TagLength = strcspn (Parser->Ptr,">");
+         Parser->Ptr += TagLength;
+         if (*Parser->Ptr == '>')
+           Parser->Ptr++;
         }
       else		// New start tag
         {
          /*
          <parent><child attribute1="value" attribute2="value">...</child>...</parent>
                   ^
-                 XML_Ptr
+               Parser->Ptr
          */
          /***** Allocate space for the child element *****/
-         if ((ChildElem = calloc ((size_t) 1,sizeof (*ChildElem))) == NULL)
-            Err_NotEnoughMemoryExit ();
+         ChildElem = XML_AllocateInArena (Parser->Tree,sizeof (*ChildElem));
 
          /***** Adjust XML elements pointers *****/
          if (ParentElem->FirstChild)	// This child is a brother of a former child
@@ -202,65 +219,70 @@ static void XML_GetElement (struct XMLElement *ParentElem)
          ParentElem->LastChild = ChildElem;
 
          /***** Get child tag name *****/
-         ChildElem->TagNameLength = strcspn (XML_Ptr,">/ \t");
-         if ((ChildElem->TagName = malloc (ChildElem->TagNameLength + 1)) == NULL)
-            Err_NotEnoughMemoryExit ();
-         strncpy (ChildElem->TagName,XML_Ptr,ChildElem->TagNameLength);
-         ChildElem->TagName[ChildElem->TagNameLength] = '\0';
-         XML_Ptr += ChildElem->TagNameLength;
+         ChildElem->TagName = Parser->Ptr;
+         ChildElem->TagNameLength = strcspn (Parser->Ptr,">/ \t");
+         Parser->Ptr += ChildElem->TagNameLength;
 
          /*
          <parent><child attribute1="value" attribute2="value">...</child>...</parent>
                        ^
-                      XML_Ptr
+                    Parser->Ptr
          */
+         /* End tag name in XML buffer,
+            keeping the character to check if end of start tag found */
+         EndOfTagName = *Parser->Ptr;
+         *Parser->Ptr = '\0';
+
          /* Check if end of start tag found */
-         if (*XML_Ptr == '>')	// End of start tag
+         if (EndOfTagName == '>')	// End of start tag
            {
-            XML_Ptr++;
+            Parser->Ptr++;
             /*
             <parent><child>...</child>...</parent>
                            ^
-                          XML_Ptr
+                        Parser->Ptr
             */
-            XML_GetElement (ChildElem);
+            XML_GetElement (Parser,ChildElem);
            }
-         else if (*XML_Ptr == '/')	// Unary tag?
+         else if (EndOfTagName == '/')	// Unary tag?
            {
-            XML_Ptr++;
+            Parser->Ptr++;
             /*
             <parent><child/>...</parent>
                            ^
-                          XML_Ptr
+                        Parser->Ptr
             */
-            if (*XML_Ptr != '>')	// Here it should be the end of start tag
+            if (*Parser->Ptr != '>')	// Here it should be the end of start tag
                Err_ShowErrorAndExit ("XML syntax error. Expect &gt; ending unary tag.");
-            XML_Ptr++;
+            Parser->Ptr++;
             /*
             <parent><child/>...</parent>
                             ^
-                           XML_Ptr
+                         Parser->Ptr
             */
            }
+         else if (EndOfTagName == '\0')
+            Err_ShowErrorAndExit ("XML syntax error. Unexpected end of file.");
          else	// Begin of an attribute
            {
+            Parser->Ptr++;	// Skip space or tab after tag name
             /*
             <parent><child attribute1="value" attribute2="value">...</child>...</parent>
-                          ^
-                         XML_Ptr
+                           ^
+                        Parser->Ptr
             */
-            XML_GetAttributes (ChildElem);
+            XML_GetAttributes (Parser,ChildElem);
             /*
             <parent><child attribute1="value" attribute2="value">...</child>...</parent>
                                                                  ^
-                                                                XML_Ptr
+                                                              Parser->Ptr
             */
-            XML_GetElement (ChildElem);
+            XML_GetElement (Parser,ChildElem);
            }
         }
 
       /* Skip spaces after the ">" character of the tag */
-      XML_SkipSpaces ();
+      XML_SkipSpaces (Parser);
      }
   }
 
@@ -268,40 +290,41 @@ static void XML_GetElement (struct XMLElement *ParentElem)
 /******************* Get the attributes of a start tag ***********************/
 /*****************************************************************************/
 
-static void XML_GetAttributes (struct XMLElement *Elem)
+static void XML_GetAttributes (struct XML_Parser *Parser,struct XMLElement *Elem)
   {
    struct XMLAttribute *Attribute;
    bool EndOfStartTag = false;
+   char Quote;
    char ErrorTxt[256];
 
    /*
    <parent><child attribute1="value" attribute2="value">...</child>...</parent>
-                 ^
-                 |
-                XML_Ptr
+                  ^
+                  |
+              Parser->Ptr
    */
    do
      {
       /* Skip spaces */
-      XML_SkipSpaces ();
+      XML_SkipSpaces (Parser);
 
-      if (*XML_Ptr == '/')	// End of unary tag?
+      if (*Parser->Ptr == '/')	// End of unary tag?
         {
-         XML_Ptr++;
-         if (*XML_Ptr == '>')
+         Parser->Ptr++;
+         if (*Parser->Ptr == '>')
            {
-            XML_Ptr++;
+            Parser->Ptr++;
             EndOfStartTag = true;
            }
          else
             Err_ShowErrorAndExit ("XML syntax error. Expect &gt; ending unary tag with attributes.");
         }
-      else if (*XML_Ptr == '>')	// End of start tag?
+      else if (*Parser->Ptr == '>')	// End of start tag?
         {
-         XML_Ptr++;
+         Parser->Ptr++;
          EndOfStartTag = true;
         }
-      else if (*XML_Ptr == '\0')
+      else if (*Parser->Ptr == '\0')
          Err_ShowErrorAndExit ("XML syntax error. Unexpected end of file.");
       else
         {
@@ -309,11 +332,10 @@ static void XML_GetAttributes (struct XMLElement *Elem)
          <parent><child attribute1="value" attribute2="value">...</child>...</parent>
                         ^
                         |
-                       XML_Ptr
+                    Parser->Ptr
          */
          /***** Allocate space for the attribute *****/
-         if ((Attribute = calloc ((size_t) 1,sizeof (*Attribute))) == NULL)
-            Err_NotEnoughMemoryExit ();
+         Attribute = XML_AllocateInArena (Parser->Tree,sizeof (*Attribute));
 
          /***** Adjust XML element and attribute pointers *****/
          if (Elem->FirstAttribute)	// This attribute is a brother of a former attribute in current element
@@ -323,31 +345,24 @@ static void XML_GetAttributes (struct XMLElement *Elem)
          Elem->LastAttribute = Attribute;
 
          /***** Get attribute name *****/
-         Attribute->AttributeNameLength = strcspn (XML_Ptr,"=");
-         if ((Attribute->AttributeName = malloc (Attribute->AttributeNameLength + 1)) == NULL)
-            Err_NotEnoughMemoryExit ();
-         strncpy (Attribute->AttributeName,XML_Ptr,Attribute->AttributeNameLength);
-         Attribute->AttributeName[Attribute->AttributeNameLength] = '\0';
-         XML_Ptr += Attribute->AttributeNameLength;
+         Attribute->AttributeName = Parser->Ptr;
+         Attribute->AttributeNameLength = strcspn (Parser->Ptr,"=");
+         Parser->Ptr += Attribute->AttributeNameLength;
          /* End of attribute name:
          <parent><child attribute1="value" attribute2="value">...</child>...</parent>
                                   ^
                                   |
-                                 XML_Ptr
+                              Parser->Ptr
          */
+         if (*Parser->Ptr == '\0')
+            Err_ShowErrorAndExit ("XML syntax error. Unexpected end of file.");
+         *Parser->Ptr = '\0';	// End attribute name in XML buffer
+
          /***** Get attribute content *****/
-         XML_Ptr++;
-         if (*XML_Ptr == '\"')
-           {
-            XML_Ptr++;
-            Attribute->ContentLength = strcspn (XML_Ptr,"\"");
-           }
-         else if (*XML_Ptr == '\'')
-           {
-            XML_Ptr++;
-            Attribute->ContentLength = strcspn (XML_Ptr,"'");
-           }
-         else
+         Parser->Ptr++;
+         Quote = *Parser->Ptr;
+         if (Quote != '\"' &&
+             Quote != '\'')
            {
             snprintf (ErrorTxt,sizeof (ErrorTxt),
 	              "XML syntax error after attribute &quot;%s&quot;"
@@ -355,19 +370,21 @@ static void XML_GetAttributes (struct XMLElement *Elem)
                       Attribute->AttributeName,Elem->TagName);
             Err_ShowErrorAndExit (ErrorTxt);
            }
-
-         if ((Attribute->Content = malloc (Attribute->ContentLength + 1)) == NULL)
-            Err_NotEnoughMemoryExit ();
-         strncpy (Attribute->Content,XML_Ptr,Attribute->ContentLength);
-         Attribute->Content[Attribute->ContentLength] = '\0';
-         XML_Ptr += Attribute->ContentLength;
-
-         XML_Ptr++;
+         Parser->Ptr++;
+         Attribute->Content = Parser->Ptr;
+         Attribute->ContentLength = strcspn (Parser->Ptr,Quote == '\"' ? "\"" :
+								        "'");
+         Parser->Ptr += Attribute->ContentLength;
+         if (*Parser->Ptr == '\0')
+            Err_ShowErrorAndExit ("XML syntax error. Unexpected end of file.");
+         *Parser->Ptr = '\0';	// End attribute content in XML buffer
+
+         Parser->Ptr++;
          /* End of attribute content
          <parent><child attribute1="value" attribute2="value">...</child>...</parent>
                                           ^
                                           |
-                                         XML_Ptr
+                                      Parser->Ptr
          */
         }
      }
@@ -378,22 +395,53 @@ static void XML_GetAttributes (struct XMLElement *Elem)
 /****************** Skip spaces while parsing XML buffer *********************/
 /*****************************************************************************/
 
-static void XML_SkipSpaces (void)
+static void XML_SkipSpaces (struct XML_Parser *Parser)
   {
-   while (isspace ((int) *XML_Ptr))
-      XML_Ptr++;
+   while (isspace ((int) *Parser->Ptr))
+      Parser->Ptr++;
+  }
+
+/*****************************************************************************/
+/************* Allocate zeroed space for an element or attribute *************/
+/*****************************************************************************/
+// All elements and attributes of a tree are freed at once with XML_FreeTree
+
+static void *XML_AllocateInArena (struct XMLTree *Tree,size_t Size)
+  {
+   struct XMLArenaBlock *Block;
+   void *Ptr;
+
+   /***** Round size to keep alignment *****/
+   Size = (Size + sizeof (max_align_t) - 1) / sizeof (max_align_t) * sizeof (max_align_t);
+
+   /***** Allocate a new block if there is no space left in current block *****/
+   if (Tree->Arena == NULL ||
+       Tree->Arena->Used + Size > XML_ARENA_BLOCK_SIZE)
+     {
+      // calloc sets the content of the block to zero
+      if ((Block = calloc ((size_t) 1,sizeof (*Block) + XML_ARENA_BLOCK_SIZE)) == NULL)
+	 Err_NotEnoughMemoryExit ();
+      Block->Next = Tree->Arena;
+      Tree->Arena = Block;
+     }
+
+   /***** Get space in current block *****/
+   Ptr = (char *) Tree->Arena->Data + Tree->Arena->Used;
+   Tree->Arena->Used += Size;
+
+   return Ptr;
   }
 
 /*****************************************************************************/
 /**************************** Print an XML element ***************************/
 /*****************************************************************************/
 
-void XML_PrintTree (struct XMLElement *ParentElem)
+void XML_PrintTree (const struct XMLElement *ParentElem)
   {
    static int Level = -1;
-   struct XMLElement *ChildElem;
-   struct XMLElement *NextBrother;
-   struct XMLAttribute *Attribute;
+   const struct XMLElement *ChildElem;
+   const struct XMLElement *NextBrother;
+   const struct XMLAttribute *Attribute;
    int i;
 
    Level++;
@@ -465,7 +513,7 @@ void XML_PrintTree (struct XMLElement *ParentElem)
 /********** Get attribute "yes"/"no" from an XML element in a tree ***********/
 /*****************************************************************************/
 
-bool XML_GetAttributteYesNoFromXMLTree (struct XMLAttribute *Attribute)
+bool XML_GetAttributteYesNoFromXMLTree (const struct XMLAttribute *Attribute)
   {
    if (!Attribute->Content)
       Err_ShowErrorAndExit ("XML attribute yes/no not found.");
@@ -480,49 +528,23 @@ bool XML_GetAttributteYesNoFromXMLTree (struct XMLAttribute *Attribute)
   }
 
 /*****************************************************************************/
-/************ Free the memory allocated for an XML element *******************/
+/***************** Free the memory allocated for an XML tree *****************/
 /*****************************************************************************/
 
-void XML_FreeTree (struct XMLElement *ParentElem)
+void XML_FreeTree (struct XMLTree *Tree)
   {
-   struct XMLElement *ChildElem;
-   struct XMLElement *NextElemBrother;
-   struct XMLAttribute *Attribute;
-   struct XMLAttribute *NextAttrib;
-
-   /***** Free memory allocated for children *****/
-   ChildElem = ParentElem->FirstChild;
-   while (ChildElem)
-     {
-      NextElemBrother = ChildElem->NextBrother;
-      XML_FreeTree (ChildElem);
-      ChildElem = NextElemBrother;
-     }
-
-   /***** Free memory allocated for TagName *****/
-   if (ParentElem->TagName)
-     {
-      free (ParentElem->TagName);
-      ParentElem->TagName = NULL;
-      ParentElem->TagNameLength = (size_t) 0;
-     }
+   struct XMLArenaBlock *Block;
+   struct XMLArenaBlock *NextBlock;
 
-   /***** Free memory allocated for attributes *****/
-   Attribute = ParentElem->FirstAttribute;
-   while (Attribute)
+   /***** Free all blocks where elements and attributes were allocated *****/
+   for (Block = Tree->Arena;
+	Block != NULL;
+	Block = NextBlock)
      {
-      NextAttrib = Attribute->Next;
-      free (Attribute->AttributeName);
-      free (Attribute->Content);
-      free (Attribute);
-      Attribute = NextAttrib;
+      NextBlock = Block->Next;
+      free (Block);
      }
 
-   /***** Free memory allocated for Content *****/
-   if (ParentElem->Content)
-     {
-      free (ParentElem->Content);
-      ParentElem->Content = NULL;
-      ParentElem->ContentLength = (size_t) 0;
-     }
+   Tree->Arena = NULL;
+   Tree->Root = NULL;
   }
@@ -27,12 +27,16 @@
 /********************************** Headers **********************************/
 /*****************************************************************************/
 
+#include <stdbool.h>	// For boolean type
 #include <stdio.h>	// For FILE *
 
 /*****************************************************************************/
 /******************************** Public types *******************************/
 /*****************************************************************************/
 
+/* Names and contents are not copied:
+   they point to the XML buffer, where they are ended with '\0' while parsing,
+   so the buffer must not be freed before the tree */
 struct XMLAttribute
   {
    struct XMLAttribute *Next;
@@ -55,6 +59,14 @@ struct XMLElement
    size_t ContentLength;
   };
 
+struct XMLArenaBlock;	// Elements and attributes are allocated in blocks
+
+struct XMLTree
+  {
+   struct XMLElement *Root;
+   struct XMLArenaBlock *Arena;
+  };
+
 /*****************************************************************************/
 /****************************** Public prototypes ****************************/
 /*****************************************************************************/
@@ -62,9 +74,9 @@ struct XMLElement
 void XML_WriteStartFile (FILE *FileTgt,const char *Type);
 void XML_WriteEndFile (FILE *FileTgt,const char *Type);
 
-void XML_GetTree (const char *XMLBuffer,struct XMLElement **XMLRootElem);
-void XML_PrintTree (struct XMLElement *ParentElem);
-bool XML_GetAttributteYesNoFromXMLTree (struct XMLAttribute *Attribute);
-void XML_FreeTree (struct XMLElement *ParentElem);
+void XML_GetTree (char *XMLBuffer,struct XMLTree *Tree);
+void XML_PrintTree (const struct XMLElement *ParentElem);
+bool XML_GetAttributteYesNoFromXMLTree (const struct XMLAttribute *Attribute);
+void XML_FreeTree (struct XMLTree *Tree);
 
 #endif
@@ -30,11 +30,11 @@
 #include <errno.h>		// For errno
 #include <linux/limits.h>	// For PATH_MAX
 #include <stdio.h>		// For asprintf
-#include <stdlib.h>		// For system...
+#include <stdlib.h>		// For free
 #include <string.h>		// For string functions...
-#include <sys/stat.h>		// For mkdir...
-#include <sys/types.h>		// For mkdir...
-#include <unistd.h>		// For chdir...
+#include <sys/stat.h>		// For lstat...
+#include <sys/types.h>		// For lstat...
+#include <unistd.h>		// For lstat...
 
 #include "swad_action_list.h"
 #include "swad_alert.h"
@@ -51,6 +51,7 @@
 #include "swad_string.h"
 #include "swad_theme.h"
 #include "swad_zip.h"
+#include "swad_zip_writer.h"
 
 /*****************************************************************************/
 /***************************** Private constants *****************************/
@@ -70,7 +71,6 @@ extern struct Globals Gbl;
 /*****************************************************************************/
 
 static ZIP_CreateZIP_t ZIP_CreateZIP = ZIP_DONT_CREATE_ZIP;
-static char ZIP_TmpDir[NAME_MAX + 1];
 
 /*****************************************************************************/
 /***************************** Private prototypes ****************************/
@@ -78,11 +78,15 @@ static char ZIP_TmpDir[NAME_MAX + 1];
 
 static void ZIP_PutLinkToCreateZIPAsgWrkPars (__attribute__((unused)) void *Args);
 
-static void ZIP_CreateTmpDirForCompression (void);
-static void ZIP_CreateDirCompressionUsr (struct Usr_Data *UsrDat);
+static void ZIP_AddUsrWorksToArchive (struct ZIPWri_Archive *Archive,
+				     struct Usr_Data *UsrDat);
+static bool ZIP_CheckIfNameIsInArchive (const struct ZIPWri_Archive *Archive,
+					const char *NameInZIP);
 
 static void ZIP_CompressFolderIntoZIP (void);
-static unsigned long long ZIP_CloneDir (const char *Path,const char *PathClone,const char *PathInTree);
+static void ZIP_AddDirToArchive (struct ZIPWri_Archive *Archive,
+				 const char *Path,const char *PathInTree,
+				 const char *NameInZIP);
 static void ZIP_ShowLinkToDownloadZIP (const char *FileName,const char *URL,
                                        off_t FileSize,unsigned long long UncompressedSize);
 
@@ -130,31 +134,24 @@ inline ZIP_CreateZIP_t ZIP_GetCreateZIP (void)
 void ZIP_CreateZIPAsgWrk (void)
   {
    extern const char *Txt_works_ZIP_FILE_NAME;
+   struct ZIPWri_Archive Archive;
    struct Usr_Data UsrDat;
    const char *Ptr;
-   char StrZip[128 + PATH_MAX];
-   char Path[PATH_MAX + 1 +
-             NAME_MAX + 1 +
-	     NAME_MAX + 1];
-   int Result;
    char FileNameZIP[NAME_MAX + 1];
    char PathFileZIP[PATH_MAX + 1];
    struct stat FileStatus;
    char URLWithSpaces[PATH_MAX + 1];
    char URL[PATH_MAX + 1];
 
-   /***** Create zip file
+   /***** Build the list of files in zip file
 	  with the assignments and works
 	  of the selected users *****/
-   /* Create temporary directory
-      for the compression of assignments and works */
-   ZIP_CreateTmpDirForCompression ();
+   ZIPWri_ArchiveConstructor (&Archive);
 
    /* Initialize structure with user's data */
    Usr_UsrDataConstructor (&UsrDat);
 
-   /* Create temporary directory for each selected user
-      inside the directory used for compression */
+   /* Add a folder for each selected user */
    for (Ptr = Gbl.Usrs.Selected.List[Rol_UNK];
         *Ptr;
        )
@@ -168,7 +165,7 @@ void ZIP_CreateZIPAsgWrk (void)
                                                    Usr_DONT_GET_PREFS,
                                                    Usr_DONT_GET_ROLE_IN_CRS) == Exi_EXISTS)
 	 if (Enr_CheckIfUsrBelongsToCurrentCrs (&UsrDat) == Usr_BELONG)
-	    ZIP_CreateDirCompressionUsr (&UsrDat);
+	    ZIP_AddUsrWorksToArchive (&Archive,&UsrDat);
      }
 
    /* Free memory used for user's data */
@@ -178,14 +175,6 @@ void ZIP_CreateZIPAsgWrk (void)
           used to download the zip file *****/
    Brw_CreateDirDownloadTmp ();
 
-   /***** Relative path of the directory with the works to compress *****/
-   snprintf (Path,sizeof (Path),"%s/%s",Cfg_PATH_ZIP_PRIVATE,ZIP_TmpDir);
-
-   /***** Change to directory of the assignments and works
-          in order to start the path in the zip file from there *****/
-   if (chdir (Path))
-      Err_ShowErrorAndExit ("Can not change to temporary folder for compression.");
-
    /***** Create public zip file with the assignment and works *****/
    snprintf (FileNameZIP,sizeof (FileNameZIP),"%s.zip",Txt_works_ZIP_FILE_NAME);
    snprintf (PathFileZIP,sizeof (PathFileZIP),"%s/%s/%s/%s",
@@ -193,78 +182,49 @@ void ZIP_CreateZIPAsgWrk (void)
              Gbl.FileBrowser.TmpPubDir.L,
              Gbl.FileBrowser.TmpPubDir.R,
              FileNameZIP);
-   snprintf (StrZip,sizeof (StrZip),"nice -n 19 zip -q -r '%s' *",
-             PathFileZIP);
-   Result = system (StrZip);
-
-   /***** Return to the CGI directory *****/
-   if (chdir (Cfg_PATH_CGI_BIN))
-      Err_ShowErrorAndExit ("Can not change to cgi-bin folder.");
+   if (ZIPWri_WriteArchive (&Archive,PathFileZIP) == Err_ERROR)
+      Err_ShowErrorAndExit ("Can not compress files into zip file.");
 
-   /***** If the zip command has been sucessful, write the link to zip file *****/
-   if (Result == 0)
+   /***** Write the link to zip file *****/
+   /* Get file size */
+   if (lstat (PathFileZIP,&FileStatus))	// On success ==> 0 is returned
+      Err_ShowErrorAndExit ("Can not get information about a file or folder.");
+   else
      {
-      /***** Get file size *****/
-      if (lstat (PathFileZIP,&FileStatus))	// On success ==> 0 is returned
-	 Err_ShowErrorAndExit ("Can not get information about a file or folder.");
-      else
-	{
-	 /***** Create URL pointing to ZIP file *****/
-	 snprintf (URLWithSpaces,sizeof (URLWithSpaces),"%s/%s/%s/%s",
-		   Cfg_URL_FILE_BROWSER_TMP_PUBLIC,
-		   Gbl.FileBrowser.TmpPubDir.L,
-		   Gbl.FileBrowser.TmpPubDir.R,
-		   FileNameZIP);
-	 Str_CopyStrChangingSpaces (URLWithSpaces,URL,PATH_MAX);	// In HTML, URL must have no spaces
-
-	 /****** Link to download file *****/
-	 ZIP_ShowLinkToDownloadZIP (FileNameZIP,URL,FileStatus.st_size,0);
-	}
+      /* Create URL pointing to ZIP file */
+      snprintf (URLWithSpaces,sizeof (URLWithSpaces),"%s/%s/%s/%s",
+		Cfg_URL_FILE_BROWSER_TMP_PUBLIC,
+		Gbl.FileBrowser.TmpPubDir.L,
+		Gbl.FileBrowser.TmpPubDir.R,
+		FileNameZIP);
+      Str_CopyStrChangingSpaces (URLWithSpaces,URL,PATH_MAX);	// In HTML, URL must have no spaces
+
+      /* Link to download file */
+      ZIP_ShowLinkToDownloadZIP (FileNameZIP,URL,FileStatus.st_size,0);
      }
-   else
-      Err_ShowErrorAndExit ("Can not compress files into zip file.");
 
-   /***** Remove the directory of compression *****/
-   Fil_RemoveTree (Path);
+   /***** Free list of files in zip file *****/
+   ZIPWri_ArchiveDestructor (&Archive);
   }
 
 /*****************************************************************************/
-/********* Create temporary directory to put the works to compress ***********/
+/************ Add a user's works zone to the list of files in zip ************/
+/************ inside a folder that identifies the user            ************/
 /*****************************************************************************/
 
-static void ZIP_CreateTmpDirForCompression (void)
-  {
-   char PathDirTmp[PATH_MAX + 1];
-
-   /***** If the private directory does not exist, create it *****/
-   Fil_CreateDirIfNotExists (Cfg_PATH_ZIP_PRIVATE);
-
-   /***** Create a new temporary directory *****/
-   Str_Copy (ZIP_TmpDir,Cry_GetUniqueNameEncrypted (),sizeof (ZIP_TmpDir) - 1);
-   snprintf (PathDirTmp,sizeof (PathDirTmp),"%s/%s",
-	     Cfg_PATH_ZIP_PRIVATE,ZIP_TmpDir);
-   if (mkdir (PathDirTmp,(mode_t) 0xFFF))
-      Err_ShowErrorAndExit ("Can not create temporary folder for compression.");
-  }
-
-/*****************************************************************************/
-/**************** Create link to a user's works zone        ******************/
-/**************** in the temporary directory of compression ******************/
-/*****************************************************************************/
-
-static void ZIP_CreateDirCompressionUsr (struct Usr_Data *UsrDat)
+static void ZIP_AddUsrWorksToArchive (struct ZIPWri_Archive *Archive,
+				     struct Usr_Data *UsrDat)
   {
    char FullNameAndUsrID[NAME_MAX + 1];
    char PathFolderUsrInsideCrs[128 + PATH_MAX + NAME_MAX];
-   char LinkTmpUsr[PATH_MAX + 1];
-   char Link[PATH_MAX + 1 + Cns_MAX_DIGITS_UINT + 1];
+   char NameInZIP[NAME_MAX + 1 + Cns_MAX_DIGITS_UINT + 1];
+   struct stat FileStatus;
    unsigned NumTry;
-   Err_SuccessOrError_t ErrorOrSuccess;
 
-   /***** Create a link in the tree of compression
+   /***** Create a folder in zip file
           with a name that identifies the owner
           of the assignments and works *****/
-   /* Create link name for this user */
+   /* Create folder name for this user */
    Str_Copy (FullNameAndUsrID,UsrDat->Surname1,sizeof (FullNameAndUsrID) - 1);
    if (UsrDat->Surname1[0] &&
        UsrDat->Surname2[0])
@@ -285,30 +245,46 @@ static void ZIP_CreateDirCompressionUsr (struct Usr_Data *UsrDat)
                   sizeof (FullNameAndUsrID) - 1);	// First user's ID
    Str_ConvertToValidFileName (FullNameAndUsrID);
 
-   /* Create path to folder and link */
+   /* Path to user's folder */
    snprintf (PathFolderUsrInsideCrs,sizeof (PathFolderUsrInsideCrs),
 	     "%s/usr/%02u/%ld",
 	     Gbl.Crs.Path.AbsPriv,(unsigned) (UsrDat->UsrCod % 100),UsrDat->UsrCod);
-   snprintf (LinkTmpUsr,sizeof (LinkTmpUsr),"%s/%s/%s",
-	     Cfg_PATH_ZIP_PRIVATE,ZIP_TmpDir,FullNameAndUsrID);
+   if (lstat (PathFolderUsrInsideCrs,&FileStatus) ||	// On success ==> 0 is returned
+       !S_ISDIR (FileStatus.st_mode))
+      return;	// This user has no assignments or works
+
+   /* If name exists ==> a former user share the same name and ID
+      (probably a unique user has created two or more accounts) */
+   Str_Copy (NameInZIP,FullNameAndUsrID,sizeof (NameInZIP) - 1);
+   for (NumTry = 2;
+	ZIP_CheckIfNameIsInArchive (Archive,NameInZIP);
+	NumTry++)
+      snprintf (NameInZIP,sizeof (NameInZIP),"%s-%u",FullNameAndUsrID,NumTry);
+
+   /***** Add user's folder and its contents *****/
+   ZIPWri_AddFolder (Archive,NameInZIP,&FileStatus);
+   ZIP_AddDirToArchive (Archive,PathFolderUsrInsideCrs,NULL,NameInZIP);
+  }
 
-   /* Try to create a link named LinkTmpUsr to PathFolderUsrInsideCrs */
-   if (symlink (PathFolderUsrInsideCrs,LinkTmpUsr))
-     {
-      for (ErrorOrSuccess = Err_ERROR, NumTry = 2;
-	   ErrorOrSuccess == Err_ERROR && errno == EEXIST && NumTry<=1000;
-	   NumTry++)
-	{
-	 // Link exists ==> a former user share the same name and ID
-	 // (probably a unique user has created two or more accounts)
-	 snprintf (Link,sizeof (Link),"%s-%u",LinkTmpUsr,NumTry);
-	 if (symlink (PathFolderUsrInsideCrs,Link) == 0)
-	    ErrorOrSuccess = Err_SUCCESS;
-	}
+/*****************************************************************************/
+/************** Check if a name is already used in zip file ******************/
+/*****************************************************************************/
 
-      if (ErrorOrSuccess == Err_ERROR)
-	 Err_ShowErrorAndExit ("Can not create temporary link for compression.");
-     }
+static bool ZIP_CheckIfNameIsInArchive (const struct ZIPWri_Archive *Archive,
+					const char *NameInZIP)
+  {
+   unsigned NumEntry;
+   size_t Length = strlen (NameInZIP);
+
+   for (NumEntry = 0;
+	NumEntry < Archive->NumEntries;
+	NumEntry++)
+      if (!strncmp (Archive->Lst[NumEntry].NameInZIP,NameInZIP,Length) &&
+	  (Archive->Lst[NumEntry].NameInZIP[Length] == '\0' ||
+	   Archive->Lst[NumEntry].NameInZIP[Length] == '/'))
+	 return true;
+
+   return false;
   }
 
 /*****************************************************************************/
@@ -337,49 +313,33 @@ static void ZIP_CompressFolderIntoZIP (void)
    extern const char *Txt_ROOT_FOLDER_EXTERNAL_NAMES[Brw_NUM_TYPES_FILE_BROWSER];
    extern const char *Txt_The_folder_is_empty;
    extern const char *Txt_The_contents_of_the_folder_are_too_big;
-   unsigned long long UncompressedSize;
-   char StrZip[128 + PATH_MAX];
+   struct ZIPWri_Archive Archive;
    char Path[PATH_MAX + 1 +
              PATH_MAX + 1];
-   char PathCompression[PATH_MAX + 1 +
-                        NAME_MAX + 1 +
-                        NAME_MAX + 1];
-   int Result;
    char *FileNameZIP;
    char PathFileZIP[PATH_MAX + 1];
    struct stat FileStatus;
    char URLWithSpaces[PATH_MAX + 1];
    char URL[PATH_MAX + 1];
 
-   /***** Create temporary private directory
-          for the compression of folder *****/
-   ZIP_CreateTmpDirForCompression ();
-
-   /***** Create a temporary public directory
-          used to download the zip file *****/
-   Brw_CreateDirDownloadTmp ();
-
-   /***** Create a copy of the directory to compress *****/
+   /***** Build the list of files to compress *****/
+   ZIPWri_ArchiveConstructor (&Archive);
    snprintf (Path,sizeof (Path),"%s/%s",
 	     Gbl.FileBrowser.Path.AboveRootFolder,
 	     Gbl.FileBrowser.FilFolLnk.Full);
-   snprintf (PathCompression,sizeof (PathCompression),"%s/%s",
-	     Cfg_PATH_ZIP_PRIVATE,ZIP_TmpDir);	// Example: /var/www/swad/zip/<temporary_dir>
+   ZIP_AddDirToArchive (&Archive,Path,Gbl.FileBrowser.FilFolLnk.Full,NULL);
 
-   UncompressedSize = ZIP_CloneDir (Path,PathCompression,Gbl.FileBrowser.FilFolLnk.Full);
-
-   if (UncompressedSize == 0)					// Nothing to compress
+   if (Archive.NumEntries == 0)					// Nothing to compress
       Ale_ShowAlert (Ale_WARNING,Txt_The_folder_is_empty);
-   else if (UncompressedSize > ZIP_MAX_SIZE_UNCOMPRESSED)	// Uncompressed size is too big
+   else if (Archive.UncompressedSize > ZIP_MAX_SIZE_UNCOMPRESSED)	// Uncompressed size is too big
       Ale_ShowAlert (Ale_WARNING,Txt_The_contents_of_the_folder_are_too_big);
    else
      {
-      /***** Change to directory of the clone folder
-	     in order to start the path in the zip file from there *****/
-      if (chdir (PathCompression))
-	 Err_ShowErrorAndExit ("Can not change to temporary folder for compression.");
+      /***** Create a temporary public directory
+	     used to download the zip file *****/
+      Brw_CreateDirDownloadTmp ();
 
-      /***** Create public zip file with the assignment and works *****/
+      /***** Create public zip file with the folder *****/
       if (asprintf (&FileNameZIP,"%s.zip",
 	            strcmp (Gbl.FileBrowser.FilFolLnk.Name,".") ? Gbl.FileBrowser.FilFolLnk.Name :
 							          Txt_ROOT_FOLDER_EXTERNAL_NAMES[Gbl.FileBrowser.Type]) < 0)
@@ -389,19 +349,10 @@ static void ZIP_CompressFolderIntoZIP (void)
 	        Gbl.FileBrowser.TmpPubDir.L,
 	        Gbl.FileBrowser.TmpPubDir.R,
 	        FileNameZIP);
-      snprintf (StrZip,sizeof (StrZip),"nice -n 19 zip -q -5 -r '%s' *",
-	        PathFileZIP);
-      Result = system (StrZip);
-
-      /***** Return to the CGI directory *****/
-      if (chdir (Cfg_PATH_CGI_BIN))
-	 Err_ShowErrorAndExit ("Can not change to cgi-bin folder.");
-
-      /***** If the zip command has not been sucessful, abort *****/
-      if (Result)
+      if (ZIPWri_WriteArchive (&Archive,PathFileZIP) == Err_ERROR)
 	 Err_ShowErrorAndExit ("Can not compress files into zip file.");
 
-      /***** If the zip command has been sucessful, write the link to zip file *****/
+      /***** Write the link to zip file *****/
       /* Get file size */
       if (lstat (PathFileZIP,&FileStatus))	// On success ==> 0 is returned
 	 Err_ShowErrorAndExit ("Can not get information about a file or folder.");
@@ -416,18 +367,19 @@ static void ZIP_CompressFolderIntoZIP (void)
 	 Str_CopyStrChangingSpaces (URLWithSpaces,URL,PATH_MAX);	// In HTML, URL must have no spaces
 
 	 /** Link to download file */
-	 ZIP_ShowLinkToDownloadZIP (FileNameZIP,URL,FileStatus.st_size,UncompressedSize);
+	 ZIP_ShowLinkToDownloadZIP (FileNameZIP,URL,FileStatus.st_size,
+				    Archive.UncompressedSize);
 	}
 
       free (FileNameZIP);
      }
 
-   /***** Remove the directory of compression *****/
-   Fil_RemoveTree (PathCompression);
+   /***** Free list of files to compress *****/
+   ZIPWri_ArchiveDestructor (&Archive);
   }
 
 /*****************************************************************************/
-/*************** Clone a directory recursively to compress it ****************/
+/********* Add the contents of a directory recursively to zip file ***********/
 /*****************************************************************************/
 
 /* Example:
@@ -435,29 +387,31 @@ static void ZIP_CompressFolderIntoZIP (void)
  * Example starting directory with document files: /var/www/swad/crs/1000/descarga/lectures/lecture_1
  * We want to compress all files inside lecture_1 into a ZIP file
  * Path = /var/www/swad/crs/1000/descarga/lectures/lecture_1
- * PathClone = /var/www/swad/zip/<unique_dir>
  * PathInTree = "descarga/lectures/lecture_1"
+ * NameInZIP = NULL
 
  * Example directory inside starting directory with document files: /var/www/swad/crs/1000/descarga/lectures/lecture_1/slides
  * Path = /var/www/swad/crs/1000/descarga/lectures/lecture_1/slides
- * PathClone: /var/www/swad/zip/<unique_dir>/slides
- * PathInTree = "descarga/lectures/lecture_1/slides
+ * PathInTree = "descarga/lectures/lecture_1/slides"
+ * NameInZIP = "slides"
  */
-// Return: full size of directory contents
+// PathInTree is NULL when the directory is not inside a file browser
+// (no hidden files and no file views)
 
-static unsigned long long ZIP_CloneDir (const char *Path,const char *PathClone,const char *PathInTree)
+static void ZIP_AddDirToArchive (struct ZIPWri_Archive *Archive,
+				 const char *Path,const char *PathInTree,
+				 const char *NameInZIP)
   {
    extern unsigned Brw_TypeOf[Brw_NUM_TYPES_FILE_BROWSER];
    struct dirent **FileList;
    int NumFile;
    int NumFiles;
    char PathFile[PATH_MAX + 1];
-   char PathFileClone[PATH_MAX + 1];
    char PathFileInTree[PATH_MAX + 1];
+   char NameFileInZIP[PATH_MAX + 1];
    struct stat FileStatus;
    Brw_FileType_t FileType;
    HidVis_HiddenOrVisible_t HiddenOrVisible;
-   unsigned long long FullSize = 0;
 
    /***** Scan directory *****/
    if ((NumFiles = scandir (Path,&FileList,NULL,alphasort)) >= 0)	// No error
@@ -466,15 +420,21 @@ static unsigned long long ZIP_CloneDir (const char *Path,const char *PathClone,c
       for (NumFile = 0;
 	   NumFile < NumFiles;
 	   NumFile++)
+	{
 	 if (strcmp (FileList[NumFile]->d_name,".") &&
 	     strcmp (FileList[NumFile]->d_name,".."))	// Skip directories "." and ".."
 	   {
-	    snprintf (PathFileInTree,sizeof (PathFileInTree),"%s/%s",
-	              PathInTree,FileList[NumFile]->d_name);
+	    if (PathInTree)
+	       snprintf (PathFileInTree,sizeof (PathFileInTree),"%s/%s",
+			 PathInTree,FileList[NumFile]->d_name);
 	    snprintf (PathFile,sizeof (PathFile),"%s/%s",
 		      Path,FileList[NumFile]->d_name);
-	    snprintf (PathFileClone,sizeof (PathFileClone),"%s/%s",
-		      PathClone,FileList[NumFile]->d_name);
+	    if (NameInZIP)
+	       snprintf (NameFileInZIP,sizeof (NameFileInZIP),"%s/%s",
+			 NameInZIP,FileList[NumFile]->d_name);
+	    else
+	       Str_Copy (NameFileInZIP,FileList[NumFile]->d_name,
+			 sizeof (NameFileInZIP) - 1);
 
 	    FileType = Brw_IS_UNKNOWN;
 	    if (lstat (PathFile,&FileStatus))	// On success ==> 0 is returned
@@ -485,45 +445,43 @@ static unsigned long long ZIP_CloneDir (const char *Path,const char *PathClone,c
 	       FileType = Str_FileIs (FileList[NumFile]->d_name,"url") ? Brw_IS_LINK :	// It's a link (URL inside a .url file)
 									 Brw_IS_FILE;	// It's a file
 
-	    HiddenOrVisible = (Brw_TypeOf[Gbl.FileBrowser.Type] & (Brw_IS_SEE_DOC |
-								   Brw_IS_SEE_MRK)) ? Brw_CheckIfFileOrFolderIsHidden (FileType,
-		        											       PathFileInTree) :
-										      HidVis_VISIBLE;
+	    HiddenOrVisible = (PathInTree &&
+			       (Brw_TypeOf[Gbl.FileBrowser.Type] & (Brw_IS_SEE_DOC |
+								    Brw_IS_SEE_MRK))) ? Brw_CheckIfFileOrFolderIsHidden (FileType,
+		        											     PathFileInTree) :
+										        HidVis_VISIBLE;
 
 	    if (HiddenOrVisible == HidVis_VISIBLE)	// If file/folder is visible
 	       switch (FileType)
 	         {
 		  case Brw_IS_FOLDER:
-		     FullSize += (unsigned long long) FileStatus.st_size;
-
-		     /***** Create clone of subdirectory *****/
-		     if (mkdir (PathFileClone,(mode_t) 0xFFF))
-			Err_ShowErrorAndExit ("Can not create temporary subfolder for compression.");
-
-		     /***** Clone subtree starting at this this directory *****/
-		     FullSize += ZIP_CloneDir (PathFile,PathFileClone,PathFileInTree);
+		     /***** Add subdirectory and its subtree *****/
+		     ZIPWri_AddFolder (Archive,NameFileInZIP,&FileStatus);
+		     ZIP_AddDirToArchive (Archive,PathFile,
+					  PathInTree ? PathFileInTree :
+						       NULL,
+					  NameFileInZIP);
 		     break;
 		  case Brw_IS_FILE:
 		  case Brw_IS_LINK:
-		     FullSize += (unsigned long long) FileStatus.st_size;
-
-		     /***** Create a symbolic link (clone) to original file *****/
-		     if (symlink (PathFile,PathFileClone))
-			Err_ShowErrorAndExit ("Can not create temporary link for compression.");
+		     /***** Add file *****/
+		     ZIPWri_AddFile (Archive,NameFileInZIP,PathFile,&FileStatus);
 
 		     /***** Update number of my views of this file *****/
-		     Brw_UpdateMyFileViews (Brw_DB_GetFilCodByPath (PathFileInTree,
-								    Brw_ANY_FILE));	// Any file, public or not
+		     if (PathInTree)
+			Brw_UpdateMyFileViews (Brw_DB_GetFilCodByPath (PathFileInTree,
+								       Brw_ANY_FILE));	// Any file, public or not
 		     break;
 		  default:
 		     break;
 	         }
 	   }
+	 free (FileList[NumFile]);
+	}
+      free (FileList);
      }
    else
       Err_ShowErrorAndExit ("Error while scanning directory.");
-
-   return FullSize;
   }
 
 /*****************************************************************************/
@@ -0,0 +1,779 @@
+// swad_zip_writer.c: write ZIP files from file trees without external programs
+
+/*
+    SWAD (Shared Workspace At a Distance),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2026 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/********************************* Headers ***********************************/
+/*****************************************************************************/
+
+/*
+   Format: ZIP64 (APPNOTE.TXT, version 4.5).
+   All entries carry ZIP64 extra fields, so there is no limit
+   in the size of files, the size of the archive or the number of entries.
+
+   Small files to be deflated are read and compressed in memory
+   by several threads in parallel, in batches of limited total size.
+   Big files and already compressed formats are streamed
+   by the main thread; their local headers are rewritten
+   when their CRC and sizes are known.
+*/
+
+#define _GNU_SOURCE 		// For asprintf
+#include <fcntl.h>		// For open
+#include <pthread.h>		// For pthread_create, pthread_join...
+#include <stdbool.h>		// For boolean type
+#include <stdio.h>		// For asprintf, fopen, fwrite...
+#include <stdlib.h>		// For malloc, realloc, free
+#include <string.h>		// For strdup
+#include <unistd.h>		// For read, close, unlink, sysconf
+#include <zlib.h>		// For crc32, deflate...
+
+#include "swad_string.h"
+#include "swad_zip_writer.h"
+
+/*****************************************************************************/
+/***************************** Private constants *****************************/
+/*****************************************************************************/
+
+#define ZIPWri_MiB (1024ULL * 1024ULL)
+
+#define ZIPWri_COMPRESSION_LEVEL	5
+#define ZIPWri_MAX_THREADS		8
+#define ZIPWri_MAX_SIZE_IN_MEMORY	( 8ULL * ZIPWri_MiB)	// Bigger files are streamed
+#define ZIPWri_MAX_SIZE_BATCH		(64ULL * ZIPWri_MiB)	// Files compressed in parallel
+#define ZIPWri_BUFFER_SIZE		(256 * 1024)
+
+#define ZIPWri_VERSION			45			// 4.5 ==> ZIP64
+#define ZIPWri_VERSION_MADE_BY		((3 << 8) | ZIPWri_VERSION)	// 3 ==> UNIX
+
+#define ZIPWri_SIGNATURE_LOCAL_HEADER	0x04034b50
+#define ZIPWri_SIGNATURE_CENTRAL_HEADER	0x02014b50
+#define ZIPWri_SIGNATURE_ZIP64_END	0x06064b50
+#define ZIPWri_SIGNATURE_ZIP64_LOCATOR	0x07064b50
+#define ZIPWri_SIGNATURE_END		0x06054b50
+
+#define ZIPWri_ZIP64_EXTRA_ID		0x0001
+
+#define ZIPWri_SIZE_LOCAL_HEADER	30
+#define ZIPWri_SIZE_LOCAL_EXTRA		(4 + 8 + 8)
+#define ZIPWri_SIZE_CENTRAL_HEADER	46
+#define ZIPWri_SIZE_CENTRAL_EXTRA	(4 + 8 + 8 + 8)
+#define ZIPWri_SIZE_ZIP64_END		56
+#define ZIPWri_SIZE_ZIP64_LOCATOR	20
+#define ZIPWri_SIZE_END			22
+
+/* Extensions of formats already compressed, stored without recompressing */
+static const char *ZIPWri_StoredExtensions[] =
+  {
+   "7z",
+   "aac",
+   "avi",
+   "bz2",
+   "docx",
+   "epub",
+   "flac",
+   "gif",
+   "gz",
+   "jar",
+   "jpeg",
+   "jpg",
+   "m4a",
+   "mkv",
+   "mov",
+   "mp3",
+   "mp4",
+   "odg",
+   "odp",
+   "ods",
+   "odt",
+   "ogg",
+   "png",
+   "pptx",
+   "rar",
+   "tgz",
+   "webm",
+   "webp",
+   "xlsx",
+   "xz",
+   "zip",
+  };
+#define ZIPWri_NUM_STORED_EXTENSIONS (sizeof (ZIPWri_StoredExtensions) / sizeof (ZIPWri_StoredExtensions[0]))
+
+/*****************************************************************************/
+/******************************* Private types *******************************/
+/*****************************************************************************/
+
+struct ZIPWri_Batch
+  {
+   struct ZIPWri_Entry *Lst;
+   unsigned NextEntry;		// Next entry to be compressed by any thread
+   unsigned EndEntry;		// Entry after the last one in batch
+   pthread_mutex_t Mutex;
+  };
+
+/*****************************************************************************/
+/***************************** Private prototypes ****************************/
+/*****************************************************************************/
+
+static struct ZIPWri_Entry *ZIPWri_NewEntry (struct ZIPWri_Archive *Archive,
+					     const struct stat *FileStatus);
+static ZIPWri_Method_t ZIPWri_GetMethod (const char *NameInZIP);
+static bool ZIPWri_CheckIfCompressInMemory (const struct ZIPWri_Entry *Entry);
+
+static void ZIPWri_CompressBatch (struct ZIPWri_Entry *Lst,
+				  unsigned FirstEntry,unsigned EndEntry);
+static void *ZIPWri_CompressBatchThread (void *Args);
+static void ZIPWri_CompressEntryInMemory (struct ZIPWri_Entry *Entry);
+static Err_SuccessOrError_t ZIPWri_StreamEntry (FILE *FileZIP,
+						struct ZIPWri_Entry *Entry);
+
+static Err_SuccessOrError_t ZIPWri_WriteLocalHeader (FILE *FileZIP,
+						     const struct ZIPWri_Entry *Entry);
+static Err_SuccessOrError_t ZIPWri_WriteCentralHeader (FILE *FileZIP,
+						       const struct ZIPWri_Entry *Entry);
+static Err_SuccessOrError_t ZIPWri_WriteEnd (FILE *FileZIP,unsigned NumEntries,
+					     unsigned long long OffsetCentral,
+					     unsigned long long SizeCentral);
+static void ZIPWri_GetDOSDateTime (time_t Time,uint16_t *DOSDate,uint16_t *DOSTime);
+
+static unsigned char *ZIPWri_Put16 (unsigned char *Ptr,uint16_t Value);
+static unsigned char *ZIPWri_Put32 (unsigned char *Ptr,uint32_t Value);
+static unsigned char *ZIPWri_Put64 (unsigned char *Ptr,uint64_t Value);
+
+/*****************************************************************************/
+/********************** Initialize and free an archive ***********************/
+/*****************************************************************************/
+
+void ZIPWri_ArchiveConstructor (struct ZIPWri_Archive *Archive)
+  {
+   Archive->NumEntries       = 0;
+   Archive->MaxEntries       = 0;
+   Archive->Lst              = NULL;
+   Archive->UncompressedSize = 0;
+  }
+
+void ZIPWri_ArchiveDestructor (struct ZIPWri_Archive *Archive)
+  {
+   unsigned NumEntry;
+   struct ZIPWri_Entry *Entry;
+
+   for (NumEntry = 0;
+	NumEntry < Archive->NumEntries;
+	NumEntry++)
+     {
+      Entry = &Archive->Lst[NumEntry];
+      free (Entry->NameInZIP);
+      if (Entry->Path)
+	 free (Entry->Path);
+      if (Entry->Data)
+	 free (Entry->Data);
+     }
+   if (Archive->Lst)
+      free (Archive->Lst);
+
+   ZIPWri_ArchiveConstructor (Archive);
+  }
+
+/*****************************************************************************/
+/*********************** Add a folder or a file to archive *******************/
+/*****************************************************************************/
+
+void ZIPWri_AddFolder (struct ZIPWri_Archive *Archive,const char *NameInZIP,
+		       const struct stat *FileStatus)
+  {
+   struct ZIPWri_Entry *Entry = ZIPWri_NewEntry (Archive,FileStatus);
+
+   if (asprintf (&Entry->NameInZIP,"%s/",NameInZIP) < 0)
+      Err_NotEnoughMemoryExit ();
+   Entry->Method = ZIPWri_STORE;
+  }
+
+void ZIPWri_AddFile (struct ZIPWri_Archive *Archive,const char *NameInZIP,
+		     const char *Path,const struct stat *FileStatus)
+  {
+   struct ZIPWri_Entry *Entry = ZIPWri_NewEntry (Archive,FileStatus);
+
+   if ((Entry->NameInZIP = strdup (NameInZIP)) == NULL ||
+       (Entry->Path      = strdup (Path     )) == NULL)
+      Err_NotEnoughMemoryExit ();
+   Entry->Method = ZIPWri_GetMethod (NameInZIP);
+   Entry->Size   = (unsigned long long) FileStatus->st_size;
+
+   Archive->UncompressedSize += Entry->Size;
+  }
+
+static struct ZIPWri_Entry *ZIPWri_NewEntry (struct ZIPWri_Archive *Archive,
+					     const struct stat *FileStatus)
+  {
+   struct ZIPWri_Entry *Entry;
+
+   /***** Enlarge list if full *****/
+   if (Archive->NumEntries == Archive->MaxEntries)
+     {
+      Archive->MaxEntries = Archive->MaxEntries ? Archive->MaxEntries * 2 :
+						  64;
+      if ((Archive->Lst = realloc (Archive->Lst,
+				   Archive->MaxEntries * sizeof (*Archive->Lst))) == NULL)
+	 Err_NotEnoughMemoryExit ();
+     }
+
+   /***** Initialize new entry *****/
+   Entry = &Archive->Lst[Archive->NumEntries++];
+   Entry->NameInZIP      = NULL;
+   Entry->Path           = NULL;
+   Entry->Mode           = FileStatus->st_mode;
+   Entry->ModifyTime     = FileStatus->st_mtime;
+   Entry->Method         = ZIPWri_STORE;
+   Entry->CRC            = 0;
+   Entry->Size           = 0;
+   Entry->CompressedSize = 0;
+   Entry->Offset         = 0;
+   Entry->Data           = NULL;
+   Entry->SuccessOrError = Err_SUCCESS;
+
+   return Entry;
+  }
+
+/*****************************************************************************/
+/*************** Get the compression method from the extension ***************/
+/*****************************************************************************/
+
+static ZIPWri_Method_t ZIPWri_GetMethod (const char *NameInZIP)
+  {
+   unsigned NumExt;
+
+   for (NumExt = 0;
+	NumExt < ZIPWri_NUM_STORED_EXTENSIONS;
+	NumExt++)
+      if (Str_FileIs (NameInZIP,ZIPWri_StoredExtensions[NumExt]))
+	 return ZIPWri_STORE;
+
+   return ZIPWri_DEFLATE;
+  }
+
+/*****************************************************************************/
+/************** Check if an entry is compressed in memory ********************/
+/*****************************************************************************/
+
+static bool ZIPWri_CheckIfCompressInMemory (const struct ZIPWri_Entry *Entry)
+  {
+   return Entry->Path &&
+	  Entry->Method == ZIPWri_DEFLATE &&
+	  Entry->Size <= ZIPWri_MAX_SIZE_IN_MEMORY;
+  }
+
+/*****************************************************************************/
+/************************** Write archive to a file **************************/
+/*****************************************************************************/
+
+Err_SuccessOrError_t ZIPWri_WriteArchive (struct ZIPWri_Archive *Archive,
+					  const char *PathFileZIP)
+  {
+   FILE *FileZIP;
+   unsigned NumEntry;
+   unsigned EndEntry;
+   unsigned long long SizeBatch;
+   unsigned long long OffsetCentral;
+   struct ZIPWri_Entry *Entry;
+   Err_SuccessOrError_t SuccessOrError = Err_SUCCESS;
+
+   /***** Open ZIP file *****/
+   if ((FileZIP = fopen (PathFileZIP,"wb")) == NULL)
+      return Err_ERROR;
+
+   /***** Write entries *****/
+   for (NumEntry = 0;
+	SuccessOrError == Err_SUCCESS && NumEntry < Archive->NumEntries;
+	)
+      if (ZIPWri_CheckIfCompressInMemory (&Archive->Lst[NumEntry]))
+	{
+	 /* Get consecutive small files to be compressed in parallel */
+	 for (EndEntry = NumEntry, SizeBatch = 0;
+	      EndEntry < Archive->NumEntries &&
+	      ZIPWri_CheckIfCompressInMemory (&Archive->Lst[EndEntry]) &&
+	      (EndEntry == NumEntry ||
+	       SizeBatch + Archive->Lst[EndEntry].Size <= ZIPWri_MAX_SIZE_BATCH);
+	      EndEntry++)
+	    SizeBatch += Archive->Lst[EndEntry].Size;
+
+	 ZIPWri_CompressBatch (Archive->Lst,NumEntry,EndEntry);
+
+	 /* Write compressed files in order */
+	 for (;
+	      SuccessOrError == Err_SUCCESS && NumEntry < EndEntry;
+	      NumEntry++)
+	   {
+	    Entry = &Archive->Lst[NumEntry];
+	    Entry->Offset = (unsigned long long) ftello (FileZIP);
+	    if ((SuccessOrError = Entry->SuccessOrError) == Err_SUCCESS)
+	       SuccessOrError = ZIPWri_WriteLocalHeader (FileZIP,Entry);
+	    if (SuccessOrError == Err_SUCCESS && Entry->CompressedSize)
+	       if (fwrite (Entry->Data,Entry->CompressedSize,1,FileZIP) != 1)
+		  SuccessOrError = Err_ERROR;
+	    free (Entry->Data);
+	    Entry->Data = NULL;
+	   }
+	}
+      else
+	{
+	 /* Folder, big file or already compressed file */
+	 Entry = &Archive->Lst[NumEntry++];
+	 Entry->Offset = (unsigned long long) ftello (FileZIP);
+	 SuccessOrError = ZIPWri_WriteLocalHeader (FileZIP,Entry);
+	 if (SuccessOrError == Err_SUCCESS && Entry->Path)
+	    SuccessOrError = ZIPWri_StreamEntry (FileZIP,Entry);
+	}
+
+   /***** Write central directory and end records *****/
+   if (SuccessOrError == Err_SUCCESS)
+     {
+      OffsetCentral = (unsigned long long) ftello (FileZIP);
+      for (NumEntry = 0;
+	   SuccessOrError == Err_SUCCESS && NumEntry < Archive->NumEntries;
+	   NumEntry++)
+	 SuccessOrError = ZIPWri_WriteCentralHeader (FileZIP,&Archive->Lst[NumEntry]);
+      if (SuccessOrError == Err_SUCCESS)
+	 SuccessOrError = ZIPWri_WriteEnd (FileZIP,Archive->NumEntries,OffsetCentral,
+					   (unsigned long long) ftello (FileZIP) - OffsetCentral);
+     }
+
+   /***** Close ZIP file *****/
+   if (fclose (FileZIP))
+      SuccessOrError = Err_ERROR;
+   if (SuccessOrError == Err_ERROR)
+      unlink (PathFileZIP);
+
+   return SuccessOrError;
+  }
+
+/*****************************************************************************/
+/************ Compress a batch of small files in several threads *************/
+/*****************************************************************************/
+
+static void ZIPWri_CompressBatch (struct ZIPWri_Entry *Lst,
+				  unsigned FirstEntry,unsigned EndEntry)
+  {
+   struct ZIPWri_Batch Batch;
+   pthread_t Threads[ZIPWri_MAX_THREADS - 1];
+   unsigned NumThreads;
+   unsigned NumThread;
+   long NumCPUs;
+
+   /***** Get number of threads *****/
+   NumCPUs = sysconf (_SC_NPROCESSORS_ONLN);
+   NumThreads = NumCPUs < 1                    ? 1 :
+		NumCPUs > ZIPWri_MAX_THREADS   ? ZIPWri_MAX_THREADS :
+						 (unsigned) NumCPUs;
+   if (NumThreads > EndEntry - FirstEntry)
+      NumThreads = EndEntry - FirstEntry;
+
+   /***** Initialize batch *****/
+   Batch.Lst       = Lst;
+   Batch.NextEntry = FirstEntry;
+   Batch.EndEntry  = EndEntry;
+   pthread_mutex_init (&Batch.Mutex,NULL);
+
+   /***** Current thread also compresses,
+	  so the batch is completed even if no thread can be created *****/
+   for (NumThread = 0;
+	NumThread < NumThreads - 1;
+	NumThread++)
+      if (pthread_create (&Threads[NumThread],NULL,ZIPWri_CompressBatchThread,&Batch))
+	 break;
+   ZIPWri_CompressBatchThread (&Batch);
+
+   /***** Wait for the other threads *****/
+   while (NumThread)
+      pthread_join (Threads[--NumThread],NULL);
+
+   pthread_mutex_destroy (&Batch.Mutex);
+  }
+
+static void *ZIPWri_CompressBatchThread (void *Args)
+  {
+   struct ZIPWri_Batch *Batch = (struct ZIPWri_Batch *) Args;
+   unsigned NumEntry;
+
+   for (;;)
+     {
+      pthread_mutex_lock (&Batch->Mutex);
+	 NumEntry = Batch->NextEntry;
+	 if (NumEntry < Batch->EndEntry)
+	    Batch->NextEntry++;
+      pthread_mutex_unlock (&Batch->Mutex);
+
+      if (NumEntry >= Batch->EndEntry)
+	 return NULL;
+
+      ZIPWri_CompressEntryInMemory (&Batch->Lst[NumEntry]);
+     }
+  }
+
+/*****************************************************************************/
+/******************* Read and compress a small file in memory ****************/
+/*****************************************************************************/
+// Called from several threads: errors are returned in the entry
+
+static void ZIPWri_CompressEntryInMemory (struct ZIPWri_Entry *Entry)
+  {
+   unsigned char *Raw;
+   unsigned char *Compressed;
+   unsigned long long SizeRead = 0;
+   ssize_t BytesRead;
+   uLong MaxCompressedSize;
+   z_stream Stream;
+   int FileDescriptor;
+
+   Entry->SuccessOrError = Err_ERROR;
+
+   /***** Read whole file *****/
+   if ((FileDescriptor = open (Entry->Path,O_RDONLY)) < 0)
+      return;
+   if ((Raw = malloc (Entry->Size + 1)) == NULL)
+     {
+      close (FileDescriptor);
+      return;
+     }
+   while (SizeRead <= Entry->Size &&
+	  (BytesRead = read (FileDescriptor,&Raw[SizeRead],
+			     Entry->Size + 1 - SizeRead)) > 0)
+      SizeRead += (unsigned long long) BytesRead;
+   close (FileDescriptor);
+   if (SizeRead != Entry->Size)	// File changed since it was added
+     {
+      free (Raw);
+      return;
+     }
+   Entry->CRC = (uint32_t) crc32 (0L,Raw,(uInt) Entry->Size);
+
+   /***** Deflate *****/
+   Stream.zalloc = Z_NULL;
+   Stream.zfree  = Z_NULL;
+   Stream.opaque = Z_NULL;
+   if (deflateInit2 (&Stream,ZIPWri_COMPRESSION_LEVEL,Z_DEFLATED,
+		     -MAX_WBITS,8,Z_DEFAULT_STRATEGY) != Z_OK)	// Raw deflate, no zlib header
+     {
+      free (Raw);
+      return;
+     }
+   MaxCompressedSize = deflateBound (&Stream,(uLong) Entry->Size);
+   if ((Compressed = malloc (MaxCompressedSize)) == NULL)
+     {
+      deflateEnd (&Stream);
+      free (Raw);
+      return;
+     }
+   Stream.next_in   = Raw;
+   Stream.avail_in  = (uInt) Entry->Size;
+   Stream.next_out  = Compressed;
+   Stream.avail_out = (uInt) MaxCompressedSize;
+   if (deflate (&Stream,Z_FINISH) == Z_STREAM_END &&
+       Stream.total_out < Entry->Size)
+     {
+      /* Compressed is smaller ==> keep it */
+      Entry->Data = Compressed;
+      Entry->CompressedSize = Stream.total_out;
+      free (Raw);
+     }
+   else
+     {
+      /* Compressed is not smaller ==> store original */
+      Entry->Method = ZIPWri_STORE;
+      Entry->Data = Raw;
+      Entry->CompressedSize = Entry->Size;
+      free (Compressed);
+     }
+   deflateEnd (&Stream);
+
+   Entry->SuccessOrError = Err_SUCCESS;
+  }
+
+/*****************************************************************************/
+/****************** Stream a file into ZIP file, then rewrite ****************/
+/****************** its local header with CRC and sizes       ****************/
+/*****************************************************************************/
+
+static Err_SuccessOrError_t ZIPWri_StreamEntry (FILE *FileZIP,
+						struct ZIPWri_Entry *Entry)
+  {
+   static unsigned char In[ZIPWri_BUFFER_SIZE];
+   static unsigned char Out[ZIPWri_BUFFER_SIZE];
+   z_stream Stream;
+   ssize_t BytesRead;
+   size_t BytesOut;
+   int FileDescriptor;
+   int Flush;
+   Err_SuccessOrError_t SuccessOrError = Err_SUCCESS;
+
+   /***** Open file *****/
+   if ((FileDescriptor = open (Entry->Path,O_RDONLY)) < 0)
+      return Err_ERROR;
+
+   Stream.zalloc = Z_NULL;
+   Stream.zfree  = Z_NULL;
+   Stream.opaque = Z_NULL;
+   if (Entry->Method == ZIPWri_DEFLATE)
+      if (deflateInit2 (&Stream,ZIPWri_COMPRESSION_LEVEL,Z_DEFLATED,
+			-MAX_WBITS,8,Z_DEFAULT_STRATEGY) != Z_OK)	// Raw deflate, no zlib header
+	{
+	 close (FileDescriptor);
+	 return Err_ERROR;
+	}
+
+   /***** Copy or deflate file into ZIP file *****/
+   Entry->CRC = 0;
+   Entry->Size = Entry->CompressedSize = 0;
+   do
+     {
+      if ((BytesRead = read (FileDescriptor,In,sizeof (In))) < 0)
+	{
+	 SuccessOrError = Err_ERROR;
+	 break;
+	}
+      Entry->CRC = (uint32_t) crc32 ((uLong) Entry->CRC,In,(uInt) BytesRead);
+      Entry->Size += (unsigned long long) BytesRead;
+
+      switch (Entry->Method)
+	{
+	 case ZIPWri_STORE:
+	    if (BytesRead)
+	       if (fwrite (In,(size_t) BytesRead,1,FileZIP) != 1)
+		  SuccessOrError = Err_ERROR;
+	    Entry->CompressedSize += (unsigned long long) BytesRead;
+	    break;
+	 case ZIPWri_DEFLATE:
+	    Flush = BytesRead ? Z_NO_FLUSH :
+				Z_FINISH;
+	    Stream.next_in  = In;
+	    Stream.avail_in = (uInt) BytesRead;
+	    do
+	      {
+	       Stream.next_out  = Out;
+	       Stream.avail_out = sizeof (Out);
+	       deflate (&Stream,Flush);
+	       if ((BytesOut = sizeof (Out) - Stream.avail_out))
+		  if (fwrite (Out,BytesOut,1,FileZIP) != 1)
+		     SuccessOrError = Err_ERROR;
+	       Entry->CompressedSize += BytesOut;
+	      }
+	    while (SuccessOrError == Err_SUCCESS && Stream.avail_out == 0);
+	    break;
+	}
+     }
+   while (SuccessOrError == Err_SUCCESS && BytesRead);
+
+   /***** Close file *****/
+   if (Entry->Method == ZIPWri_DEFLATE)
+      deflateEnd (&Stream);
+   close (FileDescriptor);
+
+   /***** Rewrite local header and go back to the end *****/
+   if (SuccessOrError == Err_SUCCESS)
+     {
+      if (fseeko (FileZIP,(off_t) Entry->Offset,SEEK_SET))
+	 return Err_ERROR;
+      if ((SuccessOrError = ZIPWri_WriteLocalHeader (FileZIP,Entry)) == Err_SUCCESS)
+	 if (fseeko (FileZIP,0,SEEK_END))
+	    SuccessOrError = Err_ERROR;
+     }
+
+   return SuccessOrError;
+  }
+
+/*****************************************************************************/
+/************************** Write the local header ***************************/
+/*****************************************************************************/
+// Sizes are always in the ZIP64 extra field, so the header has always
+// the same length and it can be rewritten after streaming the data
+
+static Err_SuccessOrError_t ZIPWri_WriteLocalHeader (FILE *FileZIP,
+						     const struct ZIPWri_Entry *Entry)
+  {
+   unsigned char Header[ZIPWri_SIZE_LOCAL_HEADER + ZIPWri_SIZE_LOCAL_EXTRA];
+   unsigned char *Ptr = Header;
+   size_t LengthName = strlen (Entry->NameInZIP);
+   uint16_t DOSDate;
+   uint16_t DOSTime;
+
+   ZIPWri_GetDOSDateTime (Entry->ModifyTime,&DOSDate,&DOSTime);
+
+   Ptr = ZIPWri_Put32 (Ptr,ZIPWri_SIGNATURE_LOCAL_HEADER);
+   Ptr = ZIPWri_Put16 (Ptr,ZIPWri_VERSION);		// Version needed to extract
+   Ptr = ZIPWri_Put16 (Ptr,0);				// Flags
+   Ptr = ZIPWri_Put16 (Ptr,(uint16_t) Entry->Method);
+   Ptr = ZIPWri_Put16 (Ptr,DOSTime);
+   Ptr = ZIPWri_Put16 (Ptr,DOSDate);
+   Ptr = ZIPWri_Put32 (Ptr,Entry->CRC);
+   Ptr = ZIPWri_Put32 (Ptr,0xFFFFFFFF);			// Compressed size in ZIP64 extra field
+   Ptr = ZIPWri_Put32 (Ptr,0xFFFFFFFF);			// Size in ZIP64 extra field
+   Ptr = ZIPWri_Put16 (Ptr,(uint16_t) LengthName);
+   Ptr = ZIPWri_Put16 (Ptr,ZIPWri_SIZE_LOCAL_EXTRA);
+
+   Ptr = ZIPWri_Put16 (Ptr,ZIPWri_ZIP64_EXTRA_ID);
+   Ptr = ZIPWri_Put16 (Ptr,ZIPWri_SIZE_LOCAL_EXTRA - 4);
+   Ptr = ZIPWri_Put64 (Ptr,Entry->Size);
+         ZIPWri_Put64 (Ptr,Entry->CompressedSize);
+
+   if (fwrite (Header,ZIPWri_SIZE_LOCAL_HEADER,1,FileZIP) != 1 ||
+       fwrite (Entry->NameInZIP,LengthName,1,FileZIP) != 1 ||
+       fwrite (&Header[ZIPWri_SIZE_LOCAL_HEADER],ZIPWri_SIZE_LOCAL_EXTRA,1,FileZIP) != 1)
+      return Err_ERROR;
+
+   return Err_SUCCESS;
+  }
+
+/*****************************************************************************/
+/********************* Write a header in central directory *******************/
+/*****************************************************************************/
+
+static Err_SuccessOrError_t ZIPWri_WriteCentralHeader (FILE *FileZIP,
+						       const struct ZIPWri_Entry *Entry)
+  {
+   unsigned char Header[ZIPWri_SIZE_CENTRAL_HEADER + ZIPWri_SIZE_CENTRAL_EXTRA];
+   unsigned char *Ptr = Header;
+   size_t LengthName = strlen (Entry->NameInZIP);
+   uint16_t DOSDate;
+   uint16_t DOSTime;
+
+   ZIPWri_GetDOSDateTime (Entry->ModifyTime,&DOSDate,&DOSTime);
+
+   Ptr = ZIPWri_Put32 (Ptr,ZIPWri_SIGNATURE_CENTRAL_HEADER);
+   Ptr = ZIPWri_Put16 (Ptr,ZIPWri_VERSION_MADE_BY);
+   Ptr = ZIPWri_Put16 (Ptr,ZIPWri_VERSION);		// Version needed to extract
+   Ptr = ZIPWri_Put16 (Ptr,0);				// Flags
+   Ptr = ZIPWri_Put16 (Ptr,(uint16_t) Entry->Method);
+   Ptr = ZIPWri_Put16 (Ptr,DOSTime);
+   Ptr = ZIPWri_Put16 (Ptr,DOSDate);
+   Ptr = ZIPWri_Put32 (Ptr,Entry->CRC);
+   Ptr = ZIPWri_Put32 (Ptr,0xFFFFFFFF);			// Compressed size in ZIP64 extra field
+   Ptr = ZIPWri_Put32 (Ptr,0xFFFFFFFF);			// Size in ZIP64 extra field
+   Ptr = ZIPWri_Put16 (Ptr,(uint16_t) LengthName);
+   Ptr = ZIPWri_Put16 (Ptr,ZIPWri_SIZE_CENTRAL_EXTRA);
+   Ptr = ZIPWri_Put16 (Ptr,0);				// Comment length
+   Ptr = ZIPWri_Put16 (Ptr,0);				// Disk number start
+   Ptr = ZIPWri_Put16 (Ptr,0);				// Internal attributes
+   Ptr = ZIPWri_Put32 (Ptr,((uint32_t) Entry->Mode << 16) |	// External attributes: UNIX mode...
+			   (Entry->Path ? 0x00 :
+					  0x10));			// ...and MS-DOS directory
+   Ptr = ZIPWri_Put32 (Ptr,0xFFFFFFFF);			// Offset in ZIP64 extra field
+
+   Ptr = ZIPWri_Put16 (Ptr,ZIPWri_ZIP64_EXTRA_ID);
+   Ptr = ZIPWri_Put16 (Ptr,ZIPWri_SIZE_CENTRAL_EXTRA - 4);
+   Ptr = ZIPWri_Put64 (Ptr,Entry->Size);
+   Ptr = ZIPWri_Put64 (Ptr,Entry->CompressedSize);
+         ZIPWri_Put64 (Ptr,Entry->Offset);
+
+   if (fwrite (Header,ZIPWri_SIZE_CENTRAL_HEADER,1,FileZIP) != 1 ||
+       fwrite (Entry->NameInZIP,LengthName,1,FileZIP) != 1 ||
+       fwrite (&Header[ZIPWri_SIZE_CENTRAL_HEADER],ZIPWri_SIZE_CENTRAL_EXTRA,1,FileZIP) != 1)
+      return Err_ERROR;
+
+   return Err_SUCCESS;
+  }
+
+/*****************************************************************************/
+/************** Write ZIP64 end record, its locator and end record ***********/
+/*****************************************************************************/
+
+static Err_SuccessOrError_t ZIPWri_WriteEnd (FILE *FileZIP,unsigned NumEntries,
+					     unsigned long long OffsetCentral,
+					     unsigned long long SizeCentral)
+  {
+   unsigned char End[ZIPWri_SIZE_ZIP64_END +
+		     ZIPWri_SIZE_ZIP64_LOCATOR +
+		     ZIPWri_SIZE_END];
+   unsigned char *Ptr = End;
+   unsigned long long OffsetZIP64End = OffsetCentral + SizeCentral;
+
+   /***** ZIP64 end of central directory record *****/
+   Ptr = ZIPWri_Put32 (Ptr,ZIPWri_SIGNATURE_ZIP64_END);
+   Ptr = ZIPWri_Put64 (Ptr,ZIPWri_SIZE_ZIP64_END - 12);	// Size of remaining record
+   Ptr = ZIPWri_Put16 (Ptr,ZIPWri_VERSION_MADE_BY);
+   Ptr = ZIPWri_Put16 (Ptr,ZIPWri_VERSION);		// Version needed to extract
+   Ptr = ZIPWri_Put32 (Ptr,0);				// Number of this disk
+   Ptr = ZIPWri_Put32 (Ptr,0);				// Disk with central directory
+   Ptr = ZIPWri_Put64 (Ptr,NumEntries);			// Entries in this disk
+   Ptr = ZIPWri_Put64 (Ptr,NumEntries);			// Total entries
+   Ptr = ZIPWri_Put64 (Ptr,SizeCentral);
+   Ptr = ZIPWri_Put64 (Ptr,OffsetCentral);
+
+   /***** ZIP64 end of central directory locator *****/
+   Ptr = ZIPWri_Put32 (Ptr,ZIPWri_SIGNATURE_ZIP64_LOCATOR);
+   Ptr = ZIPWri_Put32 (Ptr,0);				// Disk with ZIP64 end record
+   Ptr = ZIPWri_Put64 (Ptr,OffsetZIP64End);
+   Ptr = ZIPWri_Put32 (Ptr,1);				// Total number of disks
+
+   /***** End of central directory record (values in ZIP64 records) *****/
+   Ptr = ZIPWri_Put32 (Ptr,ZIPWri_SIGNATURE_END);
+   Ptr = ZIPWri_Put16 (Ptr,0);				// Number of this disk
+   Ptr = ZIPWri_Put16 (Ptr,0);				// Disk with central directory
+   Ptr = ZIPWri_Put16 (Ptr,0xFFFF);			// Entries in this disk
+   Ptr = ZIPWri_Put16 (Ptr,0xFFFF);			// Total entries
+   Ptr = ZIPWri_Put32 (Ptr,0xFFFFFFFF);			// Size of central directory
+   Ptr = ZIPWri_Put32 (Ptr,0xFFFFFFFF);			// Offset of central directory
+         ZIPWri_Put16 (Ptr,0);				// Comment length
+
+   return fwrite (End,sizeof (End),1,FileZIP) == 1 ? Err_SUCCESS :
+						     Err_ERROR;
+  }
+
+/*****************************************************************************/
+/************************ Get MS-DOS date and time ***************************/
+/*****************************************************************************/
+
+static void ZIPWri_GetDOSDateTime (time_t Time,uint16_t *DOSDate,uint16_t *DOSTime)
+  {
+   struct tm tm;
+
+   if (localtime_r (&Time,&tm) == NULL || tm.tm_year < 80)	// Before 1980 ==> 1980-01-01
+     {
+      *DOSDate = (1 << 5) | 1;
+      *DOSTime = 0;
+      return;
+     }
+
+   *DOSDate = (uint16_t) (((tm.tm_year - 80) << 9) | ((tm.tm_mon + 1) << 5) | tm.tm_mday);
+   *DOSTime = (uint16_t) ((tm.tm_hour << 11) | (tm.tm_min << 5) | (tm.tm_sec / 2));
+  }
+
+/*****************************************************************************/
+/********************* Put little-endian values in buffer ********************/
+/*****************************************************************************/
+
+static unsigned char *ZIPWri_Put16 (unsigned char *Ptr,uint16_t Value)
+  {
+   *Ptr++ = (unsigned char) ( Value        & 0xFF);
+   *Ptr++ = (unsigned char) ((Value >>  8) & 0xFF);
+   return Ptr;
+  }
+
+static unsigned char *ZIPWri_Put32 (unsigned char *Ptr,uint32_t Value)
+  {
+   Ptr = ZIPWri_Put16 (Ptr,(uint16_t) ( Value        & 0xFFFF));
+   return ZIPWri_Put16 (Ptr,(uint16_t) ((Value >> 16) & 0xFFFF));
+  }
+
+static unsigned char *ZIPWri_Put64 (unsigned char *Ptr,uint64_t Value)
+  {
+   Ptr = ZIPWri_Put32 (Ptr,(uint32_t) ( Value        & 0xFFFFFFFF));
+   return ZIPWri_Put32 (Ptr,(uint32_t) ((Value >> 32) & 0xFFFFFFFF));
+  }
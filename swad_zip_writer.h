@@ -0,0 +1,84 @@
+// swad_zip_writer.h: write ZIP files from file trees without external programs
+
+#ifndef _SWAD_ZIPWRI
+#define _SWAD_ZIPWRI
+/*
+    SWAD (Shared Workspace At a Distance),
+    is a web platform developed at the University of Granada (Spain),
+    and used to support university teaching.
+
+    This file is part of SWAD core.
+    Copyright (C) 1999-2026 Antonio Caas Vargas
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as
+    published by the Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*****************************************************************************/
+/********************************* Headers ***********************************/
+/*****************************************************************************/
+
+#include <stdint.h>		// For uint32_t
+#include <sys/stat.h>		// For struct stat
+#include <time.h>		// For time_t
+
+#include "swad_error.h"
+
+/*****************************************************************************/
+/******************************* Public types ********************************/
+/*****************************************************************************/
+
+typedef enum
+  {
+   ZIPWri_STORE   = 0,	// Already compressed formats are stored as they are
+   ZIPWri_DEFLATE = 8,
+  } ZIPWri_Method_t;
+
+struct ZIPWri_Entry
+  {
+   char *NameInZIP;		// Folders end with '/'
+   char *Path;			// Path of file in disk (NULL for folders)
+   mode_t Mode;
+   time_t ModifyTime;
+   ZIPWri_Method_t Method;
+   uint32_t CRC;
+   unsigned long long Size;
+   unsigned long long CompressedSize;
+   unsigned long long Offset;	// Offset of local header in ZIP file
+   unsigned char *Data;		// Data already compressed in memory, or NULL
+   Err_SuccessOrError_t SuccessOrError;
+  };
+
+struct ZIPWri_Archive
+  {
+   unsigned NumEntries;
+   unsigned MaxEntries;
+   struct ZIPWri_Entry *Lst;
+   unsigned long long UncompressedSize;	// Sum of the sizes of all files
+  };
+
+/*****************************************************************************/
+/***************************** Public prototypes *****************************/
+/*****************************************************************************/
+
+void ZIPWri_ArchiveConstructor (struct ZIPWri_Archive *Archive);
+void ZIPWri_ArchiveDestructor (struct ZIPWri_Archive *Archive);
+
+void ZIPWri_AddFolder (struct ZIPWri_Archive *Archive,const char *NameInZIP,
+		       const struct stat *FileStatus);
+void ZIPWri_AddFile (struct ZIPWri_Archive *Archive,const char *NameInZIP,
+		     const char *Path,const struct stat *FileStatus);
+
+Err_SuccessOrError_t ZIPWri_WriteArchive (struct ZIPWri_Archive *Archive,
+					  const char *PathFileZIP);
+
+#endif